@@ -28,6 +28,9 @@
 #include "common/gamepad.h"
 #include "common/hardware.h"
 #include "common/config.h"
+#include "common/frame_sched.h"
+#include "common/input_hub.h"
+#include "common/audio.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -43,7 +46,6 @@
 
 #define MAX_APPS        24
 #define APPS_DIR        "/opt/roomwizard/apps"
-#define RESCAN_INTERVAL_MS 5000
 
 /* Post-launch cooldown: ignore ALL input (gamepad, touch, mouse) for this
  * many milliseconds after returning from a child process.  This prevents
@@ -176,7 +178,7 @@ typedef struct {
     char      exec_path[256];
     char      icon_path[256];
     ArgMode   args;
-    uint32_t *icon_pixels;      /* Loaded & scaled to ICON_SIZE², or NULL */
+    FbSprite *icon;             /* Loaded, scaled to ICON_SIZE², compiled; or NULL */
     uint32_t  icon_color;       /* Auto-assigned colour for letter tile   */
 } AppEntry;
 
@@ -192,10 +194,18 @@ typedef struct {
     TouchInput  touch;
     GamepadManager gamepad;
     InputState  input;
-    uint32_t    last_rescan_ms;
+    uint32_t    hub_devices;        /* gamepad.devices_changed the hub was built from */
     uint32_t    last_launch_return_ms;  /* Timestamp of last child-exit for cooldown */
     Logger      logger;
     bool        needs_redraw;       /* Dirty flag — skip rendering when false */
+    /* What the panel shows, for draw_launcher()'s partial redraw.  drawn_valid
+     * false = nothing of ours is on screen (first frame, or a child just had
+     * the framebuffer), so the next draw is a full one. */
+    bool        drawn_valid;
+    int         drawn_page, drawn_selected, drawn_count;
+    bool        drawn_hint, drawn_music, drawn_effects;
+    FrameSched  sched;              /* Deadline pacing; stats go to the logger */
+    InputHub    hub;                /* Ends an idle wait when a device has input */
     /* ── the two audio toggles ───────────────────────────────────────────────
      * ⚠️ **No SAVE button, deliberately**: this is a games menu, not a settings
      * tab, and a toggle that needs a second tap to mean anything is a toggle
@@ -272,19 +282,25 @@ static int load_manifest(const char *path, AppEntry *app) {
     return 0;
 }
 
-static void load_icon(AppEntry *app) {
+/* Compiled for the launcher's surface: every tile redraw is then one memcpy
+ * per icon row instead of ICON_SIZE² fb_draw_pixel() calls.  No colour key —
+ * icons have always been drawn fully opaque. */
+static void load_icon(Launcher *l, AppEntry *app) {
+    app->icon = NULL;
     if (!app->icon_path[0]) return;
 
     int w, h;
     uint32_t *raw = ppm_load(app->icon_path, &w, &h);
     if (!raw) return;
 
-    if (w == ICON_SIZE && h == ICON_SIZE) {
-        app->icon_pixels = raw;
-    } else {
-        app->icon_pixels = ppm_scale(raw, w, h, ICON_SIZE, ICON_SIZE);
-        free(raw);
-    }
+    uint32_t *pixels = raw;
+    if (w != ICON_SIZE || h != ICON_SIZE)
+        pixels = ppm_scale(raw, w, h, ICON_SIZE, ICON_SIZE);
+    if (pixels)
+        app->icon = fb_sprite_compile(&l->fb, pixels, ICON_SIZE, 0, 0,
+                                      ICON_SIZE, ICON_SIZE, 0xFFFFFFFF);
+    if (pixels != raw) free(pixels);
+    free(raw);
 }
 
 /* ════════════════════════════════════════════════════════════════════════ */
@@ -293,8 +309,8 @@ static void load_icon(AppEntry *app) {
 
 static void free_icons(Launcher *l) {
     for (int i = 0; i < l->app_count; i++) {
-        free(l->apps[i].icon_pixels);
-        l->apps[i].icon_pixels = NULL;
+        fb_sprite_free(l->apps[i].icon);
+        l->apps[i].icon = NULL;
     }
 }
 
@@ -320,7 +336,7 @@ static int scan_apps(Launcher *l) {
 
         AppEntry app;
         if (load_manifest(path, &app) == 0) {
-            load_icon(&app);
+            load_icon(l, &app);
             l->apps[l->app_count++] = app;
             LOG_INFO(&l->logger, "Loaded: %-16s -> %s", app.name, app.exec_path);
         } else {
@@ -371,14 +387,6 @@ static void draw_letter_icon(Framebuffer *fb, int x, int y,
     fb_draw_text(fb, lx, ly, s, COLOR_WHITE, scale);
 }
 
-static void draw_ppm_icon(Framebuffer *fb, int x, int y,
-                          const uint32_t *pixels) {
-    for (int py = 0; py < ICON_SIZE; py++)
-        for (int px = 0; px < ICON_SIZE; px++)
-            fb_draw_pixel(fb, x + px, y + py,
-                          pixels[py * ICON_SIZE + px]);
-}
-
 #define TILE_RADIUS 12
 
 static void draw_tile(Framebuffer *fb, AppEntry *app,
@@ -392,8 +400,8 @@ static void draw_tile(Framebuffer *fb, AppEntry *app,
     int icon_x = tx + (tile_w - ICON_SIZE) / 2;
     int icon_y = ty + 8;
 
-    if (app->icon_pixels) {
-        draw_ppm_icon(fb, icon_x, icon_y, app->icon_pixels);
+    if (app->icon) {
+        fb_draw_sprite(fb, app->icon, icon_x, icon_y);
     } else {
         char letter = app->name[0];
         if (letter >= 'a' && letter <= 'z') letter -= 32;
@@ -507,7 +515,50 @@ static void draw_selection_border(Framebuffer *fb, int tx, int ty) {
     }
 }
 
+static bool show_input_hint(const Launcher *l) {
+    return l->input.gamepad_connected || l->input.keyboard_connected;
+}
+
+/* One tile as it is drawn in place: the border band outside it is cleared
+ * first, so a tile that loses the selection loses its border too. */
+static void redraw_tile(Launcher *l, int abs_idx) {
+    int start = l->current_page * apps_per_page;
+    if (abs_idx < start || abs_idx >= start + apps_per_page || abs_idx >= l->app_count)
+        return;
+    int tx, ty;
+    tile_xy(abs_idx - start, &tx, &ty);
+    fb_fill_rect(&l->fb, tx - 3, ty - 3, tile_w + 6, tile_h + 6, BG_COLOR);
+    draw_tile(&l->fb, &l->apps[abs_idx], tx, ty, abs_idx == l->selected_app);
+    if (abs_idx == l->selected_app)
+        draw_selection_border(&l->fb, tx, ty);
+}
+
+static void redraw_toggle(Launcher *l, ToggleSwitch *sw) {
+    fb_fill_rect(&l->fb, sw->x, sw->y, sw->track_w, sw->track_h, BG_COLOR);
+    toggle_draw(&l->fb, sw);
+}
+
+/* With damage tracking on (main()), fb_swap() copies only what was drawn, so
+ * a D-pad step or a toggle flip redraws just the two tiles or the one switch
+ * it changed — a few KB to the panel instead of the whole 1.5 MB screen.
+ * Anything that moves the layout (a page turn, a rescan, the input hint, a
+ * child that had the framebuffer) still clears and redraws everything. */
 static void draw_launcher(Launcher *l) {
+    if (l->drawn_valid && l->drawn_page == l->current_page &&
+        l->drawn_count == l->app_count && l->drawn_hint == show_input_hint(l)) {
+        if (l->drawn_selected != l->selected_app) {
+            redraw_tile(l, l->drawn_selected);
+            redraw_tile(l, l->selected_app);
+        }
+        if (l->drawn_music != l->music_sw.state)     redraw_toggle(l, &l->music_sw);
+        if (l->drawn_effects != l->effects_sw.state) redraw_toggle(l, &l->effects_sw);
+        l->drawn_selected = l->selected_app;
+        l->drawn_music    = l->music_sw.state;
+        l->drawn_effects  = l->effects_sw.state;
+        fb_swap(&l->fb);
+        return;
+    }
+
     fb_clear(&l->fb, BG_COLOR);
 
     /* Title */
@@ -547,10 +598,17 @@ static void draw_launcher(Launcher *l) {
     draw_page_dots(&l->fb, l->current_page, l->total_pages);
 
     /* Input hint */
-    if (l->input.gamepad_connected || l->input.keyboard_connected)
+    if (show_input_hint(l))
         fb_draw_text(&l->fb, SCREEN_VISIBLE_LEFT + 10, l->fb.height - 18,
                      "D-PAD: NAVIGATE  A/ENTER: LAUNCH", RGB(100, 100, 100), 1);
 
+    l->drawn_valid    = true;
+    l->drawn_page     = l->current_page;
+    l->drawn_selected = l->selected_app;
+    l->drawn_count    = l->app_count;
+    l->drawn_hint     = show_input_hint(l);
+    l->drawn_music    = l->music_sw.state;
+    l->drawn_effects  = l->effects_sw.state;
     fb_swap(&l->fb);
 }
 
@@ -734,6 +792,12 @@ static void launch_app(Launcher *l, int index,
     fb_set_bpp(fb_dev, 32);
     if (fb_init(&l->fb, fb_dev) != 0)
         LOG_ERROR(&l->logger, "Failed to re-initialise framebuffer");
+    fb_set_damage_tracking(&l->fb, true);   /* fb_init() turned it off */
+    l->drawn_valid = false;                 /* and blacked the panel */
+
+    /* The child's whole run was one iteration of the main loop — not an
+     * overrun, and not a frame time worth averaging. */
+    frame_sched_resync(&l->sched);
 
     /* Recompute grid layout (screen dimensions may differ after child) */
     compute_grid_layout(&l->fb);
@@ -784,6 +848,11 @@ static void launch_app(Launcher *l, int index,
     /* Zero the main input state so no stale held flags carry over */
     memset(&l->input, 0, sizeof(l->input));
 
+    /* Touch and every pad fd were reopened above: the idle wait's epoll set
+     * still names the closed ones, so rebuild it. */
+    input_hub_track(&l->hub, l->touch.fd, &l->gamepad);
+    l->hub_devices = l->gamepad.devices_changed;
+
     /* Record return time — main loop will ignore ALL input for
      * LAUNCH_COOLDOWN_MS after this, as defense-in-depth against
      * stale events from any source (keyboard, touch, mouse). */
@@ -802,6 +871,12 @@ static void launch_app(Launcher *l, int index,
 static volatile sig_atomic_t quit_flag = 0;
 static void on_sigterm(int sig) { (void)sig; quit_flag = 1; }
 
+/* FrameReportFn: one line of frame timing into the launcher's log. */
+static void log_frame_stats(const FrameStats *st, void *user) {
+    char line[200];
+    LOG_INFO((Logger *)user, "frames: %s", frame_stats_format(st, line, sizeof(line)));
+}
+
 int main(int argc, char *argv[]) {
     const char *fb_dev    = "/dev/fb0";
     const char *touch_dev = "/dev/input/touchscreen0";
@@ -850,11 +925,11 @@ int main(int argc, char *argv[]) {
     }
     touch_set_screen_size(&launcher.touch,
                           launcher.fb.width, launcher.fb.height);
+    fb_set_damage_tracking(&launcher.fb, true);   /* see draw_launcher() */
 
     /* Gamepad / keyboard / mouse */
     gamepad_init(&launcher.gamepad);
     memset(&launcher.input, 0, sizeof(launcher.input));
-    launcher.last_rescan_ms = 0;
     launcher.last_launch_return_ms = 0;
     launcher.selected_app = -1;  /* No keyboard selection until user navigates */
     launcher.needs_redraw = true;  /* Force initial frame draw */
@@ -874,6 +949,19 @@ int main(int argc, char *argv[]) {
         if (!config_audio_enabled(&cfg))
             LOG_INFO(&launcher.logger,
                      "audio_enabled=false — the master is off, so both toggles are moot");
+
+        /* The effect clips, loaded ONCE for every game this launcher starts: each
+         * maps the bank at audio_init() instead of reading its own copy off the SD
+         * on the first trigger of each sound.  Republished on every start, so a
+         * new fx_* path in the config is picked up at the next launcher restart;
+         * an edited file is caught sooner, by the mtime check in every game. */
+        if (config_audio_enabled(&cfg)) {
+            int n = audio_fx_bank_publish(AUDIO_FX_BANK_PATH, AUDIO_FX_BANK_RATE, NULL);
+            if (n < 0) LOG_ERROR(&launcher.logger, "Could not publish the effect bank to %s",
+                                 AUDIO_FX_BANK_PATH);
+            else       LOG_INFO(&launcher.logger, "Effect bank: %d clip(s) in %s",
+                                n, AUDIO_FX_BANK_PATH);
+        }
     }
     toggles_layout(&launcher);
 
@@ -881,8 +969,24 @@ int main(int argc, char *argv[]) {
     int count = scan_apps(&launcher);
     LOG_INFO(&launcher.logger, "Found %d app(s), %d page(s)", count, launcher.total_pages);
 
+    /* Pacing to absolute deadlines, so a frame's drawing is inside the 33 ms
+     * rather than added to it.  The launcher has no audio of its own, so there
+     * is no audio slot; its frame statistics go to the log every minute. */
+    frame_sched_init(&launcher.sched, FRAME_DELAY_ACTIVE_US, FRAME_DELAY_IDLE_US);
+    frame_sched_set_report(&launcher.sched, 60000, log_frame_stats, &launcher.logger);
+
+    /* The launcher is idle nearly all its life, so its first tap used to wait
+     * out up to a whole 100 ms idle period.  The hub ends that wait when touch
+     * or a pad has input; without epoll it falls back to the plain sleep. */
+    if (input_hub_init(&launcher.hub) != 0)
+        LOG_WARN(&launcher.logger, "epoll unavailable — idle frames sleep their full period");
+    input_hub_track(&launcher.hub, launcher.touch.fd, &launcher.gamepad);
+    launcher.hub_devices = launcher.gamepad.devices_changed;
+    frame_sched_set_wait(&launcher.sched, input_hub_wait, &launcher.hub);
+
     /* ── Main loop — polling-based, with dirty-flag rendering ───── */
     while (!quit_flag) {
+        frame_sched_begin(&launcher.sched);
         /* Save visual state for dirty detection */
         int old_selected = launcher.selected_app;
         int old_page     = launcher.current_page;
@@ -898,12 +1002,13 @@ int main(int argc, char *argv[]) {
         gamepad_poll(&launcher.gamepad, &launcher.input,
                      ts.x, ts.y, ts.pressed);
 
-        /* Periodic device rescan for hotplug */
-        uint32_t now = get_time_ms();
-        if (now - launcher.last_rescan_ms > RESCAN_INTERVAL_MS) {
-            launcher.last_rescan_ms = now;
-            gamepad_rescan(&launcher.gamepad);
+        /* gamepad_poll() adopts a pad as it is plugged in and drops one that
+         * is pulled out; either way the hub's epoll set names the old fds. */
+        if (launcher.gamepad.devices_changed != launcher.hub_devices) {
+            input_hub_track(&launcher.hub, launcher.touch.fd, &launcher.gamepad);
+            launcher.hub_devices = launcher.gamepad.devices_changed;
         }
+        uint32_t now = get_time_ms();
 
         /* ── Post-launch cooldown ──────────────────────────────────────
          * After returning from a child process, ignore ALL input for
@@ -916,11 +1021,12 @@ int main(int argc, char *argv[]) {
         if (launcher.last_launch_return_ms &&
             (now - launcher.last_launch_return_ms) < LAUNCH_COOLDOWN_MS) {
             /* Still in cooldown — draw once if needed, skip input */
-            if (launcher.needs_redraw) {
+            if (launcher.needs_redraw && frame_sched_render_due(&launcher.sched)) {
                 draw_launcher(&launcher);
                 launcher.needs_redraw = false;
             }
-            usleep(FRAME_DELAY_ACTIVE_US);
+            frame_sched_active(&launcher.sched);   /* cooldown polls at full rate */
+            frame_sched_end(&launcher.sched);
             continue;
         }
 
@@ -972,20 +1078,14 @@ int main(int argc, char *argv[]) {
         }
 
         /* Conditional rendering — only redraw when UI state has changed */
-        bool drew_frame = false;
-        if (launcher.needs_redraw) {
+        if (launcher.needs_redraw && frame_sched_render_due(&launcher.sched)) {
             draw_launcher(&launcher);
             launcher.needs_redraw = false;
-            drew_frame = true;
         }
 
-        /* Adaptive sleep — longer idle sleep reduces CPU usage significantly.
-         * ~30 fps when actively redrawing; ~10 fps polling when idle. */
-        if (drew_frame) {
-            usleep(FRAME_DELAY_ACTIVE_US);
-        } else {
-            usleep(FRAME_DELAY_IDLE_US);
-        }
+        /* Adaptive pace — longer idle period reduces CPU usage significantly.
+         * ~30 fps on a frame that asked to draw; ~10 fps polling when idle. */
+        frame_sched_end(&launcher.sched);
     }
 
     /* Cleanup */
@@ -994,6 +1094,7 @@ int main(int argc, char *argv[]) {
     free_icons(&launcher);
     fb_clear(&launcher.fb, COLOR_BLACK);
     fb_swap(&launcher.fb);
+    input_hub_close(&launcher.hub);
     gamepad_close(&launcher.gamepad);
     touch_close(&launcher.touch);
     fb_close(&launcher.fb);
@@ -26,7 +26,9 @@
 #include "../common/hardware.h"
 #include "../common/highscore.h"
 #include "../common/audio.h"
+#include "../common/frame_sched.h"
 #include "../common/gamepad.h"
+#include "../common/input_hub.h"
 
 /* ══════════════════════════════════════════════════════════════════════════
  *  Constants
@@ -192,7 +194,9 @@ typedef struct {
     int         level;        /* 1-based */
     int         bricks_left;
     int         paddle_w;
-    float       paddle_x;    /* centre X */
+    float       paddle_x;    /* centre X — what the ball and pickups hit */
+    float       paddle_lead; /* drawn centre minus paddle_x: the touch
+                              * prediction's lead, 0 with no finger down */
     Ball        balls[MAX_BALLS];
     int         ball_count;
     Brick       bricks[MAX_BRICKS];
@@ -224,6 +228,8 @@ static Framebuffer  fb;
 static TouchInput   touch;
 static GamepadManager gamepad_mgr;
 static InputState   gp_input;
+static InputHub     hub;            /* ends an idle frame's wait on input */
+static uint32_t     hub_devices;    /* gamepad_mgr.devices_changed it was built from */
 static Audio        audio;
 static GameState    game;
 static HighScoreTable hs;
@@ -234,8 +240,16 @@ static float ball_base_speed = BALL_BASE_SPEED;  /* runtime speed, adjusted for
 static GameOverScreen gos;  /* unified game over screen */
 /* Power-up / lost-ball LED flashes, advanced once per frame by the main loop. */
 static LedPulse     fx_pulse;
-static uint32_t last_rescan_ms = 0;
-#define RESCAN_INTERVAL_MS 5000
+
+/* The background, the play-area border and the bricks, painted into an
+ * offscreen layer and blitted as the frame's background: a brick is a gradient
+ * plus two alpha-blended edges, and a full wall of them redrawn every frame is
+ * most of the frame's drawing for a picture that changes only on a hit.  So
+ * every site that changes a brick invalidates it — create_bricks(),
+ * detonate_brick() and the ball's brick collision.  If the surface could not
+ * be allocated, the frame draws the three straight onto fb. */
+static FbLayer wall;
+static bool wall_ok = false;
 
 /* UI buttons */
 static Button btn_menu, btn_exit;
@@ -441,6 +455,7 @@ static void create_bricks(void) {
     int brick_w = (AREA_W - BRICK_PAD * (brick_cols + 1)) / brick_cols;
     game.brick_count = 0;
     game.bricks_left = 0;
+    fb_layer_invalidate(&wall);
     
     /* Scale the level's row count proportionally to the available brick_rows.
      * In landscape: brick_rows == BRICK_ROWS_BASE (8), so scaled_rows == lv->rows (unchanged).
@@ -771,6 +786,7 @@ static void init_level(void) {
     reset_effects();
     apply_paddle_width();
     game.paddle_x = AREA_X + AREA_W / 2;
+    game.paddle_lead = 0;
     game.ball_count = 0;
 
     create_bricks();
@@ -808,6 +824,7 @@ static void detonate_brick(int brick_idx) {
     if (brick_is_destroyed(br)) return;  /* Already destroyed (e.g., by ball in the meantime) */
 
     br->health = 0;
+    fb_layer_invalidate(&wall);
     if (br->type != BRICK_INDESTRUCTIBLE) {
         game.bricks_left--;
     }
@@ -947,7 +964,10 @@ static void update_balls(void) {
                 b->y + BALL_RADIUS <= br->y || b->y - BALL_RADIUS >= br->y + br->h)
                 continue;
 
-            /* Hit! Handle special brick types */
+            /* Hit! Handle special brick types.  A bounce off an indestructible
+             * brick changes nothing, but repainting for it is cheaper than
+             * tracking which branch did. */
+            fb_layer_invalidate(&wall);
             bool brick_destroyed = false;
             
             if (br->type == BRICK_INDESTRUCTIBLE) {
@@ -1252,7 +1272,7 @@ static void draw_hud(void) {
     }
 }
 
-static void draw_bricks(void) {
+static void draw_bricks(Surface *t) {
     for (int i = 0; i < game.brick_count; i++) {
         Brick *b = &game.bricks[i];
         if (brick_is_destroyed(b)) continue;
@@ -1270,14 +1290,14 @@ static void draw_bricks(void) {
         }
 
         /* Gradient fill */
-        fb_fill_rect_gradient(&fb, bx, by, b->w, b->h, ctop, cbot);
+        fb_fill_rect_gradient(t, bx, by, b->w, b->h, ctop, cbot);
 
         /* Subtle highlight on top edge */
-        fb_fill_rect_alpha(&fb, bx + 1, by, b->w - 2, 2,
+        fb_fill_rect_alpha(t, bx + 1, by, b->w - 2, 2,
                            COLOR_WHITE, 60);
 
         /* Bottom shadow */
-        fb_fill_rect_alpha(&fb, bx + 1, by + b->h - 2, b->w - 2, 2,
+        fb_fill_rect_alpha(t, bx + 1, by + b->h - 2, b->w - 2, 2,
                            COLOR_BLACK, 80);
 
         /* Special brick indicators */
@@ -1289,19 +1309,19 @@ static void draw_bricks(void) {
                 int x2 = bx;
                 int y2 = by + s;
                 if (x1 < bx + b->w && y2 < by + b->h) {
-                    fb_draw_line(&fb, x1, y1, x2, y2, RGB(120, 120, 120));
+                    fb_draw_line(t, x1, y1, x2, y2, RGB(120, 120, 120));
                 }
             }
         } else if (b->type == BRICK_BONUS) {
             /* Star/sparkle effect for bonus bricks */
             int cx = bx + b->w / 2;
             int cy = by + b->h / 2;
-            fb_draw_line(&fb, cx - 4, cy, cx + 4, cy, COLOR_WHITE);
-            fb_draw_line(&fb, cx, cy - 4, cx, cy + 4, COLOR_WHITE);
+            fb_draw_line(t, cx - 4, cy, cx + 4, cy, COLOR_WHITE);
+            fb_draw_line(t, cx, cy - 4, cx, cy + 4, COLOR_WHITE);
         } else if (b->type == BRICK_EXPLOSIVE) {
             /* X pattern for explosive bricks */
-            fb_draw_line(&fb, bx + 2, by + 2, bx + b->w - 2, by + b->h - 2, RGB(255, 255, 0));
-            fb_draw_line(&fb, bx + b->w - 2, by + 2, bx + 2, by + b->h - 2, RGB(255, 255, 0));
+            fb_draw_line(t, bx + 2, by + 2, bx + b->w - 2, by + b->h - 2, RGB(255, 255, 0));
+            fb_draw_line(t, bx + b->w - 2, by + 2, bx + 2, by + b->h - 2, RGB(255, 255, 0));
         }
 
         /* Health number for multi-hit bricks */
@@ -1309,14 +1329,22 @@ static void draw_bricks(void) {
             char num[8];
             snprintf(num, sizeof(num), "%d", b->health);
             int tw = (int)strlen(num) * 6;
-            fb_draw_text(&fb, bx + b->w / 2 - tw / 2,
+            fb_draw_text(t, bx + b->w / 2 - tw / 2,
                          by + b->h / 2 - 3, num, COLOR_WHITE, 1);
         }
     }
 }
 
+/* Where the paddle is DRAWN: paddle_x plus the touch prediction's lead, kept
+ * inside the wall for a width that changed since the lead was taken. */
+static float paddle_draw_x(void) {
+    return clampf(game.paddle_x + game.paddle_lead,
+                  AREA_X + game.paddle_w / 2.0f,
+                  AREA_X + AREA_W - game.paddle_w / 2.0f);
+}
+
 static void draw_paddle(void) {
-    int px = (int)game.paddle_x - game.paddle_w / 2;
+    int px = (int)paddle_draw_x() - game.paddle_w / 2;
     int py = PADDLE_Y;
 
     /* Glow under paddle */
@@ -1337,7 +1365,8 @@ static void draw_balls(void) {
         Ball *b = &game.balls[i];
         if (!b->active) continue;
 
-        int bx = (int)b->x;
+        /* A stuck ball sits on the paddle as drawn, not a lead behind it. */
+        int bx = b->stuck ? (int)(b->x - game.paddle_x + paddle_draw_x()) : (int)b->x;
         int by = (int)b->y;
         uint32_t col = b->fireball ? BALL_FIRE : BALL_COLOR;
 
@@ -1408,19 +1437,32 @@ static void draw_powerups(void) {
     }
 }
 
-static void draw_play_area_border(void) {
+static void draw_play_area_border(Surface *t) {
     /* Subtle border around play area */
-    fb_draw_rect(&fb, AREA_X - 1, AREA_Y - 1, AREA_W + 2, AREA_H + 2,
+    fb_draw_rect(t, AREA_X - 1, AREA_Y - 1, AREA_W + 2, AREA_H + 2,
                  RGB(40, 50, 80));
 }
 
-static void draw_game_screen(void) {
-    fb_clear(&fb, BG_COLOR);
+/* The wall layer's paint function. */
+static void paint_wall(Surface *s, void *user) {
+    fb_clear(s, BG_COLOR);
+    draw_play_area_border(s);
+    draw_bricks(s);
+}
 
-    /* Screen shake offset — applied via framebuffer draw offset */
+static void draw_game_screen(void) {
+    /* Screen shake offset — applied via framebuffer draw offset.  A shaken
+     * frame draws the wall directly: the border's right edge sits one pixel
+     * past the screen, outside anything the layer holds, and the shake pulls
+     * it into view.  Shakes are a few frames long, the layer covers the rest. */
     fb_set_draw_offset(&fb, (int)game.shake_x, (int)game.shake_y);
-    draw_play_area_border();
-    draw_bricks();
+    if (wall_ok && !fb.draw_offset_x && !fb.draw_offset_y) {
+        fb_layer_blit(&fb, &wall, 0, 0);
+    } else {
+        fb_clear(&fb, BG_COLOR);
+        draw_play_area_border(&fb);
+        draw_bricks(&fb);
+    }
     draw_paddle();
     draw_balls();
     draw_powerups();
@@ -1508,10 +1550,10 @@ static void handle_input(void) {
     /* Poll gamepad/keyboard/mouse through unified API */
     gamepad_poll(&gamepad_mgr, &gp_input, st.x, st.y, st.pressed);
 
-    /* Periodic device rescan for hotplug support */
-    if (now - last_rescan_ms > RESCAN_INTERVAL_MS) {
-        last_rescan_ms = now;
-        gamepad_rescan(&gamepad_mgr);
+    /* A pad plugged in or pulled out has new fds; rebuild the hub's set. */
+    if (gamepad_mgr.devices_changed != hub_devices) {
+        input_hub_track(&hub, touch.fd, &gamepad_mgr);
+        hub_devices = gamepad_mgr.devices_changed;
     }
 
     /* BTN_BACK always exits to launcher */
@@ -1573,11 +1615,20 @@ static void handle_input(void) {
          * snap to an unexpected position when switching input methods.
          * ────────────────────────────────────────────────────────────── */
 
-        /* Touch: absolute positioning (only when actively touching the screen) */
+        /* Touch: absolute positioning (only when actively touching the screen).
+         * The game's paddle — what update_balls() and the pickups collide
+         * with — is the MEASURED st.x; the prediction only moves where it is
+         * drawn (paddle_lead), so a wrong guess never decides a bounce or a
+         * lost ball (common/touch_input.h, MOTION PREDICTION). */
+        game.paddle_lead = 0;
         if (st.held || st.pressed) {
             game.paddle_x = clampf((float)st.x,
                                    AREA_X + game.paddle_w / 2.0f,
                                    AREA_X + AREA_W - game.paddle_w / 2.0f);
+            game.paddle_lead = clampf((float)st.pred_x,
+                                      AREA_X + game.paddle_w / 2.0f,
+                                      AREA_X + AREA_W - game.paddle_w / 2.0f)
+                             - game.paddle_x;
         }
 
         /* Mouse: delta-based movement — track previous position and apply
@@ -1739,6 +1790,24 @@ static void handle_input(void) {
     }
 }
 
+/** The once-a-minute report: the frame line, then the same minute's hit sounds
+ *  as trigger→DAC latency (common/audio.h audio_latency_stats()).  Side by side
+ *  because they are read together — a slow p99 frame with a flat latency line
+ *  is a render problem, both moving together is the stream's lead being eaten.
+ *  Both windows close here, so each line covers the same minute. */
+static void report_minute(const FrameStats *st, void *user)
+{
+    frame_stats_print(st, user);
+
+    AudioLatencyStats lat;
+    char line[160];
+    audio_latency_stats(&audio, &lat);
+    if (lat.count || lat.missed)
+        printf("brick_breaker: audio %s\n", audio_lat_format(&lat, line, sizeof(line)));
+    fflush(stdout);
+    audio_latency_reset(&audio);
+}
+
 /* ══════════════════════════════════════════════════════════════════════════
  *  Main
  * ══════════════════════════════════════════════════════════════════════════ */
@@ -1775,11 +1844,19 @@ int main(int argc, char *argv[]) {
         fprintf(stderr, "Failed to initialise framebuffer\n");
         return 1;
     }
+    wall_ok = fb_layer_init(&wall, &fb, (int)fb.width, (int)fb.height,
+                            paint_wall, NULL) == 0;
     if (touch_init(&touch, touch_device) < 0) {
         fprintf(stderr, "Failed to initialise touch input\n");
         fb_close(&fb);
         return 1;
     }
+    /* The paddle is drawn where the finger will be when this frame is on the
+     * panel, one active frame on, rather than where it was at the last report
+     * (common/touch_input.h, MOTION PREDICTION).  Buttons still hit-test the
+     * measured st.x/st.y, and so do the ball and the pickups: the paddle they
+     * collide with is the measured one (handle_input(), paddle_lead). */
+    touch_set_prediction(&touch, true, FRAME_DELAY_ACTIVE_US, 50);
 
     hw_init();
     hw_set_backlight(100);
@@ -1796,6 +1873,11 @@ int main(int argc, char *argv[]) {
      * rather than muting, so there is nothing for a game to do about it, and
      * audio_close() reports which path actually ran. */
     audio_cont_enable(&audio, true);
+    /* Opt-in (`audio_server` in the config): the bus in a forked process of its
+     * own, so the name-entry screen and the touch drains, which do not pump,
+     * stop starving the stream.  Unchecked for the same reason as the line
+     * above — a refusal leaves the in-loop path exactly as it was. */
+    if (audio_server_enabled(&audio)) audio_server_start(&audio);
     srand(time(NULL));
 
     /* Gamepad init */
@@ -1860,9 +1942,26 @@ int main(int argc, char *argv[]) {
 
     printf("Brick Breaker started!\n");
 
+    FrameSched sched;
+    frame_sched_init(&sched, FRAME_DELAY_ACTIVE_US, FRAME_DELAY_IDLE_US);
+    frame_sched_set_audio(&sched, audio_pump_slot, &audio,
+                          audio_cont_service_interval_us(&audio) / 2);
+    frame_sched_set_report(&sched, 60000, report_minute, "brick_breaker: frames");
+
+    /* The welcome, pause and game-over screens idle at 100 ms, and with the
+     * audio server owning the stream so does the rest; the hub ends an idle
+     * frame's sleep when touch or a pad has input (common/input_hub.h), and
+     * without epoll leaves it a sleep. */
+    if (input_hub_init(&hub) != 0)
+        fprintf(stderr, "brick_breaker: epoll unavailable, idle frames sleep their full period\n");
+    input_hub_track(&hub, touch.fd, &gamepad_mgr);
+    hub_devices = gamepad_mgr.devices_changed;
+    frame_sched_set_wait(&sched, input_hub_wait, &hub);
+
     /* ── main loop ──────────────────────────────────────────────────── */
     bool needs_redraw = true;
     while (running) {
+        frame_sched_begin(&sched);
         frame_time_ms = get_time_ms();
 
         GameScreen prev_screen = game.screen;
@@ -1891,7 +1990,7 @@ int main(int argc, char *argv[]) {
         if (game.screen == SCREEN_GAME_OVER && gameover_needs_redraw(&gos))
             needs_redraw = true;
 
-        if (needs_redraw) {
+        if (needs_redraw && frame_sched_render_due(&sched)) {
             switch (game.screen) {
             case SCREEN_WELCOME:        draw_welcome();        break;
             case SCREEN_PLAYING:        draw_game_screen();    break;
@@ -1923,21 +2022,22 @@ int main(int argc, char *argv[]) {
             }
             }
             fb_swap(&fb);
+            needs_redraw = false;
         }
 
-        /* Service the stream on EVERY iteration, drawing or not — it holds one
-         * lead (~139 ms on the OSS shim) and a skipped service is an audible
-         * gap.  ⚠️ audio_pump_active() belongs in the pacing decision: it is
-         * unconditionally true while the continuous stream is live, and
-         * FRAME_DELAY_IDLE_US (100 ms) is well above the ~55 ms service ceiling
-         * the library measures for itself (common/audio_out.h). */
-        audio_pump(&audio);
-        usleep((needs_redraw || audio_pump_active(&audio))
-               ? FRAME_DELAY_ACTIVE_US : FRAME_DELAY_IDLE_US);
-        needs_redraw = false;  /* reset for next frame */
+        /* frame_sched_end() runs the audio slot (audio_pump_slot) on EVERY
+         * iteration, drawing or not, and again in slices through the wait — the
+         * stream holds one lead (~139 ms on the OSS shim) and a skipped service
+         * is an audible gap.  ⚠️ audio_pump_active() is still in the pacing
+         * decision, as the slot's return value: it is unconditionally true
+         * while the continuous stream is live.  The wait is to an absolute
+         * deadline, so this frame's work is inside FRAME_DELAY_ACTIVE_US rather
+         * than added to it (common/frame_sched.h). */
+        frame_sched_end(&sched);
     }
 
     /* Clean up */
+    input_hub_close(&hub);
     gamepad_close(&gamepad_mgr);
     touch_close(&touch);
     hw_leds_off();
@@ -1945,6 +2045,7 @@ int main(int argc, char *argv[]) {
     audio_close(&audio);
     fb_clear(&fb, COLOR_BLACK);
     fb_swap(&fb);
+    fb_layer_free(&wall);
     fb_close(&fb);
 
     printf("Brick Breaker ended.\n");
@@ -14,7 +14,7 @@
 # <dir>/root/<device-path>, with a declared-mode manifest — the layout
 # ../release.sh publishes and ../commissioning/commission-offline.sh installs from
 # (../IMPROVEMENT_PLAN.md F9, F10).  It always builds first: this component's
-# 35 targets take well under a minute, so there is no reason for a
+# 36 targets take well under a minute, so there is no reason for a
 # stage-what-is-already-there mode and therefore no way to bundle a stale
 # binary.  (ScummVM, whose link is ~2 minutes, does have one.)
 
@@ -79,7 +79,7 @@ err()  { echo -e "[$(date '+%H:%M:%S')] ${RED}  ✗ $*${NC}"; exit 1; }
 
 # ── argument validation ─────────────────────────────────────────────────────
 # Validate BEFORE building.  A bad first argument used to surface only at the
-# first ssh, i.e. after all 35 targets had already been compiled.
+# first ssh, i.e. after all 36 targets had already been compiled.
 usage() {
     echo "Usage: $0 [<ip>] [set-default]"
     echo "       $0 --bundle <dir>"
@@ -150,24 +150,34 @@ mkdir -p build
 
 step() { echo "[$1] $2..."; }
 
-step " 1/35" "framebuffer";  $CC $WARN -O2 -static -c common/framebuffer.c    -o build/framebuffer.o
-step " 2/35" "touch_input";  $CC $WARN -O2 -static -c common/touch_input.c    -o build/touch_input.o
-step " 3/35" "touch_calib";  $CC $WARN -O2 -static -c common/touch_calib.c    -o build/touch_calib.o
-step " 4/35" "hardware";     $CC $WARN -O2 -static -c common/hardware.c        -o build/hardware.o
-step " 5/35" "common";       $CC $WARN -O2 -static -c common/common.c          -o build/common.o
-step " 6/35" "highscore";    $CC $WARN -O2 -static -c common/highscore.c       -o build/highscore.o
-step " 7/35" "keyboard";     $CC $WARN -O2 -static -c common/keyboard.c        -o build/keyboard.o
-step " 8/35" "ui_layout";    $CC $WARN -O2 -static -c common/ui_layout.c       -o build/ui_layout.o
-step " 9/35" "audio";        $CC $WARN -O2 -static -c common/audio.c           -o build/audio.o
-step "10/35" "audio_gen";    $CC $WARN -O2 -static -c common/audio_gen.c       -o build/audio_gen.o
-step "11/35" "audio_out";    $CC $WARN -O2 -static -c common/audio_out.c       -o build/audio_out.o
-step "12/35" "audio_wav";    $CC $WARN -O2 -static -c common/audio_wav.c       -o build/audio_wav.o
-step "13/35" "ppm";          $CC $WARN -O2 -static -c common/ppm.c             -o build/ppm.o
-step "14/35" "logger";       $CC $WARN -O2 -static -c common/logger.c          -o build/logger.o
-step "15/35" "config";       $CC $WARN -O2 -static -c common/config.c          -o build/config.o
-step "16/35" "gamepad";      $CC $WARN -O2 -static -c common/gamepad.c         -o build/gamepad.o
-
-COMMON_OBJ="build/framebuffer.o build/touch_input.o build/hardware.o build/common.o build/highscore.o build/keyboard.o build/audio.o build/audio_gen.o build/audio_out.o build/audio_wav.o build/config.o"
+# framebuffer.o and audio_gen.o get -mfpu=neon: the span fills and the mix
+# bus's accumulate/clamp passes have NEON behind #ifdef __ARM_NEON, the same
+# per-object flag ScummVM's module.mk gives its blit (the Cortex-A8 has NEON;
+# the toolchain default FPU does not advertise it).  Everything else stays on
+# the default FPU.
+step " 1/41" "framebuffer";  $CC $WARN -O2 -static -mfpu=neon -c common/framebuffer.c -o build/framebuffer.o
+step " 2/41" "touch_input";  $CC $WARN -O2 -static -c common/touch_input.c    -o build/touch_input.o
+step " 3/41" "input_rec";    $CC $WARN -O2 -static -c common/input_rec.c      -o build/input_rec.o
+step " 4/41" "input_lat";    $CC $WARN -O2 -static -c common/input_lat.c      -o build/input_lat.o
+step " 5/41" "touch_calib";  $CC $WARN -O2 -static -c common/touch_calib.c    -o build/touch_calib.o
+step " 6/41" "hardware";     $CC $WARN -O2 -static -c common/hardware.c        -o build/hardware.o
+step " 7/41" "common";       $CC $WARN -O2 -static -c common/common.c          -o build/common.o
+step " 8/41" "highscore";    $CC $WARN -O2 -static -c common/highscore.c       -o build/highscore.o
+step " 9/41" "keyboard";     $CC $WARN -O2 -static -c common/keyboard.c        -o build/keyboard.o
+step "10/41" "ui_layout";    $CC $WARN -O2 -static -c common/ui_layout.c       -o build/ui_layout.o
+step "11/41" "audio";        $CC $WARN -O2 -static -c common/audio.c           -o build/audio.o
+step "12/41" "audio_gen";    $CC $WARN -O2 -static -mfpu=neon -c common/audio_gen.c -o build/audio_gen.o
+step "13/41" "audio_out";    $CC $WARN -O2 -static -Iarm-deps/include -c common/audio_out.c -o build/audio_out.o
+step "14/41" "audio_wav";    $CC $WARN -O2 -static -c common/audio_wav.c       -o build/audio_wav.o
+step "15/41" "ppm";          $CC $WARN -O2 -static -c common/ppm.c             -o build/ppm.o
+step "16/41" "logger";       $CC $WARN -O2 -static -c common/logger.c          -o build/logger.o
+step "17/41" "config";       $CC $WARN -O2 -static -c common/config.c          -o build/config.o
+step "18/41" "gamepad";      $CC $WARN -O2 -static -c common/gamepad.c         -o build/gamepad.o
+step "19/41" "frame_sched";  $CC $WARN -O2 -static -c common/frame_sched.c     -o build/frame_sched.o
+step "20/41" "input_hub";    $CC $WARN -O2 -static -c common/input_hub.c       -o build/input_hub.o
+step "21/41" "input_hotplug"; $CC $WARN -O2 -static -c common/input_hotplug.c  -o build/input_hotplug.o
+
+COMMON_OBJ="build/framebuffer.o build/touch_input.o build/input_rec.o build/input_lat.o build/hardware.o build/common.o build/highscore.o build/keyboard.o build/audio.o build/audio_gen.o build/audio_out.o build/audio_wav.o build/config.o build/frame_sched.o arm-deps/lib/libtinyalsa.a"
 
 # audio_gen.o rides with audio.o and is not optional: audio.c calls into it for
 # every frame count, every byte count, the envelope and the write loop
@@ -191,76 +201,120 @@ COMMON_OBJ="build/framebuffer.o build/touch_input.o build/hardware.o build/commo
 # which is the right failure.  It has no device in it at all (plain stdio), so it
 # is also the one audio object a host test needs no shim to reach.
 
+# frame_sched.o is the deadline pacing every main loop ends in (common/
+# frame_sched.h), so it goes wherever a loop does.  It is plain libc —
+# clock_gettime() and clock_nanosleep(), no pthread, no timerfd — and does not
+# link logger.o: an app with a Logger passes a report callback instead.
+
+# input_rec.o is the record/replay behind RW_INPUT_RECORD / RW_INPUT_REPLAY
+# (common/input_rec.h).  touch_input.c and gamepad.c reach it only through weak
+# symbols, so it is in COMMON_OBJ to put replay in every app, and everything
+# that builds touch_input.c without it — vnc_client, build-usb-test.sh, the host
+# tests — still links, with the hooks resolving to NULL.
+#
+# input_lat.o rides beside it on the same terms (common/input_lat.h): the
+# input→swap latency every app publishes to /dev/shm/roomwizard-inputlat for
+# device_tools' INPUT LATENCY page.  framebuffer.c's fb_swap() is its third
+# weak caller, so a binary that links framebuffer.o without it still links.
+
+# libtinyalsa.a rides at the END of COMMON_OBJ because audio_out.o is its only
+# consumer and an archive resolves only what an object BEFORE it asked for.  It
+# is the ALSA backend (`audio_backend = alsa` in the config, audio_out_open_alsa()),
+# compiled in because step 13 puts arm-deps/include on the path — audio_out.c
+# detects the header with __has_include, exactly as it detects OSS's.  Static, no
+# dlopen (build-deps.sh proves both), so the binaries stay self-contained; a game
+# that never selects ALSA carries pcm.o's few KB and never calls it.
+
+# input_hub.o is NOT in COMMON_OBJ either: it is the epoll set behind an idle
+# frame's wait (common/input_hub.h), and only a loop that hands it to
+# frame_sched_set_wait() links it — app_launcher, which idles the most, and
+# tetris, samegame and brick_breaker, whose menus idle (and whose every frame
+# does once the audio server owns the stream).
+HUB_OBJ="build/input_hub.o"
+
+# gamepad.o always travels with input_hotplug.o (common/input_hotplug.h): the
+# inotify watch on /dev/input that replaced every game's five-second rescan
+# timer.  gamepad_init() opens it and gamepad_poll() drains it, so a direct
+# call rather than a weak hook — the link fails without it, which is right.
+GAMEPAD_OBJ="build/gamepad.o build/input_hotplug.o"
+
 # touch_calib.o is NOT in COMMON_OBJ: only the two tools that measure the touch
 # mapping need it, and there is no reason to carry the target table into eight
 # games.  Both of them must link it, though — it is the one place the fit lives.
 CALIB_OBJ="build/touch_calib.o"
 
-step "17/35" "snake";        $CC $WARN -O2 -static snake/snake.c             $COMMON_OBJ build/gamepad.o -o build/snake         -lm
-step "18/35" "tetris";       $CC $WARN -O2 -static tetris/tetris.c           $COMMON_OBJ build/gamepad.o -o build/tetris        -lm
-step "19/35" "pong";         $CC $WARN -O2 -static pong/pong.c               $COMMON_OBJ build/gamepad.o -o build/pong          -lm
+step "22/41" "snake";        $CC $WARN -O2 -static snake/snake.c             $COMMON_OBJ $GAMEPAD_OBJ -o build/snake         -lm
+step "23/41" "tetris";       $CC $WARN -O2 -static tetris/tetris.c           $COMMON_OBJ $GAMEPAD_OBJ $HUB_OBJ -o build/tetris        -lm
+step "24/41" "pong";         $CC $WARN -O2 -static pong/pong.c               $COMMON_OBJ $GAMEPAD_OBJ -o build/pong          -lm
 
-step "20/35" "brick_breaker"
-$CC $WARN -O2 -static brick_breaker/brick_breaker.c $COMMON_OBJ build/gamepad.o -o build/brick_breaker -lm
+step "25/41" "brick_breaker"
+$CC $WARN -O2 -static brick_breaker/brick_breaker.c $COMMON_OBJ $GAMEPAD_OBJ $HUB_OBJ -o build/brick_breaker -lm
 
-step "21/35" "samegame"
-$CC $WARN -O2 -static samegame/samegame.c $COMMON_OBJ build/gamepad.o -o build/samegame -lm
+step "26/41" "samegame"
+$CC $WARN -O2 -static samegame/samegame.c $COMMON_OBJ $GAMEPAD_OBJ $HUB_OBJ -o build/samegame -lm
 
-step "22/35" "frogger"
-$CC $WARN -O2 -static frogger/frogger.c $COMMON_OBJ build/gamepad.o -o build/frogger -lm
+step "27/41" "frogger"
+$CC $WARN -O2 -static frogger/frogger.c $COMMON_OBJ $GAMEPAD_OBJ -o build/frogger -lm
 
-step "23/35" "platformer"
-$CC $WARN -O2 -static platformer/platformer.c $COMMON_OBJ build/gamepad.o -o build/platformer -lm
+step "28/41" "platformer"
+$CC $WARN -O2 -static platformer/platformer.c $COMMON_OBJ $GAMEPAD_OBJ -o build/platformer -lm
 
-step "24/35" "game_selector"
-$CC $WARN -O2 -static -I. game_selector/game_selector.c $COMMON_OBJ build/gamepad.o build/ui_layout.o -o build/game_selector -lm
+step "29/41" "game_selector"
+$CC $WARN -O2 -static -I. game_selector/game_selector.c $COMMON_OBJ $GAMEPAD_OBJ build/ui_layout.o -o build/game_selector -lm
 
-step "25/35" "app_launcher"
-$CC $WARN -O2 -static -I. app_launcher/app_launcher.c $COMMON_OBJ build/gamepad.o build/ppm.o build/logger.o -o build/app_launcher -lm
+step "30/41" "app_launcher"
+$CC $WARN -O2 -static -I. app_launcher/app_launcher.c $COMMON_OBJ $GAMEPAD_OBJ $HUB_OBJ build/ppm.o build/logger.o -o build/app_launcher -lm
 
-step "26/35" "hardware_test"
+step "31/41" "hardware_test"
 $CC $WARN -O2 -static -I. hardware_test/hardware_test_gui.c $COMMON_OBJ build/ui_layout.o -o build/hardware_test -lm
 
-step "27/35" "hardware_config"
+step "32/41" "hardware_config"
 $CC $WARN -O2 -static -I. hardware_config/hardware_config.c $COMMON_OBJ build/ui_layout.o -o build/hardware_config -lm
 
-step "28/35" "hardware_diag"
+step "33/41" "hardware_diag"
 $CC $WARN -O2 -static -I. hardware_diag/hardware_diag.c $COMMON_OBJ -o build/hardware_diag -lm
 
-step "29/35" "audio_touch_test"
+step "34/41" "audio_touch_test"
 $CC $WARN -O2 -static -I. \
   tests/audio_touch_test.c \
   $COMMON_OBJ build/logger.o build/ppm.o \
   -o build/audio_touch_test -lm
 
-step "30/35" "backlight"
+step "35/41" "backlight"
 $CC $WARN -O2 -static -I. backlight/backlight.c build/hardware.o build/config.o -o build/backlight
 
 # Owns the calibration wizard (Display tab), which is why it links CALIB_OBJ.
 # The standalone unified_calibrate was folded into it and deleted — it was a
 # second, independent copy of the same 9-tap fit, carrying the same defect.
-step "31/35" "device_tools"
+step "36/41" "device_tools"
 $CC $WARN -O2 -static -I. device_tools/device_tools.c $COMMON_OBJ $CALIB_OBJ build/ui_layout.o -o build/device_tools -lm
 
 # Touch diagnostics. All three were previously absent from this script, which is
 # why the deployed touch_trace was stale (pre-bezel) and touch_inject got a
 # .hidden marker below without ever being built.
-step "32/35" "touch_raw"
+step "37/41" "touch_raw"
 $CC $WARN -O2 -static -I. tests/touch_raw.c $COMMON_OBJ $CALIB_OBJ -o build/touch_raw -lm
 
-step "33/35" "touch_trace"
+step "38/41" "touch_trace"
 $CC $WARN -O2 -static -I. tests/touch_trace.c $COMMON_OBJ -o build/touch_trace -lm
 
-step "34/35" "touch_inject"
+step "39/41" "touch_inject"
 $CC $WARN -O2 -static -I. tests/touch_inject.c -o build/touch_inject
 
 # The mix bus, driven by hand.  Groups I/J/K of tests/audio_gen_test.c cover the
 # arithmetic; whether two sounds are AUDIBLE as two, and whether the ~60 ms
 # minimum-tone rule survives a stream that is never reset, need an ear at the
 # panel (../IMPROVEMENT_PLAN.md F1 Phase 3, panel items 12 and 14).
-step "35/35" "audio_mix_test"
+step "40/41" "audio_mix_test"
 $CC $WARN -O2 -static -I. tests/audio_mix_test.c $COMMON_OBJ -o build/audio_mix_test -lm
 
+# What the engine costs on the A8 itself: a CSV of ns/frame and real-time factor
+# per stage and per voice count, the full audio_pump() path on a null device.
+# No panel needed — run it over SSH with the games stopped.  Hidden: it draws
+# nothing and would sit in the grid as a dead tile.
+step "41/41" "audio_bench"
+$CC $WARN -O2 -static -I. tests/audio_bench.c $COMMON_OBJ -o build/audio_bench -lm
+
 # Collect icon files from source dirs → build/icons/
 mkdir -p build/icons
 ICON_COUNT=0
@@ -287,7 +341,7 @@ echo "  Wrote $(ls build/apps/*.app 2>/dev/null | wc -l) app manifest(s) → bui
 GAMES_BINARIES=(snake tetris pong brick_breaker samegame frogger platformer
                 game_selector hardware_test hardware_config hardware_diag
                 audio_touch_test audio_mix_test backlight device_tools
-                touch_raw touch_trace touch_inject)
+                touch_raw touch_trace touch_inject audio_bench)
 
 # .hidden markers: hidden from game_selector's grid but still reachable over SSH.
 # Data rather than a loop body in the remote heredoc, so --bundle ships the same
@@ -296,7 +350,7 @@ GAMES_BINARIES=(snake tetris pong brick_breaker samegame frogger platformer
 # unified_calibrate, none of which were ever built, so the device accumulated
 # markers for binaries that did not exist and `ls /opt/games` lied about what
 # was installed.
-HIDDEN_MARKERS=(touch_inject touch_raw touch_trace backlight
+HIDDEN_MARKERS=(touch_inject touch_raw touch_trace backlight audio_bench
                 hardware_test hardware_config hardware_diag)
 
 echo ""
@@ -4,8 +4,8 @@
 # Today that is exactly one library: **tinyalsa**, for the native-ALSA audio
 # backend (../IMPROVEMENT_PLAN.md F1).  The OSS /dev/dsp shim it replaces needs no
 # library at all, so this script is new with F1 Phase 1 and has one consumer for
-# now — but two are planned: native_apps' own common/audio_dev.c (Phase 4) and the
-# ScummVM backend's alsa-mixer.cpp (Phase 5).  ScummVM already reaches into
+# now — native_apps' own ALSA backend in common/audio_out.c (Phase 4) — and one
+# planned: the ScummVM backend's alsa-mixer.cpp (Phase 5).  ScummVM already reaches into
 # native_apps/common/ for framebuffer.o and touch_input.o, so it will reach here
 # the same way rather than building a second copy.  ONE tinyalsa, one pinned
 # version, one LICENSE.md row.
@@ -151,13 +151,16 @@ assert_links() {
     cat > "$tmp/linktest.c" <<'LINKTEST'
 #include <string.h>
 #include <tinyalsa/asoundlib.h>
-/* Drives the surface common/audio_dev.c will use: open, negotiate, write, close. */
+/* Drives the surface common/audio_out.c's ALSA backend uses: open, the grant,
+   the mmap transfer, XRUN recovery, close — plus writei for ScummVM's. */
 int main(void)
 {
     struct pcm_config cfg;
     struct pcm *p;
     short buf[64];
     int written;
+    void *area;
+    unsigned offset, frames = 32;
 
     memset(&cfg, 0, sizeof cfg);
     cfg.channels = 2;
@@ -173,7 +176,15 @@ int main(void)
     }
     (void)pcm_get_rate(p);
     (void)pcm_get_channels(p);
+    (void)pcm_get_config(p);
+    (void)pcm_get_buffer_size(p);
+    (void)pcm_format_to_bits(pcm_get_format(p));
     (void)pcm_frames_to_bytes(p, 1024);
+    (void)pcm_get_file_descriptor(p);
+    if (pcm_prepare(p) == 0 && pcm_mmap_avail(p) > 0 &&
+        pcm_mmap_begin(p, &area, &offset, &frames) == 0 &&
+        pcm_mmap_commit(p, offset, frames) > 0)
+        (void)pcm_start(p);
     memset(buf, 0, sizeof buf);
     /* pcm_writei is warn_unused_result; a (void) cast does NOT satisfy that, so
        assign it — otherwise this test adds a warning to a zero-warning tree. */
@@ -190,7 +201,7 @@ LINKTEST
         err "libtinyalsa.a does not link -static — see above (a missing plugin-file symbol looks exactly like this)"
     fi
     rm -rf "$tmp"
-    ok "links -static against a pcm_open/writei/close consumer"
+    ok "links -static against a pcm_open/mmap/writei/close consumer"
 }
 
 download_tinyalsa() {
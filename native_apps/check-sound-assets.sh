@@ -10,12 +10,14 @@
 # Two defects that a listen catches late, a screenshot never catches, and each of
 # which has already cost this project real time:
 #
-#  1. ⚠️ **A wrong sample rate is refused in SILENCE.**  clip_load() in
-#     common/audio.c rejects any clip that is not 44100 / mono / 16-bit, logs one
-#     line, and the game falls back to its note table — so the game sounds
-#     UNCHANGED and reads as "the new file did nothing" rather than as an error.
-#     Measured: a sourced effect arrived 48000 Hz stereo and would have changed
-#     nothing on the panel (../native_apps/CLAUDE.md → *Sound assets*).
+#  1. ⚠️ **A wrong sample rate is paid for on the device, every load.**  It used
+#     to be refused in SILENCE — clip_load() rejected it and the game fell back
+#     to its note table, which read as "the new file did nothing" (measured: a
+#     sourced effect arrived 48000 Hz stereo, ../native_apps/CLAUDE.md → *Sound
+#     assets*).  Since the rate converter (common/audio_gen.h) such a file plays,
+#     but through a 32-tap filter, and an ADPCM clip at a foreign rate is held
+#     DECODED — four times the RAM it was converted to save.  So a shipped file
+#     is still held to 44100 here; the converter is for files that did not ship.
 #  2. ⚠️ **Energy below the speaker's ~700 Hz knee is not quiet, it is absent**
 #     ([../SYSTEM_ANALYSIS.md#34-audio](../SYSTEM_ANALYSIS.md#34-audio)).  A file
 #     can be peak-normalised to −0.3 dBFS, look perfect in every byte-level check,
@@ -76,9 +78,14 @@ INBAND_FAIL=-26.0
 INBAND_WARN=-20.0
 
 # Format the mixer grants.  Anything else is refused in silence by clip_load().
+# IMA-ADPCM (sounds/wav2adpcm.c) is the one other encoding audio_wav.c decodes;
+# ffprobe names its sample format `s16p` — planar, because that is what its
+# decoder hands back — so a 4:1 file is judged on codec + s16p, not on s16.
 WANT_RATE=44100
 WANT_CH=1
 WANT_FMT=s16
+WANT_ADPCM_CODEC=adpcm_ima_wav
+WANT_ADPCM_FMT=s16p
 
 # ── the instrument ──────────────────────────────────────────────────────────
 if ! command -v ffmpeg >/dev/null 2>&1 || ! command -v ffprobe >/dev/null 2>&1; then
@@ -161,18 +168,24 @@ for f in "${FILES[@]}"; do
     # `s16 / 44100 / 1` and a positional read calls every correct file wrong.
     # Measured 2026-08-22: the first version of this gate failed all eleven files
     # for "wrong format" while printing their correct format on the same line.
-    # Three named calls cost three exec()s and cannot be misread.
+    # Named calls cost one exec() each and cannot be misread.
     probe1() { ffprobe -v error -select_streams a:0 \
                    -show_entries "stream=$1" -of default=nw=1:nk=1 "$2" 2>/dev/null; }
     rate=$(probe1 sample_rate "$f")
     chan=$(probe1 channels    "$f")
     fmt=$(probe1  sample_fmt  "$f")
+    codec=$(probe1 codec_name "$f")
 
     fmt_msg="${rate:-?}/${chan:-?}/${fmt:-?}"
+    want_fmt=$WANT_FMT
+    if [ "$codec" = "$WANT_ADPCM_CODEC" ]; then
+        want_fmt=$WANT_ADPCM_FMT
+        fmt_msg="$fmt_msg ima"
+    fi
     bad_fmt=0
     [ "$rate" = "$WANT_RATE" ] || bad_fmt=1
     [ "$chan" = "$WANT_CH" ]   || bad_fmt=1
-    [ "$fmt"  = "$WANT_FMT" ]  || bad_fmt=1
+    [ "$fmt"  = "$want_fmt" ]  || bad_fmt=1
 
     d=$(delta_of "$f") || d=""
     ib=$(inband_of "$f")
@@ -188,7 +201,7 @@ for f in "${FILES[@]}"; do
     reasons=""
     if [ $bad_fmt -eq 1 ]; then
         verdict=fail
-        reasons="$reasons wrong format (want $WANT_RATE/$WANT_CH/$WANT_FMT — clip_load() refuses this in SILENCE);"
+        reasons="$reasons wrong format (want $WANT_RATE/$WANT_CH/$WANT_FMT, or $WANT_ADPCM_FMT as $WANT_ADPCM_CODEC — converted on the device at every load, or refused past 4:1);"
     fi
     if lt "$d" "$DELTA_FAIL"; then
         verdict=fail
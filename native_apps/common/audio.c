@@ -10,9 +10,15 @@
 #include <unistd.h>
 #include <errno.h>
 #include <math.h>
+#include <signal.h>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
 #include <sys/soundcard.h>
+#include <sys/stat.h>
 #include <sys/time.h>
+#include <sys/wait.h>
+#include <time.h>
 
 /* ── Hardware constants ─────────────────────────────────────────────────────
  * The device half of the audio library.  Everything that is arithmetic rather
@@ -85,6 +91,17 @@ static uint32_t time_now_ms(void)
     return audio_ms_from_timeval((long)tv.tv_sec, (long)tv.tv_usec);
 }
 
+/** Microsecond monotonic clock, wrapping through 2^32 (~71 minutes) — only ever
+ *  differenced, over one trigger's latency.  CLOCK_MONOTONIC, not
+ *  gettimeofday(): an NTP step would land inside a measurement, and the clock is
+ *  system-wide, so a stamp taken in the game means the same in the server. */
+static uint32_t time_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u);
+}
+
 /** Is there a device to write to, on whichever of the two paths is live?
  *
  * ⚠️ `dsp_fd >= 0` was the test everywhere in this file, and on the continuous
@@ -325,11 +342,60 @@ static void fx_defaults(Audio *audio);
 static void fx_config_apply(Audio *audio, Config *cfg);
 static void clip_bank_discard(Audio *audio);
 
+/* The audio server's half of every entry point, defined with the server at the
+ * end of this file.  Each public function below starts with
+ * `if (audio->server)` and posts one of these instead of acting — in the GAME's
+ * process only, because the server runs on a copy whose `server` is NULL. */
+enum {
+    SRV_QUIT, SRV_TONE, SRV_INTERRUPT, SRV_CANNED, SRV_FX_PLAY, SRV_FX_PATH,
+    SRV_MUSIC_START, SRV_MUSIC_STOP, SRV_MUSIC_PAUSE, SRV_MUSIC_RESUME,
+    SRV_MUSIC_CUE,
+    SRV_SFX_PLAY, SRV_VOLUME, SRV_SHIFT, SRV_LIMIT, SRV_KEEPALIVE,
+    SRV_PUMP_ENABLE, SRV_STREAM_START, SRV_STREAM_FREQ, SRV_STREAM_STOP,
+    SRV_LAT_RESET
+};
+static void server_post(Audio *audio, int op, int a, int b, int c, const char *path);
+static bool server_call(Audio *audio, int op, int a, const char *path);
+static void server_stop(Audio *audio);
+static void tone_at(Audio *audio, int freq_hz, int duration_ms, uint32_t now);
+
+/** The shared page: the ring, then what the server publishes. */
+typedef struct AudioServer {
+    AudioCmdRing ring;
+    /* Published by the server, loaded by the game.  One word each, relaxed —
+     * they are diagnostics and a snapshot — except `applied`, whose release
+     * store is what makes `result` and the rest of a command's effects visible
+     * to the synchronous call waiting on it. */
+    uint32_t ready;           /* 1 once the server is servicing               */
+    uint32_t applied;         /* `seq` of the last command applied            */
+    uint32_t result;          /* its return value                             */
+    uint32_t voices, clipped, dropped, limited, starved, lost, stalled;
+    int32_t  lead, period;
+    uint32_t music_active, handoffs;
+    AudioLatencyStats lat;    /* recomputed only when the window changed      */
+} AudioServer;
+
+/** One word the server published, in the game's process. */
+#define SRV_READ(audio, field) __atomic_load_n(&(audio)->server->field, __ATOMIC_RELAXED)
+
+/** Stamp a trigger whose voice was just added: when the game asked — the
+ *  command's posting time inside the server, now otherwise — and the stream
+ *  frame it starts on, which is the next one the device will be handed. */
+static void lat_mark(Audio *audio)
+{
+    if (!audio->cont) return;
+    audio_lat_mark(&audio->lat, audio->issued ? audio->issue_us : time_now_us(),
+                   audio_out_written(&audio->out));
+}
+
 /** Release one sample voice's OS resources.  Called only from audio_close():
  *  see the note there for why stopping a voice must not do this. */
 static void sample_discard(AudioSampleVoice *sv)
 {
     audio_wav_close(&sv->wav);
+    audio_wav_close(&sv->next);
+    sv->next_path[0] = '\0';
+    sv->chain        = false;
     free(sv->buf);
     sv->buf        = NULL;
     sv->buf_frames = 0;
@@ -381,6 +447,9 @@ int audio_init(Audio *audio)
 
     if (audio_open(audio) < 0) return -1;
     fx_config_apply(audio, &cfg);
+    /* After the overrides, so the bank is matched against the paths this game
+     * will actually play. */
+    audio_fx_bank_attach(audio, AUDIO_FX_BANK_PATH);
 
     /* The two games-menu toggles, applied AFTER audio_open() for the same reason
      * fx_config_apply() is: that call memsets the struct and raises both.  ⚠️ They
@@ -388,6 +457,8 @@ int audio_init(Audio *audio)
      * whose music is off still mixes its effects, and the pump still runs. */
     audio->music_on   = config_music_enabled(&cfg);
     audio->effects_on = config_effects_enabled(&cfg);
+    audio->server_on  = config_audio_server(&cfg);
+    audio->alsa_on    = config_audio_alsa(&cfg);
     if (!audio->music_on || !audio->effects_on)
         printf("audio: music %s, effects %s (%s)\n",
                audio->music_on ? "on" : "OFF",
@@ -400,11 +471,17 @@ int audio_init(Audio *audio)
 
 int audio_init_unchecked(Audio *audio)
 {
-    return audio_open(audio);
+    int rc = audio_open(audio);
+    if (rc == 0) audio_fx_bank_attach(audio, AUDIO_FX_BANK_PATH);
+    return rc;
 }
 
 void audio_close(Audio *audio)
 {
+    /* The server drains the stream and prints the bus line from ITS copy; what
+     * is left here afterwards is this process's half, with nothing live in it. */
+    if (audio->server) server_stop(audio);
+
     /* ⚠️ **The counters are the diagnosis, and this is the one place every app
      * reports them.**  One line, from the LIBRARY rather than from a game's own
      * idea of what it enabled — the same reason `audio_get_volume()` exists — and
@@ -423,6 +500,12 @@ void audio_close(Audio *audio)
                 audio->mix.dropped, audio->mix.limited, audio->mix.clipped,
                 audio_ms_for_frames(audio->sample_rate, audio->pump_lead),
                 audio_ms_for_frames(audio->sample_rate, audio->pump_period));
+        AudioLatencyStats st;
+        audio_lat_stats(&audio->lat, &st);
+        if (st.count || st.missed) {
+            char line[160];
+            fprintf(stderr, "audio: %s\n", audio_lat_format(&st, line, sizeof(line)));
+        }
     }
 
     /* ⚠️ The continuous stream DRAINS on close, bounded — otherwise the queued
@@ -488,6 +571,7 @@ static void bus_reset(Audio *audio)
 void audio_pump_enable(Audio *audio, bool on)
 {
     if (!audio) return;
+    if (audio->server) { server_post(audio, SRV_PUMP_ENABLE, on, 0, 0, NULL); return; }
     if (on) {
         if (!audio->pumping) bus_reset(audio);
         return;
@@ -511,12 +595,17 @@ void audio_pump_enable(Audio *audio, bool on)
 
 void audio_pump_set_keepalive(Audio *audio, bool on)
 {
-    if (audio) audio->keepalive = on;
+    if (!audio) return;
+    if (audio->server) { server_post(audio, SRV_KEEPALIVE, on, 0, 0, NULL); return; }
+    audio->keepalive = on;
 }
 
 bool audio_pump_active(const Audio *audio)
 {
     if (!audio) return false;
+    /* The server paces itself, so the game's loop owes the device nothing and
+     * may drop to its idle period — which is half of what the server is for. */
+    if (audio->server) return false;
     /* ⚠️ Unconditionally true on the continuous stream: the stream must be
      * serviced whatever the bus is doing, and the ceiling on how long a frame may
      * take is audio_cont_service_interval_us() — which is measured, and below
@@ -532,22 +621,64 @@ bool audio_pump_active(const Audio *audio)
     return audio_mix_pending(&audio->mix) > 0;
 }
 
+bool audio_pump_slot(void *audio)
+{
+    audio_pump((Audio *)audio);
+    return audio_pump_active((const Audio *)audio);
+}
+
 int audio_pump_voices(const Audio *audio)
 {
-    return audio ? audio_mix_active(&audio->mix) : 0;
+    if (!audio) return 0;
+    return audio->server ? (int)SRV_READ(audio, voices) : audio_mix_active(&audio->mix);
+}
+
+/* On a server these are its published copies: one snapshot, one nap old. */
+#define PUMP_COUNTER(audio, field, local) \
+    (!(audio) ? 0 : (audio)->server ? SRV_READ(audio, field) : (local))
+
+uint32_t audio_pump_clipped(const Audio *audio) { return PUMP_COUNTER(audio, clipped, audio->mix.clipped); }
+uint32_t audio_pump_dropped(const Audio *audio) { return PUMP_COUNTER(audio, dropped, audio->mix.dropped); }
+uint32_t audio_pump_limited(const Audio *audio) { return PUMP_COUNTER(audio, limited, audio->mix.limited); }
+uint32_t audio_pump_starved(const Audio *audio) { return PUMP_COUNTER(audio, starved, audio->pump_starved); }
+uint32_t audio_pump_lost(const Audio *audio)    { return PUMP_COUNTER(audio, lost,    audio->pump_lost); }
+uint32_t audio_pump_stalled(const Audio *audio)
+{
+    return PUMP_COUNTER(audio, stalled,
+                        (uint32_t)(audio->music.wav.stalled + audio->sfx.wav.stalled));
 }
+long     audio_pump_lead(const Audio *audio)    { return PUMP_COUNTER(audio, lead,    audio->pump_lead); }
+long     audio_pump_period(const Audio *audio)  { return PUMP_COUNTER(audio, period,  audio->pump_period); }
 
-uint32_t audio_pump_clipped(const Audio *audio) { return audio ? audio->mix.clipped : 0; }
-uint32_t audio_pump_dropped(const Audio *audio) { return audio ? audio->mix.dropped : 0; }
-uint32_t audio_pump_limited(const Audio *audio) { return audio ? audio->mix.limited : 0; }
-uint32_t audio_pump_starved(const Audio *audio) { return audio ? audio->pump_starved : 0; }
-uint32_t audio_pump_lost(const Audio *audio)    { return audio ? audio->pump_lost    : 0; }
-long     audio_pump_lead(const Audio *audio)    { return audio ? audio->pump_lead    : 0; }
-long     audio_pump_period(const Audio *audio)  { return audio ? audio->pump_period  : 0; }
+void audio_latency_stats(const Audio *audio, AudioLatencyStats *out)
+{
+    if (!out) return;
+    if (!audio || !audio->server) { audio_lat_stats(audio ? &audio->lat : NULL, out); return; }
+    out->count  = SRV_READ(audio, lat.count);
+    out->missed = SRV_READ(audio, lat.missed);
+    out->min_us = SRV_READ(audio, lat.min_us);
+    out->avg_us = SRV_READ(audio, lat.avg_us);
+    out->p50_us = SRV_READ(audio, lat.p50_us);
+    out->p99_us = SRV_READ(audio, lat.p99_us);
+    out->max_us = SRV_READ(audio, lat.max_us);
+}
+
+void audio_latency_reset(Audio *audio)
+{
+    if (!audio) return;
+    if (audio->server) { server_post(audio, SRV_LAT_RESET, 0, 0, 0, NULL); return; }
+    /* The pending triggers belong to the stream, not to the window. */
+    AudioLatency keep = audio->lat;
+    audio_lat_reset(&audio->lat);
+    audio->lat.npend = keep.npend;
+    memcpy(audio->lat.pend, keep.pend, sizeof(keep.pend));
+}
 
 void audio_pump_set_limit(Audio *audio, int mode)
 {
-    if (audio) audio_mix_set_limit(&audio->mix, mode);
+    if (!audio) return;
+    if (audio->server) { server_post(audio, SRV_LIMIT, mode, 0, 0, NULL); return; }
+    audio_mix_set_limit(&audio->mix, mode);
 }
 
 void audio_set_volume(Audio *audio, int vol)
@@ -556,6 +687,8 @@ void audio_set_volume(Audio *audio, int vol)
     if (vol < 1)               vol = 1;
     if (vol > AUDIO_VOL_UNITY) vol = AUDIO_VOL_UNITY;
     audio->vol = vol;
+    /* Kept here as well, so audio_get_volume() answers without a round trip. */
+    if (audio->server) { server_post(audio, SRV_VOLUME, vol, 0, 0, NULL); return; }
     /* The knee's whole job is that ONE voice passes unchanged, so it moves with
      * the amplitude rather than being a constant beside it. */
     audio_mix_set_knee(&audio->mix, audio_voice_peak(vol));
@@ -569,6 +702,7 @@ void audio_set_master_shift(Audio *audio, int shift)
     if (shift < 0)  shift = 0;
     if (shift > 15) shift = 15;
     audio->master_shift = shift;
+    if (audio->server) { server_post(audio, SRV_SHIFT, shift, 0, 0, NULL); return; }
     /* ⚠️ Both paths, from one field.  audio_out holds its own copy because
      * ScummVM sets it without an `Audio` at all; this keeps them equal whenever
      * the stream is the live half. */
@@ -631,9 +765,32 @@ static long cont_fill_osc(void *ctx, int16_t *buf, long frames, int channels)
     return frames;
 }
 
+/** Native ALSA when the config asks for it, the OSS shim otherwise — and the
+ *  shim again if ALSA will not open, so the setting can never cost the panel its
+ *  sound.  ⚠️ Both are the same `hw:0,0` underneath, so this file's own fd must
+ *  already be closed: the shim holding it is a busy device to ALSA too. */
+static int open_stream(Audio *audio)
+{
+    if (audio->alsa_on) {
+        if (audio_out_open_alsa(&audio->out, 0, 0, TARGET_RATE, FALLBACK_CHANNELS) == 0)
+            return 0;
+        fprintf(stderr, "audio: audio_backend=alsa could not open hw:0,0 — "
+                        "using %s\n", DSP_DEVICE);
+    }
+    return audio_out_open_oss(&audio->out, TARGET_RATE, FALLBACK_CHANNELS);
+}
+
 int audio_cont_enable(Audio *audio, bool on)
 {
     if (!audio) return -1;
+    /* ⚠️ The server holds the stream and nothing can take it back short of
+     * audio_close(): the old path's fd would be a second open of the device. */
+    if (audio->server) {
+        if (on) return 0;
+        fprintf(stderr, "audio: cont_enable(false) refused — the audio server owns "
+                        "the stream until audio_close()\n");
+        return -1;
+    }
     if (on == audio->cont) return 0;
 
     if (on) {
@@ -645,7 +802,7 @@ int audio_cont_enable(Audio *audio, bool on)
          * rather than leaving the panel silent. */
         if (audio->dsp_fd >= 0) { close(audio->dsp_fd); audio->dsp_fd = -1; }
 
-        if (audio_out_open_oss(&audio->out, TARGET_RATE, FALLBACK_CHANNELS) != 0) {
+        if (open_stream(audio) != 0) {
             fprintf(stderr, "audio: the continuous stream could not take the "
                             "device — restoring the old path\n");
             if (dsp_reopen(audio) < 0) audio->available = false;
@@ -659,6 +816,9 @@ int audio_cont_enable(Audio *audio, bool on)
         audio->channels    = audio_out_channels(&audio->out);
         audio->cont        = true;
         audio->osc_stream  = false;
+        /* A new stream counts its frames from zero; a trigger positioned in the
+         * old one would resolve against the wrong head. */
+        audio_lat_drop_pending(&audio->lat);
 
         bus_reset(audio);              /* CONT implies PUMP — see audio.h */
         audio_out_set_shift(&audio->out, audio->master_shift);
@@ -668,6 +828,7 @@ int audio_cont_enable(Audio *audio, bool on)
 
     /* Off: drain what is queued, then take the device back the old way. */
     audio_out_close(&audio->out);
+    audio_lat_drop_pending(&audio->lat);
     audio->cont       = false;
     audio->osc_stream = false;
     audio->pumping    = false;
@@ -679,10 +840,17 @@ int audio_cont_enable(Audio *audio, bool on)
     return 0;
 }
 
-bool audio_cont_active(const Audio *audio) { return audio ? audio->cont : false; }
+bool audio_cont_active(const Audio *audio)
+{
+    return audio ? (audio->server != NULL || audio->cont) : false;
+}
 
 long audio_cont_service_interval_us(const Audio *audio)
 {
+    /* ⚠️ 0 on a server, and that is the answer rather than "not measured": the
+     * game need not call audio_pump() at all, so a frame_sched audio slot built
+     * from this runs once per frame instead of slicing every wait for nothing. */
+    if (audio && audio->server) return 0;
     return (audio && audio->cont) ? audio_out_service_interval_us(&audio->out) : 0;
 }
 
@@ -697,11 +865,20 @@ static void cont_service(Audio *audio)
     audio->pump_period  = audio_out_period(&audio->out);
     audio->pump_starved = audio_out_starved(&audio->out);
     audio->pump_lost    = audio_out_lost(&audio->out);
+
+    /* The delay reading is an ioctl, so it is taken only while a trigger is
+     * waiting for one — a few times a second in a game, never on an idle bus. */
+    if (audio_lat_pending(&audio->lat) > 0) {
+        long delay = audio_out_delay(&audio->out);
+        if (delay >= 0)
+            audio_lat_observe(&audio->lat, audio->sample_rate, time_now_us(),
+                              audio_out_written(&audio->out), delay);
+    }
 }
 
 void audio_pump(Audio *audio)
 {
-    if (!audio) return;
+    if (!audio || audio->server) return;      /* the server services itself */
     if (audio->cont) { cont_service(audio); return; }
     if (!audio->available || audio->dsp_fd < 0 || !audio->pumping) return;
 
@@ -795,6 +972,7 @@ void audio_pump(Audio *audio)
 
 void audio_interrupt(Audio *audio)
 {
+    if (audio && audio->server) { server_post(audio, SRV_INTERRUPT, 0, 0, 0, NULL); return; }
     if (!audio_live(audio)) return;
 
     /* On the bus this is "stop all voices": no ring reset, because the reset is
@@ -817,7 +995,20 @@ void audio_interrupt(Audio *audio)
 
 void audio_tone(Audio *audio, int freq_hz, int duration_ms)
 {
-    if (!audio || !audio->available)             return;
+    if (!audio) return;
+    /* The ISSUE time travels with the command: chaining is judged on when the
+     * game asked, not on when the server's nap happened to end. */
+    if (audio->server) {
+        server_post(audio, SRV_TONE, freq_hz, duration_ms, (int)time_now_ms(), NULL);
+        return;
+    }
+    tone_at(audio, freq_hz, duration_ms, time_now_ms());
+}
+
+/** audio_tone() with the issue time supplied — the server's entry point. */
+static void tone_at(Audio *audio, int freq_hz, int duration_ms, uint32_t now)
+{
+    if (!audio->available)                       return;
     /* The EFFECTS toggle, at the one place every tone in the project passes
      * through — play_sequence() calls this, so the four canned sounds' note-table
      * fallbacks are covered by this line and not by four of their own. */
@@ -878,7 +1069,6 @@ void audio_tone(Audio *audio, int freq_hz, int duration_ms)
          * the interrupt stops every voice, so the tail it reads is 0 and the tone
          * still starts immediately.  That is the property that keeps "overlapping
          * sounds mix" from silently becoming "overlapping sounds queue". */
-        uint32_t now    = time_now_ms();
         bool     recent = (uint32_t)(now - audio->last_tone_ms) <= AUDIO_TONE_CHAIN_MS;
         /* ⚠️ That subtraction is uint32 over a clock audio_ms_from_timeval() masks to
          * 22 bits, so it is not a 2^32 wrap: across the ~48.5-day rollover the delta
@@ -899,6 +1089,7 @@ void audio_tone(Audio *audio, int freq_hz, int duration_ms)
             audio->last_tone_slot = slot;
             audio->last_tone_gen  = audio_mix_voice_gen(&audio->mix, slot);
             audio->last_tone_ms   = now;
+            if (tail_ms <= 0) lat_mark(audio);   /* a chained note is not a trigger */
         }
         return;
     }
@@ -934,6 +1125,11 @@ void audio_tone(Audio *audio, int freq_hz, int duration_ms)
 void audio_stream_start(Audio *audio, int freq_hz)
 {
     if (!audio || !audio->available) return;
+    if (audio->server) {
+        audio->streaming = true;
+        server_post(audio, SRV_STREAM_START, freq_hz, 0, 0, NULL);
+        return;
+    }
 
     /* ⚠️ Refused LOUDLY while the bus still owes audio.  The refusal used to be
      * "the pump is on"; it cannot be that any more, because CONT implies PUMP and
@@ -968,12 +1164,14 @@ void audio_stream_start(Audio *audio, int freq_hz)
 void audio_stream_set_freq(Audio *audio, int freq_hz)
 {
     if (!audio->streaming) return;
+    if (audio->server) { server_post(audio, SRV_STREAM_FREQ, freq_hz, 0, 0, NULL); return; }
     audio->osc.target_freq = (double)freq_hz;
 }
 
 void audio_stream_chunk(Audio *audio)
 {
     if (!audio || !audio->streaming) return;
+    if (audio->server)               return;   /* the server services it */
     if (!audio_live(audio))          return;
 
     /* The stream is serviced, not chunked: one service writes whatever the lead
@@ -985,6 +1183,11 @@ void audio_stream_chunk(Audio *audio)
 void audio_stream_stop(Audio *audio)
 {
     if (!audio || !audio->streaming) return;
+    if (audio->server) {
+        audio->streaming = false;
+        server_post(audio, SRV_STREAM_STOP, 0, 0, 0, NULL);
+        return;
+    }
     if (!audio_live(audio)) {
         audio->streaming  = false;
         audio->osc_stream = false;
@@ -1094,17 +1297,49 @@ static void fx_config_apply(Audio *audio, Config *cfg)
     }
 }
 
+/** The ADPCM half of clip_fill(): the same memcpy, out of this voice's decoded
+ *  block, decoding the next block from the shared payload when the cursor leaves
+ *  it.  ⚠️ The block is found from `pos`, not carried as "the next one": a voice
+ *  is rewound by setting `pos = 0`, and a carried index would resume mid-clip. */
+static long clip_fill_adpcm(AudioClipVoice *cv, int16_t *dst, long frames)
+{
+    const AudioClip *c = cv->clip;
+    long done = 0;
+    while (done < frames) {
+        long blk = cv->pos / c->block_frames;   /* per block or fill, never per frame */
+        long off = cv->pos - blk * c->block_frames;
+        if (blk != cv->dec_block) {
+            long at    = blk * c->block_align;
+            long bytes = c->adpcm_bytes - at;
+            if (bytes > c->block_align) bytes = c->block_align;
+            if (bytes <= 0
+                || audio_adpcm_decode_block(c->adpcm + at, bytes, c->channels,
+                                            cv->dec) <= off) break;
+            cv->dec_block = blk;
+        }
+        long want = frames - done;
+        long have = c->block_frames - off;
+        if (want > have) want = have;
+        memcpy(dst + done, cv->dec + off, (size_t)want * sizeof(int16_t));
+        done    += want;
+        cv->pos += want;
+    }
+    return done;
+}
+
 /** `AudioVoiceFill` over RAM: the whole mechanism, and it is a memcpy.  A short
  *  return is how the clip ends, which the bus already treats as a normal exit. */
 static long clip_fill(void *ctx, int16_t *dst, long frames)
 {
     AudioClipVoice *cv = (AudioClipVoice *)ctx;
-    if (!cv || !cv->clip || !cv->clip->pcm) return 0;
+    if (!cv || !cv->clip || (!cv->clip->pcm && !cv->clip->adpcm)) return 0;
 
     long left = cv->clip->frames - cv->pos;
     if (left <= 0) return 0;
     if (frames > left) frames = left;
 
+    if (cv->clip->adpcm) return clip_fill_adpcm(cv, dst, frames);
+
     memcpy(dst, cv->clip->pcm + cv->pos, (size_t)frames * sizeof(int16_t));
     cv->pos += frames;
     return frames;
@@ -1124,14 +1359,15 @@ static int clip_refs(const Audio *audio, const AudioClip *c)
 }
 
 /**
- * Read a whole file into `c`.  Returns true iff `c->pcm` came out non-NULL.
+ * Read a whole file into `c`, held at `rate`.  Returns true iff `c->pcm` or
+ * `c->adpcm` came out non-NULL.
  *
  * Goes through audio_wav.c rather than reading the header here, and that is
  * load-bearing: `data` is NOT at byte 44 in our own files, and a reader that
  * assumes it plays an encoder version string as audio (audio_wav.h).  It also
  * averages a multi-channel file down instead of picking the left channel.
  */
-static bool clip_load(Audio *audio, AudioClip *c, const char *path, const char *name)
+static bool clip_load(AudioClip *c, int rate, const char *path, const char *name)
 {
     AudioWav w;
     if (!audio_wav_open(&w, path, false)) {
@@ -1139,23 +1375,71 @@ static bool clip_load(Audio *audio, AudioClip *c, const char *path, const char *
                 name, path);
         return false;
     }
-    /* Same refusal as the bed's, same reason: there is no resampler, and playing
-     * 22050 material at 44100 is a pitch bug that sounds like a bad recording. */
-    if (w.rate != audio->sample_rate) {
+    /* A foreign rate is converted ONCE, here, and the clip is held at the
+     * device rate — a trigger stays a memcpy.  Refused only for a pair the
+     * converter does not take (audio_rs_supported()). */
+    bool convert = (w.rate != rate);
+    if (convert && !audio_rs_supported(w.rate, rate)) {
         fprintf(stderr, "audio: fx %s refused — %s is %d Hz, the device granted %d, "
-                        "and there is no resampler\n", name, path, w.rate, audio->sample_rate);
+                        "and that pair is past the converter's range\n",
+                name, path, w.rate, rate);
         audio_wav_close(&w);
         return false;
     }
-    if (w.frames <= 0 || w.frames > AUDIO_CLIP_MAX_FRAMES) {
+    /* The ceiling is on what is HELD, so on the converted length. */
+    long held = convert ? audio_rs_frames_out(w.rate, rate, w.frames)
+                        : w.frames;
+    if (w.frames <= 0 || held > AUDIO_CLIP_MAX_FRAMES) {
         /* ⚠️ The guard that stops a MUSIC path being RAM-loaded inside a tap. */
         fprintf(stderr, "audio: fx %s refused — %s is %ld frames, the clip ceiling is "
                         "%ld (a bed STREAMS; audio_music_start() is its path)\n",
-                name, path, w.frames, AUDIO_CLIP_MAX_FRAMES);
+                name, path, held, AUDIO_CLIP_MAX_FRAMES);
         audio_wav_close(&w);
         return false;
     }
 
+    /* ADPCM stays compressed: a quarter of the RAM, decoded a block at a time
+     * by whichever voices are playing it.  ⚠️ Not at a foreign rate: a per-voice
+     * block decode cannot be converted a block at a time without a converter
+     * per voice, so that file takes the PCM path below and is held decoded. */
+    if (w.format == AUDIO_WAV_IMA_ADPCM && !convert) {
+        uint8_t *raw = (uint8_t *)malloc((size_t)w.data_bytes);
+        if (!raw) {
+            fprintf(stderr, "audio: fx %s out of memory for %ld bytes\n", name, w.data_bytes);
+            audio_wav_close(&w);
+            return false;
+        }
+        long got = 0;
+        while (got < w.data_bytes) {
+            long n = audio_wav_read_raw(&w, raw + got, w.data_bytes - got);
+            if (n <= 0) break;
+            got += n;
+        }
+        /* A short read ends the clip at the last whole-or-partial block that
+         * arrived, same as the PCM path ends it at the last frame. */
+        long full   = got / w.block_align;
+        long rem    = got - full * w.block_align;
+        long frames = full * w.block_frames;
+        if (rem >= 4L * w.channels) frames += AUDIO_WAV_ADPCM_BLOCK_FRAMES(rem, w.channels);
+        if (frames > w.frames) frames = w.frames;
+        audio_wav_close(&w);
+
+        if (frames <= 0) {
+            fprintf(stderr, "audio: fx %s read nothing from %s\n", name, path);
+            free(raw);
+            return false;
+        }
+        c->adpcm        = raw;
+        c->adpcm_bytes  = got;
+        c->block_align  = w.block_align;
+        c->block_frames = w.block_frames;
+        c->channels     = w.channels;
+        c->frames       = frames;
+        fprintf(stderr, "audio: fx %s loaded %s — %ld of %ld frames, %d Hz, IMA-ADPCM, "
+                        "%ld bytes in RAM\n", name, path, frames, w.frames, w.rate, got);
+        return true;
+    }
+
     int16_t *pcm = (int16_t *)malloc((size_t)w.frames * sizeof(int16_t));
     if (!pcm) {
         fprintf(stderr, "audio: fx %s out of memory for %ld frames\n", name, w.frames);
@@ -1178,13 +1462,274 @@ static bool clip_load(Audio *audio, AudioClip *c, const char *path, const char *
         free(pcm);
         return false;
     }
+    if (convert) {
+        /* ⚠️ On the heap: the converter is ~4 KB of window and coefficients, and
+         * this runs inside a tap on whatever stack the caller has. */
+        AudioResampler *rs  = (AudioResampler *)malloc(sizeof(AudioResampler));
+        long            cap = audio_rs_frames_out(w.rate, rate, got);
+        int16_t        *out = (int16_t *)malloc((size_t)cap * sizeof(int16_t));
+        if (!rs || !out || !audio_rs_init(rs, w.rate, rate)) {
+            fprintf(stderr, "audio: fx %s out of memory converting %ld frames\n",
+                    name, got);
+            free(rs); free(out); free(pcm);
+            return false;
+        }
+        long n = audio_rs_convert(rs, pcm, got, out, cap);
+        free(rs);
+        free(pcm);
+        pcm = out;
+        got = n;
+    }
     c->pcm    = pcm;
     c->frames = got;
-    fprintf(stderr, "audio: fx %s loaded %s — %ld of %ld frames, %d Hz, %ld bytes in RAM\n",
-            name, path, got, w.frames, w.rate, (long)((size_t)got * sizeof(int16_t)));
+    fprintf(stderr, "audio: fx %s loaded %s — %ld of %ld frames, %d Hz%s, %ld bytes in RAM\n",
+            name, path, got, held, w.rate, convert ? " converted" : "",
+            (long)((size_t)got * sizeof(int16_t)));
     return true;
 }
 
+/* ── The shared bank: the same clips, loaded once per boot ───────────────────
+ *
+ * Every game used to load the same five files into its own heap on the first
+ * trigger of each, so the first hit of every sound paid an SD read inside a tap
+ * and the clip RAM was held once per process.  app_launcher now loads them once
+ * and writes the result to tmpfs; each game maps that file read-only, so the
+ * pages are shared and a clip found there is ready before the first frame.
+ *
+ * ⚠️ **The bank is a CACHE, never a source of truth.**  A clip is adopted from it
+ * only when the entry names the path this process would load, at this process's
+ * rate, and the file on disk still has the mtime and size it was published with.
+ * Any miss — no bank, an old bank, an operator who replaced fx_fail.wav since
+ * boot — takes the private load below, which is the behaviour without a bank.
+ *
+ * A plain file in /dev/shm rather than shm_open(): it is the same tmpfs object,
+ * and the static build then needs no -lrt.
+ */
+
+#define FX_BANK_MAGIC    0x4B4E4258u    /* "XBNK", little-endian */
+#define FX_BANK_VERSION  1
+#define FX_BANK_ALIGN    8              /* every payload starts 8-aligned */
+
+typedef struct {
+    char     path[AUDIO_FX_PATH_MAX];   /* NUL-terminated, checked on read       */
+    int64_t  mtime_s;                   /* the file AS PUBLISHED: st_mtim ...    */
+    int64_t  mtime_ns;
+    int64_t  size;                      /* ... and st_size                       */
+    uint32_t adpcm;                     /* 1 = kept as stored, 0 = mono PCM      */
+    uint32_t frames;
+    uint32_t block_align, block_frames, channels;
+    uint32_t offset, bytes;             /* the payload, from the segment start   */
+    uint32_t pad;
+} FxBankEntry;
+
+typedef struct {
+    uint32_t    magic, version;
+    uint32_t    rate;                   /* what every entry is held at           */
+    uint32_t    count;
+    uint32_t    total;                  /* bytes in the segment                  */
+    uint32_t    pad;
+    FxBankEntry e[AUDIO_FX_COUNT];
+} FxBankHeader;
+
+/** An entry whose fields cannot be trusted is skipped, not believed: the bank
+ *  is a file anyone with root can write, and a payload that ran past the mapping
+ *  would fault inside the render. */
+static bool fx_bank_entry_sane(const FxBankHeader *h, const FxBankEntry *e)
+{
+    if (memchr(e->path, '\0', sizeof(e->path)) == NULL) return false;
+    if (e->frames == 0 || e->frames > AUDIO_CLIP_MAX_FRAMES) return false;
+    if (e->offset % FX_BANK_ALIGN || e->offset < sizeof(FxBankHeader)) return false;
+    if (e->bytes > h->total || e->offset > h->total - e->bytes) return false;
+    if (!e->adpcm) return e->bytes == e->frames * sizeof(int16_t);
+    return e->channels >= 1 && e->channels <= 2 && e->block_align >= 4 * e->channels
+        && (long)e->block_frames == AUDIO_WAV_ADPCM_BLOCK_FRAMES(e->block_align, e->channels)
+        && e->frames <= (e->bytes / e->block_align + 1) * e->block_frames;
+}
+
+/** Point `c` at the bank's copy of `path`.  Returns false — quietly when there is
+ *  simply no entry — to mean "load it privately". */
+static bool fx_bank_adopt(Audio *audio, AudioClip *c, const char *path, const char *name)
+{
+    if (!audio->fx_bank) return false;
+    const FxBankHeader *h = (const FxBankHeader *)audio->fx_bank;
+    if ((int)h->rate != audio->sample_rate) return false;
+
+    for (uint32_t i = 0; i < h->count; i++) {
+        const FxBankEntry *e = &h->e[i];
+        if (!fx_bank_entry_sane(h, e) || strcmp(e->path, path) != 0) continue;
+
+        struct stat st;
+        if (stat(path, &st) != 0 || (int64_t)st.st_mtim.tv_sec != e->mtime_s
+            || (int64_t)st.st_mtim.tv_nsec != e->mtime_ns || (int64_t)st.st_size != e->size) {
+            fprintf(stderr, "audio: fx %s — %s changed since the bank was published, "
+                            "loading it privately\n", name, path);
+            return false;
+        }
+        /* The casts drop const for the struct's sake only: the mapping is
+         * PROT_READ, and nothing on the clip path writes through either. */
+        const uint8_t *payload = audio->fx_bank + e->offset;
+        if (e->adpcm) {
+            c->adpcm        = (uint8_t *)payload;
+            c->adpcm_bytes  = (long)e->bytes;
+            c->block_align  = (int)e->block_align;
+            c->block_frames = (long)e->block_frames;
+            c->channels     = (int)e->channels;
+        } else {
+            c->pcm = (int16_t *)payload;
+        }
+        c->frames = (long)e->frames;
+        c->shared = true;
+        fprintf(stderr, "audio: fx %s mapped %s from the shared bank — %ld frames, "
+                        "no private copy\n", name, path, c->frames);
+        return true;
+    }
+    return false;
+}
+
+bool audio_fx_bank_attach(Audio *audio, const char *path)
+{
+    if (!audio || !path || audio->fx_bank) return false;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;           /* no launcher ran: the normal fallback */
+    struct stat st;
+    void *m = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(FxBankHeader))
+        m = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);                          /* the mapping holds the file */
+    if (m == MAP_FAILED) {
+        fprintf(stderr, "audio: fx bank %s is unreadable — clips load privately\n", path);
+        return false;
+    }
+
+    const FxBankHeader *h = (const FxBankHeader *)m;
+    if (h->magic != FX_BANK_MAGIC || h->version != FX_BANK_VERSION
+        || h->total != (uint32_t)st.st_size || h->count > AUDIO_FX_COUNT) {
+        fprintf(stderr, "audio: fx bank %s is not a version-%d bank — clips load "
+                        "privately\n", path, FX_BANK_VERSION);
+        munmap(m, (size_t)st.st_size);
+        return false;
+    }
+    audio->fx_bank       = (const uint8_t *)m;
+    audio->fx_bank_bytes = (size_t)st.st_size;
+
+    /* Adopt now, not on the first trigger — that is the latency this is for.  A
+     * name already tried keeps what it has; a name the bank cannot serve stays
+     * untried, so its first trigger does the private load as before.  A pending
+     * `reload` on a name holding nothing has nothing left to free, so adopting
+     * clears it — otherwise that first trigger would drop the mapped clip. */
+    for (int i = 0; i < AUDIO_FX_COUNT; i++) {
+        AudioClip *c = &audio->fx[i];
+        if (c->tried || c->pcm || c->adpcm || !audio->fx_path[i][0]) continue;
+        if (fx_bank_adopt(audio, c, audio->fx_path[i], FX_NAME[i])) {
+            c->tried  = true;
+            c->reload = false;
+        }
+    }
+    return true;
+}
+
+static bool write_all(int fd, const void *buf, size_t n)
+{
+    const uint8_t *p = (const uint8_t *)buf;
+    while (n > 0) {
+        ssize_t w = write(fd, p, n);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return false;
+        p += w;
+        n -= (size_t)w;
+    }
+    return true;
+}
+
+int audio_fx_bank_publish(const char *path, int rate, const char *const *clips)
+{
+    if (!path || rate <= 0) return -1;
+
+    /* The paths a game resolves: fx_defaults() then fx_config_apply(). */
+    char want[AUDIO_FX_COUNT][AUDIO_FX_PATH_MAX];
+    if (clips) {
+        for (int i = 0; i < AUDIO_FX_COUNT; i++)
+            snprintf(want[i], AUDIO_FX_PATH_MAX, "%s", clips[i] ? clips[i] : "");
+    } else {
+        Config cfg;
+        config_init(&cfg);
+        config_load(&cfg);
+        for (int i = 0; i < AUDIO_FX_COUNT; i++)
+            snprintf(want[i], AUDIO_FX_PATH_MAX, "%s",
+                     config_get(&cfg, FX_CONFIG_KEY[i], FX_DEFAULT_PATH[i]));
+    }
+
+    FxBankHeader *h = (FxBankHeader *)calloc(1, sizeof(FxBankHeader));
+    AudioClip clip[AUDIO_FX_COUNT];
+    memset(clip, 0, sizeof(clip));
+    if (!h) return -1;
+    h->magic   = FX_BANK_MAGIC;
+    h->version = FX_BANK_VERSION;
+    h->rate    = (uint32_t)rate;
+
+    uint32_t at = (uint32_t)sizeof(FxBankHeader);
+    for (int i = 0; i < AUDIO_FX_COUNT; i++) {
+        if (!want[i][0]) continue;                     /* "" = the note table */
+        bool dup = false;
+        for (uint32_t k = 0; k < h->count; k++) dup |= strcmp(h->e[k].path, want[i]) == 0;
+        if (dup) continue;
+
+        /* stat() BEFORE the load: a file replaced mid-load then fails the
+         * check in every game, rather than passing with the old content. */
+        struct stat st;
+        AudioClip *c = &clip[h->count];
+        if (stat(want[i], &st) != 0 || !clip_load(c, rate, want[i], FX_NAME[i])) continue;
+
+        FxBankEntry *e = &h->e[h->count++];
+        memcpy(e->path, want[i], sizeof(e->path));    /* both AUDIO_FX_PATH_MAX */
+        e->mtime_s  = (int64_t)st.st_mtim.tv_sec;
+        e->mtime_ns = (int64_t)st.st_mtim.tv_nsec;
+        e->size     = (int64_t)st.st_size;
+        e->frames   = (uint32_t)c->frames;
+        if (c->adpcm) {
+            e->adpcm        = 1;
+            e->bytes        = (uint32_t)c->adpcm_bytes;
+            e->block_align  = (uint32_t)c->block_align;
+            e->block_frames = (uint32_t)c->block_frames;
+            e->channels     = (uint32_t)c->channels;
+        } else {
+            e->bytes = (uint32_t)((size_t)c->frames * sizeof(int16_t));
+        }
+        e->offset = at;
+        at += (e->bytes + FX_BANK_ALIGN - 1) & ~(uint32_t)(FX_BANK_ALIGN - 1);
+    }
+    h->total = at;
+
+    /* A temporary name, then rename(): a game holding the old bank keeps its
+     * mapping of the old inode, and one opening now sees a whole file. */
+    char tmp[AUDIO_FX_PATH_MAX + 16];
+    snprintf(tmp, sizeof(tmp), "%s.%d", path, (int)getpid());
+    int  fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    bool ok = fd >= 0 && write_all(fd, h, sizeof(*h));
+    static const uint8_t zero[FX_BANK_ALIGN];
+    for (uint32_t k = 0; ok && k < h->count; k++) {
+        const void *src = clip[k].adpcm ? (const void *)clip[k].adpcm : (const void *)clip[k].pcm;
+        uint32_t pad = ((h->e[k].bytes + FX_BANK_ALIGN - 1) & ~(uint32_t)(FX_BANK_ALIGN - 1))
+                     - h->e[k].bytes;
+        ok = write_all(fd, src, h->e[k].bytes) && write_all(fd, zero, pad);
+    }
+    if (fd >= 0 && close(fd) != 0) ok = false;
+    if (ok && rename(tmp, path) != 0) ok = false;
+    if (!ok) {
+        fprintf(stderr, "audio: fx bank %s could not be written: %s\n", path, strerror(errno));
+        unlink(tmp);
+    } else {
+        fprintf(stderr, "audio: fx bank %s published — %u clip(s), %u bytes at %d Hz\n",
+                path, h->count, h->total, rate);
+    }
+
+    int n = (int)h->count;
+    for (int k = 0; k < AUDIO_FX_COUNT; k++) { free(clip[k].pcm); free(clip[k].adpcm); }
+    free(h);
+    return ok ? n : -1;
+}
+
 /** The clip for `id`, loading it on first use, or NULL to mean "play the notes". */
 static AudioClip *clip_ready(Audio *audio, AudioFxId id)
 {
@@ -1195,8 +1740,13 @@ static AudioClip *clip_ready(Audio *audio, AudioFxId id)
          * voice is reading it — and fall back to the notes for this one trigger
          * if one still is. */
         if (clip_refs(audio, c) > 0) return NULL;
-        free(c->pcm);
+        if (!c->shared) {
+            free(c->pcm);
+            free(c->adpcm);
+        }
+        c->shared = false;
         c->pcm    = NULL;
+        c->adpcm  = NULL;
         c->frames = 0;
         c->tried  = false;
         c->reload = false;
@@ -1207,14 +1757,16 @@ static AudioClip *clip_ready(Audio *audio, AudioFxId id)
                                                 * permanent, so a failure must not
                                                 * be retried on the next tap */
         const char *path = audio->fx_path[id];
-        if (path && *path) clip_load(audio, c, path, FX_NAME[id]);
+        if (path && *path && !fx_bank_adopt(audio, c, path, FX_NAME[id]))
+            clip_load(c, audio->sample_rate, path, FX_NAME[id]);
     }
-    return c->pcm ? c : NULL;
+    return (c->pcm || c->adpcm) ? c : NULL;
 }
 
 bool audio_fx_play(Audio *audio, AudioFxId id)
 {
     if (!audio || id < 0 || id >= AUDIO_FX_COUNT) return false;
+    if (audio->server) return server_call(audio, SRV_FX_PLAY, id, NULL);
     /* ⚠️ The EFFECTS toggle returns false here rather than "played", so the caller
      * falls through to its note table — which audio_tone() then refuses too.  Both
      * halves must be gated: gating only the clip would make an OFF toggle swap
@@ -1237,12 +1789,19 @@ bool audio_fx_play(Audio *audio, AudioFxId id)
             if (!cv->buf) return false;
             cv->buf_frames = AUDIO_CLIP_VOICE_BUF_FRAMES;
         }
+        if (c->adpcm && cv->dec_cap < c->block_frames) {
+            int16_t *d = (int16_t *)realloc(cv->dec, (size_t)c->block_frames * sizeof(int16_t));
+            if (!d) return false;
+            cv->dec     = d;
+            cv->dec_cap = c->block_frames;
+        }
 
         /* ⚠️ The cursor is rewound HERE, before the add — the mixer pulls on the
          * first rendered frame and would otherwise resume where the last trigger
          * of this voice stopped. */
-        cv->clip = c;
-        cv->pos  = 0;
+        cv->clip      = c;
+        cv->pos       = 0;
+        cv->dec_block = -1;                    /* the cache is the old clip's */
 
         int slot = audio_mix_add_sample(&audio->mix, clip_fill, cv,
                                         cv->buf, cv->buf_frames,
@@ -1250,6 +1809,7 @@ bool audio_fx_play(Audio *audio, AudioFxId id)
         if (slot < 0) return false;             /* full bus: refuses, never steals */
         cv->slot = slot;
         cv->gen  = audio_mix_voice_gen(&audio->mix, slot);
+        lat_mark(audio);
         return true;
     }
     /* All AUDIO_CLIP_VOICES sounding.  Not a fault and not counted: the bus's own
@@ -1264,6 +1824,9 @@ void audio_fx_set_path(Audio *audio, AudioFxId id, const char *path)
     if (strcmp(audio->fx_path[id], path) == 0) return;   /* safe to call per frame */
 
     snprintf(audio->fx_path[id], AUDIO_FX_PATH_MAX, "%s", path);
+    /* The copy above is kept on a server too: it is what makes a per-frame call
+     * cost a strcmp rather than a command. */
+    if (audio->server) { server_post(audio, SRV_FX_PATH, id, 0, 0, audio->fx_path[id]); return; }
     audio->fx[id].reload = true;    /* the free happens at the next trigger */
 }
 
@@ -1272,19 +1835,31 @@ void audio_fx_set_path(Audio *audio, AudioFxId id, const char *path)
 static void clip_bank_discard(Audio *audio)
 {
     for (int i = 0; i < AUDIO_FX_COUNT; i++) {
-        free(audio->fx[i].pcm);
+        if (!audio->fx[i].shared) {
+            free(audio->fx[i].pcm);
+            free(audio->fx[i].adpcm);
+        }
+        audio->fx[i].shared = false;
         audio->fx[i].pcm    = NULL;
+        audio->fx[i].adpcm  = NULL;
         audio->fx[i].frames = 0;
         audio->fx[i].tried  = false;
         audio->fx[i].reload = false;
     }
     for (int i = 0; i < AUDIO_CLIP_VOICES; i++) {
         free(audio->fxv[i].buf);
+        free(audio->fxv[i].dec);
         audio->fxv[i].buf        = NULL;
         audio->fxv[i].buf_frames = 0;
+        audio->fxv[i].dec        = NULL;
+        audio->fxv[i].dec_cap    = 0;
         audio->fxv[i].clip       = NULL;
         audio->fxv[i].slot       = -1;
     }
+    /* Last, and only here: no clip and no voice refers into it any more. */
+    if (audio->fx_bank) munmap((void *)audio->fx_bank, audio->fx_bank_bytes);
+    audio->fx_bank       = NULL;
+    audio->fx_bank_bytes = 0;
 }
 
 /* ── Convenience sounds ─────────────────────────────────────────────────────
@@ -1297,6 +1872,11 @@ static void clip_bank_discard(Audio *audio)
 
 typedef struct { int freq; int ms; } AudioNote;
 
+/* The four names as the server applies them — the same order as AudioFxId. */
+static void (*const CANNED[AUDIO_FX_COUNT])(Audio *) = {
+    audio_beep, audio_blip, audio_success, audio_fail, audio_gameover
+};
+
 static void play_sequence(Audio *audio, const AudioNote *notes, int count)
 {
     if (!audio->available) return;
@@ -1304,7 +1884,9 @@ static void play_sequence(Audio *audio, const AudioNote *notes, int count)
     if (audio->pumping) {
         int delay = 0;
         for (int i = 0; i < count; i++) {
-            audio_mix_add(&audio->mix, notes[i].freq, notes[i].ms, delay, audio_voice_peak(audio->vol));
+            int slot = audio_mix_add(&audio->mix, notes[i].freq, notes[i].ms, delay,
+                                     audio_voice_peak(audio->vol));
+            if (i == 0 && slot >= 0) lat_mark(audio);
             delay += notes[i].ms;
         }
         return;
@@ -1319,6 +1901,7 @@ static void play_sequence(Audio *audio, const AudioNote *notes, int count)
 void audio_beep(Audio *audio)
 {
     static const AudioNote s[] = { { 880, 80 } };
+    if (audio && audio->server) { server_post(audio, SRV_CANNED, AUDIO_FX_BEEP, 0, 0, NULL); return; }
     if (audio_fx_play(audio, AUDIO_FX_BEEP)) return;
     play_sequence(audio, s, 1);
 }
@@ -1327,6 +1910,7 @@ void audio_beep(Audio *audio)
 void audio_blip(Audio *audio)
 {
     static const AudioNote s[] = { { 1320, 60 } };
+    if (audio && audio->server) { server_post(audio, SRV_CANNED, AUDIO_FX_BLIP, 0, 0, NULL); return; }
     if (audio_fx_play(audio, AUDIO_FX_BLIP)) return;
     play_sequence(audio, s, 1);
 }
@@ -1337,6 +1921,7 @@ void audio_blip(Audio *audio)
 void audio_success(Audio *audio)
 {
     static const AudioNote s[] = { { 523, 120 }, { 659, 120 }, { 784, 220 } };
+    if (audio && audio->server) { server_post(audio, SRV_CANNED, AUDIO_FX_SUCCESS, 0, 0, NULL); return; }
     if (audio_fx_play(audio, AUDIO_FX_SUCCESS)) return;
     play_sequence(audio, s, 3);
 }
@@ -1347,6 +1932,7 @@ void audio_success(Audio *audio)
 void audio_fail(Audio *audio)
 {
     static const AudioNote s[] = { { 392, 150 }, { 330, 150 }, { 262, 300 } };
+    if (audio && audio->server) { server_post(audio, SRV_CANNED, AUDIO_FX_FAIL, 0, 0, NULL); return; }
     if (audio_fx_play(audio, AUDIO_FX_FAIL)) return;
     play_sequence(audio, s, 3);
 }
@@ -1360,6 +1946,7 @@ void audio_fail(Audio *audio)
 void audio_gameover(Audio *audio)
 {
     static const AudioNote s[] = { { 1046, 140 }, { 880, 140 }, { 784, 140 }, { 740, 260 } };
+    if (audio && audio->server) { server_post(audio, SRV_CANNED, AUDIO_FX_GAMEOVER, 0, 0, NULL); return; }
     if (audio_fx_play(audio, AUDIO_FX_GAMEOVER)) return;
     play_sequence(audio, s, 4);
 }
@@ -1409,6 +1996,65 @@ static bool sample_live(const Audio *audio, const AudioSampleVoice *sv)
            audio_mix_voice_pending(&audio->mix, sv->slot, sv->gen) > 0;
 }
 
+/*
+ * The sample voices' fill: `ctx` is the AudioSampleVoice, and the read is its
+ * `wav`'s.
+ *
+ * ⚠️ **The chained handoff happens HERE, on the frame the pass ends**, because
+ * the mixer ends a voice on a short fill (audio_gen.h) and anything the game did
+ * at the boundary would land a buffer late — a gap, which is what the cue exists
+ * to remove.  The swap is two struct copies and no I/O: the cued file was opened
+ * and mapped at cue time, and the retired one is parked in `next` for the next
+ * cue or audio_close() to close, never closed here on the audio path.  Safe
+ * without a lock because the fill and every cue run on ONE thread — the game's
+ * pump, or the server's loop when there is a server.
+ */
+static long sample_read(void *ctx, int16_t *dst, long frames)
+{
+    AudioSampleVoice *sv = (AudioSampleVoice *)ctx;
+    long got = audio_wav_read(&sv->wav, dst, frames);
+    if (got < frames && sv->chain && sv->next.f) {
+        AudioWav done = sv->wav;
+        sv->wav          = sv->next;
+        sv->next         = done;
+        sv->next_path[0] = '\0';        /* retired, not cued: a start must not take it */
+        sv->chain        = false;
+        sv->handoffs++;
+        got += audio_wav_read(&sv->wav, dst + got, frames - got);
+    }
+    return got;
+}
+
+/* What the mixer calls.  A file at a foreign rate is read through the voice's
+ * converter, which pulls sample_read() as its window needs — so a chained
+ * handoff lands inside the converter's input and the filter runs straight
+ * across it. */
+static long sample_fill(void *ctx, int16_t *dst, long frames)
+{
+    AudioSampleVoice *sv = (AudioSampleVoice *)ctx;
+    if (sv->convert) return audio_rs_pull(&sv->rs, sample_read, sv, dst, frames);
+    return sample_read(sv, dst, frames);
+}
+
+/* Point the voice's converter at `wav`'s rate, or switch it off.  Called on
+ * every start — not on a resume, whose window holds input already read. */
+static bool sample_rate_setup(Audio *audio, AudioSampleVoice *sv, const char *what,
+                              const char *path)
+{
+    sv->convert = (sv->wav.rate != audio->sample_rate);
+    if (!sv->convert) return true;
+    if (sv->rs.in_rate == sv->wav.rate && sv->rs.out_rate == audio->sample_rate) {
+        audio_rs_reset(&sv->rs);                   /* coefficients still good */
+        return true;
+    }
+    if (audio_rs_init(&sv->rs, sv->wav.rate, audio->sample_rate)) return true;
+    fprintf(stderr, "audio: %s refused — %s is %d Hz, the device granted %d, and "
+                    "that pair is past the converter's range\n",
+            what, path, sv->wav.rate, audio->sample_rate);
+    sv->convert = false;
+    return false;
+}
+
 /*
  * Hand `sv`'s ALREADY-OPEN file to the bus.  `how` is the word the receipt uses.
  *
@@ -1436,9 +2082,19 @@ static bool sample_arm(Audio *audio, AudioSampleVoice *sv, const char *what,
 
     /* ⚠️ What is LEFT of the file, not all of it.  On a fresh open `pos` is 0 and
      * the two are the same expression; a RESUMED voice that declared the whole
-     * file would outlive its data and the mixer would pad the tail with silence. */
-    long total = sample_total_frames(sv->wav.frames - sv->wav.pos, sv->wav.loop);
-    int  slot  = audio_mix_add_sample(&audio->mix, audio_wav_fill, &sv->wav,
+     * file would outlive its data and the mixer would pad the tail with silence.
+     * A pending chain declares as a loop: a cue cleared `wav.loop` so this pass
+     * ENDS, and the voice must outlast it into the cued track. */
+    bool goes_on = sv->wav.loop || (sv->chain && sv->next.f);
+    long left    = sv->wav.frames - sv->wav.pos;
+    if (sv->convert) {
+        /* In OUTPUT frames, and counting the input the converter's window
+         * already holds — read, so not in `left`, and still to be played. */
+        left = audio_rs_frames_out(sv->wav.rate, audio->sample_rate,
+                                   left + audio_rs_buffered(&sv->rs));
+    }
+    long total = sample_total_frames(left, goes_on);
+    int  slot  = audio_mix_add_sample(&audio->mix, sample_fill, sv,
                                       sv->buf, sv->buf_frames, total,
                                       audio_voice_peak(audio->vol));
     if (slot < 0) {
@@ -1456,9 +2112,10 @@ static bool sample_arm(Audio *audio, AudioSampleVoice *sv, const char *what,
     sv->gen  = audio_mix_voice_gen(&audio->mix, slot);
     sv->held = false;
     fprintf(stderr, "audio: %s %s %s — %ld frames in file, %ld consumed, "
-                    "%ld declared, %d Hz %d ch, loop=%d, slot %d gen %lu\n",
+                    "%ld declared, %d Hz%s %d ch, loop=%d, slot %d gen %lu\n",
             what, how, path ? path : "(the held file)", sv->wav.frames,
-            sv->wav.pos, total, sv->wav.rate, sv->wav.channels,
+            sv->wav.pos, total, sv->wav.rate, sv->convert ? " converted" : "",
+            sv->wav.channels,
             (int)sv->wav.loop, slot, (unsigned long)sv->gen);
     return true;
 }
@@ -1490,23 +2147,40 @@ static bool sample_start(Audio *audio, AudioSampleVoice *sv, const char *path,
         return false;
     }
 
+    /* A start supersedes a pending chain; a cue naming this path is taken
+     * instead of an open — the file is already open, mapped and hinted. */
+    sv->chain = false;
     audio_wav_close(&sv->wav);          /* a restart must not leak the old fd */
+    if (sv->next.f && sv->next_path[0] && strcmp(sv->next_path, path) == 0) {
+        sv->wav = sv->next;
+        memset(&sv->next, 0, sizeof sv->next);
+        sv->next_path[0] = '\0';
+        sv->wav.loop = loop;
+        if (!sample_rate_setup(audio, sv, what, path)) {
+            audio_wav_close(&sv->wav);
+            return false;
+        }
+        return sample_arm(audio, sv, what, "start (cued)", path);
+    }
     if (!audio_wav_open(&sv->wav, path, loop)) {
         fprintf(stderr, "audio: %s cannot open %s\n", what, path);
         return false;
     }
 
-    /* ⚠️ No resampler, and no plan for one.  Playing 22050 material at 44100 is a
-     * pitch bug that sounds like a bad recording — the hardest audio fault to
-     * attribute — so failing is cheaper than guessing. */
-    if (sv->wav.rate != audio->sample_rate) {
-        fprintf(stderr, "audio: %s refused — %s is %d Hz, the device granted %d, "
-                        "and there is no resampler\n",
-                what, path, sv->wav.rate, audio->sample_rate);
+    /* A foreign rate streams through the voice's converter.  ⚠️ Never played
+     * raw: 22050 material at 44100 is a pitch bug that sounds like a bad
+     * recording — the hardest audio fault to attribute — so a pair the
+     * converter does not take is still refused rather than guessed at. */
+    if (!sample_rate_setup(audio, sv, what, path)) {
         audio_wav_close(&sv->wav);
         return false;
     }
 
+    /* Mapped, so an SD stall costs this voice a gap instead of costing the
+     * whole render a wait (audio_wav.h).  A file that cannot be mapped still
+     * plays, through stdio — the path every bed used before. */
+    audio_wav_map(&sv->wav);
+
     return sample_arm(audio, sv, what, "start", path);
 }
 
@@ -1520,6 +2194,7 @@ static bool sample_start(Audio *audio, AudioSampleVoice *sv, const char *path,
 bool audio_music_pause(Audio *audio)
 {
     if (!audio) return false;
+    if (audio->server) return server_call(audio, SRV_MUSIC_PAUSE, 0, NULL);
     if (!audio_music_active(audio)) {
         fprintf(stderr, "audio: music pause — nothing is sounding\n");
         return false;
@@ -1532,6 +2207,7 @@ bool audio_music_pause(Audio *audio)
 bool audio_music_resume(Audio *audio)
 {
     if (!audio) return false;
+    if (audio->server) return server_call(audio, SRV_MUSIC_RESUME, 0, NULL);
     if (!audio->music.held || !audio->music.wav.f) {
         fprintf(stderr, "audio: music resume refused — no bed is held "
                         "(audio_music_pause() first, or start one)\n");
@@ -1561,11 +2237,81 @@ bool audio_music_start(Audio *audio, const char *path, bool loop)
     /* The MUSIC toggle.  Quiet, because a game's bed state machine reads this as
      * "no bed" and stops asking — audio_music_enabled() is what it should print. */
     if (!audio->music_on) return false;
+    if (audio->server) return server_call(audio, SRV_MUSIC_START, loop, path);
     return sample_start(audio, &audio->music, path, loop, "music");
 }
 
+bool audio_music_cue(Audio *audio, const char *path, bool chain)
+{
+    if (!audio) return false;
+    if (!audio->music_on) return false;     /* the MUSIC toggle, quiet as in start */
+    if (audio->server) return server_call(audio, SRV_MUSIC_CUE, chain, path);
+    if (!audio->available || !path || !*path) return false;
+
+    AudioSampleVoice *sv = &audio->music;
+    if (strlen(path) >= sizeof sv->next_path) {
+        fprintf(stderr, "audio: music cue refused — %s is longer than %zu bytes\n",
+                path, sizeof sv->next_path - 1);
+        return false;
+    }
+    /* A re-cue, or the file the last handoff retired.  Never the mixer's ctx:
+     * the fill reads `wav` only, so this close cannot pull a file from under it. */
+    audio_wav_close(&sv->next);
+    sv->next_path[0] = '\0';
+    if (sv->chain) {
+        sv->chain    = false;
+        sv->wav.loop = true;            /* the cue it cancels had cleared it */
+    }
+
+    if (!audio_wav_open(&sv->next, path, true)) {
+        fprintf(stderr, "audio: music cue cannot open %s\n", path);
+        return false;
+    }
+    if (sv->next.rate != audio->sample_rate &&
+        !audio_rs_supported(sv->next.rate, audio->sample_rate)) {
+        fprintf(stderr, "audio: music cue refused — %s is %d Hz, the device granted "
+                        "%d, and that pair is past the converter's range\n",
+                path, sv->next.rate, audio->sample_rate);
+        audio_wav_close(&sv->next);
+        return false;
+    }
+    /* The prefetch.  audio_wav_map() hints the first two windows WILLNEED, so the
+     * kernel reads the head in while the current track plays; a file that cannot
+     * be mapped is still cued, and costs its stdio reads at the boundary. */
+    audio_wav_map(&sv->next);
+    snprintf(sv->next_path, sizeof sv->next_path, "%s", path);
+
+    if (chain) {
+        if (sv->wav.f && !sv->wav.loop) {
+            fprintf(stderr, "audio: music cue %s stands but is NOT chained — the "
+                            "bed does not loop, so its voice ends with its "
+                            "file\n", path);
+        } else if (sv->wav.f && sv->next.rate != sv->wav.rate) {
+            /* The handoff happens inside the converter's input, which has ONE
+             * ratio; a different rate needs a fresh start. */
+            fprintf(stderr, "audio: music cue %s stands but is NOT chained — it is "
+                            "%d Hz and the bed is %d Hz\n",
+                    path, sv->next.rate, sv->wav.rate);
+        } else {
+            /* End THIS pass instead of wrapping it; sample_fill() hands off on
+             * the frame it ends. */
+            sv->chain    = true;
+            sv->wav.loop = false;
+        }
+    }
+    fprintf(stderr, "audio: music cue %s — %ld frames, %s, chain=%d\n",
+            path, sv->next.frames, sv->next.map ? "mapped" : "stdio", (int)sv->chain);
+    return true;
+}
+
+uint32_t audio_music_handoffs(const Audio *audio)
+{
+    return PUMP_COUNTER(audio, handoffs, (uint32_t)audio->music.handoffs);
+}
+
 void audio_music_stop(Audio *audio)
 {
+    if (audio && audio->server) { server_post(audio, SRV_MUSIC_STOP, 0, 0, 0, NULL); return; }
     if (!audio || audio->music.slot < 0) return;
     /* ⚠️ Release, not cut.  audio_mix_release_voice() shortens the voice to
      * `pos + release` so the existing envelope walks it to exactly 0; clearing
@@ -1583,14 +2329,19 @@ void audio_music_stop(Audio *audio)
 
 bool audio_music_active(const Audio *audio)
 {
-    return audio ? sample_live(audio, &audio->music) : false;
+    if (!audio) return false;
+    return audio->server ? SRV_READ(audio, music_active) != 0
+                         : sample_live(audio, &audio->music);
 }
 
 bool audio_sfx_play(Audio *audio, const char *path)
 {
     if (!audio) return false;
     if (!audio->effects_on) return false;   /* the EFFECTS toggle */
-    return sample_start(audio, &audio->sfx, path, false, "sfx");
+    if (audio->server) return server_call(audio, SRV_SFX_PLAY, 0, path);
+    if (!sample_start(audio, &audio->sfx, path, false, "sfx")) return false;
+    lat_mark(audio);
+    return true;
 }
 
 bool audio_music_enabled(const Audio *audio)
@@ -1602,3 +2353,280 @@ bool audio_effects_enabled(const Audio *audio)
 {
     return audio && audio->effects_on;
 }
+
+bool audio_server_enabled(const Audio *audio)
+{
+    return audio && audio->server_on;
+}
+
+/* ── The audio server ────────────────────────────────────────────────────────
+ *
+ * A fork() of the game that keeps the continuous stream and does nothing else:
+ * take commands, service, publish, nap.  Everything it runs is the code above,
+ * on its own copy of the `Audio` with `server` NULL — so there is no second
+ * implementation of any sound, only a second caller of the first one.
+ *
+ * ⚠️ **The page is the ONLY thing the two processes share.**  After the fork the
+ * game's `mix`, `music` and clip bank are stale copies nobody renders; every
+ * reading the game makes of the bus comes from the words below, which the
+ * server writes and the game only loads.
+ */
+
+/** The server's nap between services, in µs — a quarter of the service
+ *  interval, clamped.  It is also the worst-case latency a command adds, so the
+ *  ceiling is a tenth of a frame's worth of tap rather than the stream's own
+ *  much looser deadline. */
+#define SERVER_NAP_MIN_US     2000
+#define SERVER_NAP_MAX_US     10000
+
+/** How long a synchronous call waits for its answer.  A bed start opens a file
+ *  on SD; one that takes this long is broken, not slow. */
+#define SERVER_CALL_MAX_MS    1000
+
+/** How long audio_close() lets the server drain before SIGKILL.  The drain is
+ *  bounded by one ring (~0.5 s, audio_out_close()), so this is four of them. */
+#define SERVER_QUIT_MAX_MS    2000
+
+static void server_publish(const Audio *a, AudioServer *s)
+{
+#define PUB(field, v) __atomic_store_n(&s->field, (v), __ATOMIC_RELAXED)
+    PUB(voices,  (uint32_t)audio_mix_active(&a->mix));
+    PUB(clipped, a->mix.clipped);
+    PUB(dropped, a->mix.dropped);
+    PUB(limited, a->mix.limited);
+    PUB(starved, a->pump_starved);
+    PUB(lost,    a->pump_lost);
+    PUB(stalled, (uint32_t)(a->music.wav.stalled + a->sfx.wav.stalled));
+    PUB(lead,    (int32_t)a->pump_lead);
+    PUB(period,  (int32_t)a->pump_period);
+    PUB(music_active, audio_music_active(a) ? 1u : 0u);
+    PUB(handoffs, (uint32_t)a->music.handoffs);
+    /* The window's summary is a histogram walk, so it is redone only when a
+     * trigger resolved, one was missed, or a reset emptied it — the server is
+     * the only writer of these words, so its own last publish is the test. */
+    if (s->lat.count != a->lat.count || s->lat.missed != a->lat.missed) {
+        AudioLatencyStats st;
+        audio_lat_stats(&a->lat, &st);
+        PUB(lat.count,  st.count);
+        PUB(lat.missed, st.missed);
+        PUB(lat.min_us, st.min_us);
+        PUB(lat.avg_us, st.avg_us);
+        PUB(lat.p50_us, st.p50_us);
+        PUB(lat.p99_us, st.p99_us);
+        PUB(lat.max_us, st.max_us);
+    }
+#undef PUB
+}
+
+static int server_apply(Audio *a, const AudioCmd *c)
+{
+    switch (c->op) {
+    case SRV_TONE:         tone_at(a, c->a, c->b, (uint32_t)c->c);       return 1;
+    case SRV_INTERRUPT:    audio_interrupt(a);                           return 1;
+    case SRV_CANNED:
+        if (c->a >= 0 && c->a < AUDIO_FX_COUNT) CANNED[c->a](a);
+        return 1;
+    case SRV_FX_PLAY:      return audio_fx_play(a, (AudioFxId)c->a);
+    case SRV_FX_PATH:      audio_fx_set_path(a, (AudioFxId)c->a, c->path); return 1;
+    case SRV_MUSIC_START:  return audio_music_start(a, c->path, c->a != 0);
+    case SRV_MUSIC_STOP:   audio_music_stop(a);                          return 1;
+    case SRV_MUSIC_PAUSE:  return audio_music_pause(a);
+    case SRV_MUSIC_RESUME: return audio_music_resume(a);
+    case SRV_MUSIC_CUE:    return audio_music_cue(a, c->path, c->a != 0);
+    case SRV_SFX_PLAY:     return audio_sfx_play(a, c->path);
+    case SRV_VOLUME:       audio_set_volume(a, c->a);                    return 1;
+    case SRV_SHIFT:        audio_set_master_shift(a, c->a);              return 1;
+    case SRV_LIMIT:        audio_pump_set_limit(a, c->a);                return 1;
+    case SRV_KEEPALIVE:    audio_pump_set_keepalive(a, c->a != 0);       return 1;
+    case SRV_PUMP_ENABLE:  audio_pump_enable(a, c->a != 0);              return 1;
+    case SRV_STREAM_START: audio_stream_start(a, c->a);                  return 1;
+    case SRV_STREAM_FREQ:  audio_stream_set_freq(a, c->a);               return 1;
+    case SRV_STREAM_STOP:  audio_stream_stop(a);                         return 1;
+    case SRV_LAT_RESET:    audio_latency_reset(a);                       return 1;
+    }
+    return 0;
+}
+
+static useconds_t server_nap_us(const Audio *a)
+{
+    long us = audio_cont_service_interval_us(a) / 4;
+    if (us < SERVER_NAP_MIN_US) us = SERVER_NAP_MIN_US;
+    if (us > SERVER_NAP_MAX_US) us = SERVER_NAP_MAX_US;
+    return (useconds_t)us;
+}
+
+/** The child.  Never returns. */
+static void server_main(Audio *a, AudioServer *s, pid_t parent)
+{
+    /* ⚠️ The game's handlers came with the fork.  A Ctrl-C or the launcher's
+     * SIGTERM is the GAME's to act on; it sends QUIT from audio_close(), and if
+     * it dies without one the kernel kills us rather than leaving an orphan
+     * holding /dev/dsp — the check after prctl() closes the race with a parent
+     * that died before it ran. */
+    signal(SIGINT,  SIG_IGN);
+    signal(SIGTERM, SIG_IGN);
+    signal(SIGHUP,  SIG_IGN);
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+    if (getppid() != parent) _exit(0);
+
+    server_publish(a, s);
+    __atomic_store_n(&s->ready, 1u, __ATOMIC_RELEASE);
+
+    for (;;) {
+        AudioCmd c;
+        while (audio_cmd_pop(&s->ring, &c)) {
+            if (c.op == SRV_QUIT) {
+                audio_close(a);                    /* drains; prints the bus line */
+                __atomic_store_n(&s->applied, c.seq, __ATOMIC_RELEASE);
+                fflush(NULL);
+                _exit(0);
+            }
+            /* The trigger's clock started in the GAME, when it posted. */
+            a->issue_us = c.t_us;
+            a->issued   = true;
+            int r = server_apply(a, &c);
+            a->issued   = false;
+            server_publish(a, s);
+            __atomic_store_n(&s->result, (uint32_t)r, __ATOMIC_RELAXED);
+            __atomic_store_n(&s->applied, c.seq, __ATOMIC_RELEASE);
+        }
+        audio_pump(a);
+        server_publish(a, s);
+        usleep(server_nap_us(a));
+    }
+}
+
+int audio_server_start(Audio *audio)
+{
+    if (!audio || !audio->available) return -1;
+    if (audio->server) return 0;
+    if (!audio->cont && audio_cont_enable(audio, true) != 0) return -1;
+
+    AudioServer *s = (AudioServer *)mmap(NULL, sizeof(AudioServer),
+                                         PROT_READ | PROT_WRITE,
+                                         MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (s == MAP_FAILED) {
+        perror("audio: server mmap");
+        return -1;
+    }
+    memset(s, 0, sizeof(*s));
+    audio_cmd_init(&s->ring);
+
+    /* Unflushed stdio would be written twice, once by each process. */
+    fflush(NULL);
+    pid_t parent = getpid();
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("audio: server fork");
+        munmap(s, sizeof(*s));
+        return -1;                     /* the in-loop path is untouched */
+    }
+    if (pid == 0) server_main(audio, s, parent);
+
+    /* The game's half: drop our copy of the stream WITHOUT a drain — the queue
+     * is the server's now — and forget the bus, so nothing here renders a voice
+     * or writes the device again. */
+    audio_out_release(&audio->out);
+    audio->cont           = false;
+    audio->osc_stream     = false;
+    audio->pumping        = false;
+    audio->streaming      = false;
+    audio->server         = s;
+    audio->server_pid     = (int)pid;
+    audio->server_seq     = 0;
+    audio->server_refused = 0;
+
+    /* Bounded: a server that never comes up is reported, not waited on forever.
+     * Commands posted meanwhile queue in the ring and are applied once it does. */
+    for (int ms = 0; ms < SERVER_CALL_MAX_MS; ms++) {
+        if (__atomic_load_n(&s->ready, __ATOMIC_ACQUIRE)) break;
+        usleep(1000);
+    }
+    fprintf(stderr, "audio: server pid %d owns the stream (%s)\n", (int)pid,
+            __atomic_load_n(&s->ready, __ATOMIC_ACQUIRE) ? "ready" : "NOT ready yet");
+    return 0;
+}
+
+bool audio_server_active(const Audio *audio)
+{
+    return audio && audio->server;
+}
+
+/** Post one command.  ⚠️ Never waits: a full ring means the server is not
+ *  keeping up, and a game frame blocked on it would be the stall this exists to
+ *  remove — so the command is dropped and counted, and the first one says so. */
+static void server_post(Audio *audio, int op, int a, int b, int c, const char *path)
+{
+    AudioCmd cmd;
+    cmd.seq  = audio->server_seq + 1;
+    cmd.t_us = time_now_us();
+    cmd.op   = op;
+    cmd.a    = a;
+    cmd.b    = b;
+    cmd.c    = c;
+    cmd.path[0] = '\0';
+    if (path) {
+        /* Refused rather than truncated: a cut path opens the wrong file or
+         * none, and the server's refusal would then name a path nobody wrote. */
+        if (strlen(path) >= AUDIO_CMD_PATH_MAX) {
+            fprintf(stderr, "audio: server refused a %zu-byte path (max %d): %s\n",
+                    strlen(path), AUDIO_CMD_PATH_MAX - 1, path);
+            return;
+        }
+        memcpy(cmd.path, path, strlen(path) + 1);
+    }
+    if (!audio_cmd_push(&audio->server->ring, &cmd)) {
+        if (audio->server_refused++ == 0)
+            fprintf(stderr, "audio: server ring full (%d commands) — dropping "
+                            "op %d; is the server alive?\n", AUDIO_CMD_SLOTS, op);
+        return;
+    }
+    audio->server_seq = cmd.seq;
+}
+
+/** Post one command and wait for its answer.  False on a refused post or a
+ *  server that did not answer in SERVER_CALL_MAX_MS. */
+static bool server_call(Audio *audio, int op, int a, const char *path)
+{
+    uint32_t before = audio->server_seq;
+    server_post(audio, op, a, 0, 0, path);
+    if (audio->server_seq == before) return false;         /* not posted */
+
+    uint32_t seq = audio->server_seq;
+    AudioServer *s = audio->server;
+    for (int ms = 0; ms <= SERVER_CALL_MAX_MS; ms++) {
+        /* Signed difference: `seq` wraps through 2^32 like the ring does. */
+        if ((int32_t)(__atomic_load_n(&s->applied, __ATOMIC_ACQUIRE) - seq) >= 0)
+            return __atomic_load_n(&s->result, __ATOMIC_RELAXED) != 0;
+        usleep(1000);
+    }
+    fprintf(stderr, "audio: server did not answer op %d in %d ms\n",
+            op, SERVER_CALL_MAX_MS);
+    return false;
+}
+
+static void server_stop(Audio *audio)
+{
+    AudioServer *s = audio->server;
+    pid_t pid = (pid_t)audio->server_pid;
+    int status = 0;
+    bool reaped = false;
+
+    server_post(audio, SRV_QUIT, 0, 0, 0, NULL);
+    for (int ms = 0; ms < SERVER_QUIT_MAX_MS; ms++) {
+        if (waitpid(pid, &status, WNOHANG) == pid) { reaped = true; break; }
+        usleep(1000);
+    }
+    if (!reaped) {
+        fprintf(stderr, "audio: server pid %d did not quit in %d ms — killing it\n",
+                (int)pid, SERVER_QUIT_MAX_MS);
+        kill(pid, SIGKILL);
+        waitpid(pid, &status, 0);
+    }
+    fprintf(stderr, "audio: server closed — posted=%u refused=%u\n",
+            audio->server_seq, audio->server_refused);
+
+    munmap(s, sizeof(*s));
+    audio->server     = NULL;
+    audio->server_pid = 0;
+}
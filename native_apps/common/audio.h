@@ -42,7 +42,7 @@
  * ⚠️ **A struct rather than five `music_*` fields, because there are TWO of
  * these and the policy must not be written twice.**  A bed and an effect differ
  * only in which instance they name and whether they loop — refusing off the bus,
- * refusing a rate mismatch, refusing while the previous one still sounds, and
+ * converting a foreign rate, refusing while the previous one still sounds, and
  * arming the release instead of cutting are one code path in `audio.c`.  The
  * moment that was two code paths, the bed and the effect could drift apart in
  * exactly the way `audio_gen.h`'s full-bus rule exists to prevent.
@@ -50,9 +50,18 @@
  * `slot` is -1 when idle and is set by `level_defaults()`, which every entry
  * point runs — a zeroed `slot` is slot 0, i.e. somebody else's voice.
  *
- * ⚠️ **`buf` and `wav` are the mixer's `ctx`, so this struct must not be copied
- * or moved while a voice is live**: `audio_mix_add_sample()` stores the pointers.
- * Nothing copies an `Audio`; this is the reason not to start.
+ * ⚠️ **This struct is the mixer's `ctx`, so it must not be copied or moved
+ * while a voice is live**: `audio_mix_add_sample()` stores the pointer, and the
+ * fill reads `wav` through it.  Nothing copies an `Audio`; this is the reason
+ * not to start.
+ *
+ * `next` is the bed's CUED track (`audio_music_cue()`): opened, rate-checked and
+ * mapped ahead of time so a track change costs neither a cold open nor a gap.  It
+ * is never the mixer's ctx — the fill only ever reads `wav` — which is why it can
+ * be closed and replaced while the bed sounds.  After a `chain` handoff it holds
+ * the RETIRED file, with `next_path` empty, until the next cue or audio_close():
+ * the handoff happens inside the render, and a close there is an munmap and an
+ * fclose on the audio path.
  */
 typedef struct {
     AudioWav wav;             /**< the open file; `wav.f` NULL when closed       */
@@ -64,6 +73,17 @@ typedef struct {
                                *   released but `wav` stays OPEN at its position,
                                *   which is what a resume re-arms over.  ⚠️ Not
                                *   the same as "idle": an idle voice has no file  */
+    AudioWav next;            /**< the cued track, or a retired one; `next.f` NULL
+                               *   when empty.  Never the mixer's ctx            */
+    char     next_path[AUDIO_CMD_PATH_MAX]; /**< what `next` was cued from; ""
+                               *   when nothing is cued                         */
+    bool     chain;           /**< hand off to `next` at the end of this pass,
+                               *   inside the fill, on the exact frame            */
+    long     handoffs;        /**< chained handoffs done — a countable receipt    */
+    bool     convert;         /**< `wav.rate` is not the device's: the fill
+                               *   reads through `rs`                           */
+    AudioResampler rs;        /**< that converter; its window is live state, so
+                               *   a resume continues it and a start resets it  */
 } AudioSampleVoice;
 
 /* ── Recorded clips in RAM: what the four canned sounds are MADE of ──────────
@@ -84,10 +104,19 @@ typedef struct {
 
 /** One loaded effect, shared by every voice playing it.  `pcm` is the whole file
  *  as mono 16-bit at the device rate — the mixer's own format, so a trigger is a
- *  `memcpy` and nothing converts anything at play time. */
+ *  `memcpy` and nothing converts anything at play time.
+ *
+ *  An IMA-ADPCM file is kept AS STORED instead, in `adpcm`, at a quarter of the
+ *  bytes, and each voice decodes the block under its own cursor (`AudioClipVoice`
+ *  → `dec`).  ⚠️ Exactly one of `pcm` / `adpcm` is set on a loaded clip. */
 typedef struct {
     int16_t *pcm;             /**< NULL until loaded, and NULL again on a miss   */
-    long     frames;          /**< what `pcm` holds                              */
+    uint8_t *adpcm;           /**< the compressed payload, or NULL for PCM        */
+    long     adpcm_bytes;     /**< what `adpcm` holds                            */
+    int      block_align;     /**< ADPCM bytes per block                         */
+    long     block_frames;    /**< frames one full block decodes to              */
+    int      channels;        /**< ADPCM channels; decoded to mono per block     */
+    long     frames;          /**< what `pcm` holds, or `adpcm` decodes to       */
     bool     tried;           /**< a load was ATTEMPTED.  ⚠️ A miss is permanent
                                *   for the process on purpose: the files can
                                *   legitimately be absent (F19), and retrying per
@@ -100,6 +129,10 @@ typedef struct {
                                *   sounding this `pcm` right now and the mixer
                                *   holds the pointer — freeing there is a
                                *   use-after-free, not a silence               */
+    bool     shared;          /**< `pcm` / `adpcm` point into the shared bank's
+                               *   read-only mapping, not at our heap.  ⚠️ Never
+                               *   free()d: the mapping is released whole, by
+                               *   audio_close(), after every voice is gone     */
 } AudioClip;
 
 /** One playing instance of a clip: the clip, a cursor into it, and the scratch
@@ -113,6 +146,9 @@ typedef struct {
     long     buf_frames;      /**< its size                                      */
     int      slot;            /**< mix-bus slot, -1 when idle                     */
     uint32_t gen;             /**< its generation, so a REUSED slot is not read   */
+    int16_t *dec;             /**< ADPCM: the block under `pos`, decoded          */
+    long     dec_cap;         /**< its size in frames; grown, never shrunk        */
+    long     dec_block;       /**< which block `dec` holds, -1 for none           */
 } AudioClipVoice;
 
 /** The canned sounds, and the order everything here indexes them in. */
@@ -147,6 +183,16 @@ typedef enum {
 /** Room for a clip path from config.  Device paths are `/opt/sound/fx_fail.wav`. */
 #define AUDIO_FX_PATH_MAX        128
 
+/** Where app_launcher publishes the effect bank: tmpfs, so it is RAM that every
+ *  game maps rather than copies, and it is gone at reboot along with anything
+ *  stale in it.  See audio_fx_bank_publish(). */
+#define AUDIO_FX_BANK_PATH       "/dev/shm/roomwizard-fxbank"
+
+/** The rate the bank is published at: what audio_open() asks for and the OMAP
+ *  codec grants.  The publisher opens no device to find out, and a game granted
+ *  anything else simply loads privately. */
+#define AUDIO_FX_BANK_RATE       44100
+
 typedef struct {
     int      dsp_fd;          /**< /dev/dsp file descriptor (-1 = not open)      */
     int      sample_rate;     /**< Negotiated sample rate (read back, typ. 44100) */
@@ -234,6 +280,8 @@ typedef struct {
                                *   audio_init()/audio_init_unchecked(); an EMPTY
                                *   string means "use the note table", which is how
                                *   a config file switches one name back to tones  */
+    const uint8_t *fx_bank;   /**< the shared bank, mapped read-only, or NULL    */
+    size_t         fx_bank_bytes;
     /* ── the two operator toggles from the games menu ────────────────────────
      * ⚠️ **Both default TRUE and only audio_init() lowers them**, which is what
      * keeps audio_init_unchecked() a real bypass: a hardware speaker test must
@@ -249,6 +297,23 @@ typedef struct {
      */
     bool     music_on;        /**< `music_enabled`   config key, default true      */
     bool     effects_on;      /**< `effects_enabled` config key, default true      */
+    /* ── trigger-to-DAC latency (audio_latency_stats()) ── */
+    AudioLatency lat;         /**< the window, and triggers awaiting a service     */
+    uint32_t issue_us;        /**< the posting time of the server command being
+                               *   applied — valid while `issued` is set           */
+    bool     issued;
+    /* ── the audio server: OPTIONAL, off unless audio_server_start() ran ─────
+     * ⚠️ Set in the GAME's copy of this struct only.  The server process runs
+     * on its own copy with `server` NULL, which is what makes every entry point
+     * below take its ordinary path there and its proxy path here.
+     */
+    struct AudioServer *server; /**< the shared page; NULL = no server        */
+    int      server_pid;      /**< the child, for the QUIT and the reap          */
+    uint32_t server_seq;      /**< commands posted, = the last one's `seq`       */
+    uint32_t server_refused;  /**< posts refused because the ring was full       */
+    bool     server_on;       /**< `audio_server` config key, default FALSE      */
+    bool     alsa_on;         /**< `audio_backend = alsa`: the stream opens on
+                               *   native ALSA, falling back to OSS            */
 } Audio;
 
 /**
@@ -321,7 +386,8 @@ void audio_tone(Audio *audio, int freq_hz, int duration_ms);
  * Two sounds at once needs userspace to hold the audio and hand the device
  * small pieces of it, because you cannot mix into a buffer the kernel already
  * has.  This library does that from the render loop — never a thread: static
- * ARM plus pthread is the SIGSEGV-before-main() scar (../CLAUDE.md).
+ * ARM plus pthread is the SIGSEGV-before-main() scar (../CLAUDE.md) — or, opted
+ * in, from a forked server process (audio_server_start() below).
  *
  * ⚠️ **It is opt-in, and that is a safety property rather than a convenience.**
  * An app that never calls audio_pump_enable() takes exactly the code path it
@@ -341,6 +407,9 @@ void audio_tone(Audio *audio, int freq_hz, int duration_ms);
  *                                                    : FRAME_DELAY_IDLE_US);
  *     }
  *
+ * (The games now do both lines through frame_sched and audio_pump_slot() below;
+ * the rule is the same.)
+ *
  * ⚠️ **That last line matters.** The pump keeps only AUDIO_PUMP_LEAD_MS (80 ms)
  * of audio inside the device, so a loop that drops to FRAME_DELAY_IDLE_US
  * (100 ms) mid-sound starves it and you hear a gap.  audio_pump_active() is the
@@ -362,6 +431,17 @@ void audio_pump(Audio *audio);
  *  is on, because a promise of continuous silence is also a promise of frames. */
 bool audio_pump_active(const Audio *audio);
 
+/** audio_pump() then audio_pump_active(), in the shape of a frame_sched audio
+ *  slot (`FrameAudioFn`, common/frame_sched.h) — `user` is the Audio.  Every
+ *  game paces with it:
+ *
+ *      frame_sched_set_audio(&sched, audio_pump_slot, &audio,
+ *                            audio_cont_service_interval_us(&audio) / 2);
+ *
+ *  so the pump runs once per frame AND in slices through a long wait, and the
+ *  pacing still asks the component whether it owes the device frames. */
+bool audio_pump_slot(void *audio);
+
 /** Voices occupying a slot right now (0..AUDIO_MAX_VOICES). */
 int  audio_pump_voices(const Audio *audio);
 
@@ -390,6 +470,13 @@ uint32_t audio_pump_starved(const Audio *audio);
  *  gone, and a non-zero count is a discontinuity in the waveform. */
 uint32_t audio_pump_lost(const Audio *audio);
 
+/** Frames the streaming voices played as silence because their file had not
+ *  reached the page cache yet (`AudioWav.stalled`, bed plus effect, current
+ *  files).  ⚠️ **Read it beside `starve`**: a stall here is one voice's gap with
+ *  the bus still on time, where the same SD hiccup on the old `fread` path was a
+ *  render that overran and showed up as `starve`. */
+uint32_t audio_pump_stalled(const Audio *audio);
+
 /** The lead the pump LAST TARGETED, in frames, and the device period it was
  *  rounded up to — both 0 until a pump call has read the period off the device.
  *
@@ -406,6 +493,33 @@ uint32_t audio_pump_lost(const Audio *audio);
 long audio_pump_lead(const Audio *audio);
 long audio_pump_period(const Audio *audio);
 
+/**
+ * Trigger-to-DAC latency: how long after the game's call each effect was heard,
+ * as a 1 ms histogram summarised (audio_gen.h, "Trigger-to-DAC latency").
+ *
+ * Measured for every effect the game TRIGGERS — audio_fx_play(), audio_sfx_play(),
+ * an unchained audio_tone() and the first note of a canned note table — and for
+ * nothing else: a bed is not a trigger, and a motif's chained second note starts
+ * late on purpose, so counting it would measure the motif, not the path.
+ * ⚠️ **Continuous stream only**, where frame positions exist; the old per-tone
+ * write path has no stream to position a trigger in and records nothing.
+ *
+ * The clock starts at the GAME's call on either side of the audio server — the
+ * stamp travels in the command — so a server nap and the ring wait are in the
+ * figure, as they are in what a player hears.  Through a server it is a snapshot
+ * one nap old, and its fields are separate words that may come from two
+ * adjacent publishes.
+ *
+ * ⚠️ The library does not link logger.o, so the dump is one line that an app
+ * with a Logger hands to LOG_INFO (`audio_lat_format()`), and audio_close()
+ * prints the same line on stderr beside the bus counters.
+ */
+void audio_latency_stats(const Audio *audio, AudioLatencyStats *out);
+
+/** Start a fresh window — after a warm-up, or between the A and B of a tuning
+ *  comparison.  Triggers still awaiting their service are kept. */
+void audio_latency_reset(Audio *audio);
+
 /** Choose how the summed bus leaves the mixer: AUDIO_MIX_HARD (the default, and
  *  ScummVM's saturating add) or AUDIO_MIX_SOFT, this repo's knee, kept so a panel
  *  can A/B them. */
@@ -512,6 +626,62 @@ bool audio_cont_active(const Audio *audio);
  *  REAL audio rather than the nominal lead — see audio_out.h. */
 long audio_cont_service_interval_us(const Audio *audio);
 
+/* ── The audio server: the bus in a process of its own ──────────────────────
+ *
+ * On the continuous stream audio_pump() must run every
+ * audio_cont_service_interval_us(), and the games' loops do that through
+ * frame_sched — but not every wait in a game is a frame.  `hs_drain_touches()`
+ * (up to 2.3 s) and `keyboard_enter()`'s name-entry loop run without pumping,
+ * and the stream starves for exactly as long.  This moves the bus out of the loop instead of
+ * adding pump calls to every blocking helper.
+ *
+ * ⚠️ **A forked PROCESS, not a thread**: static ARM plus pthread is the
+ * SIGSEGV-before-main() scar (../CLAUDE.md), and a SCHED_RR thread starves this
+ * single core.  The child inherits the open stream and everything in this
+ * struct, services it on its own usleep() cadence at normal priority, and takes
+ * commands from an `AudioCmdRing` (audio_gen.h) on a MAP_SHARED page.  The game
+ * keeps calling the SAME functions; each one posts instead of acting:
+ *
+ *   - **Fire-and-forget** — audio_tone(), the canned sounds, audio_interrupt(),
+ *     audio_music_stop(), the level knobs and the theremin.  Never waits; a full
+ *     ring refuses and counts (`server_refused`) rather than block a frame.
+ *   - ⚠️ **Synchronous** — audio_music_start/pause/resume(), audio_sfx_play() and
+ *     audio_fx_play(), because a caller branches on their answer (platformer's bed
+ *     state machine does).  Each waits, 1 ms at a time and bounded, for the
+ *     server to have applied it; the cost is one server nap.
+ *   - **Counters** — every audio_pump_*() reading, audio_music_active() and
+ *     audio_pump_voices() are words the server publishes after each command and
+ *     each service, read with one atomic load.  They are a snapshot one nap old.
+ *
+ * audio_pump() becomes a no-op and audio_pump_active() false, so the game's loop
+ * may idle: the server paces itself.  A tone's chaining recency (audio_tone())
+ * is judged on the time the GAME issued it, carried in the command, so a motif
+ * posted in one frame still chains however the server's nap falls.
+ *
+ * Opt-in per device with the `audio_server` config key, default false; the
+ * in-loop pump stays the measured path.  ⚠️ Not yet measured on the device.
+ */
+
+/**
+ * Hand the stream to a forked server process.  Enters continuous mode first if
+ * the caller has not.  Returns 0 on success; -1 leaves the in-loop path exactly
+ * as it was (no device, no mmap, or no fork).
+ *
+ * Call it ONCE, after audio_init()/audio_cont_enable() and before the first
+ * sound.  ⚠️ Call it before anything else forks — a child forked later inherits
+ * the game's half and would post into the same ring.  audio_close() stops the
+ * server (it drains and prints its own `bus closed` line), and the server dies
+ * with the game if the game dies first.
+ */
+int  audio_server_start(Audio *audio);
+
+/** True while a server owns the bus. */
+bool audio_server_active(const Audio *audio);
+
+/** The `audio_server` config key, as read by audio_init().  The games call
+ *  audio_server_start() when this says so; false on an unchecked struct. */
+bool audio_server_enabled(const Audio *audio);
+
 /* ── Convenience sounds ────────────────────────────────────────────────────
  * Each first waits (≤200 ms) for whatever is still playing, then queues its
  * own tones and returns.  Layer calls for chord effects.
@@ -581,6 +751,41 @@ bool audio_fx_play(Audio *audio, AudioFxId id);
  */
 void audio_fx_set_path(Audio *audio, AudioFxId id, const char *path);
 
+/**
+ * Load every canned name's clip ONCE and publish them as a shared bank at `path`
+ * (AUDIO_FX_BANK_PATH on the device).  Returns how many clips went in, or -1 if
+ * the bank could not be written.
+ *
+ * Without it every game loads the same five `fx_*.wav` into its own heap on the
+ * first trigger of each, so the first hit of every sound pays an SD read inside a
+ * tap and the RAM is held once per process.  app_launcher calls this at startup;
+ * audio_init() then maps the bank and every clip found in it is ready before the
+ * game's first frame.
+ *
+ * `clips` is one path per AudioFxId, or NULL for the ones a game would use — the
+ * defaults with the config's `fx_*` keys on top.  Each is decoded, or converted to
+ * `rate`, by the same loader a trigger uses, so a mapped clip is byte-for-byte
+ * what a private load would hold.
+ * ⚠️ **Written to a temporary name and renamed over `path`**, so a game that
+ * mapped the previous bank keeps reading it intact until it exits.
+ */
+int audio_fx_bank_publish(const char *path, int rate, const char *const *clips);
+
+/**
+ * Map the bank at `path` read-only and adopt every clip in it that is still
+ * current.  Returns true iff a valid bank was mapped.
+ *
+ * audio_init() and audio_init_unchecked() call this with AUDIO_FX_BANK_PATH, so a
+ * game needs nothing; it is public so a test can aim it elsewhere.  A clip is
+ * adopted only when the bank holds its CURRENT path at the device's rate and the
+ * file's mtime and size still match what was published — anything else, and an
+ * absent or malformed bank, falls back to the private load on first trigger,
+ * which is exactly the behaviour without a bank.  ⚠️ Call it before
+ * audio_server_start(): the server is a fork and inherits the mapping, but one
+ * made afterwards stays in the game's process.
+ */
+bool audio_fx_bank_attach(Audio *audio, const char *path);
+
 /* ── Recorded PCM: a music bed and a sample effect ──────────────────────────
  *
  * ⚠️ **These exist only on the mix bus, and they REFUSE loudly off it rather
@@ -590,15 +795,18 @@ void audio_fx_set_path(Audio *audio, AudioFxId id, const char *path);
  * construction.  Silently doing nothing would read on the panel as "the file is
  * broken"; `audio_pump_enable()` (or CONT) first is the fix and the message says so.
  *
- * ⚠️ **They REFUSE a rate mismatch too, for the same reason: there is no
- * resampler here and there is not going to be one.**  Every file we have is
- * 44100 / mono / 16-bit — measured on `.188` 2026-08-20 for all five of
+ * A file at a rate the device did not grant is CONVERTED, never played raw:
+ * a clip once at load, a streamed file incrementally through the voice's own
+ * `AudioResampler` (audio_gen.h).  Every file we ship is 44100 / mono / 16-bit
+ * — measured on `.188` 2026-08-20 for all five of
  * `/opt/sound/{asl_click,asl_error,asl_success,music1-mono,music2-mono}.wav` —
- * and so is what `hw:0,0` grants.  Guessing a rate is a pitch bug that sounds
- * like a bad recording, which is the hardest kind of audio fault to attribute.
+ * and so is what `hw:0,0` grants, so on the shipped path nothing converts.
+ * ⚠️ A pair past the converter's range (audio_rs_supported()) is still REFUSED
+ * loudly: guessing a rate is a pitch bug that sounds like a bad recording,
+ * which is the hardest kind of audio fault to attribute.
  *
  * The read is a PULL from the render loop (`common/audio_wav.c` →
- * `audio_wav_fill`), entered once per read-ahead buffer rather than once per
+ * `audio_wav_read`), entered once per read-ahead buffer rather than once per
  * frame, so `audio_gen.c` still has no fd and this file still owns every one.
  */
 
@@ -606,8 +814,8 @@ void audio_fx_set_path(Audio *audio, AudioFxId id, const char *path);
  * Start the music bed from `path`, looping if asked.
  *
  * Returns true if a voice was added.  Refused — with a reason on `stderr` — when
- * the bus is off, the file will not open, its rate is not the device's, the bus is
- * full, or a previous bed is still sounding.
+ * the bus is off, the file will not open, its rate cannot be converted to the
+ * device's, the bus is full, or a previous bed is still sounding.
  *
  * ⚠️ **`loop` does not mean "forever": it means a large finite total**, because
  * `audio_mix_add_sample()` needs a real `total_frames` for `audio_mix_pending()`
@@ -617,6 +825,42 @@ void audio_fx_set_path(Audio *audio, AudioFxId id, const char *path);
  */
 bool audio_music_start(Audio *audio, const char *path, bool loop);
 
+/**
+ * Open the track that plays NEXT, while the current one is still sounding.
+ *
+ * The file is opened, rate-checked and mapped now, and audio_wav_map()'s
+ * WILLNEED hints start the kernel reading its head into the page cache — so by
+ * the time it is wanted, the SD read has already happened off the audio path.
+ * Then either:
+ *
+ *   - `chain` false: a later `audio_music_start()` naming the SAME path takes
+ *     the cued file instead of opening one.  The start's refusals still apply —
+ *     the previous bed must have finished — so a game that releases the bed at a
+ *     level boundary keeps its fade, and loses only the cold open behind it.
+ *   - `chain` true: the bed hands off to the cued track at the end of its
+ *     current pass, inside the mixer's fill, on the exact frame — no release, no
+ *     silence, and no call from the game at the boundary.  The cued track then
+ *     loops until it is stopped or chained onward.  `audio_music_handoffs()`
+ *     counts them.
+ *
+ * Returns true if the track is cued.  Refused, loudly, for a file that will not
+ * open or whose rate cannot be converted, so a bad playlist entry is reported at
+ * cue time rather than at the boundary.  ⚠️ A `chain` over a bed that is NOT
+ * looping is refused (the cue stands, unchained): that voice's declared length
+ * ends with its own file, and the mixer would cut the next track where it did.
+ * So is one to a file at a different rate from the live bed's — the handoff
+ * lands inside one converter, which has one ratio.
+ *
+ * ⚠️ **The open itself is a synchronous read** — the RIFF chunk walk, a few
+ * hundred bytes — made where this is called.  Call it right after a start, not
+ * at the boundary.  With the audio server running it is made in the server.
+ */
+bool audio_music_cue(Audio *audio, const char *path, bool chain);
+
+/** Chained handoffs the bed has made since audio_init() — each one a track
+ *  change that cost zero frames of silence. */
+uint32_t audio_music_handoffs(const Audio *audio);
+
 /**
  * Stop the bed at the end of its release, not now.
  *
@@ -1,8 +1,14 @@
 #include "audio_gen.h"
 
 #include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
 /* ── Frame and byte arithmetic ───────────────────────────────────────────── */
 
 int audio_frame_bytes(int channels)
@@ -84,21 +90,103 @@ double audio_tone_env(long i, long frames, long attack, long release)
     return 1.0;
 }
 
+/* ── Fixed-point tone synthesis ─────────────────────────────────────────── */
+
+/* One cycle plus a guard entry, so entry i+1 always exists.  Built once from
+ * sin() — the table is the only place libm is still called for a tone — by the
+ * two entry points that render tones (audio_render_tone, audio_mix_init); a
+ * voice cannot exist before its mixer was initialised.  Rebuilding writes the
+ * same values, so a second build is harmless. */
+static int16_t sine_q15[AUDIO_SINE_SIZE + 1];
+static bool    sine_ready;
+
+static void sine_table_build(void)
+{
+    if (sine_ready) return;
+    for (int i = 0; i <= AUDIO_SINE_SIZE; i++)
+        sine_q15[i] = (int16_t)lrint(32767.0 * sin(2.0 * M_PI * i / AUDIO_SINE_SIZE));
+    sine_ready = true;
+}
+
+uint32_t audio_phase_inc(int rate, int freq_hz)
+{
+    if (rate <= 0 || freq_hz <= 0) return 0;
+    /* 64-bit, once per voice: freq << 32 needs it, and it is the only divide
+     * a tone costs. */
+    return (uint32_t)((((uint64_t)freq_hz << 32) + (uint64_t)rate / 2) / (uint64_t)rate);
+}
+
+static inline int32_t sine_at(uint32_t phase)
+{
+    uint32_t i    = phase >> (32 - AUDIO_SINE_BITS);
+    int32_t  frac = (int32_t)((phase >> (16 - AUDIO_SINE_BITS)) & 0xFFFF);
+    int32_t  a    = sine_q15[i];
+    return a + (((sine_q15[i + 1] - a) * frac + 0x8000) >> 16);
+}
+
+int32_t audio_sine_q15(uint32_t phase)
+{
+    sine_table_build();
+    return sine_at(phase);
+}
+
+uint32_t audio_env_recip(long n)
+{
+    return (n > 0) ? (uint32_t)((1UL << 31) / (unsigned long)n) : 0;
+}
+
+/* audio_tone_env(), in Q15, rounded.  i < attack keeps i · inv under
+ * 2^31 - 2^31/attack, and the same holds for the release, so the product and
+ * its half-step fit uint32 and the result stays below 32768 until the plateau
+ * says exactly 1.0. */
+static inline int32_t env_q15(long i, long frames, long attack, uint32_t attack_inv,
+                              long release, uint32_t release_inv)
+{
+    if (attack > 0 && i < attack)
+        return (int32_t)(((uint32_t)i * attack_inv + 0x8000) >> 16);
+    if (release > 0 && i >= frames - release)
+        return (int32_t)(((uint32_t)(frames - 1 - i) * release_inv + 0x8000) >> 16);
+    return AUDIO_Q15_ONE;
+}
+
+int32_t audio_tone_env_q15(long i, long frames, long attack, long release)
+{
+    return env_q15(i, frames, attack, audio_env_recip(attack),
+                   release, audio_env_recip(release));
+}
+
+/* a · b / 2^15, truncated TOWARD ZERO as the (int32_t)/(int16_t) casts of the
+ * double products did — a plain >> 15 would floor every negative half-cycle
+ * one LSB low.  Callers keep both factors int16-range or a Q15 ≤ 2^15, so the
+ * product fits int32. */
+static inline int32_t mul_q15(int32_t a, int32_t b)
+{
+    int32_t v = a * b;
+    return (v + ((v >> 31) & 0x7FFF)) >> 15;
+}
+
+/* One tone sample: peak · env · sin. */
+static inline int32_t tone_sample(int peak, int32_t env, uint32_t phase)
+{
+    return mul_q15((peak * env) >> 15, sine_at(phase));
+}
+
 void audio_render_tone(int rate, int freq_hz, int peak, int16_t *mono, long frames)
 {
     if (!mono || frames <= 0 || rate <= 0 || freq_hz <= 0) return;
+    sine_table_build();
 
-    long attack  = audio_attack_frames(rate, frames);
-    long release = audio_release_frames(rate, frames);
-
-    double phase_step = 2.0 * M_PI * (double)freq_hz / (double)rate;
-    double phase      = 0.0;
+    long     attack  = audio_attack_frames(rate, frames);
+    long     release = audio_release_frames(rate, frames);
+    uint32_t ainv    = audio_env_recip(attack);
+    uint32_t rinv    = audio_env_recip(release);
+    uint32_t inc     = audio_phase_inc(rate, freq_hz);
+    uint32_t phase   = 0;
 
     for (long i = 0; i < frames; i++) {
-        double env = audio_tone_env(i, frames, attack, release);
-        mono[i] = (int16_t)((double)peak * env * sin(phase));
-        phase += phase_step;
-        if (phase > 2.0 * M_PI) phase -= 2.0 * M_PI;
+        mono[i] = (int16_t)tone_sample(peak, env_q15(i, frames, attack, ainv, release, rinv),
+                                       phase);
+        phase += inc;
     }
 }
 
@@ -235,16 +323,27 @@ void audio_write_frames(const AudioSink *sink, const void *buf, long frames,
 }
 
 /* ── The mix bus ────────────────────────────────────────────────────────────
- * Sample-major on purpose: the accumulator is one int32 in a register, so there
- * is no scratch buffer to size and the sum cannot depend on slot order.  The
- * inner loop over eight slots costs a test per slot per sample even when one
- * voice is live; the sin() calls are the real cost and there is one per ACTIVE
- * voice, which is the irreducible price of mixing.
+ * Voice-major, in blocks: a block of int32 accumulator on the stack, each live
+ * voice adds its run to it, then one limiter pass turns it into int16.  The
+ * sample-major loop this replaced re-tested all eight slots — active, delay,
+ * refill — on every frame, so one drone cost eight slots' worth of branches
+ * per sample.  Integer addition is exact and order-free, so the sum still
+ * cannot depend on slot order.  A voice's run is cut into its envelope
+ * segments, so the plateau — nearly all of any sound — has no envelope in it:
+ * a table lookup and one multiply for a tone, and for a sample a widening
+ * multiply-shift-add that is four lanes at a time on NEON.  The HARD limiter is
+ * NEON too (a saturating narrow); SOFT stays scalar, because past the knee it
+ * is a double divide per sample anyway.
+ *
+ * framebuffer.c's rule holds: NEON behind #ifdef __ARM_NEON (audio_gen.o gets
+ * -mfpu=neon in build-and-deploy.sh), the scalar loop after it finishes the
+ * tail and is the whole loop on the host.
  */
 
 void audio_mix_init(AudioMixer *m, int rate)
 {
     if (!m) return;
+    sine_table_build();
     memset(m, 0, sizeof(*m));
     m->rate  = rate;
     m->limit = AUDIO_MIX_HARD;     /* clampedAdd — see AudioMixLimit */
@@ -315,86 +414,193 @@ int32_t audio_mix_limit_at(int32_t acc, int mode, int32_t knee)
     return (acc < 0) ? -v : v;
 }
 
-long audio_mix_render(AudioMixer *m, int16_t *mono, long frames)
+/* The frames after `pos` that share its envelope segment: the attack, the
+ * plateau (env exactly 1.0), or the release.  Same precedence as env_q15(), so
+ * a tone too short for its own attack and release splits where it always did. */
+static long env_run(const AudioVoice *vo, bool *flat)
 {
-    if (!m || !mono || frames <= 0) return 0;
-    if (audio_mix_pending(m) <= 0)  return 0;
-
-    for (long i = 0; i < frames; i++) {
-        int32_t acc = 0;
-
-        for (int vi = 0; vi < AUDIO_MAX_VOICES; vi++) {
-            AudioVoice *vo = &m->v[vi];
-            if (!vo->active) continue;
+    long p = vo->pos;
+    *flat = false;
+    if (vo->attack > 0 && p < vo->attack) return vo->attack - p;
+    long rel_at = (vo->release > 0) ? vo->frames - vo->release : vo->frames;
+    if (p < rel_at) { *flat = true; return rel_at - p; }
+    return vo->frames - p;
+}
 
-            if (vo->delay > 0) {        /* still waiting its turn */
-                vo->delay--;
-                continue;
+/* `n` frames of a tone into acc[0..n). */
+static void mix_tone_run(AudioVoice *vo, int32_t *acc, long n)
+{
+    uint32_t ph = vo->phase, inc = vo->phase_inc;
+    while (n > 0) {
+        bool flat;
+        long run = env_run(vo, &flat);
+        if (run > n) run = n;
+        if (flat) {
+            /* tone_sample() with env = 1.0: (peak · 2^15) >> 15 is peak. */
+            for (long k = 0; k < run; k++, ph += inc)
+                acc[k] += mul_q15(vo->peak, sine_at(ph));
+        } else {
+            for (long k = 0; k < run; k++, ph += inc) {
+                int32_t env = env_q15(vo->pos + k, vo->frames, vo->attack, vo->attack_inv,
+                                      vo->release, vo->release_inv);
+                acc[k] += tone_sample(vo->peak, env, ph);
             }
+        }
+        vo->pos += run;
+        acc += run;
+        n   -= run;
+    }
+    vo->phase = ph;
+}
 
-            double env = audio_tone_env(vo->pos, vo->frames, vo->attack, vo->release);
-
-            if (vo->kind == AUDIO_VOICE_SAMPLE) {
-                /* Pull the next block only when the last one is spent, so `fill`
-                 * — and the SD read behind it — is entered once per buffer
-                 * rather than once per frame.  buf/buf_pos/buf_len are voice
-                 * state like `pos` and `phase`, which is what keeps the
-                 * incremental-render property: N then M frames pull the same
-                 * bytes in the same order as one N+M render. */
-                if (vo->buf_pos >= vo->buf_len && !vo->drained) {
-                    long got = vo->fill(vo->ctx, vo->buf, vo->buf_cap);
-                    vo->buf_len = (got > 0) ? got : 0;
-                    vo->buf_pos = 0;
-                    if (vo->buf_len < vo->buf_cap) vo->drained = true;
-                }
-                if (vo->buf_pos >= vo->buf_len) {
-                    /* The source ran dry early — end the voice here rather than
-                     * padding with silence it never contained.  A short fill is
-                     * legal, so this is a normal exit, not an error. */
-                    vo->active = false;
-                    continue;
-                }
-                int16_t s = vo->buf[vo->buf_pos++];
-
-                /* `>> 15`, not `/ AUDIO_FULL_SCALE`.  ⚠️ Cortex-A8 has no
-                 * hardware divide, so a constant divide here would be an
-                 * `__aeabi_idiv` call per sample per voice; the shift is exact
-                 * and the 1/32768-vs-1/32767 difference is a third of an LSB at
-                 * full scale.  Same reasoning as `audio_attenuate()`. */
-                acc += (int32_t)((((long)s * (long)vo->peak) >> 15) * env);
-
-                if (++vo->pos >= vo->frames) vo->active = false;
-                continue;
+/* `n` buffered samples, all inside the voice, into acc[0..n). */
+static void mix_sample_run(AudioVoice *vo, const int16_t *src, int32_t *acc, long n)
+{
+    while (n > 0) {
+        bool flat;
+        long run = env_run(vo, &flat);
+        if (run > n) run = n;
+        long k = 0;
+        if (flat) {
+            /* mul_q15(x, 2^15) is x exactly, so the plateau is (s · peak) >> 15.
+             * `>> 15`, not `/ AUDIO_FULL_SCALE`: ⚠️ Cortex-A8 has no hardware
+             * divide, and the 1/32768-vs-1/32767 difference is a third of an
+             * LSB at full scale.  Same reasoning as `audio_attenuate()`. */
+#ifdef __ARM_NEON
+            int16_t pk = (int16_t)vo->peak;
+            for (; k + 4 <= run; k += 4) {
+                int32x4_t v = vshrq_n_s32(vmull_n_s16(vld1_s16(src + k), pk), 15);
+                vst1q_s32(acc + k, vaddq_s32(vld1q_s32(acc + k), v));
             }
+#endif
+            for (; k < run; k++)
+                acc[k] += ((int32_t)src[k] * vo->peak) >> 15;
+        } else {
+            for (; k < run; k++) {
+                int32_t env = env_q15(vo->pos + k, vo->frames, vo->attack, vo->attack_inv,
+                                      vo->release, vo->release_inv);
+                acc[k] += mul_q15(((int32_t)src[k] * vo->peak) >> 15, env);
+            }
+        }
+        vo->pos += run;
+        src += run;
+        acc += run;
+        n   -= run;
+    }
+}
 
-            acc += (int32_t)((double)vo->peak * env * sin(vo->phase));
+/* One voice's share of an `n`-frame block. */
+static void mix_voice_block(AudioVoice *vo, int32_t *acc, long n)
+{
+    long j = 0;
+    if (vo->delay > 0) {              /* still waiting its turn */
+        j = (vo->delay < n) ? vo->delay : n;
+        vo->delay -= j;
+    }
 
-            vo->phase += vo->phase_step;
-            if (vo->phase > 2.0 * M_PI) vo->phase -= 2.0 * M_PI;
+    if (vo->kind != AUDIO_VOICE_SAMPLE) {
+        long run = vo->frames - vo->pos;
+        if (run > n - j) run = n - j;
+        mix_tone_run(vo, acc + j, run);
+        /* The voice frees itself the instant its last sample is rendered,
+         * so the slot is reusable on this same call — not one pump later. */
+        if (vo->pos >= vo->frames) vo->active = false;
+        return;
+    }
 
-            /* The voice frees itself the instant its last sample is rendered,
-             * so the slot is reusable on this same call — not one pump later. */
-            if (++vo->pos >= vo->frames) vo->active = false;
+    while (j < n && vo->pos < vo->frames) {
+        /* Pull the next block only when the last one is spent, so `fill` — and
+         * the SD read behind it — is entered once per buffer rather than once
+         * per frame.  buf/buf_pos/buf_len are voice state like `pos` and
+         * `phase`, which is what keeps the incremental-render property: N then
+         * M frames pull the same bytes in the same order as one N+M render. */
+        if (vo->buf_pos >= vo->buf_len && !vo->drained) {
+            long got = vo->fill(vo->ctx, vo->buf, vo->buf_cap);
+            vo->buf_len = (got > 0) ? got : 0;
+            vo->buf_pos = 0;
+            if (vo->buf_len < vo->buf_cap) vo->drained = true;
         }
+        if (vo->buf_pos >= vo->buf_len) {
+            /* The source ran dry early — end the voice here rather than padding
+             * with silence it never contained.  A short fill is legal, so this
+             * is a normal exit, not an error. */
+            vo->active = false;
+            return;
+        }
+        long run = vo->buf_len - vo->buf_pos;
+        if (run > n - j)                run = n - j;
+        if (run > vo->frames - vo->pos) run = vo->frames - vo->pos;
+        mix_sample_run(vo, vo->buf + vo->buf_pos, acc + j, run);
+        vo->buf_pos += run;
+        j += run;
+    }
+    if (vo->pos >= vo->frames) vo->active = false;
+}
 
-        /* One limiter, after the whole sum, so slot order cannot change it.
-         * Each counter keeps ONE meaning: `clipped` is "the int16 range could not
-         * hold this", which only the hard clamp can produce, and `limited` is
-         * "the knee bent it".  Counting both into one number would have hidden
-         * the very distinction this change turns on. */
-        int32_t out = audio_mix_limit_at(acc, m->limit, m->knee);
-        if (out != acc) {
-            if (m->limit == AUDIO_MIX_HARD) m->clipped++;
-            else                            m->limited++;
+/* The block leaves the bus.  One limiter, after the whole sum, so slot order
+ * cannot change it.  Each counter keeps ONE meaning: `clipped` is "the int16
+ * range could not hold this", which only the hard clamp can produce, and
+ * `limited` is "the knee bent it".  Counting both into one number would have
+ * hidden the very distinction this change turns on. */
+static void mix_limit_block(AudioMixer *m, const int32_t *acc, int16_t *mono, long n)
+{
+    long i = 0;
+
+    if (m->limit == AUDIO_MIX_HARD) {
+#ifdef __ARM_NEON
+        /* The saturating narrow IS the clamp; a lane the round trip changed
+         * is one it clipped (all-ones, so subtracting the mask counts it). */
+        uint32x4_t hits = vdupq_n_u32(0);
+        for (; i + 4 <= n; i += 4) {
+            int32x4_t a = vld1q_s32(acc + i);
+            int16x4_t o = vqmovn_s32(a);
+            hits = vsubq_u32(hits, vmvnq_u32(vceqq_s32(a, vmovl_s16(o))));
+            vst1_s16(mono + i, o);
+        }
+        m->clipped += vgetq_lane_u32(hits, 0) + vgetq_lane_u32(hits, 1) +
+                      vgetq_lane_u32(hits, 2) + vgetq_lane_u32(hits, 3);
+#endif
+        for (; i < n; i++) {
+            int32_t a = acc[i];
+            if      (a >  32767) { a =  32767; m->clipped++; }
+            else if (a < -32768) { a = -32768; m->clipped++; }
+            mono[i] = (int16_t)a;
         }
+        return;
+    }
+
+    for (; i < n; i++) {
+        int32_t out = audio_mix_limit_at(acc[i], m->limit, m->knee);
+        if (out != acc[i]) m->limited++;
 
-        /* And a store the int16 cannot lie about.  Unreachable under SOFT — the
-         * curve asymptotes to AUDIO_MIX_CEIL — which is exactly why `clipped`
-         * reaching 0 is the measurement that the limiter is really engaged. */
+        /* And a store the int16 cannot lie about.  Unreachable under SOFT —
+         * the curve asymptotes to AUDIO_MIX_CEIL — which is exactly why
+         * `clipped` reaching 0 is the measurement that the limiter is really
+         * engaged. */
         if      (out >  32767) { out =  32767; m->clipped++; }
         else if (out < -32768) { out = -32768; m->clipped++; }
         mono[i] = (int16_t)out;
     }
+}
+
+long audio_mix_render(AudioMixer *m, int16_t *mono, long frames)
+{
+    if (!m || !mono || frames <= 0) return 0;
+    if (audio_mix_pending(m) <= 0)  return 0;
+
+    int32_t acc[AUDIO_MIX_BLOCK];
+
+    for (long done = 0; done < frames; ) {
+        long n = frames - done;
+        if (n > AUDIO_MIX_BLOCK) n = AUDIO_MIX_BLOCK;
+
+        memset(acc, 0, (size_t)n * sizeof(acc[0]));
+        for (int vi = 0; vi < AUDIO_MAX_VOICES; vi++)
+            if (m->v[vi].active) mix_voice_block(&m->v[vi], acc, n);
+
+        mix_limit_block(m, acc, mono + done, n);
+        done += n;
+    }
 
     return frames;
 }
@@ -436,14 +642,16 @@ int audio_mix_add(AudioMixer *m, int freq_hz, int duration_ms,
     if (!vo) return -1;
 
     vo->kind       = AUDIO_VOICE_TONE;
-    vo->phase      = 0.0;
-    vo->phase_step = 2.0 * M_PI * (double)freq_hz / (double)m->rate;
+    vo->phase      = 0;
+    vo->phase_inc  = audio_phase_inc(m->rate, freq_hz);
     vo->peak       = peak;
     vo->delay      = delay;
     vo->frames     = frames;
     vo->pos        = 0;
     vo->attack     = audio_attack_frames(m->rate, frames);
     vo->release    = audio_release_frames(m->rate, frames);
+    vo->attack_inv  = audio_env_recip(vo->attack);
+    vo->release_inv = audio_env_recip(vo->release);
     return slot;
 }
 
@@ -477,6 +685,8 @@ int audio_mix_add_sample(AudioMixer *m, AudioVoiceFill fill, void *ctx,
      * release is what `audio_mix_release_voice()` later arms. */
     vo->attack  = audio_attack_frames(m->rate, total_frames);
     vo->release = audio_release_frames(m->rate, total_frames);
+    vo->attack_inv  = audio_env_recip(vo->attack);
+    vo->release_inv = audio_env_recip(vo->release);
     return slot;
 }
 
@@ -581,3 +791,322 @@ long audio_pump_frames(long lead, long in_flight, long space, long cap)
     if (cap > 0 && want > cap) want = cap;
     return want;
 }
+
+/* ── Rate conversion ────────────────────────────────────────────────────── */
+
+#define RS_HALF       (AUDIO_RS_TAPS / 2)
+#define RS_BLEND_BITS (16 - AUDIO_RS_PHASE_BITS)
+
+bool audio_rs_supported(int in_rate, int out_rate)
+{
+    if (in_rate  < AUDIO_RS_RATE_MIN || in_rate  > AUDIO_RS_RATE_MAX) return false;
+    if (out_rate < AUDIO_RS_RATE_MIN || out_rate > AUDIO_RS_RATE_MAX) return false;
+    return in_rate  <= out_rate * AUDIO_RS_RATIO_MAX &&
+           out_rate <= in_rate  * AUDIO_RS_RATIO_MAX;
+}
+
+long audio_rs_frames_out(int in_rate, int out_rate, long in_frames)
+{
+    if (in_frames <= 0 || in_rate <= 0 || out_rate <= 0) return 0;
+    /* 64-bit: a bed's frame count times 96000 is far past 32 bits. */
+    return (long)(((long long)in_frames * out_rate + in_rate - 1) / in_rate);
+}
+
+long audio_rs_buffered(const AudioResampler *rs)
+{
+    if (!rs) return 0;
+    long real = rs->end >= 0 ? rs->end : rs->len;
+    return real > rs->at ? real - rs->at : 0;
+}
+
+void audio_rs_reset(AudioResampler *rs)
+{
+    if (!rs) return;
+    /* The window opens on RS_HALF - 1 frames of silence, the history before
+     * the stream's first frame, so frame 0 is filtered like any other. */
+    memset(rs->win, 0, sizeof(rs->win));
+    rs->at  = RS_HALF - 1;
+    rs->len = RS_HALF - 1;
+    rs->end = -1;
+    rs->acc = 0;
+}
+
+bool audio_rs_init(AudioResampler *rs, int in_rate, int out_rate)
+{
+    if (!rs || !audio_rs_supported(in_rate, out_rate)) return false;
+    rs->in_rate  = in_rate;
+    rs->out_rate = out_rate;
+    rs->whole    = (uint32_t)(in_rate / out_rate);
+    rs->rem      = (uint32_t)(in_rate % out_rate);
+    rs->inv      = (uint32_t)((1ULL << 32) / (uint32_t)out_rate);
+
+    /* Cutoff as a fraction of the INPUT Nyquist: the lower of the two, less
+     * a margin for the transition band AUDIO_RS_TAPS (32) taps can afford. */
+    double fc = 0.85 * (out_rate < in_rate ? (double)out_rate / in_rate : 1.0);
+    for (int p = 0; p <= AUDIO_RS_PHASES; p++) {
+        double h[AUDIO_RS_TAPS], sum = 0.0;
+        for (int k = 0; k < AUDIO_RS_TAPS; k++) {
+            /* Distance from the output position to tap k's input frame. */
+            double d = (double)(k - RS_HALF + 1) - (double)p / AUDIO_RS_PHASES;
+            double x = M_PI * fc * d;
+            double sinc = (d == 0.0) ? 1.0 : sin(x) / x;
+            double w = d / RS_HALF;                 /* -1..1 across the taps */
+            double win = (w <= -1.0 || w >= 1.0) ? 0.0
+                       : 0.42 + 0.5 * cos(M_PI * w) + 0.08 * cos(2.0 * M_PI * w);
+            h[k] = sinc * win;
+            sum += h[k];
+        }
+        /* Normalise each row to unity and put the rounding residue on the
+         * biggest tap, so DC passes exactly at every phase — a row that summed
+         * to 32767 would be a ripple at the phase rate. */
+        int total = 0, big = 0;
+        for (int k = 0; k < AUDIO_RS_TAPS; k++) {
+            rs->coef[p][k] = (int16_t)lrint(32768.0 * h[k] / sum);
+            total += rs->coef[p][k];
+            if (abs(rs->coef[p][k]) > abs(rs->coef[p][big])) big = k;
+        }
+        rs->coef[p][big] = (int16_t)(rs->coef[p][big] + (32768 - total));
+    }
+    audio_rs_reset(rs);
+    return true;
+}
+
+/* Slide the window down to what the next frame still needs, and top it up.
+ * ⚠️ The request size is `AUDIO_RS_WINDOW - RS_HALF - len` — a function of the
+ * state only.  Sizing it by the caller's `frames` would make the source see a
+ * different sequence of reads for a different slicing, and a stateful source
+ * (a file at EOF, a looping wrap) would then diverge. */
+static void rs_refill(AudioResampler *rs, AudioVoiceFill src, void *ctx)
+{
+    long keep_from = rs->at - (RS_HALF - 1);
+    if (keep_from > rs->len) keep_from = rs->len;
+    if (keep_from > 0) {
+        memmove(rs->win, rs->win + keep_from,
+                (size_t)(rs->len - keep_from) * sizeof(int16_t));
+        rs->at  -= keep_from;
+        rs->len -= keep_from;
+    }
+    long want = AUDIO_RS_WINDOW - RS_HALF - rs->len;
+    long got  = want > 0 ? src(ctx, rs->win + rs->len, want) : 0;
+    if (got < 0) got = 0;
+    rs->len += got;
+    if (got < want) {
+        /* Dry.  The frames after the last real one are silence, and there are
+         * exactly enough of them for the last real frame's window. */
+        rs->end = rs->len;
+        memset(rs->win + rs->len, 0, RS_HALF * sizeof(int16_t));
+        rs->len += RS_HALF;
+    }
+}
+
+long audio_rs_pull(AudioResampler *rs, AudioVoiceFill src, void *src_ctx,
+                   int16_t *dst, long frames)
+{
+    if (!rs || !src || !dst || frames <= 0) return 0;
+    long n = 0;
+    while (n < frames) {
+        while (rs->end < 0 && rs->at + RS_HALF >= rs->len)
+            rs_refill(rs, src, src_ctx);
+        if (rs->end >= 0 && rs->at >= rs->end) break;
+
+        uint32_t frac  = (uint32_t)(((uint64_t)rs->acc * rs->inv) >> 16);
+        uint32_t ph    = frac >> RS_BLEND_BITS;
+        int32_t  blend = (int32_t)(frac & ((1u << RS_BLEND_BITS) - 1));
+        const int16_t *x  = rs->win + rs->at - (RS_HALF - 1);
+        const int16_t *c0 = rs->coef[ph];
+        const int16_t *c1 = rs->coef[ph + 1];
+        /* int32 is enough, just: a row's |taps| sum to at most 1.87 at any
+         * supported ratio (swept 8000..96000 in 250 Hz steps; the worst is
+         * 1:1), so a full-scale worst case is 2.0e9 — under 2^31.  ⚠️ A
+         * sharper cutoff or a longer sinc moves that; re-sweep before either. */
+        int32_t a0 = 0, a1 = 0;
+        for (int k = 0; k < AUDIO_RS_TAPS; k++) {
+            a0 += (int32_t)c0[k] * x[k];
+            a1 += (int32_t)c1[k] * x[k];
+        }
+        int32_t v = a0 + (int32_t)(((int64_t)(a1 - a0) * blend) >> RS_BLEND_BITS);
+        v = (v + (1 << 14)) >> 15;
+        dst[n++] = (int16_t)(v > 32767 ? 32767 : v < -32768 ? -32768 : v);
+
+        rs->at  += rs->whole;
+        rs->acc += rs->rem;
+        if (rs->acc >= (uint32_t)rs->out_rate) {
+            rs->acc -= (uint32_t)rs->out_rate;
+            rs->at++;
+        }
+    }
+    return n;
+}
+
+typedef struct {
+    const int16_t *pcm;
+    long           left;
+} RsMemSource;
+
+static long rs_mem_fill(void *ctx, int16_t *dst, long frames)
+{
+    RsMemSource *m = (RsMemSource *)ctx;
+    if (frames > m->left) frames = m->left;
+    memcpy(dst, m->pcm, (size_t)frames * sizeof(int16_t));
+    m->pcm  += frames;
+    m->left -= frames;
+    return frames;
+}
+
+long audio_rs_convert(AudioResampler *rs, const int16_t *in, long in_frames,
+                      int16_t *out, long out_cap)
+{
+    if (!rs || !in || in_frames <= 0 || !out || out_cap <= 0) return 0;
+    audio_rs_reset(rs);
+    RsMemSource m = { in, in_frames };
+    return audio_rs_pull(rs, rs_mem_fill, &m, out, out_cap);
+}
+
+/* ── Trigger-to-DAC latency ─────────────────────────────────────────────── */
+
+void audio_lat_reset(AudioLatency *lat)
+{
+    if (lat) memset(lat, 0, sizeof(*lat));
+}
+
+void audio_lat_drop_pending(AudioLatency *lat)
+{
+    if (lat) lat->npend = 0;
+}
+
+bool audio_lat_mark(AudioLatency *lat, uint32_t t_us, long long pos)
+{
+    if (!lat) return false;
+    if (lat->npend >= AUDIO_LAT_PENDING) {
+        lat->missed++;
+        return false;
+    }
+    lat->pend[lat->npend].t_us = t_us;
+    lat->pend[lat->npend].pos  = pos;
+    lat->npend++;
+    return true;
+}
+
+int audio_lat_pending(const AudioLatency *lat)
+{
+    return lat ? lat->npend : 0;
+}
+
+int audio_lat_observe(AudioLatency *lat, int rate, uint32_t now_us,
+                      long long written, long delay)
+{
+    if (!lat || rate <= 0 || delay < 0) return 0;
+
+    int resolved = 0, keep = 0;
+    for (int i = 0; i < lat->npend; i++) {
+        AudioLatMark m = lat->pend[i];
+        if (m.pos >= written) {                /* not handed over yet */
+            lat->pend[keep++] = m;
+            continue;
+        }
+        /* ⚠️ Signed and 64-bit: `ahead` is negative for a frame already
+         * played, and frames × 10^6 leaves 32 bits at ~4300 frames.  One
+         * divide per trigger, never per frame, so the A8's missing divider is
+         * a libgcc call a few times a second. */
+        long long ahead = (long long)delay - (written - m.pos);
+        long long dac   = (long long)(int32_t)(now_us - m.t_us)
+                        + ahead * 1000000 / rate;
+        uint32_t  us    = dac > 0 ? (dac < UINT32_MAX ? (uint32_t)dac : UINT32_MAX) : 0;
+
+        uint32_t ms = us / 1000;
+        lat->hist[ms < AUDIO_LAT_BINS ? ms : AUDIO_LAT_BINS - 1]++;
+        /* The first sample sets the floor, so a zeroed struct — which is
+         * what audio_init() and a hand-built test both hold — is a valid one. */
+        if (lat->count == 0 || us < lat->min_us) lat->min_us = us;
+        if (us > lat->max_us) lat->max_us = us;
+        lat->count++;
+        lat->sum_us += us;
+        resolved++;
+    }
+    lat->npend = keep;
+    return resolved;
+}
+
+/** The upper edge of the bin holding the `target`-th sample, never past the
+ *  slowest one actually seen. */
+static uint32_t lat_edge(const AudioLatency *lat, uint32_t target)
+{
+    uint32_t cum = 0;
+    int b = 0;
+    for (; b < AUDIO_LAT_BINS - 1; b++) {
+        cum += lat->hist[b];
+        if (cum >= target) break;
+    }
+    uint32_t edge = (uint32_t)(b + 1) * 1000;
+    return edge < lat->max_us ? edge : lat->max_us;
+}
+
+void audio_lat_stats(const AudioLatency *lat, AudioLatencyStats *out)
+{
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!lat) return;
+    out->missed = lat->missed;
+    if (!lat->count) return;
+
+    out->count  = lat->count;
+    out->min_us = lat->min_us;
+    out->max_us = lat->max_us;
+    out->avg_us = (uint32_t)(lat->sum_us / lat->count);
+    out->p50_us = lat_edge(lat, lat->count - lat->count / 2);
+    out->p99_us = lat_edge(lat, lat->count - lat->count / 100);
+}
+
+char *audio_lat_format(const AudioLatencyStats *st, char *buf, size_t size)
+{
+#define MS(us) (unsigned)((us) / 1000), (unsigned)((us) % 1000 / 100)
+    snprintf(buf, size,
+             "%u triggers, %u missed; trigger→DAC min/avg/p50/p99/max "
+             "%u.%u/%u.%u/%u.%u/%u.%u/%u.%u ms",
+             (unsigned)st->count, (unsigned)st->missed,
+             MS(st->min_us), MS(st->avg_us), MS(st->p50_us), MS(st->p99_us),
+             MS(st->max_us));
+#undef MS
+    return buf;
+}
+
+/* ── The command ring ───────────────────────────────────────────────────── */
+
+void audio_cmd_init(AudioCmdRing *r)
+{
+    if (r) memset(r, 0, sizeof(*r));
+}
+
+bool audio_cmd_push(AudioCmdRing *r, const AudioCmd *c)
+{
+    if (!r || !c) return false;
+    uint32_t h = __atomic_load_n(&r->head, __ATOMIC_RELAXED);   /* ours */
+    uint32_t t = __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE);
+    if (h - t >= AUDIO_CMD_SLOTS) return false;
+
+    r->slot[h & (AUDIO_CMD_SLOTS - 1)] = *c;
+    /* Release: the slot above is visible before the count that publishes it. */
+    __atomic_store_n(&r->head, h + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+bool audio_cmd_pop(AudioCmdRing *r, AudioCmd *out)
+{
+    if (!r || !out) return false;
+    uint32_t t = __atomic_load_n(&r->tail, __ATOMIC_RELAXED);   /* ours */
+    uint32_t h = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+    if (h == t) return false;
+
+    *out = r->slot[t & (AUDIO_CMD_SLOTS - 1)];
+    /* Release: the copy above is finished before the producer may reuse the slot. */
+    __atomic_store_n(&r->tail, t + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+uint32_t audio_cmd_depth(const AudioCmdRing *r)
+{
+    if (!r) return 0;
+    uint32_t t = __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE);
+    uint32_t h = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+    return h - t;
+}
@@ -9,8 +9,9 @@
  * host regression can reach (`tests/audio_gen_test.c`), and the half that must
  * survive the OSS → ALSA port unchanged (../IMPROVEMENT_PLAN.md F1).
  *
- * The device half — open/configure/write/close plus the GPIO12 amp poke —
- * stays in `audio.c` and moves to `audio_dev.c` when it becomes tinyalsa.
+ * The device half — open/configure/write/close plus the GPIO12 amp poke — is
+ * `audio_out.c` (and `audio.c`'s pre-stream path), where the tinyalsa backend
+ * sits beside the OSS one.
  *
  * Two rules this file exists to enforce:
  *
@@ -95,6 +96,11 @@
  *  counted, never allowed to steal a playing voice — see `audio_mix_add()`. */
 #define AUDIO_MAX_VOICES         8
 
+/** Frames `audio_mix_render()` sums per pass: the int32 accumulator is this
+ *  long and lives on the stack (1 KiB).  A render of any length is cut into
+ *  blocks of this size; the block size is invisible in the output. */
+#define AUDIO_MIX_BLOCK          256
+
 /** Target queue depth the pump keeps inside the device, in ms.
  *
  *  This is the whole latency budget of the mix bus: audio already handed to the
@@ -204,9 +210,50 @@ long audio_attack_frames(int rate, long frames);
 long audio_release_frames(int rate, long frames);
 
 /** Envelope at sample `i`: 0 → 1 over the attack, 1, then 1 → 0 over the
- *  release.  Continuous at both joins, including when they meet at frames/2. */
+ *  release.  Continuous at both joins, including when they meet at frames/2.
+ *  The double form is the DEFINITION; what renders is the Q15 form below. */
 double audio_tone_env(long i, long frames, long attack, long release);
 
+/* ── Fixed-point tone synthesis ─────────────────────────────────────────────
+ *
+ * Every tone — `audio_render_tone()` and every tone voice on the mix bus — is
+ * rendered in integers: a 32-bit phase accumulator, a linearly interpolated
+ * sine table, and the envelope in Q15.  ⚠️ The Cortex-A8's VFP is not
+ * pipelined, so the `sin()` call and the double envelope it replaced were the
+ * whole cost of a tone voice — one libm call per sample per voice — for the
+ * same reason this file already spells `/ 32768` as `>> 15`.
+ *
+ * Within ±2 LSB of the double renderer it replaced (`tests/audio_gen_test.c`
+ * group D keeps that renderer as the reference), and still exactly the same
+ * between the two paths: one kernel, so a lone voice on the bus is
+ * byte-identical to `audio_render_tone()` of the same tone (group I).
+ *
+ *   - PHASE is a fraction of a turn in 32 bits, so it wraps for free and the
+ *     increment is exact to rate/2^33 Hz — no drift against the double `phase`
+ *     that needed an explicit wrap.
+ *   - The TABLE is 2^AUDIO_SINE_BITS entries of one full cycle, plus a guard
+ *     entry so the interpolation never wraps; linear interpolation on 1024
+ *     entries is good to ~5e-6 of full scale, far under one LSB.
+ *   - The ENVELOPE is `i · (2^31 / attack) >> 16`: one divide per voice at add
+ *     time instead of one per sample, and never above 1.0 (32768).
+ */
+#define AUDIO_SINE_BITS          10
+#define AUDIO_SINE_SIZE          (1 << AUDIO_SINE_BITS)
+#define AUDIO_Q15_ONE            32768
+
+/** Phase increment per frame for `freq_hz` at `rate`: round(freq · 2^32 / rate). */
+uint32_t audio_phase_inc(int rate, int freq_hz);
+
+/** sin(2π · phase / 2^32) in Q15, interpolated from the table. */
+int32_t  audio_sine_q15(uint32_t phase);
+
+/** `2^31 / n`, the envelope's per-voice reciprocal; 0 when `n <= 0`. */
+uint32_t audio_env_recip(long n);
+
+/** `audio_tone_env()` in Q15 (0..32768), with the divide hoisted into
+ *  `audio_env_recip()`.  Within one Q15 step of the double form. */
+int32_t  audio_tone_env_q15(long i, long frames, long attack, long release);
+
 /** Render `frames` MONO samples of a fixed-frequency tone with that envelope. */
 void audio_render_tone(int rate, int freq_hz, int peak, int16_t *mono, long frames);
 
@@ -351,21 +398,23 @@ typedef long (*AudioVoiceFill)(void *ctx, int16_t *dst, long frames);
 /** What a voice is made of.  TONE is 0 so `memset`-zeroing a slot still yields
  *  the voice kind every existing caller creates. */
 typedef enum {
-    AUDIO_VOICE_TONE   = 0,  /**< sin(phase) — every voice before F1 Phase 8 */
+    AUDIO_VOICE_TONE   = 0,  /**< sine table — every voice before F1 Phase 8  */
     AUDIO_VOICE_SAMPLE = 1   /**< PCM pulled through an AudioVoiceFill       */
 } AudioVoiceKind;
 
 typedef struct {
     bool     active;      /**< false = free slot                               */
     uint32_t gen;         /**< bumped on every add — see audio_mix_voice_gen() */
-    double   phase;       /**< radians, wrapped to [0, 2π)                     */
-    double   phase_step;  /**< 2π · freq / rate                                */
+    uint32_t phase;       /**< fraction of a turn, 2^32 = one cycle; wraps free */
+    uint32_t phase_inc;   /**< audio_phase_inc(rate, freq)                      */
     int      peak;        /**< this voice's amplitude — the per-voice gain      */
     long     delay;       /**< frames of silence still owed before it sounds    */
     long     frames;      /**< total length                                    */
     long     pos;         /**< frames sounded so far (0..frames)               */
     long     attack;      /**< envelope, in frames — same curve as a plain tone */
     long     release;
+    uint32_t attack_inv;  /**< audio_env_recip(attack): the envelope's divide,  */
+    uint32_t release_inv; /**< done once here instead of once per sample        */
 
     /* ── AUDIO_VOICE_SAMPLE only.  Zero for a tone, which is what `memset`
      *    already leaves behind, so no existing add path has to say so. ── */
@@ -575,6 +624,16 @@ long audio_mix_voice_pending(const AudioMixer *m, int slot, uint32_t gen);
  * A single voice is BYTE-IDENTICAL to `audio_render_tone()` of the same tone —
  * so switching an app to the pump cannot change how one sound is heard.  That
  * survives the limiter because one voice cannot reach the knee.
+ *
+ * Voice-major in blocks of AUDIO_MIX_BLOCK: each live voice adds its whole run
+ * to an int32 accumulator, then the limiter passes over the block once.  The
+ * cost follows the voices that are sounding, not slots × frames.  Because the
+ * sum is exact integer addition the order voices are added in is invisible, and
+ * because every voice's state is its own, N then M frames are still
+ * byte-identical to N+M whatever the block boundaries.  ⚠️ One consequence is
+ * visible outside: two sample voices' `fill` callbacks are no longer
+ * interleaved frame by frame, so two voices must not share one source cursor
+ * (none do — each AudioSampleVoice owns its own).
  */
 long audio_mix_render(AudioMixer *m, int16_t *mono, long frames);
 
@@ -591,4 +650,259 @@ long audio_mix_render(AudioMixer *m, int16_t *mono, long frames);
  */
 long audio_pump_frames(long lead, long in_flight, long space, long cap);
 
+/* ── Rate conversion: a polyphase FIR, fixed point ─────────────────────────
+ *
+ * What lets a file at a rate the device did not grant play at the right pitch
+ * instead of being refused.  Every file we ship is 44100 and so is what `hw:0,0`
+ * grants, so on the shipped path this never runs; it exists so a 22050 asset, or
+ * a device that grants 48000, costs a conversion rather than an offline re-export.
+ *
+ * One output frame is a 32-tap FIR over the input around its position, with the
+ * taps picked from 64 precomputed PHASES of a Blackman-windowed sinc and blended
+ * linearly between the two nearest — 64 integer MACs a frame, no double, and no
+ * divide: the position advances by an exact integer pair (`whole`, `rem` over
+ * `out_rate`), so a bed converted for hours has drifted by zero frames.  The
+ * sinc's cutoff is at 0.85 of the LOWER of the two Nyquists, so a downward
+ * conversion filters out what would fold back.
+ *
+ * ⚠️ **Incremental like everything else on the bus.**  The state is the phase,
+ * the input window and the dry flag, and refills are sized by that state, never
+ * by the caller's request — so N + M frames pulled are byte-identical to one
+ * N+M-frame pull, which is what lets it sit behind a voice's fill and be
+ * rendered in whatever slices the pump takes (tests/audio_gen_test.c group T).
+ *
+ * ⚠️ **Length is exact, and it is ceil(in × out_rate / in_rate).**
+ * `audio_rs_frames_out()` is that number, and a voice's declared total must be
+ * it: the mixer ends a voice on a short fill, and one that declared the INPUT
+ * length would be cut short or padded.
+ *
+ * Pure: no fd, no clock, no allocator — the converter is one caller-owned
+ * struct, coefficients included (~6 KB).
+ */
+
+/** FIR length.  Even; the window is centred between taps 15 and 16.  16 was
+ *  tried first and left a 30 kHz tone only 36 dB down at 96000 -> 44100 —
+ *  the transition band of a short filter is wide exactly where downward
+ *  conversion needs it narrow; 32 puts it 77 dB down (group T). */
+#define AUDIO_RS_TAPS            32
+
+/** Precomputed phases per input frame.  A power of two: the phase is the top
+ *  bits of the fraction and the blend weight is the rest. */
+#define AUDIO_RS_PHASE_BITS      6
+#define AUDIO_RS_PHASES          (1 << AUDIO_RS_PHASE_BITS)
+
+/** The input window, in frames.  Refills are at most this minus the taps, so
+ *  a converted voice enters its source about as often as an unconverted one. */
+#define AUDIO_RS_WINDOW          1024
+
+/** The supported rates, the RATE range `hw:0,0` advertises (SYSTEM_ANALYSIS.md
+ *  §3); and a ratio beyond 4:1 either way is refused, where 32 taps stop being
+ *  a filter worth the name. */
+#define AUDIO_RS_RATE_MIN        8000
+#define AUDIO_RS_RATE_MAX        96000
+#define AUDIO_RS_RATIO_MAX       4
+
+typedef struct {
+    int      in_rate, out_rate;
+    uint32_t whole;          /**< input frames per output, integer part       */
+    uint32_t rem;            /**< and the remainder, over `out_rate`           */
+    uint32_t acc;            /**< the phase: [0, out_rate)                     */
+    uint32_t inv;            /**< 2^32 / out_rate, so the phase's fraction is
+                              *   a multiply and not a per-frame divide       */
+    long     at;             /**< index in `win` of the current input frame   */
+    long     len;            /**< frames valid in `win`                       */
+    long     end;            /**< one past the last REAL frame once the source
+                              *   ran dry; -1 until then                      */
+    int16_t  win[AUDIO_RS_WINDOW];
+    int16_t  coef[AUDIO_RS_PHASES + 1][AUDIO_RS_TAPS]; /**< Q15; each row sums
+                              *   to exactly 32768, so DC passes unchanged at
+                              *   every phase                                 */
+} AudioResampler;
+
+/** Can this pair be converted?  Both rates in range and within the ratio. */
+bool audio_rs_supported(int in_rate, int out_rate);
+
+/**
+ * Set up a converter from `in_rate` to `out_rate` and prime it to the start of
+ * a stream.  Builds the coefficient table — the only libm here, once per call,
+ * never per frame.  False, and nothing usable, for an unsupported pair.
+ */
+bool audio_rs_init(AudioResampler *rs, int in_rate, int out_rate);
+
+/** Back to the start of a stream, same rates, coefficients kept. */
+void audio_rs_reset(AudioResampler *rs);
+
+/** Input frames the window holds that have not been passed yet — read from
+ *  the source, still to be played.  What a re-armed voice must add to what is
+ *  left in its file. */
+long audio_rs_buffered(const AudioResampler *rs);
+
+/** Output frames `in_frames` input frames convert to: ceil(in × out / in). */
+long audio_rs_frames_out(int in_rate, int out_rate, long in_frames);
+
+/**
+ * Produce up to `frames` converted frames in `dst`, pulling input from `src`
+ * (an AudioVoiceFill, same contract) as the window needs it.  Returns frames
+ * produced; short only once `src` has run dry and the last input frame is
+ * behind the phase, so a converter is itself a legal AudioVoiceFill source.
+ */
+long audio_rs_pull(AudioResampler *rs, AudioVoiceFill src, void *src_ctx,
+                   int16_t *dst, long frames);
+
+/** Convert a whole buffer: `in_frames` of `in` into `out`, at most `out_cap`.
+ *  Resets `rs` first.  Returns frames written — audio_rs_frames_out() when
+ *  `out_cap` allows it. */
+long audio_rs_convert(AudioResampler *rs, const int16_t *in, long in_frames,
+                      int16_t *out, long out_cap);
+
+/* ── Trigger-to-DAC latency ─────────────────────────────────────────────────
+ *
+ * How long after a game asked for a sound it left the DAC.  The counters above
+ * say whether the stream kept up; none of them says how LATE a sound was, and
+ * that is the number a hit sound is tuned against.
+ *
+ * Three readings, and each comes from the one place that knows it:
+ *
+ *   - the TRIGGER — a µs stamp taken where the game called, and the stream
+ *     frame the voice's first sample will occupy: the frames the device has
+ *     taken so far, since a voice added now starts on the next frame rendered;
+ *   - the WRITE HEAD — frames the device has taken by the service that handed
+ *     that frame over;
+ *   - the DELAY — frames between the write head and the DAC, read off the
+ *     device right after that service (`audio_out_delay()`).
+ *
+ * The frame at `pos` is `written - pos` frames behind the head, so it reaches
+ * the DAC `delay - (written - pos)` frames after the reading — in the past when
+ * that is negative.  One projection per trigger, taken at the first service
+ * that hands the frame over, rather than a poll until it plays: the delay is
+ * the device's own figure and the pacing keeps it near the lead, so waiting
+ * would add another reading of the same number and nothing else.
+ *
+ * Pure like the rest of this file — the clock readings are arguments — so the
+ * arithmetic is host-tested (`tests/audio_gen_test.c`) and `audio.c` owns the
+ * clock.  ⚠️ Stamps are µs in a uint32 and wrap every ~71 minutes; every
+ * difference here is taken modulo 2^32, which is exact for anything shorter.
+ */
+
+/** Triggers awaiting their service.  One service hands over a lead's worth of
+ *  frames, and a game triggers a handful per frame, so 16 is several frames of
+ *  margin; a trigger past it is counted in `missed`, never blocked on. */
+#define AUDIO_LAT_PENDING        16
+
+/** Histogram bins, 1 ms each; the last one collects everything slower. */
+#define AUDIO_LAT_BINS           256
+
+typedef struct {
+    uint32_t  t_us;          /**< the trigger, on the caller's clock          */
+    long long pos;           /**< the stream frame its first sample occupies  */
+} AudioLatMark;
+
+typedef struct {
+    AudioLatMark pend[AUDIO_LAT_PENDING];
+    int       npend;
+    uint32_t  hist[AUDIO_LAT_BINS];
+    uint32_t  count;         /**< triggers measured                           */
+    uint32_t  missed;        /**< triggers dropped: the pending table was full */
+    uint32_t  min_us, max_us;
+    uint64_t  sum_us;
+} AudioLatency;
+
+/** One window of latencies, in µs; zeros when count == 0.  p50/p99 are
+ *  histogram upper edges, so upper bounds good to the millisecond. */
+typedef struct {
+    uint32_t count;
+    uint32_t missed;
+    uint32_t min_us;
+    uint32_t avg_us;
+    uint32_t p50_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} AudioLatencyStats;
+
+/** Empty the window and forget the pending triggers. */
+void audio_lat_reset(AudioLatency *lat);
+
+/** Forget the pending triggers only — the stream they were positioned in has
+ *  gone, and a new one counts its frames from zero. */
+void audio_lat_drop_pending(AudioLatency *lat);
+
+/** Record a trigger at `t_us` whose first sample is stream frame `pos`.  False,
+ *  and counted in `missed`, when the pending table is full. */
+bool audio_lat_mark(AudioLatency *lat, uint32_t t_us, long long pos);
+
+/** Pending triggers: what a caller checks before paying for a delay reading. */
+int  audio_lat_pending(const AudioLatency *lat);
+
+/**
+ * Resolve every pending trigger whose first frame the device now holds, from
+ * one reading: `written` frames taken and `delay` frames ahead of the DAC, at
+ * `now_us`.  Returns triggers resolved.  A projection that lands before its
+ * own trigger — a delay the device under-reported — is recorded as 0.
+ */
+int  audio_lat_observe(AudioLatency *lat, int rate, uint32_t now_us,
+                       long long written, long delay);
+
+void audio_lat_stats(const AudioLatency *lat, AudioLatencyStats *out);
+
+/** "42 triggers, 0 missed; trigger→DAC min/avg/p50/p99/max
+ *  81.2/96.0/97.0/112.0/118.4 ms" — for a Logger or a printf.  Returns buf. */
+char *audio_lat_format(const AudioLatencyStats *st, char *buf, size_t size);
+
+/* ── The command ring: one producer, one consumer, no lock ──────────────────
+ *
+ * What `audio.c`'s audio server (audio_server_start(), audio.h) posts its calls
+ * through: the game loop produces, the server process consumes.  ⚠️ **No mutex,
+ * and not for style** — there is no pthread to take one from (the static-ARM
+ * `clock_gettime64` scar), and the two ends are different PROCESSES sharing one
+ * MAP_SHARED page, where a lock held by a process that died is held forever.
+ *
+ * `head` is written only by the producer and `tail` only by the consumer, each
+ * a free-running count that wraps through 2^32 — so "full" is `head - tail ==
+ * AUDIO_CMD_SLOTS` and needs no spare slot.  The payload is written BEFORE the
+ * release store of `head` and read AFTER the acquire load of it; that pair is
+ * the whole synchronisation (a `dmb` each way on the A8).  The two counters sit
+ * on separate cache lines so the ends do not bounce one line between them.
+ *
+ * Pure like the rest of this file — no fd, no clock — so the ordering, the full
+ * refusal and the wrap are host-tested, across a real fork() as well.
+ */
+
+/** Slots in the ring.  A power of two, so the index is a mask. */
+#define AUDIO_CMD_SLOTS          64
+
+/** Longest path a command can carry, terminator included. */
+#define AUDIO_CMD_PATH_MAX       128
+
+/** One posted call.  `op` and the arguments mean whatever the two ends agree;
+ *  `seq` is the producer's count, so a caller can wait for ITS command, and
+ *  `t_us` is when the producer posted it, so a trigger's latency starts at the
+ *  game's call and not at the consumer's pop. */
+typedef struct {
+    uint32_t seq;
+    uint32_t t_us;
+    int      op;
+    int      a, b, c;
+    char     path[AUDIO_CMD_PATH_MAX];
+} AudioCmd;
+
+typedef struct {
+    uint32_t head;                  /**< producer's count: posted           */
+    char     pad_head[60];
+    uint32_t tail;                  /**< consumer's count: taken            */
+    char     pad_tail[60];
+    AudioCmd slot[AUDIO_CMD_SLOTS];
+} AudioCmdRing;
+
+void audio_cmd_init(AudioCmdRing *r);
+
+/** Producer only.  False — and nothing written — when the ring is full: the
+ *  producer is a game loop and must never wait on the audio side. */
+bool audio_cmd_push(AudioCmdRing *r, const AudioCmd *c);
+
+/** Consumer only.  False when empty. */
+bool audio_cmd_pop(AudioCmdRing *r, AudioCmd *out);
+
+/** Commands posted and not yet taken.  Either end; a snapshot. */
+uint32_t audio_cmd_depth(const AudioCmdRing *r);
+
 #endif /* AUDIO_GEN_H */
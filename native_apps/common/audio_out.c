@@ -171,11 +171,48 @@ static long push(AudioOut *out, const int16_t *buf, long frames,
     if (res.sink_error) out->sink_errors++;
 
     out->last_frames = res.frames_written;
+    if (res.frames_written > 0) out->written += res.frames_written;
     if (res.frames_written < frames)
         out->lost += (uint32_t)(frames - res.frames_written);
     return res.frames_written;
 }
 
+/** The zero-copy service: the fill renders INTO the device's ring.  Two pieces
+ *  at most, because the ring wraps once.  Frames are whole by construction here —
+ *  the device hands out frames, not bytes — so there is no realignment and no
+ *  `audio_write_frames()` loop to route through; the accounting is push()'s. */
+static long push_mapped(AudioOut *out, long frames)
+{
+    long done = 0;
+    for (int piece = 0; piece < 2 && done < frames; piece++) {
+        int16_t *area = NULL;
+        long n = out->dev->map(out->dev_ctx, frames - done, &area);
+        if (n <= 0 || !area) break;
+
+        /* ⚠️ Zeroed for the same reason the scratch is, and NEVER read: a DMA
+         * ring is commonly mapped write-combined, where a read costs a bus
+         * round trip per word.  The fill and the memset only store, and the
+         * attenuation is a no-op at shift 0 — the native path's setting. */
+        long samples = n * (long)out->channels;
+        memset(area, 0, (size_t)samples * sizeof(int16_t));
+        if (out->fill)
+            out->fill(out->fill_ctx, area, n, out->channels);
+        attenuate(area, samples, out->shift);
+
+        long took = out->dev->commit(out->dev_ctx, n);
+        if (took > 0) done += took;
+        if (took < n) {
+            out->sink_errors++;
+            break;
+        }
+    }
+
+    out->last_frames = done;
+    out->written    += done;
+    if (done < frames) out->lost += (uint32_t)(frames - done);
+    return done;
+}
+
 /* ── Open ───────────────────────────────────────────────────────────────── */
 
 int audio_out_open(AudioOut *out, const AudioOutDev *dev, void *dev_ctx,
@@ -301,6 +338,38 @@ void audio_out_close(AudioOut *out)
     }
 
     free(out->buf);
+    free(out->alsa);
+    out->alsa       = NULL;
+    out->buf        = NULL;
+    out->buf_frames = 0;
+    out->is_open    = false;
+    out->fill       = NULL;
+    out->fill_ctx   = NULL;
+    out->fill_owner = NULL;
+    out->dev        = NULL;
+    out->dev_ctx    = NULL;
+    out->oss_fd     = -1;
+}
+
+/* ── Release: this process's copy, without a drain ──────────────────────── */
+
+void audio_out_release(AudioOut *out)
+{
+    if (!out) return;
+
+    /* ⚠️ No drain and no device call beyond the close: the queued tail belongs to
+     * the process that keeps the stream, and a drain here would block the game
+     * for a ring's worth of audio that it is not going to write any more of. */
+    if (out->is_open && out->dev) {
+        if (out->dev->release) out->dev->release(out->dev_ctx);
+        else                   out->dev->close(out->dev_ctx);
+        g_live--;
+        if (g_live < 0) g_live = 0;
+    }
+
+    free(out->buf);
+    free(out->alsa);
+    out->alsa       = NULL;
     out->buf        = NULL;
     out->buf_frames = 0;
     out->is_open    = false;
@@ -365,6 +434,9 @@ long audio_out_service(AudioOut *out)
         return 0;
     }
 
+    if (out->dev->map && out->dev->commit)
+        return push_mapped(out, want);
+
     int16_t *buf = scratch(out, want);
     if (!buf) {
         out->refused++;
@@ -446,6 +518,18 @@ bool audio_out_is_open(const AudioOut *out)     { return out ? out->is_open  : f
 long audio_out_lead(const AudioOut *out)        { return out ? out->lead_frames   : 0; }
 long audio_out_period(const AudioOut *out)      { return out ? out->period_frames : 0; }
 long audio_out_last_frames(const AudioOut *out) { return out ? out->last_frames   : 0; }
+long long audio_out_written(const AudioOut *out) { return out ? out->written       : 0; }
+
+long audio_out_delay(AudioOut *out)
+{
+    if (!out || !out->is_open || !out->dev) return -1;
+    if (out->dev->delay) return out->dev->delay(out->dev_ctx, out->frame_bytes);
+
+    AudioOutSpace sp;
+    memset(&sp, 0, sizeof(sp));
+    if (out->dev->space(out->dev_ctx, out->frame_bytes, &sp) != 0) return -1;
+    return sp.in_flight > 0 ? sp.in_flight : 0;
+}
 
 uint32_t audio_out_starved(const AudioOut *out)     { return out ? out->starved     : 0; }
 uint32_t audio_out_lost(const AudioOut *out)        { return out ? out->lost        : 0; }
@@ -455,30 +539,27 @@ uint32_t audio_out_refused(const AudioOut *out)     { return out ? out->refused
 uint32_t audio_out_services(const AudioOut *out)    { return out ? out->services    : 0; }
 uint32_t audio_out_drain_waits(const AudioOut *out) { return out ? out->drain_waits : 0; }
 
-/* ── The OSS backend ─────────────────────────────────────────────────────────
+/* ── The backends, and the amplifier both of them need ───────────────────────
  *
- * The only device code below this header.  It is compiled out where the OSS
- * headers do not exist, so the host regression links this file with no device in
- * it at all — the same split `audio_gen.c` already has, one level down.
+ * Each backend is compiled only where its header exists, so the host regression
+ * links this file with no device in it at all — the same split `audio_gen.c`
+ * already has, one level down.  Both are detected HERE, because the amp below is
+ * shared and must not be an unused function on a host that has neither.
  */
 
 #if defined(__has_include)
 #  if __has_include(<sys/soundcard.h>)
 #    define AUDIO_OUT_HAVE_OSS 1
 #  endif
+#  if __has_include(<tinyalsa/asoundlib.h>)
+#    define AUDIO_OUT_HAVE_TINYALSA 1
+#  endif
 #endif
 
-#ifdef AUDIO_OUT_HAVE_OSS
-
-#include <errno.h>
-#include <fcntl.h>
-#include <unistd.h>
-#include <sys/ioctl.h>
-#include <sys/soundcard.h>
+#if defined(AUDIO_OUT_HAVE_OSS) || defined(AUDIO_OUT_HAVE_TINYALSA)
 
 #define GPIO12_DIRECTION  "/sys/class/gpio/gpio12/direction"
 #define GPIO12_VALUE      "/sys/class/gpio/gpio12/value"
-#define DSP_DEVICE        "/dev/dsp"
 
 /** Drive GPIO12 HIGH to enable the on-board speaker amplifier (SPKR1).  Done
  *  here rather than by the caller so it works from a dev shell before
@@ -492,6 +573,24 @@ static void enable_amp(void)
     if (f) { fputs("1",   f); fclose(f); }
 }
 
+#endif
+
+/* ── The OSS backend ─────────────────────────────────────────────────────────
+ *
+ * `/dev/dsp` through the kernel's OSS emulation — the measured path, and still
+ * the default.
+ */
+
+#ifdef AUDIO_OUT_HAVE_OSS
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/soundcard.h>
+
+#define DSP_DEVICE        "/dev/dsp"
+
 static int oss_open(void *ctx, int rate_req, int channels_req,
                     int *rate_granted, int *bits_granted, int *channels_granted)
 {
@@ -595,8 +694,20 @@ static void oss_close(void *ctx)
     if (*fdp >= 0) { close(*fdp); *fdp = -1; }
 }
 
+/* GETODELAY answers in bytes, like GETOSPACE, and is converted the same way. */
+static long oss_delay(void *ctx, int frame_bytes)
+{
+    int *fdp = (int *)ctx;
+    int bytes = 0;
+
+    if (frame_bytes <= 0) return -1;
+    if (ioctl(*fdp, SNDCTL_DSP_GETODELAY, &bytes) < 0 || bytes < 0) return -1;
+    return (long)bytes / frame_bytes;
+}
+
 static const AudioOutDev OSS_DEV = {
-    oss_open, oss_space, oss_write, oss_wait, oss_close
+    oss_open, oss_space, oss_write, oss_wait, oss_close, NULL, NULL, NULL,
+    oss_delay
 };
 
 int audio_out_open_oss(AudioOut *out, int rate_req, int channels_req)
@@ -621,3 +732,288 @@ int audio_out_open_oss(AudioOut *out, int rate_req, int channels_req)
 }
 
 #endif /* AUDIO_OUT_HAVE_OSS */
+
+/* ── The ALSA backend ────────────────────────────────────────────────────────
+ *
+ * Native `hw:card,device` through tinyalsa, the F1 Phase 4 path: the same stream
+ * on the same DAI, minus the OSS emulation layer, its fixed 2048-frame period and
+ * its over-reporting free space.  Compiled out where tinyalsa's header is not on
+ * the include path — build-and-deploy.sh puts `arm-deps/include` there, the host
+ * build does not, and `tests/audio_alsa_test.c` puts a simulated one there.
+ *
+ * ⚠️ tinyalsa, not alsa-lib, and that is a decision rather than a gap: it links
+ * static with no dlopen and ships nothing to the device — no libasound, no
+ * /usr/share/alsa (../IMPROVEMENT_PLAN.md F1, operator decisions).  So there is
+ * no `plug`, no `dmix` and no `null` device: what opens is the hardware, and a
+ * rate or channel count it does not support is refused rather than converted.
+ */
+
+#ifdef AUDIO_OUT_HAVE_TINYALSA
+
+#include <errno.h>
+#include <unistd.h>
+#include <tinyalsa/asoundlib.h>
+
+typedef struct {
+    struct pcm *pcm;
+    unsigned    card, device;
+    long        frame_bytes;
+    long        period_frames;
+    long        ring_frames;
+    bool        running;      /**< started, and not yet seen to underrun         */
+    unsigned    map_offset;   /**< the last map()'s ring offset, for commit()    */
+    uint32_t    xruns;        /**< recoveries, for the close-time line           */
+} AlsaDev;
+
+/** Back to PREPARED after an underrun or a refused commit.  The kernel leaves
+ *  the stream stopped in XRUN and nothing restarts it but this; the next commit
+ *  restarts the DAC. */
+static void alsa_recover(AlsaDev *a)
+{
+    a->running = false;
+    a->xruns++;
+    if (pcm_prepare(a->pcm) != 0)
+        fprintf(stderr, "audio_out: ALSA re-prepare failed: %s\n",
+                pcm_get_error(a->pcm));
+}
+
+static int alsa_open(void *ctx, int rate_req, int channels_req,
+                     int *rate_granted, int *bits_granted, int *channels_granted)
+{
+    AlsaDev *a = (AlsaDev *)ctx;
+
+    enable_amp();
+
+    struct pcm_config cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.channels     = (unsigned)channels_req;
+    cfg.rate         = (unsigned)rate_req;
+    cfg.period_size  = AUDIO_OUT_ALSA_PERIOD_FRAMES;
+    cfg.period_count = AUDIO_OUT_ALSA_PERIODS;
+    cfg.format       = PCM_FORMAT_S16_LE;
+    /* ⚠️ The DAC is started by alsa_commit(), never by a threshold: an mmap
+     * commit is not a write, and whether the kernel auto-starts on one differs
+     * between kernel versions.  A start that does not depend on it is the same
+     * on the panel's 2.6 kernel as on the host.  The stop threshold stays the
+     * default — the ring — so an empty ring IS an XRUN, which is the signal. */
+    cfg.start_threshold = AUDIO_OUT_ALSA_PERIOD_FRAMES * AUDIO_OUT_ALSA_PERIODS;
+
+    a->pcm = pcm_open(a->card, a->device, PCM_OUT | PCM_MMAP | PCM_NONBLOCK, &cfg);
+    if (!a->pcm || !pcm_is_ready(a->pcm)) {
+        fprintf(stderr, "audio_out: cannot open ALSA hw:%u,%u: %s\n", a->card,
+                a->device, a->pcm ? pcm_get_error(a->pcm) : "no memory");
+        if (a->pcm) pcm_close(a->pcm);
+        a->pcm = NULL;
+        return -1;
+    }
+
+    /* The GRANT.  tinyalsa writes back what hw_params settled on, so these are
+     * the device's numbers, not cfg's. */
+    const struct pcm_config *got = pcm_get_config(a->pcm);
+    a->frame_bytes   = (long)pcm_frames_to_bytes(a->pcm, 1);
+    a->ring_frames   = (long)pcm_get_buffer_size(a->pcm);
+    a->period_frames = got ? (long)got->period_size : 0;
+    if (a->period_frames <= 0 || a->period_frames > a->ring_frames)
+        a->period_frames = a->ring_frames / AUDIO_OUT_ALSA_PERIODS;
+
+    if (pcm_prepare(a->pcm) != 0) {
+        fprintf(stderr, "audio_out: ALSA prepare failed: %s\n", pcm_get_error(a->pcm));
+        pcm_close(a->pcm);
+        a->pcm = NULL;
+        return -1;
+    }
+
+    *rate_granted     = (int)pcm_get_rate(a->pcm);
+    *bits_granted     = (int)pcm_format_to_bits(pcm_get_format(a->pcm));
+    *channels_granted = (int)pcm_get_channels(a->pcm);
+
+    fprintf(stderr, "audio_out: ALSA hw:%u,%u open (mmap), granted %d Hz %d-bit "
+                    "%d ch, %ld x %ld frames (requested %d Hz %d ch)\n",
+            a->card, a->device, *rate_granted, *bits_granted, *channels_granted,
+            a->ring_frames / (a->period_frames > 0 ? a->period_frames : 1),
+            a->period_frames, rate_req, channels_req);
+    return 0;
+}
+
+/* An underrun is found HERE, on the service's first call, so it lands on the
+ * same `in_flight <= 0` test an OSS underrun does: counted once as `starved`, and
+ * the lead is refilled from empty by the same arithmetic. */
+static int alsa_space(void *ctx, int frame_bytes, AudioOutSpace *sp)
+{
+    AlsaDev *a = (AlsaDev *)ctx;
+    if (!a->pcm || frame_bytes <= 0) return -1;
+
+    long avail = pcm_mmap_avail(a->pcm);
+    if (a->running && (avail < 0 || avail >= a->ring_frames)) {
+        alsa_recover(a);
+        avail = a->ring_frames;
+    }
+    if (avail < 0) return -1;
+    if (avail > a->ring_frames) avail = a->ring_frames;
+
+    sp->period_frames = a->period_frames;
+    sp->ring_frames   = a->ring_frames;
+    sp->space         = avail;
+    sp->in_flight     = a->ring_frames - avail;
+    return 0;
+}
+
+static long alsa_map(void *ctx, long frames, int16_t **area)
+{
+    AlsaDev *a = (AlsaDev *)ctx;
+    if (!a->pcm || frames <= 0) return -1;
+
+    void *base = NULL;
+    unsigned offset = 0, n = (unsigned)frames;
+    if (pcm_mmap_begin(a->pcm, &base, &offset, &n) < 0 || !base) return -1;
+
+    a->map_offset = offset;
+    *area = (int16_t *)((char *)base + (long)offset * a->frame_bytes);
+    return (long)n;
+}
+
+static long alsa_commit(void *ctx, long frames)
+{
+    AlsaDev *a = (AlsaDev *)ctx;
+    if (!a->pcm || frames <= 0) return 0;
+
+    int took = pcm_mmap_commit(a->pcm, a->map_offset, (unsigned)frames);
+    if (took < 0) {
+        alsa_recover(a);
+        return 0;
+    }
+    if (!a->running && took > 0) {
+        if (pcm_start(a->pcm) == 0) {
+            a->running = true;
+        } else {
+            /* Queued but not playing: the next space() still reads it as queued,
+             * and the next commit tries the start again. */
+            fprintf(stderr, "audio_out: ALSA start failed: %s\n", pcm_get_error(a->pcm));
+        }
+    }
+    return took;
+}
+
+/* Mode 2 and the prefill: the same ring, through a copy.  Whole frames only —
+ * the ring cannot hold half of one — so a byte count that is not a frame
+ * multiple is taken up to its last whole frame. */
+static ssize_t alsa_write(void *ctx, const void *buf, size_t nbytes, bool *again)
+{
+    AlsaDev *a = (AlsaDev *)ctx;
+    if (!a->pcm || a->frame_bytes <= 0) { errno = EBADF; return -1; }
+
+    const char *src = (const char *)buf;
+    long want = (long)nbytes / a->frame_bytes;
+    long done = 0;
+
+    if (a->running) {
+        long avail = pcm_mmap_avail(a->pcm);
+        if (avail < 0 || avail >= a->ring_frames) alsa_recover(a);
+    }
+
+    for (int piece = 0; piece < 2 && done < want; piece++) {
+        int16_t *area = NULL;
+        long n = alsa_map(a, want - done, &area);
+        if (n <= 0) break;
+        memcpy(area, src + done * a->frame_bytes, (size_t)(n * a->frame_bytes));
+        long took = alsa_commit(a, n);
+        if (took <= 0) break;
+        done += took;
+        if (took < n) break;
+    }
+
+    if (done == 0) {
+        *again = true;
+        errno = EAGAIN;
+        return -1;
+    }
+    return (ssize_t)(done * a->frame_bytes);
+}
+
+static void alsa_wait(void *ctx, int usec)
+{
+    (void)ctx;
+    /* ⚠️ Not pcm_wait().  It returns as soon as a period is free, and the drain
+     * polls while there is free space — so it would spin the drain's whole bound
+     * in a few milliseconds and close on a full ring. */
+    if (usec > 0) usleep((useconds_t)usec);
+}
+
+static void alsa_close(void *ctx)
+{
+    AlsaDev *a = (AlsaDev *)ctx;
+    if (!a->pcm) return;
+
+    /* The generic drain stops at the OSS slack, ~1.3 periods, because the shim's
+     * free space over-reports.  This one does not, so that remainder is real
+     * audio, and pcm_close() DROPs it — wait it out first, once, bounded by what
+     * the device itself says is left. */
+    long avail = pcm_mmap_avail(a->pcm);
+    if (a->running && avail >= 0 && avail < a->ring_frames) {
+        long ms = audio_ms_for_frames((int)pcm_get_rate(a->pcm), a->ring_frames - avail);
+        if (ms > 0) usleep((useconds_t)(ms * 1000));
+    }
+    if (a->xruns)
+        fprintf(stderr, "audio_out: ALSA hw:%u,%u closed after %u XRUN recover%s\n",
+                a->card, a->device, a->xruns, a->xruns == 1 ? "y" : "ies");
+
+    pcm_close(a->pcm);
+    a->pcm = NULL;
+    a->running = false;
+}
+
+/* ⚠️ The fork parent's copy.  pcm_close() would stop the stream the child is
+ * still playing (it DROPs before it unmaps), so this closes the parent's fd and
+ * nothing else.  The `struct pcm` is tinyalsa's and opaque, and the only call
+ * that frees it is pcm_close(), so it is left behind: a few hundred bytes, once
+ * per process, against stopping the DAC from the wrong side of the fork. */
+static void alsa_release(void *ctx)
+{
+    AlsaDev *a = (AlsaDev *)ctx;
+    if (!a->pcm) return;
+    int fd = pcm_get_file_descriptor(a->pcm);
+    if (fd >= 0) close(fd);
+    a->pcm = NULL;
+    a->running = false;
+}
+
+static const AudioOutDev ALSA_DEV = {
+    alsa_open, alsa_space, alsa_write, alsa_wait, alsa_close,
+    alsa_map, alsa_commit, alsa_release,
+    NULL                       /* in_flight is already the kernel's delay */
+};
+
+int audio_out_open_alsa(AudioOut *out, unsigned card, unsigned device,
+                        int rate_req, int channels_req)
+{
+    if (!out) return -1;
+
+    /* Owned by the AudioOut, like the scratch, and freed by close/release.  It is
+     * attached only AFTER audio_out_open(), whose first act is the memset. */
+    AlsaDev *a = (AlsaDev *)calloc(1, sizeof(*a));
+    if (!a) return -1;
+    a->card   = card;
+    a->device = device;
+
+    int rc = audio_out_open(out, &ALSA_DEV, a, rate_req, channels_req);
+    if (rc != 0) {
+        if (a->pcm) pcm_close(a->pcm);
+        free(a);
+        return rc;
+    }
+    out->alsa = a;
+    return 0;
+}
+
+#else  /* no tinyalsa header: the host, or a build without arm-deps */
+
+int audio_out_open_alsa(AudioOut *out, unsigned card, unsigned device,
+                        int rate_req, int channels_req)
+{
+    (void)card; (void)device; (void)rate_req; (void)channels_req;
+    if (out) { memset(out, 0, sizeof(*out)); out->oss_fd = -1; }
+    fprintf(stderr, "audio_out: built without tinyalsa — no ALSA backend\n");
+    return -1;
+}
+
+#endif /* AUDIO_OUT_HAVE_TINYALSA */
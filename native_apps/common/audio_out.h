@@ -55,6 +55,9 @@
  *   - The fill callback must not call back into any `audio_out_*` function.
  *   - The accessors are reads of one word and safe from anywhere; they are
  *     diagnostics, not synchronisation.
+ *   - Across a fork() the stream belongs to ONE process.  `audio.c`'s audio
+ *     server is the case: the child services, and the parent calls
+ *     `audio_out_release()` on its copy instead of ever touching it again.
  *
  * ── THE TWO WRITE MODES, AND WHY BOTH ────────────────────────────────────────
  *
@@ -123,14 +126,29 @@
 /** Poll interval while draining at close, in microseconds. */
 #define AUDIO_OUT_DRAIN_WAIT_US      2000
 
+/** The ALSA backend's ring, asked for explicitly rather than inherited.
+ *
+ * 1024 frames is 23 ms at 44100 — half the OSS shim's 2048, which is the latency
+ * F1 Phase 4 is for.  ⚠️ The lead is still `audio_pump_lead_frames()`'s: 80 ms
+ * rounds up to FOUR of these periods, and that function caps the lead at half
+ * the ring, so eight is the smallest count that does not clip it.  The device
+ * may grant other numbers; the grant, read back, is what the geometry uses. */
+#define AUDIO_OUT_ALSA_PERIOD_FRAMES 1024
+#define AUDIO_OUT_ALSA_PERIODS       8
+
 /* ── The device, behind a vtable ─────────────────────────────────────────────
  *
  * Injectable for exactly one reason: it is what lets `tests/audio_out_test.c`
  * drive this file on the host with **no fd in the test at all** — a simulated
  * ring that can be told to over-report, to stall, to accept half a frame, or to
- * grant a channel count nobody asked for.  The OSS implementation lives in
- * `audio_out.c` behind `audio_out_open_oss()` and is the only device code in the
- * repo below this header.
+ * grant a channel count nobody asked for.  The two implementations live in
+ * `audio_out.c` behind `audio_out_open_oss()` and `audio_out_open_alsa()` and are
+ * the only device code in the repo below this header.
+ *
+ * `map`/`commit` are the optional zero-copy pair, both or neither: a device that
+ * can hand out its own ring gets the fill rendered straight into it by
+ * `audio_out_service()`, and the scratch copy disappears.  `release` is optional
+ * too — see `audio_out_release()`; without it the fork parent calls `close`.
  */
 
 typedef struct {
@@ -157,6 +175,19 @@ typedef struct {
     ssize_t (*write)(void *ctx, const void *buf, size_t nbytes, bool *again);
     void (*wait)(void *ctx, int usec);
     void (*close)(void *ctx);
+
+    /** Up to `frames` CONTIGUOUS frames of the device's own ring at its write
+     *  position, in `*area`.  Returns the frames granted — fewer at the ring's
+     *  wrap — 0 when it is full, -1 on a fault. */
+    long (*map)(void *ctx, long frames, int16_t **area);
+    /** Hand the first `frames` of the last `map` to the device.  Returns the
+     *  frames it took; anything less is audio that will not be played. */
+    long (*commit)(void *ctx, long frames);
+    /** Drop this process's copy of the device without stopping it. */
+    void (*release)(void *ctx);
+    /** Optional: frames between the write position and the DAC right now, or
+     *  -1.  Without it audio_out_delay() reads `in_flight` off `space`. */
+    long (*delay)(void *ctx, int frame_bytes);
 } AudioOutDev;
 
 /**
@@ -183,6 +214,7 @@ typedef struct {
     const AudioOutDev *dev;
     void       *dev_ctx;
     int         oss_fd;        /**< the OSS backend's own ctx; -1 otherwise    */
+    void       *alsa;          /**< the ALSA backend's own ctx; NULL otherwise */
     bool        is_open;
 
     /* What the device GRANTED.  Never what was requested. */
@@ -217,6 +249,8 @@ typedef struct {
     uint32_t    services;
     uint32_t    drain_waits;
     long        last_frames;
+    long long   written;       /**< frames the device took since open: the
+                                *   stream position of the next frame rendered */
 } AudioOut;
 
 /**
@@ -244,6 +278,27 @@ int  audio_out_open(AudioOut *out, const AudioOutDev *dev, void *dev_ctx,
  */
 int  audio_out_open_oss(AudioOut *out, int rate_req, int channels_req);
 
+/**
+ * The same, on native ALSA `hw:card,device` through tinyalsa: `PCM_MMAP`, an
+ * explicit `AUDIO_OUT_ALSA_PERIOD_FRAMES` × `AUDIO_OUT_ALSA_PERIODS` ring, and the
+ * serviced mode writing straight into the DMA buffer (`map`/`commit` above).
+ *
+ * ⚠️ **An XRUN is recovered, never returned.** The backend re-prepares the stream
+ * and reports it empty, so it is counted exactly where an OSS underrun is — one
+ * `starved` — and the next service refills the lead and restarts the DAC.  A
+ * commit the device refused is counted as `lost`.  Neither counter gained a
+ * second meaning.
+ *
+ * ⚠️ Opened `PCM_NONBLOCK`: a busy ALSA device BLOCKS a plain open until it is
+ * free, which would turn "fall back to OSS" into "hang at init".
+ *
+ * Returns -1 — and a caller should fall back to `audio_out_open_oss()` — where
+ * the build has no tinyalsa, the device refuses the ring, or it grants a format
+ * other than S16_LE.
+ */
+int  audio_out_open_alsa(AudioOut *out, unsigned card, unsigned device,
+                         int rate_req, int channels_req);
+
 /**
  * Drain what is queued — bounded — then close.  Safe on a struct that was never
  * opened or whose open failed.
@@ -255,6 +310,22 @@ int  audio_out_open_oss(AudioOut *out, int rate_req, int channels_req);
  */
 void audio_out_close(AudioOut *out);
 
+/**
+ * Close THIS PROCESS's copy of the stream without draining it.
+ *
+ * For the parent of a fork() that handed the stream to its child
+ * (`audio_server_start()`, audio.h): both processes hold the same open file
+ * description, and the child goes on servicing it.  `audio_out_close()` here
+ * would wait out the child's queue and then count the device as free while it
+ * is not; this drops the fd, the scratch and this process's "one live" mark, and
+ * touches nothing the child can see.
+ *
+ * ⚠️ On ALSA "touches nothing" is the backend's `release`, not its `close`:
+ * closing a tinyalsa pcm issues DROP on the shared stream, which would stop the
+ * child's DAC from the parent.
+ */
+void audio_out_release(AudioOut *out);
+
 /**
  * Install, replace or (with `fill == NULL`) remove the fill callback.
  *
@@ -374,6 +445,28 @@ long audio_out_lead(const AudioOut *out);
 long audio_out_period(const AudioOut *out);
 /** Frames the last service or write handed to the device. */
 long audio_out_last_frames(const AudioOut *out);
+/** Frames the device has taken since open, prefill included — the position in
+ *  the stream a voice added now starts at.  64-bit: a 32-bit count wraps after
+ *  ~13.5 hours at 44100, and a kiosk runs longer than that. */
+long long audio_out_written(const AudioOut *out);
+
+/**
+ * Frames between the write position and the DAC, read off the device NOW: what
+ * a frame handed over this instant waits before it is heard.  -1 on a closed
+ * stream or a failed read.
+ *
+ * ⚠️ **Not `space`'s `in_flight` on OSS, because that is the over-stated figure**
+ * (`AUDIO_OUT_OSPACE_SLACK_NUM`).  The OSS backend asks `SNDCTL_DSP_GETODELAY`,
+ * which is the emulation's own answer to exactly this question.  On tinyalsa
+ * `in_flight` already IS the delay — `buffer_size − avail` off the kernel's
+ * synced `hw_ptr` is how ALSA defines it for playback — so that backend needs no
+ * hook of its own.  Neither includes the codec's own pipeline, which is a fixed
+ * few samples on this part and not the number anyone is tuning.  ⚠️ Whether the
+ * shim's GETODELAY carries the same ~1.3-period excess as its GETOSPACE is NOT
+ * yet measured; compare the two backends' readings on `.188` before trusting
+ * an OSS figure to a period.
+ */
+long audio_out_delay(AudioOut *out);
 
 /** Services that found the queue DRY.  ⚠️ On a stream that is never allowed to
  *  go idle, dry is ALWAYS a fault — one audible gap each — and it is what
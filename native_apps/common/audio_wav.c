@@ -1,13 +1,17 @@
 /*
- * audio_wav.c — streaming mono RIFF/WAVE reader.  Rationale in audio_wav.h.
+ * audio_wav.c — streaming mono RIFF/WAVE reader, PCM and IMA-ADPCM.  Rationale
+ * in audio_wav.h.
  */
 
 #include "audio_wav.h"
 
+#include <fcntl.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
-/* One frame of the file, in bytes.  16-bit only, checked at open. */
+/* One frame of the file, in bytes.  16-bit PCM only, checked at open. */
 #define WAV_BYTES_PER_SAMPLE 2
 
 /* Frames pulled from stdio per read() batch.  Bounded so a caller asking for a
@@ -25,6 +29,150 @@ static unsigned int le16(const unsigned char *p)
     return (unsigned int)p[0] | ((unsigned int)p[1] << 8);
 }
 
+/* ── IMA-ADPCM ────────────────────────────────────────────────────────────
+ * The standard IMA tables, once, for both directions.  A nibble is a sign and a
+ * 3-bit magnitude in quarter-steps of STEP[index]; the index then walks up on a
+ * large nibble and down on a small one, so the step tracks the signal's slope.
+ * Everything below is shifts, adds and two lookups — no multiply, no divide. */
+static const int16_t ADPCM_STEP[89] = {
+        7,     8,     9,    10,    11,    12,    13,    14,    16,    17,
+       19,    21,    23,    25,    28,    31,    34,    37,    41,    45,
+       50,    55,    60,    66,    73,    80,    88,    97,   107,   118,
+      130,   143,   157,   173,   190,   209,   230,   253,   279,   307,
+      337,   371,   408,   449,   494,   544,   598,   658,   724,   796,
+      876,   963,  1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+     2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,
+     5894,  6484,  7132,  7845,  8630,  9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static const int8_t ADPCM_INDEX_ADJ[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+/* Apply one nibble to a channel's predictor and index.  ⚠️ The ENCODER calls
+ * this too, rather than tracking the source sample: the encoder must predict
+ * from what the decoder will reconstruct, or the two drift apart by the
+ * quantisation error of every sample and the error accumulates. */
+static int adpcm_apply(int *pred, int *index, int nib)
+{
+    int step = ADPCM_STEP[*index];
+    int diff = step >> 3;
+    if (nib & 4) diff += step;
+    if (nib & 2) diff += step >> 1;
+    if (nib & 1) diff += step >> 2;
+
+    int p = (nib & 8) ? *pred - diff : *pred + diff;
+    if (p >  32767) p =  32767;
+    if (p < -32768) p = -32768;
+    *pred = p;
+
+    int i = *index + ADPCM_INDEX_ADJ[nib];
+    if (i < 0)  i = 0;
+    if (i > 88) i = 88;
+    *index = i;
+    return p;
+}
+
+/* A block header's predictor and index.  An index past 88 is a corrupt header;
+ * clamping it keeps the table read in bounds and the block merely sounds wrong. */
+static void adpcm_header(const uint8_t *h, int *pred, int *index)
+{
+    *pred  = (int16_t)le16(h);
+    *index = h[2] > 88 ? 88 : h[2];
+}
+
+long audio_adpcm_decode_block(const uint8_t *blk, long bytes, int channels,
+                              int16_t *dst)
+{
+    if (!blk || !dst || channels < 1 || channels > 2 || bytes < 4L * channels)
+        return 0;
+
+    if (channels == 1) {
+        int pred, index;
+        adpcm_header(blk, &pred, &index);
+        long n = 0;
+        dst[n++] = (int16_t)pred;
+        for (long i = 4; i < bytes; i++) {
+            dst[n++] = (int16_t)adpcm_apply(&pred, &index, blk[i] & 0x0f);
+            dst[n++] = (int16_t)adpcm_apply(&pred, &index, blk[i] >> 4);
+        }
+        return n;
+    }
+
+    /* Stereo interleaves in 4-byte runs: 8 nibbles of L, then 8 of R.  Decode a
+     * run of each into a pair of 8-frame scratches and average — (L+R)>>1, the
+     * same downmix, for the same reason, as the PCM path below. */
+    int pl, il, pr, ir;
+    adpcm_header(blk,     &pl, &il);
+    adpcm_header(blk + 4, &pr, &ir);
+    long n = 0;
+    dst[n++] = (int16_t)((pl + pr) >> 1);
+    for (long g = 8; g + 8 <= bytes; g += 8) {
+        int l[8], r[8];
+        for (int k = 0; k < 4; k++) {
+            l[2 * k]     = adpcm_apply(&pl, &il, blk[g + k] & 0x0f);
+            l[2 * k + 1] = adpcm_apply(&pl, &il, blk[g + k] >> 4);
+            r[2 * k]     = adpcm_apply(&pr, &ir, blk[g + 4 + k] & 0x0f);
+            r[2 * k + 1] = adpcm_apply(&pr, &ir, blk[g + 4 + k] >> 4);
+        }
+        for (int k = 0; k < 8; k++) dst[n++] = (int16_t)((l[k] + r[k]) >> 1);
+    }
+    return n;
+}
+
+long audio_adpcm_encode_block(const int16_t *src, long frames, int *index,
+                              uint8_t *dst, int block_align)
+{
+    if (!src || !index || !dst || frames <= 0 || block_align < 5) return 0;
+    long max = AUDIO_WAV_ADPCM_BLOCK_FRAMES(block_align, 1);
+    if (frames > max) frames = max;
+
+    /* The header carries the first sample EXACTLY and the running index, so a
+     * block decodes with no knowledge of the one before it. */
+    int pred = src[0];
+    if (*index < 0)  *index = 0;
+    if (*index > 88) *index = 88;
+    /* ⚠️ Raise the index to the block's opening slope.  The step only grows by
+     * a few table entries per nibble, so a block that starts steep — any sound
+     * out of silence, and the first block of every file, whose carried index is
+     * 0 — otherwise spends its first ~10 frames chasing the signal: measured
+     * 8644 off at frame 6 of a -8 dBFS 1 kHz sine.  The header stores the index,
+     * so choosing it costs the decoder nothing.  Raised only, never lowered. */
+    if (frames > 1) {
+        int d = abs((int)src[1] - pred);
+        while (*index < 88 && (ADPCM_STEP[*index] << 1) < d) (*index)++;
+    }
+    dst[0] = (uint8_t)(pred & 0xff);
+    dst[1] = (uint8_t)((pred >> 8) & 0xff);
+    dst[2] = (uint8_t)*index;
+    dst[3] = 0;
+
+    long out = 4;
+    for (long i = 1; i < frames; i += 2) {
+        int nib[2] = { 0, 0 };
+        for (int h = 0; h < 2; h++) {
+            /* A short last block with an even frame count leaves the high
+             * nibble of its last byte spare.  It is written as 0 and still
+             * applied, so the index carried out of this block is the one the
+             * decoder would hold; the decoder's extra frame is cut by `fact`. */
+            int s = (i + h < frames) ? src[i + h] : pred;
+            int step  = ADPCM_STEP[*index];
+            int delta = s - pred;
+            int n = 0;
+            if (delta < 0) { n = 8; delta = -delta; }
+            if (delta >= step)        { n |= 4; delta -= step; }
+            if (delta >= (step >> 1)) { n |= 2; delta -= step >> 1; }
+            if (delta >= (step >> 2))   n |= 1;
+            adpcm_apply(&pred, index, n);
+            nib[h] = n;
+        }
+        dst[out++] = (uint8_t)(nib[0] | (nib[1] << 4));
+    }
+    return out;
+}
+
 bool audio_wav_open(AudioWav *w, const char *path, bool loop)
 {
     if (!w || !path) return false;
@@ -44,8 +192,8 @@ bool audio_wav_open(AudioWav *w, const char *path, bool loop)
         return false;
     }
 
-    int  channels = 0, bits = 0, rate = 0;
-    long data_pos = 0, data_bytes = 0;
+    int  channels = 0, bits = 0, rate = 0, format = 0, block_align = 0;
+    long data_pos = 0, data_bytes = 0, spb = 0, fact = 0;
     unsigned char hdr[8];
 
     /* ⚠️ The walk itself.  `fmt ` and `data` can arrive in any order and with
@@ -58,14 +206,26 @@ bool audio_wav_open(AudioWav *w, const char *path, bool loop)
         unsigned long sz = le32(hdr + 4);
 
         if (!memcmp(hdr, "fmt ", 4)) {
-            unsigned char fmt[16];
-            if (sz < 16 || fread(fmt, 1, 16, f) != 16) break;
-            channels = (int)le16(fmt + 2);
-            rate     = (int)le32(fmt + 4);
-            bits     = (int)le16(fmt + 14);
-            if (sz > 16) {
-                if (fseek(f, (long)(sz - 16) + ((long)sz & 1), SEEK_CUR) != 0) break;
+            /* 16 bytes for PCM; ADPCM adds cbSize and wSamplesPerBlock. */
+            unsigned char fmt[20];
+            unsigned long take = sz >= 20 ? 20 : 16;
+            if (sz < 16 || fread(fmt, 1, take, f) != take) break;
+            format      = (int)le16(fmt);
+            channels    = (int)le16(fmt + 2);
+            rate        = (int)le32(fmt + 4);
+            block_align = (int)le16(fmt + 12);
+            bits        = (int)le16(fmt + 14);
+            if (take == 20 && le16(fmt + 16) >= 2) spb = (long)le16(fmt + 18);
+            if (sz > take) {
+                if (fseek(f, (long)(sz - take) + ((long)sz & 1), SEEK_CUR) != 0) break;
             }
+        } else if (!memcmp(hdr, "fact", 4)) {
+            /* The true frame count.  ADPCM needs it: a short last block's spare
+             * nibble would otherwise decode as one frame nobody recorded. */
+            unsigned char fc[4];
+            if (sz < 4 || fread(fc, 1, 4, f) != 4) break;
+            fact = (long)le32(fc);
+            if (fseek(f, (long)(sz - 4) + ((long)sz & 1), SEEK_CUR) != 0) break;
         } else if (!memcmp(hdr, "data", 4)) {
             data_pos   = ftell(f);
             data_bytes = (long)sz;
@@ -75,10 +235,27 @@ bool audio_wav_open(AudioWav *w, const char *path, bool loop)
         }
     }
 
-    if (channels < 1 || bits != 16 || data_pos <= 0 || data_bytes <= 0) {
-        fprintf(stderr, "audio_wav: %s: need 16-bit PCM with a data chunk "
-                        "(got %d ch, %d bits, %ld data bytes at %ld)\n",
-                path, channels, bits, data_bytes, data_pos);
+    bool adpcm = (format == AUDIO_WAV_IMA_ADPCM);
+    bool shape_ok = adpcm
+        ? (bits == 4 && channels >= 1 && channels <= 2
+           && block_align > 4 * channels && block_align <= AUDIO_WAV_ADPCM_MAX_BLOCK
+           && (channels == 1 || (block_align & 7) == 0))
+        : (channels >= 1 && bits == 16);
+    if (!shape_ok || data_pos <= 0 || data_bytes <= 0) {
+        fprintf(stderr, "audio_wav: %s: need 16-bit PCM or 4-bit IMA-ADPCM with a "
+                        "data chunk (got format 0x%x, %d ch, %d bits, block %d, "
+                        "%ld data bytes at %ld)\n",
+                path, format, channels, bits, block_align, data_bytes, data_pos);
+        fclose(f);
+        return false;
+    }
+    /* ⚠️ A samples-per-block that disagrees with the block size is a layout this
+     * decoder does not produce frames for, and trusting either number plays the
+     * file at a drifting offset.  Refuse it. */
+    long block_frames = adpcm ? AUDIO_WAV_ADPCM_BLOCK_FRAMES(block_align, channels) : 0;
+    if (adpcm && spb > 0 && spb != block_frames) {
+        fprintf(stderr, "audio_wav: %s: ADPCM block of %d bytes decodes to %ld "
+                        "frames, header says %ld\n", path, block_align, block_frames, spb);
         fclose(f);
         return false;
     }
@@ -97,8 +274,20 @@ bool audio_wav_open(AudioWav *w, const char *path, bool loop)
         }
     }
 
-    long frame_bytes = (long)WAV_BYTES_PER_SAMPLE * channels;
-    long frames      = data_bytes / frame_bytes;
+    long frames;
+    if (adpcm) {
+        /* Whole blocks, plus what a short last block holds.  The one divide is
+         * at open, never per read. */
+        long full = data_bytes / block_align;
+        long rem  = data_bytes - full * block_align;
+        frames = full * block_frames;
+        if (rem >= 4L * channels) frames += AUDIO_WAV_ADPCM_BLOCK_FRAMES(rem, channels);
+        if (fact > 0 && fact < frames) frames = fact;
+    } else {
+        long frame_bytes = (long)WAV_BYTES_PER_SAMPLE * channels;
+        frames     = data_bytes / frame_bytes;
+        data_bytes = frames * frame_bytes;   /* whole frames only */
+    }
     if (frames <= 0) {
         fprintf(stderr, "audio_wav: %s holds no whole frames\n", path);
         fclose(f);
@@ -109,11 +298,25 @@ bool audio_wav_open(AudioWav *w, const char *path, bool loop)
     w->rate       = rate;
     w->channels   = channels;
     w->data_pos   = data_pos;
-    w->data_bytes = frames * frame_bytes;   /* whole frames only */
+    w->data_bytes = data_bytes;
     w->frames     = frames;
     w->pos        = 0;
     w->loop       = loop;
     w->loops      = 0;
+    w->format     = adpcm ? AUDIO_WAV_IMA_ADPCM : AUDIO_WAV_PCM;
+
+    if (adpcm) {
+        w->block_align  = block_align;
+        w->block_frames = block_frames;
+        w->blk = (uint8_t *)malloc((size_t)block_align);
+        w->dec = (int16_t *)malloc((size_t)block_frames * sizeof(int16_t));
+        if (!w->blk || !w->dec) {
+            fprintf(stderr, "audio_wav: %s: out of memory for a %d-byte block\n",
+                    path, block_align);
+            audio_wav_close(w);
+            return false;
+        }
+    }
 
     if (fseek(f, data_pos, SEEK_SET) != 0) {
         fprintf(stderr, "audio_wav: %s: cannot seek to data at %ld\n", path, data_pos);
@@ -126,19 +329,252 @@ bool audio_wav_open(AudioWav *w, const char *path, bool loop)
 void audio_wav_rewind(AudioWav *w)
 {
     if (!w || !w->f) return;
-    if (fseek(w->f, w->data_pos, SEEK_SET) == 0) w->pos = 0;
+    if (w->map) {
+        /* No seek: the cursor is ours.  The first window was hinted before the
+         * wrap (map_hint()), so it is not hinted twice. */
+        w->pos    = 0;
+        w->cur    = 0;
+        w->hinted = w->wrap_hinted ? (w->data_bytes < AUDIO_WAV_MAP_WINDOW
+                                      ? w->data_bytes : AUDIO_WAV_MAP_WINDOW) : 0;
+        w->wrap_hinted = false;
+    } else if (fseek(w->f, w->data_pos, SEEK_SET) == 0) {
+        w->pos = 0;
+    }
+    /* The decoded block belongs to the old position.  Blocks are independent,
+     * so dropping it is the whole ADPCM rewind. */
+    w->dec_n  = 0;
+    w->dec_at = 0;
+}
+
+/* ── the mapped path ──────────────────────────────────────────────────────
+ * Two operations, and neither ever waits on the card.  map_hint() keeps the
+ * kernel's read-ahead two windows in front of the cursor — `WILLNEED` queues
+ * the read and returns.  map_ready() asks mincore() how much of what the next
+ * read needs is already in the page cache, and the read takes only that. */
+
+static void map_hint(AudioWav *w)
+{
+    int  fd  = fileno(w->f);
+    long end = w->cur + 2 * AUDIO_WAV_MAP_WINDOW;
+    if (end > w->data_bytes) end = w->data_bytes;
+    while (w->hinted < end) {
+        long len = w->data_bytes - w->hinted;
+        if (len > AUDIO_WAV_MAP_WINDOW) len = AUDIO_WAV_MAP_WINDOW;
+        posix_fadvise(fd, w->data_pos + w->hinted, len, POSIX_FADV_WILLNEED);
+        w->hinted += len;
+    }
+    /* ⚠️ The wrap is a SEEK to the top of the file, and sequential read-ahead
+     * does not see it coming: without this the first fill of every pass would
+     * ask for bytes nobody requested.  Hinted once the cursor is within two
+     * windows of the end — the same lead every other window gets. */
+    if (w->loop && !w->wrap_hinted && w->data_bytes - w->cur <= 2 * AUDIO_WAV_MAP_WINDOW) {
+        long len = w->data_bytes < AUDIO_WAV_MAP_WINDOW ? w->data_bytes : AUDIO_WAV_MAP_WINDOW;
+        posix_fadvise(fd, w->data_pos, len, POSIX_FADV_WILLNEED);
+        w->wrap_hinted = true;
+    }
+}
+
+/* Bytes from `cur` that can be touched without a wait, up to `need`.
+ *
+ * ⚠️ Asked afresh on every call, never cached: a page that was resident a second
+ * ago can have been evicted since, and a cached "yes" is exactly the fault this
+ * exists to avoid.  One mincore() per fill — once per read-ahead buffer, ~93 ms
+ * of a bed — costs a syscall that touches no disk. */
+static long map_ready(AudioWav *w, long need)
+{
+    unsigned char vec[AUDIO_WAV_MAP_WINDOW / 4096 + 2];
+    if (need > AUDIO_WAV_MAP_WINDOW) need = AUDIO_WAV_MAP_WINDOW;
+    if (need > w->data_bytes - w->cur) need = w->data_bytes - w->cur;
+    if (need <= 0) return 0;
+
+    uintptr_t mask  = (uintptr_t)w->page - 1;
+    uintptr_t start = (uintptr_t)(w->map + w->cur) & ~mask;
+    uintptr_t stop  = (uintptr_t)(w->map + w->cur + need);
+    size_t    pages = (size_t)((stop - start + mask) / (uintptr_t)w->page);
+    if (pages > sizeof(vec)) pages = sizeof(vec);
+
+    /* A probe that cannot answer must not silence the bed: fall back to
+     * touching the bytes, which is the stdio path's behaviour anyway. */
+    if (mincore((void *)start, pages * (size_t)w->page, vec) != 0) return need;
+
+    size_t i = 0;
+    while (i < pages && (vec[i] & 1)) i++;
+    long have = (long)((start + i * (size_t)w->page) - (uintptr_t)(w->map + w->cur));
+    if (have < 0)    have = 0;
+    if (have > need) have = need;
+    return have;
+}
+
+/* The PCM half of a mapped read: frames straight out of the mapping. */
+static long read_mapped_pcm(AudioWav *w, int16_t *dst, long frames)
+{
+    long frame_bytes = (long)WAV_BYTES_PER_SAMPLE * w->channels;
+    long done = 0;
+    while (done < frames) {
+        if (w->pos >= w->frames) {
+            if (!w->loop) break;
+            audio_wav_rewind(w);
+            w->loops++;
+        }
+        long want = frames - done;
+        long left = w->frames - w->pos;
+        if (want > left) want = left;
+
+        long ok = map_ready(w, want * frame_bytes) / frame_bytes;
+        if (ok <= 0) {
+            /* ⚠️ Not arrived.  Silence for the rest of this fill and return it
+             * as FULL — a short fill would end the voice — and try again next
+             * fill, from the same cursor.  This is the whole stall guarantee. */
+            memset(dst + done, 0, (size_t)(frames - done) * sizeof(int16_t));
+            w->stalled += frames - done;
+            done = frames;
+            break;
+        }
+
+        const uint8_t *src = w->map + w->cur;
+        if (w->channels == 1) {
+            memcpy(dst + done, src, (size_t)ok * sizeof(int16_t));
+        } else {
+            for (long i = 0; i < ok; i++) {
+                int16_t lr[2];
+                memcpy(lr, src + i * frame_bytes, sizeof(lr));
+                /* (L+R)>>1, same as the stdio path and for the same reason. */
+                dst[done + i] = (int16_t)(((int32_t)lr[0] + (int32_t)lr[1]) >> 1);
+            }
+        }
+        w->cur += ok * frame_bytes;
+        w->pos += ok;
+        done   += ok;
+    }
+    map_hint(w);
+    return done;
+}
+
+bool audio_wav_map(AudioWav *w)
+{
+    if (!w || !w->f) return false;
+    if (w->map) return true;
+    if (w->pos != 0 || w->dec_n != 0) {
+        fprintf(stderr, "audio_wav: map refused — the file has already been read\n");
+        return false;
+    }
+
+    long page = sysconf(_SC_PAGESIZE);
+    if (page <= 0 || (page & (page - 1)) != 0) return false;
+
+    long   off = w->data_pos & ~(page - 1);
+    size_t len = (size_t)(w->data_pos - off + w->data_bytes);
+    void  *base = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fileno(w->f), off);
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "audio_wav: cannot map %ld data bytes — streaming through "
+                        "stdio instead\n", w->data_bytes);
+        return false;
+    }
+    /* SEQUENTIAL doubles the kernel's own read-ahead and lets it drop pages
+     * behind the cursor early.  The explicit WILLNEED windows are still needed:
+     * read-ahead is triggered BY a fault, and a fault is the wait this avoids. */
+    madvise(base, len, MADV_SEQUENTIAL);
+
+    w->map_base    = base;
+    w->map_len     = len;
+    w->map         = (const uint8_t *)base + (w->data_pos - off);
+    w->page        = page;
+    w->cur         = 0;
+    w->hinted      = 0;
+    w->wrap_hinted = false;
+    w->stalled     = 0;
+    map_hint(w);
+    return true;
 }
 
 void audio_wav_close(AudioWav *w)
 {
     if (!w) return;
+    if (w->map_base) munmap(w->map_base, w->map_len);
+    w->map_base = NULL;
+    w->map      = NULL;
     if (w->f) fclose(w->f);
     w->f = NULL;
+    free(w->blk);
+    free(w->dec);
+    w->blk   = NULL;
+    w->dec   = NULL;
+    w->dec_n = w->dec_at = 0;
+}
+
+long audio_wav_read_raw(AudioWav *w, void *dst, long bytes)
+{
+    if (!w || !w->f || !dst || bytes <= 0) return 0;
+    if (w->map) {
+        long left = w->data_bytes - w->cur;
+        if (bytes > left) bytes = left;
+        if (bytes <= 0) return 0;
+        memcpy(dst, w->map + w->cur, (size_t)bytes);
+        w->cur += bytes;
+        return bytes;
+    }
+    long at = ftell(w->f);
+    if (at < w->data_pos) return 0;
+    long left = w->data_pos + w->data_bytes - at;
+    if (bytes > left) bytes = left;
+    if (bytes <= 0) return 0;
+    return (long)fread(dst, 1, (size_t)bytes, w->f);
+}
+
+/* The ADPCM half of audio_wav_read(): hand out the decoded block, decoding the
+ * next one when it runs out.  Same wrap and short-return rules as PCM. */
+static long read_adpcm(AudioWav *w, int16_t *dst, long frames)
+{
+    long done = 0;
+    while (done < frames) {
+        if (w->pos >= w->frames) {
+            if (!w->loop) break;
+            audio_wav_rewind(w);
+            w->loops++;
+            if (w->pos >= w->frames) break;     /* rewind failed — do not spin */
+        }
+        if (w->dec_at >= w->dec_n && w->map) {
+            long bytes = w->data_bytes - w->cur;
+            if (bytes > w->block_align) bytes = w->block_align;
+            if (map_ready(w, bytes) < bytes) {
+                /* Not arrived: silence, as full, exactly as read_mapped_pcm(). */
+                memset(dst + done, 0, (size_t)(frames - done) * sizeof(int16_t));
+                w->stalled += frames - done;
+                done = frames;
+                break;
+            }
+            w->dec_n  = audio_adpcm_decode_block(w->map + w->cur, bytes,
+                                                 w->channels, w->dec);
+            w->dec_at = 0;
+            w->cur   += bytes;
+            if (w->dec_n <= 0) break;
+        } else if (w->dec_at >= w->dec_n) {
+            long got = (long)fread(w->blk, 1, (size_t)w->block_align, w->f);
+            w->dec_n  = audio_adpcm_decode_block(w->blk, got, w->channels, w->dec);
+            w->dec_at = 0;
+            if (w->dec_n <= 0) break;
+        }
+
+        long want = frames - done;
+        long left = w->frames - w->pos;          /* `fact` cuts the last block */
+        long have = w->dec_n - w->dec_at;
+        if (want > left) want = left;
+        if (want > have) want = have;
+
+        memcpy(dst + done, w->dec + w->dec_at, (size_t)want * sizeof(int16_t));
+        w->dec_at += want;
+        done      += want;
+        w->pos    += want;
+    }
+    if (w->map) map_hint(w);
+    return done;
 }
 
 long audio_wav_read(AudioWav *w, int16_t *dst, long frames)
 {
     if (!w || !w->f || !dst || frames <= 0) return 0;
+    if (w->format == AUDIO_WAV_IMA_ADPCM) return read_adpcm(w, dst, frames);
+    if (w->map) return read_mapped_pcm(w, dst, frames);
 
     long done = 0;
     while (done < frames) {
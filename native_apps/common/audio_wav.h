@@ -20,8 +20,27 @@
  * that a mix-bus sample voice's `AudioVoiceFill` sits on top of, so a 44 s bed
  * costs one `FILE *` and the caller's buffer rather than 3.9 MB of RAM.
  *
- * No mixer, no device, no framebuffer — plain stdio, so it host-tests with no
- * shim at all.
+ * It reads IMA-ADPCM as well as PCM, and that is a SIZE decision, not a quality
+ * one. A 4-bit ADPCM file is a quarter of the 16-bit one, so a bed costs a
+ * quarter of the SD bandwidth while it streams and a clip costs a quarter of the
+ * RAM while it sits in the bank (audio.h → AudioClip). The decode is shifts and
+ * adds over two small tables — no multiply, no divide, which matters on a
+ * Cortex-A8 — and it is BLOCK-local: every block restarts the predictor from its
+ * own header, so a rewind or a clip retrigger costs one block and never a replay
+ * from the top. The files come from `../sounds/wav2adpcm.c`.
+ *
+ * It can MAP instead of read (`audio_wav_map()`), and the streaming voices do.
+ * ⚠️ **The point is not speed, it is where the wait happens.** `fread` runs
+ * inside `audio_mix_render()` — the fill is pulled mid-render — so one slow SD
+ * read stalls every voice and the device with it. Mapped, the kernel is told
+ * what is coming (`posix_fadvise(WILLNEED)` windows ahead of the cursor, and
+ * the file's first window before a loop wraps), and the read asks `mincore()`
+ * whether the bytes have ARRIVED before touching them. If they have not, that
+ * one voice plays silence for the fill and counts it in `stalled`; the render
+ * never takes a page fault it would have to wait on.
+ *
+ * No mixer, no device, no framebuffer — plain stdio and mmap, so it host-tests
+ * with no shim at all.
  */
 
 #ifndef ROOMWIZARD_AUDIO_WAV_H
@@ -31,25 +50,70 @@
 #include <stdint.h>
 #include <stdio.h>
 
+/** `wFormatTag` values the reader accepts. */
+#define AUDIO_WAV_PCM        0x0001
+#define AUDIO_WAV_IMA_ADPCM  0x0011
+
+/** Largest ADPCM `nBlockAlign` accepted.  ⚠️ It sizes the reader's two block
+ *  buffers, so a header claiming 64 KB blocks must be refused rather than
+ *  believed.  ffmpeg writes 1024 × channels, our converter writes 512. */
+#define AUDIO_WAV_ADPCM_MAX_BLOCK   2048
+
+/** Frames one ADPCM block of `bytes` decodes to: the header sample plus two
+ *  nibbles per byte after the 4-byte-per-channel headers — for stereo, whole
+ *  8-byte groups only.  512 mono bytes → 1017 frames. */
+/** Read-ahead granularity of a mapped file, in bytes: one `WILLNEED` hint, and
+ *  the most one `mincore()` probe covers.  64 KB is 0.74 s of 44.1 kHz mono PCM and ~3 s of
+ *  ADPCM, and the read keeps TWO of them hinted ahead of the cursor — far more
+ *  than the 11.4 MB/s card needs to keep up, so a stall means a slow request,
+ *  not a slow card. */
+#define AUDIO_WAV_MAP_WINDOW   (64L * 1024)
+
+#define AUDIO_WAV_ADPCM_BLOCK_FRAMES(bytes, ch) \
+    ((ch) == 1 ? 1 + ((long)(bytes) - 4) * 2 : 1 + (((long)(bytes) - 8) >> 3) * 8)
+
 typedef struct {
     FILE *f;
-    int   rate;         /**< the FILE's rate.  Not resampled — see below.     */
+    int   rate;         /**< the FILE's rate.  Not converted here — see below */
     int   channels;     /**< in the file; reads are averaged down to 1        */
     long  data_pos;     /**< byte offset of the first PCM byte (172, not 44)  */
     long  data_bytes;   /**< clamped to what the file really holds            */
-    long  frames;       /**< data_bytes / (2 * channels)                      */
+    long  frames;       /**< data_bytes / (2 * channels); for ADPCM the block
+                         *   count's worth, capped by the `fact` chunk         */
     long  pos;           /**< frames consumed since open or wrap               */
     bool  loop;         /**< wrap to data_pos at EOF instead of running dry   */
     long  loops;        /**< times it has wrapped — a countable receipt       */
+
+    /* ── ADPCM only; all zero/NULL for PCM ── */
+    int      format;       /**< AUDIO_WAV_PCM or AUDIO_WAV_IMA_ADPCM          */
+    int      block_align;  /**< bytes per compressed block                    */
+    long     block_frames; /**< frames one full block decodes to              */
+    uint8_t *blk;          /**< one compressed block, as read                 */
+    int16_t *dec;          /**< that block decoded, mono                      */
+    long     dec_n;        /**< frames valid in `dec`                         */
+    long     dec_at;       /**< next of them to hand out                      */
+
+    /* ── mapped only (audio_wav_map()); `map` NULL on the stdio path ── */
+    const uint8_t *map;    /**< the data chunk's first byte, in the mapping   */
+    void    *map_base;     /**< what mmap() returned, page-aligned            */
+    size_t   map_len;      /**< and its length                                */
+    long     page;         /**< page size; a power of two                     */
+    long     cur;          /**< byte cursor into the data chunk               */
+    long     hinted;       /**< [0, hinted) has had its WILLNEED              */
+    bool     wrap_hinted;  /**< the first window is hinted for the next wrap  */
+    long     stalled;      /**< frames played as SILENCE because their bytes
+                            *   were not resident — each one an audible gap in
+                            *   this voice, instead of a stall of the whole bus */
 } AudioWav;
 
 /**
  * Open `path` and walk its chunks. Returns true on success.
  *
- * Accepts 16-bit PCM only, which is what `hw:0,0` grants and what every file we
- * have is. ⚠️ **It does NOT resample.** `rate` is reported so the caller can
- * refuse a mismatch loudly; a bed played at the wrong rate is a pitch bug that
- * sounds like a bad recording, so guessing is worse than failing.
+ * Accepts 16-bit PCM, which is what `hw:0,0` grants, and 4-bit IMA-ADPCM in one
+ * or two channels, which decodes to it. ⚠️ **It does NOT resample.** `rate` is
+ * reported so the caller can convert (audio_gen.h's AudioResampler) or refuse
+ * loudly; a bed played at the wrong rate is a pitch bug that sounds like a bad
+ * recording, so guessing is worse than failing.
  *
  * `data_bytes` is clamped to the bytes actually present, so a header that
  * over-claims (a truncated file, or a stream written with a placeholder size)
@@ -67,12 +131,56 @@ bool audio_wav_open(AudioWav *w, const char *path, bool loop);
  */
 long audio_wav_read(AudioWav *w, int16_t *dst, long frames);
 
+/**
+ * Switch an open file to the mapped path: mmap the data chunk, mark it
+ * `MADV_SEQUENTIAL`, and hint the first windows. Call straight after
+ * `audio_wav_open()`, before any read. Returns false — and the file stays on
+ * stdio, working — if the mapping cannot be made.
+ *
+ * ⚠️ A mapped read that finds its bytes not yet resident does NOT wait: it pads
+ * the fill with silence and counts `stalled`. The mix bus ends a voice on a
+ * short fill, so the padding is what keeps the voice alive — and it eats the
+ * voice's declared length, so a one-shot that stalled ends that much early.
+ */
+bool audio_wav_map(AudioWav *w);
+
 /** Rewind to the first PCM frame without reopening. */
 void audio_wav_rewind(AudioWav *w);
 
-/** Close the file. Safe on an already-closed or zeroed struct. */
+/** Close the file, unmap it, and free the ADPCM block buffers. Safe on an
+ *  already-closed or zeroed struct. */
 void audio_wav_close(AudioWav *w);
 
+/**
+ * Read up to `bytes` of the data chunk AS STORED — compressed, for ADPCM — into
+ * `dst`. Returns bytes read. Ignores `loop`, and does not move `pos`: it is for
+ * a caller that keeps the payload and decodes it itself (the clip bank), and it
+ * must not be mixed with `audio_wav_read()` on the same open.
+ */
+long audio_wav_read_raw(AudioWav *w, void *dst, long bytes);
+
+/**
+ * Decode one IMA-ADPCM block (Microsoft's WAVE layout: a 4-byte header per
+ * channel, then 4-byte groups of 8 nibbles per channel, low nibble first) into
+ * `dst` as MONO. Returns frames written, `AUDIO_WAV_ADPCM_BLOCK_FRAMES(bytes,
+ * channels)` — `bytes` may be short of a full block, which is how a file's last
+ * block arrives. Stereo is averaged like the PCM path. Pure: no state survives
+ * the call, which is what lets a clip's voices share one payload.
+ */
+long audio_adpcm_decode_block(const uint8_t *blk, long bytes, int channels,
+                              int16_t *dst);
+
+/**
+ * Encode up to one block of mono `src` into `dst`, whose full size is
+ * `block_align` bytes. Returns bytes written — `block_align` for a full block,
+ * fewer for a short last one. `*index` is the step index carried from the
+ * previous block (start at 0); a block's header stores it so the DECODER needs
+ * no carry. The host converter's half, kept beside the decoder so both read the
+ * one pair of tables.
+ */
+long audio_adpcm_encode_block(const int16_t *src, long frames, int *index,
+                              uint8_t *dst, int block_align);
+
 /**
  * `AudioVoiceFill` adapter: pass `audio_wav_fill` and an `AudioWav *` as `ctx`
  * to `audio_mix_add_sample()`. Kept here rather than in `audio_gen.c` so the
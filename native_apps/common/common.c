@@ -63,12 +63,14 @@ void text_to_uppercase(char *dest, const char *src, size_t max_len) {
     dest[i] = '\0';
 }
 
+// The font's metrics live with the font, in framebuffer.c, so what is measured
+// here is by construction what fb_draw_text() draws.
 int text_measure_width(const char *text, int scale) {
-    return strlen(text) * 6 * scale;  // 5x7 font + 1px spacing = 6px per char
+    return fb_text_width(text, scale);
 }
 
 int text_measure_height(int scale) {
-    return 7 * scale;  // 5x7 font height
+    return fb_text_height(scale);
 }
 
 void text_draw_centered(Framebuffer *fb, int center_x, int center_y,
@@ -298,6 +298,14 @@ bool config_effects_enabled(const Config *cfg) {
     return config_get_bool(cfg, "effects_enabled", true);
 }
 
+bool config_audio_server(const Config *cfg) {
+    return config_get_bool(cfg, "audio_server", false);
+}
+
+bool config_audio_alsa(const Config *cfg) {
+    return strcmp(config_get(cfg, "audio_backend", "oss"), "alsa") == 0;
+}
+
 bool config_led_enabled(const Config *cfg) {
     return config_get_bool(cfg, "led_enabled", true);
 }
@@ -79,6 +79,17 @@ bool config_audio_enabled(const Config *cfg);
 bool config_music_enabled(const Config *cfg);
 bool config_effects_enabled(const Config *cfg);
 
+/* Run the mix bus in a forked server process instead of the game's own loop.
+ * Reads "audio_server" (default: FALSE — the in-loop pump is the measured path).
+ * Read by common/audio.c's audio_init(); see audio_server_start() in audio.h. */
+bool config_audio_server(const Config *cfg);
+
+/* Open the continuous stream on native ALSA (hw:0,0, tinyalsa, mmap) instead of
+ * the OSS shim.  Reads "audio_backend" — "alsa" or "oss" (default: "oss", the
+ * measured path).  A failed ALSA open falls back to OSS.  Read by common/audio.c's
+ * audio_init(); see audio_out_open_alsa() in audio_out.h. */
+bool config_audio_alsa(const Config *cfg);
+
 /* Check if LED effects are disabled. Reads "led_enabled" key (default: true). */
 bool config_led_enabled(const Config *cfg);
 
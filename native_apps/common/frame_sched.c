@@ -0,0 +1,270 @@
+#include "frame_sched.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/* ── The real clock ─────────────────────────────────────────────────────── */
+
+static uint64_t mono_now_ns(void *user)
+{
+    (void)user;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void mono_sleep_until(uint64_t until_ns, void *user)
+{
+    (void)user;
+    struct timespec ts;
+    ts.tv_sec  = (time_t)(until_ns / 1000000000ULL);
+    ts.tv_nsec = (long)(until_ns % 1000000000ULL);
+    /* Absolute, so a signal that cuts the sleep short costs nothing: go back
+     * to the same deadline.  clock_nanosleep() returns the error, not -1. */
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+        ;
+}
+
+/* ── Setup ──────────────────────────────────────────────────────────────── */
+
+void frame_sched_init(FrameSched *fs, uint32_t active_us, uint32_t idle_us)
+{
+    memset(fs, 0, sizeof(*fs));
+    frame_sched_set_rate(fs, active_us, idle_us);
+    fs->max_skip = FRAME_SCHED_MAX_SKIP;
+    frame_sched_set_clock(fs, NULL, NULL, NULL);
+    frame_sched_stats_reset(fs);
+}
+
+void frame_sched_set_rate(FrameSched *fs, uint32_t active_us, uint32_t idle_us)
+{
+    fs->active_ns = (uint64_t)active_us * 1000;
+    fs->idle_ns   = (uint64_t)idle_us * 1000;
+}
+
+void frame_sched_set_audio(FrameSched *fs, FrameAudioFn fn, void *user, long interval_us)
+{
+    fs->audio = fn;
+    fs->audio_user = user;
+    fs->audio_interval_ns = (fn && interval_us > 0) ? (uint64_t)interval_us * 1000 : 0;
+}
+
+void frame_sched_set_skip(FrameSched *fs, int max_skip)
+{
+    fs->max_skip = max_skip < 0 ? 0 : max_skip;
+}
+
+void frame_sched_set_report(FrameSched *fs, uint32_t every_ms, FrameReportFn fn, void *user)
+{
+    fs->report = (every_ms && fn) ? fn : NULL;
+    fs->report_user = user;
+    fs->report_ns = (uint64_t)every_ms * 1000000;
+    fs->report_start_ns = fs->prev_begin_ns;
+}
+
+void frame_sched_set_wait(FrameSched *fs, FrameWaitFn fn, void *user)
+{
+    fs->wait = fn;
+    fs->wait_user = user;
+}
+
+void frame_sched_set_clock(FrameSched *fs, FrameClockFn clock, FrameSleepFn sleep, void *user)
+{
+    fs->clock = clock ? clock : mono_now_ns;
+    fs->sleep = sleep ? sleep : mono_sleep_until;
+    fs->clock_user = user;
+}
+
+/* ── The frame ──────────────────────────────────────────────────────────── */
+
+void frame_sched_begin(FrameSched *fs)
+{
+    uint64_t now = fs->clock(fs->clock_user);
+
+    if (fs->prev_begin_ns == 0) {
+        /* First frame: its slot starts now, and so does the report window. */
+        fs->deadline_ns = now;
+        fs->report_start_ns = now;
+    } else {
+        uint64_t dt = now - fs->prev_begin_ns;
+        uint32_t ms = (uint32_t)(dt / 1000000);
+        fs->hist[ms < FRAME_SCHED_HIST_BINS ? ms : FRAME_SCHED_HIST_BINS - 1]++;
+        fs->frames++;
+        fs->sum_ns += dt;
+        if (dt < fs->min_ns) fs->min_ns = dt;
+        if (dt > fs->max_ns) fs->max_ns = dt;
+    }
+    fs->prev_begin_ns = now;
+    fs->begin_ns = now;
+    fs->wants_active = false;
+
+    if (fs->report && fs->frames && now - fs->report_start_ns >= fs->report_ns) {
+        FrameStats st;
+        frame_sched_stats(fs, &st);
+        fs->report(&st, fs->report_user);
+        frame_sched_stats_reset(fs);
+        fs->report_start_ns = now;
+    }
+}
+
+bool frame_sched_render_due(FrameSched *fs)
+{
+    fs->wants_active = true;
+    if (fs->behind && fs->skip_run < fs->max_skip) {
+        fs->skip_run++;
+        fs->skipped++;
+        return false;
+    }
+    fs->skip_run = 0;
+    fs->rendered++;
+    return true;
+}
+
+void frame_sched_active(FrameSched *fs)
+{
+    fs->wants_active = true;
+}
+
+/* Sleep to `until`, or through the wait hook on an idle frame.  True when
+ * input cut it short: the frame ends now, and the next slot starts from here
+ * rather than from a deadline the wake has made meaningless. */
+static bool wait_until(FrameSched *fs, uint64_t until, bool wake)
+{
+    if (!wake) {
+        fs->sleep(until, fs->clock_user);
+        return false;
+    }
+    if (!fs->wait(until, fs->wait_user)) return false;
+    fs->woken++;
+    fs->deadline_ns = fs->clock(fs->clock_user);
+    return true;
+}
+
+void frame_sched_end(FrameSched *fs)
+{
+    bool active = fs->wants_active;
+    if (fs->audio && fs->audio(fs->audio_user))
+        active = true;
+
+    uint64_t now = fs->clock(fs->clock_user);
+    uint64_t work = now - fs->begin_ns;
+    fs->work_sum_ns += work;
+    fs->work_frames++;
+    if (work > fs->work_max_ns) fs->work_max_ns = work;
+
+    uint64_t period = active ? fs->active_ns : fs->idle_ns;
+    uint64_t next = fs->deadline_ns + period;
+
+    if (now >= next) {
+        /* Overrun.  Up to a period late, keep the deadline: the next frame
+         * starts at once and the loop catches up.  Later than that, drop the
+         * missed slots — bursting through them is a fast-forward, not a
+         * recovery. */
+        fs->overruns++;
+        fs->behind = true;
+        fs->deadline_ns = (now - next >= period) ? now : next;
+        return;
+    }
+    fs->behind = false;
+    fs->deadline_ns = next;
+
+    bool wake = !active && fs->wait;
+    while (fs->audio_interval_ns && next - now > fs->audio_interval_ns) {
+        if (wait_until(fs, now + fs->audio_interval_ns, wake)) return;
+        fs->audio(fs->audio_user);
+        now = fs->clock(fs->clock_user);
+        if (now >= next) return;
+    }
+    wait_until(fs, next, wake);
+}
+
+void frame_sched_resync(FrameSched *fs)
+{
+    fs->prev_begin_ns = 0;
+    fs->behind = false;
+    fs->skip_run = 0;
+}
+
+void frame_sched_tick(FrameSched *fs, const FrameSlots *slots, void *user)
+{
+    frame_sched_begin(fs);
+    bool dirty = (slots->update && slots->update(user)) || fs->pending;
+    if (dirty) {
+        if (frame_sched_render_due(fs)) {
+            if (slots->render) slots->render(user);
+            fs->pending = false;
+        } else {
+            fs->pending = true;
+        }
+    }
+    frame_sched_end(fs);
+}
+
+/* ── Statistics ─────────────────────────────────────────────────────────── */
+
+void frame_sched_stats(const FrameSched *fs, FrameStats *out)
+{
+    memset(out, 0, sizeof(*out));
+    out->rendered = fs->rendered;
+    out->skipped  = fs->skipped;
+    out->overruns = fs->overruns;
+    out->woken    = fs->woken;
+    if (fs->work_frames) {
+        out->work_avg_us = (uint32_t)(fs->work_sum_ns / fs->work_frames / 1000);
+        out->work_max_us = (uint32_t)(fs->work_max_ns / 1000);
+    }
+    if (!fs->frames) return;
+
+    out->frames = fs->frames;
+    out->min_us = (uint32_t)(fs->min_ns / 1000);
+    out->max_us = (uint32_t)(fs->max_ns / 1000);
+    out->avg_us = (uint32_t)(fs->sum_ns / fs->frames / 1000);
+
+    /* The bin holding the ceil(0.99 n)-th frame time; its upper edge, but
+     * never past the slowest frame actually seen. */
+    uint32_t target = fs->frames - fs->frames / 100;
+    uint32_t cum = 0;
+    int b = 0;
+    for (; b < FRAME_SCHED_HIST_BINS - 1; b++) {
+        cum += fs->hist[b];
+        if (cum >= target) break;
+    }
+    uint32_t edge = (uint32_t)(b + 1) * 1000;
+    out->p99_us = edge < out->max_us ? edge : out->max_us;
+}
+
+void frame_sched_stats_reset(FrameSched *fs)
+{
+    fs->frames = fs->rendered = fs->skipped = fs->overruns = fs->woken = 0;
+    fs->sum_ns = fs->work_sum_ns = fs->work_frames = 0;
+    fs->max_ns = fs->work_max_ns = 0;
+    fs->min_ns = UINT64_MAX;
+    memset(fs->hist, 0, sizeof(fs->hist));
+}
+
+char *frame_stats_format(const FrameStats *st, char *buf, size_t size)
+{
+#define MS(us) (unsigned)((us) / 1000), (unsigned)((us) % 1000 / 100)
+    snprintf(buf, size,
+             "%u frames, %u skipped, %u overruns; "
+             "frame min/avg/p99/max %u.%u/%u.%u/%u.%u/%u.%u ms; "
+             "work avg/max %u.%u/%u.%u ms",
+             (unsigned)st->frames, (unsigned)st->skipped, (unsigned)st->overruns,
+             MS(st->min_us), MS(st->avg_us), MS(st->p99_us), MS(st->max_us),
+             MS(st->work_avg_us), MS(st->work_max_us));
+#undef MS
+    size_t len = strlen(buf);
+    if (st->woken && len < size)
+        snprintf(buf + len, size - len, "; %u woken by input", (unsigned)st->woken);
+    return buf;
+}
+
+void frame_stats_print(const FrameStats *st, void *user)
+{
+    char line[200];
+    printf("%s: %s\n", user ? (const char *)user : "frame",
+           frame_stats_format(st, line, sizeof(line)));
+    fflush(stdout);
+}
@@ -0,0 +1,222 @@
+#ifndef FRAME_SCHED_H
+#define FRAME_SCHED_H
+
+/**
+ * frame_sched — absolute-deadline pacing for every native app's main loop.
+ *
+ * Every loop used to end in
+ *
+ *     usleep(needs_redraw || audio_pump_active(&audio)
+ *            ? FRAME_DELAY_ACTIVE_US : FRAME_DELAY_IDLE_US);
+ *
+ * which sleeps a full period ON TOP of the frame's work: a 12 ms frame at
+ * "30 fps" is really 45 ms, 22 fps, and the rate moves with the load.  This
+ * file keeps the same two periods but sleeps to a DEADLINE
+ * (`clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME)`), so the work is inside
+ * the period instead of added to it, and a late frame is caught up instead of
+ * compounded.
+ *
+ * ── THE SHAPE OF A LOOP ──────────────────────────────────────────────────────
+ *
+ *     FrameSched sched;
+ *     frame_sched_init(&sched, FRAME_DELAY_ACTIVE_US, FRAME_DELAY_IDLE_US);
+ *     frame_sched_set_audio(&sched, audio_pump_slot, &audio,
+ *                           audio_cont_service_interval_us(&audio) / 2);
+ *     while (running) {
+ *         frame_sched_begin(&sched);
+ *         ...input, update...                          (the UPDATE slot)
+ *         if (needs_redraw && frame_sched_render_due(&sched)) {
+ *             draw(); fb_swap(&fb);                    (the RENDER slot)
+ *             needs_redraw = false;
+ *         }
+ *         frame_sched_end(&sched);                     (the AUDIO slot + the wait)
+ *     }
+ *
+ * The slots are the loop's own code rather than callbacks, because every game
+ * already has a hand-written loop with early `continue`s and screen switches
+ * that would not survive being cut into three functions.  Only the audio slot
+ * is a callback — it is the one the scheduler must be able to call from INSIDE
+ * the wait.  `frame_sched_tick()` is the callback form of the same frame for a
+ * loop that is simple enough to use it.
+ *
+ * ── THE PACE ─────────────────────────────────────────────────────────────────
+ *
+ * A frame is ACTIVE — the short period — if it asked `frame_sched_render_due()`
+ * (it had something to draw, drawn or skipped) or if the audio slot returned
+ * true.  That is exactly the old `needs_redraw || audio_pump_active()`; the
+ * audio half stays in the decision for the reason every game's comment gave,
+ * even though the sliced wait below already keeps the stream fed.
+ *
+ * ── THE AUDIO SLOT ───────────────────────────────────────────────────────────
+ *
+ * It runs once per frame in `frame_sched_end()`, and again every
+ * `interval_us` while waiting, so a long period (the idle 100 ms, or snake's
+ * 150 ms step) is cut into service-sized pieces rather than shortened — the
+ * same thing snake used to do by hand.  0 means once per frame only.
+ *
+ * ── FRAME SKIP ───────────────────────────────────────────────────────────────
+ *
+ * A frame whose work ran past its deadline is an OVERRUN.  The next
+ * `frame_sched_render_due()` then returns false — update and audio still run,
+ * the draw does not, and the caller's dirty flag stays set — for at most
+ * `max_skip` frames in a row (FRAME_SCHED_MAX_SKIP by default), so a game that
+ * cannot keep up slows its picture before it slows its clock and still shows
+ * one frame in `max_skip + 1`.  A frame more than one period late drops the
+ * missed deadlines instead of bursting through them.
+ *
+ * ── WAKING ON INPUT ──────────────────────────────────────────────────────────
+ *
+ * `frame_sched_set_wait()` replaces the sleep of an IDLE frame with a wait that
+ * may end early — common/input_hub.h's, which returns when a touch or pad fd
+ * becomes readable.  The frame then ends at once, the next one starts its slot
+ * from that moment, and its poll finds the event waiting.  ⚠️ Idle frames only:
+ * an active frame is already at the short period, and letting a drag's 100 Hz
+ * of events cut it would make input, not the period, set the render rate.
+ *
+ * ── STATISTICS ───────────────────────────────────────────────────────────────
+ *
+ * Frame time is begin-to-begin: the interval the panel actually saw.  Work
+ * time is begin-to-end, before the wait: the headroom.  Both are kept for a
+ * window that `frame_sched_stats()` reads and `frame_sched_stats_reset()`
+ * clears; p99 comes from a 1 ms histogram, so it is an upper bound good to the
+ * millisecond.  `frame_sched_set_report()` hands a closed window to a callback
+ * every `every_ms` — `frame_stats_print()` for stdout, or a wrapper around
+ * LOG_INFO for an app with a Logger (the scheduler does not link logger.o).
+ *
+ * ── CLOCK ────────────────────────────────────────────────────────────────────
+ *
+ * No pthread, no timerfd: one `clock_gettime()` and one `clock_nanosleep()`
+ * per wake, both plain libc on this static build (touch_raw already reads
+ * CLOCK_MONOTONIC).  `frame_sched_set_clock()` replaces both so the policy is
+ * host-testable without sleeping (`tests/frame_sched_test.c`).
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/** Consecutive renders an overrunning loop may drop; 0 disables skipping. */
+#define FRAME_SCHED_MAX_SKIP     2
+
+/** Histogram bins, 1 ms each; the last one collects everything slower. */
+#define FRAME_SCHED_HIST_BINS    256
+
+/** One window of timings.  Times in microseconds; zeros when frames == 0. */
+typedef struct {
+    uint32_t frames;        /* frames begun after the first in this window     */
+    uint32_t rendered;      /* render_due() said yes                           */
+    uint32_t skipped;       /* render_due() said no: dropped for an overrun    */
+    uint32_t overruns;      /* frames whose work ran past their deadline       */
+    uint32_t min_us;        /* frame time, begin to begin                      */
+    uint32_t avg_us;
+    uint32_t p99_us;        /* histogram upper edge: good to 1 ms              */
+    uint32_t max_us;
+    uint32_t work_avg_us;   /* begin to end, before the wait                   */
+    uint32_t work_max_us;
+    uint32_t woken;         /* idle waits cut short by input                   */
+} FrameStats;
+
+typedef bool (*FrameAudioFn)(void *user);                 /* true: keep active pace */
+typedef void (*FrameReportFn)(const FrameStats *stats, void *user);
+typedef uint64_t (*FrameClockFn)(void *user);              /* monotonic ns */
+typedef void (*FrameSleepFn)(uint64_t until_ns, void *user);
+typedef bool (*FrameWaitFn)(uint64_t until_ns, void *user); /* true: woken early */
+
+/** Callback form of one frame, for frame_sched_tick(). */
+typedef struct {
+    bool (*update)(void *user);   /* true: something to draw (the dirty flag)  */
+    void (*render)(void *user);
+} FrameSlots;
+
+typedef struct {
+    uint64_t active_ns, idle_ns;
+    uint64_t deadline_ns;         /* start of the current frame's slot          */
+    uint64_t begin_ns;            /* this frame's frame_sched_begin()            */
+    uint64_t prev_begin_ns;       /* 0 before the first frame                    */
+    bool     wants_active;        /* render_due() asked this frame               */
+    bool     behind;              /* the last frame overran                      */
+    int      max_skip, skip_run;
+    bool     pending;             /* tick(): a skipped render still owed         */
+
+    FrameAudioFn  audio;
+    void         *audio_user;
+    uint64_t      audio_interval_ns;
+
+    FrameReportFn report;
+    void         *report_user;
+    uint64_t      report_ns, report_start_ns;
+
+    FrameClockFn  clock;
+    FrameSleepFn  sleep;
+    void         *clock_user;
+
+    FrameWaitFn   wait;               /* idle frames only; NULL = sleep        */
+    void         *wait_user;
+
+    /* the window */
+    uint32_t frames, rendered, skipped, overruns, woken;
+    uint64_t sum_ns, work_sum_ns, work_frames;
+    uint64_t min_ns, max_ns, work_max_ns;
+    uint32_t hist[FRAME_SCHED_HIST_BINS];
+} FrameSched;
+
+/** Periods in µs; the first frame's deadline is set by its frame_sched_begin(). */
+void frame_sched_init(FrameSched *fs, uint32_t active_us, uint32_t idle_us);
+
+/** Change the periods — snake's step interval is its active AND idle period
+ *  while playing.  Takes effect at the next frame_sched_end(). */
+void frame_sched_set_rate(FrameSched *fs, uint32_t active_us, uint32_t idle_us);
+
+/** The audio slot: called once per frame_sched_end() and every interval_us of
+ *  the wait (0 = once per frame).  NULL removes it. */
+void frame_sched_set_audio(FrameSched *fs, FrameAudioFn fn, void *user, long interval_us);
+
+void frame_sched_set_skip(FrameSched *fs, int max_skip);
+
+/** Hand each window to fn every every_ms, then start a new one.  0/NULL = off. */
+void frame_sched_set_report(FrameSched *fs, uint32_t every_ms, FrameReportFn fn, void *user);
+
+/** Replace the clock and the sleep (tests).  NULL restores the real ones. */
+void frame_sched_set_clock(FrameSched *fs, FrameClockFn clock, FrameSleepFn sleep, void *user);
+
+/** The wait of an idle frame: fn sleeps to the deadline or returns true early
+ *  when input arrives (input_hub_wait()).  NULL restores the plain sleep. */
+void frame_sched_set_wait(FrameSched *fs, FrameWaitFn fn, void *user);
+
+/** Start a frame: stamps it, and records the previous one's frame time. */
+void frame_sched_begin(FrameSched *fs);
+
+/** Ask before drawing.  Marks the frame active; false means drop this render
+ *  (the loop is behind) and keep the dirty flag for the next frame. */
+bool frame_sched_render_due(FrameSched *fs);
+
+/** Mark this frame active without a render — a loop that must poll at the
+ *  short period with nothing to draw (the launcher's post-launch cooldown). */
+void frame_sched_active(FrameSched *fs);
+
+/** Run the audio slot, then wait for the frame's deadline, servicing audio in
+ *  slices on the way. */
+void frame_sched_end(FrameSched *fs);
+
+/** Forget the frame in progress: the next frame_sched_begin() starts a fresh
+ *  slot and records no frame time.  For a loop that blocked on purpose — the
+ *  launcher waiting on a child — so that wait is neither an overrun nor a
+ *  60-second "frame" in the statistics. */
+void frame_sched_resync(FrameSched *fs);
+
+/** One whole frame from callbacks: begin, update, render if due (a skipped
+ *  render is owed and retried next frame), end. */
+void frame_sched_tick(FrameSched *fs, const FrameSlots *slots, void *user);
+
+void frame_sched_stats(const FrameSched *fs, FrameStats *out);
+void frame_sched_stats_reset(FrameSched *fs);
+
+/** "300 frames, 12 skipped, 3 overruns; frame min/avg/p99/max 32.9/33.4/36.0/41.2
+ *  ms; work avg/max 8.1/20.3 ms" — for a Logger or a printf, with "; 4 woken by
+ *  input" appended when a wait hook cut any idle frame short.  Returns buf. */
+char *frame_stats_format(const FrameStats *st, char *buf, size_t size);
+
+/** A FrameReportFn that prints one line to stdout, prefixed with (const char *)user. */
+void frame_stats_print(const FrameStats *st, void *user);
+
+#endif /* FRAME_SCHED_H */
@@ -1,5 +1,6 @@
 #include "framebuffer.h"
 #include "hardware.h"
+#include "input_lat.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -8,6 +9,9 @@
 #include <sys/mman.h>
 #include <sys/ioctl.h>
 #include <linux/fb.h>
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
 
 // Runtime bezel margins (pixels hidden by the plastic bezel)
 int screen_bezel_top    = FB_BEZEL_TOP_DEFAULT;
@@ -123,10 +127,77 @@ static int fb_apply_viewport(Framebuffer *fb, int panel_w, int panel_h) {
 // Paint the whole panel black, so the bezel bands are clean and nothing from a
 // previously running app survives outside the logical surface.
 static void fb_black_panel(Framebuffer *fb) {
-    if (fb->buffer != MAP_FAILED && fb->buffer != NULL)
+    if (fb->page_flip)
+        memset(fb->map, 0, fb->map_size);   // both pages: either may be shown next
+    else if (fb->buffer != MAP_FAILED && fb->buffer != NULL)
         memset(fb->buffer, 0, fb->screen_size);
 }
 
+// ---------------------------------------------------------------------------
+// Page flipping — see framebuffer.h. The request is file-static, like the bpp
+// that fb_set_bpp() leaves on the device, because it has to be known before
+// fb_init() sizes the mapping.
+// ---------------------------------------------------------------------------
+
+#ifndef FBIO_WAITFORVSYNC
+#define FBIO_WAITFORVSYNC _IOW('F', 0x20, uint32_t)
+#endif
+
+static bool flip_requested = false;
+static bool flip_vsync_requested = false;
+
+void fb_request_page_flip(bool on, bool wait_vsync) {
+    flip_requested = on;
+    flip_vsync_requested = wait_vsync;
+}
+
+// The hidden page can only BE the back buffer if the logical surface is whole,
+// unpadded panel rows: back_buffer is indexed y * width + x everywhere (here,
+// ScummVM, vnc_client), so a left/right bezel or a wide line_length would need
+// a stride nothing else knows about. A top/bottom bezel is fine — it is just a
+// row offset into the page. Portrait is out because the rotation is the copy.
+static bool fb_flip_geometry_ok(const Framebuffer *fb) {
+    return !fb->portrait_mode && fb->view_x == 0 &&
+           fb->width == fb->phys_width &&
+           fb->line_length == fb->width * fb->bytes_per_pixel;
+}
+
+static inline uint8_t *fb_page(Framebuffer *fb, int page) {
+    return (uint8_t *)fb->map + (size_t)page * fb->screen_size;
+}
+
+// buffer = the page on screen, back_buffer = the logical rectangle of the other.
+static void fb_flip_point(Framebuffer *fb) {
+    fb->buffer = (uint32_t *)fb_page(fb, fb->shown_page);
+    fb->back_buffer = (uint32_t *)(fb_page(fb, 1 - fb->shown_page) +
+                                   (size_t)fb->view_y * fb->line_length);
+}
+
+static int fb_pan_to(Framebuffer *fb, int page) {
+    struct fb_var_screeninfo vinfo;
+    if (ioctl(fb->fd, FBIOGET_VSCREENINFO, &vinfo) == -1) return -1;
+    vinfo.xoffset = 0;
+    vinfo.yoffset = (uint32_t)page * fb->phys_height;
+    return ioctl(fb->fd, FBIOPAN_DISPLAY, &vinfo);
+}
+
+// Leave flipping for the copying swap: show page 0, give the app a malloc'd back
+// buffer with the current frame in it. Used when the geometry stops qualifying
+// (fb_set_bezel) or a pan fails. False only if the malloc does.
+static bool fb_flip_leave(Framebuffer *fb) {
+    uint32_t *bb = (uint32_t *)malloc(fb->back_buffer_size);
+    if (bb == NULL) return false;
+    memcpy(bb, fb->back_buffer, fb->back_buffer_size);
+    if (fb->shown_page != 0)
+        memcpy(fb_page(fb, 0), fb_page(fb, fb->shown_page), fb->screen_size);
+    fb_pan_to(fb, 0);
+    fb->shown_page = 0;
+    fb->buffer = (uint32_t *)fb_page(fb, 0);
+    fb->back_buffer = bb;
+    fb->page_flip = false;
+    return true;
+}
+
 int fb_set_bezel(Framebuffer *fb, int top, int bottom, int left, int right) {
     int old_t = screen_bezel_top,  old_b = screen_bezel_bottom;
     int old_l = screen_bezel_left, old_r = screen_bezel_right;
@@ -149,7 +220,30 @@ int fb_set_bezel(Framebuffer *fb, int top, int bottom, int left, int right) {
     }
 
     size_t new_size = (size_t)fb->width * fb->height * fb->bytes_per_pixel;
-    if (new_size != fb->back_buffer_size) {
+    if (fb->page_flip) {
+        // The back buffer is a window into the mapping, never realloc'd. Move
+        // the window if the new margins still allow flipping; otherwise drop to
+        // the copying swap first and fall through to the normal resize.
+        if (fb_flip_geometry_ok(fb)) {
+            fb->back_buffer_size = new_size;
+            fb_flip_point(fb);
+        } else {
+            printf("Framebuffer: bezel L=%d R=%d leaves no whole rows — page flipping off\n",
+                   left, right);
+            // Still at the OLD size here, so the copy in fb_flip_leave() stays
+            // inside the old window; the resize below then reallocs as usual.
+            if (!fb_flip_leave(fb)) {
+                // Cannot leave and cannot stay: restore the old geometry.
+                screen_bezel_top    = old_t;
+                screen_bezel_bottom = old_b;
+                screen_bezel_left   = old_l;
+                screen_bezel_right  = old_r;
+                fb_apply_viewport(fb, panel_w, panel_h);
+                return -1;
+            }
+        }
+    }
+    if (!fb->page_flip && new_size != fb->back_buffer_size) {
         uint32_t *nb = (uint32_t *)realloc(fb->back_buffer, new_size);
         if (nb == NULL) {
             screen_bezel_top    = old_t;
@@ -164,6 +258,10 @@ int fb_set_bezel(Framebuffer *fb, int top, int bottom, int left, int right) {
     }
     memset(fb->back_buffer, 0, fb->back_buffer_size);
     fb_black_panel(fb);
+    // New geometry: every damage rectangle is stale, and the panel was just
+    // blacked, so the next swap has to be a full one.
+    fb->damage_full = true;
+    fb->damage_count = 0;
     return 0;
 }
 
@@ -344,6 +442,169 @@ static inline void *fb_target(Framebuffer *fb) {
     return fb->double_buffering ? (void *)fb->back_buffer : (void *)fb->buffer;
 }
 
+// ---------------------------------------------------------------------------
+// Span layer
+//
+// Every FILLED primitive is a set of horizontal runs, so they all reduce to
+// "clip once, then fill whole rows". fb_draw_pixel() redoes the bounds test, the
+// fb_target() lookup and the bpp branch per pixel, and a full-screen background
+// through it was a measurable slice of the frame on a 600 MHz part with no GPU.
+// Below, the clip happens once per primitive (or once per row for the round
+// ones), the depth is chosen once per run, and the run itself is a plain store
+// loop — NEON q-register stores where the compiler is given -mfpu=neon (the same
+// #ifdef __ARM_NEON shape as ScummVM's blit), scalar everywhere else, including
+// the host tests.
+//
+// Outlines, lines and text still plot pixel by pixel (fb_put_pixel()): they are
+// a few hundred pixels, not a few hundred thousand.
+// ---------------------------------------------------------------------------
+
+static void fb_span_fill16(uint16_t *p, int n, uint16_t c) {
+#ifdef __ARM_NEON
+    uint16x8_t v = vdupq_n_u16(c);
+    for (; n >= 16; n -= 16, p += 16) {
+        vst1q_u16(p, v);
+        vst1q_u16(p + 8, v);
+    }
+#endif
+    while (n-- > 0) *p++ = c;
+}
+
+static void fb_span_fill32(uint32_t *p, int n, uint32_t c) {
+#ifdef __ARM_NEON
+    uint32x4_t v = vdupq_n_u32(c);
+    for (; n >= 8; n -= 8, p += 8) {
+        vst1q_u32(p, v);
+        vst1q_u32(p + 4, v);
+    }
+#endif
+    while (n-- > 0) *p++ = c;
+}
+
+// Fill n pixels starting at pixel index idx. No clipping: the caller has done it.
+static inline void fb_span_fill(void *target, size_t idx, int n, uint32_t color, bool is16) {
+    if (is16) fb_span_fill16((uint16_t *)target + idx, n, fb_pack565(color));
+    else      fb_span_fill32((uint32_t *)target + idx, n, color);
+}
+
+// Clip the rectangle (x, y, w, h) — already in surface coordinates, i.e. with
+// the draw offset applied — to the logical surface. False when nothing is left.
+static inline bool fb_clip_rect(const Framebuffer *fb, int *x, int *y, int *w, int *h) {
+    int x0 = *x, y0 = *y, x1 = *x + *w, y1 = *y + *h;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > (int)fb->width)  x1 = (int)fb->width;
+    if (y1 > (int)fb->height) y1 = (int)fb->height;
+    if (x0 >= x1 || y0 >= y1) return false;
+    *x = x0; *y = y0; *w = x1 - x0; *h = y1 - y0;
+    return true;
+}
+
+// Fill the inclusive run x0..x1 on row y, clipped. Surface coordinates.
+static inline void fb_hspan(Framebuffer *fb, int x0, int x1, int y, uint32_t color) {
+    if (y < 0 || y >= (int)fb->height) return;
+    if (x0 < 0) x0 = 0;
+    if (x1 >= (int)fb->width) x1 = (int)fb->width - 1;
+    if (x0 > x1) return;
+    fb_span_fill(fb_target(fb), (size_t)y * fb->width + x0, x1 - x0 + 1, color,
+                 FB_IS_16BPP(fb));
+}
+
+// Half-width of a filled circle of radius r on the row d away from its centre:
+// the largest x with x*x + d*d <= r*r, which is exactly the set the old
+// per-pixel test accepted. -1 when the row misses the circle. The loop is at
+// most r steps and runs once per row, not once per pixel.
+static inline int fb_circle_half_width(int r, int d) {
+    int rr = r * r - d * d;
+    if (rr < 0) return -1;
+    int x = r;
+    while (x * x > rr) x--;
+    return x;
+}
+
+// ---------------------------------------------------------------------------
+// Damage list
+//
+// Each primitive reports ONE rectangle — its clipped bounding box — not one per
+// pixel, so the cost with tracking on is a handful of compares per primitive
+// and with it off a single branch. The list is kept disjoint: a new rectangle
+// swallows every entry it overlaps (and the grown union may overlap more, hence
+// the restart). When the list is full, the entry whose union with the newcomer
+// grows least is merged into it. All of it is multiplies and compares — no
+// divide, which the Cortex-A8 does not have.
+// ---------------------------------------------------------------------------
+
+static inline bool fb_rect_overlaps(const FbRect *a, const FbRect *b) {
+    return a->x < b->x + b->w && b->x < a->x + a->w &&
+           a->y < b->y + b->h && b->y < a->y + a->h;
+}
+
+static inline FbRect fb_rect_union(const FbRect *a, const FbRect *b) {
+    int x0 = a->x < b->x ? a->x : b->x;
+    int y0 = a->y < b->y ? a->y : b->y;
+    int x1 = a->x + a->w > b->x + b->w ? a->x + a->w : b->x + b->w;
+    int y1 = a->y + a->h > b->y + b->h ? a->y + a->h : b->y + b->h;
+    FbRect u = { x0, y0, x1 - x0, y1 - y0 };
+    return u;
+}
+
+static inline void fb_damage_remove(Framebuffer *fb, int i) {
+    fb->damage[i] = fb->damage[--fb->damage_count];
+}
+
+// Record (x, y, w, h) in SURFACE coordinates — draw offset already applied.
+static void fb_damage(Framebuffer *fb, int x, int y, int w, int h) {
+    if (!fb->damage_tracking || fb->damage_full) return;
+    if (!fb_clip_rect(fb, &x, &y, &w, &h)) return;
+    FbRect r = { x, y, w, h };
+
+    for (;;) {
+        for (int i = 0; i < fb->damage_count; ) {
+            if (fb_rect_overlaps(&fb->damage[i], &r)) {
+                r = fb_rect_union(&fb->damage[i], &r);
+                fb_damage_remove(fb, i);
+                i = 0;
+            } else {
+                i++;
+            }
+        }
+        if (fb->damage_count < FB_DAMAGE_MAX) break;
+
+        int best = 0;
+        long best_growth = -1;
+        for (int i = 0; i < fb->damage_count; i++) {
+            FbRect u = fb_rect_union(&fb->damage[i], &r);
+            long growth = (long)u.w * u.h - (long)fb->damage[i].w * fb->damage[i].h;
+            if (best_growth < 0 || growth < best_growth) {
+                best = i;
+                best_growth = growth;
+            }
+        }
+        r = fb_rect_union(&fb->damage[best], &r);
+        fb_damage_remove(fb, best);
+        // The merged rectangle may now overlap others: absorb them too.
+    }
+    fb->damage[fb->damage_count++] = r;
+}
+
+static inline void fb_damage_all(Framebuffer *fb) {
+    fb->damage_full = true;
+    fb->damage_count = 0;
+}
+
+void fb_set_damage_tracking(Framebuffer *fb, bool on) {
+    fb->damage_tracking = on;
+    fb_damage_all(fb);
+}
+
+void fb_mark_dirty(Framebuffer *fb, int x, int y, int w, int h) {
+    fb_damage(fb, x, y, w, h);
+}
+
+void fb_mark_all_dirty(Framebuffer *fb) {
+    fb_damage_all(fb);
+}
+
 int fb_init(Framebuffer *fb, const char *device) {
     struct fb_var_screeninfo vinfo;
     struct fb_fix_screeninfo finfo;
@@ -441,82 +702,327 @@ int fb_init(Framebuffer *fb, const char *device) {
     }
 
     fb->line_length = finfo.line_length;
-    fb->screen_size = fb->line_length * fb->phys_height;  // Physical size for mmap
+    fb->screen_size = fb->line_length * fb->phys_height;  // One page: the panel
     fb->back_buffer_size = (size_t)fb->width * fb->height * fb->bytes_per_pixel;
 
-    fb->buffer = (uint32_t *)mmap(0, fb->screen_size, PROT_READ | PROT_WRITE, MAP_SHARED, fb->fd, 0);
-    if (fb->buffer == MAP_FAILED) {
+    // A flipping app that died while showing its second page leaves the panel
+    // panned there, and this process is about to draw into page 0. Always
+    // start from the top of the virtual screen.
+    if (vinfo.xoffset != 0 || vinfo.yoffset != 0) {
+        vinfo.xoffset = 0;
+        vinfo.yoffset = 0;
+        ioctl(fb->fd, FBIOPAN_DISPLAY, &vinfo);
+    }
+
+    fb->page_flip = false;
+    fb->shown_page = 0;
+    fb->flip_vsync = flip_vsync_requested;
+    if (flip_requested) {
+        const char *why = NULL;
+        if (!fb_flip_geometry_ok(fb)) {
+            why = fb->portrait_mode ? "portrait mode rotates in fb_swap"
+                                    : "the visible rectangle is not whole panel rows";
+        } else {
+            struct fb_var_screeninfo want = vinfo;
+            want.yres_virtual = vinfo.yres * 2;
+            want.yoffset = 0;
+            if (ioctl(fb->fd, FBIOPUT_VSCREENINFO, &want) == -1 ||
+                ioctl(fb->fd, FBIOGET_VSCREENINFO, &want) == -1 ||
+                want.yres_virtual < vinfo.yres * 2) {
+                why = "the driver refused a double-height virtual screen";
+            } else if (ioctl(fb->fd, FBIOGET_FSCREENINFO, &finfo) == -1 ||
+                       finfo.line_length != fb->line_length ||
+                       finfo.smem_len < 2 * fb->screen_size) {
+                why = "the driver's memory does not hold two pages";
+            } else {
+                fb->page_flip = true;
+            }
+            // The driver may have taken the doubled virtual height and only then
+            // failed a later check.  The copy path does not need it, and the
+            // next app would inherit it, so put the geometry back as it was.
+            if (!fb->page_flip)
+                ioctl(fb->fd, FBIOPUT_VSCREENINFO, &vinfo);
+        }
+        if (why)
+            printf("Framebuffer: page flipping requested but %s — copying fb_swap\n", why);
+    }
+
+    fb->map_size = fb->page_flip ? 2 * fb->screen_size : fb->screen_size;
+    fb->map = mmap(0, fb->map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fb->fd, 0);
+    if (fb->map == MAP_FAILED) {
         perror("Error mapping framebuffer device to memory");
         close(fb->fd);
         return -1;
     }
+    fb->buffer = (uint32_t *)fb->map;
 
-    // Allocate back buffer for double buffering
-    fb->back_buffer = (uint32_t *)malloc(fb->back_buffer_size);
-    if (fb->back_buffer == NULL) {
-        perror("Error allocating back buffer");
-        munmap(fb->buffer, fb->screen_size);
-        close(fb->fd);
-        return -1;
+    if (fb->page_flip) {
+        // Draw straight into the hidden page; fb_swap() pans instead of copying.
+        fb_flip_point(fb);
+    } else {
+        // Allocate back buffer for double buffering
+        fb->back_buffer = (uint32_t *)malloc(fb->back_buffer_size);
+        if (fb->back_buffer == NULL) {
+            perror("Error allocating back buffer");
+            munmap(fb->map, fb->map_size);
+            close(fb->fd);
+            return -1;
+        }
     }
     fb->double_buffering = true;
 
     fb->draw_offset_x = 0;
     fb->draw_offset_y = 0;
 
+    fb->damage_tracking = false;
+    fb->damage_full = true;
+    fb->damage_count = 0;
+
     // Black the whole panel once: clears the bezel bands and any leftovers.
     fb_black_panel(fb);
 
-    printf("Framebuffer initialized: %dx%d logical at (%d,%d) on a %dx%d panel%s, %d bpp\n",
+    printf("Framebuffer initialized: %dx%d logical at (%d,%d) on a %dx%d panel%s, %d bpp%s\n",
            fb->width, fb->height, fb->view_x, fb->view_y, panel_w, panel_h,
-           fb->portrait_mode ? " [portrait]" : "", vinfo.bits_per_pixel);
+           fb->portrait_mode ? " [portrait]" : "", vinfo.bits_per_pixel,
+           fb->page_flip ? (fb->flip_vsync ? ", page flipping + vsync" : ", page flipping") : "");
     return 0;
 }
 
 void fb_close(Framebuffer *fb) {
-    if (fb->back_buffer != NULL) {
+    if (fb->page_flip) {
+        // Hand the panel back the way every other app expects it: page 0 on
+        // screen and showing what we last showed. The back buffer is part of
+        // the mapping, so there is nothing to free.
+        if (fb->shown_page != 0)
+            memcpy(fb_page(fb, 0), fb_page(fb, fb->shown_page), fb->screen_size);
+        fb_pan_to(fb, 0);
+    } else if (fb->back_buffer != NULL) {
         free(fb->back_buffer);
     }
-    if (fb->buffer != MAP_FAILED) {
-        munmap(fb->buffer, fb->screen_size);
+    if (fb->map != NULL && fb->map != MAP_FAILED) {
+        munmap(fb->map, fb->map_size);
     }
     if (fb->fd != -1) {
         close(fb->fd);
     }
 }
 
-void fb_swap(Framebuffer *fb) {
-    if (!fb->double_buffering || fb->back_buffer == NULL)
-        return;
+// ---------------------------------------------------------------------------
+// Portrait rotation
+//
+// Logical (lx, ly) lands on physical row phys_height-1-(lx+view_x), column
+// ly+view_y: a logical COLUMN is a physical ROW. Rotating pixel by pixel reads
+// the back buffer in order and writes the panel one pixel per line_length —
+// every store a different cache line, and on the A8 a different write-combining
+// burst — for all 384000 pixels of a frame.
+//
+// Instead the rectangle is cut into 8x8 tiles. A tile is eight source rows of
+// eight pixels, transposed in registers, and stored as eight runs of eight
+// contiguous pixels, one per destination row: 16 or 32 bytes per store instead
+// of 2 or 4. Tiles are walked in DESTINATION order (a band of eight physical
+// rows at a time, left to right along them), so the panel is written in
+// ascending addresses and only the back-buffer reads stride — those hit the
+// cache, the uncached framebuffer mapping does not.
+//
+// The transpose is NEON vtrn where the compiler is given -mfpu=neon and a plain
+// 64-load/64-store loop otherwise. Whatever does not fill a whole tile (the
+// ragged edges of the rectangle, and damage rectangles thinner than a tile)
+// takes the per-pixel path, which is the old loop verbatim.
+// tests/fb_rotate_test.c holds the result to that loop at both depths.
+// ---------------------------------------------------------------------------
+
+#define FB_ROT_TILE 8
+
+// One 8x8 tile. src is the tile's top-left pixel, src_stride in pixels; dst is
+// the tile's column 0 on the panel, i.e. the start of the run for lx = tile x,
+// and logical column k lands at dst + k*dst_step (dst_step is -line_length).
+static void fb_rot_tile16(const uint16_t *src, size_t src_stride,
+                          uint8_t *dst, ptrdiff_t dst_step) {
+#ifdef __ARM_NEON
+    uint16x8_t r0 = vld1q_u16(src),                  r1 = vld1q_u16(src + src_stride);
+    uint16x8_t r2 = vld1q_u16(src + 2 * src_stride), r3 = vld1q_u16(src + 3 * src_stride);
+    uint16x8_t r4 = vld1q_u16(src + 4 * src_stride), r5 = vld1q_u16(src + 5 * src_stride);
+    uint16x8_t r6 = vld1q_u16(src + 6 * src_stride), r7 = vld1q_u16(src + 7 * src_stride);
+
+    // 16-bit pairs, then 32-bit pairs: after these, each half of a q register
+    // is four rows of one column.
+    uint16x8x2_t t01 = vtrnq_u16(r0, r1), t23 = vtrnq_u16(r2, r3);
+    uint16x8x2_t t45 = vtrnq_u16(r4, r5), t67 = vtrnq_u16(r6, r7);
+    uint32x4x2_t u02 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[0]), vreinterpretq_u32_u16(t23.val[0]));
+    uint32x4x2_t u13 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[1]), vreinterpretq_u32_u16(t23.val[1]));
+    uint32x4x2_t u46 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[0]), vreinterpretq_u32_u16(t67.val[0]));
+    uint32x4x2_t u57 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[1]), vreinterpretq_u32_u16(t67.val[1]));
+
+    // Rows 0-3 of a column come from the first group, rows 4-7 from the second.
+    #define FB_ROT_COL16(k, a, b, half) \
+        vst1q_u16((uint16_t *)(dst + (k) * dst_step), vreinterpretq_u16_u32( \
+            vcombine_u32(vget_##half##_u32(a), vget_##half##_u32(b))))
+    FB_ROT_COL16(0, u02.val[0], u46.val[0], low);
+    FB_ROT_COL16(1, u13.val[0], u57.val[0], low);
+    FB_ROT_COL16(2, u02.val[1], u46.val[1], low);
+    FB_ROT_COL16(3, u13.val[1], u57.val[1], low);
+    FB_ROT_COL16(4, u02.val[0], u46.val[0], high);
+    FB_ROT_COL16(5, u13.val[0], u57.val[0], high);
+    FB_ROT_COL16(6, u02.val[1], u46.val[1], high);
+    FB_ROT_COL16(7, u13.val[1], u57.val[1], high);
+    #undef FB_ROT_COL16
+#else
+    for (int k = 0; k < FB_ROT_TILE; k++) {
+        uint16_t *d = (uint16_t *)(dst + k * dst_step);
+        for (int j = 0; j < FB_ROT_TILE; j++)
+            d[j] = src[(size_t)j * src_stride + k];
+    }
+#endif
+}
+
+#ifdef __ARM_NEON
+// 4x4 quarter of a 32bpp tile: rows of src become runs at dst, dst + dst_step, ...
+static inline void fb_rot_quad32(const uint32_t *src, size_t src_stride,
+                                 uint8_t *dst, ptrdiff_t dst_step) {
+    uint32x4x2_t t01 = vtrnq_u32(vld1q_u32(src), vld1q_u32(src + src_stride));
+    uint32x4x2_t t23 = vtrnq_u32(vld1q_u32(src + 2 * src_stride), vld1q_u32(src + 3 * src_stride));
+    vst1q_u32((uint32_t *)dst,                  vcombine_u32(vget_low_u32(t01.val[0]),  vget_low_u32(t23.val[0])));
+    vst1q_u32((uint32_t *)(dst + dst_step),     vcombine_u32(vget_low_u32(t01.val[1]),  vget_low_u32(t23.val[1])));
+    vst1q_u32((uint32_t *)(dst + 2 * dst_step), vcombine_u32(vget_high_u32(t01.val[0]), vget_high_u32(t23.val[0])));
+    vst1q_u32((uint32_t *)(dst + 3 * dst_step), vcombine_u32(vget_high_u32(t01.val[1]), vget_high_u32(t23.val[1])));
+}
+#endif
+
+static void fb_rot_tile32(const uint32_t *src, size_t src_stride,
+                          uint8_t *dst, ptrdiff_t dst_step) {
+#ifdef __ARM_NEON
+    // Four 4x4 transposes; quadrant (rows 4.., cols 0..) lands 16 bytes along
+    // the first four runs, and so on.
+    fb_rot_quad32(src,                      src_stride, dst,                     dst_step);
+    fb_rot_quad32(src + 4 * src_stride,     src_stride, dst + 16,                dst_step);
+    fb_rot_quad32(src + 4,                  src_stride, dst + 4 * dst_step,      dst_step);
+    fb_rot_quad32(src + 4 * src_stride + 4, src_stride, dst + 4 * dst_step + 16, dst_step);
+#else
+    for (int k = 0; k < FB_ROT_TILE; k++) {
+        uint32_t *d = (uint32_t *)(dst + k * dst_step);
+        for (int j = 0; j < FB_ROT_TILE; j++)
+            d[j] = src[(size_t)j * src_stride + k];
+    }
+#endif
+}
+
+// Per-pixel rotation of (x, y, w, h): the edges the tiles do not cover.
+static void fb_rotate_pixels(Framebuffer *fb, int x, int y, int w, int h) {
+    // 90 CCW rotation from the logical surface into the panel, offset by the
+    // viewport: logical (lx, ly) -> virtual (lx+view_x, ly+view_y)
+    //                            -> physical (vy, phys_height-1-vx)
+    // Byte-addressed, so it is correct at either bpp and under a line_length
+    // that is wider than the visible row (both hold on this panel).
+    const uint32_t bpp = fb->bytes_per_pixel;
+    const uint8_t *src = (const uint8_t *)fb->back_buffer;
+    uint8_t *dst = (uint8_t *)fb->buffer;
+    const bool is16 = FB_IS_16BPP(fb);
+    uint32_t lw = fb->width;
+    uint32_t ph_minus_1 = fb->phys_height - 1;
+
+    for (int ly = y; ly < y + h; ly++) {
+        const uint8_t *src_row = src + (size_t)ly * lw * bpp;
+        uint32_t px = ly + fb->view_y;   // Physical X = virtual Y
+        for (int lx = x; lx < x + w; lx++) {
+            uint32_t py = ph_minus_1 - (lx + fb->view_x);
+            uint8_t *d = dst + (size_t)py * fb->line_length + (size_t)px * bpp;
+            if (is16) *(uint16_t *)d = ((const uint16_t *)src_row)[lx];
+            else      *(uint32_t *)d = ((const uint32_t *)src_row)[lx];
+        }
+    }
+}
+
+static void fb_rotate_rect(Framebuffer *fb, int x, int y, int w, int h) {
+    const uint32_t bpp = fb->bytes_per_pixel;
+    const bool is16 = FB_IS_16BPP(fb);
+    const ptrdiff_t dst_step = -(ptrdiff_t)fb->line_length;
+    const int w8 = w & ~(FB_ROT_TILE - 1), h8 = h & ~(FB_ROT_TILE - 1);
+
+    for (int tx = 0; tx < w8; tx += FB_ROT_TILE) {
+        int lx = x + tx;
+        uint8_t *dst_row = (uint8_t *)fb->buffer +
+            (size_t)(fb->phys_height - 1 - (lx + fb->view_x)) * fb->line_length;
+        for (int ty = 0; ty < h8; ty += FB_ROT_TILE) {
+            int ly = y + ty;
+            uint8_t *dst = dst_row + (size_t)(ly + fb->view_y) * bpp;
+            size_t si = (size_t)ly * fb->width + lx;
+            if (is16) fb_rot_tile16((const uint16_t *)fb->back_buffer + si, fb->width, dst, dst_step);
+            else      fb_rot_tile32(fb->back_buffer + si, fb->width, dst, dst_step);
+        }
+        if (h8 < h) fb_rotate_pixels(fb, lx, y + h8, FB_ROT_TILE, h - h8);
+    }
+    if (w8 < w) fb_rotate_pixels(fb, x + w8, y, w - w8, h);
+}
+
+// Copy one rectangle of the logical surface (x, y, w, h — clipped, logical
+// coordinates) to its place on the panel. Both the full and the damage-tracked
+// swap go through here, so a partial present cannot disagree with a full one.
+static void fb_present_rect(Framebuffer *fb, int x, int y, int w, int h) {
+    const uint32_t bpp = fb->bytes_per_pixel;
+    const uint8_t *src = (const uint8_t *)fb->back_buffer;
+    uint8_t *dst = (uint8_t *)fb->buffer;
 
     if (fb->portrait_mode) {
-        // 90 CCW rotation from the logical surface into the panel, offset by the
-        // viewport: logical (lx, ly) -> virtual (lx+view_x, ly+view_y)
-        //                            -> physical (vy, phys_height-1-vx)
-        // Byte-addressed, so it is correct at either bpp and under a line_length
-        // that is wider than the visible row (both hold on this panel).
-        const uint32_t bpp = fb->bytes_per_pixel;
-        const bool is16 = FB_IS_16BPP(fb);
-        uint32_t lw = fb->width;
-        uint32_t lh = fb->height;
-        uint32_t ph_minus_1 = fb->phys_height - 1;
-        const uint8_t *src = (const uint8_t *)fb->back_buffer;
-        uint8_t *dst = (uint8_t *)fb->buffer;
-
-        for (uint32_t ly = 0; ly < lh; ly++) {
-            const uint8_t *src_row = src + (size_t)ly * lw * bpp;
-            uint32_t px = ly + fb->view_y;   // Physical X = virtual Y
-            for (uint32_t lx = 0; lx < lw; lx++) {
-                uint32_t py = ph_minus_1 - (lx + fb->view_x);
-                uint8_t *d = dst + (size_t)py * fb->line_length + (size_t)px * bpp;
-                if (is16) *(uint16_t *)d = ((const uint16_t *)src_row)[lx];
-                else      *(uint32_t *)d = ((const uint32_t *)src_row)[lx];
-            }
+        fb_rotate_rect(fb, x, y, w, h);
+        return;
+    }
+
+    // Landscape: row by row into the visible rectangle. Byte-based so it is
+    // correct at any bpp (ScummVM runs this path at 16bpp).
+    const size_t row_bytes = (size_t)w * bpp;
+    src += ((size_t)y * fb->width + x) * bpp;
+    dst += (size_t)(y + fb->view_y) * fb->line_length + (size_t)(x + fb->view_x) * bpp;
+    for (int j = 0; j < h; j++) {
+        memcpy(dst, src, row_bytes);
+        src += (size_t)fb->width * bpp;
+        dst += fb->line_length;
+    }
+}
+
+// The back buffer to the panel: a pan, a damage-tracked copy or a full one.
+static void fb_present(Framebuffer *fb) {
+    if (fb->page_flip) {
+        // The frame is already in the hidden page: show it, and draw the next
+        // one into the page that just went off screen.
+        int next = 1 - fb->shown_page;
+        fb->damage_full = false;
+        fb->damage_count = 0;
+        if (fb_pan_to(fb, next) == -1) {
+            // A driver that granted the virtual size but will not pan. Copy
+            // this frame into the page on screen and stop trying.
+            // If even the malloc fails, this stays in flip mode and the next
+            // swap lands here again — a copy per frame, which still shows it.
+            perror("Framebuffer: FBIOPAN_DISPLAY failed — page flipping off");
+            memcpy(fb_page(fb, fb->shown_page), fb_page(fb, next), fb->screen_size);
+            fb_flip_leave(fb);
+            return;
+        }
+        if (fb->flip_vsync) {
+            uint32_t crtc = 0;
+            ioctl(fb->fd, FBIO_WAITFORVSYNC, &crtc);
         }
+        fb->shown_page = next;
+        fb_flip_point(fb);
         return;
     }
 
-    if (fb->view_x == 0 && fb->view_y == 0 &&
+    if (fb->damage_tracking && !fb->damage_full) {
+        long covered = 0;
+        for (int i = 0; i < fb->damage_count; i++)
+            covered += (long)fb->damage[i].w * fb->damage[i].h;
+        if (covered * 100 <= (long)fb->width * fb->height * FB_DAMAGE_FULL_PERCENT) {
+            for (int i = 0; i < fb->damage_count; i++)
+                fb_present_rect(fb, fb->damage[i].x, fb->damage[i].y,
+                                fb->damage[i].w, fb->damage[i].h);
+            fb->damage_count = 0;
+            return;
+        }
+    }
+    fb->damage_full = false;
+    fb->damage_count = 0;
+
+    if (!fb->portrait_mode &&
+        fb->view_x == 0 && fb->view_y == 0 &&
         fb->width == fb->phys_width && fb->height == fb->phys_height &&
         fb->line_length == fb->width * fb->bytes_per_pixel) {
         // No bezel and no line padding: one straight copy
@@ -524,25 +1030,25 @@ void fb_swap(Framebuffer *fb) {
         return;
     }
 
-    // Letterboxed: copy row by row into the visible rectangle. Byte-based so it
-    // is correct at any bpp (ScummVM runs this path at 16bpp).
-    const uint32_t bpp = fb->bytes_per_pixel;
-    const uint32_t row_bytes = fb->width * bpp;
-    const uint8_t *src = (const uint8_t *)fb->back_buffer;
-    uint8_t *dst = (uint8_t *)fb->buffer
-                 + (size_t)fb->view_y * fb->line_length
-                 + (size_t)fb->view_x * bpp;
+    fb_present_rect(fb, 0, 0, (int)fb->width, (int)fb->height);
+}
 
-    for (uint32_t y = 0; y < fb->height; y++) {
-        memcpy(dst, src, row_bytes);
-        src += row_bytes;
-        dst += fb->line_length;
-    }
+void fb_swap(Framebuffer *fb) {
+    // A Surface (fb_surface_init) has a back buffer and no panel.
+    if (fb->buffer == NULL)
+        return;
+    if (fb->double_buffering && fb->back_buffer != NULL)
+        fb_present(fb);
+    // A single-buffered app drew straight to the panel, so its swap is the
+    // moment the frame is complete all the same. Weak: NULL unless
+    // input_lat.o is linked (input_lat.h).
+    if (input_lat_present) input_lat_present();
 }
 
 void fb_clear(Framebuffer *fb, uint32_t color) {
     /* Clear the back buffer if double buffering is enabled */
     void *target = fb_target(fb);
+    fb_damage_all(fb);
     size_t total = (size_t)fb->width * fb->height;
     if (color == 0) {
         /* Fast path: memset for black (all-zero). Sized in bytes so it stays
@@ -553,12 +1059,9 @@ void fb_clear(Framebuffer *fb, uint32_t color) {
         /* One packed word per pixel — a uint32_t fill would run off the end of
          * a 16bpp allocation, which is the 2x overflow the dispatch above
          * exists to prevent. */
-        uint16_t c = fb_pack565(color);
-        uint16_t *p = (uint16_t *)target;
-        for (size_t i = 0; i < total; i++) p[i] = c;
+        fb_span_fill16((uint16_t *)target, (int)total, fb_pack565(color));
     } else {
-        uint32_t *p = (uint32_t *)target;
-        for (size_t i = 0; i < total; i++) p[i] = color;
+        fb_span_fill32((uint32_t *)target, (int)total, color);
     }
 }
 
@@ -572,52 +1075,63 @@ void fb_clear_draw_offset(Framebuffer *fb) {
     fb->draw_offset_y = 0;
 }
 
-void fb_draw_pixel(Framebuffer *fb, int x, int y, uint32_t color) {
+// fb_draw_pixel() without the damage record. The outline, line and text
+// primitives plot through this and report their bounding box once instead.
+static inline void fb_put_pixel(Framebuffer *fb, int x, int y, uint32_t color) {
     if (x >= 0 && x < (int)fb->width && y >= 0 && y < (int)fb->height) {
         // Draw to back buffer if double buffering is enabled
         fb_store(fb_target(fb), (size_t)y * fb->width + x, color, FB_IS_16BPP(fb));
     }
 }
 
+void fb_draw_pixel(Framebuffer *fb, int x, int y, uint32_t color) {
+    fb_put_pixel(fb, x, y, color);
+    fb_damage(fb, x, y, 1, 1);
+}
+
 void fb_draw_rect(Framebuffer *fb, int x, int y, int w, int h, uint32_t color) {
     x += fb->draw_offset_x;
     y += fb->draw_offset_y;
+    fb_damage(fb, x, y, w, h);
     for (int i = 0; i < w; i++) {
-        fb_draw_pixel(fb, x + i, y, color);
-        fb_draw_pixel(fb, x + i, y + h - 1, color);
+        fb_put_pixel(fb, x + i, y, color);
+        fb_put_pixel(fb, x + i, y + h - 1, color);
     }
     for (int i = 0; i < h; i++) {
-        fb_draw_pixel(fb, x, y + i, color);
-        fb_draw_pixel(fb, x + w - 1, y + i, color);
+        fb_put_pixel(fb, x, y + i, color);
+        fb_put_pixel(fb, x + w - 1, y + i, color);
     }
 }
 
 void fb_fill_rect(Framebuffer *fb, int x, int y, int w, int h, uint32_t color) {
     x += fb->draw_offset_x;
     y += fb->draw_offset_y;
-    for (int j = 0; j < h; j++) {
-        for (int i = 0; i < w; i++) {
-            fb_draw_pixel(fb, x + i, y + j, color);
-        }
-    }
+    if (!fb_clip_rect(fb, &x, &y, &w, &h)) return;
+    fb_damage(fb, x, y, w, h);
+    void *target = fb_target(fb);
+    const bool is16 = FB_IS_16BPP(fb);
+    size_t idx = (size_t)y * fb->width + x;
+    for (int j = 0; j < h; j++, idx += fb->width)
+        fb_span_fill(target, idx, w, color, is16);
 }
 
 void fb_draw_circle(Framebuffer *fb, int cx, int cy, int radius, uint32_t color) {
     cx += fb->draw_offset_x;
     cy += fb->draw_offset_y;
+    fb_damage(fb, cx - radius, cy - radius, 2 * radius + 1, 2 * radius + 1);
     int x = radius;
     int y = 0;
     int err = 0;
     
     while (x >= y) {
-        fb_draw_pixel(fb, cx + x, cy + y, color);
-        fb_draw_pixel(fb, cx + y, cy + x, color);
-        fb_draw_pixel(fb, cx - y, cy + x, color);
-        fb_draw_pixel(fb, cx - x, cy + y, color);
-        fb_draw_pixel(fb, cx - x, cy - y, color);
-        fb_draw_pixel(fb, cx - y, cy - x, color);
-        fb_draw_pixel(fb, cx + y, cy - x, color);
-        fb_draw_pixel(fb, cx + x, cy - y, color);
+        fb_put_pixel(fb, cx + x, cy + y, color);
+        fb_put_pixel(fb, cx + y, cy + x, color);
+        fb_put_pixel(fb, cx - y, cy + x, color);
+        fb_put_pixel(fb, cx - x, cy + y, color);
+        fb_put_pixel(fb, cx - x, cy - y, color);
+        fb_put_pixel(fb, cx - y, cy - x, color);
+        fb_put_pixel(fb, cx + y, cy - x, color);
+        fb_put_pixel(fb, cx + x, cy - y, color);
         
         if (err <= 0) {
             y += 1;
@@ -633,99 +1147,205 @@ void fb_draw_circle(Framebuffer *fb, int cx, int cy, int radius, uint32_t color)
 void fb_fill_circle(Framebuffer *fb, int cx, int cy, int radius, uint32_t color) {
     cx += fb->draw_offset_x;
     cy += fb->draw_offset_y;
-    for (int y = -radius; y <= radius; y++) {
-        for (int x = -radius; x <= radius; x++) {
-            if (x*x + y*y <= radius*radius) {
-                fb_draw_pixel(fb, cx + x, cy + y, color);
-            }
-        }
+    fb_damage(fb, cx - radius, cy - radius, 2 * radius + 1, 2 * radius + 1);
+    // One run per row. Walking d outward from the centre, the half-width only
+    // shrinks, so it is carried across rows instead of recomputed.
+    int hw = radius;
+    for (int d = 0; d <= radius; d++) {
+        while (hw * hw + d * d > radius * radius) hw--;
+        fb_hspan(fb, cx - hw, cx + hw, cy + d, color);
+        if (d) fb_hspan(fb, cx - hw, cx + hw, cy - d, color);
     }
 }
 
 // Draw filled rounded rectangle
 void fb_fill_rounded_rect(Framebuffer *fb, int x, int y, int w, int h, int r, uint32_t color) {
+    if (w <= 0 || h <= 0) return;
+    x += fb->draw_offset_x;
+    y += fb->draw_offset_y;
+    fb_damage(fb, x, y, w, h);
     if (r < 0) r = 0;
     if (r > w / 2) r = w / 2;
     if (r > h / 2) r = h / 2;
-    // Central rectangle
-    fb_fill_rect(fb, x + r, y, w - 2 * r, h, color);
-    // Left and right rectangles
-    fb_fill_rect(fb, x, y + r, r, h - 2 * r, color);
-    fb_fill_rect(fb, x + w - r, y + r, r, h - 2 * r, color);
-    // Four corner circles
-    fb_fill_circle(fb, x + r,     y + r,     r, color);
-    fb_fill_circle(fb, x + w - r - 1, y + r,     r, color);
-    fb_fill_circle(fb, x + r,     y + h - r - 1, r, color);
-    fb_fill_circle(fb, x + w - r - 1, y + h - r - 1, r, color);
+    // The shape is the union of a central rectangle, two side rectangles and
+    // four corner circles centred r in from each corner. It used to be drawn as
+    // exactly that — seven primitives and a lot of overdraw. The union is one
+    // contiguous run per row, so it is drawn as one: the side rectangles cover
+    // the rows between the corner centres, and on the rows above and below them
+    // each end of the run is the corner circle's edge.
+    const int left_c  = x + r;            // corner circle centres, columns
+    const int right_c = x + w - r - 1;
+    const int top_c   = r;                // and rows, relative to y
+    const int bot_c   = h - r - 1;
+    //
+    // ⚠️ When r == w/2 or r == h/2 at an EVEN size, the centres cross: right_c
+    // sits one column LEFT of left_c (and bot_c one row above top_c), so the
+    // nearest centre is taken rather than the one on the same side. The
+    // seven-primitive version also spilled one row above and one column right
+    // of the box in exactly that case — its corner circles reach r past a centre
+    // that is only r-1 from the edge. The run is clamped to the box, so that
+    // spill is gone; inside the box the pixels are unchanged (tests/fb_span_test.c).
+    const int lo_c = left_c < right_c ? left_c : right_c;
+    const int hi_c = left_c < right_c ? right_c : left_c;
+    for (int j = 0; j < h; j++) {
+        int d = 0;                        // side rectangles: the full width
+        if (j < top_c || j > bot_c) {
+            int dt = abs(j - top_c), db = abs(j - bot_c);
+            d = dt < db ? dt : db;
+        }
+        int ext = fb_circle_half_width(r, d);
+        if (ext < 0) ext = 0;             // the central rectangle alone
+        int x0 = lo_c - ext, x1 = hi_c + ext;
+        if (x0 < x) x0 = x;
+        if (x1 > x + w - 1) x1 = x + w - 1;
+        fb_hspan(fb, x0, x1, y + j, color);
+    }
 }
 
 // Draw rounded rectangle outline
 void fb_draw_rounded_rect(Framebuffer *fb, int x, int y, int w, int h, int r, uint32_t color) {
     x += fb->draw_offset_x;
     y += fb->draw_offset_y;
+    fb_damage(fb, x, y, w, h);
     if (r < 0) r = 0;
     if (r > w / 2) r = w / 2;
     if (r > h / 2) r = h / 2;
     // Top and bottom edges
     for (int i = r; i < w - r; i++) {
-        fb_draw_pixel(fb, x + i, y, color);
-        fb_draw_pixel(fb, x + i, y + h - 1, color);
+        fb_put_pixel(fb, x + i, y, color);
+        fb_put_pixel(fb, x + i, y + h - 1, color);
     }
     // Left and right edges
     for (int i = r; i < h - r; i++) {
-        fb_draw_pixel(fb, x, y + i, color);
-        fb_draw_pixel(fb, x + w - 1, y + i, color);
+        fb_put_pixel(fb, x, y + i, color);
+        fb_put_pixel(fb, x + w - 1, y + i, color);
     }
     // Four corner arcs (Bresenham circle)
     int cx, cy, err;
     cx = r; cy = 0; err = 0;
     while (cx >= cy) {
-        fb_draw_pixel(fb, x + r - cx,     y + r - cy,     color); // TL
-        fb_draw_pixel(fb, x + r - cy,     y + r - cx,     color);
-        fb_draw_pixel(fb, x + w-1-r + cx, y + r - cy,     color); // TR
-        fb_draw_pixel(fb, x + w-1-r + cy, y + r - cx,     color);
-        fb_draw_pixel(fb, x + r - cx,     y + h-1-r + cy, color); // BL
-        fb_draw_pixel(fb, x + r - cy,     y + h-1-r + cx, color);
-        fb_draw_pixel(fb, x + w-1-r + cx, y + h-1-r + cy, color); // BR
-        fb_draw_pixel(fb, x + w-1-r + cy, y + h-1-r + cx, color);
+        fb_put_pixel(fb, x + r - cx,     y + r - cy,     color); // TL
+        fb_put_pixel(fb, x + r - cy,     y + r - cx,     color);
+        fb_put_pixel(fb, x + w-1-r + cx, y + r - cy,     color); // TR
+        fb_put_pixel(fb, x + w-1-r + cy, y + r - cx,     color);
+        fb_put_pixel(fb, x + r - cx,     y + h-1-r + cy, color); // BL
+        fb_put_pixel(fb, x + r - cy,     y + h-1-r + cx, color);
+        fb_put_pixel(fb, x + w-1-r + cx, y + h-1-r + cy, color); // BR
+        fb_put_pixel(fb, x + w-1-r + cy, y + h-1-r + cx, color);
         if (err <= 0) { cy++; err += 2*cy + 1; }
         if (err > 0)  { cx--; err -= 2*cx + 1; }
     }
 }
 
+// ---------------------------------------------------------------------------
+// Text
+//
+// font_5x7 is column-major bits, which is the wrong way round for a raster:
+// the old loop tested 35 bits per glyph and sent every lit one through
+// scale*scale fb_put_pixel() calls, each redoing the clip and the bpp branch.
+// A HUD score at scale 3 is a few thousand of those per frame, per string.
+//
+// So each glyph is pre-rasterised, once, into the horizontal runs of each of
+// its 7 rows (5 bits make at most 3 runs). That cache is independent of scale,
+// colour and depth — a run at scale s is just the run times s, and the colour
+// is packed once per string — so 95 glyphs x 7 rows is the whole of it, built
+// on first use. fb_draw_text() then walks the string ROW BY ROW, filling each
+// glyph's runs on that row with the span fill: ascending addresses, the
+// vertical clip done once per string, the horizontal one skipping whole
+// characters and trimming only the runs that cross an edge.
+//
+// The output is the same pixels as the per-pixel loop; tests/fb_text_test.c
+// holds it to a verbatim copy of that loop.
+// ---------------------------------------------------------------------------
+
+#define FB_GLYPHS 95
+
+typedef struct {
+    uint8_t n;          // runs on this row, 0..3
+    uint8_t x[3];       // first column of each run
+    uint8_t len[3];
+} FbGlyphRow;
+
+static FbGlyphRow glyph_rows[FB_GLYPHS][7];
+static bool glyph_rows_ready = false;
+
+static void fb_glyph_rows_build(void) {
+    for (int g = 0; g < FB_GLYPHS; g++) {
+        for (int row = 0; row < 7; row++) {
+            FbGlyphRow *gr = &glyph_rows[g][row];
+            gr->n = 0;
+            int col = 0;
+            while (col < 5) {
+                if (!(font_5x7[g][col] & (1 << row))) { col++; continue; }
+                int start = col;
+                while (col < 5 && (font_5x7[g][col] & (1 << row))) col++;
+                gr->x[gr->n] = (uint8_t)start;
+                gr->len[gr->n] = (uint8_t)(col - start);
+                gr->n++;
+            }
+        }
+    }
+    glyph_rows_ready = true;
+}
+
+int fb_text_width(const char *text, int scale) {
+    return (int)strlen(text) * 6 * scale;   // 5 px glyph + 1 px spacing
+}
+
+int fb_text_height(int scale) {
+    return 7 * scale;
+}
+
 void fb_draw_text(Framebuffer *fb, int x, int y, const char *text, uint32_t color, int scale) {
     x += fb->draw_offset_x;
     y += fb->draw_offset_y;
-    int offset_x = 0;
-    
-    while (*text) {
-        char c = *text;
-        int idx = c - ' ';
-        
-        if (idx < 0 || idx >= 95) {
-            offset_x += 6 * scale;
-            text++;
-            continue;
-        }
-        
-        {
-            for (int col = 0; col < 5; col++) {
-                uint8_t column = font_5x7[idx][col];
-                for (int row = 0; row < 7; row++) {
-                    if (column & (1 << row)) {
-                        for (int sy = 0; sy < scale; sy++) {
-                            for (int sx = 0; sx < scale; sx++) {
-                                fb_draw_pixel(fb, x + offset_x + col * scale + sx, 
-                                            y + row * scale + sy, color);
-                            }
-                        }
-                    }
+    const int n = (int)strlen(text);
+    fb_damage(fb, x, y, n * 6 * scale, 7 * scale);
+    if (scale <= 0 || n == 0) return;
+    if (!glyph_rows_ready) fb_glyph_rows_build();
+
+    const int fw = (int)fb->width;
+    const int advance = 6 * scale;
+    int y0 = y < 0 ? 0 : y;
+    int y1 = y + 7 * scale;
+    if (y1 > (int)fb->height) y1 = (int)fb->height;
+    if (y0 >= y1) return;
+
+    // The characters that can touch the surface, found once: skip those whose
+    // 5-column cell ends at or left of 0, stop at the first that starts at or
+    // right of the width.
+    int first = 0, cx0 = x;
+    while (first < n && cx0 + 5 * scale <= 0) { first++; cx0 += advance; }
+    int last = first, cx_end = cx0;
+    while (last < n && cx_end < fw) { last++; cx_end += advance; }
+    if (first >= last) return;
+
+    const bool is16 = FB_IS_16BPP(fb);
+    const uint16_t c16 = fb_pack565(color);
+    void *target = fb_target(fb);
+
+    int py = y0;
+    for (int row = 0; row < 7 && py < y1; row++) {
+        int band_end = y + (row + 1) * scale;    // this font row covers rows < band_end
+        if (band_end > y1) band_end = y1;
+        for (; py < band_end; py++) {
+            size_t line = (size_t)py * fb->width;
+            int cx = cx0;
+            for (int i = first; i < last; i++, cx += advance) {
+                int idx = (unsigned char)text[i] - ' ';
+                if (idx < 0 || idx >= FB_GLYPHS) continue;
+                const FbGlyphRow *gr = &glyph_rows[idx][row];
+                for (int k = 0; k < gr->n; k++) {
+                    int sx0 = cx + gr->x[k] * scale;
+                    int sx1 = sx0 + gr->len[k] * scale;
+                    if (sx0 < 0) sx0 = 0;
+                    if (sx1 > fw) sx1 = fw;
+                    if (sx0 >= sx1) continue;
+                    if (is16) fb_span_fill16((uint16_t *)target + line + sx0, sx1 - sx0, c16);
+                    else      fb_span_fill32((uint32_t *)target + line + sx0, sx1 - sx0, color);
                 }
             }
         }
-        
-        offset_x += 6 * scale;
-        text++;
     }
 }
 
@@ -733,11 +1353,13 @@ void fb_draw_text(Framebuffer *fb, int x, int y, const char *text, uint32_t colo
 void fb_draw_line(Framebuffer *fb, int x0, int y0, int x1, int y1, uint32_t color) {
     x0 += fb->draw_offset_x; y0 += fb->draw_offset_y;
     x1 += fb->draw_offset_x; y1 += fb->draw_offset_y;
+    fb_damage(fb, x0 < x1 ? x0 : x1, y0 < y1 ? y0 : y1,
+              abs(x1 - x0) + 1, abs(y1 - y0) + 1);
     int dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
     int dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
     int err = dx + dy;
     for (;;) {
-        fb_draw_pixel(fb, x0, y0, color);
+        fb_put_pixel(fb, x0, y0, color);
         if (x0 == x1 && y0 == y1) break;
         int e2 = 2 * err;
         if (e2 >= dy) { err += dy; x0 += sx; }
@@ -759,10 +1381,149 @@ void fb_draw_thick_line(Framebuffer *fb, int x0, int y0, int x1, int y1,
     }
 }
 
+// ---------------------------------------------------------------------------
+// Alpha blending
+//
+// Every blend here is out = (src*a + dst*(255-a)) / 255 per channel, and the
+// /255 is the one the Cortex-A8 cannot afford: no hardware divide, so each was
+// a call into __aeabi_uidiv, three per pixel, on every pixel of a pause
+// overlay. fb_div255() is EXACT floor division for the range a blend can
+// produce (0..255*255) — the same pixels as before, to the bit — in an add and
+// two shifts, and the same identity vectorises: +1, add-shifted-right-by-8,
+// narrow-shifted-right-by-8 is three NEON instructions for eight channels.
+//
+// The kernels work on spans, like the fills: fb_blend_span*() puts a solid
+// colour over n pixels, fb_over_span*() puts n premultiplied sprite pixels
+// over n pixels. Both depths: at 16bpp the destination is unpacked to 8 bits a
+// channel with fb_unpack565()'s bit replication, blended, and repacked, so the
+// scalar and NEON paths agree with each other and with the old code.
+// ---------------------------------------------------------------------------
+
+static inline uint32_t fb_div255(uint32_t x) {
+    x += 1;
+    return (x + (x >> 8)) >> 8;
+}
+
+// Straight alpha: colour over dst at alpha a. The result has no top byte, as
+// fb_store() of a blended colour never had.
+static inline uint32_t fb_mix(uint32_t color, uint32_t dst, uint32_t a) {
+    uint32_t ia = 255 - a;
+    uint32_t r = fb_div255(((color >> 16) & 0xFF) * a + ((dst >> 16) & 0xFF) * ia);
+    uint32_t g = fb_div255(((color >>  8) & 0xFF) * a + ((dst >>  8) & 0xFF) * ia);
+    uint32_t b = fb_div255(( color        & 0xFF) * a + ( dst        & 0xFF) * ia);
+    return (r << 16) | (g << 8) | b;
+}
+
+// Premultiplied: src is ARGB with its colour already scaled by its alpha, so
+// only the destination needs the multiply.
+static inline uint32_t fb_over(uint32_t src, uint32_t dst) {
+    uint32_t ia = 255 - (src >> 24);
+    uint32_t r = ((src >> 16) & 0xFF) + fb_div255(((dst >> 16) & 0xFF) * ia);
+    uint32_t g = ((src >>  8) & 0xFF) + fb_div255(((dst >>  8) & 0xFF) * ia);
+    uint32_t b = ( src        & 0xFF) + fb_div255(( dst        & 0xFF) * ia);
+    return (r << 16) | (g << 8) | b;
+}
+
+#ifdef __ARM_NEON
+// floor(x/255) of eight 16-bit lanes that ALREADY include fb_div255()'s +1
+// (folded into a constant by the callers, it is free there).
+static inline uint8x8_t fb_div255_n(uint16x8_t x1) {
+    return vshrn_n_u16(vsraq_n_u16(x1, x1, 8), 8);
+}
+
+static inline void fb_unpack565_n(uint16x8_t v, uint8x8_t *r, uint8x8_t *g, uint8x8_t *b) {
+    uint8x8_t r5 = vmovn_u16(vshrq_n_u16(v, 11));
+    uint8x8_t g6 = vmovn_u16(vandq_u16(vshrq_n_u16(v, 5), vdupq_n_u16(0x3F)));
+    uint8x8_t b5 = vmovn_u16(vandq_u16(v, vdupq_n_u16(0x1F)));
+    *r = vorr_u8(vshl_n_u8(r5, 3), vshr_n_u8(r5, 2));
+    *g = vorr_u8(vshl_n_u8(g6, 2), vshr_n_u8(g6, 4));
+    *b = vorr_u8(vshl_n_u8(b5, 3), vshr_n_u8(b5, 2));
+}
+
+static inline uint16x8_t fb_pack565_n(uint8x8_t r, uint8x8_t g, uint8x8_t b) {
+    return vorrq_u16(vorrq_u16(vshlq_n_u16(vmovl_u8(vshr_n_u8(r, 3)), 11),
+                               vshlq_n_u16(vmovl_u8(vshr_n_u8(g, 2)), 5)),
+                     vmovl_u8(vshr_n_u8(b, 3)));
+}
+#endif
+
+// Solid colour over n pixels at alpha a. XRGB8888 is B,G,R,X in memory, so
+// vld4 hands over one register per channel.
+static void fb_blend_span32(uint32_t *p, int n, uint32_t color, uint32_t a) {
+#ifdef __ARM_NEON
+    if (n >= 8) {
+        const uint8x8_t ia = vdup_n_u8((uint8_t)(255 - a));
+        const uint16x8_t kr = vdupq_n_u16((uint16_t)(((color >> 16) & 0xFF) * a + 1));
+        const uint16x8_t kg = vdupq_n_u16((uint16_t)(((color >>  8) & 0xFF) * a + 1));
+        const uint16x8_t kb = vdupq_n_u16((uint16_t)(( color        & 0xFF) * a + 1));
+        for (; n >= 8; n -= 8, p += 8) {
+            uint8x8x4_t d = vld4_u8((const uint8_t *)p);
+            d.val[0] = fb_div255_n(vmlal_u8(kb, d.val[0], ia));
+            d.val[1] = fb_div255_n(vmlal_u8(kg, d.val[1], ia));
+            d.val[2] = fb_div255_n(vmlal_u8(kr, d.val[2], ia));
+            d.val[3] = vdup_n_u8(0);
+            vst4_u8((uint8_t *)p, d);
+        }
+    }
+#endif
+    for (; n > 0; n--, p++) *p = fb_mix(color, *p, a);
+}
+
+static void fb_blend_span16(uint16_t *p, int n, uint32_t color, uint32_t a) {
+#ifdef __ARM_NEON
+    if (n >= 8) {
+        const uint8x8_t ia = vdup_n_u8((uint8_t)(255 - a));
+        const uint16x8_t kr = vdupq_n_u16((uint16_t)(((color >> 16) & 0xFF) * a + 1));
+        const uint16x8_t kg = vdupq_n_u16((uint16_t)(((color >>  8) & 0xFF) * a + 1));
+        const uint16x8_t kb = vdupq_n_u16((uint16_t)(( color        & 0xFF) * a + 1));
+        for (; n >= 8; n -= 8, p += 8) {
+            uint8x8_t r, g, b;
+            fb_unpack565_n(vld1q_u16(p), &r, &g, &b);
+            vst1q_u16(p, fb_pack565_n(fb_div255_n(vmlal_u8(kr, r, ia)),
+                                      fb_div255_n(vmlal_u8(kg, g, ia)),
+                                      fb_div255_n(vmlal_u8(kb, b, ia))));
+        }
+    }
+#endif
+    for (; n > 0; n--, p++) *p = fb_pack565(fb_mix(color, fb_unpack565(*p), a));
+}
+
+// n premultiplied ARGB sprite pixels over n surface pixels.
+static void fb_over_span32(uint32_t *p, const uint32_t *s, int n) {
+#ifdef __ARM_NEON
+    const uint16x8_t one = vdupq_n_u16(1);
+    for (; n >= 8; n -= 8, p += 8, s += 8) {
+        uint8x8x4_t src = vld4_u8((const uint8_t *)s);
+        uint8x8x4_t d = vld4_u8((const uint8_t *)p);
+        uint8x8_t ia = vmvn_u8(src.val[3]);
+        for (int c = 0; c < 3; c++)
+            d.val[c] = vadd_u8(src.val[c], fb_div255_n(vmlal_u8(one, d.val[c], ia)));
+        d.val[3] = vdup_n_u8(0);
+        vst4_u8((uint8_t *)p, d);
+    }
+#endif
+    for (; n > 0; n--, p++, s++) *p = fb_over(*s, *p);
+}
+
+static void fb_over_span16(uint16_t *p, const uint32_t *s, int n) {
+#ifdef __ARM_NEON
+    const uint16x8_t one = vdupq_n_u16(1);
+    for (; n >= 8; n -= 8, p += 8, s += 8) {
+        uint8x8x4_t src = vld4_u8((const uint8_t *)s);
+        uint8x8_t ia = vmvn_u8(src.val[3]);
+        uint8x8_t r, g, b;
+        fb_unpack565_n(vld1q_u16(p), &r, &g, &b);
+        vst1q_u16(p, fb_pack565_n(vadd_u8(src.val[2], fb_div255_n(vmlal_u8(one, r, ia))),
+                                  vadd_u8(src.val[1], fb_div255_n(vmlal_u8(one, g, ia))),
+                                  vadd_u8(src.val[0], fb_div255_n(vmlal_u8(one, b, ia)))));
+    }
+#endif
+    for (; n > 0; n--, p++, s++) *p = fb_pack565(fb_over(*s, fb_unpack565(*p)));
+}
+
 /* -- Alpha-blended pixel ------------------------------------------------ */
-void fb_draw_pixel_alpha(Framebuffer *fb, int x, int y, uint32_t color, uint8_t alpha) {
-    x += fb->draw_offset_x;
-    y += fb->draw_offset_y;
+/* Surface coordinates, no damage record. */
+static void fb_blend_pixel(Framebuffer *fb, int x, int y, uint32_t color, uint8_t alpha) {
     if (x < 0 || x >= (int)fb->width || y < 0 || y >= (int)fb->height) return;
     void *target = fb_target(fb);
     bool is16 = FB_IS_16BPP(fb);
@@ -770,22 +1531,30 @@ void fb_draw_pixel_alpha(Framebuffer *fb, int x, int y, uint32_t color, uint8_t
     /* Read-modify-write, so the destination has to be UNPACKED first: at 16bpp
      * the stored word is RGB565 and blending it as if it were RGB888 produces a
      * colour unrelated to what is on screen. */
-    uint32_t dst = fb_load(target, idx, is16);
-    uint32_t sr = (color >> 16) & 0xFF, sg = (color >> 8) & 0xFF, sb = color & 0xFF;
-    uint32_t dr = (dst   >> 16) & 0xFF, dg = (dst   >> 8) & 0xFF, db = dst   & 0xFF;
-    uint32_t a = alpha, ia = 255 - alpha;
-    uint32_t r = (sr * a + dr * ia) / 255;
-    uint32_t g = (sg * a + dg * ia) / 255;
-    uint32_t b = (sb * a + db * ia) / 255;
-    fb_store(target, idx, (r << 16) | (g << 8) | b, is16);
+    fb_store(target, idx, fb_mix(color, fb_load(target, idx, is16), alpha), is16);
+}
+
+void fb_draw_pixel_alpha(Framebuffer *fb, int x, int y, uint32_t color, uint8_t alpha) {
+    x += fb->draw_offset_x;
+    y += fb->draw_offset_y;
+    fb_blend_pixel(fb, x, y, color, alpha);
+    fb_damage(fb, x, y, 1, 1);
 }
 
 /* -- Alpha-blended filled rect ------------------------------------------ */
 void fb_fill_rect_alpha(Framebuffer *fb, int x, int y, int w, int h,
                         uint32_t color, uint8_t alpha) {
-    for (int j = 0; j < h; j++)
-        for (int i = 0; i < w; i++)
-            fb_draw_pixel_alpha(fb, x + i, y + j, color, alpha);
+    x += fb->draw_offset_x;
+    y += fb->draw_offset_y;
+    fb_damage(fb, x, y, w, h);
+    if (!fb_clip_rect(fb, &x, &y, &w, &h)) return;
+    void *target = fb_target(fb);
+    const bool is16 = FB_IS_16BPP(fb);
+    for (int j = 0; j < h; j++) {
+        size_t idx = (size_t)(y + j) * fb->width + x;
+        if (is16) fb_blend_span16((uint16_t *)target + idx, w, color, alpha);
+        else      fb_blend_span32((uint32_t *)target + idx, w, color, alpha);
+    }
 }
 
 /* -- Vertical gradient filled rect -------------------------------------- */
@@ -805,15 +1574,22 @@ void fb_fill_rect_gradient(Framebuffer *fb, int x, int y, int w, int h,
     int dg = (int)((bottom_color >>  8) & 0xFF) - tg;
     int db = (int)( bottom_color        & 0xFF) - tb;
     int span = (h > 1) ? h - 1 : 1;
-    for (int j = 0; j < h; j++) {
+    /* Clip the columns once. The rows are clipped by range rather than by
+     * moving y, because the colour of row j depends on j within the WHOLE
+     * gradient — a gradient half off the top must not restart its ramp. */
+    int cx = x, cy = y, cw = w, ch = h;
+    if (!fb_clip_rect(fb, &cx, &cy, &cw, &ch)) return;
+    fb_damage(fb, cx, cy, cw, ch);
+    void *target = fb_target(fb);
+    const bool is16 = FB_IS_16BPP(fb);
+    for (int j = cy - y; j < cy - y + ch; j++) {
         /* j <= span, so |d*j/span| <= |d| and each channel stays between its
          * two endpoints — both already masked to 0..255. No clamp needed. */
         uint32_t r = (uint32_t)(tr + dr * j / span);
         uint32_t g = (uint32_t)(tg + dg * j / span);
         uint32_t b = (uint32_t)(tb + db * j / span);
         uint32_t c = (r << 16) | (g << 8) | b;
-        for (int i = 0; i < w; i++)
-            fb_draw_pixel(fb, x + i, y + j, c);
+        fb_span_fill(target, (size_t)(y + j) * fb->width + cx, cw, c, is16);
     }
 }
 
@@ -864,6 +1640,7 @@ void fb_blit_sprite(Framebuffer *fb, const uint32_t *src_pixels, int src_w,
                     uint32_t color_key) {
     int off_x = fb->draw_offset_x;
     int off_y = fb->draw_offset_y;
+    fb_damage(fb, dx + off_x, dy + off_y, w, h);
     int fb_w  = (int)fb->width;
     int fb_h  = (int)fb->height;
     void *target = fb_target(fb);
@@ -894,6 +1671,7 @@ void fb_blit_sprite_flipped(Framebuffer *fb, const uint32_t *src_pixels, int src
                             uint32_t color_key) {
     int off_x = fb->draw_offset_x;
     int off_y = fb->draw_offset_y;
+    fb_damage(fb, dx + off_x, dy + off_y, w, h);
     int fb_w  = (int)fb->width;
     int fb_h  = (int)fb->height;
     void *target = fb_target(fb);
@@ -928,6 +1706,7 @@ void fb_blit_sprite_scaled(Framebuffer *fb, const uint32_t *src_pixels, int src_
 
     int off_x = fb->draw_offset_x;
     int off_y = fb->draw_offset_y;
+    fb_damage(fb, dx + off_x, dy + off_y, dw, dh);
     int fb_w  = (int)fb->width;
     int fb_h  = (int)fb->height;
     void *target = fb_target(fb);
@@ -956,3 +1735,360 @@ void fb_blit_sprite_scaled(Framebuffer *fb, const uint32_t *src_pixels, int src_
         }
     }
 }
+
+// ---------------------------------------------------------------------------
+// Compiled sprites
+//
+// The three fb_blit_sprite* calls above re-decide, per pixel per blit, things
+// that never change for a piece of art loaded from disk: is this pixel the
+// colour key, and what does it look like at this depth. fb_sprite_compile()
+// answers both once. Each row becomes a list of OPAQUE runs, and the pixels
+// of those runs are stored already packed into the surface format, back to
+// back — so drawing is: clip the rows once, and per run, clip the two ends and
+// memcpy. Transparent pixels cost nothing at all; a fully opaque row is one
+// memcpy.
+//
+// fb_sprite_compile_alpha() is the same thing for art with a real alpha
+// channel instead of a magenta key — anti-aliased edges, soft shadows, glows.
+// Alpha 0 is skipped and alpha 255 is an opaque run exactly as above; only the
+// pixels in between become BLEND runs, stored as premultiplied ARGB8888 at
+// either depth (the blend needs the 8-bit channels) and drawn with
+// fb_over_span*(). A typical piece of art is mostly opaque interior, so most
+// of it is still memcpy.
+//
+// A sprite is one malloc (header, row index, runs, pixels), freed with
+// fb_sprite_free(). It is compiled for fb's depth and fb_draw_sprite() on a
+// surface of another depth draws nothing — re-compile after fb_set_bpp().
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    uint16_t x, len;        // columns [x, x+len) of its row
+    uint32_t offset : 31;   // byte offset of its first pixel in the pixels
+    uint32_t blend  : 1;    // premultiplied ARGB8888 to blend, else packed opaque
+} FbSpriteRun;
+
+struct FbSprite {
+    int w, h;
+    uint32_t bytes_per_pixel;
+    const uint32_t *row_start;      // h+1 entries: runs of row r are [row_start[r], row_start[r+1])
+    const FbSpriteRun *runs;
+    const uint8_t *pixels;
+};
+
+enum { FB_SPR_SKIP, FB_SPR_OPAQUE, FB_SPR_BLEND };
+
+// What a source pixel becomes: keyed sprites have no BLEND pixels; with
+// use_alpha the key is ignored and the top byte decides.
+static inline int fb_sprite_class(uint32_t p, bool use_alpha, uint32_t color_key) {
+    if (!use_alpha) return p == color_key ? FB_SPR_SKIP : FB_SPR_OPAQUE;
+    uint32_t a = p >> 24;
+    return a == 0 ? FB_SPR_SKIP : a == 255 ? FB_SPR_OPAQUE : FB_SPR_BLEND;
+}
+
+static inline uint32_t fb_premultiply(uint32_t p) {
+    uint32_t a = p >> 24;
+    return (a << 24) |
+           (fb_div255(((p >> 16) & 0xFF) * a) << 16) |
+           (fb_div255(((p >>  8) & 0xFF) * a) << 8) |
+            fb_div255(( p        & 0xFF) * a);
+}
+
+static FbSprite *fb_sprite_build(const Framebuffer *fb, const uint32_t *src_pixels, int src_w,
+                                 int sx, int sy, int w, int h,
+                                 bool use_alpha, uint32_t color_key) {
+    if (w <= 0 || h <= 0 || w > 0xFFFF) return NULL;
+    const uint32_t bpp = fb->bytes_per_pixel;
+    const bool is16 = FB_IS_16BPP(fb);
+
+    // Pass 1: size everything, so the sprite is a single allocation. Blend
+    // runs hold 32-bit pixels and start 4-aligned.
+    size_t nruns = 0, nbytes = 0;
+    for (int row = 0; row < h; row++) {
+        const uint32_t *p = src_pixels + (size_t)(sy + row) * src_w + sx;
+        for (int col = 0; col < w; ) {
+            int cls = fb_sprite_class(p[col], use_alpha, color_key);
+            if (cls == FB_SPR_SKIP) { col++; continue; }
+            int start = col;
+            while (col < w && fb_sprite_class(p[col], use_alpha, color_key) == cls) col++;
+            nruns++;
+            if (cls == FB_SPR_BLEND) nbytes = ((nbytes + 3) & ~(size_t)3) + (size_t)(col - start) * 4;
+            else                     nbytes += (size_t)(col - start) * bpp;
+        }
+    }
+    if (nbytes >= 0x80000000u) return NULL;
+
+    size_t index_bytes = (size_t)(h + 1) * sizeof(uint32_t);
+    size_t runs_bytes  = nruns * sizeof(FbSpriteRun);
+    uint8_t *mem = (uint8_t *)malloc(sizeof(FbSprite) + index_bytes + runs_bytes + nbytes);
+    if (!mem) return NULL;
+    FbSprite *spr = (FbSprite *)mem;
+    uint32_t *row_start = (uint32_t *)(mem + sizeof(FbSprite));
+    FbSpriteRun *runs = (FbSpriteRun *)((uint8_t *)row_start + index_bytes);
+    uint8_t *pixels = (uint8_t *)runs + runs_bytes;
+    spr->w = w;
+    spr->h = h;
+    spr->bytes_per_pixel = bpp;
+    spr->row_start = row_start;
+    spr->runs = runs;
+    spr->pixels = pixels;
+
+    // Pass 2: the same walk, writing the runs and their pixels.
+    uint32_t r = 0;
+    size_t off = 0;
+    for (int row = 0; row < h; row++) {
+        const uint32_t *p = src_pixels + (size_t)(sy + row) * src_w + sx;
+        row_start[row] = r;
+        for (int col = 0; col < w; ) {
+            int cls = fb_sprite_class(p[col], use_alpha, color_key);
+            if (cls == FB_SPR_SKIP) { col++; continue; }
+            bool blend = (cls == FB_SPR_BLEND);
+            if (blend) off = (off + 3) & ~(size_t)3;
+            runs[r].x = (uint16_t)col;
+            runs[r].offset = (uint32_t)off;
+            runs[r].blend = blend;
+            for (; col < w && fb_sprite_class(p[col], use_alpha, color_key) == cls; col++) {
+                if (blend) {
+                    *(uint32_t *)(pixels + off) = fb_premultiply(p[col]);
+                    off += 4;
+                } else {
+                    fb_store(pixels + off, 0, p[col], is16);
+                    off += bpp;
+                }
+            }
+            runs[r].len = (uint16_t)(col - runs[r].x);
+            r++;
+        }
+    }
+    row_start[h] = r;
+    return spr;
+}
+
+FbSprite *fb_sprite_compile(const Framebuffer *fb, const uint32_t *src_pixels, int src_w,
+                            int sx, int sy, int w, int h, uint32_t color_key) {
+    return fb_sprite_build(fb, src_pixels, src_w, sx, sy, w, h, false, color_key);
+}
+
+FbSprite *fb_sprite_compile_alpha(const Framebuffer *fb, const uint32_t *src_pixels, int src_w,
+                                  int sx, int sy, int w, int h) {
+    return fb_sprite_build(fb, src_pixels, src_w, sx, sy, w, h, true, 0);
+}
+
+void fb_sprite_free(FbSprite *spr) {
+    free(spr);
+}
+
+// Shared by both directions: the rows of spr that land on the surface.
+static bool fb_sprite_rows(Framebuffer *fb, const FbSprite *spr, int *dx, int *dy,
+                           int *r0, int *r1) {
+    *dx += fb->draw_offset_x;
+    *dy += fb->draw_offset_y;
+    fb_damage(fb, *dx, *dy, spr->w, spr->h);
+    if (spr->bytes_per_pixel != fb->bytes_per_pixel) return false;
+    *r0 = *dy < 0 ? -*dy : 0;
+    *r1 = spr->h;
+    if (*dy + *r1 > (int)fb->height) *r1 = (int)fb->height - *dy;
+    return *r0 < *r1 && *dx < (int)fb->width && *dx + spr->w > 0;
+}
+
+void fb_draw_sprite(Framebuffer *fb, const FbSprite *spr, int dx, int dy) {
+    int r0, r1;
+    if (!fb_sprite_rows(fb, spr, &dx, &dy, &r0, &r1)) return;
+    const int fw = (int)fb->width;
+    const uint32_t bpp = spr->bytes_per_pixel;
+    uint8_t *target = (uint8_t *)fb_target(fb);
+
+    for (int row = r0; row < r1; row++) {
+        uint8_t *line = target + (size_t)(dy + row) * fb->width * bpp;
+        for (uint32_t i = spr->row_start[row]; i < spr->row_start[row + 1]; i++) {
+            const FbSpriteRun *run = &spr->runs[i];
+            int x0 = dx + run->x, x1 = x0 + run->len;
+            if (x0 >= fw) break;                 // runs are in ascending x
+            int skip = x0 < 0 ? -x0 : 0;
+            if (x1 > fw) x1 = fw;
+            int n = x1 - x0 - skip;
+            if (n <= 0) continue;
+            uint8_t *d = line + (size_t)(x0 + skip) * bpp;
+            if (run->blend) {
+                const uint32_t *s = (const uint32_t *)(spr->pixels + run->offset) + skip;
+                if (bpp == 2) fb_over_span16((uint16_t *)d, s, n);
+                else          fb_over_span32((uint32_t *)d, s, n);
+            } else {
+                memcpy(d, spr->pixels + run->offset + (size_t)skip * bpp, (size_t)n * bpp);
+            }
+        }
+    }
+}
+
+// Mirrored about the sprite's vertical centre line, as fb_blit_sprite_flipped:
+// source column c lands on dx + w-1-c. A run is still contiguous on the
+// surface, just reversed, so it is a backwards copy instead of a memcpy.
+void fb_draw_sprite_flipped(Framebuffer *fb, const FbSprite *spr, int dx, int dy) {
+    int r0, r1;
+    if (!fb_sprite_rows(fb, spr, &dx, &dy, &r0, &r1)) return;
+    const int fw = (int)fb->width;
+    const bool is16 = FB_IS_16BPP(fb);
+    void *target = fb_target(fb);
+
+    for (int row = r0; row < r1; row++) {
+        size_t line = (size_t)(dy + row) * fb->width;
+        for (uint32_t i = spr->row_start[row]; i < spr->row_start[row + 1]; i++) {
+            const FbSpriteRun *run = &spr->runs[i];
+            int x1 = dx + spr->w - run->x;       // one past the run's first pixel
+            int x0 = x1 - run->len;
+            if (x1 <= 0) break;                  // later runs land further left
+            int lo = x0 < 0 ? 0 : x0, hi = x1 > fw ? fw : x1;
+            // Surface column d shows the run's pixel (x1-1-d).
+            if (run->blend) {
+                const uint32_t *s = (const uint32_t *)(spr->pixels + run->offset) + (x1 - 1 - lo);
+                for (int x = lo; x < hi; x++, s--) {
+                    size_t idx = line + x;
+                    fb_store(target, idx, fb_over(*s, fb_load(target, idx, is16)), is16);
+                }
+            } else if (is16) {
+                const uint16_t *s = (const uint16_t *)(spr->pixels + run->offset) + (x1 - 1 - lo);
+                uint16_t *d = (uint16_t *)target + line;
+                for (int x = lo; x < hi; x++) d[x] = *s--;
+            } else {
+                const uint32_t *s = (const uint32_t *)(spr->pixels + run->offset) + (x1 - 1 - lo);
+                uint32_t *d = (uint32_t *)target + line;
+                for (int x = lo; x < hi; x++) d[x] = *s--;
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Offscreen surfaces and layers
+//
+// Every game repaints its chrome — the clear, the well border, the hint text —
+// from primitives every frame, though none of it changes between levels. A
+// Surface is a Framebuffer with fd -1 and no panel, so it takes the whole
+// primitive set for free, and blitting one back is the same row memcpy the
+// landscape swap does. A layer adds the "only when invalidated" bookkeeping.
+// ---------------------------------------------------------------------------
+
+int fb_surface_init(Surface *surf, const Framebuffer *like, int w, int h) {
+    memset(surf, 0, sizeof(*surf));
+    surf->fd = -1;
+    if (w <= 0 || h <= 0) return -1;
+    surf->bytes_per_pixel = like->bytes_per_pixel;
+    surf->width  = surf->phys_width  = (uint32_t)w;
+    surf->height = surf->phys_height = (uint32_t)h;
+    surf->line_length = (uint32_t)w * surf->bytes_per_pixel;
+    surf->double_buffering = true;
+    surf->back_buffer_size = (size_t)w * h * surf->bytes_per_pixel;
+    surf->back_buffer = (uint32_t *)calloc(1, surf->back_buffer_size);
+    return surf->back_buffer ? 0 : -1;
+}
+
+void fb_surface_free(Surface *surf) {
+    free(surf->back_buffer);
+    surf->back_buffer = NULL;
+    surf->back_buffer_size = 0;
+}
+
+// Clip a src rectangle of src onto fb at (dx, dy) — surface coordinates —
+// moving the source corner with whatever is cut off the destination.
+static bool fb_blit_clip(const Framebuffer *fb, const Surface *src,
+                         int *sx, int *sy, int *dx, int *dy, int *w, int *h) {
+    if (*sx < 0) { *dx -= *sx; *w += *sx; *sx = 0; }
+    if (*sy < 0) { *dy -= *sy; *h += *sy; *sy = 0; }
+    if (*sx + *w > (int)src->width)  *w = (int)src->width  - *sx;
+    if (*sy + *h > (int)src->height) *h = (int)src->height - *sy;
+    int x = *dx, y = *dy;
+    if (*w <= 0 || *h <= 0 || !fb_clip_rect(fb, &x, &y, w, h)) return false;
+    *sx += x - *dx;
+    *sy += y - *dy;
+    *dx = x;
+    *dy = y;
+    return true;
+}
+
+void fb_blit_surface(Framebuffer *fb, const Surface *src,
+                     int sx, int sy, int dx, int dy, int w, int h) {
+    dx += fb->draw_offset_x;
+    dy += fb->draw_offset_y;
+    fb_damage(fb, dx, dy, w, h);
+    if (src->bytes_per_pixel != fb->bytes_per_pixel || src->back_buffer == NULL) return;
+    if (!fb_blit_clip(fb, src, &sx, &sy, &dx, &dy, &w, &h)) return;
+    const size_t bpp = fb->bytes_per_pixel;
+    void *target = fb_target(fb);
+    // A surface may blit onto itself. memmove covers an overlap within a row;
+    // moving the picture down, the rows must go bottom first, or each one
+    // lands on source rows not yet read.
+    const bool upward = (const void *)src->back_buffer == target && dy > sy;
+    for (int n = 0; n < h; n++) {
+        int j = upward ? h - 1 - n : n;
+        memmove((uint8_t *)target + ((size_t)(dy + j) * fb->width + dx) * bpp,
+                (const uint8_t *)src->back_buffer + ((size_t)(sy + j) * src->width + sx) * bpp,
+                (size_t)w * bpp);
+    }
+}
+
+void fb_blit_surface_keyed(Framebuffer *fb, const Surface *src,
+                           int sx, int sy, int dx, int dy, int w, int h,
+                           uint32_t color_key) {
+    dx += fb->draw_offset_x;
+    dy += fb->draw_offset_y;
+    fb_damage(fb, dx, dy, w, h);
+    if (src->bytes_per_pixel != fb->bytes_per_pixel || src->back_buffer == NULL) return;
+    if (!fb_blit_clip(fb, src, &sx, &sy, &dx, &dy, &w, &h)) return;
+    const bool is16 = FB_IS_16BPP(fb);
+    void *target = fb_target(fb);
+    // Compare stored words, so the key is packed once instead of every pixel
+    // unpacked.
+    const uint16_t key16 = fb_pack565(color_key);
+    // Onto itself, walk away from the direction of the move, as
+    // fb_blit_surface() does — rows bottom first moving down, and (there being
+    // no memmove for a keyed copy) pixels right to left moving right.
+    const bool self = (const void *)src->back_buffer == target;
+    const bool upward = self && dy > sy;
+    const bool leftward = self && dy == sy && dx > sx;
+    for (int n = 0; n < h; n++) {
+        int j = upward ? h - 1 - n : n;
+        size_t si = (size_t)(sy + j) * src->width + sx;
+        size_t di = (size_t)(dy + j) * fb->width + dx;
+        if (is16) {
+            const uint16_t *s = (const uint16_t *)src->back_buffer + si;
+            uint16_t *d = (uint16_t *)target + di;
+            if (leftward) { for (int i = w - 1; i >= 0; i--) if (s[i] != key16) d[i] = s[i]; }
+            else          { for (int i = 0; i < w; i++)     if (s[i] != key16) d[i] = s[i]; }
+        } else {
+            const uint32_t *s = src->back_buffer + si;
+            uint32_t *d = (uint32_t *)target + di;
+            if (leftward) { for (int i = w - 1; i >= 0; i--) if (s[i] != color_key) d[i] = s[i]; }
+            else          { for (int i = 0; i < w; i++)     if (s[i] != color_key) d[i] = s[i]; }
+        }
+    }
+}
+
+int fb_layer_init(FbLayer *layer, const Framebuffer *like, int w, int h,
+                  FbLayerPaint paint, void *user) {
+    layer->paint = paint;
+    layer->user = user;
+    layer->valid = false;
+    return fb_surface_init(&layer->surface, like, w, h);
+}
+
+void fb_layer_invalidate(FbLayer *layer) {
+    layer->valid = false;
+}
+
+Surface *fb_layer_surface(FbLayer *layer) {
+    if (!layer->valid && layer->surface.back_buffer != NULL) {
+        fb_clear(&layer->surface, 0);
+        if (layer->paint) layer->paint(&layer->surface, layer->user);
+        layer->valid = true;
+    }
+    return &layer->surface;
+}
+
+void fb_layer_blit(Framebuffer *fb, FbLayer *layer, int dx, int dy) {
+    Surface *surf = fb_layer_surface(layer);
+    fb_blit_surface(fb, surf, 0, 0, dx, dy, (int)surf->width, (int)surf->height);
+}
+
+void fb_layer_free(FbLayer *layer) {
+    fb_surface_free(&layer->surface);
+    layer->valid = false;
+}
@@ -5,6 +5,21 @@
 #include <stdbool.h>
 #include <stddef.h>  // For size_t
 
+// A rectangle in logical surface coordinates (the damage list's element).
+typedef struct {
+    int x, y, w, h;
+} FbRect;
+
+// Damage list capacity. Past it, the two rectangles whose union grows least are
+// merged, so the list never overflows — it just gets coarser.
+#define FB_DAMAGE_MAX 32
+
+// Coverage, in percent of the logical surface, past which a damage-tracked
+// fb_swap() stops copying rectangles and does one full copy instead: by then
+// the per-row setup and the slack in merged rectangles cost more than the
+// bytes they save.
+#define FB_DAMAGE_FULL_PERCENT 50
+
 typedef struct {
     int fd;
     // Pixel storage. Typed uint32_t for history, but the pixel SIZE is
@@ -27,6 +42,15 @@ typedef struct {
     size_t back_buffer_size; // Back buffer size (logical dims × bpp)
     int view_x;              // Logical surface origin within the panel (bezel left)
     int view_y;              // Logical surface origin within the panel (bezel top)
+    bool damage_tracking;    // fb_swap copies only damage[] (fb_set_damage_tracking)
+    bool damage_full;        // Whole surface dirty: next swap is a full copy
+    int damage_count;        // Entries in damage[], disjoint after merging
+    FbRect damage[FB_DAMAGE_MAX];
+    bool page_flip;          // back_buffer is the hidden page of the mmap (fb_request_page_flip)
+    bool flip_vsync;         // fb_swap waits for vsync after each pan
+    int shown_page;          // Page being scanned out (0 or 1) while page_flip
+    void *map;               // Start of the mmap: one page, or two while page_flip
+    size_t map_size;         // Bytes mapped at map
 } Framebuffer;
 
 // ---------------------------------------------------------------------------
@@ -141,6 +165,60 @@ void fb_close(Framebuffer *fb);
 // Swap buffers (present back buffer to screen)
 void fb_swap(Framebuffer *fb);
 
+// ---------------------------------------------------------------------------
+// Damage tracking (partial fb_swap)
+//
+// By default fb_swap() copies the whole logical surface every frame. With
+// tracking on, every drawing primitive and blit in this file records the
+// rectangle it touched, and fb_swap() copies only those — merged, and falling
+// back to one full copy past FB_DAMAGE_FULL_PERCENT coverage. A frame that
+// changed a score digit then writes a few hundred bytes to the panel instead of
+// ~1.5 MB.
+//
+// Opt-in, because it is only correct if the panel is only ever written through
+// this file: code that writes fb->back_buffer directly (ScummVM, vnc_client)
+// must either leave tracking off or report what it wrote with fb_mark_dirty().
+// It also only pays off for an app that stops clearing the whole screen every
+// frame — fb_clear() marks everything dirty, as it should.
+// ---------------------------------------------------------------------------
+
+// Turn tracking on or off. Either way the next swap is a full copy, so the
+// panel and the back buffer start out identical.
+void fb_set_damage_tracking(Framebuffer *fb, bool on);
+
+// Report a rectangle written behind the primitives' back, in logical
+// coordinates (the draw offset is NOT applied — direct writes do not see it).
+void fb_mark_dirty(Framebuffer *fb, int x, int y, int w, int h);
+
+// Make the next swap a full copy.
+void fb_mark_all_dirty(Framebuffer *fb);
+
+// ---------------------------------------------------------------------------
+// Page flipping (zero-copy fb_swap)
+//
+// Normally the back buffer is malloc'd and fb_swap() copies it to the panel —
+// one extra full-frame write per frame, ~1.5 MB at 32bpp. With page flipping
+// requested, fb_init() asks the driver for a virtual height of two panels and
+// points back_buffer straight at the hidden one; fb_swap() then pans the
+// display to it with FBIOPAN_DISPLAY and, if asked, waits for vsync — no copy,
+// and no tearing.
+//
+// Call fb_request_page_flip() BEFORE fb_init(), like fb_set_bpp(). It is a
+// request, not a guarantee: fb_init() falls back to the copying swap, with a
+// line on stdout, when the driver refuses the larger virtual size, in portrait
+// mode (the rotation IS the copy), or when the visible rectangle is not whole
+// rows of the panel (a left/right bezel or a padded line_length) — back_buffer
+// keeps its width-stride layout either way, so nothing that indexes it needs to
+// know. fb->page_flip says which one you got.
+//
+// ⚠️ What an app gives up: after fb_swap() the back buffer holds the frame
+// BEFORE last, not the one just shown. An app that redraws the whole screen
+// every frame (fb_clear first) cannot tell; one that draws incrementally over
+// the previous frame must not opt in. Damage tracking is ignored while
+// flipping, for the same reason.
+// ---------------------------------------------------------------------------
+void fb_request_page_flip(bool on, bool wait_vsync);
+
 // Clear screen with color
 void fb_clear(Framebuffer *fb, uint32_t color);
 
@@ -177,6 +255,12 @@ void fb_fill_circle(Framebuffer *fb, int cx, int cy, int radius, uint32_t color)
 // Draw text (simple bitmap font — lowercase mapped to uppercase automatically)
 void fb_draw_text(Framebuffer *fb, int x, int y, const char *text, uint32_t color, int scale);
 
+// Size of a string as fb_draw_text() lays it out: 6*scale per character (a
+// 5-column glyph plus one column of spacing, including after the last one) by
+// 7*scale. common.c's text_measure_width()/text_measure_height() are these.
+int fb_text_width(const char *text, int scale);
+int fb_text_height(int scale);
+
 // Draw filled rounded rectangle (r = corner radius)
 void fb_fill_rounded_rect(Framebuffer *fb, int x, int y, int w, int h, int r, uint32_t color);
 
@@ -265,4 +349,75 @@ void fb_blit_sprite_scaled(Framebuffer *fb, const uint32_t *src_pixels, int src_
                            int dx, int dy, int dw, int dh,
                            uint32_t color_key);
 
+// Compiled sprites — for art that is loaded once and drawn every frame.
+//
+// fb_sprite_compile() takes the same source rectangle and colour key as
+// fb_blit_sprite() and turns it, once, into per-row lists of opaque runs whose
+// pixels are already packed for fb's depth. fb_draw_sprite() /
+// fb_draw_sprite_flipped() then draw exactly what fb_blit_sprite() /
+// fb_blit_sprite_flipped() would, with no per-pixel key test or packing:
+// clipped, honouring the draw offset, and recorded as damage.
+//
+// fb_sprite_compile_alpha() is the same for art with an alpha channel: the top
+// byte of each source pixel is straight (non-premultiplied) alpha, 0 skipped,
+// 255 opaque, anything between blended over the surface when drawn. No colour
+// key — a magenta pixel with alpha 255 is magenta.
+//
+// A sprite belongs to the depth it was compiled at; drawn onto a surface of
+// another depth it draws nothing. Returns NULL on bad size or out of memory.
+typedef struct FbSprite FbSprite;
+
+FbSprite *fb_sprite_compile(const Framebuffer *fb, const uint32_t *src_pixels, int src_w,
+                            int sx, int sy, int w, int h, uint32_t color_key);
+FbSprite *fb_sprite_compile_alpha(const Framebuffer *fb, const uint32_t *src_pixels, int src_w,
+                                  int sx, int sy, int w, int h);
+void fb_sprite_free(FbSprite *spr);
+void fb_draw_sprite(Framebuffer *fb, const FbSprite *spr, int dx, int dy);
+void fb_draw_sprite_flipped(Framebuffer *fb, const FbSprite *spr, int dx, int dy);
+
+// Offscreen surfaces — draw once, blit every frame.
+//
+// A Surface IS a Framebuffer with no panel behind it: its back_buffer is its
+// pixels, in the same format as the screen it was made for, so every fb_*
+// primitive above draws into it unchanged (fb_fill_rect(&surf, ...)).
+// fb_swap() on it does nothing; free it with fb_surface_free().
+//
+// fb_blit_surface() copies a rectangle of one onto fb, opaque, one memcpy per
+// row: clipped on both sides, honouring fb's draw offset, and recorded as
+// damage. fb_blit_surface_keyed() skips the pixels equal to color_key (as the
+// surface stores it: compared after packing at 16bpp). A surface of another
+// depth than fb is not drawn. Either may blit a surface onto itself, the two
+// rectangles overlapping: the result is as if the source were read first.
+typedef Framebuffer Surface;
+
+int  fb_surface_init(Surface *surf, const Framebuffer *like, int w, int h);
+void fb_surface_free(Surface *surf);
+void fb_blit_surface(Framebuffer *fb, const Surface *src,
+                     int sx, int sy, int dx, int dy, int w, int h);
+void fb_blit_surface_keyed(Framebuffer *fb, const Surface *src,
+                           int sx, int sy, int dx, int dy, int w, int h,
+                           uint32_t color_key);
+
+// A cached layer: a Surface plus the function that paints it. The paint
+// function runs on the first use and after each fb_layer_invalidate(), onto a
+// surface cleared to black; every other fb_layer_blit() is just the copy. So a
+// game's static chrome — borders, labels, a pre-drawn playfield — costs one
+// memcpy per row per frame instead of its primitives, and is rebuilt only when
+// the game says it changed (new level, new layout).
+typedef void (*FbLayerPaint)(Surface *surf, void *user);
+
+typedef struct {
+    Surface surface;
+    FbLayerPaint paint;
+    void *user;
+    bool valid;             // surface holds what paint() would draw now
+} FbLayer;
+
+int      fb_layer_init(FbLayer *layer, const Framebuffer *like, int w, int h,
+                       FbLayerPaint paint, void *user);
+void     fb_layer_invalidate(FbLayer *layer);
+Surface *fb_layer_surface(FbLayer *layer);      // repainted first if invalid
+void     fb_layer_blit(Framebuffer *fb, FbLayer *layer, int dx, int dy);
+void     fb_layer_free(FbLayer *layer);
+
 #endif
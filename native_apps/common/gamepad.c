@@ -17,6 +17,9 @@
 
 #include "gamepad.h"
 #include "framebuffer.h"
+#include "input_rec.h"
+#include "input_lat.h"
+#include "input_hotplug.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -141,7 +144,12 @@ static void load_axis_calibration(GamepadManager *gm) {
 
     for (int i = 0; i < GAMEPAD_MAX_AXES; i++) {
         struct input_absinfo info;
-        if (ioctl(gm->gamepad_fd, EVIOCGABS(axes[i]), &info) == 0) {
+        /* Through input_rec when linked: a replayed pad is a pipe, and its
+         * ranges come from the recording (input_rec.h, THE FILE). */
+        int rc = input_rec_absinfo
+               ? input_rec_absinfo(INPUT_REC_GAMEPAD, gm->gamepad_fd, axes[i], &info)
+               : ioctl(gm->gamepad_fd, EVIOCGABS(axes[i]), &info);
+        if (rc == 0) {
             gm->axis_min[i]  = info.minimum;
             gm->axis_max[i]  = info.maximum;
             gm->axis_flat[i] = info.flat;
@@ -212,47 +220,132 @@ static int normalize_axis(int value, int min_val, int max_val) {
     return normalized;
 }
 
-/* ── Scan /dev/input/event* for gamepad, keyboard, and mouse ────────────── */
-static void scan_devices(GamepadManager *gm) {
-    char path[64];
+/* ── Device slots ───────────────────────────────────────────────────────── */
+static int *slot_fd(GamepadManager *gm, GDevType type) {
+    switch (type) {
+        case GDEV_GAMEPAD:  return &gm->gamepad_fd;
+        case GDEV_KEYBOARD: return &gm->keyboard_fd;
+        case GDEV_MOUSE:    return &gm->mouse_fd;
+        default:            return NULL;
+    }
+}
+
+static bool slots_full(const GamepadManager *gm) {
+    return gm->gamepad_fd >= 0 && gm->keyboard_fd >= 0 && gm->mouse_fd >= 0;
+}
+
+/* Open one event node and, if it classifies into an EMPTY slot, keep it
+ * there.  Returns the slot it filled, or GDEV_UNKNOWN (node closed). */
+static GDevType open_node(GamepadManager *gm, const char *path) {
     char name[128];
 
-    for (int i = 0; i < GAMEPAD_MAX_DEVICES; i++) {
-        snprintf(path, sizeof(path), "/dev/input/event%d", i);
+    int fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) return GDEV_UNKNOWN;
 
-        int fd = open(path, O_RDONLY | O_NONBLOCK);
-        if (fd < 0) continue;
+    /* Read device name */
+    name[0] = '\0';
+    ioctl(fd, EVIOCGNAME(sizeof(name)), name);
+
+    /* Filter out Panjit touchscreen (same as usb_test.c) */
+    if (strstr(name, "panjit") || strstr(name, "Panjit") || strstr(name, "PANJIT")) {
+        close(fd);
+        return GDEV_UNKNOWN;
+    }
 
-        /* Read device name */
-        name[0] = '\0';
-        ioctl(fd, EVIOCGNAME(sizeof(name)), name);
+    GDevType type = classify_device(fd);
+    int *slot = slot_fd(gm, type);
+    if (!slot || *slot >= 0) {
+        close(fd);
+        return GDEV_UNKNOWN;
+    }
+    *slot = fd;
+    printf("gamepad: found %s '%s' at %s\n",
+           type == GDEV_GAMEPAD ? "gamepad" : type == GDEV_KEYBOARD ? "keyboard" : "mouse",
+           name, path);
+    return type;
+}
 
-        /* Filter out Panjit touchscreen (same as usb_test.c) */
-        if (strstr(name, "panjit") || strstr(name, "Panjit") || strstr(name, "PANJIT")) {
-            close(fd);
-            continue;
-        }
+/* Finish a slot that was empty before this scan.  Under replay (input_rec.h)
+ * its fd becomes the recording's pipe for that source, whatever is actually
+ * plugged in — or -1 if the session never used it.  Otherwise it comes back
+ * unchanged.  Slots that were already filled are left alone: under replay they
+ * hold their pipe already, and another dup would only change the fd under
+ * input_hub. */
+static void settle_slot(GamepadManager *gm, GDevType type) {
+    static const InputRecSource rec_src[] = {
+        [GDEV_GAMEPAD]  = INPUT_REC_GAMEPAD,
+        [GDEV_KEYBOARD] = INPUT_REC_KEYBOARD,
+        [GDEV_MOUSE]    = INPUT_REC_MOUSE,
+    };
+    int *slot = slot_fd(gm, type);
+    int was = *slot;
+    if (input_rec_device) *slot = input_rec_device(rec_src[type], *slot);
+    /* After the swap, so a replayed pad is normalised to the recorded ranges. */
+    if (type == GDEV_GAMEPAD && gm->gamepad_fd >= 0)
+        load_axis_calibration(gm);
+    if (was >= 0 || *slot >= 0) gm->devices_changed++;
+}
 
-        GDevType type = classify_device(fd);
-
-        if (type == GDEV_GAMEPAD && gm->gamepad_fd < 0) {
-            gm->gamepad_fd = fd;
-            load_axis_calibration(gm);
-            printf("gamepad: found gamepad '%s' at %s\n", name, path);
-        } else if (type == GDEV_KEYBOARD && gm->keyboard_fd < 0) {
-            gm->keyboard_fd = fd;
-            printf("gamepad: found keyboard '%s' at %s\n", name, path);
-        } else if (type == GDEV_MOUSE && gm->mouse_fd < 0) {
-            gm->mouse_fd = fd;
-            printf("gamepad: found mouse '%s' at %s\n", name, path);
-        } else {
-            close(fd);
-        }
+/* ── Scan /dev/input/event* for whatever is still missing ───────────────── */
+/* The full scan: at init, after an unplug, and when the hotplug watcher lost
+ * events or is not available.  Arrivals otherwise go through adopt_node(). */
+static void scan_devices(GamepadManager *gm) {
+    char path[64];
+    bool was_empty[GDEV_MOUSE + 1];
+    for (int t = GDEV_KEYBOARD; t <= GDEV_MOUSE; t++)
+        was_empty[t] = *slot_fd(gm, (GDevType)t) < 0;
+
+    /* Stop early once all three are found — including before the first open,
+     * which is what makes a rescan with everything attached free. */
+    for (int i = 0; i < GAMEPAD_MAX_DEVICES && !slots_full(gm); i++) {
+        snprintf(path, sizeof(path), INPUT_HOTPLUG_DIR "/event%d", i);
+        open_node(gm, path);
+    }
+
+    for (int t = GDEV_KEYBOARD; t <= GDEV_MOUSE; t++)
+        if (was_empty[t]) settle_slot(gm, (GDevType)t);
+}
+
+/* ── A node the hotplug watcher reported ────────────────────────────────── */
+static void adopt_node(GamepadManager *gm, const char *path) {
+    /* The create and the chmod after it are two reports for one node, and the
+     * init scan may already hold a node whose create is still queued. */
+    if (slots_full(gm) ||
+        input_hotplug_same_node(gm->gamepad_fd,  path) ||
+        input_hotplug_same_node(gm->keyboard_fd, path) ||
+        input_hotplug_same_node(gm->mouse_fd,    path))
+        return;
+    GDevType type = open_node(gm, path);
+    if (type != GDEV_UNKNOWN) settle_slot(gm, type);
+}
+
+/* ── A device whose read() failed with ENODEV: it was unplugged ─────────── */
+static void drop_device(GamepadManager *gm, int *fd, const char *what) {
+    printf("gamepad: %s unplugged\n", what);
+    close(*fd);
+    *fd = -1;
+    /* The key-up for anything held at unplug time will never arrive, so
+     * keeping its latched level would freeze that button on.  Clearing all of
+     * them costs at most one re-press on the device that is still there. */
+    memset(gm->held_latched, 0, sizeof(gm->held_latched));
+    gm->devices_changed++;
+    /* Another device of the same kind may have been plugged in while the slot
+     * was taken, and a node it never reported again — one scan picks it up. */
+    scan_devices(gm);
+}
 
-        /* Stop early if all three found */
-        if (gm->gamepad_fd >= 0 && gm->keyboard_fd >= 0 && gm->mouse_fd >= 0)
-            break;
+static void poll_hotplug(GamepadManager *gm) {
+    char path[96];
+    int watch_fd = gm->hotplug.fd;
+    InputHotplugChange c;
+    while ((c = input_hotplug_next(&gm->hotplug, path, sizeof(path))) != INPUT_HOTPLUG_NONE) {
+        if (c == INPUT_HOTPLUG_ADDED) adopt_node(gm, path);
+        else                          scan_devices(gm);
     }
+    /* The watch went away (IN_IGNORED) and the watcher closed its fd for the
+     * fallback timer.  input_hub registered that fd too, so it is news to a
+     * re-tracking caller like any device fd closing. */
+    if (watch_fd >= 0 && gm->hotplug.fd < 0) gm->devices_changed++;
 }
 
 /* ── Apply sensible defaults to all configurable fields ─────────────────── */
@@ -466,6 +559,9 @@ int gamepad_init(GamepadManager *gm) {
     gamepad_load_config(gm, GAMEPAD_CONFIG_PATH);
 
     scan_devices(gm);
+    /* After the scan: the watcher reports arrivals from here on.  Without
+     * inotify it falls back to asking for a scan every few seconds. */
+    input_hotplug_open(&gm->hotplug, NULL);
 
     printf("gamepad: init complete (gamepad=%s, keyboard=%s, mouse=%s)\n",
            gm->gamepad_fd >= 0 ? "connected" : "none",
@@ -474,7 +570,7 @@ int gamepad_init(GamepadManager *gm) {
     return 0;
 }
 
-void gamepad_close(GamepadManager *gm) {
+static void close_devices(GamepadManager *gm) {
     if (gm->gamepad_fd >= 0) {
         close(gm->gamepad_fd);
         gm->gamepad_fd = -1;
@@ -487,11 +583,17 @@ void gamepad_close(GamepadManager *gm) {
         close(gm->mouse_fd);
         gm->mouse_fd = -1;
     }
+    gm->devices_changed++;
+}
+
+void gamepad_close(GamepadManager *gm) {
+    close_devices(gm);
+    input_hotplug_close(&gm->hotplug);
 }
 
 void gamepad_rescan(GamepadManager *gm) {
     /* Close existing devices and re-scan */
-    gamepad_close(gm);
+    close_devices(gm);
     memset(gm->prev_held, 0, sizeof(gm->prev_held));
     /* Drop the latched levels too: the key-up for anything held at unplug time
      * will never arrive, so keeping it would freeze that button on. */
@@ -559,7 +661,10 @@ static void poll_gamepad(GamepadManager *gm, InputState *state) {
     struct input_event ev;
     GamepadButtonMap *m = &gm->button_map;
 
-    while (read(gm->gamepad_fd, &ev, sizeof(ev)) == (ssize_t)sizeof(ev)) {
+    ssize_t n;
+    while ((n = read(gm->gamepad_fd, &ev, sizeof(ev))) == (ssize_t)sizeof(ev)) {
+        if (input_rec_event) input_rec_event(INPUT_REC_GAMEPAD, &ev);
+        if (input_lat_event) input_lat_event(&ev);
 
         if (ev.type == EV_ABS) {
             int code = ev.code;
@@ -638,6 +743,9 @@ static void poll_gamepad(GamepadManager *gm, InputState *state) {
                 gm->held_latched[BTN_ID_BACK] = down;
         }
     }
+    /* Unplugged: the next poll's fd < 0 branch zeroes the axes. */
+    if (n < 0 && errno == ENODEV)
+        drop_device(gm, &gm->gamepad_fd, "gamepad");
 }
 
 /* ── Merge the left analog stick into the D-pad directions ──────────────── */
@@ -677,7 +785,10 @@ static void poll_keyboard(GamepadManager *gm) {
     if (gm->keyboard_fd < 0) return;
 
     struct input_event ev;
-    while (read(gm->keyboard_fd, &ev, sizeof(ev)) == (ssize_t)sizeof(ev)) {
+    ssize_t n;
+    while ((n = read(gm->keyboard_fd, &ev, sizeof(ev))) == (ssize_t)sizeof(ev)) {
+        if (input_rec_event) input_rec_event(INPUT_REC_KEYBOARD, &ev);
+        if (input_lat_event) input_lat_event(&ev);
         if (ev.type != EV_KEY) continue;
 
         bool down = (ev.value != 0); /* value 1 = press, 2 = repeat, 0 = release */
@@ -719,6 +830,8 @@ static void poll_keyboard(GamepadManager *gm) {
                 break;
         }
     }
+    if (n < 0 && errno == ENODEV)
+        drop_device(gm, &gm->keyboard_fd, "keyboard");
 }
 
 /* ── Read mouse events with acceleration ────────────────────────────────── */
@@ -731,7 +844,10 @@ static void poll_mouse(GamepadManager *gm, InputState *state) {
     bool right_held = state->mouse_right_held ? true : false;
     bool middle_held = state->mouse_middle_held ? true : false;
 
-    while (read(gm->mouse_fd, &ev, sizeof(ev)) == (ssize_t)sizeof(ev)) {
+    ssize_t n;
+    while ((n = read(gm->mouse_fd, &ev, sizeof(ev))) == (ssize_t)sizeof(ev)) {
+        if (input_rec_event) input_rec_event(INPUT_REC_MOUSE, &ev);
+        if (input_lat_event) input_lat_event(&ev);
 
         if (ev.type == EV_REL) {
             if (ev.code == REL_X)
@@ -750,6 +866,12 @@ static void poll_mouse(GamepadManager *gm, InputState *state) {
         }
         /* EV_SYN ignored — we batch all events in the read loop */
     }
+    if (n < 0 && errno == ENODEV) {
+        /* Unplugged: its button-ups will never come.  Released here, so the
+         * edge pass reports them as releases rather than holding them. */
+        drop_device(gm, &gm->mouse_fd, "mouse");
+        left_held = right_held = middle_held = false;
+    }
 
     /* Apply mouse acceleration to accumulated delta */
     if (accum_dx != 0 || accum_dy != 0) {
@@ -846,6 +968,10 @@ static void compute_mouse_edges(GamepadManager *gm, InputState *state) {
 
 void gamepad_poll(GamepadManager *gm, InputState *state,
                   int touch_x, int touch_y, bool touch_active) {
+    /* Devices plugged in since the last poll, classified one node at a time
+     * (input_hotplug.h).  First, so the flags below already count them. */
+    poll_hotplug(gm);
+
     state->gamepad_connected  = (gm->gamepad_fd >= 0);
     state->keyboard_connected = (gm->keyboard_fd >= 0);
     state->mouse_connected    = (gm->mouse_fd >= 0) ? 1 : 0;
@@ -24,6 +24,8 @@ extern "C" {
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "input_hotplug.h"
+
 /* Maximum devices to scan — bumped to 32 because USB keyboards/mice are
    often assigned event numbers >= 16 when built-in devices occupy lower slots */
 #define GAMEPAD_MAX_DEVICES 32
@@ -198,18 +200,30 @@ typedef struct {
     int mouse_x, mouse_y;                  /* Accumulated absolute position */
     int mouse_screen_w, mouse_screen_h;    /* Bounds for clamping */
     MouseAccelConfig mouse_accel;          /* Acceleration parameters */
+
+    /* Hotplug: gamepad_poll() classifies new event nodes as inotify reports
+     * them, and drops a device whose read() fails with ENODEV — no rescan
+     * timer needed (input_hotplug.h). */
+    InputHotplug hotplug;
+
+    /* Bumped whenever any of the three fds above is opened, closed or
+     * replaced, and when the hotplug watcher closes its own.  Keep a copy and
+     * compare: a change means anything holding the old fds (input_hub's epoll
+     * set) has to re-register. */
+    uint32_t devices_changed;
 } GamepadManager;
 
 /**
  * Initialize the gamepad manager — scans /dev/input/event* for gamepad,
- * keyboard, and mouse.  Automatically loads config from GAMEPAD_CONFIG_PATH
- * if the file exists.
- * Returns 0 on success (even if no devices found — they can be hot-plugged).
+ * keyboard, and mouse, then watches the directory for new ones.
+ * Automatically loads config from GAMEPAD_CONFIG_PATH if the file exists.
+ * Returns 0 on success (even if no devices found — they can be hot-plugged,
+ * and gamepad_poll() picks them up).
  */
 int gamepad_init(GamepadManager *gm);
 
 /**
- * Close all open device fds.
+ * Close all open device fds and the hotplug watcher.
  */
 void gamepad_close(GamepadManager *gm);
 
@@ -222,7 +236,9 @@ void gamepad_poll(GamepadManager *gm, InputState *state,
                   int touch_x, int touch_y, bool touch_active);
 
 /**
- * Re-scan for devices (call periodically or on hotplug).
+ * Close every device and scan again from scratch.  Not needed for hotplug —
+ * gamepad_poll() adopts new devices and drops unplugged ones by itself; this
+ * is for a caller that wants the devices reopened (a config change).
  */
 void gamepad_rescan(GamepadManager *gm);
 
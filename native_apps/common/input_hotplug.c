@@ -0,0 +1,98 @@
+#include "input_hotplug.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+
+/* Create for devtmpfs/mknod, attrib for the mode mdev sets afterwards (the
+ * node may not be openable before it), moved-to for a udev that renames a
+ * temporary node into place. */
+#define HOTPLUG_MASK (IN_CREATE | IN_ATTRIB | IN_MOVED_TO | IN_ONLYDIR)
+
+static uint64_t mono_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000ULL;
+}
+
+/** "event" and at least one digit, nothing else: js*, mouse*, mice and the
+ *  by-id/by-path directories are other views of the same devices. */
+static bool is_event_node(const char *name)
+{
+    if (strncmp(name, "event", 5) != 0 || !name[5]) return false;
+    for (const char *p = name + 5; *p; p++)
+        if (*p < '0' || *p > '9') return false;
+    return true;
+}
+
+int input_hotplug_open(InputHotplug *hp, const char *dir)
+{
+    memset(hp, 0, sizeof(*hp));
+    snprintf(hp->dir, sizeof(hp->dir), "%s", dir ? dir : INPUT_HOTPLUG_DIR);
+    hp->last_scan_ms = mono_ms();
+
+    hp->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (hp->fd < 0) return -1;
+    if (inotify_add_watch(hp->fd, hp->dir, HOTPLUG_MASK) < 0) {
+        close(hp->fd);
+        hp->fd = -1;
+        return -1;
+    }
+    return 0;
+}
+
+void input_hotplug_close(InputHotplug *hp)
+{
+    if (hp->fd >= 0) close(hp->fd);
+    hp->fd  = -1;
+    hp->len = hp->off = 0;
+}
+
+InputHotplugChange input_hotplug_next(InputHotplug *hp, char *path, size_t size)
+{
+    if (hp->fd < 0) {
+        uint64_t now = mono_ms();
+        if (now - hp->last_scan_ms < INPUT_HOTPLUG_RESCAN_MS) return INPUT_HOTPLUG_NONE;
+        hp->last_scan_ms = now;
+        return INPUT_HOTPLUG_RESCAN;
+    }
+
+    for (;;) {
+        if (hp->off >= hp->len) {
+            /* read() on inotify returns whole records only, never a torn one. */
+            ssize_t n = read(hp->fd, hp->buf, sizeof(hp->buf));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return INPUT_HOTPLUG_NONE;
+            hp->len = (int)n;
+            hp->off = 0;
+        }
+        const struct inotify_event *ie =
+            (const struct inotify_event *)((const char *)hp->buf + hp->off);
+        hp->off += (int)(sizeof(*ie) + ie->len);
+
+        if (ie->mask & IN_Q_OVERFLOW) return INPUT_HOTPLUG_RESCAN;
+        if (ie->mask & IN_IGNORED) {
+            /* The watch is gone (the directory was removed or unmounted):
+             * nothing more will come from it, so fall back to the timer. */
+            input_hotplug_close(hp);
+            hp->last_scan_ms = mono_ms();
+            return INPUT_HOTPLUG_RESCAN;
+        }
+        if ((ie->mask & IN_ISDIR) || !ie->len || !is_event_node(ie->name)) continue;
+
+        if (path && size) snprintf(path, size, "%s/%s", hp->dir, ie->name);
+        return INPUT_HOTPLUG_ADDED;
+    }
+}
+
+bool input_hotplug_same_node(int fd, const char *path)
+{
+    struct stat a, b;
+    if (fd < 0 || !path || fstat(fd, &a) != 0 || stat(path, &b) != 0) return false;
+    return a.st_dev == b.st_dev && a.st_ino == b.st_ino;
+}
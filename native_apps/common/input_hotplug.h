@@ -0,0 +1,90 @@
+#ifndef INPUT_HOTPLUG_H
+#define INPUT_HOTPLUG_H
+
+/**
+ * input_hotplug — notice new /dev/input/event* nodes as they appear.
+ *
+ * Every input layer used to find a late controller the same way: a timer in
+ * the main loop (every game's RESCAN_INTERVAL_MS, vnc_input's and ScummVM's
+ * DEVICE_SCAN_INTERVAL) that opened EVERY event node and ran three or four
+ * EVIOCGBIT ioctls on each, every five seconds, mostly to learn that nothing
+ * had changed.  That is a burst of syscalls in the middle of a frame, a log
+ * line per device per scan, and up to five seconds between plugging a pad in
+ * and the game seeing it.
+ *
+ * This file watches the directory with inotify instead.  The kernel (devtmpfs,
+ * then mdev fixing the mode) creates the node when the device registers, so
+ * the watcher hands the caller that one path within a frame and the caller
+ * classifies only it.  A loop that draws nothing until input arrives can put
+ * the fd in its epoll set (input_hub does) and wake for the plug itself.
+ *
+ * ── WHAT IT REPORTS ──────────────────────────────────────────────────────────
+ *
+ * Only arrivals.  An unplugged device is noticed by its reader: read() on the
+ * open fd fails with ENODEV from the moment the device is gone, which is both
+ * earlier and more certain than the node's deletion, and it is the reader that
+ * owns the fd and the state to clear.  After dropping a device, scan again for
+ * what is still missing — a second pad that was plugged while the slot was
+ * full gets its turn that way.
+ *
+ * ⚠️ **An ADDED path can be one the caller already has open.**  The create
+ * and the mode change that follows it are two events for one node, and a scan
+ * at start-up may already have opened a node whose create is still queued.
+ * Check with input_hotplug_same_node() before adopting it twice.
+ *
+ * ── WITHOUT INOTIFY ──────────────────────────────────────────────────────────
+ *
+ * If inotify or the watch cannot be had (an old kernel, no /dev/input yet, the
+ * watch dropped), input_hotplug_next() degrades to the old timer: it answers
+ * INPUT_HOTPLUG_RESCAN once every INPUT_HOTPLUG_RESCAN_MS.  A lost queue
+ * (IN_Q_OVERFLOW) also answers RESCAN, once.  Callers therefore keep their full
+ * scan — they just stop calling it on a clock.
+ *
+ * Plain C and libc, no pthread; usable from C++ (ScummVM's backend).
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define INPUT_HOTPLUG_DIR        "/dev/input"
+#define INPUT_HOTPLUG_RESCAN_MS  5000   /* the fallback timer, as the old scans */
+
+typedef enum {
+    INPUT_HOTPLUG_NONE = 0,             /* nothing new                           */
+    INPUT_HOTPLUG_ADDED,                /* `path` is an event node to classify   */
+    INPUT_HOTPLUG_RESCAN,               /* events lost or no watcher: scan all   */
+} InputHotplugChange;
+
+typedef struct {
+    int      fd;                        /* inotify fd, -1 = on the fallback timer */
+    char     dir[64];
+    uint64_t last_scan_ms;              /* the fallback timer's last RESCAN       */
+    int      len, off;                  /* unconsumed bytes of buf                */
+    uint32_t buf[256];                  /* struct inotify_event records; u32 for alignment */
+} InputHotplug;
+
+/** Watch `dir` (NULL = INPUT_HOTPLUG_DIR).  Returns 0, or -1 with hp->fd == -1
+ *  and the fallback timer running — the watcher is still usable either way.
+ *  The caller is expected to have scanned once already; nothing is reported
+ *  for nodes that exist before the call. */
+int  input_hotplug_open(InputHotplug *hp, const char *dir);
+void input_hotplug_close(InputHotplug *hp);
+
+/** The next change, without blocking.  For ADDED, the node's full path is
+ *  written to `path`.  Call until it returns INPUT_HOTPLUG_NONE. */
+InputHotplugChange input_hotplug_next(InputHotplug *hp, char *path, size_t size);
+
+/** True if `fd` is open on the node at `path` (same inode), so an ADDED for a
+ *  device the caller already holds can be skipped without opening it. */
+bool input_hotplug_same_node(int fd, const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INPUT_HOTPLUG_H */
@@ -0,0 +1,93 @@
+#include "input_hub.h"
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+
+static uint64_t mono_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void sleep_until(uint64_t until_ns)
+{
+    struct timespec ts;
+    ts.tv_sec  = (time_t)(until_ns / 1000000000ULL);
+    ts.tv_nsec = (long)(until_ns % 1000000000ULL);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+        ;
+}
+
+int input_hub_init(InputHub *hub)
+{
+    memset(hub, 0, sizeof(*hub));
+    for (int i = 0; i < INPUT_SRC_COUNT; i++) hub->fd[i] = -1;
+    hub->epfd = epoll_create1(EPOLL_CLOEXEC);
+    return hub->epfd >= 0 ? 0 : -1;
+}
+
+void input_hub_close(InputHub *hub)
+{
+    if (hub->epfd >= 0) close(hub->epfd);
+    hub->epfd    = -1;
+    hub->watched = 0;
+    for (int i = 0; i < INPUT_SRC_COUNT; i++) hub->fd[i] = -1;
+}
+
+void input_hub_track(InputHub *hub, int touch_fd, const GamepadManager *gm)
+{
+    /* A fresh set rather than DEL/ADD pairs: a DEL of an fd that was closed and
+     * reopened under the same number fails, and a stale ADD succeeds. */
+    if (hub->epfd >= 0) close(hub->epfd);
+    hub->epfd    = epoll_create1(EPOLL_CLOEXEC);
+    hub->watched = 0;
+
+    int want[INPUT_SRC_COUNT] = {
+        touch_fd,
+        gm ? gm->gamepad_fd  : -1,
+        gm ? gm->keyboard_fd : -1,
+        gm ? gm->mouse_fd    : -1,
+        gm ? gm->hotplug.fd  : -1,
+    };
+    for (int i = 0; i < INPUT_SRC_COUNT; i++) {
+        hub->fd[i] = -1;
+        if (hub->epfd < 0 || want[i] < 0) continue;
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events   = EPOLLIN | EPOLLET;
+        ev.data.u32 = (uint32_t)i;
+        if (epoll_ctl(hub->epfd, EPOLL_CTL_ADD, want[i], &ev) == 0) {
+            hub->fd[i] = want[i];
+            hub->watched++;
+        }
+    }
+}
+
+bool input_hub_wait(uint64_t until_ns, void *user)
+{
+    InputHub *hub = (InputHub *)user;
+    uint64_t now = mono_ns();
+
+    while (hub && hub->epfd >= 0 && hub->watched > 0 && until_ns > now) {
+        /* Whole milliseconds only: epoll rounds its timeout UP, and a wait
+         * that overshoots the deadline is an overrun frame_sched would count. */
+        int ms = (int)((until_ns - now) / 1000000ULL);
+        struct epoll_event ev[INPUT_SRC_COUNT];
+        int n = epoll_wait(hub->epfd, ev, INPUT_SRC_COUNT, ms);
+        now = mono_ns();
+        if (n > 0) {
+            hub->wakes++;
+            hub->last_wake_ns = now;
+            hub->last_src     = (InputSource)ev[0].data.u32;
+            return true;
+        }
+        if (n < 0 && errno == EINTR) continue;     /* recompute what is left */
+        break;                                     /* timed out, or no epoll */
+    }
+    if (until_ns > now) sleep_until(until_ns);
+    return false;
+}
@@ -0,0 +1,90 @@
+#ifndef INPUT_HUB_H
+#define INPUT_HUB_H
+
+/**
+ * input_hub — let a main loop's idle wait end the moment input arrives.
+ *
+ * Every loop polls its devices at the top of a frame and then sleeps to the
+ * frame's deadline.  On an IDLE frame that deadline is FRAME_DELAY_IDLE_US
+ * away, so a tap landing just after the poll waited up to 100 ms before anything
+ * read it — the launcher, which spends nearly all its life idle, felt it on
+ * every first tap.  This file registers the loop's evdev fds with one epoll
+ * set and hands frame_sched a wait that returns early when any of them becomes
+ * readable (frame_sched_set_wait()), so an idle screen still wakes ten times a
+ * second at most, but reacts to a tap within the epoll wakeup.
+ *
+ * ── WHAT IT DOES NOT DO ──────────────────────────────────────────────────────
+ *
+ * It never read()s.  touch_poll() and gamepad_poll() stay the only readers of
+ * their fds, because the per-device state machines — press/release edges, the
+ * latched key levels, the mouse accumulator — live there and nowhere else, and
+ * a second reader would split one device's events between two owners.  The
+ * hub is readiness plus a timestamp: when the last wake happened and which
+ * source caused it, which is what a latency measurement needs to start from.
+ *
+ * ── EDGE-TRIGGERED, ON PURPOSE ───────────────────────────────────────────────
+ *
+ * ⚠️ **EPOLLET, not level.**  A loop that registers a device it does not drain
+ * every frame (a gamepad fd on a screen that ignores the pad) would otherwise
+ * see it readable on every wait and spin at 100 % CPU — the opposite of the
+ * point.  Edge-triggered reports each ARRIVAL once; the cost is at most one
+ * spurious early wake when data arrived during the frame's work and was already
+ * drained by its poll.
+ *
+ * ── RE-REGISTRATION ──────────────────────────────────────────────────────────
+ *
+ * ⚠️ **Call input_hub_track() after anything that reopens a device** —
+ * gamepad_rescan() closes and reopens every fd, gamepad_poll() opens and closes
+ * them as devices come and go (GamepadManager.devices_changed says when), and
+ * the launcher re-inits touch after each child.  epoll drops a closed file silently, and a reopened device
+ * usually gets the SAME fd number back, so comparing numbers cannot tell a live
+ * registration from a dead one.  track() therefore rebuilds the set outright:
+ * one epoll_create1() and at most five adds.
+ *
+ * The fifth is the GamepadManager's hotplug watcher (input_hotplug.h): an idle
+ * screen wakes for a controller being plugged in, not only for its first
+ * button, and the poll that follows adopts it.
+ *
+ * Plain libc, no pthread: epoll_wait() for whole milliseconds, then an absolute
+ * clock_nanosleep() for the remainder, so the deadline keeps frame_sched's
+ * precision rather than epoll's.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "gamepad.h"
+
+typedef enum {
+    INPUT_SRC_TOUCH = 0,
+    INPUT_SRC_GAMEPAD,
+    INPUT_SRC_KEYBOARD,
+    INPUT_SRC_MOUSE,
+    INPUT_SRC_HOTPLUG,                  /* a new /dev/input node, not input     */
+    INPUT_SRC_COUNT
+} InputSource;
+
+typedef struct {
+    int         epfd;                   /* -1 before init / after close          */
+    int         fd[INPUT_SRC_COUNT];    /* what is registered, -1 = none         */
+    int         watched;                /* how many of them                      */
+    uint32_t    wakes;                  /* waits that ended on input             */
+    uint64_t    last_wake_ns;           /* CLOCK_MONOTONIC of the latest         */
+    InputSource last_src;               /* and which source it was               */
+} InputHub;
+
+/** Returns 0, or -1 if epoll is unavailable (the hub then just sleeps). */
+int  input_hub_init(InputHub *hub);
+void input_hub_close(InputHub *hub);
+
+/** Register the touch fd, the GamepadManager's three and its hotplug watcher;
+ *  -1s are skipped.
+ *  Rebuilds the set — see RE-REGISTRATION above. */
+void input_hub_track(InputHub *hub, int touch_fd, const GamepadManager *gm);
+
+/** A FrameWaitFn (frame_sched.h): sleep until `until_ns` on CLOCK_MONOTONIC,
+ *  or until a registered fd becomes readable.  `user` is the InputHub.
+ *  Returns true iff input ended the wait. */
+bool input_hub_wait(uint64_t until_ns, void *user);
+
+#endif /* INPUT_HUB_H */
@@ -0,0 +1,278 @@
+#include "input_lat.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+#define LAT_MAGIC    0x4C495752u    /* "RWIL" little-endian */
+#define LAT_VERSION  1
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t bins;                  /* INPUT_LAT_BINS, checked on load */
+    char     name[INPUT_LAT_NAME_MAX];
+} LatFileHeader;
+
+/* ── The histogram ──────────────────────────────────────────────────────── */
+
+void input_lat_hist_reset(InputLatHist *h)
+{
+    if (h) memset(h, 0, sizeof(*h));
+}
+
+void input_lat_hist_add(InputLatHist *h, uint32_t us)
+{
+    if (!h) return;
+    uint32_t ms = us / 1000;
+    h->hist[ms < INPUT_LAT_BINS ? ms : INPUT_LAT_BINS - 1]++;
+    /* The first sample sets the floor, so a zeroed struct is a valid one. */
+    if (h->count == 0 || us < h->min_us) h->min_us = us;
+    if (us > h->max_us) h->max_us = us;
+    h->count++;
+    h->sum_us += us;
+}
+
+void input_lat_hist_merge(InputLatHist *dst, const InputLatHist *src)
+{
+    if (!dst || !src) return;
+    dst->stale += src->stale;
+    if (!src->count) return;
+    for (int b = 0; b < INPUT_LAT_BINS; b++) dst->hist[b] += src->hist[b];
+    if (dst->count == 0 || src->min_us < dst->min_us) dst->min_us = src->min_us;
+    if (src->max_us > dst->max_us) dst->max_us = src->max_us;
+    dst->count  += src->count;
+    dst->sum_us += src->sum_us;
+}
+
+/** The upper edge of the bin holding the `target`-th sample, never past the
+ *  slowest one actually seen — audio_gen.c's lat_edge() on this histogram. */
+static uint32_t lat_edge(const InputLatHist *h, uint32_t target)
+{
+    uint32_t cum = 0;
+    int b = 0;
+    for (; b < INPUT_LAT_BINS - 1; b++) {
+        cum += h->hist[b];
+        if (cum >= target) break;
+    }
+    uint32_t edge = (uint32_t)(b + 1) * 1000;
+    return edge < h->max_us ? edge : h->max_us;
+}
+
+void input_lat_hist_stats(const InputLatHist *h, InputLatStats *out)
+{
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!h) return;
+    out->stale = h->stale;
+    if (!h->count) return;
+
+    out->count  = h->count;
+    out->min_us = h->min_us;
+    out->max_us = h->max_us;
+    out->avg_us = (uint32_t)(h->sum_us / h->count);
+    out->p50_us = lat_edge(h, h->count - h->count / 2);
+    out->p95_us = lat_edge(h, h->count - h->count / 20);
+}
+
+char *input_lat_format(const InputLatStats *st, char *buf, size_t size)
+{
+#define MS(us) (unsigned)((us) / 1000), (unsigned)((us) % 1000 / 100)
+    snprintf(buf, size,
+             "%u inputs, %u stale; input→swap min/avg/p50/p95/max "
+             "%u.%u/%u.%u/%u.%u/%u.%u/%u.%u ms",
+             (unsigned)st->count, (unsigned)st->stale,
+             MS(st->min_us), MS(st->avg_us), MS(st->p50_us), MS(st->p95_us),
+             MS(st->max_us));
+#undef MS
+    return buf;
+}
+
+/* ── The file ───────────────────────────────────────────────────────────── */
+
+int input_lat_save(const char *path, const char *name, const InputLatHist *h)
+{
+    if (!path || !h) { errno = EINVAL; return -1; }
+
+    LatFileHeader fh;
+    memset(&fh, 0, sizeof(fh));
+    fh.magic   = LAT_MAGIC;
+    fh.version = LAT_VERSION;
+    fh.bins    = INPUT_LAT_BINS;
+    if (name) strncpy(fh.name, name, sizeof(fh.name) - 1);
+
+    /* A temp file and a rename, so device_tools never reads half of one. */
+    char tmp[256];
+    snprintf(tmp, sizeof(tmp), "%s.%d", path, (int)getpid());
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return -1;
+    bool ok = write(fd, &fh, sizeof(fh)) == (ssize_t)sizeof(fh) &&
+              write(fd, h, sizeof(*h))   == (ssize_t)sizeof(*h);
+    int saved = errno;
+    close(fd);
+    if (!ok || rename(tmp, path) != 0) {
+        if (ok) saved = errno;
+        unlink(tmp);
+        errno = saved ? saved : EIO;
+        return -1;
+    }
+    return 0;
+}
+
+int input_lat_load(const char *path, char name[INPUT_LAT_NAME_MAX], InputLatHist *h)
+{
+    if (!path || !h) { errno = EINVAL; return -1; }
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+
+    LatFileHeader fh;
+    InputLatHist  in;
+    bool ok = read(fd, &fh, sizeof(fh)) == (ssize_t)sizeof(fh) &&
+              read(fd, &in, sizeof(in)) == (ssize_t)sizeof(in);
+    close(fd);
+    if (!ok || fh.magic != LAT_MAGIC || fh.version != LAT_VERSION ||
+        fh.bins != INPUT_LAT_BINS) {
+        errno = EINVAL;
+        return -1;
+    }
+    fh.name[sizeof(fh.name) - 1] = '\0';
+    if (name) memcpy(name, fh.name, INPUT_LAT_NAME_MAX);
+    *h = in;
+    return 0;
+}
+
+/* ── The tracer ─────────────────────────────────────────────────────────── */
+
+static struct {
+    bool         named;             /* dir/name settled (open, or first sample) */
+    bool         publish;           /* false after input_lat_open(NULL, ...)    */
+    bool         base_loaded;       /* earlier runs' file read into `base`      */
+    bool         at_exit;
+    char         dir[128];
+    char         name[INPUT_LAT_NAME_MAX];
+    bool         pending;
+    uint64_t     pending_us;        /* kernel stamp of the oldest unpresented input */
+    bool         dirty;             /* window changed since the last publish    */
+    uint64_t     saved_ms;
+    InputLatHist window;
+    InputLatHist base;
+} g;
+
+static uint64_t realtime_us(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint64_t)tv.tv_sec * 1000000ULL + (uint64_t)tv.tv_usec;
+}
+
+static uint64_t mono_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000ULL;
+}
+
+static void publish(void)
+{
+    if (!g.publish || !g.name[0]) { g.dirty = false; return; }
+
+    char path[sizeof(g.dir) + INPUT_LAT_NAME_MAX + 2];
+    snprintf(path, sizeof(path), "%s/%s", g.dir, g.name);
+    if (!g.base_loaded) {
+        /* What earlier runs of this app left, so the file is its history
+         * since boot rather than its last run's. */
+        char was[INPUT_LAT_NAME_MAX];
+        if (input_lat_load(path, was, &g.base) != 0 || strcmp(was, g.name) != 0)
+            input_lat_hist_reset(&g.base);
+        g.base_loaded = true;
+        mkdir(g.dir, 0777);
+    }
+    InputLatHist all = g.base;
+    input_lat_hist_merge(&all, &g.window);
+    input_lat_save(path, g.name, &all);     /* tmpfs full: try again next time */
+    g.dirty    = false;
+    g.saved_ms = mono_ms();
+}
+
+static void publish_at_exit(void)
+{
+    if (g.dirty) publish();
+}
+
+static void settle_name(void)
+{
+    if (g.named) return;
+    g.named   = true;
+    g.publish = true;
+    snprintf(g.dir, sizeof(g.dir), "%s", INPUT_LAT_DIR);
+
+    FILE *f = fopen("/proc/self/comm", "r");
+    if (!f || !fgets(g.name, sizeof(g.name), f)) snprintf(g.name, sizeof(g.name), "app");
+    if (f) fclose(f);
+    g.name[strcspn(g.name, "\n/")] = '\0';
+    if (!g.name[0]) snprintf(g.name, sizeof(g.name), "app");
+}
+
+void input_lat_open(const char *dir, const char *name)
+{
+    g.named       = true;
+    g.publish     = dir != NULL;
+    g.base_loaded = false;
+    g.pending     = false;
+    g.dirty       = false;
+    g.saved_ms    = 0;
+    snprintf(g.dir, sizeof(g.dir), "%s", dir ? dir : "");
+    snprintf(g.name, sizeof(g.name), "%s", name ? name : "app");
+    g.name[strcspn(g.name, "/")] = '\0';
+    input_lat_hist_reset(&g.window);
+    input_lat_hist_reset(&g.base);
+}
+
+void input_lat_event(const struct input_event *ev)
+{
+    if (!ev || g.pending) return;
+    if (ev->type != EV_KEY && ev->type != EV_ABS && ev->type != EV_REL) return;
+    g.pending    = true;
+    g.pending_us = (uint64_t)ev->time.tv_sec * 1000000ULL + (uint64_t)ev->time.tv_usec;
+}
+
+void input_lat_drop(void)
+{
+    g.pending = false;
+}
+
+void input_lat_present(void)
+{
+    if (g.pending) {
+        g.pending = false;
+        uint64_t now = realtime_us();
+        if (now >= g.pending_us) {              /* else the clock was stepped */
+            uint64_t d = now - g.pending_us;
+            if (d > INPUT_LAT_STALE_US) g.window.stale++;
+            else                        input_lat_hist_add(&g.window, (uint32_t)d);
+            if (!g.dirty) {
+                settle_name();
+                if (!g.at_exit) { atexit(publish_at_exit); g.at_exit = true; }
+                g.dirty = true;
+            }
+        }
+    }
+    /* One clock read per swap only while there is something to publish. */
+    if (g.dirty && mono_ms() - g.saved_ms >= INPUT_LAT_SAVE_MS) publish();
+}
+
+void input_lat_flush(void)
+{
+    if (g.dirty) publish();
+}
+
+void input_lat_window(InputLatHist *out)
+{
+    if (out) *out = g.window;
+}
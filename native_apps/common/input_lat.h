@@ -0,0 +1,130 @@
+#ifndef INPUT_LAT_H
+#define INPUT_LAT_H
+
+/**
+ * input_lat — input-to-photon latency: from an evdev event's kernel timestamp
+ * to the fb_swap() that first presents a frame after it, per app.
+ *
+ * "Tapping feels laggy in some games" had no number behind it.  The frame
+ * statistics (frame_sched.h) say how long a frame took, not how long a tap
+ * waited for one: a game can hold 30 fps and still show a press two frames
+ * late because it polls after its update, or only redraws on its tick.  This
+ * measures the thing the finger feels.
+ *
+ * ── THE MARKER ───────────────────────────────────────────────────────────────
+ *
+ * Every loop in this tree is one thread that reads input, updates, and swaps,
+ * so the "caused-by" marker is a single process-wide stamp, not a tag carried
+ * through each game's state: touch_input.c and gamepad.c hand every event they
+ * read to input_lat_event(), the first state-changing one since the last
+ * present (EV_KEY, EV_ABS, EV_REL — not the SYN that closes a report) sets
+ * the stamp from its KERNEL timestamp, and later ones leave it alone.  The
+ * next fb_swap() resolves it: latency = now - stamp, into a 1 ms histogram,
+ * and clears it.  The oldest unpresented input is the one that waited longest,
+ * so a drag measures its worst report, not its freshest.
+ *
+ * The kernel timestamp is the start because it includes what the app cannot
+ * see: an event that sat in the evdev queue for 90 ms of an idle frame's sleep
+ * is 90 ms of the lag.  evdev stamps with CLOCK_REALTIME (this kernel predates
+ * EVIOCSCLOCKID), so the present is read with gettimeofday() too; a negative
+ * difference is an NTP step and is discarded.
+ *
+ * ⚠️ **First swap after, not the swap that shows it.**  A game that defers the
+ * effect (snake turns on its next 150 ms step) presents unrelated frames in
+ * between, and the figure is a lower bound for it.  A swap more than
+ * INPUT_LAT_STALE_US after its input is almost certainly not its effect — an
+ * idle menu that was tapped on nothing — and is counted as `stale` instead of
+ * binned.  An app that knows an input changed nothing can say so with
+ * input_lat_drop().  And "photon" stops at the swap: the panel shows it at the
+ * next refresh, up to one scanout (~16 ms) later, the same for every app.
+ *
+ * ── WHERE IT GOES ────────────────────────────────────────────────────────────
+ *
+ * Each process writes its histogram to INPUT_LAT_DIR/<comm>, every
+ * INPUT_LAT_SAVE_MS while it has new samples and at exit, merged with what
+ * earlier runs of the same app left there — so the file is that app's history
+ * since boot (the directory is tmpfs).  device_tools' INPUT LATENCY page reads
+ * the directory.  The write is a rename of a temp file, so a reader never sees
+ * half of one.
+ *
+ * The hooks are weak, for the reason given in input_rec.h (WHY THE HOOKS ARE
+ * WEAK): framebuffer.c, touch_input.c and gamepad.c are built in many places
+ * that do not list this file, and build-and-deploy.sh's COMMON_OBJ is where
+ * it is linked.  The histogram arithmetic is pure and host-tested
+ * (tests/input_lat_test.c).
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <linux/input.h>
+
+#define INPUT_LAT_DIR        "/dev/shm/roomwizard-inputlat"
+#define INPUT_LAT_BINS       256            /* 1 ms each; the last collects slower */
+#define INPUT_LAT_STALE_US   1000000u       /* a swap this late is not the effect  */
+#define INPUT_LAT_SAVE_MS    5000           /* publish at most this often          */
+#define INPUT_LAT_NAME_MAX   16             /* /proc/self/comm is 15 + NUL         */
+
+typedef struct {
+    uint32_t hist[INPUT_LAT_BINS];
+    uint32_t count;          /* inputs measured                                */
+    uint32_t stale;          /* inputs whose next swap came too late to count  */
+    uint32_t min_us, max_us;
+    uint64_t sum_us;
+} InputLatHist;
+
+/** One histogram summarised, in µs; zeros when count == 0.  Percentiles are
+ *  bin upper edges, so upper bounds good to the millisecond. */
+typedef struct {
+    uint32_t count;
+    uint32_t stale;
+    uint32_t min_us;
+    uint32_t avg_us;
+    uint32_t p50_us;
+    uint32_t p95_us;
+    uint32_t max_us;
+} InputLatStats;
+
+/* ── The histogram (pure) ─────────────────────────────────────────────────── */
+
+void  input_lat_hist_reset(InputLatHist *h);
+void  input_lat_hist_add(InputLatHist *h, uint32_t us);
+/** dst += src: two windows, or two runs of one app. */
+void  input_lat_hist_merge(InputLatHist *dst, const InputLatHist *src);
+void  input_lat_hist_stats(const InputLatHist *h, InputLatStats *out);
+
+/** "37 inputs, 2 stale; input→swap min/avg/p50/p95/max
+ *  12.4/41.0/39.0/88.0/97.3 ms" — for a Logger or a printf.  Returns buf. */
+char *input_lat_format(const InputLatStats *st, char *buf, size_t size);
+
+/** One app's file.  Returns 0, or -1 (errno set) — load() also fails on a file
+ *  that is not an input_lat histogram. */
+int   input_lat_save(const char *path, const char *name, const InputLatHist *h);
+int   input_lat_load(const char *path, char name[INPUT_LAT_NAME_MAX], InputLatHist *h);
+
+/* ── The tracer (process-wide, weak) ──────────────────────────────────────── */
+
+#define INPUT_LAT_WEAK __attribute__((weak))
+
+/** Every event read from an input fd — touch_input.c and gamepad.c. */
+INPUT_LAT_WEAK void input_lat_event(const struct input_event *ev);
+
+/** A frame just went to the panel — fb_swap(). */
+INPUT_LAT_WEAK void input_lat_present(void);
+
+/** The input since the last present changed nothing: do not charge it to the
+ *  next swap. */
+INPUT_LAT_WEAK void input_lat_drop(void);
+
+/** Where and as whom this process publishes.  Optional — the default is
+ *  INPUT_LAT_DIR and /proc/self/comm, taken on the first sample — and it
+ *  starts a fresh window.  NULL dir disables publishing (tests). */
+INPUT_LAT_WEAK void input_lat_open(const char *dir, const char *name);
+
+/** Publish now, rather than at the next INPUT_LAT_SAVE_MS boundary. */
+INPUT_LAT_WEAK void input_lat_flush(void);
+
+/** This process's samples since it started (or input_lat_open()). */
+INPUT_LAT_WEAK void input_lat_window(InputLatHist *out);
+
+#endif /* INPUT_LAT_H */
@@ -0,0 +1,400 @@
+#include "input_rec.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+
+_Static_assert(sizeof(InputRecHeader) == 16, "InputRecHeader is the file format");
+_Static_assert(sizeof(InputRecord) == 12,    "InputRecord is the file format");
+
+#define AXES        ABS_CNT
+#define FLUSH_US    1000000ULL      /* flush the recording at most once a second */
+#define FULL_SPEED_WAIT_MS  250     /* how long an unpaced replay waits on a full pipe */
+
+enum { MODE_OFF = 0, MODE_RECORD, MODE_REPLAY };
+
+static struct {
+    bool     env_checked;
+    int      mode;
+    /* recording */
+    FILE    *f;
+    uint64_t last_us;               /* time of the previous event record         */
+    uint64_t flushed_us;
+    uint32_t events;
+    /* replay */
+    int      rd[INPUT_REC_SRC_COUNT];   /* read ends; -1 = source not in the file */
+    pid_t    feeder;
+    bool     have_abs[INPUT_REC_SRC_COUNT][AXES];
+    int32_t  abs_min[INPUT_REC_SRC_COUNT][AXES];
+    int32_t  abs_max[INPUT_REC_SRC_COUNT][AXES];
+} g = { .rd = { -1, -1, -1, -1 } };
+
+static uint64_t realtime_us(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint64_t)tv.tv_sec * 1000000ULL + (uint64_t)tv.tv_usec;
+}
+
+static uint64_t mono_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void sleep_until(uint64_t until_ns)
+{
+    struct timespec ts;
+    ts.tv_sec  = (time_t)(until_ns / 1000000000ULL);
+    ts.tv_nsec = (long)(until_ns % 1000000000ULL);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+        ;
+}
+
+static void write_record(uint32_t dt_us, InputRecSource src, int type, int code,
+                         int32_t value)
+{
+    InputRecord r;
+    r.dt_us = dt_us;
+    r.value = value;
+    r.code  = (uint16_t)code;
+    r.type  = (uint8_t)type;
+    r.src   = (uint8_t)src;
+    if (fwrite(&r, sizeof(r), 1, g.f) != 1) {
+        /* A full /tmp mid-session: stop rather than leave a torn record for the
+         * replay to misparse.  What was written is a valid shorter session. */
+        printf("input_rec: write failed (%s), recording stopped after %u events\n",
+               strerror(errno), g.events);
+        input_rec_stop();
+    }
+}
+
+void input_rec_stop(void)
+{
+    if (g.f) {
+        fclose(g.f);
+        printf("input_rec: recording closed, %u events\n", g.events);
+    }
+    g.f = NULL;
+    g.events = 0;
+    for (int i = 0; i < INPUT_REC_SRC_COUNT; i++) {
+        if (g.rd[i] >= 0) close(g.rd[i]);
+        g.rd[i] = -1;
+    }
+    if (g.feeder > 0) {
+        kill(g.feeder, SIGTERM);
+        waitpid(g.feeder, NULL, 0);
+    }
+    g.feeder = 0;
+    g.mode = MODE_OFF;
+}
+
+int input_rec_record(const char *path)
+{
+    input_rec_stop();
+    g.env_checked = true;
+
+    g.f = fopen(path, "wb");
+    if (!g.f) {
+        printf("input_rec: cannot record to %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    InputRecHeader h;
+    memset(&h, 0, sizeof(h));
+    h.magic        = INPUT_REC_MAGIC;
+    h.version      = INPUT_REC_VERSION;
+    h.record_bytes = sizeof(InputRecord);
+    h.start_us     = realtime_us();
+    if (fwrite(&h, sizeof(h), 1, g.f) != 1) {
+        printf("input_rec: cannot write %s: %s\n", path, strerror(errno));
+        fclose(g.f);
+        g.f = NULL;
+        return -1;
+    }
+    g.last_us    = h.start_us;
+    g.flushed_us = h.start_us;
+    g.mode       = MODE_RECORD;
+    printf("input_rec: recording input to %s\n", path);
+    return 0;
+}
+
+/* ── replay ─────────────────────────────────────────────────────────────────── */
+
+static FILE *open_recording(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        printf("input_rec: cannot replay %s: %s\n", path, strerror(errno));
+        return NULL;
+    }
+    InputRecHeader h;
+    if (fread(&h, sizeof(h), 1, f) != 1 || h.magic != INPUT_REC_MAGIC ||
+        h.version != INPUT_REC_VERSION || h.record_bytes != sizeof(InputRecord)) {
+        printf("input_rec: %s is not a version %d input recording\n",
+               path, INPUT_REC_VERSION);
+        fclose(f);
+        return NULL;
+    }
+    return f;
+}
+
+/* The child: stream the file into the pipes on the recorded clock.  Never
+ * returns.  Non-blocking writes, so one source nobody reads cannot hold up the
+ * others — see WHAT REPLAY IS NOT in the header. */
+static void feed(FILE *f, const int *wr, double speed, bool term_at_end, pid_t app)
+{
+    uint64_t start = mono_ns();
+    uint64_t t_us = 0;
+    uint32_t sent = 0, dropped = 0;
+    InputRecord r;
+
+    while (fread(&r, sizeof(r), 1, f) == 1) {
+        t_us += r.dt_us;
+        if (r.type >= INPUT_REC_META || r.src >= INPUT_REC_SRC_COUNT || wr[r.src] < 0)
+            continue;
+        if (speed > 0)
+            sleep_until(start + (uint64_t)((double)t_us * 1000.0 / speed));
+
+        /* Stamped now, not with the recorded time: a consumer of the kernel
+         * timestamp (latency, velocity) must see it on the replay's clock. */
+        struct input_event ev;
+        memset(&ev, 0, sizeof(ev));
+        gettimeofday(&ev.time, NULL);
+        ev.type  = r.type;
+        ev.code  = r.code;
+        ev.value = r.value;
+        ssize_t n = write(wr[r.src], &ev, sizeof(ev));
+        if (n < 0 && errno == EAGAIN && speed <= 0) {
+            /* Full speed is paced by the reader instead of the clock: give it
+             * a moment to drain before calling the source unread. */
+            struct pollfd pfd = { .fd = wr[r.src], .events = POLLOUT, .revents = 0 };
+            if (poll(&pfd, 1, FULL_SPEED_WAIT_MS) > 0)
+                n = write(wr[r.src], &ev, sizeof(ev));
+        }
+        if (n == (ssize_t)sizeof(ev))   sent++;
+        else if (n < 0 && errno == EAGAIN) dropped++;
+        else break;                     /* EPIPE: the app is gone */
+    }
+
+    printf("input_rec: replay finished, %u events fed, %u dropped on full pipes\n",
+           sent, dropped);
+    fflush(stdout);
+    for (int i = 0; i < INPUT_REC_SRC_COUNT; i++)
+        if (wr[i] >= 0) close(wr[i]);
+    if (term_at_end) kill(app, SIGTERM);
+    _exit(0);
+}
+
+/** In the feeder, right after fork(): close every fd the app had open but the
+ *  pipes it writes, the recording and stdio.  It outlives the app by up to a
+ *  poll interval and may be replaying for minutes — and an inherited /dev/dsp
+ *  held that long makes the NEXT app's exclusive OSS open fail.  The kernel
+ *  here predates close_range(), so walk /proc/self/fd, or every number below
+ *  the fd limit without /proc. */
+static bool feeder_keeps(int fd, const int wr[INPUT_REC_SRC_COUNT], int file_fd)
+{
+    if (fd <= 2 || fd == file_fd) return true;
+    for (int i = 0; i < INPUT_REC_SRC_COUNT; i++)
+        if (fd == wr[i]) return true;
+    return false;
+}
+
+static void close_inherited(const int wr[INPUT_REC_SRC_COUNT], int file_fd)
+{
+    DIR *d = opendir("/proc/self/fd");
+    if (d) {
+        struct dirent *e;
+        while ((e = readdir(d)) != NULL) {
+            if (e->d_name[0] < '0' || e->d_name[0] > '9') continue;
+            int fd = atoi(e->d_name);
+            if (fd != dirfd(d) && !feeder_keeps(fd, wr, file_fd)) close(fd);
+        }
+        closedir(d);
+        return;
+    }
+    long max = sysconf(_SC_OPEN_MAX);
+    if (max <= 0 || max > 65536) max = 1024;
+    for (int fd = 3; fd < max; fd++)
+        if (!feeder_keeps(fd, wr, file_fd)) close(fd);
+}
+
+int input_rec_replay(const char *path, double speed, bool term_at_end)
+{
+    input_rec_stop();
+    g.env_checked = true;
+
+    FILE *f = open_recording(path);
+    if (!f) return -1;
+
+    /* One pass for what the file holds: which sources get a pipe at all (one
+     * the session never used stays -1, as an unplugged device would), and the
+     * axis ranges the devices reported when it was recorded. */
+    bool used[INPUT_REC_SRC_COUNT] = { false };
+    uint32_t total = 0;
+    InputRecord r;
+    memset(g.have_abs, 0, sizeof(g.have_abs));
+    while (fread(&r, sizeof(r), 1, f) == 1) {
+        if (r.src >= INPUT_REC_SRC_COUNT) continue;
+        if (r.type < INPUT_REC_META) { used[r.src] = true; total++; continue; }
+        if (r.code >= AXES) continue;
+        if (r.type == INPUT_REC_ABS_MIN) g.abs_min[r.src][r.code] = r.value;
+        if (r.type == INPUT_REC_ABS_MAX) {
+            g.abs_max[r.src][r.code] = r.value;
+            g.have_abs[r.src][r.code] = true;
+        }
+    }
+
+    int wr[INPUT_REC_SRC_COUNT];
+    for (int i = 0; i < INPUT_REC_SRC_COUNT; i++) {
+        int p[2] = { -1, -1 };
+        wr[i] = -1;
+        if (!used[i]) continue;
+        if (pipe(p) != 0) {
+            printf("input_rec: pipe: %s\n", strerror(errno));
+            for (int j = 0; j < i; j++) if (wr[j] >= 0) close(wr[j]);
+            input_rec_stop();
+            fclose(f);
+            return -1;
+        }
+        fcntl(p[0], F_SETFL, O_NONBLOCK);
+        fcntl(p[0], F_SETFD, FD_CLOEXEC);
+        fcntl(p[1], F_SETFL, O_NONBLOCK);
+        fcntl(p[1], F_SETFD, FD_CLOEXEC);
+        g.rd[i] = p[0];
+        wr[i]   = p[1];
+    }
+
+    fflush(stdout);                     /* or the child prints our buffer again */
+    fflush(stderr);
+    pid_t app = getpid();
+    pid_t pid = fork();
+    if (pid == 0) {
+        /* The app's handlers would only set its `running` flag in here, and
+         * input_rec_stop() has to be able to end the feeder with SIGTERM. */
+        signal(SIGTERM, SIG_DFL);
+        signal(SIGINT,  SIG_DFL);
+        close_inherited(wr, fileno(f));
+        fseek(f, (long)sizeof(InputRecHeader), SEEK_SET);
+        feed(f, wr, speed, term_at_end, app);
+    }
+    for (int i = 0; i < INPUT_REC_SRC_COUNT; i++)
+        if (wr[i] >= 0) close(wr[i]);
+    fclose(f);
+    if (pid < 0) {
+        printf("input_rec: fork: %s\n", strerror(errno));
+        input_rec_stop();
+        return -1;
+    }
+
+    g.feeder = pid;
+    g.mode   = MODE_REPLAY;
+    char pace[32];
+    if (speed > 0) snprintf(pace, sizeof(pace), "%.3gx", speed);
+    else           snprintf(pace, sizeof(pace), "full speed");
+    printf("input_rec: replaying %s at %s: %u events (touch %s, gamepad %s, "
+           "keyboard %s, mouse %s)\n", path, pace, total,
+           used[INPUT_REC_TOUCH] ? "yes" : "no", used[INPUT_REC_GAMEPAD] ? "yes" : "no",
+           used[INPUT_REC_KEYBOARD] ? "yes" : "no", used[INPUT_REC_MOUSE] ? "yes" : "no");
+    return 0;
+}
+
+/* ── the hooks ──────────────────────────────────────────────────────────────── */
+
+static void env_start(void)
+{
+    if (g.env_checked) return;
+    g.env_checked = true;
+
+    /* Copied and unset before anything else: see TURNING IT ON. */
+    char rec[256] = "", rep[256] = "";
+    const char *v;
+    double speed = 1.0;
+    bool term = false;
+    if ((v = getenv(INPUT_REC_ENV_RECORD))) snprintf(rec, sizeof(rec), "%s", v);
+    if ((v = getenv(INPUT_REC_ENV_REPLAY))) snprintf(rep, sizeof(rep), "%s", v);
+    if ((v = getenv(INPUT_REC_ENV_SPEED)))  speed = atof(v);
+    if ((v = getenv(INPUT_REC_ENV_EXIT)))   term = (atoi(v) != 0);
+    unsetenv(INPUT_REC_ENV_RECORD);
+    unsetenv(INPUT_REC_ENV_REPLAY);
+    unsetenv(INPUT_REC_ENV_SPEED);
+    unsetenv(INPUT_REC_ENV_EXIT);
+
+    if (rep[0]) {
+        if (rec[0])
+            printf("input_rec: both %s and %s set, replaying only\n",
+                   INPUT_REC_ENV_RECORD, INPUT_REC_ENV_REPLAY);
+        input_rec_replay(rep, speed, term);
+    } else if (rec[0]) {
+        input_rec_record(rec);
+    }
+}
+
+int input_rec_device(InputRecSource src, int fd)
+{
+    env_start();
+    if (g.mode != MODE_REPLAY || src >= INPUT_REC_SRC_COUNT) return fd;
+
+    /* A dup, so the owner's close() on rescan or re-init costs the replay
+     * nothing: the next open gets another dup of the same pipe. */
+    if (fd >= 0) close(fd);
+    return g.rd[src] >= 0 ? fcntl(g.rd[src], F_DUPFD_CLOEXEC, 0) : -1;
+}
+
+void input_rec_event(InputRecSource src, const struct input_event *ev)
+{
+    if (g.mode != MODE_RECORD) return;
+
+    uint64_t t = (uint64_t)ev->time.tv_sec * 1000000ULL + (uint64_t)ev->time.tv_usec;
+    uint64_t dt = t > g.last_us ? t - g.last_us : 0;   /* never backwards */
+    if (dt > UINT32_MAX) dt = UINT32_MAX;
+    if (t > g.last_us) g.last_us = t;
+
+    write_record((uint32_t)dt, src, ev->type, ev->code, ev->value);
+    if (!g.f) return;
+    g.events++;
+
+    /* Flushed on a frame boundary, at most once a second: a session that ends
+     * in a crash or a SIGKILL from the launcher still replays to within a
+     * second of the end, and the panel is not asked for a write per report. */
+    if (ev->type == EV_SYN && ev->code == SYN_REPORT && t - g.flushed_us >= FLUSH_US) {
+        fflush(g.f);
+        g.flushed_us = t;
+    }
+}
+
+int input_rec_absinfo(InputRecSource src, int fd, int code, struct input_absinfo *out)
+{
+    env_start();
+    if (g.mode == MODE_REPLAY) {
+        if (src >= INPUT_REC_SRC_COUNT || code < 0 || code >= AXES ||
+            !g.have_abs[src][code])
+            return -1;
+        memset(out, 0, sizeof(*out));
+        out->minimum = g.abs_min[src][code];
+        out->maximum = g.abs_max[src][code];
+        return 0;
+    }
+
+    if (fd < 0 || ioctl(fd, EVIOCGABS(code), out) != 0) return -1;
+    if (g.mode == MODE_RECORD) {
+        write_record(0, src, INPUT_REC_ABS_MIN, code, out->minimum);
+        if (g.f) write_record(0, src, INPUT_REC_ABS_MAX, code, out->maximum);
+    }
+    return 0;
+}
+
+uint32_t input_rec_count(void)
+{
+    return g.mode == MODE_RECORD ? g.events : 0;
+}
@@ -0,0 +1,139 @@
+#ifndef INPUT_REC_H
+#define INPUT_REC_H
+
+/**
+ * input_rec — record an app's raw evdev streams, and play them back into it.
+ *
+ * There is no /dev/uinput on the device, so touch_inject can only poke the one
+ * touchscreen node and nothing past an app's first screen runs without a finger
+ * on the panel.  This file makes a session repeatable instead: RECORD logs every
+ * input_event touch_input.c and gamepad.c read, with its kernel timestamp, to a
+ * compact file; REPLAY hands those two files a pipe per source in place of the
+ * device fd, fed by a forked process that writes the same events back at the
+ * recorded pace — or N times faster.  The readers cannot tell the difference:
+ * touch_poll(), gamepad_poll() and input_hub's epoll all see an fd that becomes
+ * readable and yields whole `struct input_event`s, so the game under replay runs
+ * its real input path, which is what a frame-time or audio-starvation benchmark
+ * has to measure.
+ *
+ * ── TURNING IT ON ────────────────────────────────────────────────────────────
+ *
+ *     RW_INPUT_RECORD=/tmp/snake.rwin   /opt/games/snake     (record a session)
+ *     RW_INPUT_REPLAY=/tmp/snake.rwin   /opt/games/snake     (play it back)
+ *     RW_INPUT_SPEED=4                  ...replay 4x faster; 0 = as fast as read
+ *     RW_INPUT_REPLAY_EXIT=1            ...SIGTERM the app when the file ends
+ *
+ * Read once, on the first device the process opens, and then UNSET: the
+ * launcher's children inherit its environment, and a game opening the
+ * launcher's recording for writing would truncate it mid-session.  A
+ * recording is therefore one process's session.  REPLAY wins if both are set.
+ * The same variables work on the host, where there is no device at all — the
+ * replayed pipe is the touch fd.
+ *
+ * ── THE FILE ─────────────────────────────────────────────────────────────────
+ *
+ * A 16-byte InputRecHeader, then 12-byte InputRecord's — half the size of the
+ * host's `struct input_event` and three quarters of the device's, and the same
+ * bytes on both (little-endian, no padding), so a session recorded on the panel
+ * replays on the dev machine.  Each record carries the microseconds since the
+ * previous one rather than an absolute time, so a 32-bit field covers any gap
+ * a session has (saturating at 71 minutes).  Types at or above
+ * INPUT_REC_META are not events: they carry the EVIOCGABS range of an axis as
+ * the recording process saw it, because a pipe answers no ioctl and a stick
+ * normalised against a 0..0 range reads dead centre.
+ *
+ * ── WHY THE HOOKS ARE WEAK ───────────────────────────────────────────────────
+ *
+ * ⚠️ **Every function below is a weak symbol, and callers test its address.**
+ * touch_input.c is compiled by vnc_client's Makefile, build-usb-test.sh and the
+ * documented command line of fifteen host tests, none of which list this file.
+ * A weak reference links to NULL where input_rec.o is absent and to the real
+ * function where it is present, so build-and-deploy.sh's COMMON_OBJ gets
+ * record/replay in every app and nothing else has to change.  The cost when it
+ * is linked but off is one call and one flag test per event.
+ *
+ * ── WHAT REPLAY IS NOT ───────────────────────────────────────────────────────
+ *
+ * Deterministic timing, not a deterministic game.  Events arrive at the
+ * recorded offsets from the start of replay, but a game that seeds rand() from
+ * the clock, or that reads a press on frame N instead of N+1 because the device
+ * is slower today, will diverge from the recording the way two human sessions
+ * do.  Benchmarks compare load, not outcomes.  The feeder never blocks: a
+ * source's pipe that is full (nobody polls it) drops the event, and the feeder
+ * prints the count when the file ends, so an unread keyboard cannot stall the
+ * touch stream behind it.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <linux/input.h>
+
+#define INPUT_REC_ENV_RECORD  "RW_INPUT_RECORD"
+#define INPUT_REC_ENV_REPLAY  "RW_INPUT_REPLAY"
+#define INPUT_REC_ENV_SPEED   "RW_INPUT_SPEED"
+#define INPUT_REC_ENV_EXIT    "RW_INPUT_REPLAY_EXIT"
+
+#define INPUT_REC_MAGIC       0x4E495752u   /* "RWIN" little-endian */
+#define INPUT_REC_VERSION     1
+
+/* Record types at or above this are metadata, never written to a pipe. */
+#define INPUT_REC_META        0xF0
+#define INPUT_REC_ABS_MIN     0xF0          /* value = absinfo.minimum of `code` */
+#define INPUT_REC_ABS_MAX     0xF1          /* value = absinfo.maximum of `code` */
+
+typedef enum {
+    INPUT_REC_TOUCH = 0,
+    INPUT_REC_GAMEPAD,
+    INPUT_REC_KEYBOARD,
+    INPUT_REC_MOUSE,
+    INPUT_REC_SRC_COUNT
+} InputRecSource;
+
+typedef struct {
+    uint32_t magic;             /* INPUT_REC_MAGIC                              */
+    uint16_t version;           /* INPUT_REC_VERSION                            */
+    uint16_t record_bytes;      /* sizeof(InputRecord), checked on replay        */
+    uint64_t start_us;          /* CLOCK_REALTIME when recording began          */
+} InputRecHeader;
+
+typedef struct {
+    uint32_t dt_us;             /* since the previous record (or the start)     */
+    int32_t  value;
+    uint16_t code;
+    uint8_t  type;              /* EV_* — or INPUT_REC_META and up              */
+    uint8_t  src;               /* InputRecSource                               */
+} InputRecord;
+
+#define INPUT_REC_WEAK __attribute__((weak))
+
+/** Called by touch_input.c / gamepad.c with each device fd they open (or -1
+ *  for a source they found nothing for).  Returns the fd to use: unchanged
+ *  when recording or off; under replay the real fd is closed and a dup of the
+ *  source's pipe returned, or -1 if the recording has no events for it.
+ *  The first call reads the environment (see TURNING IT ON). */
+INPUT_REC_WEAK int  input_rec_device(InputRecSource src, int fd);
+
+/** Called with every event read from a source's fd; a no-op unless recording. */
+INPUT_REC_WEAK void input_rec_event(InputRecSource src, const struct input_event *ev);
+
+/** EVIOCGABS, as the device fd's owners should ask it: a plain ioctl, which
+ *  recording also writes to the file; under replay, answered from the file.
+ *  Returns 0 or -1 like the ioctl. */
+INPUT_REC_WEAK int  input_rec_absinfo(InputRecSource src, int fd, int code,
+                                      struct input_absinfo *out);
+
+/** Explicit forms of the environment switches, for tests and tools.  Either
+ *  one stops whatever was running first.  `speed` <= 0 replays as fast as the
+ *  app drains the pipes; `term_at_end` sends SIGTERM to this process when the
+ *  file is exhausted.  Return 0, or -1 (reason printed) leaving input_rec off. */
+INPUT_REC_WEAK int  input_rec_record(const char *path);
+INPUT_REC_WEAK int  input_rec_replay(const char *path, double speed, bool term_at_end);
+
+/** Flush and close a recording, or stop the replay feeder and drop the pipes
+ *  (fds already handed out just read EOF).  Safe to call when off. */
+INPUT_REC_WEAK void input_rec_stop(void);
+
+/** Events written to the current recording so far (0 when not recording). */
+INPUT_REC_WEAK uint32_t input_rec_count(void);
+
+#endif /* INPUT_REC_H */
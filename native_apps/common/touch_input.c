@@ -1,5 +1,7 @@
 #include "touch_input.h"
 #include "framebuffer.h"
+#include "input_rec.h"
+#include "input_lat.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -7,6 +9,8 @@
 #include <unistd.h>
 #include <errno.h>
 #include <poll.h>
+#include <time.h>
+#include <sys/time.h>
 #include <linux/input.h>
 
 // Default calibration file path
@@ -164,8 +168,20 @@ static void publish_safe_area(TouchInput *touch) {
                lo_x, hi_x, lo_y, hi_y, touch->screen_width, touch->screen_height);
 }
 
+// EVIOCGABS through input_rec when it is linked in, so a recording carries the
+// range and a replay can answer it (input_rec.h, THE FILE).
+static int touch_absinfo(int fd, int code, struct input_absinfo *abs) {
+    if (input_rec_absinfo)
+        return input_rec_absinfo(INPUT_REC_TOUCH, fd, code, abs);
+    return ioctl(fd, EVIOCGABS(code), abs);
+}
+
 int touch_init(TouchInput *touch, const char *device) {
     touch->fd = open(device, O_RDONLY | O_NONBLOCK);
+    // Before the failure check: under replay the recording is the device, on a
+    // host with no /dev/input at all (input_rec.h).
+    if (input_rec_device)
+        touch->fd = input_rec_device(INPUT_REC_TOUCH, touch->fd);
     if (touch->fd == -1) {
         perror("Error opening touch device");
         printf("ERROR: Failed to open %s, fd=%d\n", device, touch->fd);
@@ -179,16 +195,21 @@ int touch_init(TouchInput *touch, const char *device) {
     touch->state.pressed = false;
     touch->state.released = false;
     touch->state.held = false;
+    touch->state.pred_x = 0;
+    touch->state.pred_y = 0;
     touch->last_x = 0;
     touch->last_y = 0;
     touch->touching = false;
+    touch->predict = false;
+    touch->predict_lead_us = 0;
+    memset(&touch->motion, 0, sizeof(touch->motion));
 
     // Query the hardware coordinate range via EVIOCGABS. This is the default
     // raw→screen mapping (works out of the box on this panel); calibration
     // replaces it with a measured curve.
     struct input_absinfo abs_x, abs_y;
-    if (ioctl(touch->fd, EVIOCGABS(ABS_X), &abs_x) == 0 &&
-        ioctl(touch->fd, EVIOCGABS(ABS_Y), &abs_y) == 0) {
+    if (touch_absinfo(touch->fd, ABS_X, &abs_x) == 0 &&
+        touch_absinfo(touch->fd, ABS_Y, &abs_y) == 0) {
         touch->raw_min_x = abs_x.minimum;
         touch->raw_max_x = abs_x.maximum;
         touch->raw_min_y = abs_y.minimum;
@@ -329,6 +350,8 @@ int touch_wait_for_press_raw(TouchInput *touch, int *raw_x, int *raw_y) {
             if (n < 0 && (errno == EINTR || errno == EAGAIN)) continue;
             break;                          // short read or device gone
         }
+        if (input_rec_event) input_rec_event(INPUT_REC_TOUCH, &ev);
+        if (input_lat_event) input_lat_event(&ev);
 
         if (ev.type == EV_ABS) {
             if (ev.code == ABS_X) current_x = ev.value;
@@ -364,6 +387,28 @@ int touch_wait_for_press(TouchInput *touch, int *x, int *y) {
     return 0;
 }
 
+static int64_t realtime_us(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+// pred_x/pred_y for target_us, clamped to the screen like a measured position.
+static void predict_into_state(TouchInput *touch, int64_t now_us, int64_t target_us) {
+    int x, y;
+    if (!touch_motion_predict(&touch->motion, now_us, target_us, &x, &y)) {
+        touch->state.pred_x = touch->state.x;
+        touch->state.pred_y = touch->state.y;
+        return;
+    }
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (touch->screen_width > 0  && x >= touch->screen_width)  x = touch->screen_width - 1;
+    if (touch->screen_height > 0 && y >= touch->screen_height) y = touch->screen_height - 1;
+    touch->state.pred_x = x;
+    touch->state.pred_y = y;
+}
+
 int touch_poll(TouchInput *touch) {
     // Non-blocking poll. Process events in arrival order:
     //   1. ABS_X, ABS_Y → last_x/last_y (RAW)
@@ -378,6 +423,8 @@ int touch_poll(TouchInput *touch) {
 
     while (read(touch->fd, &ev, sizeof(ev)) == sizeof(ev)) {
         events_read++;
+        if (input_rec_event) input_rec_event(INPUT_REC_TOUCH, &ev);
+        if (input_lat_event) input_lat_event(&ev);
 
         if (ev.type == EV_ABS) {
             if (ev.code == ABS_X) touch->last_x = ev.value;
@@ -391,6 +438,8 @@ int touch_poll(TouchInput *touch) {
                 scale_coordinates(touch, &x, &y);
                 touch->state.x = x;
                 touch->state.y = y;
+                // A new contact: the last one's motion says nothing about it.
+                touch_motion_reset(&touch->motion);
             } else if (ev.value == 0 && touch->touching) {
                 touch->touching = false;
                 touch->state.released = true;
@@ -402,10 +451,27 @@ int touch_poll(TouchInput *touch) {
                 scale_coordinates(touch, &x, &y);
                 touch->state.x = x;
                 touch->state.y = y;
+                // The report's own kernel time, not the time it was read: a
+                // burst drained in one poll is still spread over its real
+                // interval, which is what the velocity is measured against.
+                if (touch->predict)
+                    touch_motion_add(&touch->motion,
+                                     (int64_t)ev.time.tv_sec * 1000000 + ev.time.tv_usec,
+                                     x, y);
             }
         }
     }
 
+    // Every poll, not only one that read something: the target moves on with
+    // the clock even while the finger is between reports.
+    if (touch->predict && touch->touching && touch->predict_lead_us > 0) {
+        int64_t now = realtime_us();
+        predict_into_state(touch, now, now + touch->predict_lead_us);
+    } else {
+        touch->state.pred_x = touch->state.x;
+        touch->state.pred_y = touch->state.y;
+    }
+
     return events_read;
 }
 
@@ -664,7 +730,111 @@ void touch_drain_events(TouchInput *touch) {
     touch->state.pressed  = false;
     touch->state.released = false;
     touch->state.held     = false;
+    touch->state.pred_x   = touch->state.x;
+    touch->state.pred_y   = touch->state.y;
+    touch_motion_reset(&touch->motion);
 
     if (drained > 0)
         printf("touch_drain_events: discarded %d stale events\n", drained);
 }
+
+// ── Motion prediction ──────────────────────────────────────────────────────
+
+void touch_set_prediction(TouchInput *touch, bool enable, int lead_us, int smoothing) {
+    if (lead_us < 0) lead_us = 0;
+    if (smoothing < 0) smoothing = 0;
+    if (smoothing > TOUCH_PRED_SMOOTH_MAX) smoothing = TOUCH_PRED_SMOOTH_MAX;
+    touch->predict = enable;
+    touch->predict_lead_us = lead_us;
+    touch_motion_reset(&touch->motion);
+    touch->motion.smoothing = smoothing;
+    touch->state.pred_x = touch->state.x;
+    touch->state.pred_y = touch->state.y;
+}
+
+void touch_predict_at(TouchInput *touch, uint64_t target_mono_ns) {
+    if (!touch->predict || !touch->touching) {
+        touch->state.pred_x = touch->state.x;
+        touch->state.pred_y = touch->state.y;
+        return;
+    }
+    // The caller's clock is monotonic and evdev's is realtime; carry the
+    // target across as an offset from now, which both clocks agree on.
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    int64_t mono_us = (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+    int64_t now = realtime_us();
+    predict_into_state(touch, now, now + ((int64_t)(target_mono_ns / 1000) - mono_us));
+}
+
+void touch_motion_reset(TouchMotion *m) {
+    int smoothing = m->smoothing;
+    memset(m, 0, sizeof(*m));
+    m->smoothing = smoothing;
+}
+
+void touch_motion_add(TouchMotion *m, int64_t t_us, int x, int y) {
+    m->head = (m->head + 1) % TOUCH_PRED_SAMPLES;
+    m->t_us[m->head] = t_us;
+    m->x[m->head] = x;
+    m->y[m->head] = y;
+    if (m->n < TOUCH_PRED_SAMPLES) m->n++;
+
+    // Least-squares slope of position over time across the reports inside the
+    // window, times relative to the newest so floats keep their precision.
+    // Fitting several reports rather than differencing the last two is what
+    // keeps one noisy report from flinging the prediction.
+    float st = 0, sx = 0, sy = 0;
+    int k = 0;
+    for (int i = 0; i < m->n; i++) {
+        int j = (m->head - i + TOUCH_PRED_SAMPLES) % TOUCH_PRED_SAMPLES;
+        int64_t age = t_us - m->t_us[j];
+        if (age < 0 || age > TOUCH_PRED_WINDOW_US) break;
+        st += (float)-age * 1e-6f;
+        sx += (float)m->x[j];
+        sy += (float)m->y[j];
+        k++;
+    }
+    if (k < 3) return;                  // two points are a difference, not a fit
+    float mt = st / k, mx = sx / k, my = sy / k;
+    float stt = 0, stx = 0, sty = 0;
+    for (int i = 0; i < k; i++) {
+        int j = (m->head - i + TOUCH_PRED_SAMPLES) % TOUCH_PRED_SAMPLES;
+        float dt = (float)-(t_us - m->t_us[j]) * 1e-6f - mt;
+        stt += dt * dt;
+        stx += dt * ((float)m->x[j] - mx);
+        sty += dt * ((float)m->y[j] - my);
+    }
+    if (stt <= 0) return;               // every report in one instant
+    float vx = stx / stt, vy = sty / stt;
+
+    if (!m->have_v) {
+        m->vx = vx; m->vy = vy;
+        m->have_v = true;
+    } else {
+        float a = (float)(100 - m->smoothing) / 100.0f;
+        m->vx += a * (vx - m->vx);
+        m->vy += a * (vy - m->vy);
+    }
+}
+
+bool touch_motion_predict(const TouchMotion *m, int64_t now_us, int64_t target_us,
+                          int *x, int *y) {
+    if (m->n == 0) { *x = 0; *y = 0; return false; }
+    int64_t t = m->t_us[m->head];
+    *x = m->x[m->head];
+    *y = m->y[m->head];
+    if (!m->have_v || now_us - t > TOUCH_PRED_STALE_US) return false;
+
+    int64_t lead = target_us - now_us;
+    if (lead < 0) lead = 0;
+    if (lead > TOUCH_PRED_MAX_LEAD_US) lead = TOUCH_PRED_MAX_LEAD_US;
+    float span = (float)(now_us + lead - t) * 1e-6f;
+    float px = (float)*x + m->vx * span;
+    float py = (float)*y + m->vy * span;
+    // Round half away from zero without libm: not every build of this file
+    // links -lm.
+    *x = (int)(px + (px >= 0 ? 0.5f : -0.5f));
+    *y = (int)(py + (py >= 0 ? 0.5f : -0.5f));
+    return true;
+}
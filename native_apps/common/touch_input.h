@@ -10,8 +10,54 @@ typedef struct {
     bool pressed;
     bool released;
     bool held;
+    // Where the finger is expected to be at the prediction target (see MOTION
+    // PREDICTION below). x/y stay the last MEASURED position; pred_x/pred_y are
+    // equal to them unless an app turned prediction on and the finger is moving.
+    int pred_x;
+    int pred_y;
 } TouchState;
 
+// MOTION PREDICTION — opt-in, for apps that follow a dragging finger.
+//
+// touch_poll() reports the position of the last SYN_REPORT, which was already
+// some milliseconds old when it was read and is older still by the time the
+// frame built from it reaches the panel; a paddle under a moving finger trails
+// it by a frame or more. With prediction on, every report of the current
+// contact is kept with its KERNEL timestamp, the velocity is the least-squares
+// slope over the last TOUCH_PRED_SAMPLES reports inside TOUCH_PRED_WINDOW_US,
+// and pred_x/pred_y extrapolate the last position along it to a target time —
+// a fixed lead past each poll, or an explicit time such as the next present.
+//
+// Smoothing (0..TOUCH_PRED_SMOOTH_MAX) is an exponential average over
+// successive velocity estimates: 0 takes each fit as is, higher values trade
+// responsiveness to a change of direction for less of the digitiser's ±1-2 px
+// report noise being multiplied by the lead. Extrapolation stops — pred is the
+// measured position — when the newest report is older than TOUCH_PRED_STALE_US
+// (a finger held still stops producing reports) and never reaches further than
+// TOUCH_PRED_MAX_LEAD_US past the poll. The result is clamped to the screen.
+//
+// ⚠️ A prediction is a guess: use it for what is DRAWN to follow the finger,
+// and the measured x/y for hit tests, taps and anything sent elsewhere.
+#define TOUCH_PRED_SAMPLES      8
+#define TOUCH_PRED_WINDOW_US    60000   // older reports do not vote on velocity
+#define TOUCH_PRED_STALE_US     30000   // no report for this long: finger stopped
+#define TOUCH_PRED_MAX_LEAD_US  50000
+#define TOUCH_PRED_SMOOTH_MAX   95
+
+// One contact's recent reports and the velocity fitted to them, in logical
+// pixels and microseconds on the evdev clock (CLOCK_REALTIME). Pure — no fd —
+// so the arithmetic is testable by itself; TouchInput embeds one.
+typedef struct {
+    int      n;                        // reports held, up to TOUCH_PRED_SAMPLES
+    int      head;                     // slot of the newest
+    int64_t  t_us[TOUCH_PRED_SAMPLES];
+    int      x[TOUCH_PRED_SAMPLES];
+    int      y[TOUCH_PRED_SAMPLES];
+    bool     have_v;                   // vx/vy hold an estimate
+    float    vx, vy;                   // smoothed, px per second
+    int      smoothing;                // 0..TOUCH_PRED_SMOOTH_MAX
+} TouchMotion;
+
 // A touch is mapped to app coordinates in two independent stages.
 //
 // 1. CALIBRATION — raw digitiser value to PANEL pixel, a per-axis PIECEWISE
@@ -97,6 +143,11 @@ typedef struct {
     bool calibrated;
     TouchCalibration calib;
     bool portrait_mode;      // Portrait mode active (coordinate rotation)
+    // Motion prediction (touch_set_prediction); off after touch_init().
+    bool predict;
+    int predict_lead_us;     // touch_poll() predicts this far past itself; 0 = only
+                             // when the app calls touch_predict_at()
+    TouchMotion motion;
 } TouchInput;
 
 // Panel positions of the two interior knots, for a given panel extent. Fixed
@@ -211,4 +262,23 @@ int touch_load_calibration(TouchInput *touch, const char *filename);
 // Drain all pending events from the touch device (call after reopen)
 void touch_drain_events(TouchInput *touch);
 
+// Turn motion prediction on or off (see MOTION PREDICTION above). With
+// lead_us > 0 every touch_poll() fills pred_x/pred_y for lead_us past the
+// poll; with 0 they follow x/y until the app calls touch_predict_at().
+// `smoothing` is clamped to 0..TOUCH_PRED_SMOOTH_MAX.
+void touch_set_prediction(TouchInput *touch, bool enable, int lead_us, int smoothing);
+
+// Fill state.pred_x/pred_y for an explicit target time on CLOCK_MONOTONIC, in
+// ns — frame_sched's clock, so "the next present" can be passed as it knows it.
+// Measured position when prediction is off or the finger is up.
+void touch_predict_at(TouchInput *touch, uint64_t target_mono_ns);
+
+// The arithmetic behind both, exposed for the host test.
+void touch_motion_reset(TouchMotion *m);
+void touch_motion_add(TouchMotion *m, int64_t t_us, int x, int y);
+// Extrapolate the newest report to target_us, knowing it is now now_us; returns
+// false (and the newest position, or 0,0 with no reports) when it declines to.
+bool touch_motion_predict(const TouchMotion *m, int64_t now_us, int64_t target_us,
+                          int *x, int *y);
+
 #endif
@@ -22,6 +22,7 @@
 #include "../common/config.h"
 #include "../common/ui_layout.h"
 #include "../common/audio.h"
+#include "../common/input_lat.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -37,6 +38,7 @@
 #include <linux/fb.h>
 #include <math.h>
 #include <errno.h>
+#include <dirent.h>
 #include <linux/input.h>
 #include <ifaddrs.h>
 #include <net/if.h>
@@ -209,6 +211,7 @@ typedef enum {
     DIAG_HARDWARE,
     DIAG_CONFIG,
     DIAG_NETWORK,
+    DIAG_INPUT_LAT,
     DIAG_PAGE_COUNT
 } DiagPage;
 
@@ -243,7 +246,8 @@ static const char *test_names[] = {
 };
 
 static const char *diag_page_titles[] = {
-    "SYSTEM INFO", "MEMORY", "STORAGE", "HARDWARE", "CONFIGURATION", "NETWORK"
+    "SYSTEM INFO", "MEMORY", "STORAGE", "HARDWARE", "CONFIGURATION", "NETWORK",
+    "INPUT LATENCY"
 };
 
 typedef struct {
@@ -268,6 +272,7 @@ typedef struct {
     uint32_t      status_time_ms;
     DiagPage      diag_page;
     bool          diag_needs_refresh;
+    char          lat_selected[INPUT_LAT_NAME_MAX];  /* INPUT LATENCY: histogram shown */
     TestSubState  test_sub;
     int           test_selected;
     CalibSubState calib_sub;
@@ -313,6 +318,7 @@ static ModalDialog reboot_dialog;
 
 /* Diagnostics */
 static Button diag_prev_btn, diag_next_btn;
+static Button diag_lat_clear_btn;
 
 /* Tests */
 static UILayout test_layout;
@@ -937,6 +943,9 @@ static void create_diagnostics_ui(void) {
     button_init_full(&diag_next_btn, CONTENT_RIGHT - 120, nav_y,
                      120, 45, "NEXT >", RGB(60, 60, 80), COLOR_WHITE,
                      BTN_COLOR_HIGHLIGHT, 2);
+    button_init_full(&diag_lat_clear_btn, CONTENT_LEFT + CONTENT_WIDTH / 2 - 60, nav_y,
+                     120, 45, "CLEAR", RGB(60, 60, 80), COLOR_WHITE,
+                     BTN_COLOR_HIGHLIGHT, 2);
 }
 
 static void draw_diag_system(Framebuffer *fb) {
@@ -1153,6 +1162,141 @@ static void draw_diag_network(Framebuffer *fb) {
     y = draw_info_row(fb, y, "DNS:", dns, COLOR_DATA);
 }
 
+/* INPUT LATENCY — what every app linked with input_lat.o has published to
+ * INPUT_LAT_DIR (common/input_lat.h): per app, the time from an input's kernel
+ * timestamp to the next fb_swap().  The slowest apps by p95 are listed; a tap
+ * on a row draws that app's histogram underneath.  The directory is re-read at
+ * most once a second, since this page redraws every loop. */
+#define LAT_MAX_APPS   5
+#define LAT_ROW_Y0     (CONTENT_Y + 52)
+#define LAT_ROW_H      26
+#define LAT_BARS       64                   /* 4 ms each: 0..255 ms */
+
+typedef struct {
+    char          name[INPUT_LAT_NAME_MAX];
+    InputLatHist  hist;
+    InputLatStats st;
+} LatApp;
+
+static LatApp   lat_apps[LAT_MAX_APPS];
+static int      lat_app_cnt = 0;
+static uint32_t lat_loaded_ms = 0;
+static bool     lat_loaded = false;
+
+static void lat_reload(uint32_t now) {
+    if (lat_loaded && now - lat_loaded_ms < 1000) return;
+    lat_loaded = true;
+    lat_loaded_ms = now;
+    lat_app_cnt = 0;
+
+    DIR *d = opendir(INPUT_LAT_DIR);
+    if (!d) return;
+    struct dirent *de;
+    while ((de = readdir(d)) != NULL) {
+        if (de->d_name[0] == '.') continue;
+        char path[300];
+        snprintf(path, sizeof(path), "%s/%s", INPUT_LAT_DIR, de->d_name);
+        LatApp a;
+        /* A file whose recorded name is not its own is a writer's temp file
+         * caught before its rename. */
+        if (input_lat_load(path, a.name, &a.hist) != 0 || strcmp(a.name, de->d_name) != 0)
+            continue;
+        input_lat_hist_stats(&a.hist, &a.st);
+        if (a.st.count == 0 && a.st.stale == 0) continue;
+
+        /* Insertion by p95, slowest first; the fastest falls off the end. */
+        int at = lat_app_cnt;
+        while (at > 0 && lat_apps[at - 1].st.p95_us < a.st.p95_us) at--;
+        if (at >= LAT_MAX_APPS) continue;
+        int last = lat_app_cnt < LAT_MAX_APPS ? lat_app_cnt : LAT_MAX_APPS - 1;
+        memmove(&lat_apps[at + 1], &lat_apps[at], (size_t)(last - at) * sizeof(LatApp));
+        lat_apps[at] = a;
+        if (lat_app_cnt < LAT_MAX_APPS) lat_app_cnt++;
+    }
+    closedir(d);
+}
+
+static void lat_clear(void) {
+    DIR *d = opendir(INPUT_LAT_DIR);
+    if (d) {
+        struct dirent *de;
+        while ((de = readdir(d)) != NULL) {
+            if (de->d_name[0] == '.') continue;
+            char path[300];
+            snprintf(path, sizeof(path), "%s/%s", INPUT_LAT_DIR, de->d_name);
+            unlink(path);
+        }
+        closedir(d);
+    }
+    lat_loaded = false;
+}
+
+static void draw_diag_input_lat(Framebuffer *fb, AppState *state) {
+    lat_reload(get_time_ms());
+    int y = CONTENT_Y + 30;
+    char b[128];
+
+    if (lat_app_cnt == 0) {
+        fb_draw_text(fb, CONTENT_LEFT+10, y, "NO SAMPLES YET", COLOR_LABEL, 2); y += 28;
+        fb_draw_text(fb, CONTENT_LEFT+10, y,
+                     "PLAY A GAME, THEN COME BACK: EVERY APP PUBLISHES ITS INPUT-TO-SWAP TIME",
+                     COLOR_LABEL, 1);
+        return;
+    }
+
+    fb_draw_text(fb, CONTENT_LEFT+10, y, "APP (SLOWEST P95 FIRST)   INPUTS  P50  P95  MAX MS",
+                 COLOR_LABEL, 1);
+
+    const LatApp *sel = &lat_apps[0];
+    for (int i = 0; i < lat_app_cnt; i++)
+        if (strcmp(lat_apps[i].name, state->lat_selected) == 0) sel = &lat_apps[i];
+
+    for (int i = 0; i < lat_app_cnt; i++) {
+        const LatApp *a = &lat_apps[i];
+        int ry = LAT_ROW_Y0 + i * LAT_ROW_H;
+        if (a == sel) fb_fill_rect(fb, CONTENT_LEFT, ry - 4, CONTENT_WIDTH, LAT_ROW_H - 2, COLOR_TAB_ACTIVE);
+        snprintf(b, sizeof(b), "%-12.12s %6u %4u %4u %4u", a->name, (unsigned)a->st.count,
+                 (unsigned)(a->st.p50_us / 1000), (unsigned)(a->st.p95_us / 1000),
+                 (unsigned)(a->st.max_us / 1000));
+        uint32_t c = a->st.p95_us > 100000 ? COLOR_BAR_CRIT
+                   : a->st.p95_us > 50000  ? COLOR_BAR_WARN : COLOR_DATA;
+        fb_draw_text(fb, CONTENT_LEFT+10, ry, b, c, 2);
+    }
+
+    y = LAT_ROW_Y0 + lat_app_cnt * LAT_ROW_H + 6;
+    fb_draw_line(fb, CONTENT_LEFT, y, CONTENT_RIGHT, y, COLOR_SECTION_LINE); y += 8;
+    snprintf(b, sizeof(b), "%s: MIN %u  AVG %u  P50 %u  P95 %u  MAX %u MS, %u STALE",
+             sel->name, (unsigned)(sel->st.min_us / 1000), (unsigned)(sel->st.avg_us / 1000),
+             (unsigned)(sel->st.p50_us / 1000), (unsigned)(sel->st.p95_us / 1000),
+             (unsigned)(sel->st.max_us / 1000), (unsigned)sel->st.stale);
+    fb_draw_text(fb, CONTENT_LEFT+10, y, b, COLOR_HEADER_TEXT, 1); y += 16;
+
+    /* The histogram: LAT_BARS columns of 4 ms, the last one also holding
+     * everything past 255 ms, scaled to the tallest. */
+    int top = y, bottom = CONTENT_Y + CONTENT_H - 55 - 22;
+    if (bottom - top < 20) return;
+    uint32_t bars[LAT_BARS], peak = 1;
+    for (int i = 0; i < LAT_BARS; i++) {
+        bars[i] = 0;
+        for (int k = 0; k < INPUT_LAT_BINS / LAT_BARS; k++)
+            bars[i] += sel->hist.hist[i * (INPUT_LAT_BINS / LAT_BARS) + k];
+        if (bars[i] > peak) peak = bars[i];
+    }
+    int bw = CONTENT_WIDTH / LAT_BARS;
+    int x0 = CONTENT_LEFT + (CONTENT_WIDTH - bw * LAT_BARS) / 2;
+    fb_fill_rect(fb, x0, top, bw * LAT_BARS, bottom - top, COLOR_BAR_BG);
+    for (int i = 0; i < LAT_BARS; i++) {
+        int h = (int)((uint64_t)bars[i] * (uint32_t)(bottom - top) / peak);
+        if (bars[i] && h < 1) h = 1;
+        int ms = i * (INPUT_LAT_BINS / LAT_BARS);
+        uint32_t c = ms >= 100 ? COLOR_BAR_CRIT : ms >= 50 ? COLOR_BAR_WARN : COLOR_BAR_FILL;
+        if (h > 0) fb_fill_rect(fb, x0 + i * bw, bottom - h, bw > 1 ? bw - 1 : 1, h, c);
+    }
+    fb_draw_text(fb, x0, bottom + 4, "0", COLOR_LABEL, 1);
+    fb_draw_text(fb, x0 + bw * LAT_BARS / 2 - 9, bottom + 4, "128", COLOR_LABEL, 1);
+    fb_draw_text(fb, x0 + bw * LAT_BARS - 42, bottom + 4, "256+ MS", COLOR_LABEL, 1);
+}
+
 static void draw_diagnostics(Framebuffer *fb, AppState *state) {
     fb_draw_text(fb, CONTENT_LEFT+10, CONTENT_Y+5,
                  diag_page_titles[state->diag_page], COLOR_HEADER_TEXT, 2);
@@ -1166,9 +1310,11 @@ static void draw_diagnostics(Framebuffer *fb, AppState *state) {
         case DIAG_HARDWARE:draw_diag_hardware(fb); break;
         case DIAG_CONFIG:  draw_diag_config(fb);   break;
         case DIAG_NETWORK: draw_diag_network(fb);  break;
+        case DIAG_INPUT_LAT: draw_diag_input_lat(fb, state); break;
         default: break;
     }
     if (state->diag_page > 0) button_draw(fb, &diag_prev_btn);
+    if (state->diag_page == DIAG_INPUT_LAT) button_draw(fb, &diag_lat_clear_btn);
     if (state->diag_page < DIAG_PAGE_COUNT - 1)
         button_set_text(&diag_next_btn, "NEXT >");
     else
@@ -1188,6 +1334,18 @@ static void handle_diag_input(AppState *state, int tx, int ty,
         state->diag_page = (DiagPage)next;
         state->diag_needs_refresh = true;
     }
+    if (state->diag_page != DIAG_INPUT_LAT) return;
+    if (button_update(&diag_lat_clear_btn, tx, ty, touching, now)) {
+        /* An app still running puts its own history back at its next publish. */
+        lat_clear();
+    }
+    if (touching) {
+        for (int i = 0; i < lat_app_cnt; i++) {
+            int ry = LAT_ROW_Y0 + i * LAT_ROW_H;
+            if (ty >= ry - 4 && ty < ry - 4 + LAT_ROW_H && tx >= CONTENT_LEFT && tx < CONTENT_RIGHT)
+                memcpy(state->lat_selected, lat_apps[i].name, sizeof(state->lat_selected));
+        }
+    }
 }
 
 /* â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•â•
@@ -20,6 +20,7 @@
 #include "../common/hardware.h"
 #include "../common/highscore.h"
 #include "../common/audio.h"
+#include "../common/frame_sched.h"
 #include "../common/logger.h"
 #include "../common/gamepad.h"
 
@@ -184,8 +185,6 @@ HighScoreTable hs_table;
 static GameOverScreen gos;
 bool running = true;
 GameScreen current_screen = SCREEN_WELCOME;
-static uint32_t last_rescan_ms = 0;
-#define RESCAN_INTERVAL_MS 5000
 
 static Lane lanes[NUM_LANE_CONFIGS];
 static Frog frog;
@@ -214,6 +213,16 @@ static int goal_cols[NUM_GOALS];
  * push them into the playfield.  Equals HUD_HEIGHT when the inset is 0. */
 static int hud_height;
 
+/* The goal zone, the grass verges and the road, painted into an offscreen layer
+ * that replaces the frame's clear: the grass alone is a few hundred seeded dots,
+ * redrawn every frame for rows that look the same all game.  The water lanes
+ * animate and stay per-frame.  The lily pads are the only part that changes,
+ * so every site that writes goals_reached invalidates the layer — reset_game(),
+ * advance_level() and check_goal_reached().  If the surface could not be
+ * allocated, draw_all() clears and draws the three straight onto fb. */
+static FbLayer verge;
+static bool verge_ok = false;
+
 /* UI Buttons */
 Button menu_button;
 Button exit_button;
@@ -269,9 +278,10 @@ static void draw_hud(void);
 static void draw_timer_bar(void);
 static void draw_life_icons(int x, int y);
 static void draw_water_lane(int row);
-static void draw_road_lane(int row);
-static void draw_grass_lane(int row);
-static void draw_goal_zone(void);
+static void draw_road_lane(Surface *t, int row);
+static void draw_grass_lane(Surface *t, int row);
+static void draw_goal_zone(Surface *t);
+static void draw_static_lanes(Surface *t);
 static void draw_frog_sprite(int screen_x, int screen_y);
 static void draw_car(int sx, int sy, uint32_t color);
 static void draw_truck(int sx, int sy, uint32_t color);
@@ -465,6 +475,7 @@ static void reset_game(void) {
     state.goals_filled = 0;
     for (int i = 0; i < NUM_GOALS; i++)
         state.goals_reached[i] = false;
+    fb_layer_invalidate(&verge);
 
     death_anim_active  = false;
     death_anim_frame   = 0;
@@ -505,6 +516,7 @@ static void advance_level(void) {
     for (int i = 0; i < NUM_GOALS; i++)
         state.goals_reached[i] = false;
     state.goals_filled = 0;
+    fb_layer_invalidate(&verge);
 
     init_lanes();
     reset_frog_position();
@@ -671,6 +683,7 @@ static void check_goal_reached(void) {
         if (frog.col == goal_cols[i] && !state.goals_reached[i]) {
             state.goals_reached[i] = true;
             state.goals_filled++;
+            fb_layer_invalidate(&verge);
             state.score += 50;
             state.score += (int)state.timer * 10;
 
@@ -753,12 +766,6 @@ static void handle_input(void) {
     // Poll gamepad/keyboard/touch through unified API
     gamepad_poll(&gamepad, &input, ts.x, ts.y, ts.pressed);
 
-    // Periodic device rescan for hotplug support
-    if (now - last_rescan_ms > RESCAN_INTERVAL_MS) {
-        last_rescan_ms = now;
-        gamepad_rescan(&gamepad);
-    }
-
     // BTN_BACK always exits to launcher
     if (input.buttons[BTN_ID_BACK].pressed) {
         fb_fade_out(&fb);
@@ -1117,25 +1124,25 @@ static void draw_water_lane(int row) {
     }
 }
 
-static void draw_road_lane(int row) {
+static void draw_road_lane(Surface *t, int row) {
     int y = grid_offset_y + row * cell_size;
     int x = grid_offset_x;
     int w = grid_width;
 
-    fb_fill_rect(&fb, x, y, w, cell_size, COLOR_ROAD_DARK);
+    fb_fill_rect(t, x, y, w, cell_size, COLOR_ROAD_DARK);
 
     int dash_y = y + cell_size / 2 - 1;
     int step = cell_size; if (step < 4) step = 4;
     for (int dx = 0; dx < w; dx += step)
-        fb_fill_rect(&fb, x + dx + 2, dash_y, cell_size / 2 - 2, 2, COLOR_ROAD_LINE);
+        fb_fill_rect(t, x + dx + 2, dash_y, cell_size / 2 - 2, 2, COLOR_ROAD_LINE);
 }
 
-static void draw_grass_lane(int row) {
+static void draw_grass_lane(Surface *t, int row) {
     int y = grid_offset_y + row * cell_size;
     int x = grid_offset_x;
     int w = grid_width;
 
-    fb_fill_rect(&fb, x, y, w, cell_size, COLOR_GRASS_DARK);
+    fb_fill_rect(t, x, y, w, cell_size, COLOR_GRASS_DARK);
 
     unsigned int seed = (unsigned int)(row * 1000);
     int dots = w / 8; if (dots < 1) dots = 1;
@@ -1144,16 +1151,16 @@ static void draw_grass_lane(int row) {
         int ddx = (int)((seed >> 16) % (unsigned)w);
         seed = seed * 1103515245u + 12345u;
         int ddy = (int)((seed >> 16) % (unsigned)cell_size);
-        fb_fill_rect(&fb, x + ddx, y + ddy, 2, 2, COLOR_GRASS_LIGHT);
+        fb_fill_rect(t, x + ddx, y + ddy, 2, 2, COLOR_GRASS_LIGHT);
     }
 }
 
-static void draw_goal_zone(void) {
+static void draw_goal_zone(Surface *t) {
     int y = grid_offset_y;
     int x = grid_offset_x;
     int w = grid_width;
 
-    fb_fill_rect(&fb, x, y, w, cell_size, COLOR_WATER_DARK);
+    fb_fill_rect(t, x, y, w, cell_size, COLOR_WATER_DARK);
 
     for (int i = 0; i < NUM_GOALS; i++) {
         int px = grid_offset_x + goal_cols[i] * cell_size + cell_size / 2;
@@ -1161,19 +1168,37 @@ static void draw_goal_zone(void) {
         int pr = cell_size / 2 - 2; if (pr < 3) pr = 3;
 
         if (state.goals_reached[i]) {
-            fb_fill_circle(&fb, px, py, pr, COLOR_LILYPAD);
-            fb_fill_circle(&fb, px, py, pr / 2, COLOR_GOAL_FROG);
-            fb_fill_circle(&fb, px - pr / 4, py - pr / 3, 2, COLOR_FROG_EYE_W);
-            fb_fill_circle(&fb, px + pr / 4, py - pr / 3, 2, COLOR_FROG_EYE_W);
+            fb_fill_circle(t, px, py, pr, COLOR_LILYPAD);
+            fb_fill_circle(t, px, py, pr / 2, COLOR_GOAL_FROG);
+            fb_fill_circle(t, px - pr / 4, py - pr / 3, 2, COLOR_FROG_EYE_W);
+            fb_fill_circle(t, px + pr / 4, py - pr / 3, 2, COLOR_FROG_EYE_W);
         } else {
-            fb_fill_circle(&fb, px, py, pr, COLOR_LILYPAD);
-            fb_draw_line(&fb, px, py, px - pr / 2, py - pr, COLOR_WATER_DARK);
-            fb_draw_line(&fb, px, py, px + pr / 2, py - pr, COLOR_WATER_DARK);
-            fb_fill_circle(&fb, px + 1, py + 1, pr / 3, COLOR_LILYPAD_LIGHT);
+            fb_fill_circle(t, px, py, pr, COLOR_LILYPAD);
+            fb_draw_line(t, px, py, px - pr / 2, py - pr, COLOR_WATER_DARK);
+            fb_draw_line(t, px, py, px + pr / 2, py - pr, COLOR_WATER_DARK);
+            fb_fill_circle(t, px + 1, py + 1, pr / 3, COLOR_LILYPAD_LIGHT);
         }
     }
 }
 
+/* The rows that do not animate, in the order draw_playing_field() used to draw
+ * them — a grass dot can spill a pixel into the road row below it. */
+static void draw_static_lanes(Surface *t) {
+    for (int row = 0; row < NUM_ROWS; row++) {
+        if (row == 0)
+            draw_goal_zone(t);
+        else if (row == 6 || row == 12)
+            draw_grass_lane(t, row);
+        else if (row >= 7 && row <= 11)
+            draw_road_lane(t, row);
+    }
+}
+
+/* The verge layer's paint function. */
+static void paint_verge(Surface *s, void *user) {
+    draw_static_lanes(s);
+}
+
 /* ═══════════════════════════════════════════════════════════════════════════
  * Draw Lane Objects
  * ═══════════════════════════════════════════════════════════════════════════ */
@@ -1301,18 +1326,10 @@ static void draw_hud(void) {
  * ═══════════════════════════════════════════════════════════════════════════ */
 
 static void draw_playing_field(void) {
-    /* 1. Draw lane backgrounds */
-    for (int row = 0; row < NUM_ROWS; row++) {
-        if (row == 0) {
-            draw_goal_zone();
-        } else if (row >= 1 && row <= 5) {
-            draw_water_lane(row);
-        } else if (row == 6 || row == 12) {
-            draw_grass_lane(row);
-        } else if (row >= 7 && row <= 11) {
-            draw_road_lane(row);
-        }
-    }
+    /* 1. Draw the water lanes; the rest of the lane backgrounds came with the
+     *    frame's background (draw_all()) */
+    for (int row = 1; row <= 5; row++)
+        draw_water_lane(row);
 
     /* 2. Draw lane objects */
     for (int i = 0; i < NUM_LANE_CONFIGS; i++)
@@ -1360,10 +1377,9 @@ static void draw_playing_field(void) {
  * ═══════════════════════════════════════════════════════════════════════════ */
 
 static void draw_all(void) {
-    fb_clear(&fb, COLOR_BLACK);
-
     /* ── Welcome screen ──────────────────────────────────────────────── */
     if (current_screen == SCREEN_WELCOME) {
+        fb_clear(&fb, COLOR_BLACK);
         draw_welcome_screen(&fb, "FROGGER",
             "TAP AHEAD OF THE FROG TO HOP\n"
             "OR USE A D-PAD / ARROW KEYS\n"
@@ -1374,7 +1390,15 @@ static void draw_all(void) {
         return;
     }
 
-    /* Draw the playing field as background for PLAYING, PAUSED, GAME_OVER */
+    /* Draw the playing field as background for PLAYING, PAUSED, GAME_OVER.
+     * The verge layer is black outside the grid, so it stands in for the clear;
+     * the HUD band is above the grid and covers the layer's top edge. */
+    if (verge_ok) {
+        fb_layer_blit(&fb, &verge, 0, 0);
+    } else {
+        fb_clear(&fb, COLOR_BLACK);
+        draw_static_lanes(&fb);
+    }
     draw_hud();
     draw_playing_field();
 
@@ -1458,6 +1482,11 @@ int main(int argc, char *argv[]) {
      * rather than muting, so there is nothing for a game to do about it, and
      * audio_close() reports which path actually ran. */
     audio_cont_enable(&audio, true);
+    /* Opt-in (`audio_server` in the config): the bus in a forked process of its
+     * own, so the name-entry screen and the touch drains, which do not pump,
+     * stop starving the stream.  Unchecked for the same reason as the line
+     * above — a refusal leaves the in-loop path exactly as it was. */
+    if (audio_server_enabled(&audio)) audio_server_start(&audio);
 
     /* Framebuffer init */
     /* Pin 32bpp — /dev/fb0 keeps whatever ran last (see fb_set_bpp). */
@@ -1476,6 +1505,9 @@ int main(int argc, char *argv[]) {
     }
     touch_set_screen_size(&touch, fb.width, fb.height);
 
+    verge_ok = fb_layer_init(&verge, &fb, (int)fb.width, (int)fb.height,
+                             paint_verge, NULL) == 0;
+
     /* Gamepad init */
     gamepad_init(&gamepad);
 
@@ -1488,9 +1520,16 @@ int main(int argc, char *argv[]) {
     printf("Frogger game started! Touch screen to play.\n");
     printf("Press Ctrl+C to exit.\n");
 
+    FrameSched sched;
+    frame_sched_init(&sched, FRAME_DELAY_ACTIVE_US, FRAME_DELAY_IDLE_US);
+    frame_sched_set_audio(&sched, audio_pump_slot, &audio,
+                          audio_cont_service_interval_us(&audio) / 2);
+    frame_sched_set_report(&sched, 60000, frame_stats_print, "frogger: frames");
+
     /* ── Main game loop ────────────────────────────────────────────────── */
     bool needs_redraw = true;
     while (running) {
+        frame_sched_begin(&sched);
         GameScreen prev_screen = current_screen;
         handle_input();
         update_game();
@@ -1516,21 +1555,21 @@ int main(int argc, char *argv[]) {
         if (current_screen == SCREEN_GAME_OVER && gameover_needs_redraw(&gos))
             needs_redraw = true;
 
-        if (needs_redraw) {
+        if (needs_redraw && frame_sched_render_due(&sched)) {
             draw_all();
             fb_swap(&fb);
+            needs_redraw = false;
         }
 
-        /* Service the stream on EVERY iteration, drawing or not — it holds one
-         * lead (~139 ms on the OSS shim) and a skipped service is an audible
-         * gap.  ⚠️ audio_pump_active() belongs in the pacing decision: it is
-         * unconditionally true while the continuous stream is live, and
-         * FRAME_DELAY_IDLE_US (100 ms) is well above the ~55 ms service ceiling
-         * the library measures for itself (../common/audio_out.h). */
-        audio_pump(&audio);
-        usleep((needs_redraw || audio_pump_active(&audio))
-               ? FRAME_DELAY_ACTIVE_US : FRAME_DELAY_IDLE_US);
-        needs_redraw = false;
+        /* frame_sched_end() runs the audio slot (audio_pump_slot) on EVERY
+         * iteration, drawing or not, and again in slices through the wait — the
+         * stream holds one lead (~139 ms on the OSS shim) and a skipped service
+         * is an audible gap.  ⚠️ audio_pump_active() is still in the pacing
+         * decision, as the slot's return value: it is unconditionally true
+         * while the continuous stream is live.  The wait is to an absolute
+         * deadline, so this frame's work is inside FRAME_DELAY_ACTIVE_US rather
+         * than added to it (common/frame_sched.h). */
+        frame_sched_end(&sched);
     }
 
     /* Cleanup */
@@ -1539,6 +1578,7 @@ int main(int argc, char *argv[]) {
     audio_close(&audio);
     gamepad_close(&gamepad);
     touch_close(&touch);
+    fb_layer_free(&verge);
     fb_close(&fb);
 
     printf("Frogger game ended. Final score: %d\n", state.score);
@@ -25,7 +25,6 @@
 #define BUTTON_HEIGHT 80
 #define BUTTON_MARGIN 20
 #define EXIT_BUTTON_HEIGHT 60
-#define RESCAN_INTERVAL_MS 5000
 
 /* Post-launch cooldown: ignore ALL input (gamepad, touch, mouse) for this
  * many milliseconds after returning from a child process.  This prevents
@@ -54,7 +53,6 @@ typedef struct {
     TouchInput touch;
     GamepadManager gamepad;
     InputState input;
-    uint32_t last_rescan_ms;
     uint32_t last_launch_return_ms;  /* Timestamp of last child-exit for cooldown */
 } GameSelector;
 
@@ -482,7 +480,6 @@ int main(int argc, char *argv[]) {
     // Initialize gamepad (keyboard, gamepad, mouse)
     gamepad_init(&selector.gamepad);
     memset(&selector.input, 0, sizeof(selector.input));
-    selector.last_rescan_ms = 0;
     selector.last_launch_return_ms = 0;
     
     // Scan for available games
@@ -517,13 +514,7 @@ int main(int argc, char *argv[]) {
         // Poll gamepad/keyboard through unified API
         gamepad_poll(&selector.gamepad, &selector.input,
                      state.x, state.y, state.pressed);
-
-        // Periodic device rescan for hotplug support
         uint32_t current_time = get_time_ms();
-        if (current_time - selector.last_rescan_ms > RESCAN_INTERVAL_MS) {
-            selector.last_rescan_ms = current_time;
-            gamepad_rescan(&selector.gamepad);
-        }
 
         /* Save state for dirty-flag comparison */
         int old_selected = selector.selected_game;
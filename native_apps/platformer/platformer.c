@@ -28,6 +28,7 @@
 #include "../common/hardware.h"
 #include "../common/highscore.h"
 #include "../common/audio.h"
+#include "../common/frame_sched.h"
 #include "../common/config.h"
 #include "../common/gamepad.h"
 
@@ -77,7 +78,6 @@
 #define HUD_HEIGHT       40
 #define DEATH_ANIM_FRAMES 20
 #define INVINCIBLE_TIME  60
-#define RESCAN_INTERVAL_MS 5000   /* USB hotplug re-detect, as in the other games */
 #define COIN_SCORE       100
 #define STOMP_SCORE      200
 #define LEVEL_BONUS      1000
@@ -426,6 +426,12 @@ static void bed_service(void) {
         if (audio_music_start(&audio, bed_track[t], true)) {
             bed_state = BED_PLAYING;
             bed_next  = (t + 1) % bed_track_count;   /* the NEXT fresh start */
+            /* Open and prefetch it NOW, a whole level ahead, so the start at the
+             * boundary takes a warm file instead of a cold SD open.  Unchained on
+             * purpose: the level-complete release IS the track change here.  A
+             * refused cue marks nothing — the start reports its own failure. */
+            if (bed_next != t && !bed_failed[bed_next])
+                audio_music_cue(&audio, bed_track[bed_next], false);
             break;
         }
         /* A missing file, a rate mismatch or a bus that never came up are all
@@ -1854,20 +1860,6 @@ static void handle_input(void) {
     gamepad_poll(&gamepad, &input, ts.x, ts.y, ts.pressed);
     uint32_t now = get_time_ms();
 
-    /* Periodic device rescan for hotplug.  This game is controller-only, and it
-     * was the one app of ten with no rescan: gamepad.c's read loop is
-     * `while (read(fd, …) == sizeof(ev))`, so a pad that leaves the bus just
-     * makes read() fail forever on a stale fd and nothing reopens it.  Input
-     * then stays dead for the life of the process — which is what was seen on
-     * the panel 2026-08-10, and why relaunching the game fixed it.
-     * gamepad_rescan() also clears held_latched[], so a direction held at
-     * unplug time does not stay asserted. */
-    static uint32_t last_rescan_ms = 0;
-    if (now - last_rescan_ms > RESCAN_INTERVAL_MS) {
-        last_rescan_ms = now;
-        gamepad_rescan(&gamepad);
-    }
-
     /* BTN_BACK always exits to the launcher. Platformer was the only game without
      * this, which left its game-over screen with no way out. */
     if (input.buttons[BTN_ID_BACK].pressed) {
@@ -2001,6 +1993,11 @@ int main(int argc, char *argv[]) {
      * rather than muting, so there is nothing for a game to do about it, and
      * audio_close() reports which path actually ran. */
     audio_cont_enable(&audio, true);
+    /* Opt-in (`audio_server` in the config): the bus in a forked process of its
+     * own, so the name-entry screen and the touch drains, which do not pump,
+     * stop starving the stream.  Unchecked for the same reason as the line
+     * above — a refusal leaves the in-loop path exactly as it was. */
+    if (audio_server_enabled(&audio)) audio_server_start(&audio);
     bed_configure();
 
     /* Framebuffer init */
@@ -2031,9 +2028,16 @@ int main(int argc, char *argv[]) {
 
     printf("Office Runner started! Press Ctrl+C to exit.\n");
 
+    FrameSched sched;
+    frame_sched_init(&sched, FRAME_DELAY_ACTIVE_US, FRAME_DELAY_IDLE_US);
+    frame_sched_set_audio(&sched, audio_pump_slot, &audio,
+                          audio_cont_service_interval_us(&audio) / 2);
+    frame_sched_set_report(&sched, 60000, frame_stats_print, "platformer: frames");
+
     /* Main loop */
     bool needs_redraw = true;
     while (running) {
+        frame_sched_begin(&sched);
         GameScreen prev_screen = current_screen;
         handle_input();
         update_game();
@@ -2060,23 +2064,23 @@ int main(int argc, char *argv[]) {
         if (current_screen == SCREEN_GAME_OVER && gameover_needs_redraw(&gos))
             needs_redraw = true;
 
-        if (needs_redraw) {
+        if (needs_redraw && frame_sched_render_due(&sched)) {
             draw_all();
             fb_swap(&fb);
+            needs_redraw = false;
         }
 
-        /* Service the stream on EVERY iteration, drawing or not — it holds one
-         * lead (~139 ms on the OSS shim) and a skipped service is an audible
-         * gap.  ⚠️ audio_pump_active() belongs in the pacing decision: it is
-         * unconditionally true while the continuous stream is live, and
-         * FRAME_DELAY_IDLE_US (100 ms) is well above the ~55 ms service ceiling
-         * the library measures for itself (../common/audio_out.h). */
+        /* frame_sched_end() runs the audio slot (audio_pump_slot) on EVERY
+         * iteration, drawing or not, and again in slices through the wait — the
+         * stream holds one lead (~139 ms on the OSS shim) and a skipped service
+         * is an audible gap.  ⚠️ audio_pump_active() is still in the pacing
+         * decision, as the slot's return value: it is unconditionally true
+         * while the continuous stream is live.  The wait is to an absolute
+         * deadline, so this frame's work is inside FRAME_DELAY_ACTIVE_US rather
+         * than added to it (common/frame_sched.h). */
         bed_service();          /* one bed transition, BEFORE the pump so a voice
                                  * started this iteration is rendered by it */
-        audio_pump(&audio);
-        usleep((needs_redraw || audio_pump_active(&audio))
-               ? FRAME_DELAY_ACTIVE_US : FRAME_DELAY_IDLE_US);
-        needs_redraw = false;
+        frame_sched_end(&sched);
     }
 
     /* Cleanup */
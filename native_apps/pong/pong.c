@@ -17,6 +17,7 @@
 #include "../common/common.h"
 #include "../common/hardware.h"
 #include "../common/audio.h"
+#include "../common/frame_sched.h"
 #include "../common/gamepad.h"
 
 #define PADDLE_WIDTH 15
@@ -75,10 +76,12 @@ GameScreen current_screen = SCREEN_WELCOME;
 bool portrait_mode = false;
 static HighScoreTable hs_table;
 static GameOverScreen gos;
-static uint32_t last_rescan_ms = 0;
-#define RESCAN_INTERVAL_MS 5000
 /* LED flourishes (game start, match won), advanced once per frame by the main loop. */
 static LedPulse led_pulse;
+/* The player paddle is DRAWN this far past game.player.y: the touch
+ * prediction's lead while a finger drags it, 0 otherwise. game.player.y itself
+ * — what the ball bounces off — follows the measured touch (handle_input()). */
+static float player_lead = 0;
 
 // Function prototypes
 void init_game();
@@ -139,6 +142,7 @@ void reset_game() {
         game.player.y = play_area_height / 2 - PADDLE_HEIGHT / 2;
         game.ai.y = play_area_height / 2 - PADDLE_HEIGHT / 2;
     }
+    player_lead = 0;
     game.player.score = 0;
     game.ai.score = 0;
     game.game_over = false;
@@ -399,12 +403,6 @@ void handle_input() {
     // Poll gamepad/keyboard/touch through unified API
     gamepad_poll(&gamepad, &input, state.x, state.y, state.pressed);
 
-    // Periodic device rescan for hotplug support
-    if (current_time - last_rescan_ms > RESCAN_INTERVAL_MS) {
-        last_rescan_ms = current_time;
-        gamepad_rescan(&gamepad);
-    }
-
     // BTN_BACK always exits to launcher
     if (input.buttons[BTN_ID_BACK].pressed) {
         fb_fade_out(&fb);
@@ -517,27 +515,29 @@ void handle_input() {
         }
     }
     
-    // Move player paddle to touch position (existing touch behavior)
+    // Move player paddle to touch position (existing touch behavior).
+    // The measured touch moves the paddle the ball collides with; the
+    // predicted one only where it is drawn (player_lead), so a wrong guess
+    // never decides a return (common/touch_input.h, MOTION PREDICTION).
+    if (!game.paused) player_lead = 0;
     if ((state.held || state.pressed) && !game.game_over && !game.paused) {
-        if (portrait_mode) {
-            // Portrait: move paddle horizontally using touch X
-            int relative_x = state.x - offset_x;
-            game.player.y = relative_x - PADDLE_HEIGHT / 2;
-            
-            if (game.player.y < 0) game.player.y = 0;
-            if (game.player.y > play_area_width - PADDLE_HEIGHT) {
-                game.player.y = play_area_width - PADDLE_HEIGHT;
-            }
-        } else {
-            // Landscape: move paddle vertically using touch Y
-            int relative_y = state.y - offset_y;
-            game.player.y = relative_y - PADDLE_HEIGHT / 2;
-            
-            if (game.player.y < 0) game.player.y = 0;
-            if (game.player.y > play_area_height - PADDLE_HEIGHT) {
-                game.player.y = play_area_height - PADDLE_HEIGHT;
-            }
-        }
+        // Portrait: the paddle moves horizontally, with touch X;
+        // landscape: vertically, with touch Y
+        float max_pos = portrait_mode ?
+            (float)(play_area_width - PADDLE_HEIGHT) :
+            (float)(play_area_height - PADDLE_HEIGHT);
+        int origin = portrait_mode ? offset_x : offset_y;
+        int at     = portrait_mode ? state.x : state.y;
+        int ahead  = portrait_mode ? state.pred_x : state.pred_y;
+
+        game.player.y = at - origin - PADDLE_HEIGHT / 2;
+        if (game.player.y < 0) game.player.y = 0;
+        if (game.player.y > max_pos) game.player.y = max_pos;
+
+        float drawn = ahead - origin - PADDLE_HEIGHT / 2;
+        if (drawn < 0) drawn = 0;
+        if (drawn > max_pos) drawn = max_pos;
+        player_lead = drawn - game.player.y;
     }
 
     // Gamepad/keyboard paddle movement (when not touching)
@@ -611,7 +611,7 @@ static void draw_playing_field(void) {
                      PADDLE_HEIGHT, PADDLE_WIDTH, COLOR_RED);
         
         // Draw player paddle (bottom, green) — horizontal paddle
-        fb_fill_rect(&fb, offset_x + (int)game.player.y,
+        fb_fill_rect(&fb, offset_x + (int)(game.player.y + player_lead),
                      offset_y + play_area_height - PADDLE_WIDTH - 5,
                      PADDLE_HEIGHT, PADDLE_WIDTH, COLOR_GREEN);
         
@@ -629,7 +629,7 @@ static void draw_playing_field(void) {
         }
         
         // Draw player paddle (left, green)
-        fb_fill_rect(&fb, offset_x + 5, offset_y + (int)game.player.y,
+        fb_fill_rect(&fb, offset_x + 5, offset_y + (int)(game.player.y + player_lead),
                      PADDLE_WIDTH, PADDLE_HEIGHT, COLOR_GREEN);
         
         // Draw AI paddle (right, red)
@@ -728,6 +728,11 @@ int main(int argc, char *argv[]) {
         fb_close(&fb);
         return 1;
     }
+    // Predicted touch for the paddle: it follows where the finger will be a
+    // frame from now, not its last report (common/touch_input.h, MOTION
+    // PREDICTION). Buttons keep using the measured state.x/state.y, and so
+    // does the paddle the ball bounces off — only its drawing leads.
+    touch_set_prediction(&touch, true, FRAME_DELAY_ACTIVE_US, 50);
     
     // Initialize hardware control
     hw_init();
@@ -744,6 +749,11 @@ int main(int argc, char *argv[]) {
      * rather than muting, so there is nothing for a game to do about it, and
      * audio_close() reports which path actually ran. */
     audio_cont_enable(&audio, true);
+    /* Opt-in (`audio_server` in the config): the bus in a forked process of its
+     * own, so the name-entry screen and the touch drains, which do not pump,
+     * stop starving the stream.  Unchecked for the same reason as the line
+     * above — a refusal leaves the in-loop path exactly as it was. */
+    if (audio_server_enabled(&audio)) audio_server_start(&audio);
     
     srand(time(NULL));
     init_game();
@@ -752,11 +762,18 @@ int main(int argc, char *argv[]) {
     gamepad_init(&gamepad);
     gamepad_set_mouse_bounds(&gamepad, fb.width, fb.height);
 
+    FrameSched sched;
+    frame_sched_init(&sched, FRAME_DELAY_ACTIVE_US, FRAME_DELAY_IDLE_US);
+    frame_sched_set_audio(&sched, audio_pump_slot, &audio,
+                          audio_cont_service_interval_us(&audio) / 2);
+    frame_sched_set_report(&sched, 60000, frame_stats_print, "pong: frames");
+
     printf("Pong game started!\n");
     
     /* ── main loop ───────────────────────────────────────────────────── */
     bool needs_redraw = true;
     while (running) {
+        frame_sched_begin(&sched);
         GameScreen prev_screen = current_screen;
         handle_input();
         update_game();
@@ -783,21 +800,21 @@ int main(int argc, char *argv[]) {
         if (current_screen == SCREEN_GAME_OVER && gameover_needs_redraw(&gos))
             needs_redraw = true;
 
-        if (needs_redraw) {
+        if (needs_redraw && frame_sched_render_due(&sched)) {
             draw_game();
             fb_swap(&fb);
+            needs_redraw = false;
         }
 
-        /* Service the stream on EVERY iteration, drawing or not — it holds one
-         * lead (~139 ms on the OSS shim) and a skipped service is an audible
-         * gap.  ⚠️ audio_pump_active() belongs in the pacing decision: it is
-         * unconditionally true while the continuous stream is live, and
-         * FRAME_DELAY_IDLE_US (100 ms) is well above the ~55 ms service ceiling
-         * the library measures for itself (../common/audio_out.h). */
-        audio_pump(&audio);
-        usleep((needs_redraw || audio_pump_active(&audio))
-               ? FRAME_DELAY_ACTIVE_US : FRAME_DELAY_IDLE_US);
-        needs_redraw = false;  /* reset for next frame */
+        /* frame_sched_end() runs the audio slot (audio_pump_slot) on EVERY
+         * iteration, drawing or not, and again in slices through the wait — the
+         * stream holds one lead (~139 ms on the OSS shim) and a skipped service
+         * is an audible gap.  ⚠️ audio_pump_active() is still in the pacing
+         * decision, as the slot's return value: it is unconditionally true
+         * while the continuous stream is live.  The wait is to an absolute
+         * deadline, so this frame's work is inside FRAME_DELAY_ACTIVE_US rather
+         * than added to it (common/frame_sched.h). */
+        frame_sched_end(&sched);
     }
     
     gamepad_close(&gamepad);
@@ -19,7 +19,9 @@
 #include "../common/hardware.h"
 #include "../common/highscore.h"
 #include "../common/audio.h"
+#include "../common/frame_sched.h"
 #include "../common/gamepad.h"
+#include "../common/input_hub.h"
 
 /* ========================================================================== */
 /* CONSTANTS                                                                  */
@@ -155,6 +157,8 @@ static TouchInput touch;
 static Audio audio;
 static GamepadManager gamepad;
 static InputState input;
+static InputHub hub;            /* ends an idle frame's wait on input */
+static uint32_t hub_devices;    /* gamepad.devices_changed the hub was built from */
 static SameGameState game;
 static LEDEffect led_effect;
 static bool running = true;
@@ -162,9 +166,6 @@ static GameScreen current_screen = SCREEN_WELCOME;
 static HighScoreTable hs_table;
 static GameOverScreen gos;
 
-/* Gamepad rescan timer */
-static uint32_t last_rescan_ms = 0;
-#define RESCAN_INTERVAL_MS 5000
 
 /* UI Buttons */
 static Button menu_button;
@@ -172,6 +173,25 @@ static Button exit_button;
 static Button start_button;
 static ModalDialog pause_dialog;
 
+/* The playing screen under the HUD and the blocks — black, the grid border
+ * and the grid background — painted once into an offscreen layer, so that
+ * draw_field_changes() can put back what was under anything it redraws.
+ * Without the layer every frame is a full one. */
+static FbLayer board_bg;
+static bool board_bg_ok = false;
+
+/* What the last steady playing frame left on the panel, so the next one can
+ * redraw only what differs (draw_field_changes()).  field_drawn is cleared by
+ * every frame that is not steady — see field_is_steady().  A cell's key is its
+ * grid value, plus DRAWN_HL while it is drawn highlighted. */
+#define DRAWN_HL 8
+static bool field_drawn = false;
+static int drawn_cell[MAX_COLS][MAX_ROWS];
+static int drawn_score, drawn_remaining, drawn_hl_count;
+static ButtonVisualState drawn_menu_state, drawn_exit_state;
+static bool drawn_flash;
+static int drawn_flash_col, drawn_flash_row;
+
 /* Color lookup tables */
 static const uint32_t block_colors[NUM_COLORS] = {
     BLOCK_COLOR_RED, BLOCK_COLOR_BLUE, BLOCK_COLOR_GREEN,
@@ -990,11 +1010,45 @@ static void draw_hud(void) {
     text_draw_centered(&fb, fb.width / 2, SCREEN_SAFE_TOP + 45, remain_text, COLOR_YELLOW, 2);
 }
 
-static void draw_grid_border(void) {
+static void draw_grid_border(Surface *s) {
     int bw = game.cols * game.block_size;
     int bh = game.rows * game.block_size;
-    fb_draw_rect(&fb, game.grid_x - 2, game.grid_y - 2, bw + 4, bh + 4, RGB(60, 60, 60));
-    fb_draw_rect(&fb, game.grid_x - 1, game.grid_y - 1, bw + 2, bh + 2, RGB(100, 100, 100));
+    fb_draw_rect(s, game.grid_x - 2, game.grid_y - 2, bw + 4, bh + 4, RGB(60, 60, 60));
+    fb_draw_rect(s, game.grid_x - 1, game.grid_y - 1, bw + 2, bh + 2, RGB(100, 100, 100));
+}
+
+/* The static part of the playing screen, onto s: the board_bg layer, or fb
+ * itself in draw_playing_field(). */
+static void paint_board(Surface *s, void *user) {
+    /* Draw grid border */
+    draw_grid_border(s);
+
+    /* Draw grid background */
+    fb_fill_rect(s, game.grid_x, game.grid_y,
+                 game.cols * game.block_size, game.rows * game.block_size,
+                 RGB(20, 20, 30));
+}
+
+/* The group size shown under the grid: 0 when there is no line */
+static int shown_hl_count(void) {
+    return (game.highlight_active && game.highlight_count >= 2) ? game.highlight_count : 0;
+}
+
+static int hl_text_y(void) {
+    /* At the bottom of the grid area */
+    int text_y = game.grid_y + game.rows * game.block_size + 8;
+    if (text_y + 16 > (int)fb.height) text_y = (int)fb.height - 16;
+    return text_y;
+}
+
+/* Highlight count indicator (show how many blocks selected) */
+static void draw_highlight_count(void) {
+    if (!shown_hl_count()) return;
+    char hl_text[48];
+    int points = (game.highlight_count - 1) * (game.highlight_count - 1);
+    snprintf(hl_text, sizeof(hl_text), "%d BLOCKS (+%d PTS)",
+             game.highlight_count, points);
+    text_draw_centered(&fb, fb.width / 2, hl_text_y(), hl_text, COLOR_CYAN, 1);
 }
 
 static void draw_playing_field(void) {
@@ -1004,13 +1058,7 @@ static void draw_playing_field(void) {
     /* Draw HUD */
     draw_hud();
 
-    /* Draw grid border */
-    draw_grid_border();
-
-    /* Draw grid background */
-    fb_fill_rect(&fb, game.grid_x, game.grid_y,
-                 game.cols * game.block_size, game.rows * game.block_size,
-                 RGB(20, 20, 30));
+    paint_board(&fb, NULL);
 
     /* Calculate animation progress */
     float anim_progress = 0.0f;
@@ -1206,17 +1254,7 @@ static void draw_playing_field(void) {
         }
     }
 
-    /* Highlight count indicator (show how many blocks selected) */
-    if (game.highlight_active && game.highlight_count >= 2) {
-        char hl_text[48];
-        int points = (game.highlight_count - 1) * (game.highlight_count - 1);
-        snprintf(hl_text, sizeof(hl_text), "%d BLOCKS (+%d PTS)",
-                 game.highlight_count, points);
-        /* Draw at bottom of grid area */
-        int text_y = game.grid_y + game.rows * game.block_size + 8;
-        if (text_y + 16 > (int)fb.height) text_y = (int)fb.height - 16;
-        text_draw_centered(&fb, fb.width / 2, text_y, hl_text, COLOR_CYAN, 1);
-    }
+    draw_highlight_count();
 
     /* Mouse hover highlight — subtle indicator of cell under cursor */
     if (input.mouse_connected && game.anim_state == ANIM_NONE) {
@@ -1275,7 +1313,132 @@ static void draw_mouse_hover(int mx, int my) {
                  RGB(200, 200, 200));
 }
 
+/* A frame whose every pixel is a function of the grid, the highlight, the
+ * flash and the HUD numbers — which draw_field_changes() can then redraw cell
+ * by cell.  Not while blocks are moving (the removal fade and the fall and
+ * slide animations draw between cells), not under the shake's draw offset or
+ * the PERFECT CLEAR text, and not with a mouse: its crosshair lands anywhere,
+ * on top of all of it, and a whole frame is the simple way to take it off. */
+static bool field_is_steady(void) {
+    return board_bg_ok && current_screen == SCREEN_PLAYING &&
+           game.anim_state == ANIM_NONE && !game.shake_active &&
+           !game.perfect_clear && !input.mouse_connected;
+}
+
+static int cell_key(int c, int r) {
+    bool hl = game.highlight_active && game.highlight_map[c][r];
+    return game.grid[c][r] | (hl ? DRAWN_HL : 0);
+}
+
+static void remember_field(void) {
+    for (int c = 0; c < game.cols; c++)
+        for (int r = 0; r < game.rows; r++)
+            drawn_cell[c][r] = cell_key(c, r);
+    drawn_score      = game.score;
+    drawn_remaining  = game.blocks_remaining;
+    drawn_hl_count   = shown_hl_count();
+    drawn_menu_state = menu_button.visual_state;
+    drawn_exit_state = exit_button.visual_state;
+    drawn_flash      = game.flash_active;
+    drawn_flash_col  = game.flash_col;
+    drawn_flash_row  = game.flash_row;
+    field_drawn      = true;
+}
+
+static void restore_board(int x, int y, int w, int h) {
+    fb_blit_surface(&fb, fb_layer_surface(&board_bg), x, y, x, y, w, h);
+}
+
+/* One cell over what was under it, flash included — the flash is a blend, so
+ * it is only ever drawn over a freshly drawn block. */
+static void redraw_cell(int c, int r, uint32_t now) {
+    int bs = game.block_size;
+    int px = game.grid_x + c * bs;
+    int py = game.grid_y + r * bs;
+    restore_board(px, py, bs, bs);
+    draw_block(c, r, game.highlight_active && game.highlight_map[c][r], 1.0f);
+    if (game.flash_active && c == game.flash_col && r == game.flash_row) {
+        uint32_t flash_elapsed = now - game.flash_start;
+        uint8_t flash_alpha = (uint8_t)(180 * (1.0f - (float)flash_elapsed / 200.0f));
+        fb_fill_rect_alpha(&fb, px, py, bs, bs, COLOR_RED, flash_alpha);
+    }
+}
+
+/* A steady frame over the previous steady frame.  With damage tracking on
+ * (main()), fb_swap() then copies only what this touched — the group a tap
+ * highlighted, the flash on one block — instead of the 1.5 MB screen that
+ * fb_clear() plus draw_playing_field() rewrites. */
+static void draw_field_changes(void) {
+    uint32_t now = get_time_ms();
+    if (game.flash_active && now - game.flash_start >= 200)
+        game.flash_active = false;
+
+    /* The group-size line: on a panel with no room under the grid it is drawn
+     * over the bottom row of blocks, so it is redrawn with any cell it
+     * crosses, and they with it. */
+    int band_y = hl_text_y();
+    int band_h = text_measure_height(1);
+    bool band_dirty = shown_hl_count() != drawn_hl_count;
+
+    static bool dirty[MAX_COLS][MAX_ROWS];
+    for (int c = 0; c < game.cols; c++) {
+        for (int r = 0; r < game.rows; r++) {
+            /* Highlighted blocks pulse, so they are redrawn every frame */
+            dirty[c][r] = cell_key(c, r) != drawn_cell[c][r] ||
+                          (cell_key(c, r) & DRAWN_HL);
+        }
+    }
+    if (drawn_flash) dirty[drawn_flash_col][drawn_flash_row] = true;
+    if (game.flash_active) dirty[game.flash_col][game.flash_row] = true;
+
+    int bs = game.block_size;
+    int band_r0 = (band_y - game.grid_y) / bs;
+    int band_r1 = (band_y + band_h - 1 - game.grid_y) / bs;
+    if (band_r0 < 0) band_r0 = 0;
+    if (band_r1 >= game.rows) band_r1 = game.rows - 1;
+    for (int c = 0; c < game.cols && !band_dirty; c++)
+        for (int r = band_r0; r <= band_r1; r++)
+            if (dirty[c][r]) band_dirty = true;
+    if (band_dirty) {
+        restore_board(0, band_y, fb.width, band_h);
+        for (int c = 0; c < game.cols; c++)
+            for (int r = band_r0; r <= band_r1; r++)
+                dirty[c][r] = true;
+    }
+
+    for (int c = 0; c < game.cols; c++)
+        for (int r = 0; r < game.rows; r++)
+            if (dirty[c][r]) redraw_cell(c, r, now);
+    if (band_dirty)
+        draw_highlight_count();
+
+    /* The HUD's two lines sit between the buttons, above the grid border;
+     * draw_hud() redraws the buttons as well.  ⚠️ The lines are CENTRED on
+     * SCREEN_SAFE_TOP + 20 and + 45 (text_draw_centered()), so the score's top
+     * half is above + 20 — a rectangle starting there left it for the new
+     * score to be drawn over. */
+    if (game.score != drawn_score || game.blocks_remaining != drawn_remaining ||
+        menu_button.visual_state != drawn_menu_state ||
+        exit_button.visual_state != drawn_exit_state) {
+        int th = text_measure_height(2);
+        restore_board(0, SCREEN_SAFE_TOP + 20 - th / 2, fb.width, 25 + th);
+        draw_hud();
+    }
+    remember_field();
+}
+
 static void draw_game(void) {
+    /* Update screen shake before drawing (before the choice, too: the frame
+     * the shake ends is a full one, to erase the last offset frame) */
+    if (current_screen != SCREEN_WELCOME)
+        update_shake();
+
+    if (field_is_steady() && field_drawn) {
+        draw_field_changes();
+        return;
+    }
+    field_drawn = false;
+
     fb_clear(&fb, COLOR_BLACK);
 
     if (current_screen == SCREEN_WELCOME) {
@@ -1288,11 +1451,10 @@ static void draw_game(void) {
         return;
     }
 
-    /* Update screen shake before drawing */
-    update_shake();
-
     /* Draw the playing field as background for all playing states */
     draw_playing_field();
+    if (field_is_steady())
+        remember_field();
 
     if (current_screen == SCREEN_PAUSED) {
         fb_clear_draw_offset(&fb);
@@ -1398,10 +1560,10 @@ static void handle_input(void) {
     /* Poll gamepad/keyboard/mouse through unified API */
     gamepad_poll(&gamepad, &input, state.x, state.y, state.pressed);
 
-    /* Periodic device rescan for hotplug support */
-    if (now - last_rescan_ms > RESCAN_INTERVAL_MS) {
-        last_rescan_ms = now;
-        gamepad_rescan(&gamepad);
+    /* A pad plugged in or pulled out has new fds; rebuild the hub's set. */
+    if (gamepad.devices_changed != hub_devices) {
+        input_hub_track(&hub, touch.fd, &gamepad);
+        hub_devices = gamepad.devices_changed;
     }
 
     /* BTN_BACK always exits to launcher */
@@ -1604,6 +1766,11 @@ int main(int argc, char *argv[]) {
      * rather than muting, so there is nothing for a game to do about it, and
      * audio_close() reports which path actually ran. */
     audio_cont_enable(&audio, true);
+    /* Opt-in (`audio_server` in the config): the bus in a forked process of its
+     * own, so the name-entry screen and the touch drains, which do not pump,
+     * stop starving the stream.  Unchecked for the same reason as the line
+     * above — a refusal leaves the in-loop path exactly as it was. */
+    if (audio_server_enabled(&audio)) audio_server_start(&audio);
 
     /* Framebuffer init */
     /* Pin 32bpp — /dev/fb0 keeps whatever ran last (see fb_set_bpp). */
@@ -1621,6 +1788,7 @@ int main(int argc, char *argv[]) {
         return 1;
     }
     touch_set_screen_size(&touch, fb.width, fb.height);
+    fb_set_damage_tracking(&fb, true);   /* see draw_field_changes() */
 
     /* Gamepad/keyboard/mouse init */
     gamepad_init(&gamepad);
@@ -1631,14 +1799,33 @@ int main(int argc, char *argv[]) {
 
     /* Initialize game */
     init_game();
+    board_bg_ok = fb_layer_init(&board_bg, &fb, (int)fb.width, (int)fb.height,
+                                paint_board, NULL) == 0;
 
     printf("SameGame started! Touch screen or use mouse to play.\n");
     printf("Grid: %d x %d, block size: %d\n", game.cols, game.rows, game.block_size);
 
+    FrameSched sched;
+    frame_sched_init(&sched, FRAME_DELAY_ACTIVE_US, FRAME_DELAY_IDLE_US);
+    frame_sched_set_audio(&sched, audio_pump_slot, &audio,
+                          audio_cont_service_interval_us(&audio) / 2);
+    frame_sched_set_report(&sched, 60000, frame_stats_print, "samegame: frames");
+
+    /* Nothing moves on a SameGame board while the player thinks, so most of its
+     * frames are idle ones once the audio server owns the stream, each up to
+     * 100 ms asleep before the tap is read.  The hub cuts that sleep short on
+     * touch or pad input (common/input_hub.h); without epoll it stays a sleep. */
+    if (input_hub_init(&hub) != 0)
+        fprintf(stderr, "samegame: epoll unavailable, idle frames sleep their full period\n");
+    input_hub_track(&hub, touch.fd, &gamepad);
+    hub_devices = gamepad.devices_changed;
+    frame_sched_set_wait(&sched, input_hub_wait, &hub);
+
     /* Main game loop */
     bool needs_redraw = true;  /* first frame always draws */
 
     while (running) {
+        frame_sched_begin(&sched);
         /* Save visual state before input handling */
         GameScreen prev_screen     = current_screen;
         bool       prev_highlight  = game.highlight_active;
@@ -1683,35 +1870,37 @@ int main(int argc, char *argv[]) {
         if (current_screen == SCREEN_GAME_OVER && gameover_needs_redraw(&gos))
             needs_redraw = true;
 
-        bool drew = needs_redraw;       /* capture BEFORE the if clears it */
-        if (needs_redraw) {
+        if (needs_redraw && frame_sched_render_due(&sched)) {
             draw_game();
             fb_swap(&fb);
             needs_redraw = false;
         }
 
-        /* Adaptive sleep: full rate while frames are actually being drawn.
-         * Testing needs_redraw here instead of drew always picked IDLE, which
-         * pinned the whole game to 10 FPS.
-         * Service the stream on EVERY iteration, drawing or not — it holds one
-         * lead (~139 ms on the OSS shim) and a skipped service is an audible
-         * gap.  ⚠️ audio_pump_active() belongs in the pacing decision: it is
-         * unconditionally true while the continuous stream is live, and
-         * FRAME_DELAY_IDLE_US (100 ms) is well above the ~55 ms service ceiling
-         * the library measures for itself (../common/audio_out.h). */
-        audio_pump(&audio);
-        usleep((drew || audio_pump_active(&audio))
-               ? FRAME_DELAY_ACTIVE_US : FRAME_DELAY_IDLE_US);
+        /* Full rate while there is something to draw: frame_sched counts a
+         * frame active when it asked frame_sched_render_due(), drawn or
+         * skipped — the old `drew` flag, which had to be captured before the
+         * draw cleared needs_redraw or the game pinned itself to 10 FPS.
+         * frame_sched_end() runs the audio slot (audio_pump_slot) on EVERY
+         * iteration, drawing or not, and again in slices through the wait — the
+         * stream holds one lead (~139 ms on the OSS shim) and a skipped service
+         * is an audible gap.  ⚠️ audio_pump_active() is still in the pacing
+         * decision, as the slot's return value: it is unconditionally true
+         * while the continuous stream is live.  The wait is to an absolute
+         * deadline, so this frame's work is inside FRAME_DELAY_ACTIVE_US rather
+         * than added to it (common/frame_sched.h). */
+        frame_sched_end(&sched);
     }
 
     /* Cleanup (reverse order) */
     hw_leds_off();
     hw_set_backlight(100);
     audio_close(&audio);
+    input_hub_close(&hub);
     gamepad_close(&gamepad);
     touch_close(&touch);
     fb_clear(&fb, COLOR_BLACK);
     fb_swap(&fb);
+    fb_layer_free(&board_bg);
     fb_close(&fb);
 
     printf("SameGame ended. Final score: %d\n", game.score);
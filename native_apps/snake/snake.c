@@ -19,6 +19,7 @@
 #include "../common/hardware.h"
 #include "../common/highscore.h"
 #include "../common/audio.h"
+#include "../common/frame_sched.h"
 #include "../common/gamepad.h"
 
 #define GRID_SIZE 20
@@ -89,8 +90,6 @@ GameScreen current_screen = SCREEN_WELCOME;
 HighScoreTable hs_table;
 static GameOverScreen gos;
 Audio audio;
-static uint32_t last_rescan_ms = 0;
-#define RESCAN_INTERVAL_MS 5000
 
 // UI Buttons
 Button menu_button;
@@ -355,12 +354,6 @@ void handle_input() {
     // Poll gamepad/keyboard/touch through unified API
     gamepad_poll(&gamepad, &input, state.x, state.y, state.pressed);
 
-    // Periodic device rescan for hotplug support
-    if (current_time - last_rescan_ms > RESCAN_INTERVAL_MS) {
-        last_rescan_ms = current_time;
-        gamepad_rescan(&gamepad);
-    }
-
     // BTN_BACK always exits to launcher
     if (input.buttons[BTN_ID_BACK].pressed) {
         fb_fade_out(&fb);
@@ -624,6 +617,11 @@ int main(int argc, char *argv[]) {
      * rather than muting, so there is nothing for a game to do about it, and
      * audio_close() reports which path actually ran. */
     audio_cont_enable(&audio, true);
+    /* Opt-in (`audio_server` in the config): the bus in a forked process of its
+     * own, so the name-entry screen and the touch drains, which do not pump,
+     * stop starving the stream.  Unchecked for the same reason as the line
+     * above — a refusal leaves the in-loop path exactly as it was. */
+    if (audio_server_enabled(&audio)) audio_server_start(&audio);
     
     // Initialize framebuffer
     /* Pin 32bpp — /dev/fb0 keeps whatever ran last (see fb_set_bpp). */
@@ -656,9 +654,16 @@ int main(int argc, char *argv[]) {
     // Gamepad init
     gamepad_init(&gamepad);
 
+    FrameSched sched;
+    frame_sched_init(&sched, FRAME_DELAY_ACTIVE_US, FRAME_DELAY_IDLE_US);
+    frame_sched_set_audio(&sched, audio_pump_slot, &audio,
+                          audio_cont_service_interval_us(&audio) / 2);
+    frame_sched_set_report(&sched, 60000, frame_stats_print, "snake: frames");
+
     // Game loop
     bool needs_redraw = true;
     while (running) {
+        frame_sched_begin(&sched);
         GameScreen prev_screen = current_screen;
         handle_input();
         if (current_screen == SCREEN_PLAYING)
@@ -686,48 +691,31 @@ int main(int argc, char *argv[]) {
         if (current_screen == SCREEN_GAME_OVER && gameover_needs_redraw(&gos))
             needs_redraw = true;
 
-        if (needs_redraw) {
+        if (needs_redraw && frame_sched_render_due(&sched)) {
             draw_game();
             fb_swap(&fb);
+            needs_redraw = false;
         }
-        /* Service the stream on EVERY iteration, drawing or not — it holds one
-         * lead (~139 ms on the OSS shim) and a skipped service is an audible
-         * gap.  ⚠️ audio_pump_active() belongs in the pacing decision: it is
-         * unconditionally true while the continuous stream is live, and
-         * FRAME_DELAY_IDLE_US (100 ms) is well above the ~55 ms service ceiling
-         * the library measures for itself (../common/audio_out.h). */
-        audio_pump(&audio);
-
-        /* Adaptive sleep: game.speed during play, idle polling on static screens.
+        /* Pacing: game.speed during play, the usual two rates on static screens.
          *
-         * ⚠️ Snake is the one game whose play sleep IS its step interval — the
+         * ⚠️ Snake is the one game whose play period IS its step interval — the
          * snake advances once per iteration, so game.speed (INITIAL_SPEED
          * 150 ms falling to 50) cannot be shortened to service the stream
-         * without making the snake faster.  It starves BEFORE it speeds up
-         * rather than after: 150 ms is ~3x the ~55 ms service ceiling, so a
-         * single usleep() here would run the device dry twice per step at
-         * level 1 and stop doing so as the game got harder.  So the wait is
-         * BROKEN INTO service-sized pieces instead of shortened — same step
-         * interval, stream fed throughout.  audio_cont_service_interval_us()
-         * is 0 when there is no continuous stream (audio disabled, or the
-         * handover failed), and then this is one usleep() exactly as before.
-         * ⚠️ HALF the published interval, not all of it: that figure is a
-         * CEILING (it already carries half a period of margin — see
-         * ../common/audio_out.h), so sleeping the whole of it and then pumping
-         * puts the service at its edge.  Half lands snake at ~27 ms, the same
-         * neighbourhood as the other six games' FRAME_DELAY_ACTIVE_US. */
-        long wait_us = (current_screen == SCREEN_PLAYING)
-                     ? (long)game.speed
-                     : ((needs_redraw || audio_pump_active(&audio))
-                        ? FRAME_DELAY_ACTIVE_US : FRAME_DELAY_IDLE_US);
-        long slice_us = audio_cont_service_interval_us(&audio) / 2;
-        while (slice_us > 0 && wait_us > slice_us) {
-            usleep((useconds_t)slice_us);
-            wait_us -= slice_us;
-            audio_pump(&audio);
-        }
-        usleep((useconds_t)wait_us);
-        needs_redraw = false;
+         * without making the snake faster.  150 ms is ~3x the ~55 ms service
+         * ceiling, so the wait is BROKEN INTO service-sized pieces instead of
+         * shortened — which is what the scheduler's audio slot does for every
+         * game now: audio_pump_slot runs once at frame_sched_end() and again
+         * every half service interval through the wait (0 when there is no
+         * continuous stream, and then the wait is one sleep).  ⚠️ HALF the
+         * published interval, not all of it: that figure is a CEILING (it
+         * already carries half a period of margin — see ../common/audio_out.h).
+         * The deadline is absolute, so the step interval no longer grows by the
+         * frame's own work and the snake keeps time as it gets faster. */
+        if (current_screen == SCREEN_PLAYING)
+            frame_sched_set_rate(&sched, game.speed, game.speed);
+        else
+            frame_sched_set_rate(&sched, FRAME_DELAY_ACTIVE_US, FRAME_DELAY_IDLE_US);
+        frame_sched_end(&sched);
     }
     
     // Cleanup
@@ -22,8 +22,9 @@
  * seen passing is not evidence (../../CLAUDE.md → *Working style*).
  *
  * Output is **mono / 44100 / 16-bit**, which is the mix bus's internal format,
- * so nothing at runtime resamples or downmixes — and there is no resampler:
- * audio_music_start() and audio_sfx_play() REFUSE a rate mismatch loudly.
+ * so nothing at runtime resamples or downmixes.  Another rate would play — a
+ * clip is converted once at load, a bed as it streams — but at the cost of a
+ * 32-tap filter that a file written at 44100 never pays.
  * Verify a written file with `od -t x1 -N 48 <file>`: channels 0x0001 at byte
  * 22, rate 0x0000ac44 at 24, bits 0x0010 at 34.
  *
@@ -0,0 +1,163 @@
+/*
+ * wav2adpcm — convert a WAV to mono 4-bit IMA-ADPCM, the compressed format
+ * ../common/audio_wav.c plays.  HOST ONLY: no device, no cross-compiler.
+ *
+ * ⚠️ **This buys SIZE, and it is paid for in the top of the spectrum.**  4:1 is
+ * what the device gets — a bed streams a quarter of the bytes off the SD, and a
+ * clip holds a quarter of the RAM in the bank — and IMA's step adapts slower
+ * than a sharp transient, so the first few milliseconds of a click soften and
+ * broadband noise gains a hiss floor.  That is inaudible on most of our material
+ * through this speaker and not on all of it, and a byte-level check cannot tell
+ * which.  So converting a shipped file is an operator's ear-checked decision per
+ * file, never a build step: this tool exists so that decision is one command.
+ *
+ * It reads through audio_wav.c — the same chunk walk and the same (L+R)>>1
+ * downmix the device uses — so whatever the device would have played as PCM is
+ * exactly what gets encoded, and a file the device would refuse is refused here.
+ * The rate is carried, never changed: converting is the device's job at load.
+ *
+ * Output: `fmt ` 0x0011 with the 2-byte extension (wSamplesPerBlock), a `fact`
+ * chunk holding the true frame count, then `data` in 512-byte blocks — 1017
+ * frames, 23 ms at 44100, which is also what a rewind or a clip retrigger costs
+ * to decode.  ffprobe reports the result as `adpcm_ima_wav` / `s16p`, which is
+ * what ../check-sound-assets.sh accepts.
+ *
+ *   gcc -O2 -Wall -Wextra -I native_apps -o /tmp/wav2adpcm \
+ *       native_apps/sounds/wav2adpcm.c native_apps/common/audio_wav.c -lm
+ *   /tmp/wav2adpcm in.wav out.wav
+ *
+ *   # a whole set, into a staging directory for the listen — never in place:
+ *   mkdir -p /tmp/adpcm
+ *   for f in native_apps/sounds/fx_*.wav native_apps/music/[a-z]*.wav; do
+ *       /tmp/wav2adpcm "$f" "/tmp/adpcm/$(basename "$f")"
+ *   done
+ *
+ * It prints the round-trip error against its own input, so a file that encodes
+ * badly is visible before anyone listens.  ⚠️ Never run it on an ADPCM input:
+ * it would decode and re-encode, compounding the error for no saving.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common/audio_wav.h"
+
+/* Bytes per block.  Small enough that a retrigger decodes 23 ms, large enough
+ * that the 4-byte header is under 1% of the file. */
+#define W2A_BLOCK_ALIGN 512
+
+static void put_le32(FILE *f, uint32_t v)
+{
+    unsigned char b[4] = { (unsigned char)v, (unsigned char)(v >> 8),
+                           (unsigned char)(v >> 16), (unsigned char)(v >> 24) };
+    fwrite(b, 1, 4, f);
+}
+
+static void put_le16(FILE *f, uint16_t v)
+{
+    unsigned char b[2] = { (unsigned char)v, (unsigned char)(v >> 8) };
+    fwrite(b, 1, 2, f);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3) {
+        fprintf(stderr, "usage: wav2adpcm <in.wav> <out.wav>\n");
+        return 2;
+    }
+
+    AudioWav w;
+    if (!audio_wav_open(&w, argv[1], false)) return 1;
+    if (w.format == AUDIO_WAV_IMA_ADPCM) {
+        fprintf(stderr, "wav2adpcm: %s is already IMA-ADPCM — refusing to "
+                        "re-encode it\n", argv[1]);
+        audio_wav_close(&w);
+        return 1;
+    }
+
+    int16_t *pcm = (int16_t *)malloc((size_t)w.frames * sizeof(int16_t));
+    if (!pcm) { fprintf(stderr, "wav2adpcm: out of memory\n"); audio_wav_close(&w); return 1; }
+    long frames = 0;
+    while (frames < w.frames) {
+        long n = audio_wav_read(&w, pcm + frames, w.frames - frames);
+        if (n <= 0) break;
+        frames += n;
+    }
+    int rate = w.rate;
+    audio_wav_close(&w);
+
+    long spb    = AUDIO_WAV_ADPCM_BLOCK_FRAMES(W2A_BLOCK_ALIGN, 1);
+    long blocks = (frames + spb - 1) / spb;
+    uint8_t *data = (uint8_t *)malloc((size_t)blocks * W2A_BLOCK_ALIGN);
+    if (!data) { fprintf(stderr, "wav2adpcm: out of memory\n"); free(pcm); return 1; }
+
+    long bytes = 0;
+    int  index = 0;
+    for (long at = 0; at < frames; at += spb)
+        bytes += audio_adpcm_encode_block(pcm + at, frames - at, &index,
+                                          data + bytes, W2A_BLOCK_ALIGN);
+
+    FILE *f = fopen(argv[2], "wb");
+    if (!f) { fprintf(stderr, "wav2adpcm: cannot write %s\n", argv[2]); free(pcm); free(data); return 1; }
+
+    long pad = bytes & 1;
+    fwrite("RIFF", 1, 4, f);
+    put_le32(f, (uint32_t)(4 + (8 + 20) + (8 + 4) + (8 + bytes + pad)));
+    fwrite("WAVE", 1, 4, f);
+
+    fwrite("fmt ", 1, 4, f);  put_le32(f, 20);
+    put_le16(f, AUDIO_WAV_IMA_ADPCM);
+    put_le16(f, 1);                                        /* mono            */
+    put_le32(f, (uint32_t)rate);
+    /* nAvgBytesPerSec: informational, and the one place a divide is honest. */
+    put_le32(f, (uint32_t)((long)rate * W2A_BLOCK_ALIGN / spb));
+    put_le16(f, W2A_BLOCK_ALIGN);
+    put_le16(f, 4);                                        /* bits per sample */
+    put_le16(f, 2);                                        /* cbSize          */
+    put_le16(f, (uint16_t)spb);
+
+    fwrite("fact", 1, 4, f);  put_le32(f, 4);
+    put_le32(f, (uint32_t)frames);
+
+    fwrite("data", 1, 4, f);  put_le32(f, (uint32_t)bytes);
+    fwrite(data, 1, (size_t)bytes, f);
+    if (pad) fputc(0, f);
+    fclose(f);
+
+    /* The round trip, through the device's own reader. */
+    long worst = 0;
+    double sq = 0.0;
+    long checked = 0;
+    if (audio_wav_open(&w, argv[2], false)) {
+        static int16_t back[4096];
+        long at = 0;
+        for (;;) {
+            long n = audio_wav_read(&w, back, 4096);
+            if (n <= 0) break;
+            for (long i = 0; i < n && at + i < frames; i++) {
+                long e = labs((long)back[i] - (long)pcm[at + i]);
+                if (e > worst) worst = e;
+                sq += (double)e * (double)e;
+            }
+            at += n;
+        }
+        checked = at;
+        audio_wav_close(&w);
+    }
+    if (checked != frames) {
+        fprintf(stderr, "wav2adpcm: %s reads back %ld frames, wrote %ld\n",
+                argv[2], checked, frames);
+        free(pcm); free(data);
+        return 1;
+    }
+
+    printf("%s: %ld frames, %ld → %ld bytes (%.2f:1), worst error %ld, rms %.1f\n",
+           argv[2], frames, frames * 2, bytes, bytes ? (double)frames * 2 / (double)bytes : 0.0,
+           worst, frames ? sqrt(sq / (double)frames) : 0.0);
+    free(pcm);
+    free(data);
+    return 0;
+}
@@ -0,0 +1,77 @@
+/*
+ * tests/alsashim/tinyalsa/asoundlib.h — the part of tinyalsa 2.0.0 that
+ * `common/audio_out.c`'s ALSA backend calls, declared and NOT implemented.
+ *
+ * Unlike `tests/hostshim/`, this is a mock, not a redirect: the host has no
+ * tinyalsa, and the device-free stand-in upstream ALSA would offer — the `null`
+ * and `file` plugins — is alsa-lib's, which this repo deliberately does not link
+ * (../../../IMPROVEMENT_PLAN.md F1).  So `tests/audio_alsa_test.c` implements
+ * every function below as a simulated `hw:0,0`: a real mmap ring with an
+ * `appl_ptr`, a `hw_ptr` the test advances, and the XRUN state an empty ring
+ * falls into.
+ *
+ * Put this directory on the include path (`-Itests/alsashim`) and audio_out.c's
+ * `__has_include(<tinyalsa/asoundlib.h>)` compiles the backend in.  ⚠️ ONLY for
+ * that test: any other binary that sees it links against symbols nobody defines.
+ *
+ * The names, signatures and flag values are upstream's (include/tinyalsa/pcm.h
+ * at 2.0.0); the struct has the fields upstream's has, and audio_out.c sets them
+ * by name after a memset, so field order is not load-bearing.
+ */
+#ifndef ROOMWIZARD_ALSASHIM_TINYALSA_ASOUNDLIB_H
+#define ROOMWIZARD_ALSASHIM_TINYALSA_ASOUNDLIB_H
+
+#define PCM_OUT       0x00000000
+#define PCM_IN        0x10000000
+#define PCM_MMAP      0x00000001
+#define PCM_NOIRQ     0x00000002
+#define PCM_NONBLOCK  0x00000010
+
+enum pcm_format {
+    PCM_FORMAT_INVALID = -1,
+    PCM_FORMAT_S16_LE  = 0,
+    PCM_FORMAT_S32_LE,
+    PCM_FORMAT_S8,
+    PCM_FORMAT_S24_LE,
+    PCM_FORMAT_S24_3LE,
+    PCM_FORMAT_MAX
+};
+
+struct pcm_config {
+    unsigned int channels;
+    unsigned int rate;
+    unsigned int period_size;
+    unsigned int period_count;
+    enum pcm_format format;
+    unsigned int start_threshold;
+    unsigned int stop_threshold;
+    unsigned int silence_threshold;
+    unsigned int silence_size;
+    unsigned int avail_min;
+};
+
+struct pcm;
+
+struct pcm *pcm_open(unsigned int card, unsigned int device, unsigned int flags,
+                     const struct pcm_config *config);
+int pcm_close(struct pcm *pcm);
+int pcm_is_ready(const struct pcm *pcm);
+const char *pcm_get_error(const struct pcm *pcm);
+int pcm_get_file_descriptor(const struct pcm *pcm);
+
+const struct pcm_config *pcm_get_config(const struct pcm *pcm);
+unsigned int pcm_get_rate(const struct pcm *pcm);
+unsigned int pcm_get_channels(const struct pcm *pcm);
+enum pcm_format pcm_get_format(const struct pcm *pcm);
+unsigned int pcm_get_buffer_size(const struct pcm *pcm);
+unsigned int pcm_frames_to_bytes(const struct pcm *pcm, unsigned int frames);
+unsigned int pcm_format_to_bits(enum pcm_format format);
+
+int pcm_prepare(struct pcm *pcm);
+int pcm_start(struct pcm *pcm);
+int pcm_mmap_avail(struct pcm *pcm);
+int pcm_mmap_begin(struct pcm *pcm, void **areas, unsigned int *offset,
+                   unsigned int *frames);
+int pcm_mmap_commit(struct pcm *pcm, unsigned int offset, unsigned int frames);
+
+#endif
@@ -0,0 +1,453 @@
+/*
+ * audio_alsa_test.c — `common/audio_out.c`'s ALSA backend, on the host, against
+ * a simulated `hw:0,0`.
+ *
+ * The backend is tinyalsa with `PCM_MMAP`: an explicit period × count ring, the
+ * serviced mode rendering straight into the DMA buffer through
+ * `pcm_mmap_begin()`/`pcm_mmap_commit()`, and an XRUN recovered inside the
+ * backend and reported through the counters the OSS path already has.  None of
+ * that is reachable through `tests/audio_out_test.c`'s fake, which sits ABOVE the
+ * backend; this sits BELOW it.
+ *
+ * ⚠️ **Not ALSA's `null` or `file` plugin.** Those are alsa-lib's, and this repo
+ * links tinyalsa static with no alsa-lib on purpose (../IMPROVEMENT_PLAN.md F1,
+ * operator decisions) — tinyalsa has no plugin layer to put them behind.  So
+ * `tests/alsashim/tinyalsa/asoundlib.h` declares the tinyalsa calls the backend
+ * makes and this file implements them as a device: a real ring the backend maps,
+ * an `appl_ptr` that commits advance, a `hw_ptr` the test advances, and the XRUN
+ * state an empty ring falls into.  What that cannot show is the real driver's
+ * timing, which is what the panel is for.
+ *
+ * Group A is the open: the flags (`PCM_MMAP`, and `PCM_NONBLOCK`, without which
+ * a busy device hangs the fallback), the explicit ring, and the GRANT read back
+ * rather than the request.  Group B is the zero-copy service: the fill is handed
+ * a pointer INSIDE the device's ring, and the audio stays a gapless ramp across
+ * several wraps, where one service is two pieces.  Group C is the XRUN: counted
+ * once as `starved`, re-prepared, refilled to the lead and restarted — and a
+ * refused commit counted as `lost`.  Group D is mode 2 through the same ring.
+ * Group E is the drain and the close.  Group F is the fork parent's release,
+ * which must NOT close the pcm (that DROPs the child's stream).
+ *
+ * Needs no sudo, no device and no network.
+ *
+ * Build (host gcc, from native_apps/):
+ *   gcc -Wall -Wextra -Wno-unused-parameter -I common -Itests/alsashim \
+ *       -o build/audio_alsa_test tests/audio_alsa_test.c common/audio_out.c \
+ *       common/audio_gen.c -lm && ./build/audio_alsa_test
+ *
+ * ⚠️ `-Itests/alsashim` is what compiles the backend in, and it belongs on THIS
+ * line only — see the shim's header.
+ *
+ * NOT part of build-and-deploy.sh: that script cross-compiles for ARM and this
+ * is a host binary.  Run it by hand after touching the ALSA half of
+ * common/audio_out.c.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <tinyalsa/asoundlib.h>
+
+#include "../common/audio_gen.h"
+#include "../common/audio_out.h"
+
+static int failures = 0;
+static int checks   = 0;
+
+static void check(bool cond, const char *what)
+{
+    checks++;
+    if (!cond) { failures++; printf("  FAIL: %s\n", what); }
+    else       { printf("  ok:   %s\n", what); }
+}
+
+/* ── The simulated hw:0,0 ─────────────────────────────────────────────────── */
+
+enum { ST_SETUP, ST_PREPARED, ST_RUNNING, ST_XRUN };
+
+#define LOG_CAP  (1 << 18)
+
+struct pcm {
+    struct pcm_config cfg;       /* the GRANT */
+    unsigned  flags;
+    bool      ready;
+    int       fd;
+    int16_t  *ring;
+    unsigned long hw, appl;      /* monotonic frame counters, like the kernel's */
+    int       state;
+};
+
+/* What the next open grants, and what the test can see of the last one. */
+static struct {
+    bool      refuse;
+    unsigned  rate, channels, period, periods;
+    struct pcm_config asked;
+    unsigned  flags;
+    struct pcm *pcm;
+    int       opens, closes, prepares, starts, bad_starts, bad_offsets;
+    int       fail_commits;      /* the next N commits are refused -EPIPE     */
+    long      drain_per_avail;   /* frames "played" per pcm_mmap_avail()      */
+    int16_t   log[LOG_CAP];      /* left channel of every committed frame     */
+    long      logged;
+} dev;
+
+static void dev_reset(void)
+{
+    memset(&dev, 0, sizeof(dev));
+    dev.rate     = 44100;
+    dev.channels = 2;
+    dev.period   = AUDIO_OUT_ALSA_PERIOD_FRAMES;
+    dev.periods  = AUDIO_OUT_ALSA_PERIODS;
+}
+
+static unsigned ring_of(const struct pcm *p)
+{
+    return p->cfg.period_size * p->cfg.period_count;
+}
+
+/** The DAC: `n` frames leave the ring, and an empty ring is an XRUN — the
+ *  default stop threshold is the ring, which is what the backend relies on. */
+static void dev_play(long n)
+{
+    struct pcm *p = dev.pcm;
+    if (!p || p->state != ST_RUNNING) return;
+    unsigned long q = p->appl - p->hw;
+    if ((unsigned long)n >= q) { p->hw = p->appl; p->state = ST_XRUN; }
+    else                       p->hw += (unsigned long)n;
+}
+
+struct pcm *pcm_open(unsigned int card, unsigned int device, unsigned int flags,
+                     const struct pcm_config *config)
+{
+    struct pcm *p = calloc(1, sizeof(*p));
+    dev.opens++;
+    dev.asked = *config;
+    dev.flags = flags;
+    dev.pcm   = p;
+    p->fd     = -1;
+    if (dev.refuse) return p;    /* upstream returns a not-ready pcm, not NULL */
+
+    p->cfg              = *config;
+    p->cfg.rate         = dev.rate;
+    p->cfg.channels     = dev.channels;
+    p->cfg.period_size  = dev.period;
+    p->cfg.period_count = dev.periods;
+    p->flags            = flags;
+    p->ring  = calloc((size_t)ring_of(p) * p->cfg.channels, sizeof(int16_t));
+    p->fd    = open("/dev/null", O_WRONLY);
+    p->ready = true;
+    p->state = ST_SETUP;
+    return p;
+}
+
+int pcm_close(struct pcm *pcm)
+{
+    dev.closes++;
+    if (pcm == dev.pcm) dev.pcm = NULL;
+    if (pcm->fd >= 0) close(pcm->fd);
+    free(pcm->ring);
+    free(pcm);
+    return 0;
+}
+
+int pcm_is_ready(const struct pcm *pcm)             { return pcm->ready; }
+const char *pcm_get_error(const struct pcm *pcm)    { return pcm->ready ? "" : "Device or resource busy"; }
+int pcm_get_file_descriptor(const struct pcm *pcm)  { return pcm->fd; }
+const struct pcm_config *pcm_get_config(const struct pcm *pcm) { return &pcm->cfg; }
+unsigned int pcm_get_rate(const struct pcm *pcm)     { return pcm->cfg.rate; }
+unsigned int pcm_get_channels(const struct pcm *pcm) { return pcm->cfg.channels; }
+enum pcm_format pcm_get_format(const struct pcm *pcm) { return pcm->cfg.format; }
+unsigned int pcm_get_buffer_size(const struct pcm *pcm) { return ring_of(pcm); }
+
+unsigned int pcm_frames_to_bytes(const struct pcm *pcm, unsigned int frames)
+{
+    return frames * pcm->cfg.channels * 2;
+}
+
+unsigned int pcm_format_to_bits(enum pcm_format format)
+{
+    return format == PCM_FORMAT_S16_LE ? 16 : 32;
+}
+
+int pcm_prepare(struct pcm *pcm)
+{
+    dev.prepares++;
+    pcm->appl  = pcm->hw;        /* the kernel's post-prepare: nothing queued */
+    pcm->state = ST_PREPARED;
+    return 0;
+}
+
+int pcm_start(struct pcm *pcm)
+{
+    if (pcm->state != ST_PREPARED) { dev.bad_starts++; errno = EBADFD; return -1; }
+    dev.starts++;
+    pcm->state = ST_RUNNING;
+    return 0;
+}
+
+int pcm_mmap_avail(struct pcm *pcm)
+{
+    if (dev.drain_per_avail) dev_play(dev.drain_per_avail);
+    return (int)(ring_of(pcm) - (pcm->appl - pcm->hw));
+}
+
+int pcm_mmap_begin(struct pcm *pcm, void **areas, unsigned int *offset,
+                   unsigned int *frames)
+{
+    unsigned ring  = ring_of(pcm);
+    unsigned off   = (unsigned)(pcm->appl % ring);
+    unsigned avail = ring - (unsigned)(pcm->appl - pcm->hw);
+    unsigned n = *frames;
+    if (n > avail)      n = avail;
+    if (n > ring - off) n = ring - off;
+    *areas  = pcm->ring;
+    *offset = off;
+    *frames = n;
+    return 0;
+}
+
+int pcm_mmap_commit(struct pcm *pcm, unsigned int offset, unsigned int frames)
+{
+    if (dev.fail_commits > 0) {
+        dev.fail_commits--;
+        pcm->state = ST_XRUN;
+        return -EPIPE;
+    }
+    unsigned ring = ring_of(pcm);
+    if (offset != pcm->appl % ring) dev.bad_offsets++;
+    for (unsigned i = 0; i < frames && dev.logged < LOG_CAP; i++)
+        dev.log[dev.logged++] = pcm->ring[(size_t)(offset + i) * pcm->cfg.channels];
+    pcm->appl += frames;
+    return (int)frames;
+}
+
+static long queued(void)
+{
+    return dev.pcm ? (long)(dev.pcm->appl - dev.pcm->hw) : -1;
+}
+
+/* ── A fill that proves where it wrote ───────────────────────────────────────
+ *
+ * A ramp, so a dropped or repeated frame anywhere in the stream is visible in the
+ * log, and the address of every buffer it was handed, so "zero-copy" is a check
+ * rather than a claim. */
+
+static struct {
+    int16_t next;
+    int     calls, outside;
+    long    frames;
+} ramp;
+
+static long ramp_fill(void *ctx, int16_t *buf, long frames, int channels)
+{
+    (void)ctx;
+    struct pcm *p = dev.pcm;
+    ramp.calls++;
+    ramp.frames += frames;
+    if (!p || buf < p->ring ||
+        buf + frames * channels > p->ring + (size_t)ring_of(p) * p->cfg.channels)
+        ramp.outside++;
+    for (long i = 0; i < frames; i++) {
+        ramp.next = (int16_t)((ramp.next + 1) & 0x3fff);
+        for (int c = 0; c < channels; c++) buf[i * channels + c] = ramp.next;
+    }
+    return frames;
+}
+
+/** The log from `from` on is one unbroken ramp. */
+static bool log_is_ramp(long from)
+{
+    for (long i = from + 1; i < dev.logged; i++)
+        if (dev.log[i] != (int16_t)((dev.log[i - 1] + 1) & 0x3fff)) return false;
+    return dev.logged > from + 1;
+}
+
+/* ── The groups ───────────────────────────────────────────────────────────── */
+
+static void group_a(void)
+{
+    printf("A  the open: flags, the explicit ring, the grant\n");
+    AudioOut out;
+
+    dev_reset();
+    dev.rate   = 48000;          /* granted something else than asked */
+    dev.period = 940;            /* and rounded the period */
+    check(audio_out_open_alsa(&out, 0, 0, 44100, 2) == 0, "A1  opens");
+    check((dev.flags & PCM_MMAP) && (dev.flags & PCM_NONBLOCK) && !(dev.flags & PCM_IN),
+          "A2  PCM_OUT | PCM_MMAP | PCM_NONBLOCK");
+    check(dev.asked.period_size == AUDIO_OUT_ALSA_PERIOD_FRAMES &&
+          dev.asked.period_count == AUDIO_OUT_ALSA_PERIODS &&
+          dev.asked.format == PCM_FORMAT_S16_LE,
+          "A3  the ring is ASKED for explicitly, S16_LE");
+    check(audio_out_rate(&out) == 48000 && audio_out_period(&out) == 940,
+          "A4  the rate and period used are the GRANT, not the request");
+    check(audio_out_bits(&out) == 16 && audio_out_channels(&out) == 2,
+          "A5  width and channels read back");
+    long lead = audio_pump_lead_frames(audio_frames_for_ms(48000, AUDIO_PUMP_LEAD_MS),
+                                       940, AUDIO_PUMP_LEAD_PERIODS, 940 * 8);
+    check(audio_out_lead(&out) == lead && queued() == lead,
+          "A6  the prefill is one lead, in whole granted periods");
+    check(dev.prepares == 1 && dev.starts == 1 && dev.pcm->state == ST_RUNNING,
+          "A7  prepared once, and the DAC started by the prefill's commit");
+    audio_out_close(&out);
+    check(dev.closes == 1 && !audio_out_is_open(&out), "A8  close closes the pcm");
+
+    dev_reset();
+    dev.refuse = true;
+    check(audio_out_open_alsa(&out, 0, 0, 44100, 2) == -1, "A9  a busy device is refused");
+    check(dev.closes == 1 && !audio_out_is_open(&out),
+          "A10 ...and the not-ready pcm is closed, not leaked");
+    dev.refuse = false;
+    check(audio_out_open_alsa(&out, 0, 0, 44100, 2) == 0,
+          "A11 the refusal did not leave the one-per-process mark behind");
+    audio_out_close(&out);
+}
+
+static void group_b(void)
+{
+    printf("B  the zero-copy service\n");
+    AudioOut out;
+    dev_reset();
+    memset(&ramp, 0, sizeof(ramp));
+    audio_out_open_alsa(&out, 0, 0, 44100, 2);
+    long lead = audio_out_lead(&out);
+    long from = dev.logged;
+    audio_out_set_fill(&out, ramp_fill, NULL, "ramp");
+
+    dev_play(1024);
+    long n = audio_out_service(&out);
+    check(n == 1024 && queued() == lead, "B1  a service tops the queue back up to the lead");
+    check(ramp.calls == 1 && ramp.outside == 0,
+          "B2  the fill was handed the device's own ring — no scratch copy");
+
+    /* Several wraps of an 8192-frame ring at an uneven pace: every one of them
+     * puts a service's span across the end, where it must be two pieces. */
+    int two_piece = 0;
+    for (int i = 0; i < 60; i++) {
+        int before = ramp.calls;
+        dev_play(700 + (i % 5) * 97);
+        audio_out_service(&out);
+        if (ramp.calls - before == 2) two_piece++;
+    }
+    check(two_piece >= 3, "B3  a service across the ring's end is two mapped pieces");
+    check(ramp.outside == 0, "B4  ...both inside the ring");
+    check(log_is_ramp(from) && dev.logged - from == ramp.frames,
+          "B5  and the stream is one gapless ramp, every filled frame committed once");
+    check(dev.bad_offsets == 0, "B6  every commit names the offset its map was given");
+    check(audio_out_starved(&out) == 0 && audio_out_lost(&out) == 0,
+          "B7  no starve, no loss on a stream serviced in time");
+    audio_out_close(&out);
+}
+
+static void group_c(void)
+{
+    printf("C  XRUN recovery, through starved and lost\n");
+    AudioOut out;
+    dev_reset();
+    memset(&ramp, 0, sizeof(ramp));
+    audio_out_open_alsa(&out, 0, 0, 44100, 2);
+    long lead = audio_out_lead(&out);
+    audio_out_set_fill(&out, ramp_fill, NULL, "ramp");
+
+    dev_play(100000);            /* the loop stalled: the ring ran dry */
+    check(dev.pcm->state == ST_XRUN, "C0  (the simulated device underran)");
+    long from = dev.logged;
+    long n = audio_out_service(&out);
+    check(audio_out_starved(&out) == 1, "C1  the XRUN is counted once, as starved");
+    check(dev.prepares == 2 && dev.starts == 2 && dev.pcm->state == ST_RUNNING,
+          "C2  re-prepared and restarted by the same service");
+    check(n == lead && queued() == lead, "C3  ...which refilled the whole lead");
+    check(audio_out_lost(&out) == 0 && dev.bad_starts == 0,
+          "C4  nothing lost, and no start was tried on an unprepared stream");
+    dev_play(1024);
+    audio_out_service(&out);
+    check(audio_out_starved(&out) == 1, "C5  the next service is not a second starve");
+    check(log_is_ramp(from), "C6  and the audio after the recovery is continuous");
+
+    dev_play(1024);
+    dev.fail_commits = 1;
+    uint32_t lost0 = audio_out_lost(&out);
+    n = audio_out_service(&out);
+    check(n == 0 && audio_out_lost(&out) == lost0 + 1024,
+          "C7  a refused commit is counted as lost, frame for frame");
+    check(dev.prepares == 3, "C8  ...and the stream re-prepared");
+    n = audio_out_service(&out);
+    check(n == lead && dev.pcm->state == ST_RUNNING && audio_out_starved(&out) == 2,
+          "C9  the next service finds it empty, counts it, and restarts it");
+    audio_out_close(&out);
+}
+
+static void group_d(void)
+{
+    printf("D  mode 2 through the same ring\n");
+    static int16_t mono[20000];
+    AudioOut out;
+    dev_reset();
+    audio_out_open_alsa(&out, 0, 0, 44100, 2);
+    long from = dev.logged;
+    for (int i = 0; i < 20000; i++) mono[i] = (int16_t)((i + 1) & 0x3fff);
+
+    dev.drain_per_avail = 2048;  /* the DAC keeps playing while mode 2 waits */
+    long n = audio_out_write(&out, mono, 20000);
+    check(n == 20000, "D1  a buffer longer than the ring is written whole");
+    bool same = dev.logged - from == 20000;
+    for (long i = 0; same && i < 20000; i++) same = dev.log[from + i] == mono[i];
+    check(same, "D2  ...and arrives in order, every frame once");
+    check(audio_out_lost(&out) == 0 && audio_out_misaligned(&out) == 0,
+          "D3  nothing lost, nothing misaligned");
+    dev.drain_per_avail = 0;
+    audio_out_close(&out);
+}
+
+static void group_e(void)
+{
+    printf("E  the drain and the close\n");
+    AudioOut out;
+    dev_reset();
+    audio_out_open_alsa(&out, 0, 0, 44100, 2);
+    dev.drain_per_avail = 256;
+    audio_out_close(&out);
+    check(dev.closes == 1 && dev.pcm == NULL, "E1  the pcm is closed");
+    check(audio_out_drain_waits(&out) > 0, "E2  after waiting on the queued lead");
+    check(out.alsa == NULL, "E3  and the backend's ctx is freed");
+}
+
+static void group_f(void)
+{
+    printf("F  the fork parent's release\n");
+    AudioOut out;
+    dev_reset();
+    audio_out_open_alsa(&out, 0, 0, 44100, 2);
+    struct pcm *p = dev.pcm;
+    int fd = p->fd;
+    audio_out_release(&out);
+    check(dev.closes == 0 && p->state == ST_RUNNING,
+          "F1  release does not close the pcm — that would DROP the child's stream");
+    check(fcntl(fd, F_GETFD) == -1 && errno == EBADF, "F2  ...it closes this process's fd");
+    check(!audio_out_is_open(&out) && out.alsa == NULL, "F3  and forgets the stream");
+    check(audio_out_open_alsa(&out, 0, 0, 44100, 2) == 0,
+          "F4  the one-per-process mark went with it");
+    audio_out_close(&out);
+    free(p->ring);
+    free(p);                     /* the leak release documents, on the host */
+}
+
+int main(void)
+{
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    group_a();
+    group_b();
+    group_c();
+    group_d();
+    group_e();
+    group_f();
+    printf("\n%s  %d checks, %d failure(s)\n",
+           failures ? "FAILED" : "PASSED", checks, failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,587 @@
+/*
+ * audio_bench — what the audio engine COSTS, per configuration, as a CSV.
+ *
+ * The audio_*_test programs say whether the engine is right; nothing said how
+ * much of a 600 MHz core it takes to be right, and every decision since F1 has
+ * been argued from "it kept up on the panel".  This is the number behind that:
+ * each stage driven on its own with parameterised voice counts, clip lengths
+ * and limiter modes, and then the whole `audio_pump()` path end to end.
+ *
+ *   bench       what runs                                      parameters
+ *   mix_tone    audio_mix_render(), N tone voices              voices × limit
+ *   mix_clip    audio_mix_render(), N clip voices retriggered  voices × clip × limit
+ *   limit       audio_mix_limit_at() over a hot summed bus     limit
+ *   osc         audio_osc_render(), the theremin's oscillator  —
+ *   wav_pcm     audio_wav_read(), 16-bit mono on stdio         clip
+ *   wav_stereo  the same, stereo, so the (L+R)>>1 downmix      clip
+ *   wav_map     the mono file on the mapped path               clip
+ *   wav_adpcm   audio_wav_read(), 4-bit IMA-ADPCM              clip
+ *   rs          audio_rs_pull(), 22050 → device rate           —
+ *   pump        audio_pump() on the continuous stream, N tone
+ *               voices, fill → interleave → attenuate → write  voices × limit
+ *
+ * One CSV row per configuration on stdout:
+ *
+ *   bench,voices,clip_ms,limit,frames,ns_per_frame,rtf,cpu_pct
+ *
+ * `frames` are OUTPUT frames at the device rate, `rtf` is audio seconds per
+ * wall second (1.0 = exactly real time; the A8 needs it well above 1), and
+ * `cpu_pct` is 100 / rtf — the share of one core the stage would take running
+ * continuously.  Columns that do not apply to a bench are empty.  Each row is
+ * the BEST of `-r` runs: the noise on a benchmark is all on one side.
+ *
+ * ⚠️ **`pump` runs the shipped code with NO hardware**: a null `AudioOutDev`
+ * behind audio_out_open()'s vtable that grants the OMAP codec's geometry and
+ * accepts every byte.  It reports the ring empty on every service, so each
+ * audio_pump() renders a full lead — the worst case per call, and the case that
+ * makes frames per call a constant.  (It therefore counts one `starve` per
+ * service; the bus line audio_close() prints on stderr says so, and it is not a
+ * fault here.)  What it does NOT time is the device: the write's syscall and
+ * the driver behind it are not in this number.
+ *
+ * ⚠️ **Host numbers transfer as a DIRECTION only.**  The A8 has NEON in
+ * audio_gen.o, no divider and a 256 KB L2; compare rows within one machine, and
+ * run the ARM build (build-and-deploy.sh ships it hidden) for absolute figures.
+ * `wav_*` reads fixtures written to `-w` (default /tmp) and re-read from the page
+ * cache, so it is the decode and the copy, not the SD card.
+ *
+ * Usage:
+ *   audio_bench [-v 1,2,4,8] [-c 100,1000] [-l hard,soft] [-s seconds]
+ *               [-r runs] [-b block] [-w fixture_dir] [-o out.csv]
+ *
+ * Build and run (host gcc, from native_apps/):
+ *   gcc -O2 -Wall -Wextra -Wno-unused-parameter -I. -Itests/hostshim \
+ *       -o build/audio_bench tests/audio_bench.c \
+ *       common/audio.c common/audio_gen.c common/audio_out.c common/audio_wav.c \
+ *       common/config.c -lm && \
+ *   ./build/audio_bench > build/audio_bench.csv
+ *
+ * ⚠️ `-Itests/hostshim` is host-only, as for audio_path_dump: the cross
+ * toolchain has the real `<sys/soundcard.h>`.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "common/audio.h"
+#include "common/audio_gen.h"
+#include "common/audio_out.h"
+#include "common/audio_wav.h"
+
+#define RATE            44100
+#define MAX_LIST        8
+
+/* The OMAP codec's grant on the native path — 1024-frame periods, eight of
+ * them (audio_out.h AUDIO_OUT_ALSA_*) — so the lead, and the frames one
+ * service renders, are the panel's. */
+#define NULL_PERIOD     1024
+#define NULL_RING       8192
+
+/* ── Options ────────────────────────────────────────────────────────────── */
+
+typedef struct {
+    int    voices[MAX_LIST];  int nvoices;
+    int    clip_ms[MAX_LIST]; int nclip;
+    int    limit[2];          int nlimit;
+    double seconds;           /* audio rendered per run                       */
+    int    runs;
+    long   block;             /* frames per render call — one service's worth */
+    const char *wav_dir;
+} Opts;
+
+static int parse_list(const char *s, int *out, int max)
+{
+    int n = 0;
+    while (*s && n < max) {
+        char *end;
+        long v = strtol(s, &end, 10);
+        if (end == s || v <= 0) return -1;
+        out[n++] = (int)v;
+        s = (*end == ',') ? end + 1 : end;
+        if (*end && *end != ',') return -1;
+    }
+    return n;
+}
+
+static int parse_limits(const char *s, int *out)
+{
+    int n = 0;
+    if (strstr(s, "hard")) out[n++] = AUDIO_MIX_HARD;
+    if (strstr(s, "soft")) out[n++] = AUDIO_MIX_SOFT;
+    return n;
+}
+
+static const char *limit_name(int mode) { return mode == AUDIO_MIX_SOFT ? "soft" : "hard"; }
+
+/* ── Timing and the row ─────────────────────────────────────────────────── */
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static FILE *g_out;
+
+/* Empty for a column that does not apply, so a spreadsheet reads a gap
+ * rather than a zero that looks measured. */
+static void row(const char *bench, int voices, int clip_ms, int limit,
+                long frames, double best_s)
+{
+    double ns  = best_s * 1e9 / (double)frames;
+    double rtf = ((double)frames / RATE) / best_s;
+    char v[16] = "", c[16] = "";
+    if (voices > 0)  snprintf(v, sizeof(v), "%d", voices);
+    if (clip_ms > 0) snprintf(c, sizeof(c), "%d", clip_ms);
+    fprintf(g_out, "%s,%s,%s,%s,%ld,%.2f,%.1f,%.3f\n", bench, v, c,
+            limit >= 0 ? limit_name(limit) : "", frames, ns, rtf, 100.0 / rtf);
+    fflush(g_out);
+}
+
+/* ── Sources ────────────────────────────────────────────────────────────── */
+
+/* A clip held in RAM, as the clip bank holds one, replayed from the top. */
+typedef struct { const int16_t *pcm; long len, pos; } MemClip;
+
+static long mem_fill(void *ctx, int16_t *dst, long frames)
+{
+    MemClip *m = (MemClip *)ctx;
+    long n = m->len - m->pos;
+    if (n > frames) n = frames;
+    if (n > 0) memcpy(dst, m->pcm + m->pos, (size_t)n * sizeof(int16_t));
+    m->pos += n;
+    return n;
+}
+
+static void fill_sine(int16_t *pcm, long frames, int rate, double hz, double amp)
+{
+    for (long i = 0; i < frames; i++)
+        pcm[i] = (int16_t)lrint(amp * sin(2.0 * M_PI * hz * (double)i / rate));
+}
+
+/* Keep `n` tone voices sounding.  A re-add only happens when one finishes,
+ * which at 30 s per tone is almost never inside a run. */
+static void keep_tones(AudioMixer *mx, int n, int peak)
+{
+    while (audio_mix_active(mx) < n) {
+        int k = audio_mix_active(mx);
+        if (audio_mix_add(mx, 220 * (k + 1), AUDIO_MAX_TONE_MS, 0, peak) < 0) break;
+    }
+}
+
+/* ── Stage benches ──────────────────────────────────────────────────────── */
+
+static int16_t g_mono[16384];
+
+static void bench_mix_tone(const Opts *o, int voices, int limit)
+{
+    static AudioMixer mx;
+    long total = (long)(o->seconds * RATE), best_frames = 0;
+    double best = 1e30;
+
+    for (int r = 0; r < o->runs; r++) {
+        audio_mix_init(&mx, RATE);
+        audio_mix_set_limit(&mx, limit);
+        long done = 0;
+        double t0 = now_s();
+        while (done < total) {
+            keep_tones(&mx, voices, AUDIO_PEAK);
+            done += audio_mix_render(&mx, g_mono, o->block);
+        }
+        double dt = now_s() - t0;
+        if (dt < best) { best = dt; best_frames = done; }
+    }
+    row("mix_tone", voices, 0, limit, best_frames, best);
+}
+
+static void bench_mix_clip(const Opts *o, int voices, int clip_ms, int limit)
+{
+    static AudioMixer mx;
+    static int16_t bufs[AUDIO_MAX_VOICES][1024];
+    MemClip clip[AUDIO_MAX_VOICES];
+    int      slot[AUDIO_MAX_VOICES];
+    uint32_t gen[AUDIO_MAX_VOICES];
+
+    long len = audio_frames_for_ms(RATE, clip_ms);
+    int16_t *pcm = (int16_t *)malloc((size_t)len * sizeof(int16_t));
+    if (!pcm) return;
+    fill_sine(pcm, len, RATE, 660.0, AUDIO_PEAK);
+
+    long total = (long)(o->seconds * RATE), best_frames = 0;
+    double best = 1e30;
+    for (int r = 0; r < o->runs; r++) {
+        audio_mix_init(&mx, RATE);
+        audio_mix_set_limit(&mx, limit);
+        for (int v = 0; v < voices; v++) { slot[v] = -1; gen[v] = 0; }
+        long done = 0;
+        double t0 = now_s();
+        while (done < total) {
+            /* Retrigger what finished: a clip voice's arm is part of what a
+             * short effect costs, so it is inside the timing. */
+            for (int v = 0; v < voices; v++) {
+                if (slot[v] >= 0 && audio_mix_voice_pending(&mx, slot[v], gen[v]) > 0)
+                    continue;
+                clip[v] = (MemClip){ pcm, len, 0 };
+                slot[v] = audio_mix_add_sample(&mx, mem_fill, &clip[v], bufs[v], 1024,
+                                               len, AUDIO_PEAK);
+                gen[v]  = slot[v] >= 0 ? audio_mix_voice_gen(&mx, slot[v]) : 0;
+            }
+            done += audio_mix_render(&mx, g_mono, o->block);
+        }
+        double dt = now_s() - t0;
+        if (dt < best) { best = dt; best_frames = done; }
+    }
+    row("mix_clip", voices, clip_ms, limit, best_frames, best);
+    free(pcm);
+}
+
+/* The limiter alone, over what eight loud voices sum to: a ramp that spends
+ * most of its time above the knee, where SOFT does its divide. */
+static void bench_limit(const Opts *o, int limit)
+{
+    static int32_t acc[4096];
+    for (int i = 0; i < 4096; i++)
+        acc[i] = (int32_t)((i - 2048) * (8 * AUDIO_PEAK / 2048));
+
+    long total = (long)(o->seconds * RATE);
+    double best = 1e30;
+    volatile int32_t sink = 0;
+    for (int r = 0; r < o->runs; r++) {
+        long done = 0;
+        int32_t s = 0;
+        double t0 = now_s();
+        while (done < total) {
+            for (int i = 0; i < 4096; i++) s += audio_mix_limit_at(acc[i], limit, AUDIO_PEAK);
+            done += 4096;
+        }
+        double dt = now_s() - t0;
+        sink += s;
+        if (dt < best) best = dt;
+    }
+    (void)sink;
+    row("limit", 0, 0, limit, (total + 4095) / 4096 * 4096, best);
+}
+
+static void bench_osc(const Opts *o)
+{
+    AudioOsc osc;
+    long total = (long)(o->seconds * RATE), best_frames = 0;
+    double best = 1e30;
+    for (int r = 0; r < o->runs; r++) {
+        audio_osc_init(&osc, RATE, 440.0, AUDIO_PEAK);
+        long done = 0;
+        double t0 = now_s();
+        while (done < total) {
+            osc.target_freq = (done / o->block) & 1 ? 880.0 : 440.0;  /* keep it gliding */
+            audio_osc_render(&osc, AUDIO_OSC_GLIDE, g_mono, o->block);
+            done += o->block;
+        }
+        double dt = now_s() - t0;
+        if (dt < best) { best = dt; best_frames = done; }
+    }
+    row("osc", 0, 0, -1, best_frames, best);
+}
+
+static void bench_rs(const Opts *o)
+{
+    static AudioResampler rs;
+    static int16_t src[22050];
+    fill_sine(src, 22050, 22050, 440.0, AUDIO_PEAK);
+
+    long total = (long)(o->seconds * RATE), best_frames = 0;
+    double best = 1e30;
+    for (int r = 0; r < o->runs; r++) {
+        if (!audio_rs_init(&rs, 22050, RATE)) return;
+        MemClip m = { src, 22050, 0 };
+        long done = 0;
+        double t0 = now_s();
+        while (done < total) {
+            long got = audio_rs_pull(&rs, mem_fill, &m, g_mono, o->block);
+            if (got < o->block) { m.pos = 0; audio_rs_reset(&rs); }
+            done += got;
+        }
+        double dt = now_s() - t0;
+        if (dt < best) { best = dt; best_frames = done; }
+    }
+    row("rs", 0, 0, -1, best_frames, best);
+}
+
+/* ── WAV fixtures and the reader ────────────────────────────────────────── */
+
+static void put32(FILE *f, uint32_t v)
+{
+    unsigned char b[4] = { (unsigned char)v, (unsigned char)(v >> 8),
+                           (unsigned char)(v >> 16), (unsigned char)(v >> 24) };
+    fwrite(b, 1, 4, f);
+}
+
+static void put16(FILE *f, uint16_t v)
+{
+    unsigned char b[2] = { (unsigned char)v, (unsigned char)(v >> 8) };
+    fwrite(b, 1, 2, f);
+}
+
+static bool write_pcm(const char *path, const int16_t *mono, long frames, int channels)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f) return false;
+    uint32_t data = (uint32_t)(frames * channels * 2);
+    fwrite("RIFF", 1, 4, f); put32(f, 36 + data);
+    fwrite("WAVE", 1, 4, f);
+    fwrite("fmt ", 1, 4, f); put32(f, 16);
+    put16(f, AUDIO_WAV_PCM); put16(f, (uint16_t)channels);
+    put32(f, RATE); put32(f, (uint32_t)(RATE * channels * 2));
+    put16(f, (uint16_t)(channels * 2)); put16(f, 16);
+    fwrite("data", 1, 4, f); put32(f, data);
+    for (long i = 0; i < frames; i++)
+        for (int c = 0; c < channels; c++) put16(f, (uint16_t)mono[i]);
+    fclose(f);
+    return true;
+}
+
+/* The layout ../sounds/wav2adpcm.c writes: 512-byte blocks, `fact` chunk. */
+static bool write_adpcm(const char *path, const int16_t *mono, long frames)
+{
+    const int align = 512;
+    long spb = AUDIO_WAV_ADPCM_BLOCK_FRAMES(align, 1);
+    long blocks = (frames + spb - 1) / spb;
+    uint8_t *data = (uint8_t *)malloc((size_t)blocks * align);
+    if (!data) return false;
+    long bytes = 0;
+    int index = 0;
+    for (long at = 0; at < frames; at += spb)
+        bytes += audio_adpcm_encode_block(mono + at, frames - at, &index, data + bytes, align);
+
+    FILE *f = fopen(path, "wb");
+    if (!f) { free(data); return false; }
+    long pad = bytes & 1;
+    fwrite("RIFF", 1, 4, f); put32(f, (uint32_t)(4 + 28 + 12 + 8 + bytes + pad));
+    fwrite("WAVE", 1, 4, f);
+    fwrite("fmt ", 1, 4, f); put32(f, 20);
+    put16(f, AUDIO_WAV_IMA_ADPCM); put16(f, 1);
+    put32(f, RATE); put32(f, (uint32_t)((long)RATE * align / spb));
+    put16(f, (uint16_t)align); put16(f, 4); put16(f, 2); put16(f, (uint16_t)spb);
+    fwrite("fact", 1, 4, f); put32(f, 4); put32(f, (uint32_t)frames);
+    fwrite("data", 1, 4, f); put32(f, (uint32_t)bytes);
+    fwrite(data, 1, (size_t)bytes, f);
+    if (pad) fputc(0, f);
+    fclose(f);
+    free(data);
+    return true;
+}
+
+/* Read `seconds` of a LOOPING open, so a short clip is decoded many times and
+ * the wrap is part of the cost, as it is for a bed. */
+static void bench_wav(const Opts *o, const char *bench, const char *path,
+                      bool map, int clip_ms)
+{
+    long total = (long)(o->seconds * RATE), best_frames = 0;
+    double best = 1e30;
+    for (int r = 0; r < o->runs; r++) {
+        AudioWav w;
+        if (!audio_wav_open(&w, path, true)) {
+            fprintf(stderr, "audio_bench: cannot open %s\n", path);
+            return;
+        }
+        if (map && !audio_wav_map(&w)) {
+            fprintf(stderr, "audio_bench: %s would not map\n", path);
+            audio_wav_close(&w);
+            return;
+        }
+        long done = 0;
+        double t0 = now_s();
+        while (done < total) {
+            long got = audio_wav_read(&w, g_mono, o->block);
+            if (got <= 0) break;
+            done += got;
+        }
+        double dt = now_s() - t0;
+        if (map && w.stalled)
+            fprintf(stderr, "audio_bench: %s stalled %ld frames — page cache cold?\n",
+                    path, w.stalled);
+        audio_wav_close(&w);
+        if (done > 0 && dt < best) { best = dt; best_frames = done; }
+    }
+    if (best_frames > 0) row(bench, 0, clip_ms, -1, best_frames, best);
+}
+
+static void bench_wavs(const Opts *o, int clip_ms)
+{
+    char mono[256], stereo[256], adpcm[256];
+    snprintf(mono,   sizeof(mono),   "%s/audio_bench_%d_mono.wav",   o->wav_dir, clip_ms);
+    snprintf(stereo, sizeof(stereo), "%s/audio_bench_%d_stereo.wav", o->wav_dir, clip_ms);
+    snprintf(adpcm,  sizeof(adpcm),  "%s/audio_bench_%d_adpcm.wav",  o->wav_dir, clip_ms);
+
+    long len = audio_frames_for_ms(RATE, clip_ms);
+    int16_t *pcm = (int16_t *)malloc((size_t)len * sizeof(int16_t));
+    if (!pcm) return;
+    fill_sine(pcm, len, RATE, 440.0, AUDIO_PEAK);
+    bool ok = write_pcm(mono, pcm, len, 1) && write_pcm(stereo, pcm, len, 2) &&
+              write_adpcm(adpcm, pcm, len);
+    free(pcm);
+    if (!ok) { fprintf(stderr, "audio_bench: cannot write fixtures in %s\n", o->wav_dir); return; }
+
+    bench_wav(o, "wav_pcm",    mono,   false, clip_ms);
+    bench_wav(o, "wav_stereo", stereo, false, clip_ms);
+    bench_wav(o, "wav_map",    mono,   true,  clip_ms);
+    bench_wav(o, "wav_adpcm",  adpcm,  false, clip_ms);
+    unlink(mono); unlink(stereo); unlink(adpcm);
+}
+
+/* ── The whole pump, on a null device ───────────────────────────────────── */
+
+static int null_open(void *ctx, int rate_req, int channels_req,
+                     int *rate, int *bits, int *channels)
+{
+    *rate = RATE; *bits = 16; *channels = channels_req;
+    return 0;
+}
+
+static int null_space(void *ctx, int frame_bytes, AudioOutSpace *sp)
+{
+    sp->period_frames = NULL_PERIOD;
+    sp->ring_frames   = NULL_RING;
+    sp->in_flight     = 0;
+    sp->space         = NULL_RING;
+    return 0;
+}
+
+static ssize_t null_write(void *ctx, const void *buf, size_t n, bool *again)
+{
+    return (ssize_t)n;
+}
+
+static void null_wait(void *ctx, int usec) { }
+static void null_close(void *ctx) { }
+
+static const AudioOutDev NULL_DEV = {
+    null_open, null_space, null_write, null_wait, null_close, NULL, NULL, NULL, NULL
+};
+
+/* An `Audio` on the continuous path with the null device under it — the
+ * fields audio_open() and audio_cont_enable() would have set, and no fd. */
+static bool mk_pump(Audio *a, int limit)
+{
+    memset(a, 0, sizeof(*a));
+    a->dsp_fd       = -1;
+    a->sample_rate  = RATE;
+    a->channels     = 2;
+    a->available    = true;
+    a->vol          = AUDIO_VOICE_VOL;
+    a->master_shift = AUDIO_MASTER_SHIFT;
+    a->music_on     = true;
+    a->effects_on   = true;
+    for (int i = 0; i < AUDIO_CLIP_VOICES; i++) a->fxv[i].slot = -1;
+    a->music.slot = a->sfx.slot = -1;
+    if (audio_out_open(&a->out, &NULL_DEV, NULL, RATE, 2) != 0) return false;
+    a->cont    = true;
+    a->pumping = true;
+    audio_mix_init(&a->mix, RATE);
+    audio_mix_set_limit(&a->mix, limit);
+    audio_mix_set_knee(&a->mix, audio_voice_peak(a->vol));
+    audio_out_set_shift(&a->out, a->master_shift);
+    audio_out_set_fill(&a->out, audio_cont_fill_mix, a, "audio_bench");
+    return true;
+}
+
+static void bench_pump(const Opts *o, int voices, int limit)
+{
+    static Audio a;
+    long total = (long)(o->seconds * RATE), best_frames = 0;
+    double best = 1e30;
+    for (int r = 0; r < o->runs; r++) {
+        if (!mk_pump(&a, limit)) { fprintf(stderr, "audio_bench: null device refused\n"); return; }
+        long long w0 = audio_out_written(&a.out);
+        long done = 0;
+        double t0 = now_s();
+        while (done < total) {
+            keep_tones(&a.mix, voices, audio_voice_peak(a.vol));
+            audio_pump(&a);
+            long long w = audio_out_written(&a.out);
+            if (w - w0 == done) break;                /* wedged: nothing taken */
+            done = (long)(w - w0);
+        }
+        double dt = now_s() - t0;
+        audio_close(&a);
+        if (done > 0 && dt < best) { best = dt; best_frames = done; }
+    }
+    if (best_frames > 0) row("pump", voices, 0, limit, best_frames, best);
+}
+
+/* ── main ───────────────────────────────────────────────────────────────── */
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage: audio_bench [-v 1,2,4,8] [-c 100,1000] [-l hard,soft] [-s seconds]\n"
+            "                   [-r runs] [-b block] [-w fixture_dir] [-o out.csv]\n");
+}
+
+int main(int argc, char **argv)
+{
+    Opts o = {
+        .voices  = { 1, 2, 4, 8 }, .nvoices = 4,
+        .clip_ms = { 100, 1000 },  .nclip   = 2,
+        .limit   = { AUDIO_MIX_HARD, AUDIO_MIX_SOFT }, .nlimit = 2,
+        .seconds = 10.0, .runs = 3, .block = 1024, .wav_dir = "/tmp",
+    };
+    const char *out_path = NULL;
+
+    int c;
+    while ((c = getopt(argc, argv, "v:c:l:s:r:b:w:o:h")) != -1) {
+        switch (c) {
+        case 'v': o.nvoices = parse_list(optarg, o.voices, MAX_LIST);   break;
+        case 'c': o.nclip   = parse_list(optarg, o.clip_ms, MAX_LIST);  break;
+        case 'l': o.nlimit  = parse_limits(optarg, o.limit);            break;
+        case 's': o.seconds = atof(optarg);                             break;
+        case 'r': o.runs    = atoi(optarg);                             break;
+        case 'b': o.block   = atol(optarg);                             break;
+        case 'w': o.wav_dir = optarg;                                   break;
+        case 'o': out_path  = optarg;                                   break;
+        default:  usage(); return 2;
+        }
+    }
+    /* A voice count past the bus is refused by the mixer, so it would time
+     * fewer voices than its row claims. */
+    bool bad = o.nvoices <= 0 || o.nclip <= 0 || o.nlimit <= 0 ||
+               o.seconds <= 0.0 || o.runs <= 0 ||
+               o.block <= 0 || o.block > (long)(sizeof(g_mono) / sizeof(g_mono[0]));
+    for (int i = 0; i < o.nvoices && !bad; i++) bad = o.voices[i] > AUDIO_MAX_VOICES;
+    for (int i = 0; i < o.nclip && !bad; i++)   bad = o.clip_ms[i] > AUDIO_MAX_TONE_MS;
+    if (bad) { usage(); return 2; }
+
+    g_out = stdout;
+    if (out_path && !(g_out = fopen(out_path, "w"))) {
+        perror(out_path);
+        return 1;
+    }
+
+    fprintf(g_out, "bench,voices,clip_ms,limit,frames,ns_per_frame,rtf,cpu_pct\n");
+
+    for (int l = 0; l < o.nlimit; l++)
+        for (int v = 0; v < o.nvoices; v++)
+            bench_mix_tone(&o, o.voices[v], o.limit[l]);
+    for (int l = 0; l < o.nlimit; l++)
+        for (int k = 0; k < o.nclip; k++)
+            for (int v = 0; v < o.nvoices; v++)
+                bench_mix_clip(&o, o.voices[v], o.clip_ms[k], o.limit[l]);
+    for (int l = 0; l < o.nlimit; l++)
+        bench_limit(&o, o.limit[l]);
+    bench_osc(&o);
+    bench_rs(&o);
+    for (int k = 0; k < o.nclip; k++)
+        bench_wavs(&o, o.clip_ms[k]);
+    for (int l = 0; l < o.nlimit; l++)
+        for (int v = 0; v < o.nvoices; v++)
+            bench_pump(&o, o.voices[v], o.limit[l]);
+
+    if (g_out != stdout) fclose(g_out);
+    return 0;
+}
@@ -780,7 +780,7 @@ int main(int argc, char *argv[])
             fprintf(stderr, "mix: tap act=%d pad=%s freq=%d ms=%d path=%s cont=%d "
                             "svc_us=%ld pump_label=%d "
                             "pump_active=%d keepalive=%d limit=%s vol=%d shift=%d acoustic=%d voices=%d "
-                            "clip=%lu lim=%lu starve=%lu lost=%lu drop=%lu "
+                            "clip=%lu lim=%lu starve=%lu stall=%lu lost=%lu drop=%lu "
                             "bed=%d wraps=%ld "
                             "gapmax=%lu lead=%ldfr/%ldms period=%ldfr\n",
                     (int)p->act, p->btn.text, p->freq, p->ms,
@@ -797,6 +797,7 @@ int main(int argc, char *argv[])
                     (unsigned long)audio_pump_clipped(&audio),
                     (unsigned long)audio_pump_limited(&audio),
                     (unsigned long)audio_pump_starved(&audio),
+                    (unsigned long)audio_pump_stalled(&audio),
                     (unsigned long)audio_pump_lost(&audio),
                     (unsigned long)audio_pump_dropped(&audio),
                     (int)audio_music_active(&audio), audio.music.wav.loops,
@@ -272,7 +272,7 @@ static void fake_wait(void *ctx, int usec)
 static void fake_close(void *ctx) { ((Fake *)ctx)->closes++; }
 
 static const AudioOutDev FAKE_DEV = {
-    fake_open, fake_space, fake_write, fake_wait, fake_close
+    fake_open, fake_space, fake_write, fake_wait, fake_close, NULL, NULL, NULL, NULL
 };
 
 /** 44100 / 2 channels / 2048-frame period / 16-period ring — the configuration
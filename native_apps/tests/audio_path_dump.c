@@ -163,7 +163,7 @@ static void fd_wait(void *ctx, int usec)
 static void fd_close(void *ctx) { (void)ctx; }
 
 static const AudioOutDev file_dev = {
-    fd_open, fd_space, fd_write, fd_wait, fd_close
+    fd_open, fd_space, fd_write, fd_wait, fd_close, NULL, NULL, NULL, NULL
 };
 
 /* ── The signal checks ───────────────────────────────────────────────────────
@@ -35,16 +35,88 @@
  *       common/audio_wav.c common/audio_gen.c -lm
  */
 
+#include <fcntl.h>
+#include <signal.h>
 #include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 #include "common/audio_wav.h"
 #include "common/audio_gen.h"
 
 static int checks = 0, failures = 0;
 
+/* ── the simulated card, for group J ───────────────────────────────────────
+ * ⚠️ These three DEFINE libc's `mincore`, `posix_fadvise` and `madvise`, so the
+ * calls audio_wav.c makes land here instead — the executable's definition wins
+ * over the shared library's.  That is the stall injection: a page is "on the
+ * card" until `card_head` passes it, whatever the real page cache holds (and on
+ * a tmpfs /tmp it holds everything, so the real call could never show a stall).
+ *
+ * And the proof that nothing WAITS is stronger than a timer: every undelivered
+ * page of the mapping is mprotect()ed PROT_NONE, so touching one — which on the
+ * device is a fault that sleeps on the SD — raises SIGSEGV here, and the handler
+ * counts it in `touched_undelivered` and unprotects the page so the run can go on
+ * to report it.  With the card stalled the render must leave that at 0. */
+static uintptr_t card_head = UINTPTR_MAX;   /* first undelivered address       */
+static long      page_size;
+/* Written by the SIGSEGV handler: volatile, or at -O2 the compiler keeps the
+ * value it read before the poke and the control below never sees the trap. */
+static volatile sig_atomic_t touched_undelivered;
+static long      hint_off[64], hint_len[64];
+static int       hints, sequential;
+
+int mincore(void *addr, size_t length, unsigned char *vec)
+{
+    uintptr_t a = (uintptr_t)addr;
+    for (size_t i = 0; i * (size_t)page_size < length; i++)
+        vec[i] = (a + i * (size_t)page_size < card_head) ? 1 : 0;
+    return 0;
+}
+
+int posix_fadvise(int fd, off_t offset, off_t len, int advice)
+{
+    if (advice == POSIX_FADV_WILLNEED && hints < 64) {
+        hint_off[hints] = (long)offset;
+        hint_len[hints] = (long)len;
+        hints++;
+    }
+    return 0;
+}
+
+int madvise(void *addr, size_t length, int advice)
+{
+    if (advice == MADV_SEQUENTIAL) sequential++;
+    return 0;
+}
+
+static void on_segv(int sig, siginfo_t *si, void *uc)
+{
+    uintptr_t a = (uintptr_t)si->si_addr & ~((uintptr_t)page_size - 1);
+    touched_undelivered++;
+    if (mprotect((void *)a, (size_t)page_size, PROT_READ) != 0) _exit(3);
+}
+
+/* The card stalls at `at` (an address in the mapping): mincore says so, and the
+ * pages are fenced so that a touch is caught rather than waited on. */
+static void card_stall(const AudioWav *w, uintptr_t at)
+{
+    uintptr_t end = (uintptr_t)w->map_base + w->map_len;
+    card_head = at & ~((uintptr_t)page_size - 1);
+    mprotect((void *)card_head, end - card_head, PROT_NONE);
+}
+
+static void card_deliver(const AudioWav *w)
+{
+    uintptr_t end = (uintptr_t)w->map_base + w->map_len;
+    if (card_head < end) mprotect((void *)card_head, end - card_head, PROT_READ);
+    card_head = UINTPTR_MAX;
+}
+
 static void check(int ok, const char *what)
 {
     checks++;
@@ -115,6 +187,44 @@ static void write_fixture(const char *path, const int16_t *pcm, long frames,
     fclose(f);
 }
 
+/* An IMA-ADPCM fixture, mono, encoded by the reader's own encoder.  `fact`
+ * false leaves the frame count to the block arithmetic; `spb` 0 writes the
+ * correct samples-per-block and anything else writes a lie.  Returns the data
+ * chunk's byte count. */
+static long write_adpcm(const char *path, const int16_t *pcm, long frames,
+                        int block_align, int fact, long spb)
+{
+    static uint8_t data[65536];
+    long bpb = AUDIO_WAV_ADPCM_BLOCK_FRAMES(block_align, 1);
+    long bytes = 0;
+    int  index = 0;
+    for (long at = 0; at < frames && bytes + block_align <= (long)sizeof(data); at += bpb)
+        bytes += audio_adpcm_encode_block(pcm + at, frames - at, &index,
+                                          data + bytes, block_align);
+
+    FILE *f = fopen(path, "wb");
+    if (!f) { printf("  (cannot write %s)\n", path); return 0; }
+    long pad = bytes & 1;
+    fwrite("RIFF", 1, 4, f);
+    put32(f, (unsigned long)(4 + 28 + (fact ? 12 : 0) + 8 + bytes + pad));
+    fwrite("WAVE", 1, 4, f);
+    fwrite("fmt ", 1, 4, f);  put32(f, 20);
+    put16(f, AUDIO_WAV_IMA_ADPCM);
+    put16(f, 1);
+    put32(f, RATE);
+    put32(f, (unsigned long)(RATE / 2));          /* informational only        */
+    put16(f, (unsigned int)block_align);
+    put16(f, 4);                                  /* bits                      */
+    put16(f, 2);                                  /* cbSize                    */
+    put16(f, (unsigned int)(spb ? spb : bpb));
+    if (fact) { fwrite("fact", 1, 4, f); put32(f, 4); put32(f, (unsigned long)frames); }
+    fwrite("data", 1, 4, f);  put32(f, (unsigned long)bytes);
+    fwrite(data, 1, (size_t)bytes, f);
+    if (pad) fputc(0, f);
+    fclose(f);
+    return bytes;
+}
+
 /* A ramp, so any frame's expected value is a function of its index alone and a
  * misaligned read is visible rather than merely different. */
 static void fill_ramp(int16_t *pcm, long n, int step)
@@ -413,6 +523,264 @@ int main(void)
         audio_wav_close(&w);
     }
 
+    /* ── I. IMA-ADPCM ────────────────────────────────────────────────────── */
+    printf("\nI. a 4:1 IMA-ADPCM file plays as the PCM it was made from\n");
+    {
+        /* The decoder against arithmetic done by hand, BEFORE the encoder is
+         * trusted for anything: an encoder and decoder that share one mistake
+         * round-trip perfectly.  Header pred 0, index 0; byte 0x77 is nibbles
+         * 7 then 7.  Step 7: 0 + 7 + 3 + 1 = 11, index → 8.  Step 16:
+         * 2 + 16 + 8 + 4 = 30, so 41. */
+        const uint8_t hand[5] = { 0x00, 0x00, 0x00, 0x00, 0x77 };
+        int16_t hd[3] = { -1, -1, -1 };
+        check(audio_adpcm_decode_block(hand, 5, 1, hd) == 3,
+              "one byte after the header decodes to three frames");
+        check(hd[0] == 0 && hd[1] == 11 && hd[2] == 41,
+              "and they are 0, 11, 41 — the IMA step table, worked by hand");
+
+        /* Stereo: L header 1000, R 3000, all-zero nibbles hold both flat at
+         * index 0 (step 7 >> 3 is 0), so every frame is the average, 2000. */
+        uint8_t st[24] = { 0xe8, 0x03, 0, 0, 0xb8, 0x0b, 0, 0 };
+        static int16_t sd[32];
+        long sn = audio_adpcm_decode_block(st, 24, 2, sd);
+        int flat = (sn == 17);
+        for (long i = 0; i < sn; i++) if (sd[i] != 2000) flat = 0;
+        check(flat, "stereo: 1 + 2×8 frames, each (L+R)>>1 = 2000");
+
+        /* A 1 kHz sine at -8 dBFS, 5001 frames in 256-byte blocks (505 frames
+         * each): nine full blocks and a short tenth whose frame count is odd,
+         * so the encoder's spare nibble is exercised. */
+        static int16_t src[5001];
+        for (long i = 0; i < 5001; i++)
+            src[i] = (int16_t)lrint(13000.0 * sin(2.0 * M_PI * 1000.0 * (double)i / RATE));
+        long bytes = write_adpcm("/tmp/as_ima.wav", src, 5001, 256, 1, 0);
+
+        check(audio_wav_open(&w, "/tmp/as_ima.wav", false), "ADPCM file opens");
+        check(w.format == AUDIO_WAV_IMA_ADPCM && w.block_align == 256
+              && w.block_frames == 505, "ADPCM: format 0x11, 256-byte blocks of 505");
+        check(w.frames == 5001, "ADPCM: 5001 frames — the `fact` count, not 5002");
+        check(w.data_bytes == bytes && w.data_bytes * 39 <= 5001L * 2 * 10,
+              "ADPCM: the payload is under a 3.9th of the 16-bit size");
+
+        static int16_t whole[6000];
+        long n = audio_wav_read(&w, whole, 6000);
+        check(n == 5001, "ADPCM: a whole read returns every frame and stops");
+        double sq = 0.0;
+        long worst = 0;
+        for (long i = 0; i < n; i++) {
+            long e = labs((long)whole[i] - (long)src[i]);
+            if (e > worst) worst = e;
+            sq += (double)e * (double)e;
+        }
+        double rms_err = sqrt(sq / (double)(n > 0 ? n : 1));
+        /* ⚠️ Bounds from a measurement of this very signal (rms 109, worst 282
+         * on 2026-10-16), with headroom.  A decode off by one nibble, one block
+         * or one byte order lands in the thousands — and so does an encoder
+         * that starts every file at index 0: rms 283, worst 8644 at frame 6,
+         * which is what the `worst` bound is really for. */
+        check(rms_err < 250.0, "ADPCM: rms error is a small fraction of the signal");
+        check(worst < 1500, "ADPCM: no frame is off by more than a quantisation step");
+        check(whole[0] == src[0] && whole[505] == src[505] && whole[4545] == src[4545],
+              "ADPCM: every block's first frame is exact — it is the header");
+        audio_wav_close(&w);
+
+        /* Pieces equal the whole, across block edges and the short last block. */
+        check(audio_wav_open(&w, "/tmp/as_ima.wav", false), "reopen ADPCM for streaming");
+        long total = 0;
+        const long sizes[5] = { 1, 37, 504, 506, 1024 };
+        for (int i = 0; total < 5001; i = (i + 1) % 5) {
+            long k = audio_wav_read(&w, got + (total % 4000), sizes[i]);
+            if (k <= 0) break;
+            if (memcmp(got + (total % 4000), whole + total, (size_t)k * 2) != 0) break;
+            total += k;
+        }
+        check(total == 5001, "ADPCM: odd-sized reads are frame-identical to one read");
+
+        /* Rewind mid-block drops the half-used decode. */
+        audio_wav_rewind(&w);
+        check(audio_wav_read(&w, got, 10) == 10 && memcmp(got, whole, 20) == 0,
+              "ADPCM: rewind restarts at frame 0, not mid-block");
+        audio_wav_close(&w);
+
+        /* Looping wraps at the `fact` end, not at the spare frame. */
+        check(audio_wav_open(&w, "/tmp/as_ima.wav", true), "reopen ADPCM looping");
+        static int16_t lp[5101];
+        check(audio_wav_read(&w, lp, 5101) == 5101 && w.loops == 1,
+              "ADPCM loop: reads straight through the wrap, counted once");
+        check(memcmp(lp + 5001, whole, 100 * 2) == 0,
+              "ADPCM loop: the frame after the last is frame 0");
+        audio_wav_close(&w);
+
+        /* The clip bank's path: the payload raw, then decoded block by block. */
+        check(audio_wav_open(&w, "/tmp/as_ima.wav", false), "reopen ADPCM raw");
+        static uint8_t raw[4096];
+        long rb = audio_wav_read_raw(&w, raw, sizeof(raw));
+        check(rb == bytes, "raw read returns exactly the data chunk");
+        long bf = audio_adpcm_decode_block(raw + 3 * 256, 256, 1, got);
+        check(bf == 505 && memcmp(got, whole + 3 * 505, 505 * 2) == 0,
+              "block 3 decoded alone equals frames 1515.. of the stream");
+        audio_wav_close(&w);
+
+        /* No `fact`: the block arithmetic's count, spare frame included. */
+        write_adpcm("/tmp/as_ima_nofact.wav", src, 5001, 256, 0, 0);
+        check(audio_wav_open(&w, "/tmp/as_ima_nofact.wav", false)
+              && w.frames == 5002, "no fact: 9×505 + 457 = 5002 frames");
+        audio_wav_close(&w);
+
+        /* Refusals: a samples-per-block that disagrees with the block, and a
+         * block bigger than the reader will allocate for. */
+        write_adpcm("/tmp/as_ima_spb.wav", src, 5001, 256, 1, 500);
+        check(!audio_wav_open(&w, "/tmp/as_ima_spb.wav", false),
+              "a samples-per-block that disagrees with the block is REFUSED");
+        write_adpcm("/tmp/as_ima_big.wav", src, 5001, 4096, 1, 0);
+        check(!audio_wav_open(&w, "/tmp/as_ima_big.wav", false),
+              "a 4096-byte block is REFUSED, not allocated");
+
+        /* Negative control: the same payload read as if it were PCM is nothing
+         * like the source — so the closeness above is the decoder's doing. */
+        double sq_raw = 0.0;
+        const int16_t *as_pcm = (const int16_t *)raw;
+        for (long i = 0; i < 1000; i++) {
+            double e = (double)as_pcm[i] - (double)src[i];
+            sq_raw += e * e;
+        }
+        check(sqrt(sq_raw / 1000.0) > 10.0 * rms_err,
+              "control: the payload misread as PCM is ten times further off");
+    }
+
+    /* ── J. mapped streaming: the render never waits on the card ───────────── */
+    printf("\nJ. a mapped bed reads ahead, and a stalled card costs a gap, never a wait\n");
+    {
+        page_size = sysconf(_SC_PAGESIZE);
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_sigaction = on_segv;
+        sa.sa_flags     = SA_SIGINFO;
+        sigaction(SIGSEGV, &sa, NULL);
+
+        /* 4 s of mono, every frame's value a function of its index: 352800
+         * bytes, so five 64 KB windows and a bit. */
+        static int16_t bed[176400];
+        for (long i = 0; i < 176400; i++) bed[i] = (int16_t)(i * 7);
+        FILE *f = fopen("/tmp/as_bed.wav", "wb");
+        if (f) {
+            fwrite("RIFF", 1, 4, f); put32(f, 36 + 352800);
+            fwrite("WAVE", 1, 4, f);
+            fwrite("fmt ", 1, 4, f); put32(f, 16);
+            put16(f, 1); put16(f, 1); put32(f, RATE); put32(f, RATE * 2);
+            put16(f, 2); put16(f, 16);
+            fwrite("data", 1, 4, f); put32(f, 352800);
+            fwrite(bed, 2, 176400, f);
+            fclose(f);
+        }
+
+        /* The negative control FIRST: the trap must be seen to fire, or a
+         * zero below means only that nothing was watching. */
+        check(audio_wav_open(&w, "/tmp/as_bed.wav", true), "bed opens");
+        hints = 0; sequential = 0;
+        check(audio_wav_map(&w) && w.map != NULL, "the bed maps");
+        card_stall(&w, (uintptr_t)(w.map + 200000));
+        volatile uint8_t poke = w.map[300000];
+        (void)poke;
+        check(touched_undelivered == 1,
+              "control: touching an undelivered page IS caught by the trap");
+        card_deliver(&w);
+        touched_undelivered = 0;
+
+        check(sequential == 1, "the mapping is marked MADV_SEQUENTIAL");
+        check(hints == 2 && hint_off[0] == 44 && hint_len[0] == AUDIO_WAV_MAP_WINDOW
+              && hint_off[1] == 44 + AUDIO_WAV_MAP_WINDOW,
+              "map hints the first TWO windows before any read");
+
+        /* Read up to one page short of a stall point, with the card stalled
+         * there.  A direct read first: full count, zeros, cursor held. */
+        long stop_frame = 20000;                       /* 40000 bytes in        */
+        card_stall(&w, (uintptr_t)(w.map + stop_frame * 2));
+        long head = (long)(card_head - (uintptr_t)w.map) / 2;   /* first frame off the card */
+        long n = 0;
+        while (w.pos + 2048 <= head) n += audio_wav_read(&w, got, 2048);
+        check(n == w.pos && memcmp(got, bed + w.pos - 2048, 2048 * 2) == 0,
+              "before the stall the frames are the file's");
+        long at = w.pos;
+        n = audio_wav_read(&w, got, 2048);
+        int zeros = 1;
+        for (long i = head - at; i < 2048; i++) if (got[i] != 0) zeros = 0;
+        check(n == 2048, "a stalled read still returns FULL — a short one would end the voice");
+        check(w.pos == head && memcmp(got, bed + at, (size_t)(head - at) * 2) == 0,
+              "it takes every delivered frame, and stops at the card's head");
+        check(zeros && w.stalled == 2048 - (head - at),
+              "the rest is silence, counted in `stalled`");
+        check(touched_undelivered == 0, "and not one undelivered byte was touched");
+
+        /* The card catches up: the very next frame is the next frame. */
+        card_deliver(&w);
+        long before = w.stalled;
+        n = audio_wav_read(&w, got, 100);
+        check(n == 100 && memcmp(got, bed + head, 200) == 0 && w.stalled == before,
+              "delivered: it resumes at the frame it stalled on — no skip");
+
+        /* Hints ride ahead of the cursor. */
+        long last = 0;
+        for (int i = 0; i < hints; i++)
+            if (hint_off[i] + hint_len[i] > last) last = hint_off[i] + hint_len[i];
+        check(last >= 44 + w.pos * 2 + AUDIO_WAV_MAP_WINDOW,
+              "WILLNEED has been issued at least a window ahead of the cursor");
+
+        /* Now the whole point: through the MIXER, with the card stalled.  The
+         * render is where the fill is pulled, so this is the claim itself. */
+        AudioMixer m;
+        audio_mix_init(&m, RATE);
+        int slot = audio_mix_add_sample(&m, audio_wav_fill, &w, vbuf, 2048,
+                                        RATE * 60L, AUDIO_PEAK);
+        card_stall(&w, (uintptr_t)(w.map + w.cur + 3 * 4096));
+        static int16_t mixed[4096];
+        long rendered = 0;
+        for (int k = 0; k < 40; k++) rendered += audio_mix_render(&m, mixed, 1024);
+        check(rendered == 40 * 1024, "the render returns every block while the card is stalled");
+        check(touched_undelivered == 0,
+              "⚠️ audio_mix_render touched NO undelivered page — it never waited on I/O");
+        check(w.stalled > before && audio_mix_voice_gen(&m, slot) != 0
+              && audio_mix_voice_pending(&m, slot, audio_mix_voice_gen(&m, slot)) > 0,
+              "the bed stalled, counted it, and is still alive on the bus");
+        card_deliver(&w);
+        before = w.stalled;
+        for (int k = 0; k < 8; k++) audio_mix_render(&m, mixed, 1024);
+        check(w.stalled == before, "delivered: the stall count stops growing");
+
+        /* The wrap is hinted before it happens.  Read to the last window. */
+        audio_mix_init(&m, RATE);                     /* drop the voice, not the file */
+        while (w.pos < 176400 - 4096) audio_wav_read(&w, got, 4096);
+        check(w.wrap_hinted && hint_off[hints - 1] == 44,
+              "near the end, the file's FIRST window is hinted for the wrap");
+        long tail = 176400 - w.pos;
+        n = audio_wav_read(&w, got, 8192);
+        check(n == 8192 && w.loops == 1
+              && memcmp(got, bed + 176400 - tail, (size_t)tail * 2) == 0
+              && memcmp(got + tail, bed, (size_t)(8192 - tail) * 2) == 0,
+              "the wrap is seamless: after the last frame comes frame 0");
+        check(touched_undelivered == 0 && w.stalled == before,
+              "a clean card stalls nothing, end to end");
+        audio_wav_close(&w);
+
+        /* ADPCM takes the same mapped road; its frames must not change. */
+        check(audio_wav_open(&w, "/tmp/as_ima.wav", false) && audio_wav_map(&w),
+              "the ADPCM file maps too");
+        static int16_t ima_map[6000], ima_io[6000];
+        long a = audio_wav_read(&w, ima_map, 6000);
+        audio_wav_close(&w);
+        audio_wav_open(&w, "/tmp/as_ima.wav", false);
+        long b = audio_wav_read(&w, ima_io, 6000);
+        audio_wav_close(&w);
+        check(a == 5001 && a == b && memcmp(ima_map, ima_io, (size_t)a * 2) == 0,
+              "ADPCM mapped decodes frame-identical to ADPCM through stdio");
+
+        /* Refused after a read: the cursor would have to be translated. */
+        audio_wav_open(&w, "/tmp/as_bed.wav", false);
+        audio_wav_read(&w, got, 10);
+        check(!audio_wav_map(&w) && w.map == NULL, "map is refused once the file has been read");
+        audio_wav_close(&w);
+    }
+
     printf("\n%d checks, %d failures\n", checks, failures);
     return failures ? 1 : 0;
 }
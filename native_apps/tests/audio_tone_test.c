@@ -62,6 +62,17 @@
  * hardwired HARD inside `bus_reset()` would satisfy the first and destroy the
  * carry-across the panel's `LIM` pad depends on.
  *
+ * Group M is the shared effect bank: audio_fx_bank_publish() into a file in
+ * /tmp, mapped by audio_fx_bank_attach(), and the two refusals that make it a
+ * cache rather than a source of truth — a file edited since publishing, and a
+ * bank at another rate.  Its content check is group I's, for group I's reason.
+ *
+ * Group L is trigger-to-DAC latency through the shipped continuous path: a
+ * simulated device behind audio_out_open()'s vtable whose reported delay the
+ * check sets, so the position a trigger is stamped with and the projection that
+ * resolves it are both exact numbers rather than timings.  The arithmetic alone
+ * is `tests/audio_gen_test.c` group U.
+ *
  * ⚠️ **Group A is group B's negative control, which is why it must not be deleted
  * as redundant.**  A guard that is accidentally always-false passes B and C for the
  * wrong reason — it would look like a fix while having abolished chaining outright.
@@ -153,6 +164,11 @@ static void gap_one_tap(void) { usleep(133000); }
  */
 #define BED_FIXTURE "/tmp/at_bed.wav"
 
+/* Group J's second track: half a second, so "which file is playing" is answered
+ * by `wav.frames` without reading content. */
+#define CUE_FIXTURE    "/tmp/at_cue.wav"
+#define CUE_ABSENT     "/tmp/at_cue_absent.wav"
+
 /* Group I's fixtures.  Short, because a clip is an EFFECT: 4410 frames is 100 ms
  * at TEST_RATE, which is the length the stock set actually renders (27–200 ms).
  * CLIP_TOO_BIG is written once and removed — it is 353 KB and exists only to
@@ -164,6 +180,9 @@ static void gap_one_tap(void) { usleep(133000); }
 #define CLIP_TAIL     "/tmp/at_clip_tail.wav"
 #define CLIP_FRAMES   4410L
 
+/* Group M's bank, published and mapped by the test itself. */
+#define BANK_FIXTURE  "/tmp/at_fxbank"
+
 static void put32(FILE *f, unsigned long v)
 {
     fputc((int)(v & 0xff), f);         fputc((int)((v >> 8) & 0xff), f);
@@ -237,6 +256,25 @@ static void write_tail_fixture(const char *path, long frames)
     fclose(f);
 }
 
+/* The QUIETEST sample the bus produced over `frames`.  Group J's gap check: the
+ * fixtures are a square wave that never crosses zero gently, so one frame of
+ * silence at a handoff is a sample near 0, and nothing else is. */
+static int render_floor(Audio *a, long frames)
+{
+    static int16_t mono[2048];
+    int floor = 32767;
+    while (frames > 0) {
+        long n = frames > 2048 ? 2048 : frames;
+        audio_mix_render(&a->mix, mono, n);
+        for (long i = 0; i < n; i++) {
+            int v = mono[i] < 0 ? -mono[i] : mono[i];
+            if (v < floor) floor = v;
+        }
+        frames -= n;
+    }
+    return floor;
+}
+
 /* Render the bus for real, which is the only thing that advances a voice — and
  * the only thing that finishes a release.  A game does this through
  * audio_pump(); here there is no device, so drive the mixer directly. */
@@ -250,6 +288,35 @@ static void render_frames(Audio *a, long frames)
     }
 }
 
+/* Group L's device: a ring that takes everything and plays nothing on its own,
+ * so the delay it reports is whatever the check says.  It reaches the shipped
+ * continuous path through audio_out_open()'s vtable, which is the one way a
+ * host test gets `cont` set with a stream that really counts frames. */
+static long lat_dev_delay;
+
+static int lat_open(void *ctx, int rate_req, int channels_req,
+                    int *rate, int *bits, int *channels)
+{
+    *rate = rate_req; *bits = 16; *channels = channels_req;
+    return 0;
+}
+static int lat_space(void *ctx, int frame_bytes, AudioOutSpace *sp)
+{
+    sp->period_frames = 1024;
+    sp->ring_frames   = 8192;
+    sp->in_flight     = 0;
+    sp->space         = 8192;
+    return 0;
+}
+static ssize_t lat_write(void *ctx, const void *buf, size_t n, bool *again) { return (ssize_t)n; }
+static void lat_wait(void *ctx, int usec) { }
+static void lat_close(void *ctx) { }
+static long lat_delay(void *ctx, int frame_bytes) { return lat_dev_delay; }
+
+static const AudioOutDev LAT_DEV = {
+    lat_open, lat_space, lat_write, lat_wait, lat_close, NULL, NULL, NULL, lat_delay
+};
+
 int main(void)
 {
     Audio a;
@@ -502,6 +569,7 @@ int main(void)
     {
         fd = mk_audio(&a);
         if (fd < 0) return 1;
+        a.effects_on = true;        /* the conversion checks below need a real yes */
         /* A MISSING file is the normal case (the sound files are device-only,
          * ../IMPROVEMENT_PLAN.md F19) and the refusal is permanent for the
          * process: a per-trigger retry would fill app_stdout.log.  Creating the
@@ -514,11 +582,21 @@ int main(void)
               "and the refusal is PERMANENT — the file appearing changes nothing");
         remove(CLIP_ABSENT);
 
-        /* Same refusal as the bed's, and for the same reason: no resampler. */
+        /* A clip at another rate is CONVERTED once, at load — held at the
+         * device rate, so its length in RAM is the converted one — and a pair
+         * past the converter's 4:1 is refused, never pitch-shifted. */
+        write_bed_fixture(CLIP_FIXTURE, CLIP_FRAMES);
         audio_fx_set_path(&a, AUDIO_FX_BEEP, CLIP_FIXTURE);
         a.sample_rate = TEST_RATE / 2;
-        check(!audio_fx_play(&a, AUDIO_FX_BEEP),
-              "a clip at the wrong rate is refused, not pitch-shifted");
+        check(audio_fx_play(&a, AUDIO_FX_BEEP),
+              "a clip at twice the device rate plays — converted, not refused");
+        check(a.fx[AUDIO_FX_BEEP].frames == CLIP_FRAMES / 2,
+              "and is held at the DEVICE rate: half the frames");
+        audio_fx_set_path(&a, AUDIO_FX_BLIP, CLIP_FIXTURE2);
+        write_bed_fixture(CLIP_FIXTURE2, CLIP_FRAMES);
+        a.sample_rate = TEST_RATE / 5;
+        check(!audio_fx_play(&a, AUDIO_FX_BLIP),
+              "a 5:1 clip is past the converter and refused, not pitch-shifted");
         a.sample_rate = TEST_RATE;
 
         /* The guard that stops a MUSIC path being RAM-loaded inside a tap. */
@@ -582,6 +660,261 @@ int main(void)
         close(fd);
     }
 
+    printf("\nJ. the CUE: the next bed opened early, and a chain with no gap\n");
+    {
+        fd = mk_audio(&a);
+        if (fd < 0) return 1;
+        /* ⚠️ Set here, not in mk_audio(): the toggles are what this group's
+         * refusals are about, and the groups above predate them. */
+        a.music_on = true;
+        write_bed_fixture(BED_FIXTURE, TEST_RATE);       /* 1 s   */
+        write_bed_fixture(CUE_FIXTURE, TEST_RATE / 2);   /* 0.5 s */
+        unlink(CUE_ABSENT);
+
+        check(audio_music_start(&a, BED_FIXTURE, true), "a looping bed starts");
+        check(!audio_music_cue(&a, CUE_ABSENT, true),
+              "a cue of a missing file is refused at CUE time, not at the boundary");
+        check(!a.music.chain && a.music.wav.loop,
+              "and leaves the live bed looping, unchained");
+
+        check(audio_music_cue(&a, CUE_FIXTURE, true), "a chained cue is accepted");
+        check(a.music.next.f != NULL && strcmp(a.music.next_path, CUE_FIXTURE) == 0,
+              "the cued file is OPEN before the boundary — no open is left for it");
+        check(a.music.chain && !a.music.wav.loop,
+              "and the bed's pass will END instead of wrapping");
+
+        /* Across the boundary: the first track's last frames and the cued one's
+         * first, rendered as one span.  A handoff a buffer late — or a voice that
+         * ended on the short fill — is a run of zeros in here. */
+        render_frames(&a, TEST_RATE - 3000);
+        int floor = render_floor(&a, 6000);
+        check(audio_music_handoffs(&a) == 1, "exactly one handoff happened");
+        check(a.music.wav.frames == TEST_RATE / 2,
+              "and the voice is now reading the CUED file");
+        check(a.music.next.loops == 0,
+              "the first track ended its pass — it did not wrap past the cue");
+        check(floor > 500, "ZERO frames of silence across the handoff");
+        check(audio_music_active(&a), "the same voice is still live");
+        check(a.music.next_path[0] == '\0',
+              "the retired file is parked, not mistaken for a cue");
+
+        render_frames(&a, TEST_RATE);                    /* two of its passes */
+        check(a.music.wav.loops >= 1 && audio_music_handoffs(&a) == 1,
+              "the chained track LOOPS on, and hands off nothing further");
+
+        /* Unchained: the game's own stop/start at a boundary takes the cue. */
+        check(audio_music_cue(&a, BED_FIXTURE, false), "an unchained cue is accepted");
+        check(a.music.wav.loop, "and does not touch the bed's loop");
+        audio_music_stop(&a);
+        render_frames(&a, TEST_RATE / 2);
+        check(!audio_music_active(&a), "the bed released");
+        check(audio_music_start(&a, BED_FIXTURE, true), "a start naming the cue plays");
+        check(a.music.next.f == NULL && a.music.wav.frames == TEST_RATE,
+              "by TAKING the cued file rather than opening another");
+        check(a.music.wav.loop, "with the start's own loop flag");
+
+        /* A start naming something else opens it and leaves the cue standing. */
+        check(audio_music_cue(&a, CUE_FIXTURE, false), "a second cue");
+        audio_music_stop(&a);
+        render_frames(&a, TEST_RATE / 2);
+        check(audio_music_start(&a, BED_FIXTURE, false), "a start of another path");
+        check(a.music.next.f != NULL && strcmp(a.music.next_path, CUE_FIXTURE) == 0,
+              "leaves the cue where it was");
+        check(audio_music_cue(&a, CUE_FIXTURE, true) && !a.music.chain,
+              "a chain over a NON-looping bed stands as a cue but does not chain");
+
+        /* A chain cued over a HELD bed: the resume must declare past this pass,
+         * because the cue cleared `loop` and the remainder alone ends the voice
+         * on the frame the handoff should have happened. */
+        audio_music_stop(&a);
+        render_frames(&a, TEST_RATE / 2);
+        check(audio_music_start(&a, BED_FIXTURE, true), "a looping bed again");
+        render_frames(&a, TEST_RATE / 4);
+        check(audio_music_pause(&a), "held");
+        check(audio_music_cue(&a, CUE_FIXTURE, true) && a.music.chain,
+              "a chain cued while it is held");
+        render_frames(&a, TEST_RATE / 2);
+        check(audio_music_resume(&a), "resumed");
+        render_frames(&a, TEST_RATE);
+        check(audio_music_handoffs(&a) == 2 && audio_music_active(&a),
+              "the resumed voice outlasts its pass INTO the cued track");
+
+        a.music_on = false;
+        check(!audio_music_cue(&a, CUE_FIXTURE, false), "the MUSIC toggle refuses a cue");
+        a.music_on = true;
+        close(fd);
+    }
+
+    printf("\nK. a bed at a FOREIGN rate streams through the voice's converter\n");
+    {
+        fd = mk_audio(&a);
+        if (fd < 0) return 1;
+        a.music_on = true;
+        a.sample_rate = TEST_RATE / 2;          /* the device "granted" 22050 */
+        write_bed_fixture(BED_FIXTURE, TEST_RATE);
+
+        check(audio_music_start(&a, BED_FIXTURE, false),
+              "a 44100 bed on a 22050 device starts — converted, not refused");
+        check(a.music.convert, "through the voice's converter");
+        check(audio_mix_voice_pending(&a.mix, a.music.slot, a.music.gen) == TEST_RATE / 2,
+              "declaring its length in DEVICE frames");
+
+        check(render_peak(&a, TEST_RATE / 8) > 2000, "and it SOUNDS at the bed's level");
+
+        /* The resume: the converter's window holds input already READ (so not
+         * in what is left of the file) and still to be played.  A declared
+         * total that forgot it ends the voice before the file's last frames. */
+        check(audio_music_pause(&a), "held mid-file");
+        render_frames(&a, TEST_RATE / 4);
+        long window = audio_rs_buffered(&a.music.rs);
+        long left   = a.music.wav.frames - a.music.wav.pos;
+        check(window > 0, "with input in the converter's window, read but unplayed");
+        check(audio_music_resume(&a), "and resumed");
+        long owed = audio_mix_voice_pending(&a.mix, a.music.slot, a.music.gen);
+        check(owed == audio_rs_frames_out(TEST_RATE, TEST_RATE / 2, left + window),
+              "declaring the file's remainder PLUS that window, in device frames");
+        render_frames(&a, owed);
+        check(!audio_music_active(&a), "it runs out exactly where it declared");
+        check(a.music.wav.pos == a.music.wav.frames && audio_rs_buffered(&a.music.rs) == 0,
+              "having played the file to its LAST frame, window included");
+
+        a.sample_rate = TEST_RATE / 5;
+        check(!audio_music_start(&a, BED_FIXTURE, true),
+              "a 5:1 bed is refused — past the converter, never pitch-shifted");
+        a.sample_rate = TEST_RATE;
+        close(fd);
+    }
+
+    printf("\nL. trigger-to-DAC latency: each trigger positioned and resolved once\n");
+    {
+        fd = mk_audio(&a);
+        if (fd < 0) return 1;
+        a.effects_on = true;
+        a.cont = audio_out_open(&a.out, &LAT_DEV, NULL, TEST_RATE, 2) == 0;
+        check(a.cont, "a stream opened behind a simulated device");
+        audio_out_set_fill(&a.out, audio_cont_fill_mix, &a, "mix bus");
+        long long w0 = audio_out_written(&a.out);
+        check(w0 > 0, "its prefill counts as frames the device took");
+
+        audio_tone(&a, 1000, 60);
+        audio_tone(&a, 500, 60);
+        check(audio_lat_pending(&a.lat) == 1,
+              "a two-note motif is ONE trigger — the chained note starts late on purpose");
+        check(a.lat.pend[0].pos == w0, "positioned at the next frame the device takes");
+
+        /* One service hands over a lead; the device reports all of it still
+         * queued, so the tone's first frame is the prefill's depth from the DAC. */
+        lat_dev_delay = (long)(w0 + audio_out_lead(&a.out));
+        audio_pump(&a);
+        AudioLatencyStats st;
+        audio_latency_stats(&a, &st);
+        uint32_t floor_us = (uint32_t)(w0 * 1000000 / TEST_RATE);
+        check(st.count == 1 && audio_lat_pending(&a.lat) == 0,
+              "resolved by the first service that handed its frame over");
+        check(st.min_us >= floor_us && st.min_us < floor_us + 20000,
+              "latency = the queue ahead of it, plus the call-to-service time");
+
+        /* A device that says it has played everything, a frame it cannot have
+         * played yet: under-reported, and recorded as 0 rather than wrapped. */
+        lat_dev_delay = 0;
+        gap_one_tap();                       /* a tap, not the motif's third note */
+        audio_tone(&a, 800, 30);
+        audio_pump(&a);
+        audio_latency_stats(&a, &st);
+        check(st.count == 2 && st.min_us == 0 && st.max_us < 1000000,
+              "an under-reported delay reads 0, never a wrapped 4295 s");
+
+        audio_latency_reset(&a);
+        audio_latency_stats(&a, &st);
+        check(st.count == 0 && st.max_us == 0, "a reset opens a fresh window");
+
+        audio_out_close(&a.out);
+        a.cont = false;
+        audio_tone(&a, 700, 30);
+        check(audio_lat_pending(&a.lat) == 0,
+              "off the stream nothing is positioned, so nothing is recorded");
+        close(fd);
+    }
+
+    printf("\nM. the shared effect bank: published once, mapped, and only while current\n");
+    {
+        write_bed_fixture(CLIP_FIXTURE, CLIP_FRAMES);
+        write_tail_fixture(CLIP_TAIL, CLIP_FRAMES);
+        const char *clips[AUDIO_FX_COUNT] = { CLIP_FIXTURE, NULL, NULL, CLIP_TAIL, CLIP_FIXTURE };
+        check(audio_fx_bank_publish(BANK_FIXTURE, TEST_RATE, clips) == 2,
+              "two distinct clips published — the repeated path is stored once");
+
+        fd = mk_audio(&a);
+        if (fd < 0) return 1;
+        a.effects_on = true;
+        audio_fx_set_path(&a, AUDIO_FX_BEEP, CLIP_FIXTURE);
+        audio_fx_set_path(&a, AUDIO_FX_FAIL, CLIP_TAIL);
+        check(audio_fx_bank_attach(&a, BANK_FIXTURE), "the bank maps");
+        check(a.fx[AUDIO_FX_BEEP].shared && a.fx[AUDIO_FX_BEEP].frames == CLIP_FRAMES,
+              "and a clip is READY before its first trigger, at its real length");
+        const uint8_t *p = (const uint8_t *)a.fx[AUDIO_FX_FAIL].pcm;
+        check(p >= a.fx_bank && p < a.fx_bank + a.fx_bank_bytes,
+              "its PCM is the mapping itself, not a private copy");
+
+        /* Content, for group I's reason: an entry aimed at the wrong offset
+         * still has the right length and plays without complaint. */
+        check(audio_fx_play(&a, AUDIO_FX_FAIL), "a mapped clip plays");
+        int head = render_peak(&a, (CLIP_FRAMES * 3) / 4 - 1024);
+        int tail = render_peak(&a, CLIP_FRAMES);
+        check(head < 400 && tail > 2000,
+              "and it is the RIGHT clip — silent head, loud tail, out of the bank");
+
+        /* A swap away from a mapped clip must not free() into the mapping. */
+        audio_fx_set_path(&a, AUDIO_FX_FAIL, CLIP_FIXTURE2);
+        write_bed_fixture(CLIP_FIXTURE2, CLIP_FRAMES / 2);
+        check(audio_fx_play(&a, AUDIO_FX_FAIL) && !a.fx[AUDIO_FX_FAIL].shared
+              && a.fx[AUDIO_FX_FAIL].frames == CLIP_FRAMES / 2,
+              "a path the bank does not hold loads privately, and the swap freed nothing");
+        close(fd);
+
+        /* The CACHE rule: an edited file is never served from the bank. */
+        write_bed_fixture(CLIP_FIXTURE, CLIP_FRAMES / 2);
+        fd = mk_audio(&a);
+        if (fd < 0) return 1;
+        a.effects_on = true;
+        audio_fx_set_path(&a, AUDIO_FX_BEEP, CLIP_FIXTURE);
+        audio_fx_set_path(&a, AUDIO_FX_FAIL, CLIP_TAIL);
+        audio_fx_bank_attach(&a, BANK_FIXTURE);
+        check(!a.fx[AUDIO_FX_BEEP].shared && !a.fx[AUDIO_FX_BEEP].tried,
+              "a clip whose file changed since publishing is NOT adopted");
+        check(a.fx[AUDIO_FX_FAIL].shared, "while an unchanged one beside it still is");
+        check(audio_fx_play(&a, AUDIO_FX_BEEP) && a.fx[AUDIO_FX_BEEP].frames == CLIP_FRAMES / 2,
+              "the changed one loads privately on its first trigger — the NEW content");
+        close(fd);
+
+        /* A bank at another rate is someone else's: nothing in it is adopted. */
+        fd = mk_audio(&a);
+        if (fd < 0) return 1;
+        a.sample_rate = TEST_RATE / 2;
+        audio_fx_set_path(&a, AUDIO_FX_FAIL, CLIP_TAIL);
+        check(audio_fx_bank_attach(&a, BANK_FIXTURE) && !a.fx[AUDIO_FX_FAIL].shared,
+              "a device granted another rate maps the bank but adopts nothing");
+        close(fd);
+
+        /* No bank is the normal case off the launcher, and a damaged one must
+         * be refused whole rather than half-believed. */
+        fd = mk_audio(&a);
+        if (fd < 0) return 1;
+        unlink(BANK_FIXTURE);
+        check(!audio_fx_bank_attach(&a, BANK_FIXTURE) && a.fx_bank == NULL,
+              "no bank: attach says no, and nothing is mapped");
+        FILE *f = fopen(BANK_FIXTURE, "wb");
+        if (f) {
+            static const char junk[4096] = "not a bank";
+            fwrite(junk, 1, sizeof(junk), f);
+            fclose(f);
+        }
+        check(!audio_fx_bank_attach(&a, BANK_FIXTURE) && a.fx_bank == NULL,
+              "a file that is not a bank is refused whole");
+        unlink(BANK_FIXTURE);
+        close(fd);
+    }
+
     printf("\n%s  %d checks, %d failure(s)\n",
            failures ? "FAILED" : "PASSED", checks, failures);
     return failures ? 1 : 0;
@@ -0,0 +1,268 @@
+/* Host-side regression for the alpha-blend kernels and alpha sprites.
+ *
+ * Runs on the DEV MACHINE with native gcc, not on the device — a synthetic
+ * Framebuffer over a malloc'd buffer, as in fb_span_test.c.
+ *
+ *   cd native_apps && gcc -Wall -Wextra -Wno-unused-parameter -I common \
+ *       -o build/fb_alpha_test tests/fb_alpha_test.c \
+ *       common/framebuffer.c common/hardware.c common/config.c \
+ *       common/touch_input.c -lm && ./build/fb_alpha_test
+ *
+ * What it asserts, and why:
+ *
+ *   1. fb_fill_rect_alpha() gives the SAME PIXELS as the old per-pixel
+ *      fb_draw_pixel_alpha() loop with its three real divisions by 255 —
+ *      copied verbatim below — for EVERY (source, destination, alpha)
+ *      channel triple, at both depths. The division trick is exact only over
+ *      a range; exhaustive is the only convincing proof that a blend never
+ *      leaves it. Rows are 256 wide, so on the device (build with
+ *      arm-linux-gnueabihf-gcc -mfpu=neon and run it there) the same sweep
+ *      exercises the NEON kernel and its scalar tail.
+ *   2. Clipping and the draw offset are honoured, as for every fill.
+ *   3. Alpha sprites: alpha 0 leaves the surface alone, alpha 255 is the
+ *      pixel, and in between the result is premultiplied src + dst*(1-a),
+ *      computed here with plain division — and within one step per channel
+ *      of the straight blend it replaces.
+ *
+ * NOT part of build-and-deploy.sh: that script cross-compiles for ARM and this
+ * is a host binary. Run it by hand after touching a blend.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "framebuffer.h"
+
+static int fails = 0;
+
+static void expect_true(const char *what, bool cond) {
+    if (!cond) { printf("  FAIL %-56s\n", what); fails++; }
+    else       { printf("  ok   %-56s\n", what); }
+}
+
+static Framebuffer fb;
+static uint8_t *got_buf, *want_buf;
+static size_t bytes;
+
+static void surface_init(int w, int h, int bytes_per_pixel) {
+    memset(&fb, 0, sizeof(fb));
+    fb.width  = (uint32_t)w;
+    fb.height = (uint32_t)h;
+    fb.bytes_per_pixel = (uint32_t)bytes_per_pixel;
+    fb.double_buffering = true;
+    bytes = (size_t)w * h * bytes_per_pixel;
+    free(got_buf);
+    free(want_buf);
+    got_buf  = (uint8_t *)malloc(bytes);
+    want_buf = (uint8_t *)malloc(bytes);
+    if (!got_buf || !want_buf) { printf("  FAIL out of memory\n"); exit(2); }
+    fb.back_buffer_size = bytes;
+}
+
+/* ── REFERENCE: fb_draw_pixel_alpha() before the kernels ─────────────────── */
+
+static uint32_t ref_unpack565(uint16_t v) {
+    uint32_t r = (v >> 11) & 0x1F, g = (v >> 5) & 0x3F, b = v & 0x1F;
+    r = (r << 3) | (r >> 2);
+    g = (g << 2) | (g >> 4);
+    b = (b << 3) | (b >> 2);
+    return (r << 16) | (g << 8) | b;
+}
+
+static uint16_t ref_pack565(uint32_t c) {
+    return (uint16_t)((((c >> 16) & 0xF8) << 8) |
+                      (((c >>  8) & 0xFC) << 3) |
+                      (( c        & 0xF8) >> 3));
+}
+
+static void ref_draw_pixel_alpha(Framebuffer *fb, int x, int y, uint32_t color, uint8_t alpha) {
+    x += fb->draw_offset_x;
+    y += fb->draw_offset_y;
+    if (x < 0 || x >= (int)fb->width || y < 0 || y >= (int)fb->height) return;
+    void *target = fb->back_buffer;
+    bool is16 = fb->bytes_per_pixel == 2;
+    size_t idx = (size_t)y * fb->width + x;
+    uint32_t dst = is16 ? ref_unpack565(((uint16_t *)target)[idx])
+                        : ((uint32_t *)target)[idx] & 0x00FFFFFF;
+    uint32_t sr = (color >> 16) & 0xFF, sg = (color >> 8) & 0xFF, sb = color & 0xFF;
+    uint32_t dr = (dst   >> 16) & 0xFF, dg = (dst   >> 8) & 0xFF, db = dst   & 0xFF;
+    uint32_t a = alpha, ia = 255 - alpha;
+    uint32_t r = (sr * a + dr * ia) / 255;
+    uint32_t g = (sg * a + dg * ia) / 255;
+    uint32_t b = (sb * a + db * ia) / 255;
+    uint32_t out = (r << 16) | (g << 8) | b;
+    if (is16) ((uint16_t *)target)[idx] = ref_pack565(out);
+    else      ((uint32_t *)target)[idx] = out;
+}
+
+/* ───────────────────────────────────────────────────────────────────────── */
+
+/* Row y of a 256 x 1 surface holds destination value d in every channel at
+ * x = d (at 16bpp, the nearest 565 value: the sweep still covers every
+ * reachable destination). */
+static void grey_ramp(uint8_t *buf, int bpp) {
+    for (int d = 0; d < 256; d++) {
+        uint32_t c = RGB(d, d, d);
+        if (bpp == 2) ((uint16_t *)buf)[d] = ref_pack565(c);
+        else          ((uint32_t *)buf)[d] = c;
+    }
+}
+
+static void exhaustive(int bpp) {
+    surface_init(256, 1, bpp);
+    bool ok = true;
+    for (int a = 0; a < 256 && ok; a++)
+        for (int s = 0; s < 256 && ok; s++) {
+            /* Different value per channel, so a swapped channel shows. */
+            uint32_t color = RGB(s, 255 - s, s ^ 0x5A);
+            grey_ramp(want_buf, bpp);
+            fb.back_buffer = (uint32_t *)want_buf;
+            for (int x = 0; x < 256; x++) ref_draw_pixel_alpha(&fb, x, 0, color, (uint8_t)a);
+            grey_ramp(got_buf, bpp);
+            fb.back_buffer = (uint32_t *)got_buf;
+            fb_fill_rect_alpha(&fb, 0, 0, 256, 1, color, (uint8_t)a);
+            if (memcmp(got_buf, want_buf, bytes) != 0) {
+                printf("  FAIL at src %d alpha %d\n", s, a);
+                ok = false;
+            }
+        }
+    expect_true("every src x dst x alpha matches the /255 loop", ok);
+}
+
+static void clipped(int bpp) {
+    static const int offsets[][2] = { {0, 0}, {3, -5}, {-17, 9} };
+    const int W = 41, H = 29;
+    surface_init(W, H, bpp);
+    bool ok = true;
+    for (unsigned o = 0; o < 3 && ok; o++) {
+        fb_set_draw_offset(&fb, offsets[o][0], offsets[o][1]);
+        for (int y = -12; y <= H + 2 && ok; y += 3)
+            for (int x = -14; x <= W + 2 && ok; x += 3) {
+                for (size_t i = 0; i < bytes; i++) want_buf[i] = got_buf[i] = (uint8_t)(i * 7);
+                fb.back_buffer = (uint32_t *)want_buf;
+                for (int j = 0; j < 11; j++)
+                    for (int i = 0; i < 13; i++)
+                        ref_draw_pixel_alpha(&fb, x + i, y + j, RGB(200, 40, 90), 77);
+                fb.back_buffer = (uint32_t *)got_buf;
+                fb_fill_rect_alpha(&fb, x, y, 13, 11, RGB(200, 40, 90), 77);
+                if (bpp == 4)   /* the old loop also cleared the top byte */
+                    for (size_t i = 3; i < bytes; i += 4) got_buf[i] = want_buf[i];
+                if (memcmp(got_buf, want_buf, bytes) != 0) {
+                    printf("  FAIL at (%d,%d) off (%d,%d)\n", x, y, offsets[o][0], offsets[o][1]);
+                    ok = false;
+                }
+            }
+        fb_clear_draw_offset(&fb);
+    }
+    expect_true("clipped at every edge, with a draw offset", ok);
+}
+
+/* ── Alpha sprites ──────────────────────────────────────────────────────── */
+
+#define SW 19
+#define SH 6
+
+static uint32_t art[SW * SH];
+
+static void art_init(void) {
+    for (int y = 0; y < SH; y++)
+        for (int x = 0; x < SW; x++) {
+            uint32_t a;
+            if (y == 0)      a = 0;                           /* invisible row */
+            else if (y == 1) a = 255;                         /* opaque row */
+            else if (y == 2) a = (uint32_t)(x * 255 / (SW - 1));  /* ramp 0..255 */
+            else             a = (uint32_t)((x * 37 + y * 91) & 0xFF);
+            art[y * SW + x] = (a << 24) | (uint32_t)RGB(x * 13, 255 - y * 40, (x * y * 7) & 0xFF);
+        }
+}
+
+/* Expected result of one visible sprite pixel over dst, 8-bit channels. */
+static uint32_t ref_over(uint32_t p, uint32_t dst) {
+    uint32_t a = p >> 24, ia = 255 - a, out = 0;
+    for (int sh = 0; sh <= 16; sh += 8) {
+        uint32_t s = (p >> sh) & 0xFF, d = (dst >> sh) & 0xFF;
+        out |= (s * a / 255 + d * ia / 255) << sh;
+    }
+    return out;
+}
+
+static uint32_t ref_straight(uint32_t p, uint32_t dst) {
+    uint32_t a = p >> 24, ia = 255 - a, out = 0;
+    for (int sh = 0; sh <= 16; sh += 8) {
+        uint32_t s = (p >> sh) & 0xFF, d = (dst >> sh) & 0xFF;
+        out |= ((s * a + d * ia) / 255) << sh;
+    }
+    return out;
+}
+
+static uint32_t pixel_at(const uint8_t *buf, int bpp, size_t idx) {
+    if (bpp == 2) return ref_unpack565(((const uint16_t *)buf)[idx]);
+    return ((const uint32_t *)buf)[idx] & 0x00FFFFFF;
+}
+
+static void alpha_sprites(int bpp) {
+    const int W = 33, H = 14;
+    surface_init(W, H, bpp);
+    FbSprite *spr = fb_sprite_compile_alpha(&fb, art, SW, 0, 0, SW, SH);
+    expect_true("fb_sprite_compile_alpha compiles", spr != NULL);
+    if (!spr) return;
+
+    bool ok = true, close = true;
+    for (int flip = 0; flip < 2; flip++)
+        for (int y = -SH; y <= H && ok; y++)
+            for (int x = -SW; x <= W && ok; x++) {
+                for (size_t i = 0; i < (size_t)W * H; i++) {
+                    uint32_t c = RGB((i * 5) & 0xFF, (i * 3) & 0xFF, (255 - i) & 0xFF);
+                    if (bpp == 2) ((uint16_t *)got_buf)[i] = ref_pack565(c);
+                    else          ((uint32_t *)got_buf)[i] = c;
+                }
+                memcpy(want_buf, got_buf, bytes);
+                fb.back_buffer = (uint32_t *)got_buf;
+                if (flip) fb_draw_sprite_flipped(&fb, spr, x, y);
+                else      fb_draw_sprite(&fb, spr, x, y);
+
+                for (int j = 0; j < SH; j++)
+                    for (int i = 0; i < SW; i++) {
+                        int px = x + (flip ? SW - 1 - i : i), py = y + j;
+                        if (px < 0 || px >= W || py < 0 || py >= H) continue;
+                        size_t idx = (size_t)py * W + px;
+                        uint32_t p = art[j * SW + i];
+                        if ((p >> 24) == 0) continue;     /* not drawn at all */
+                        uint32_t dst = pixel_at(want_buf, bpp, idx);
+                        uint32_t want = ref_over(p, dst);
+                        if ((p >> 24) == 255) want = p;   /* opaque: copied as is, top byte too */
+                        if (bpp == 2) ((uint16_t *)want_buf)[idx] = ref_pack565(want);
+                        else          ((uint32_t *)want_buf)[idx] = want;
+                        if (bpp == 4) {
+                            uint32_t st = ref_straight(p, dst), ov = want & 0x00FFFFFF;
+                            for (int sh = 0; sh <= 16; sh += 8) {
+                                int diff = (int)((st >> sh) & 0xFF) - (int)((ov >> sh) & 0xFF);
+                                if (diff < -1 || diff > 1) close = false;
+                            }
+                        }
+                    }
+                if (memcmp(got_buf, want_buf, bytes) != 0) {
+                    printf("  FAIL %s at (%d,%d)\n", flip ? "flipped" : "upright", x, y);
+                    ok = false;
+                }
+            }
+    expect_true("alpha sprite, upright and flipped, at every position", ok);
+    if (bpp == 4)
+        expect_true("premultiplied is within 1 of the straight blend", close);
+    fb_sprite_free(spr);
+}
+
+int main(void) {
+    art_init();
+    for (int bpp = 4; bpp >= 2; bpp -= 2) {
+        printf("%dbpp\n", bpp * 8);
+        exhaustive(bpp);
+        clipped(bpp);
+        alpha_sprites(bpp);
+        printf("\n");
+    }
+    free(got_buf);
+    free(want_buf);
+    printf("%s (%d failure%s)\n", fails ? "FAILED" : "PASSED",
+           fails, fails == 1 ? "" : "s");
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,212 @@
+/* Host-side regression for damage tracking and the partial fb_swap().
+ *
+ * Runs on the DEV MACHINE with native gcc, not on the device. fb_swap() only
+ * touches fb->buffer / line_length / phys_* / view_* besides the back buffer,
+ * so a synthetic Framebuffer with a malloc'd "panel" stands in for the mmap of
+ * /dev/fb0 — the same trick framebuffer_bpp_test.c plays with the back buffer.
+ *
+ *   cd native_apps && gcc -Wall -Wextra -Wno-unused-parameter -I common \
+ *       -o build/fb_damage_test tests/fb_damage_test.c \
+ *       common/framebuffer.c common/hardware.c common/config.c \
+ *       common/touch_input.c -lm && ./build/fb_damage_test
+ *
+ * What it asserts, and why. A partial swap has exactly two ways to be wrong:
+ *
+ *   1. it MISSES a pixel a primitive wrote — the panel shows a stale frame
+ *      under the new one. Caught by comparing the panel after a damage-tracked
+ *      swap against a second panel that got a FULL swap of the same frame.
+ *   2. it copies MORE than it was told — correct on screen, and silently no
+ *      faster than before. Caught by poisoning the panel before the partial
+ *      swap: a poisoned pixel that survives was not copied, and must be
+ *      outside every primitive drawn that frame.
+ *
+ * Both run in landscape with a bezel, and in portrait, at both depths — the
+ * rectangle present goes through the same rotation code as the full one, and
+ * a rectangle path that only works at (0,0) would pass a test without a bezel.
+ *
+ * NOT part of build-and-deploy.sh: that script cross-compiles for ARM and this
+ * is a host binary. Run it by hand after touching fb_swap() or the damage list.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "framebuffer.h"
+
+static int fails = 0;
+
+static void expect_true(const char *what, bool cond) {
+    if (!cond) { printf("  FAIL %-52s\n", what); fails++; }
+    else       { printf("  ok   %-52s\n", what); }
+}
+
+#define PW 64              /* panel, landscape physical */
+#define PH 40
+#define BEZEL_T 3
+#define BEZEL_B 2
+#define BEZEL_L 4
+#define BEZEL_R 1
+#define POISON 0xA5
+
+static Framebuffer fb;
+static uint8_t *panel, *ref_panel;
+static size_t panel_bytes;
+
+/* Build a synthetic fb the way fb_init() + fb_apply_viewport() would. */
+static void surface_init(int bpp, bool portrait) {
+    free(fb.back_buffer);
+    free(panel);
+    free(ref_panel);
+    memset(&fb, 0, sizeof(fb));
+    fb.fd = -1;
+    fb.bytes_per_pixel = (uint32_t)bpp;
+    fb.phys_width  = PW;
+    fb.phys_height = PH;
+    fb.portrait_mode = portrait;
+    fb.line_length = (PW + 3) * bpp;         /* padded stride, as on the panel */
+    fb.screen_size = (size_t)fb.line_length * PH;
+    int panel_w = portrait ? PH : PW, panel_h = portrait ? PW : PH;
+    fb.view_x = BEZEL_L;
+    fb.view_y = BEZEL_T;
+    fb.width  = (uint32_t)(panel_w - BEZEL_L - BEZEL_R);
+    fb.height = (uint32_t)(panel_h - BEZEL_T - BEZEL_B);
+    fb.back_buffer_size = (size_t)fb.width * fb.height * bpp;
+    fb.back_buffer = (uint32_t *)calloc(1, fb.back_buffer_size);
+    fb.double_buffering = true;
+    fb.damage_full = true;
+    panel_bytes = fb.screen_size;
+    panel     = (uint8_t *)calloc(1, panel_bytes);
+    ref_panel = (uint8_t *)calloc(1, panel_bytes);
+    fb.buffer = (uint32_t *)panel;
+    if (!fb.back_buffer || !panel || !ref_panel) { printf("  FAIL out of memory\n"); exit(2); }
+}
+
+/* A full swap of the current back buffer into ref_panel, leaving fb as it was. */
+static void reference_swap(void) {
+    Framebuffer saved = fb;
+    fb.buffer = (uint32_t *)ref_panel;
+    fb.damage_tracking = false;
+    fb_swap(&fb);
+    fb = saved;
+}
+
+static size_t poison_survivors(void) {
+    size_t n = 0;
+    for (size_t i = 0; i < panel_bytes; i++) if (panel[i] == POISON) n++;
+    return n;
+}
+
+static const uint32_t C_BG = RGB(5, 10, 15);
+
+static void run(int bpp, bool portrait) {
+    printf("%dbpp %s\n", bpp * 8, portrait ? "portrait" : "landscape, bezel");
+    surface_init(bpp, portrait);
+    fb_set_damage_tracking(&fb, true);
+    fb_clear(&fb, C_BG);
+    expect_true("fb_clear marks the whole surface", fb.damage_full);
+    fb_swap(&fb);
+    reference_swap();
+    expect_true("the first tracked swap is a full one",
+                memcmp(panel, ref_panel, panel_bytes) == 0);
+    expect_true("and leaves nothing pending", !fb.damage_full && fb.damage_count == 0);
+
+    /* A small frame: a score digit, a dot, a blit, an offset rect. */
+    static uint32_t sprite[6 * 5];
+    for (int i = 0; i < 6 * 5; i++) sprite[i] = RGB(200, 10 * i, 90);
+    fb_draw_text(&fb, 2, 2, "7", RGB(255, 255, 0), 1);
+    fb_draw_pixel(&fb, (int)fb.width - 1, (int)fb.height - 1, RGB(1, 2, 3));
+    fb_blit_sprite(&fb, sprite, 6, 0, 0, 10, 12, 6, 5, 0xFFFFFFFF);
+    fb_set_draw_offset(&fb, 3, -2);
+    fb_fill_rect(&fb, 20, 8, 5, 4, RGB(0, 255, 0));
+    fb_clear_draw_offset(&fb);
+    expect_true("a small frame is tracked as rectangles",
+                !fb.damage_full && fb.damage_count > 0);
+
+    memset(panel, POISON, panel_bytes);
+    reference_swap();
+    fb_swap(&fb);
+
+    /* 1: every pixel the reference wrote INSIDE a damage rect must match; the
+     * strongest form is that un-poisoned bytes all equal the reference. */
+    bool matched = true;
+    for (size_t i = 0; i < panel_bytes; i++)
+        if (panel[i] != POISON && panel[i] != ref_panel[i]) { matched = false; break; }
+    expect_true("every byte the partial swap wrote matches a full swap", matched);
+
+    /* And every pixel that CHANGED this frame was written. */
+    surface_init(bpp, portrait);   /* fresh: reproduce, then compare whole panels */
+    fb_set_damage_tracking(&fb, true);
+    fb_clear(&fb, C_BG);
+    fb_swap(&fb);
+    fb_draw_text(&fb, 2, 2, "7", RGB(255, 255, 0), 1);
+    fb_draw_pixel(&fb, (int)fb.width - 1, (int)fb.height - 1, RGB(1, 2, 3));
+    fb_blit_sprite(&fb, sprite, 6, 0, 0, 10, 12, 6, 5, 0xFFFFFFFF);
+    fb_set_draw_offset(&fb, 3, -2);
+    fb_fill_rect(&fb, 20, 8, 5, 4, RGB(0, 255, 0));
+    fb_clear_draw_offset(&fb);
+    fb_draw_line(&fb, 30, 2, 34, 9, RGB(9, 9, 9));
+    fb_fill_rect_alpha(&fb, 5, 20, 3, 3, RGB(255, 255, 255), 100);
+    fb_swap(&fb);
+    reference_swap();
+    expect_true("no changed pixel is missed (panel == full swap)",
+                memcmp(panel, ref_panel, panel_bytes) == 0);
+
+    /* 2: it copied only what was drawn. */
+    fb_draw_pixel(&fb, 1, 1, RGB(7, 7, 7));
+    memset(panel, POISON, panel_bytes);
+    fb_swap(&fb);
+    expect_true("a one-pixel frame copies one pixel",
+                poison_survivors() == panel_bytes - (size_t)bpp);
+
+    /* Past the threshold it falls back to a full copy. */
+    fb_fill_rect(&fb, 0, 0, (int)fb.width, (int)fb.height * 3 / 4, RGB(1, 1, 1));
+    memset(panel, POISON, panel_bytes);
+    fb_swap(&fb);
+    reference_swap();
+    /* A full copy writes the logical rectangle; the bezel bands and the stride
+     * padding are never written by any swap, so compare only non-poison. */
+    size_t logical = (size_t)fb.width * fb.height * bpp;
+    expect_true("past FB_DAMAGE_FULL_PERCENT the whole surface is copied",
+                panel_bytes - poison_survivors() == logical);
+
+    /* Overflow of the list merges rather than drops. The bezel bands are still
+     * poisoned from the check above; no swap ever writes them. */
+    memcpy(panel, ref_panel, panel_bytes);
+    for (int i = 0; i < FB_DAMAGE_MAX * 3; i++)
+        fb_draw_pixel(&fb, (i * 7) % (int)fb.width, (i * 5) % (int)fb.height,
+                      RGB(i, 3, 3));    /* no channel can equal POISON */
+    expect_true("the damage list never exceeds FB_DAMAGE_MAX",
+                fb.damage_count <= FB_DAMAGE_MAX);
+    fb_swap(&fb);
+    reference_swap();
+    expect_true("and nothing drawn past the cap is lost",
+                memcmp(panel, ref_panel, panel_bytes) == 0);
+
+    /* The rectangles are kept disjoint. */
+    fb_fill_rect(&fb, 2, 2, 6, 6, RGB(1, 2, 3));
+    fb_fill_rect(&fb, 5, 5, 6, 6, RGB(1, 2, 3));
+    expect_true("two overlapping fills merge into one rectangle",
+                fb.damage_count == 1 && fb.damage[0].x == 2 && fb.damage[0].w == 9);
+    fb_swap(&fb);
+
+    /* Off by default: untracked swaps behave exactly as before. */
+    fb_set_damage_tracking(&fb, false);
+    fb_draw_pixel(&fb, 1, 1, RGB(9, 9, 9));
+    memset(panel, POISON, panel_bytes);
+    fb_swap(&fb);
+    expect_true("with tracking off every swap is a full copy",
+                panel_bytes - poison_survivors() == logical);
+    printf("\n");
+}
+
+int main(void) {
+    run(4, false);
+    run(2, false);
+    run(4, true);
+    run(2, true);
+    free(fb.back_buffer);
+    free(panel);
+    free(ref_panel);
+    printf("%s (%d failure%s)\n", fails ? "FAILED" : "PASSED",
+           fails, fails == 1 ? "" : "s");
+    return fails ? 1 : 0;
+}
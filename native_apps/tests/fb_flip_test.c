@@ -0,0 +1,252 @@
+/* Host-side regression for page flipping (fb_request_page_flip).
+ *
+ * Runs on the DEV MACHINE with native gcc, not on the device. Unlike the other
+ * framebuffer tests this one drives the REAL fb_init()/fb_swap()/fb_close():
+ * the "device" is a temp file, which mmap()s like /dev/fb0 does, and ioctl() is
+ * defined below, so the executable's definition wins over libc's for every call
+ * framebuffer.c makes. That fake is a tiny fbdev: it reports a panel, grants or
+ * refuses a double-height virtual screen, and records every pan and vsync wait.
+ *
+ *   cd native_apps && gcc -Wall -Wextra -Wno-unused-parameter -I common \
+ *       -o build/fb_flip_test tests/fb_flip_test.c \
+ *       common/framebuffer.c common/hardware.c common/config.c \
+ *       common/touch_input.c -lm && ./build/fb_flip_test
+ *
+ * What it asserts, and why: the whole point of flipping is that fb_swap()
+ * COPIES NOTHING, so the flip cases check that the page on screen is untouched
+ * by a swap and the pan went to the page that was drawn. Every fallback — a
+ * driver that refuses the virtual size, memory that does not hold two pages, a
+ * pan that fails at runtime — must still put the frame on screen, because the
+ * alternative is a black panel with no message — and a fallback after the
+ * driver took the double height must put the old height back, or the next app
+ * inherits it. And fb_close() must leave page 0 on screen, because the next
+ * app maps one page and draws into page 0.
+ *
+ * Uses the defaults for the bezel (no /etc/touch_calibration.conf on a dev
+ * machine): 15 px top and bottom, none left/right, which is the geometry that
+ * qualifies for flipping.
+ *
+ * NOT part of build-and-deploy.sh: that script cross-compiles for ARM and this
+ * is a host binary. Run it by hand after touching fb_init(), fb_swap() or
+ * fb_close().
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/fb.h>
+#include "framebuffer.h"
+
+static int fails = 0;
+
+static void expect_true(const char *what, bool cond) {
+    if (!cond) { printf("  FAIL %-56s\n", what); fails++; }
+    else       { printf("  ok   %-56s\n", what); }
+}
+
+/* ── The fake fbdev ─────────────────────────────────────────────────────── */
+
+#define XRES 64
+#define YRES 80
+#define BPP  4
+#define PAGE ((size_t)XRES * YRES * BPP)
+
+static struct {
+    bool grant_virtual;      /* FBIOPUT_VSCREENINFO takes yres_virtual = 2*yres */
+    bool pan_ok;
+    uint32_t smem_len;
+    uint32_t yres_virtual;
+    uint32_t yoffset;
+    int pans;
+    int vsyncs;
+} dev;
+
+int ioctl(int fd, unsigned long request, ...) {
+    va_list ap;
+    va_start(ap, request);
+    void *arg = va_arg(ap, void *);
+    va_end(ap);
+
+    if (request == FBIOGET_FSCREENINFO) {
+        struct fb_fix_screeninfo *f = (struct fb_fix_screeninfo *)arg;
+        memset(f, 0, sizeof(*f));
+        f->line_length = XRES * BPP;
+        f->smem_len = dev.smem_len;
+        return 0;
+    }
+    if (request == FBIOGET_VSCREENINFO) {
+        struct fb_var_screeninfo *v = (struct fb_var_screeninfo *)arg;
+        memset(v, 0, sizeof(*v));
+        v->xres = v->xres_virtual = XRES;
+        v->yres = YRES;
+        v->yres_virtual = dev.yres_virtual;
+        v->yoffset = dev.yoffset;
+        v->bits_per_pixel = BPP * 8;
+        return 0;
+    }
+    if (request == FBIOPUT_VSCREENINFO) {
+        const struct fb_var_screeninfo *v = (const struct fb_var_screeninfo *)arg;
+        if (v->yres_virtual > YRES && !dev.grant_virtual) return 0;  /* silently keeps it */
+        dev.yres_virtual = v->yres_virtual;
+        return 0;
+    }
+    if (request == FBIOPAN_DISPLAY) {
+        const struct fb_var_screeninfo *v = (const struct fb_var_screeninfo *)arg;
+        if (!dev.pan_ok || v->yoffset + YRES > dev.yres_virtual) { errno = EINVAL; return -1; }
+        dev.yoffset = v->yoffset;
+        dev.pans++;
+        return 0;
+    }
+    if (request == FBIO_WAITFORVSYNC) {
+        dev.vsyncs++;
+        return 0;
+    }
+    errno = ENOTTY;
+    return -1;
+}
+
+/* ── Helpers ─────────────────────────────────────────────────────────────── */
+
+static char dev_path[64];
+static Framebuffer fb;
+
+static void device_reset(bool grant, bool pan_ok, uint32_t smem_pages) {
+    memset(&dev, 0, sizeof(dev));
+    dev.grant_virtual = grant;
+    dev.pan_ok = pan_ok;
+    dev.smem_len = (uint32_t)(PAGE * smem_pages);
+    dev.yres_virtual = YRES;
+    strcpy(dev_path, "/tmp/fb_flip_test.XXXXXX");
+    int fd = mkstemp(dev_path);
+    if (fd < 0 || ftruncate(fd, (off_t)(2 * PAGE)) != 0) {
+        printf("  FAIL cannot create the fake device\n");
+        exit(2);
+    }
+    close(fd);
+}
+
+static void device_done(void) {
+    unlink(dev_path);
+}
+
+static uint32_t page_pixel(int page, int x, int y) {
+    const uint8_t *p = (const uint8_t *)fb.map + (size_t)page * PAGE;
+    return ((const uint32_t *)p)[(size_t)y * XRES + x] & 0x00FFFFFF;
+}
+
+/* Logical (x, y) is panel (x, y + view_y) in landscape with no side bezel. */
+static uint32_t shown_pixel(int x, int y) {
+    return page_pixel((int)(dev.yoffset / YRES), x, y + fb.view_y);
+}
+
+static const uint32_t C_A = RGB(200, 100, 50);
+static const uint32_t C_B = RGB(10, 250, 90);
+
+/* ── Cases ──────────────────────────────────────────────────────────────── */
+
+static void flip_granted(bool vsync) {
+    printf("flip granted%s\n", vsync ? ", vsync" : "");
+    device_reset(true, true, 2);
+    fb_request_page_flip(true, vsync);
+    expect_true("fb_init succeeds", fb_init(&fb, dev_path) == 0);
+    expect_true("page flipping is on", fb.page_flip);
+    expect_true("the back buffer is the hidden page, offset by the bezel",
+                (uint8_t *)fb.back_buffer ==
+                (uint8_t *)fb.map + PAGE + (size_t)fb.view_y * XRES * BPP);
+
+    fb_clear(&fb, 0);
+    fb_draw_pixel(&fb, 3, 4, C_A);
+    uint32_t page0_before = page_pixel(0, 3, 4 + fb.view_y);
+    fb_swap(&fb);
+    expect_true("the swap panned to page 1", dev.yoffset == YRES && dev.pans == 1);
+    expect_true("page 0 was not written by the swap", page_pixel(0, 3, 4 + fb.view_y) == page0_before);
+    expect_true("the frame is on screen", shown_pixel(3, 4) == C_A);
+    expect_true("the next frame draws into page 0",
+                (uint8_t *)fb.back_buffer ==
+                (uint8_t *)fb.map + (size_t)fb.view_y * XRES * BPP);
+
+    fb_clear(&fb, 0);
+    fb_draw_pixel(&fb, 5, 6, C_B);
+    fb_swap(&fb);
+    expect_true("the second swap panned back to page 0", dev.yoffset == 0 && dev.pans == 2);
+    expect_true("and shows the second frame", shown_pixel(5, 6) == C_B && shown_pixel(3, 4) == 0);
+    expect_true(vsync ? "each swap waited for vsync" : "no vsync wait unless asked",
+                dev.vsyncs == (vsync ? 2 : 0));
+
+    /* Leave page 1 on screen, then close: page 0 must end up showing it. */
+    fb_clear(&fb, 0);
+    fb_draw_pixel(&fb, 7, 1, C_A);
+    fb_swap(&fb);
+    fb_close(&fb);
+    expect_true("fb_close pans back to page 0", dev.yoffset == 0);
+    fb.map = NULL;
+    device_done();
+}
+
+static void refused(const char *what, bool grant, uint32_t smem_pages) {
+    printf("%s\n", what);
+    device_reset(grant, true, smem_pages);
+    fb_request_page_flip(true, false);
+    expect_true("fb_init still succeeds", fb_init(&fb, dev_path) == 0);
+    expect_true("and falls back to the copying swap", !fb.page_flip);
+    expect_true("leaving the panel one page tall for the next app",
+                dev.yres_virtual == YRES);
+    fb_clear(&fb, 0);
+    fb_draw_pixel(&fb, 2, 2, C_A);
+    fb_swap(&fb);
+    expect_true("the frame still reaches the panel", shown_pixel(2, 2) == C_A);
+    expect_true("without any pan", dev.pans == 0);
+    fb_close(&fb);
+    device_done();
+}
+
+static void pan_fails_at_runtime(void) {
+    printf("pan fails after the virtual size was granted\n");
+    device_reset(true, false, 2);
+    fb_request_page_flip(true, false);
+    expect_true("fb_init succeeds and flips", fb_init(&fb, dev_path) == 0 && fb.page_flip);
+    fb_clear(&fb, 0);
+    fb_draw_pixel(&fb, 4, 4, C_B);
+    fb_swap(&fb);
+    expect_true("the failed pan still shows the frame", shown_pixel(4, 4) == C_B);
+    expect_true("and flipping is off from then on", !fb.page_flip);
+    fb_draw_pixel(&fb, 6, 6, C_A);
+    fb_swap(&fb);
+    expect_true("later swaps copy, on top of the kept frame",
+                shown_pixel(6, 6) == C_A && shown_pixel(4, 4) == C_B);
+    fb_close(&fb);
+    device_done();
+}
+
+static void stale_offset(void) {
+    printf("a previous app died panned to page 1\n");
+    device_reset(true, true, 2);
+    dev.yres_virtual = 2 * YRES;
+    dev.yoffset = YRES;
+    fb_request_page_flip(false, false);
+    expect_true("fb_init succeeds", fb_init(&fb, dev_path) == 0);
+    expect_true("and pans back to the top", dev.yoffset == 0);
+    fb_close(&fb);
+    device_done();
+}
+
+int main(void) {
+    flip_granted(false);
+    printf("\n");
+    flip_granted(true);
+    printf("\n");
+    refused("driver keeps yres_virtual", false, 2);
+    printf("\n");
+    refused("driver grants it but has one page of memory", true, 1);
+    printf("\n");
+    pan_fails_at_runtime();
+    printf("\n");
+    stale_offset();
+
+    printf("\n%s (%d failure%s)\n", fails ? "FAILED" : "PASSED",
+           fails, fails == 1 ? "" : "s");
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,152 @@
+/* Host-side regression for the tiled portrait rotation in fb_swap().
+ *
+ * Runs on the DEV MACHINE with native gcc, not on the device. Same synthetic
+ * Framebuffer as fb_damage_test.c: a malloc'd "panel" with a padded stride
+ * stands in for the mmap of /dev/fb0, in portrait, with a bezel on every side.
+ *
+ *   cd native_apps && gcc -Wall -Wextra -Wno-unused-parameter -I common \
+ *       -o build/fb_rotate_test tests/fb_rotate_test.c \
+ *       common/framebuffer.c common/hardware.c common/config.c \
+ *       common/touch_input.c -lm && ./build/fb_rotate_test
+ *
+ * What it asserts: the panel after fb_swap() is byte-identical to the panel the
+ * old per-pixel loop (copied verbatim below as reference_rotate) produces from
+ * the same back buffer — at both depths, for surfaces whose sides are and are
+ * not multiples of the 8x8 tile, and for damage rectangles that start off the
+ * tile grid, are thinner than a tile, or straddle one. The panel is poisoned
+ * first, so a tile that writes a byte the reference never writes (a stray run
+ * into the bezel or the stride padding) fails as surely as one that misses.
+ *
+ * A host build exercises the scalar tile; the NEON tile is the same walk with a
+ * different 8x8 transpose, so build this for the device (arm-linux-gnueabihf-gcc
+ * -mfpu=neon, run on the unit) after touching fb_rot_tile16/32.
+ *
+ * NOT part of build-and-deploy.sh: that script cross-compiles for ARM and this
+ * is a host binary. Run it by hand after touching the portrait swap.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "framebuffer.h"
+
+static int fails = 0;
+
+static void expect_true(const char *what, bool cond) {
+    if (!cond) { printf("  FAIL %-52s\n", what); fails++; }
+    else       { printf("  ok   %-52s\n", what); }
+}
+
+#define POISON 0xA5
+
+static Framebuffer fb;
+static uint8_t *panel, *ref_panel;
+static size_t panel_bytes;
+
+/* The portrait loop from fb_swap() before tiling, verbatim but for the rect. */
+static void reference_rotate(Framebuffer *f, uint8_t *dst, int x, int y, int w, int h) {
+    const uint32_t bpp = f->bytes_per_pixel;
+    const uint8_t *src = (const uint8_t *)f->back_buffer;
+    const bool is16 = (f->bytes_per_pixel == 2);
+    uint32_t lw = f->width;
+    uint32_t ph_minus_1 = f->phys_height - 1;
+
+    for (int ly = y; ly < y + h; ly++) {
+        const uint8_t *src_row = src + (size_t)ly * lw * bpp;
+        uint32_t px = ly + f->view_y;
+        for (int lx = x; lx < x + w; lx++) {
+            uint32_t py = ph_minus_1 - (lx + f->view_x);
+            uint8_t *d = dst + (size_t)py * f->line_length + (size_t)px * bpp;
+            if (is16) *(uint16_t *)d = ((const uint16_t *)src_row)[lx];
+            else      *(uint32_t *)d = ((const uint32_t *)src_row)[lx];
+        }
+    }
+}
+
+/* A portrait panel of pw x ph (landscape physical) with the given bezel. */
+static void surface_init(int bpp, int pw, int ph, int top, int bottom, int left, int right) {
+    free(fb.back_buffer);
+    free(panel);
+    free(ref_panel);
+    memset(&fb, 0, sizeof(fb));
+    fb.fd = -1;
+    fb.bytes_per_pixel = (uint32_t)bpp;
+    fb.phys_width  = (uint32_t)pw;
+    fb.phys_height = (uint32_t)ph;
+    fb.portrait_mode = true;
+    fb.line_length = (uint32_t)((pw + 5) * bpp);   /* padded stride */
+    fb.screen_size = (size_t)fb.line_length * ph;
+    fb.view_x = (uint32_t)left;
+    fb.view_y = (uint32_t)top;
+    fb.width  = (uint32_t)(ph - left - right);     /* portrait: logical w = panel h */
+    fb.height = (uint32_t)(pw - top - bottom);
+    fb.back_buffer_size = (size_t)fb.width * fb.height * bpp;
+    fb.back_buffer = (uint32_t *)malloc(fb.back_buffer_size);
+    fb.double_buffering = true;
+    panel_bytes = fb.screen_size;
+    panel     = (uint8_t *)malloc(panel_bytes);
+    ref_panel = (uint8_t *)malloc(panel_bytes);
+    if (!fb.back_buffer || !panel || !ref_panel) { printf("  FAIL out of memory\n"); exit(2); }
+    fb.buffer = (uint32_t *)panel;
+
+    /* Every pixel distinct (mod the depth), no byte equal to POISON. */
+    for (size_t i = 0; i < (size_t)fb.width * fb.height; i++) {
+        uint32_t v = (uint32_t)(i * 2654435761u) & 0x00FFFFFF;
+        uint8_t b[4];
+        memcpy(b, &v, 4);
+        for (int k = 0; k < 4; k++) if (b[k] == POISON) b[k] ^= 1;
+        memcpy(&v, b, 4);
+        if (bpp == 2) ((uint16_t *)fb.back_buffer)[i] = (uint16_t)v;
+        else          fb.back_buffer[i] = v;
+    }
+}
+
+static void full_frame(const char *what, int bpp, int pw, int ph,
+                       int top, int bottom, int left, int right) {
+    surface_init(bpp, pw, ph, top, bottom, left, right);
+    memset(panel, POISON, panel_bytes);
+    memset(ref_panel, POISON, panel_bytes);
+    fb_swap(&fb);
+    reference_rotate(&fb, ref_panel, 0, 0, (int)fb.width, (int)fb.height);
+    expect_true(what, memcmp(panel, ref_panel, panel_bytes) == 0);
+}
+
+static void partial(const char *what, int x, int y, int w, int h) {
+    memset(panel, POISON, panel_bytes);
+    memset(ref_panel, POISON, panel_bytes);
+    fb_set_damage_tracking(&fb, true);
+    fb.damage_full = false;
+    fb.damage_count = 0;
+    fb_mark_dirty(&fb, x, y, w, h);
+    fb_swap(&fb);
+    fb_set_damage_tracking(&fb, false);
+    reference_rotate(&fb, ref_panel, x, y, w, h);
+    expect_true(what, memcmp(panel, ref_panel, panel_bytes) == 0);
+}
+
+static void run(int bpp) {
+    printf("%dbpp portrait\n", bpp * 8);
+    full_frame("whole tiles, no bezel", bpp, 64, 48, 0, 0, 0, 0);
+    full_frame("ragged edges, bezel on every side", bpp, 77, 53, 3, 2, 5, 1);
+    full_frame("thinner than one tile", bpp, 12, 9, 2, 3, 1, 2);
+    full_frame("the device geometry (800x480, 15px bezel)", bpp, 800, 480, 15, 15, 0, 0);
+
+    surface_init(bpp, 77, 53, 3, 2, 5, 1);
+    partial("a rectangle off the tile grid", 3, 5, 19, 13);
+    partial("a rectangle exactly one tile", 8, 16, 8, 8);
+    partial("a one-pixel rectangle", 11, 7, 1, 1);
+    partial("a rectangle thinner than a tile", 2, 1, 30, 3);
+    partial("a column thinner than a tile", 40, 0, 5, 60);
+    partial("the bottom-right corner", (int)fb.width - 9, (int)fb.height - 10, 9, 10);
+    printf("\n");
+}
+
+int main(void) {
+    run(4);
+    run(2);
+    free(fb.back_buffer);
+    free(panel);
+    free(ref_panel);
+    printf("%s (%d failure%s)\n", fails ? "FAILED" : "PASSED",
+           fails, fails == 1 ? "" : "s");
+    return fails ? 1 : 0;
+}
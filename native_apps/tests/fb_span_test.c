@@ -0,0 +1,277 @@
+/* Host-side regression for the framebuffer's span layer.
+ *
+ * Runs on the DEV MACHINE with native gcc, not on the device — the pattern
+ * gradient_test.c and framebuffer_bpp_test.c established: a synthetic
+ * Framebuffer over a malloc'd buffer exercises the real primitives with no
+ * /dev/fb0 in the loop.
+ *
+ *   cd native_apps && gcc -Wall -Wextra -Wno-unused-parameter -I common \
+ *       -o build/fb_span_test tests/fb_span_test.c \
+ *       common/framebuffer.c common/hardware.c common/config.c \
+ *       common/touch_input.c -lm && ./build/fb_span_test
+ *
+ * What it asserts, and why: fb_fill_rect, fb_fill_rect_gradient,
+ * fb_fill_circle and fb_fill_rounded_rect were rebuilt from per-pixel
+ * fb_draw_pixel() loops onto clip-once row spans. That is a pure speed change,
+ * so the only acceptable result is the SAME PIXELS. The REFERENCE below is the
+ * old per-pixel code, transcribed verbatim from framebuffer.c as of 2026-08-21,
+ * and every case draws the same primitive through both onto two surfaces and
+ * compares them word for word — at both depths, with and without a draw
+ * offset, and with shapes hanging off every edge, because clipping is where a
+ * span rewrite goes wrong.
+ *
+ * The rounded rectangle gets the widest sweep: the old one was SEVEN
+ * primitives overdrawing each other, and the union of their coverage is what
+ * the single run per row has to reproduce, including the even-h r == h/2 case
+ * where the two corner-centre rows cross. See clamp_reference_to_box() for
+ * the one pixel the old version drew outside its own box and the new one does
+ * not.
+ *
+ * NOT part of build-and-deploy.sh: that script cross-compiles for ARM and this
+ * is a host binary. Run it by hand after touching a fill primitive.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "framebuffer.h"
+
+static int fails = 0;
+static int cases = 0;
+
+#define W 64
+#define H 40
+
+static Framebuffer fb;
+static uint8_t *got_buf, *want_buf;
+static size_t bytes;
+
+static void surface_init(int bytes_per_pixel) {
+    memset(&fb, 0, sizeof(fb));
+    fb.width  = W;
+    fb.height = H;
+    fb.bytes_per_pixel = (uint32_t)bytes_per_pixel;
+    fb.double_buffering = true;
+    bytes = (size_t)W * H * bytes_per_pixel;
+    free(got_buf);
+    free(want_buf);
+    got_buf  = (uint8_t *)malloc(bytes);
+    want_buf = (uint8_t *)malloc(bytes);
+    if (!got_buf || !want_buf) { printf("  FAIL out of memory\n"); exit(2); }
+    fb.back_buffer_size = bytes;
+}
+
+/* ── The reference: the pre-span primitives, verbatim ─────────────────────── */
+
+static void ref_fill_rect(Framebuffer *fb, int x, int y, int w, int h, uint32_t color) {
+    x += fb->draw_offset_x;
+    y += fb->draw_offset_y;
+    for (int j = 0; j < h; j++) {
+        for (int i = 0; i < w; i++) {
+            fb_draw_pixel(fb, x + i, y + j, color);
+        }
+    }
+}
+
+static void ref_fill_circle(Framebuffer *fb, int cx, int cy, int radius, uint32_t color) {
+    cx += fb->draw_offset_x;
+    cy += fb->draw_offset_y;
+    for (int y = -radius; y <= radius; y++) {
+        for (int x = -radius; x <= radius; x++) {
+            if (x*x + y*y <= radius*radius) {
+                fb_draw_pixel(fb, cx + x, cy + y, color);
+            }
+        }
+    }
+}
+
+static void ref_fill_rounded_rect(Framebuffer *fb, int x, int y, int w, int h, int r, uint32_t color) {
+    if (r < 0) r = 0;
+    if (r > w / 2) r = w / 2;
+    if (r > h / 2) r = h / 2;
+    ref_fill_rect(fb, x + r, y, w - 2 * r, h, color);
+    ref_fill_rect(fb, x, y + r, r, h - 2 * r, color);
+    ref_fill_rect(fb, x + w - r, y + r, r, h - 2 * r, color);
+    ref_fill_circle(fb, x + r,     y + r,     r, color);
+    ref_fill_circle(fb, x + w - r - 1, y + r,     r, color);
+    ref_fill_circle(fb, x + r,     y + h - r - 1, r, color);
+    ref_fill_circle(fb, x + w - r - 1, y + h - r - 1, r, color);
+}
+
+static void ref_fill_rect_gradient(Framebuffer *fb, int x, int y, int w, int h,
+                                   uint32_t top_color, uint32_t bottom_color) {
+    x += fb->draw_offset_x;
+    y += fb->draw_offset_y;
+    int tr = (int)((top_color >> 16) & 0xFF);
+    int tg = (int)((top_color >>  8) & 0xFF);
+    int tb = (int)( top_color        & 0xFF);
+    int dr = (int)((bottom_color >> 16) & 0xFF) - tr;
+    int dg = (int)((bottom_color >>  8) & 0xFF) - tg;
+    int db = (int)( bottom_color        & 0xFF) - tb;
+    int span = (h > 1) ? h - 1 : 1;
+    for (int j = 0; j < h; j++) {
+        uint32_t r = (uint32_t)(tr + dr * j / span);
+        uint32_t g = (uint32_t)(tg + dg * j / span);
+        uint32_t b = (uint32_t)(tb + db * j / span);
+        uint32_t c = (r << 16) | (g << 8) | b;
+        for (int i = 0; i < w; i++)
+            fb_draw_pixel(fb, x + i, y + j, c);
+    }
+}
+
+/* ── Drive one shape through both and compare ─────────────────────────────── */
+
+typedef enum { P_RECT, P_CIRCLE, P_ROUNDED, P_GRADIENT } Prim;
+
+static const uint32_t C_BG = RGB(10, 20, 30);
+static const uint32_t C_A  = RGB(255, 128, 8);
+static const uint32_t C_B  = RGB(0, 220, 255);
+
+static void draw(Prim p, bool reference, const int *a) {
+    switch (p) {
+    case P_RECT:
+        if (reference) ref_fill_rect(&fb, a[0], a[1], a[2], a[3], C_A);
+        else           fb_fill_rect(&fb, a[0], a[1], a[2], a[3], C_A);
+        break;
+    case P_CIRCLE:
+        if (reference) ref_fill_circle(&fb, a[0], a[1], a[2], C_A);
+        else           fb_fill_circle(&fb, a[0], a[1], a[2], C_A);
+        break;
+    case P_ROUNDED:
+        if (reference) ref_fill_rounded_rect(&fb, a[0], a[1], a[2], a[3], a[4], C_A);
+        else           fb_fill_rounded_rect(&fb, a[0], a[1], a[2], a[3], a[4], C_A);
+        break;
+    case P_GRADIENT:
+        if (reference) ref_fill_rect_gradient(&fb, a[0], a[1], a[2], a[3], C_A, C_B);
+        else           fb_fill_rect_gradient(&fb, a[0], a[1], a[2], a[3], C_A, C_B);
+        break;
+    }
+}
+
+/* The one deliberate difference. At an even w or h with r at its clamp, the
+ * corner circles of the old rounded rectangle reached one pixel past the box
+ * (a row above, a column to the right). The span version clamps to the box, so
+ * the reference is clamped the same way before comparing: everything INSIDE
+ * the box must still match exactly. */
+static void clamp_reference_to_box(const int *a) {
+    int x0 = a[0] + fb.draw_offset_x, y0 = a[1] + fb.draw_offset_y;
+    for (int y = 0; y < H; y++)
+        for (int x = 0; x < W; x++)
+            if (x < x0 || x >= x0 + a[2] || y < y0 || y >= y0 + a[3])
+                fb_draw_pixel(&fb, x, y, C_BG);
+}
+
+/* Returns true when both surfaces agree; reports only the first mismatch. */
+static bool same(Prim p, const int *a) {
+    fb.back_buffer = (uint32_t *)want_buf;
+    fb_clear(&fb, C_BG);
+    draw(p, true, a);
+    if (p == P_ROUNDED) clamp_reference_to_box(a);
+    fb.back_buffer = (uint32_t *)got_buf;
+    fb_clear(&fb, C_BG);
+    draw(p, false, a);
+    cases++;
+    if (memcmp(got_buf, want_buf, bytes) == 0) return true;
+    for (size_t i = 0; i < bytes; i++) {
+        if (got_buf[i] != want_buf[i]) {
+            size_t px = i / fb.bytes_per_pixel;
+            printf("  FAIL prim %d args %d,%d,%d,%d,%d off %d,%d @%zubpp: first diff at (%zu,%zu)\n",
+                   (int)p, a[0], a[1], a[2], a[3], a[4], fb.draw_offset_x, fb.draw_offset_y,
+                   (size_t)fb.bytes_per_pixel * 8, px % W, px / W);
+            break;
+        }
+    }
+    fails++;
+    return false;
+}
+
+static void sweep(const char *what, Prim p) {
+    int before = fails, n0 = cases;
+    int a[5] = {0};
+    switch (p) {
+    case P_RECT:
+    case P_GRADIENT:
+        /* Every edge: inside, hanging off each side, covering everything,
+         * degenerate and negative. */
+        for (int x = -W; x <= W; x += 13)
+            for (int y = -H; y <= H; y += 11)
+                for (int w = -2; w <= W + 20; w += 17)
+                    for (int h = -2; h <= H + 20; h += 9) {
+                        a[0] = x; a[1] = y; a[2] = w; a[3] = h;
+                        same(p, a);
+                    }
+        break;
+    case P_CIRCLE:
+        for (int cx = -20; cx <= W + 20; cx += 7)
+            for (int cy = -20; cy <= H + 20; cy += 7)
+                for (int r = -1; r <= 45; r += 3) {
+                    a[0] = cx; a[1] = cy; a[2] = r;
+                    same(p, a);
+                }
+        break;
+    case P_ROUNDED:
+        /* Small shapes with every radius up to and past the clamp, so r == w/2
+         * and r == h/2 are hit at both parities. */
+        for (int w = 1; w <= 14; w++)
+            for (int h = 1; h <= 14; h++)
+                for (int r = -1; r <= 8; r++) {
+                    a[0] = 5; a[1] = 4; a[2] = w; a[3] = h; a[4] = r;
+                    same(p, a);
+                }
+        /* And clipped ones. */
+        for (int x = -30; x <= W; x += 11)
+            for (int y = -30; y <= H; y += 9)
+                for (int r = 0; r <= 20; r += 4) {
+                    a[0] = x; a[1] = y; a[2] = 45; a[3] = 36; a[4] = r;
+                    same(p, a);
+                }
+        break;
+    }
+    if (fails == before) printf("  ok   %-44s %d cases\n", what, cases - n0);
+    else                 printf("  FAIL %-44s %d of %d differ\n", what, fails - before, cases - n0);
+}
+
+static void run_depth(int bytes_per_pixel) {
+    static const int offsets[][2] = { {0, 0}, {3, -5}, {-17, 9} };
+    surface_init(bytes_per_pixel);
+    for (size_t o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++) {
+        fb.draw_offset_x = offsets[o][0];
+        fb.draw_offset_y = offsets[o][1];
+        printf("%dbpp, draw offset (%d,%d)\n", bytes_per_pixel * 8,
+               fb.draw_offset_x, fb.draw_offset_y);
+        sweep("fb_fill_rect matches the per-pixel loop", P_RECT);
+        sweep("fb_fill_rect_gradient matches, clipped ramps", P_GRADIENT);
+        sweep("fb_fill_circle matches the x*x+y*y test", P_CIRCLE);
+        sweep("fb_fill_rounded_rect matches the 7-primitive union", P_ROUNDED);
+    }
+}
+
+int main(void) {
+    run_depth(4);
+    printf("\n");
+    run_depth(2);
+
+    /* fb_clear() went onto the same span fill. */
+    printf("\nfb_clear\n");
+    for (int bpp = 2; bpp <= 4; bpp += 2) {
+        surface_init(bpp);
+        fb.back_buffer = (uint32_t *)want_buf;
+        for (int y = 0; y < H; y++)
+            for (int x = 0; x < W; x++)
+                fb_draw_pixel(&fb, x, y, C_B);
+        fb.back_buffer = (uint32_t *)got_buf;
+        fb_clear(&fb, C_B);
+        cases++;
+        if (memcmp(got_buf, want_buf, bytes) == 0) {
+            printf("  ok   fb_clear non-zero colour at %-14d every pixel\n", bpp * 8);
+        } else {
+            printf("  FAIL fb_clear non-zero colour at %dbpp\n", bpp * 8);
+            fails++;
+        }
+    }
+
+    free(got_buf);
+    free(want_buf);
+    printf("\n%s (%d failure%s, %d cases)\n", fails ? "FAILED" : "PASSED",
+           fails, fails == 1 ? "" : "s", cases);
+    return fails ? 1 : 0;
+}
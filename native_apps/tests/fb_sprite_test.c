@@ -0,0 +1,153 @@
+/* Host-side regression for compiled (run-length) sprites.
+ *
+ * Runs on the DEV MACHINE with native gcc, not on the device — a synthetic
+ * Framebuffer over a malloc'd buffer, as in fb_span_test.c.
+ *
+ *   cd native_apps && gcc -Wall -Wextra -Wno-unused-parameter -I common \
+ *       -o build/fb_sprite_test tests/fb_sprite_test.c \
+ *       common/framebuffer.c common/hardware.c common/config.c \
+ *       common/touch_input.c -lm && ./build/fb_sprite_test
+ *
+ * What it asserts, and why: fb_draw_sprite() and fb_draw_sprite_flipped() are
+ * the precompiled form of fb_blit_sprite() and fb_blit_sprite_flipped(), which
+ * are still in the tree and are the reference here. Same source rectangle,
+ * same key, same destination: the surfaces must be identical word for word —
+ * at both depths, with and without a draw offset, and with the sprite hanging
+ * off every edge, because a run blitter goes wrong at the clip (a run cut in
+ * the middle, a flipped run whose far end is the one off screen). The art has
+ * runs of every shape: fully transparent rows, fully opaque rows, single
+ * pixels, and runs touching both sides.
+ *
+ * NOT part of build-and-deploy.sh: that script cross-compiles for ARM and this
+ * is a host binary. Run it by hand after touching the sprite compiler or
+ * blitters.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "framebuffer.h"
+
+static int fails = 0;
+static int cases = 0;
+
+#define W 53
+#define H 37
+
+/* Source sheet: the sprite is cut from (SX, SY) so src_w != sprite width. */
+#define SHEET_W 24
+#define SHEET_H 20
+#define SX 3
+#define SY 2
+#define SW 17
+#define SH 13
+
+static Framebuffer fb;
+static uint8_t *got_buf, *want_buf;
+static size_t bytes;
+static uint32_t sheet[SHEET_W * SHEET_H];
+
+static void surface_init(int bytes_per_pixel) {
+    memset(&fb, 0, sizeof(fb));
+    fb.width  = W;
+    fb.height = H;
+    fb.bytes_per_pixel = (uint32_t)bytes_per_pixel;
+    fb.double_buffering = true;
+    bytes = (size_t)W * H * bytes_per_pixel;
+    free(got_buf);
+    free(want_buf);
+    got_buf  = (uint8_t *)malloc(bytes);
+    want_buf = (uint8_t *)malloc(bytes);
+    if (!got_buf || !want_buf) { printf("  FAIL out of memory\n"); exit(2); }
+    fb.back_buffer_size = bytes;
+}
+
+static void sheet_init(void) {
+    for (int y = 0; y < SHEET_H; y++)
+        for (int x = 0; x < SHEET_W; x++) {
+            int sx = x - SX, sy = y - SY;
+            bool opaque;
+            if (sy == 0)      opaque = false;                 /* empty row */
+            else if (sy == 1) opaque = true;                  /* full row */
+            else if (sy == 2) opaque = (sx % 4 == 0);         /* single pixels */
+            else if (sy == 3) opaque = (sx == 0 || sx == SW - 1);
+            else              opaque = ((sx * 7 + sy * 3) % 5) < 3;
+            sheet[y * SHEET_W + x] = opaque
+                ? (0xFF000000u | (uint32_t)(x * 9) << 16 | (uint32_t)(y * 11) << 8 | (uint32_t)(x ^ y))
+                : SPRITE_TRANSPARENT;
+        }
+}
+
+static const uint32_t C_BG = RGB(10, 20, 30);
+
+static bool same(const FbSprite *spr, bool flipped, uint32_t key, int x, int y) {
+    fb.back_buffer = (uint32_t *)want_buf;
+    fb_clear(&fb, C_BG);
+    if (flipped) fb_blit_sprite_flipped(&fb, sheet, SHEET_W, SX, SY, x, y, SW, SH, key);
+    else         fb_blit_sprite(&fb, sheet, SHEET_W, SX, SY, x, y, SW, SH, key);
+    fb.back_buffer = (uint32_t *)got_buf;
+    fb_clear(&fb, C_BG);
+    if (flipped) fb_draw_sprite_flipped(&fb, spr, x, y);
+    else         fb_draw_sprite(&fb, spr, x, y);
+    cases++;
+    return memcmp(got_buf, want_buf, bytes) == 0;
+}
+
+static void sweep(const char *what, bool flipped, uint32_t key) {
+    FbSprite *spr = fb_sprite_compile(&fb, sheet, SHEET_W, SX, SY, SW, SH, key);
+    if (!spr) { printf("  FAIL %s: compile failed\n", what); fails++; return; }
+    bool ok = true;
+    for (int y = -SH - 1; y <= H + 1 && ok; y++)
+        for (int x = -SW - 1; x <= W + 1 && ok; x++)
+            if (!same(spr, flipped, key, x, y)) {
+                printf("  FAIL %-32s at (%d,%d) off (%d,%d)\n", what, x, y,
+                       fb.draw_offset_x, fb.draw_offset_y);
+                fails++;
+                ok = false;
+            }
+    if (ok) printf("  ok   %-32s off (%d,%d)\n", what, fb.draw_offset_x, fb.draw_offset_y);
+    fb_sprite_free(spr);
+}
+
+static void run_depth(int bytes_per_pixel) {
+    static const int offsets[][2] = { {0, 0}, {3, -5}, {-17, 9} };
+    surface_init(bytes_per_pixel);
+    printf("%dbpp\n", bytes_per_pixel * 8);
+    for (unsigned o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++) {
+        fb_set_draw_offset(&fb, offsets[o][0], offsets[o][1]);
+        sweep("colour key", false, SPRITE_TRANSPARENT);
+        sweep("colour key, flipped", true, SPRITE_TRANSPARENT);
+        sweep("no key (0xFFFFFFFF)", false, 0xFFFFFFFF);
+        sweep("no key, flipped", true, 0xFFFFFFFF);
+        fb_clear_draw_offset(&fb);
+    }
+
+    /* A sprite belongs to its depth. */
+    FbSprite *spr = fb_sprite_compile(&fb, sheet, SHEET_W, SX, SY, SW, SH, 0xFFFFFFFF);
+    Framebuffer other = fb;
+    other.bytes_per_pixel = bytes_per_pixel == 4 ? 2 : 4;
+    other.back_buffer = (uint32_t *)got_buf;
+    memset(got_buf, 0, bytes);
+    fb_draw_sprite(&other, spr, 0, 0);
+    bool untouched = true;
+    for (size_t i = 0; i < bytes; i++) if (got_buf[i]) untouched = false;
+    printf("  %s drawn at another depth, draws nothing\n", untouched ? "ok  " : "FAIL");
+    if (!untouched) fails++;
+    fb_sprite_free(spr);
+
+    bool rejected = fb_sprite_compile(&fb, sheet, SHEET_W, 0, 0, 0, 4, 0) == NULL;
+    printf("  %s an empty rectangle does not compile\n", rejected ? "ok  " : "FAIL");
+    if (!rejected) fails++;
+}
+
+int main(void) {
+    sheet_init();
+    run_depth(4);
+    printf("\n");
+    run_depth(2);
+
+    free(got_buf);
+    free(want_buf);
+    printf("\n%s (%d failure%s, %d cases)\n", fails ? "FAILED" : "PASSED",
+           fails, fails == 1 ? "" : "s", cases);
+    return fails ? 1 : 0;
+}
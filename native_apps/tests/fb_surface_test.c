@@ -0,0 +1,209 @@
+/* Host-side regression for offscreen surfaces and cached layers.
+ *
+ * Runs on the DEV MACHINE with native gcc, not on the device — a synthetic
+ * Framebuffer over a malloc'd buffer, as in fb_span_test.c.
+ *
+ *   cd native_apps && gcc -Wall -Wextra -Wno-unused-parameter -I common \
+ *       -o build/fb_surface_test tests/fb_surface_test.c \
+ *       common/framebuffer.c common/hardware.c common/config.c \
+ *       common/touch_input.c -lm && ./build/fb_surface_test
+ *
+ * What it asserts, and why: a layer is only worth having if blitting it is
+ * indistinguishable from drawing its contents in place. So the same scene is
+ * drawn straight into the frame and, separately, into a Surface that is then
+ * blitted — the frames must match word for word, at both depths. The blits
+ * are then held to a per-pixel reference with the source and destination both
+ * hanging off every edge and a draw offset set, because a rectangle blit goes
+ * wrong at the clip, and onto the same surface with the rectangles overlapping
+ * in every direction, because a top-down row walk smears a picture moved down.
+ * And a layer must paint exactly once until invalidated — a layer that
+ * repaints every frame is correct and useless.
+ *
+ * NOT part of build-and-deploy.sh: that script cross-compiles for ARM and this
+ * is a host binary. Run it by hand after touching the Surface code.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "framebuffer.h"
+
+static int fails = 0;
+
+static void expect_true(const char *what, bool cond) {
+    if (!cond) { printf("  FAIL %-56s\n", what); fails++; }
+    else       { printf("  ok   %-56s\n", what); }
+}
+
+#define W 61
+#define H 43
+
+static Framebuffer fb;
+static uint8_t *got_buf, *want_buf;
+static size_t bytes;
+
+static void surface_init(int bytes_per_pixel) {
+    memset(&fb, 0, sizeof(fb));
+    fb.width  = W;
+    fb.height = H;
+    fb.bytes_per_pixel = (uint32_t)bytes_per_pixel;
+    fb.double_buffering = true;
+    bytes = (size_t)W * H * bytes_per_pixel;
+    free(got_buf);
+    free(want_buf);
+    got_buf  = (uint8_t *)malloc(bytes);
+    want_buf = (uint8_t *)malloc(bytes);
+    if (!got_buf || !want_buf) { printf("  FAIL out of memory\n"); exit(2); }
+    fb.back_buffer_size = bytes;
+}
+
+static void scene(Framebuffer *t) {
+    fb_clear(t, RGB(3, 4, 5));
+    fb_draw_rect(t, 2, 2, W - 4, H - 4, RGB(255, 255, 255));
+    fb_fill_rounded_rect(t, 8, 6, 30, 14, 5, RGB(20, 90, 200));
+    fb_draw_text(t, 10, 24, "LVL 3", RGB(255, 255, 0), 1);
+    fb_fill_rect_alpha(t, 30, 10, 20, 20, RGB(255, 0, 0), 120);
+    fb_draw_line(t, 0, H - 1, W - 1, 0, RGB(0, 255, 0));
+}
+
+static int paints = 0;
+static void paint_scene(Surface *s, void *user) {
+    (void)user;
+    paints++;
+    scene(s);
+}
+
+/* Pixel (x, y) of a surface as stored, at either depth. */
+static uint32_t stored(const Framebuffer *t, int x, int y) {
+    size_t i = (size_t)y * t->width + x;
+    return t->bytes_per_pixel == 2 ? ((const uint16_t *)t->back_buffer)[i]
+                                   : t->back_buffer[i];
+}
+
+static void store(Framebuffer *t, int x, int y, uint32_t v) {
+    size_t i = (size_t)y * t->width + x;
+    if (t->bytes_per_pixel == 2) ((uint16_t *)t->back_buffer)[i] = (uint16_t)v;
+    else                         t->back_buffer[i] = v;
+}
+
+/* The blit, one pixel at a time, straight from its definition. */
+static void ref_blit(Framebuffer *t, const Surface *s, int sx, int sy, int dx, int dy,
+                     int w, int h, bool keyed, uint32_t key) {
+    dx += t->draw_offset_x;
+    dy += t->draw_offset_y;
+    uint32_t k = t->bytes_per_pixel == 2
+        ? (uint32_t)((((key >> 16) & 0xF8) << 8) | (((key >> 8) & 0xFC) << 3) | ((key & 0xF8) >> 3))
+        : key;
+    for (int j = 0; j < h; j++)
+        for (int i = 0; i < w; i++) {
+            int x = sx + i, y = sy + j, px = dx + i, py = dy + j;
+            if (x < 0 || y < 0 || x >= (int)s->width || y >= (int)s->height) continue;
+            if (px < 0 || py < 0 || px >= (int)t->width || py >= (int)t->height) continue;
+            uint32_t v = stored(s, x, y);
+            if (keyed && v == k) continue;
+            store(t, px, py, v);
+        }
+}
+
+static void run_depth(int bpp) {
+    printf("%dbpp\n", bpp * 8);
+    surface_init(bpp);
+
+    /* 1: a layer blitted at (0,0) is the scene drawn in place. */
+    fb.back_buffer = (uint32_t *)want_buf;
+    scene(&fb);
+    FbLayer layer;
+    paints = 0;
+    expect_true("fb_layer_init", fb_layer_init(&layer, &fb, W, H, paint_scene, NULL) == 0);
+    fb.back_buffer = (uint32_t *)got_buf;
+    memset(got_buf, 0x5A, bytes);
+    fb_layer_blit(&fb, &layer, 0, 0);
+    expect_true("a blitted layer matches the scene drawn in place",
+                memcmp(got_buf, want_buf, bytes) == 0);
+    fb_layer_blit(&fb, &layer, 0, 0);
+    fb_layer_blit(&fb, &layer, 0, 0);
+    expect_true("and paints once however often it is blitted", paints == 1);
+    fb_layer_invalidate(&layer);
+    fb_layer_blit(&fb, &layer, 0, 0);
+    expect_true("and once more after fb_layer_invalidate", paints == 2);
+    fb_swap(&layer.surface);
+    expect_true("fb_swap on a surface is a no-op", paints == 2);
+
+    /* 2: rectangle blits, clipped on both sides, with a draw offset. */
+    static const int offsets[][2] = { {0, 0}, {3, -5}, {-17, 9} };
+    bool ok = true, ok_keyed = true;
+    const uint32_t key = RGB(3, 4, 5);      /* the scene's background */
+    for (unsigned o = 0; o < 3; o++) {
+        fb_set_draw_offset(&fb, offsets[o][0], offsets[o][1]);
+        for (int sy = -6; sy <= H; sy += 7)
+            for (int sx = -6; sx <= W; sx += 9)
+                for (int dy = -20; dy <= H; dy += 11)
+                    for (int dx = -25; dx <= W; dx += 13)
+                        for (int k = 0; k < 2; k++) {
+                            for (size_t i = 0; i < bytes; i++) want_buf[i] = got_buf[i] = (uint8_t)(i * 13);
+                            fb.back_buffer = (uint32_t *)want_buf;
+                            ref_blit(&fb, &layer.surface, sx, sy, dx, dy, 23, 17, k, key);
+                            fb.back_buffer = (uint32_t *)got_buf;
+                            if (k) fb_blit_surface_keyed(&fb, &layer.surface, sx, sy, dx, dy, 23, 17, key);
+                            else   fb_blit_surface(&fb, &layer.surface, sx, sy, dx, dy, 23, 17);
+                            if (memcmp(got_buf, want_buf, bytes) != 0) {
+                                if (k) ok_keyed = false; else ok = false;
+                            }
+                        }
+        fb_clear_draw_offset(&fb);
+    }
+    expect_true("fb_blit_surface clips like a per-pixel copy", ok);
+    expect_true("fb_blit_surface_keyed skips exactly the key", ok_keyed);
+
+    /* 2b: a surface blitted onto itself, the rectangles overlapping in every
+     * direction — the result must be the copy read from a snapshot. */
+    static const int moves[][2] = {
+        {0, 5}, {0, -5}, {7, 0}, {-7, 0}, {4, 3}, {-4, 3}, {4, -3}, {-4, -3}, {1, 1},
+    };
+    bool ok_self = true, ok_self_keyed = true;
+    uint8_t *snap_buf = (uint8_t *)malloc(bytes);
+    Surface snap = fb;
+    snap.back_buffer = (uint32_t *)snap_buf;
+    for (unsigned m = 0; m < sizeof(moves) / sizeof(moves[0]); m++)
+        for (int k = 0; k < 2; k++) {
+            fb.back_buffer = (uint32_t *)got_buf;
+            scene(&fb);
+            memcpy(snap_buf, got_buf, bytes);
+            memcpy(want_buf, got_buf, bytes);
+            fb.back_buffer = (uint32_t *)want_buf;
+            ref_blit(&fb, &snap, 10, 8, 10 + moves[m][0], 8 + moves[m][1], 30, 20, k, key);
+            fb.back_buffer = (uint32_t *)got_buf;
+            if (k) fb_blit_surface_keyed(&fb, &fb, 10, 8, 10 + moves[m][0], 8 + moves[m][1],
+                                         30, 20, key);
+            else   fb_blit_surface(&fb, &fb, 10, 8, 10 + moves[m][0], 8 + moves[m][1], 30, 20);
+            if (memcmp(got_buf, want_buf, bytes) != 0) {
+                if (k) ok_self_keyed = false; else ok_self = false;
+            }
+        }
+    free(snap_buf);
+    expect_true("a blit onto the same surface reads the source first", ok_self);
+    expect_true("and so does a keyed one", ok_self_keyed);
+
+    /* 3: a surface of another depth is refused, not misread. */
+    Surface other;
+    Framebuffer like = fb;
+    like.bytes_per_pixel = bpp == 4 ? 2 : 4;
+    fb_surface_init(&other, &like, 8, 8);
+    fb_clear(&other, RGB(255, 255, 255));
+    memcpy(want_buf, got_buf, bytes);
+    fb_blit_surface(&fb, &other, 0, 0, 0, 0, 8, 8);
+    expect_true("a surface of another depth is not drawn",
+                memcmp(got_buf, want_buf, bytes) == 0);
+    fb_surface_free(&other);
+    fb_layer_free(&layer);
+    printf("\n");
+}
+
+int main(void) {
+    run_depth(4);
+    run_depth(2);
+    free(got_buf);
+    free(want_buf);
+    printf("%s (%d failure%s)\n", fails ? "FAILED" : "PASSED",
+           fails, fails == 1 ? "" : "s");
+    return fails ? 1 : 0;
+}
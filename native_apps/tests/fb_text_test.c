@@ -0,0 +1,270 @@
+/* Host-side regression for the glyph-run text blitter (fb_draw_text).
+ *
+ * Runs on the DEV MACHINE with native gcc, not on the device — a synthetic
+ * Framebuffer over a malloc'd buffer, as in fb_span_test.c.
+ *
+ *   cd native_apps && gcc -Wall -Wextra -Wno-unused-parameter -I common \
+ *       -o build/fb_text_test tests/fb_text_test.c \
+ *       common/framebuffer.c common/hardware.c common/config.c \
+ *       common/touch_input.c -lm && ./build/fb_text_test
+ *
+ * What it asserts, and why: fb_draw_text() went from a per-bit, per-pixel
+ * loop to row-major runs out of a pre-rasterised glyph table. That is a pure
+ * speed change, so the only acceptable result is the SAME PIXELS. The
+ * REFERENCE below is the old loop, transcribed verbatim, drawing through
+ * fb_draw_pixel(); font_5x7 is static in framebuffer.c, so a copy of it is
+ * here too — if the two drift apart the sweep fails, which is the point. Every
+ * printable character is drawn at scales 1-4, at both depths, with and
+ * without a draw offset, and hanging off every edge — the clip is the part a
+ * run blitter can get wrong.
+ *
+ * NOT part of build-and-deploy.sh: that script cross-compiles for ARM and this
+ * is a host binary. Run it by hand after touching fb_draw_text() or the font.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "framebuffer.h"
+
+static int fails = 0;
+static int cases = 0;
+
+#define W 71
+#define H 37
+
+static Framebuffer fb;
+static uint8_t *got_buf, *want_buf;
+static size_t bytes;
+
+/* framebuffer.c's font_5x7, copied. */
+static const uint8_t font_5x7[][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, // Space
+    {0x00, 0x00, 0x5F, 0x00, 0x00}, // !
+    {0x00, 0x07, 0x00, 0x07, 0x00}, // "
+    {0x14, 0x7F, 0x14, 0x7F, 0x14}, // #
+    {0x24, 0x2A, 0x7F, 0x2A, 0x12}, // $
+    {0x23, 0x13, 0x08, 0x64, 0x62}, // %
+    {0x36, 0x49, 0x55, 0x22, 0x50}, // &
+    {0x00, 0x05, 0x03, 0x00, 0x00}, // '
+    {0x00, 0x1C, 0x22, 0x41, 0x00}, // (
+    {0x00, 0x41, 0x22, 0x1C, 0x00}, // )
+    {0x14, 0x08, 0x3E, 0x08, 0x14}, // *
+    {0x08, 0x08, 0x3E, 0x08, 0x08}, // +
+    {0x00, 0x50, 0x30, 0x00, 0x00}, // ,
+    {0x08, 0x08, 0x08, 0x08, 0x08}, // -
+    {0x00, 0x60, 0x60, 0x00, 0x00}, // .
+    {0x20, 0x10, 0x08, 0x04, 0x02}, // /
+    {0x3E, 0x51, 0x49, 0x45, 0x3E}, // 0
+    {0x00, 0x42, 0x7F, 0x40, 0x00}, // 1
+    {0x42, 0x61, 0x51, 0x49, 0x46}, // 2
+    {0x21, 0x41, 0x45, 0x4B, 0x31}, // 3
+    {0x18, 0x14, 0x12, 0x7F, 0x10}, // 4
+    {0x27, 0x45, 0x45, 0x45, 0x39}, // 5
+    {0x3C, 0x4A, 0x49, 0x49, 0x30}, // 6
+    {0x01, 0x71, 0x09, 0x05, 0x03}, // 7
+    {0x36, 0x49, 0x49, 0x49, 0x36}, // 8
+    {0x06, 0x49, 0x49, 0x29, 0x1E}, // 9
+    {0x00, 0x36, 0x36, 0x00, 0x00}, // :
+    {0x00, 0x56, 0x36, 0x00, 0x00}, // ;
+    {0x08, 0x14, 0x22, 0x41, 0x00}, // <
+    {0x14, 0x14, 0x14, 0x14, 0x14}, // =
+    {0x00, 0x41, 0x22, 0x14, 0x08}, // >
+    {0x02, 0x01, 0x51, 0x09, 0x06}, // ?
+    {0x32, 0x49, 0x79, 0x41, 0x3E}, // @
+    {0x7E, 0x11, 0x11, 0x11, 0x7E}, // A
+    {0x7F, 0x49, 0x49, 0x49, 0x36}, // B
+    {0x3E, 0x41, 0x41, 0x41, 0x22}, // C
+    {0x7F, 0x41, 0x41, 0x22, 0x1C}, // D
+    {0x7F, 0x49, 0x49, 0x49, 0x41}, // E
+    {0x7F, 0x09, 0x09, 0x09, 0x01}, // F
+    {0x3E, 0x41, 0x49, 0x49, 0x7A}, // G
+    {0x7F, 0x08, 0x08, 0x08, 0x7F}, // H
+    {0x00, 0x41, 0x7F, 0x41, 0x00}, // I
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, // J
+    {0x7F, 0x08, 0x14, 0x22, 0x41}, // K
+    {0x7F, 0x40, 0x40, 0x40, 0x40}, // L
+    {0x7F, 0x02, 0x0C, 0x02, 0x7F}, // M
+    {0x7F, 0x04, 0x08, 0x10, 0x7F}, // N
+    {0x3E, 0x41, 0x41, 0x41, 0x3E}, // O
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, // P
+    {0x3E, 0x41, 0x51, 0x21, 0x5E}, // Q
+    {0x7F, 0x09, 0x19, 0x29, 0x46}, // R
+    {0x46, 0x49, 0x49, 0x49, 0x31}, // S
+    {0x01, 0x01, 0x7F, 0x01, 0x01}, // T
+    {0x3F, 0x40, 0x40, 0x40, 0x3F}, // U
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, // V
+    {0x3F, 0x40, 0x38, 0x40, 0x3F}, // W
+    {0x63, 0x14, 0x08, 0x14, 0x63}, // X
+    {0x07, 0x08, 0x70, 0x08, 0x07}, // Y
+    {0x61, 0x51, 0x49, 0x45, 0x43}, // Z
+    // ASCII 91–96: [ \ ] ^ _ `
+    {0x00, 0x7F, 0x41, 0x41, 0x00}, // [
+    {0x02, 0x04, 0x08, 0x10, 0x20}, // backslash
+    {0x00, 0x41, 0x41, 0x7F, 0x00}, // ]
+    {0x04, 0x02, 0x01, 0x02, 0x04}, // ^
+    {0x40, 0x40, 0x40, 0x40, 0x40}, // _
+    {0x00, 0x01, 0x02, 0x04, 0x00}, // `
+    // ASCII 97–122: lowercase a–z
+    {0x20, 0x54, 0x54, 0x54, 0x78}, // a
+    {0x7F, 0x48, 0x44, 0x44, 0x38}, // b
+    {0x38, 0x44, 0x44, 0x44, 0x20}, // c
+    {0x38, 0x44, 0x44, 0x48, 0x7F}, // d
+    {0x38, 0x54, 0x54, 0x54, 0x18}, // e
+    {0x08, 0x7E, 0x09, 0x01, 0x02}, // f
+    {0x0C, 0x52, 0x52, 0x52, 0x3E}, // g
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, // h
+    {0x00, 0x44, 0x7D, 0x40, 0x00}, // i
+    {0x20, 0x40, 0x44, 0x3D, 0x00}, // j
+    {0x7F, 0x10, 0x28, 0x44, 0x00}, // k
+    {0x00, 0x41, 0x7F, 0x40, 0x00}, // l
+    {0x7C, 0x04, 0x18, 0x04, 0x78}, // m
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, // n
+    {0x38, 0x44, 0x44, 0x44, 0x38}, // o
+    {0x7C, 0x14, 0x14, 0x14, 0x08}, // p
+    {0x08, 0x14, 0x14, 0x18, 0x7C}, // q
+    {0x7C, 0x08, 0x04, 0x04, 0x08}, // r
+    {0x48, 0x54, 0x54, 0x54, 0x20}, // s
+    {0x04, 0x3F, 0x44, 0x40, 0x20}, // t
+    {0x3C, 0x40, 0x40, 0x20, 0x7C}, // u
+    {0x1C, 0x20, 0x40, 0x20, 0x1C}, // v
+    {0x3C, 0x40, 0x30, 0x40, 0x3C}, // w
+    {0x44, 0x28, 0x10, 0x28, 0x44}, // x
+    {0x0C, 0x50, 0x50, 0x50, 0x3C}, // y
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, // z
+    // ASCII 123–126: { | } ~
+    {0x00, 0x08, 0x36, 0x41, 0x00}, // {
+    {0x00, 0x00, 0x7F, 0x00, 0x00}, // |
+    {0x00, 0x41, 0x36, 0x08, 0x00}, // }
+    {0x10, 0x08, 0x08, 0x10, 0x08}, // ~
+};
+
+static void surface_init(int bytes_per_pixel) {
+    memset(&fb, 0, sizeof(fb));
+    fb.width  = W;
+    fb.height = H;
+    fb.bytes_per_pixel = (uint32_t)bytes_per_pixel;
+    fb.double_buffering = true;
+    bytes = (size_t)W * H * bytes_per_pixel;
+    free(got_buf);
+    free(want_buf);
+    got_buf  = (uint8_t *)malloc(bytes);
+    want_buf = (uint8_t *)malloc(bytes);
+    if (!got_buf || !want_buf) { printf("  FAIL out of memory\n"); exit(2); }
+    fb.back_buffer_size = bytes;
+}
+
+/* ── REFERENCE: fb_draw_text() before the glyph runs ─────────────────────── */
+
+static void ref_draw_text(Framebuffer *fb, int x, int y, const char *text, uint32_t color, int scale) {
+    x += fb->draw_offset_x;
+    y += fb->draw_offset_y;
+    int offset_x = 0;
+
+    while (*text) {
+        char c = *text;
+        int idx = c - ' ';
+
+        if (idx < 0 || idx >= 95) {
+            offset_x += 6 * scale;
+            text++;
+            continue;
+        }
+
+        {
+            for (int col = 0; col < 5; col++) {
+                uint8_t column = font_5x7[idx][col];
+                for (int row = 0; row < 7; row++) {
+                    if (column & (1 << row)) {
+                        for (int sy = 0; sy < scale; sy++) {
+                            for (int sx = 0; sx < scale; sx++) {
+                                fb_draw_pixel(fb, x + offset_x + col * scale + sx,
+                                            y + row * scale + sy, color);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        offset_x += 6 * scale;
+        text++;
+    }
+}
+
+/* ───────────────────────────────────────────────────────────────────────── */
+
+static const uint32_t C_BG = RGB(10, 20, 30);
+static const uint32_t C_FG = RGB(255, 128, 8);
+
+static bool same(const char *text, int x, int y, int scale) {
+    fb.back_buffer = (uint32_t *)want_buf;
+    fb_clear(&fb, C_BG);
+    ref_draw_text(&fb, x, y, text, C_FG, scale);
+    fb.back_buffer = (uint32_t *)got_buf;
+    fb_clear(&fb, C_BG);
+    fb_draw_text(&fb, x, y, text, C_FG, scale);
+    cases++;
+    return memcmp(got_buf, want_buf, bytes) == 0;
+}
+
+static void sweep(const char *what, const char *text, int scale) {
+    bool ok = true;
+    int tw = (int)strlen(text) * 6 * scale, th = 7 * scale;
+    for (int y = -th - 1; y <= H + 1 && ok; y += (scale > 1 ? 3 : 2))
+        for (int x = -tw - 1; x <= W + 1 && ok; x += (scale > 1 ? 5 : 3))
+            if (!same(text, x, y, scale)) {
+                printf("  FAIL %-36s scale %d at (%d,%d) off (%d,%d)\n", what, scale,
+                       x, y, fb.draw_offset_x, fb.draw_offset_y);
+                fails++;
+                ok = false;
+            }
+    if (ok) printf("  ok   %-36s scale %d\n", what, scale);
+}
+
+static void run_depth(int bytes_per_pixel) {
+    static const int offsets[][2] = { {0, 0}, {3, -5}, {-17, 9} };
+    char all[96];
+    for (int i = 0; i < 95; i++) all[i] = (char)(' ' + i);
+    all[95] = '\0';
+
+    surface_init(bytes_per_pixel);
+    printf("%dbpp\n", bytes_per_pixel * 8);
+    for (unsigned o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++) {
+        fb_set_draw_offset(&fb, offsets[o][0], offsets[o][1]);
+        for (int scale = 1; scale <= 4; scale++) {
+            sweep("a score", "SCORE 0042", scale);
+            sweep("unprintables are blank cells", "A\tB\x7f" "C\x80" "D", scale);
+        }
+        /* Every glyph, in strings short enough to sweep across the surface. */
+        for (int i = 0; i < 95; i += 5) {
+            char chunk[6];
+            memcpy(chunk, all + i, 5);
+            chunk[5] = '\0';
+            sweep("printable ASCII, five at a time", chunk, 1 + (i / 5) % 3);
+        }
+        fb_clear_draw_offset(&fb);
+    }
+    for (int scale = -1; scale <= 0; scale++) {
+        bool ok = same("ABC", 4, 4, scale);
+        printf("  %s scale %-2d draws nothing\n", ok ? "ok  " : "FAIL", scale);
+        if (!ok) fails++;
+    }
+    bool ok = same("", 4, 4, 2);
+    printf("  %s empty string\n", ok ? "ok  " : "FAIL");
+    if (!ok) fails++;
+    ok = fb_text_width("HELLO", 3) == 90 && fb_text_height(3) == 21;
+    printf("  %s metrics: fb_text_width/height\n", ok ? "ok  " : "FAIL");
+    if (!ok) fails++;
+}
+
+int main(void) {
+    run_depth(4);
+    printf("\n");
+    run_depth(2);
+
+    free(got_buf);
+    free(want_buf);
+    printf("\n%s (%d failure%s, %d cases)\n", fails ? "FAILED" : "PASSED",
+           fails, fails == 1 ? "" : "s", cases);
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,360 @@
+/* Host-side regression for the deadline frame scheduler.
+ *
+ * Runs on the DEV MACHINE with native gcc, not on the device.  No sleeping:
+ * frame_sched_set_clock() swaps in a fake clock that the test advances by hand
+ * to stand for a frame's work, and a "sleep" that jumps it to the deadline.
+ *
+ *   cd native_apps && gcc -Wall -Wextra -Wno-unused-parameter -I common \
+ *       -o build/frame_sched_test tests/frame_sched_test.c \
+ *       common/frame_sched.c && ./build/frame_sched_test
+ *
+ * What it asserts, and why: the point of the scheduler is that the frame's work
+ * is INSIDE the period — 12 ms of work at 33 ms must still be 33 ms begin to
+ * begin, where the old usleep() made it 45.  Then the policies that replaced
+ * each game's hand-written tail: the idle/active choice is the old
+ * `needs_redraw || audio_pump_active()`, the audio slot is never further apart
+ * than its interval however long the wait (snake's 150 ms step), an overrun
+ * drops at most max_skip renders, a long stall drops the missed deadlines
+ * instead of bursting through them, and the statistics are right on a frame
+ * sequence whose answer is known.  Last, the input wait (input_hub.h): it may cut
+ * an idle frame short and must never touch an active one.
+ *
+ * NOT part of build-and-deploy.sh: that script cross-compiles for ARM and this
+ * is a host binary.  Run it by hand after touching common/frame_sched.c.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "frame_sched.h"
+
+static int fails = 0;
+
+static void expect_true(const char *what, bool cond) {
+    if (!cond) { printf("  FAIL %-60s\n", what); fails++; }
+    else       { printf("  ok   %-60s\n", what); }
+}
+
+#define MS(x) ((uint64_t)(x) * 1000000ULL)
+#define ACTIVE_NS 33333000ULL
+
+static uint64_t now_ns = MS(1000);
+static bool slept_backwards = false;
+
+static uint64_t fake_clock(void *user) { (void)user; return now_ns; }
+static void fake_sleep(uint64_t until, void *user) {
+    (void)user;
+    if (until < now_ns) slept_backwards = true;
+    else now_ns = until;
+}
+
+/* The audio slot: when it ran, and what it answers. */
+static bool audio_answer = false;
+static int audio_calls = 0;
+static uint64_t audio_last_ns, audio_max_gap_ns;
+static bool audio_slot(void *user) {
+    (void)user;
+    if (audio_calls && now_ns - audio_last_ns > audio_max_gap_ns)
+        audio_max_gap_ns = now_ns - audio_last_ns;
+    audio_last_ns = now_ns;
+    audio_calls++;
+    return audio_answer;
+}
+
+static void fresh(FrameSched *fs, uint32_t active_us, uint32_t idle_us) {
+    frame_sched_init(fs, active_us, idle_us);
+    frame_sched_set_clock(fs, fake_clock, fake_sleep, NULL);
+    audio_answer = false;
+    audio_calls = 0;
+    audio_max_gap_ns = 0;
+}
+
+/* One frame: `work_ms` of work, a render asked for if `draw`. */
+static bool frame(FrameSched *fs, double work_ms, bool draw) {
+    frame_sched_begin(fs);
+    now_ns += (uint64_t)(work_ms * 1e6);
+    bool drew = draw && frame_sched_render_due(fs);
+    frame_sched_end(fs);
+    return drew;
+}
+
+static void test_deadlines(void) {
+    printf("deadlines\n");
+    FrameSched fs;
+    fresh(&fs, 33333, 100000);
+
+    for (int i = 0; i < 31; i++) frame(&fs, 12, true);
+    FrameStats st;
+    frame_sched_stats(&fs, &st);
+    expect_true("12 ms of work at 33 ms is 33 ms begin to begin, not 45",
+                st.frames == 30 && st.min_us == 33333 && st.max_us == 33333);
+    expect_true("no overruns, nothing skipped", st.overruns == 0 && st.skipped == 0);
+    expect_true("work time is the 12 ms", st.work_avg_us == 12000 && st.work_max_us == 12000);
+
+    frame(&fs, 3, false);            /* the switch: this interval was active */
+    frame_sched_stats_reset(&fs);
+    for (int i = 0; i < 5; i++) frame(&fs, 3, false);
+    frame_sched_stats(&fs, &st);
+    expect_true("a frame with nothing to draw paces at the idle period",
+                st.frames == 5 && st.min_us == 100000 && st.max_us == 100000);
+
+    audio_answer = true;
+    frame_sched_set_audio(&fs, audio_slot, NULL, 0);
+    frame(&fs, 3, false);
+    frame_sched_stats_reset(&fs);
+    for (int i = 0; i < 5; i++) frame(&fs, 3, false);
+    frame_sched_stats(&fs, &st);
+    expect_true("...but active while the audio slot says it owes frames",
+                st.min_us == 33333 && st.max_us == 33333);
+    expect_true("and the slot ran once per frame with no interval", audio_calls == 6);
+
+    /* Jitter in the work does not move the deadlines. */
+    frame_sched_stats_reset(&fs);
+    uint64_t t0 = now_ns;
+    frame_sched_begin(&fs);
+    uint64_t first = now_ns;
+    frame_sched_render_due(&fs);
+    frame_sched_end(&fs);
+    double jitter[] = { 1, 30, 5, 22, 0.5, 31 };
+    for (int i = 0; i < 6; i++) frame(&fs, jitter[i], true);
+    frame_sched_begin(&fs);
+    expect_true("frame starts stay on the grid whatever the work",
+                now_ns - first == 7 * ACTIVE_NS && t0 == first);
+    frame_sched_end(&fs);
+    expect_true("and the sleep never goes backwards", !slept_backwards);
+}
+
+static void test_audio_slices(void) {
+    printf("audio slot\n");
+    FrameSched fs;
+    fresh(&fs, 33333, 100000);
+    frame_sched_set_audio(&fs, audio_slot, NULL, 27000);
+    for (int i = 0; i < 20; i++) frame(&fs, 4, false);
+    expect_true("through a 100 ms idle wait the slot is never > 27 ms apart",
+                audio_max_gap_ns <= MS(27));
+    expect_true("and it still ran at least once per frame", audio_calls >= 20);
+
+    /* Snake: the period is the step, set every frame. */
+    fresh(&fs, 33333, 100000);
+    frame_sched_set_audio(&fs, audio_slot, NULL, 27000);
+    frame_sched_set_rate(&fs, 150000, 150000);
+    for (int i = 0; i < 11; i++) frame(&fs, 8, true);
+    FrameStats st;
+    frame_sched_stats(&fs, &st);
+    expect_true("a 150 ms step keeps exact time", st.min_us == 150000 && st.max_us == 150000);
+    expect_true("with the stream fed every 27 ms inside it", audio_max_gap_ns <= MS(27));
+}
+
+/* frame_sched_tick()'s slots: dirty when told, work that takes a set time. */
+static int tick_dirty, tick_renders;
+static double tick_work_ms;
+static bool tick_update(void *user) {
+    (void)user;
+    now_ns += (uint64_t)(tick_work_ms * 1e6);
+    bool d = tick_dirty;
+    tick_dirty = 0;
+    return d;
+}
+static void tick_render(void *user) { (void)user; tick_renders++; }
+
+static void test_skip(void) {
+    printf("frame skip\n");
+    FrameSched fs;
+    fresh(&fs, 33333, 100000);
+
+    frame(&fs, 10, true);
+    frame(&fs, 45, true);            /* overruns its slot */
+    FrameStats st;
+    frame_sched_stats(&fs, &st);
+    expect_true("a frame past its deadline is an overrun", st.overruns == 1);
+    expect_true("the next render is dropped", !frame(&fs, 5, true));
+    expect_true("and the one after runs once the loop caught up", frame(&fs, 5, true));
+
+    /* A loop that can never keep up still shows one frame in max_skip + 1. */
+    fresh(&fs, 33333, 100000);
+    int drawn = 0;
+    for (int i = 0; i < 30; i++) drawn += frame(&fs, 40, true);
+    frame_sched_stats(&fs, &st);
+    expect_true("a loop that never keeps up draws one frame in three",
+                drawn == 10 && st.skipped == 20);
+
+    fresh(&fs, 33333, 100000);
+    frame_sched_set_skip(&fs, 0);
+    drawn = 0;
+    for (int i = 0; i < 10; i++) drawn += frame(&fs, 40, true);
+    expect_true("max_skip 0 never drops a render", drawn == 10);
+
+    /* A stall of several periods is dropped, not replayed. */
+    fresh(&fs, 33333, 100000);
+    frame(&fs, 5, true);
+    frame(&fs, 200, true);           /* ~6 periods */
+    frame_sched_begin(&fs);
+    uint64_t b1 = now_ns;
+    now_ns += MS(5);
+    frame_sched_render_due(&fs);
+    frame_sched_end(&fs);
+    frame_sched_begin(&fs);
+    expect_true("after a 200 ms stall the next frame is a full period later",
+                now_ns - b1 == ACTIVE_NS);
+    frame_sched_end(&fs);
+
+    /* tick(): a render skipped after an overrun is owed, and drawn next. */
+    fresh(&fs, 33333, 100000);
+    tick_dirty = 1;
+    tick_renders = 0;
+    FrameSlots slots = { tick_update, tick_render };
+    tick_work_ms = 50;
+    frame_sched_tick(&fs, &slots, NULL);        /* dirty, drawn, overruns */
+    tick_work_ms = 2;
+    tick_dirty = 1;
+    frame_sched_tick(&fs, &slots, NULL);        /* dirty, skipped */
+    expect_true("tick(): a render skipped after an overrun is not drawn",
+                tick_renders == 1);
+    frame_sched_tick(&fs, &slots, NULL);        /* clean, but owed */
+    expect_true("but is owed, and drawn on the next frame though it is clean",
+                tick_renders == 2);
+    frame_sched_tick(&fs, &slots, NULL);
+    expect_true("and only once", tick_renders == 2);
+}
+
+static void test_stats(void) {
+    printf("statistics\n");
+    FrameSched fs;
+    fresh(&fs, 1000, 1000);          /* 1 ms periods: work sets the frame time */
+    frame_sched_set_skip(&fs, 0);
+    frame_sched_begin(&fs);
+    /* 200 frames: 196 of 20 ms, 2 of 40 ms, 2 of 90 ms. */
+    for (int i = 0; i < 200; i++) {
+        now_ns += MS(i < 196 ? 20 : i < 198 ? 40 : 90);
+        frame_sched_end(&fs);
+        frame_sched_begin(&fs);
+    }
+    FrameStats st;
+    frame_sched_stats(&fs, &st);
+    expect_true("min and max are exact", st.min_us == 20000 && st.max_us == 90000);
+    expect_true("avg is exact", st.avg_us == (196 * 20000u + 2 * 40000u + 2 * 90000u) / 200);
+    expect_true("p99 is the 198th of 200: the 40 ms bin's upper edge",
+                st.p99_us == 41000);
+
+    char line[200];
+    frame_stats_format(&st, line, sizeof(line));
+    expect_true("the log line carries the numbers",
+                strstr(line, "200 frames") && strstr(line, "20.0/20.9/41.0/90.0 ms"));
+}
+
+static int reports;
+static FrameStats last_report;
+static void on_report(const FrameStats *st, void *user) {
+    (void)user;
+    reports++;
+    last_report = *st;
+}
+
+static void test_report(void) {
+    printf("report\n");
+    FrameSched fs;
+    fresh(&fs, 33333, 100000);
+    frame_sched_set_report(&fs, 1000, on_report, NULL);
+    for (int i = 0; i < 31; i++) frame(&fs, 2, true);   /* 30 intervals: 999.99 ms */
+    expect_true("nothing reported before the window closes", reports == 0);
+    frame(&fs, 2, true);
+    expect_true("one report once a second has passed", reports == 1);
+    expect_true("covering the window's frames", last_report.frames == 31);
+    FrameStats st;
+    frame_sched_stats(&fs, &st);
+    expect_true("and the window starts again", st.frames == 0);
+
+    /* resync: a deliberate block is not a frame. */
+    fresh(&fs, 33333, 100000);
+    for (int i = 0; i < 4; i++) frame(&fs, 2, true);
+    frame_sched_resync(&fs);
+    now_ns += MS(60000);             /* the launcher waiting on a child */
+    for (int i = 0; i < 4; i++) frame(&fs, 2, true);
+    frame_sched_stats(&fs, &st);
+    expect_true("after resync a 60 s wait is neither a frame nor an overrun",
+                st.max_us == 33333 && st.overruns == 0 && st.frames == 6);
+}
+
+/* The wait hook: input "arrives" at wake_at_ns, if that is before the deadline. */
+static uint64_t wake_at_ns = 0;
+static int wait_calls = 0;
+static bool fake_wait(uint64_t until, void *user) {
+    (void)user;
+    wait_calls++;
+    if (wake_at_ns && wake_at_ns > now_ns && wake_at_ns < until) {
+        now_ns = wake_at_ns;
+        wake_at_ns = 0;
+        return true;
+    }
+    fake_sleep(until, user);
+    return false;
+}
+
+static void test_wake(void) {
+    printf("wake on input\n");
+    FrameSched fs;
+    FrameStats st;
+    char line[200];
+    fresh(&fs, 33333, 100000);
+    frame_sched_set_wait(&fs, fake_wait, NULL);
+    wait_calls = 0;
+
+    frame(&fs, 3, false);
+    frame_sched_stats_reset(&fs);
+    uint64_t start = now_ns;
+    frame_sched_begin(&fs);
+    now_ns += MS(3);
+    wake_at_ns = now_ns + MS(20);
+    frame_sched_end(&fs);
+    expect_true("input 20 ms into an idle wait ends the frame then, not at 100 ms",
+                now_ns - start == MS(23));
+    frame(&fs, 3, false);
+    frame_sched_begin(&fs);
+    frame_sched_stats(&fs, &st);
+    expect_true("and the next idle slot runs a full period from the wake",
+                now_ns - start == MS(23) + MS(100) && st.woken == 1);
+    frame_sched_end(&fs);
+
+    frame(&fs, 3, true);             /* the switch: this interval was active */
+    int calls = wait_calls;
+    frame_sched_stats_reset(&fs);
+    wake_at_ns = now_ns + MS(10);
+    frame(&fs, 3, true);
+    frame(&fs, 3, true);
+    frame_sched_stats(&fs, &st);
+    expect_true("an ACTIVE frame never calls the hook: input does not set the pace",
+                wait_calls == calls && st.woken == 0 && st.max_us == 33333);
+    wake_at_ns = 0;
+
+    fresh(&fs, 33333, 100000);
+    frame_sched_set_wait(&fs, fake_wait, NULL);
+    frame_sched_set_audio(&fs, audio_slot, NULL, 27000);
+    frame(&fs, 3, false);
+    audio_calls = 0;
+    frame_sched_begin(&fs);
+    start = now_ns;
+    wake_at_ns = start + MS(40);
+    frame_sched_end(&fs);
+    expect_true("a sliced idle wait is cut mid-slice, audio serviced on the way",
+                now_ns - start == MS(40) && audio_calls == 2);
+
+    frame_sched_stats(&fs, &st);
+    frame_stats_format(&st, line, sizeof(line));
+    expect_true("the report line says how many waits input cut short",
+                strstr(line, "; 1 woken by input") != NULL);
+    frame_sched_stats_reset(&fs);
+    frame_sched_stats(&fs, &st);
+    frame_stats_format(&st, line, sizeof(line));
+    expect_true("and says nothing when none were", strstr(line, "woken") == NULL);
+}
+
+int main(void) {
+    test_deadlines();
+    test_audio_slices();
+    test_skip();
+    test_stats();
+    test_report();
+    test_wake();
+    printf("\n%s (%d failure%s)\n", fails ? "FAILED" : "PASSED",
+           fails, fails == 1 ? "" : "s");
+    return fails ? 1 : 0;
+}
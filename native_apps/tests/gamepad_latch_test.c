@@ -9,8 +9,9 @@
  *
  *   cd native_apps && gcc -Wall -Wextra -Wno-unused-parameter -I common \
  *       -o build/gamepad_latch_test tests/gamepad_latch_test.c \
- *       common/gamepad.c common/framebuffer.c common/hardware.c \
- *       common/config.c common/touch_input.c -lm && ./build/gamepad_latch_test
+ *       common/gamepad.c common/input_hotplug.c common/framebuffer.c \
+ *       common/hardware.c common/config.c common/touch_input.c -lm \
+ *       && ./build/gamepad_latch_test
  *
  * The bug: `.held` used to be *stored* in the caller's InputState, written
  * directly by every source and cleared by none.  For the event-driven sources
@@ -41,6 +42,7 @@
 #include <string.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <sys/stat.h>
 #include <linux/input.h>
 #include "gamepad.h"
 
@@ -314,6 +316,39 @@ static void test_sources_or_together(void) {
     gamepad_close(&gm);
 }
 
+/* ═══ 6. The hotplug watcher closing is a device change ═════════════════════
+ *
+ * Not held state, but the same manager and no device needed: input_hub puts
+ * the watcher's fd in its epoll set beside the three device fds, and a caller
+ * re-tracks only when devices_changed moves.  When the watch goes away
+ * (IN_IGNORED — here, its directory removed) input_hotplug closes the fd, and
+ * the hub would otherwise keep waiting on a file that no longer exists. */
+#define HP_DIR "/tmp/rw_gamepad_test_hotplug"
+
+static void test_watcher_close_counts(void) {
+    printf("\nHotplug watcher: its closing bumps devices_changed\n");
+
+    GamepadManager gm;
+    InputState st;
+    manager_init(&gm);
+    memset(&st, 0, sizeof(st));
+
+    rmdir(HP_DIR);
+    mkdir(HP_DIR, 0777);
+    expect_bool("watching a scratch directory",
+                input_hotplug_open(&gm.hotplug, HP_DIR) == 0, true);
+    uint32_t before = gm.devices_changed;
+    gamepad_poll(&gm, &st, 0, 0, false);
+    expect_bool("nothing happened: devices_changed still", gm.devices_changed == before, true);
+
+    rmdir(HP_DIR);                              /* IN_DELETE_SELF, IN_IGNORED */
+    gamepad_poll(&gm, &st, 0, 0, false);
+    expect_bool("the watch gone: its fd closed", gm.hotplug.fd < 0, true);
+    expect_bool("and devices_changed moved", gm.devices_changed != before, true);
+
+    gamepad_close(&gm);
+}
+
 int main(void) {
     printf("gamepad held-state regression (latched events vs per-frame positions)\n");
 
@@ -322,6 +357,7 @@ int main(void) {
     test_stick_releases();
     test_unplug_clears();
     test_sources_or_together();
+    test_watcher_close_counts();
 
     printf("\n%s (%d failure%s)\n", fails ? "FAILED" : "PASSED",
            fails, fails == 1 ? "" : "s");
@@ -12,7 +12,7 @@
  * Put this directory FIRST on the include path (`-Itests/hostshim`) and
  * `common/audio.c` compiles unmodified on host gcc.  Nothing here is deployed and
  * nothing in `common/` knows it exists; `common/audio_out.c` solves the same
- * problem the other way, with an `__has_include` split (audio_out.c:465-478),
+ * problem the other way, with an `__has_include` split (audio_out.c:536-543),
  * because it must also *drop* the device code.  audio.c must keep it — the tests
  * that use this shim never open /dev/dsp, they build an `Audio` by hand.
  */
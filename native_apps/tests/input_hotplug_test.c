@@ -0,0 +1,158 @@
+/* Host-side regression for the /dev/input hotplug watcher
+ * (common/input_hotplug.h).
+ *
+ * Runs on the DEV MACHINE with native gcc, not on the device.  It watches a
+ * scratch directory rather than /dev/input: inotify does not care whether
+ * the names it reports are device nodes, and plain files can be created and
+ * renamed without root.
+ *
+ *   cd native_apps && gcc -Wall -Wextra -Wno-unused-parameter -I common \
+ *       -o build/input_hotplug_test tests/input_hotplug_test.c \
+ *       common/input_hotplug.c && ./build/input_hotplug_test
+ *
+ * What it asserts, and why: nothing is reported for nodes that existed before
+ * the watch (the caller's own scan found those); a created event node is
+ * reported with its full path, and so is the mode change after it — the
+ * caller tells the two apart with input_hotplug_same_node(), which is checked
+ * here too; a node renamed into place counts as created; js*, mouse*, the
+ * by-id directory and anything that is not "event" plus digits are not
+ * reported at all; a burst of creates between two polls is reported whole and
+ * in order; and when the watch itself goes away, or cannot be had to begin
+ * with, the caller is told to RESCAN — once, then on the fallback timer.
+ *
+ * Not covered: IN_Q_OVERFLOW (it takes max_queued_events creates to provoke),
+ * and gamepad.c's use of it, which needs real evdev nodes to classify.
+ *
+ * NOT part of build-and-deploy.sh: that script cross-compiles for ARM and this
+ * is a host binary.  Run it by hand after touching common/input_hotplug.c.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "input_hotplug.h"
+
+#define HP_DIR "/tmp/input_hotplug_test"
+
+static int fails = 0;
+
+static void expect_true(const char *what, bool cond) {
+    if (!cond) { printf("  FAIL %-60s\n", what); fails++; }
+    else       { printf("  ok   %-60s\n", what); }
+}
+
+static void touch_file(const char *name) {
+    char path[128];
+    snprintf(path, sizeof(path), HP_DIR "/%s", name);
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd >= 0) close(fd);
+}
+
+static void cleanup(void) {
+    static const char *names[] = {
+        "event0", "event3", "event7", "event11", "event12", "event13", ".tmp-node",
+        "mouse0", "js0", "mice", "event", "event1a",
+    };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        char path[128];
+        snprintf(path, sizeof(path), HP_DIR "/%s", names[i]);
+        unlink(path);
+    }
+    rmdir(HP_DIR "/by-id");
+    rmdir(HP_DIR);
+}
+
+static void test_watch(void) {
+    printf("reporting new nodes\n");
+    cleanup();
+    mkdir(HP_DIR, 0777);
+    touch_file("event0");                           /* there before the watch */
+
+    InputHotplug hp;
+    char path[128];
+    expect_true("open", input_hotplug_open(&hp, HP_DIR) == 0 && hp.fd >= 0);
+    expect_true("nodes that were already there are not reported",
+                input_hotplug_next(&hp, path, sizeof(path)) == INPUT_HOTPLUG_NONE);
+
+    touch_file("event3");
+    expect_true("a created event node is reported",
+                input_hotplug_next(&hp, path, sizeof(path)) == INPUT_HOTPLUG_ADDED &&
+                strcmp(path, HP_DIR "/event3") == 0);
+    expect_true("once", input_hotplug_next(&hp, path, sizeof(path)) == INPUT_HOTPLUG_NONE);
+
+    int held = open(HP_DIR "/event3", O_RDONLY);
+    chmod(HP_DIR "/event3", 0660);                  /* what mdev does next */
+    expect_true("the mode change after it is reported too",
+                input_hotplug_next(&hp, path, sizeof(path)) == INPUT_HOTPLUG_ADDED &&
+                strcmp(path, HP_DIR "/event3") == 0);
+    expect_true("and same_node() says the caller already holds it",
+                input_hotplug_same_node(held, path));
+
+    touch_file(".tmp-node");
+    rename(HP_DIR "/.tmp-node", HP_DIR "/event7");
+    expect_true("a node renamed into place counts",
+                input_hotplug_next(&hp, path, sizeof(path)) == INPUT_HOTPLUG_ADDED &&
+                strcmp(path, HP_DIR "/event7") == 0);
+    expect_true("and is a different node", !input_hotplug_same_node(held, path));
+    expect_true("same_node() of no fd, or of no node, is false",
+                !input_hotplug_same_node(-1, HP_DIR "/event3") &&
+                !input_hotplug_same_node(held, HP_DIR "/event99"));
+    close(held);
+
+    touch_file("mouse0");
+    touch_file("js0");
+    touch_file("mice");
+    touch_file("event");
+    touch_file("event1a");
+    mkdir(HP_DIR "/by-id", 0777);
+    expect_true("other views of a device and near-miss names are not",
+                input_hotplug_next(&hp, path, sizeof(path)) == INPUT_HOTPLUG_NONE);
+
+    touch_file("event11");
+    touch_file("event12");
+    touch_file("event13");
+    bool got11 = input_hotplug_next(&hp, path, sizeof(path)) == INPUT_HOTPLUG_ADDED &&
+                 strcmp(path, HP_DIR "/event11") == 0;
+    bool got12 = input_hotplug_next(&hp, path, sizeof(path)) == INPUT_HOTPLUG_ADDED &&
+                 strcmp(path, HP_DIR "/event12") == 0;
+    bool got13 = input_hotplug_next(&hp, path, sizeof(path)) == INPUT_HOTPLUG_ADDED &&
+                 strcmp(path, HP_DIR "/event13") == 0;
+    expect_true("a burst between polls comes whole and in order", got11 && got12 && got13);
+    expect_true("then nothing", input_hotplug_next(&hp, path, sizeof(path)) == INPUT_HOTPLUG_NONE);
+
+    cleanup();                                      /* removes the watched dir */
+    expect_true("the watch going away asks for a rescan",
+                input_hotplug_next(&hp, path, sizeof(path)) == INPUT_HOTPLUG_RESCAN &&
+                hp.fd < 0);
+    expect_true("once, and then the fallback timer",
+                input_hotplug_next(&hp, path, sizeof(path)) == INPUT_HOTPLUG_NONE);
+    input_hotplug_close(&hp);
+}
+
+static void test_fallback(void) {
+    printf("without a watch\n");
+    cleanup();
+    InputHotplug hp;
+    char path[128];
+    expect_true("a missing directory cannot be watched",
+                input_hotplug_open(&hp, HP_DIR) == -1 && hp.fd == -1);
+    expect_true("no rescan before the interval",
+                input_hotplug_next(&hp, path, sizeof(path)) == INPUT_HOTPLUG_NONE);
+    hp.last_scan_ms -= INPUT_HOTPLUG_RESCAN_MS;     /* as if it had passed */
+    expect_true("one when it is due",
+                input_hotplug_next(&hp, path, sizeof(path)) == INPUT_HOTPLUG_RESCAN);
+    expect_true("and the timer restarts",
+                input_hotplug_next(&hp, path, sizeof(path)) == INPUT_HOTPLUG_NONE);
+    input_hotplug_close(&hp);
+    expect_true("close is safe on it", hp.fd == -1);
+}
+
+int main(void) {
+    test_watch();
+    test_fallback();
+    printf("\n%s (%d failure%s)\n", fails ? "FAILED" : "PASSED",
+           fails, fails == 1 ? "" : "s");
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,241 @@
+/* Host-side regression for the idle-frame input wait (common/input_hub.h).
+ *
+ * Runs on the DEV MACHINE with native gcc, not on the device.  Real fds, not
+ * a fake wait: pipes stand in for the evdev nodes, because epoll reports a
+ * pipe's read end readable by the same rules, and frame_sched_test.c already
+ * covers what the scheduler does with the answer.
+ *
+ *   cd native_apps && gcc -Wall -Wextra -Wno-unused-parameter -I common \
+ *       -o build/input_hub_test tests/input_hub_test.c \
+ *       common/input_hub.c && ./build/input_hub_test
+ *
+ * What it asserts, and why: a pipe already readable ends the wait at once,
+ * and one written from another process mid-wait ends it then — both well
+ * before the deadline, with the source recorded; an empty one times out with
+ * false, neither before the deadline nor more than TIMER_SLACK_MS after it,
+ * because a wait that overshoots is an overrun frame_sched counts; EPOLLET
+ * reports an arrival once — an fd left undrained does not end the next wait
+ * (that is the 100 % CPU spin the header warns about) — and rearms once it has
+ * been drained and written again; a GamepadManager's hotplug watcher is
+ * tracked as INPUT_SRC_HOTPLUG; and a hub with nothing registered, or no hub
+ * at all, still sleeps to the deadline.
+ *
+ * ⚠️ Timing bounds are loose on purpose (TIMER_SLACK_MS): a loaded dev
+ * machine schedules late, and this is a check that the wait is to the
+ * deadline, not a benchmark of how close.
+ *
+ * NOT part of build-and-deploy.sh: that script cross-compiles for ARM and this
+ * is a host binary.  Run it by hand after touching common/input_hub.c.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "input_hub.h"
+
+#define WAIT_MS        60
+#define TIMER_SLACK_MS 15
+
+static int fails = 0;
+
+static void expect_true(const char *what, bool cond) {
+    if (!cond) { printf("  FAIL %-60s\n", what); fails++; }
+    else       { printf("  ok   %-60s\n", what); }
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t ms_ns(int ms) { return (uint64_t)ms * 1000000ULL; }
+
+static void put(int fd) {
+    char c = 'x';
+    if (write(fd, &c, 1) != 1) perror("write");
+}
+
+static void drain(int fd) {
+    char buf[64];
+    /* Only ever a few bytes in the pipe, and never a read on an empty one:
+     * the read end is blocking. */
+    if (read(fd, buf, sizeof(buf)) < 0) perror("read");
+}
+
+/* Returns the wait's result; *late_ms is how far past `until` it returned,
+ * negative if it came back early. */
+static bool timed_wait(InputHub *hub, uint64_t until, long *late_ms) {
+    bool r = input_hub_wait(until, hub);
+    *late_ms = (long)((int64_t)(now_ns() - until) / 1000000LL);
+    return r;
+}
+
+static void test_readable(void) {
+    printf("input ends the wait\n");
+    int p[2];
+    if (pipe(p) != 0) { perror("pipe"); exit(1); }
+
+    InputHub hub;
+    expect_true("init", input_hub_init(&hub) == 0 && hub.epfd >= 0);
+    input_hub_track(&hub, p[0], NULL);
+    expect_true("the touch fd is registered, nothing else",
+                hub.watched == 1 && hub.fd[INPUT_SRC_TOUCH] == p[0]);
+
+    long late;
+    put(p[1]);
+    uint64_t until = now_ns() + ms_ns(WAIT_MS);
+    expect_true("an fd readable before the wait returns true",
+                timed_wait(&hub, until, &late));
+    expect_true("at once, well before the deadline", late < -(WAIT_MS / 2));
+    expect_true("counted, with its source",
+                hub.wakes == 1 && hub.last_src == INPUT_SRC_TOUCH &&
+                hub.last_wake_ns != 0);
+    drain(p[0]);
+
+    /* Data arriving DURING the wait — the case the hub exists for.  A child
+     * process writes it; no pthread on the device, none here. */
+    pid_t pid = fork();
+    if (pid == 0) {
+        usleep(WAIT_MS * 1000 / 4);
+        put(p[1]);
+        _exit(0);
+    }
+    uint64_t t0 = now_ns();
+    until = t0 + ms_ns(WAIT_MS * 4);
+    bool woke = timed_wait(&hub, until, &late);
+    long took = (long)((now_ns() - t0) / 1000000ULL);
+    waitpid(pid, NULL, 0);
+    expect_true("input arriving mid-wait returns true", woke && hub.wakes == 2);
+    expect_true("when it arrives, not at the deadline",
+                took >= WAIT_MS / 4 - 1 && late < -WAIT_MS);
+    drain(p[0]);
+
+    input_hub_close(&hub);
+    expect_true("close leaves nothing registered",
+                hub.epfd == -1 && hub.watched == 0 && hub.fd[INPUT_SRC_TOUCH] == -1);
+    close(p[0]);
+    close(p[1]);
+}
+
+static void test_timeout(void) {
+    printf("\nno input: the deadline, no later\n");
+    int p[2];
+    if (pipe(p) != 0) { perror("pipe"); exit(1); }
+
+    InputHub hub;
+    input_hub_init(&hub);
+    input_hub_track(&hub, p[0], NULL);
+
+    long late;
+    uint64_t until = now_ns() + ms_ns(WAIT_MS);
+    expect_true("an empty fd times out with false", !timed_wait(&hub, until, &late));
+    expect_true("not before the deadline", late >= 0);
+    expect_true("and not overshooting it", late <= TIMER_SLACK_MS);
+    expect_true("not counted as a wake", hub.wakes == 0);
+
+    /* Under a millisecond left: epoll_wait(0) polls, the remainder is slept. */
+    until = now_ns() + 400000ULL;
+    expect_true("a sub-millisecond wait times out too",
+                !timed_wait(&hub, until, &late) && late >= 0 && late <= TIMER_SLACK_MS);
+
+    /* A deadline already behind: returns at once, no sleep. */
+    until = now_ns() - ms_ns(5);
+    expect_true("a deadline already past returns at once",
+                !timed_wait(&hub, until, &late) && late <= 5 + TIMER_SLACK_MS);
+
+    input_hub_close(&hub);
+    close(p[0]);
+    close(p[1]);
+}
+
+static void test_edge(void) {
+    printf("\nedge-triggered: one report per arrival\n");
+    int p[2];
+    if (pipe(p) != 0) { perror("pipe"); exit(1); }
+
+    InputHub hub;
+    input_hub_init(&hub);
+    input_hub_track(&hub, p[0], NULL);
+
+    long late;
+    put(p[1]);
+    expect_true("the arrival ends one wait",
+                timed_wait(&hub, now_ns() + ms_ns(WAIT_MS), &late));
+    expect_true("left undrained, it does not end the next",
+                !timed_wait(&hub, now_ns() + ms_ns(WAIT_MS), &late) && late >= 0);
+
+    drain(p[0]);
+    expect_true("drained and nothing new: still a timeout",
+                !timed_wait(&hub, now_ns() + ms_ns(WAIT_MS), &late));
+    put(p[1]);
+    expect_true("drained, the next arrival rearms it",
+                timed_wait(&hub, now_ns() + ms_ns(WAIT_MS), &late) && late < 0);
+    expect_true("two wakes in all", hub.wakes == 2);
+    drain(p[0]);
+
+    input_hub_close(&hub);
+    close(p[0]);
+    close(p[1]);
+}
+
+static void test_sources(void) {
+    printf("\nwhat is tracked\n");
+    int touch[2], hp[2];
+    if (pipe(touch) != 0 || pipe(hp) != 0) { perror("pipe"); exit(1); }
+
+    /* Only the fields track() reads: no real devices, the watcher a pipe. */
+    GamepadManager gm;
+    memset(&gm, 0, sizeof(gm));
+    gm.gamepad_fd = gm.keyboard_fd = gm.mouse_fd = -1;
+    gm.hotplug.fd = hp[0];
+
+    InputHub hub;
+    input_hub_init(&hub);
+    input_hub_track(&hub, touch[0], &gm);
+    expect_true("touch and the hotplug watcher, the closed pads skipped",
+                hub.watched == 2 && hub.fd[INPUT_SRC_HOTPLUG] == hp[0] &&
+                hub.fd[INPUT_SRC_GAMEPAD] == -1);
+
+    long late;
+    put(hp[1]);
+    expect_true("a new /dev/input node ends the wait as HOTPLUG",
+                timed_wait(&hub, now_ns() + ms_ns(WAIT_MS), &late) &&
+                hub.last_src == INPUT_SRC_HOTPLUG);
+    drain(hp[0]);
+
+    /* The watcher gone (gm.hotplug.fd = -1 after IN_IGNORED): re-tracking
+     * drops it rather than keeping a stale registration. */
+    gm.hotplug.fd = -1;
+    input_hub_track(&hub, touch[0], &gm);
+    expect_true("re-tracking drops a watcher that has closed",
+                hub.watched == 1 && hub.fd[INPUT_SRC_HOTPLUG] == -1);
+
+    input_hub_track(&hub, -1, NULL);
+    uint64_t until = now_ns() + ms_ns(WAIT_MS / 2);
+    expect_true("nothing registered: sleeps to the deadline",
+                hub.watched == 0 && !timed_wait(&hub, until, &late) &&
+                late >= 0 && late <= TIMER_SLACK_MS);
+
+    input_hub_close(&hub);
+    until = now_ns() + ms_ns(WAIT_MS / 2);
+    bool r = input_hub_wait(until, NULL);
+    late = (long)((int64_t)(now_ns() - until) / 1000000LL);
+    expect_true("no hub at all: the plain sleep",
+                !r && late >= 0 && late <= TIMER_SLACK_MS);
+
+    close(touch[0]); close(touch[1]);
+    close(hp[0]);    close(hp[1]);
+}
+
+int main(void) {
+    test_readable();
+    test_timeout();
+    test_edge();
+    test_sources();
+    printf("\n%s (%d failure%s)\n", fails ? "FAILED" : "PASSED",
+           fails, fails == 1 ? "" : "s");
+    return fails ? 1 : 0;
+}
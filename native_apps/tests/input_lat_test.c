@@ -0,0 +1,231 @@
+/* Host-side regression for the input-to-photon latency tracer
+ * (common/input_lat.h).
+ *
+ * Runs on the DEV MACHINE with native gcc, not on the device.  The tracer
+ * reads the wall clock against the event's own timestamp, so the events below
+ * are stamped in the past rather than slept for, and the run is instant.
+ *
+ *   cd native_apps && gcc -Wall -Wextra -Wno-unused-parameter -I common \
+ *       -o build/input_lat_test tests/input_lat_test.c common/input_lat.c \
+ *       common/framebuffer.c common/hardware.c common/config.c \
+ *       common/touch_input.c -lm && ./build/input_lat_test
+ *
+ * What it asserts, and why: the histogram bins by the millisecond and its
+ * percentiles are bin upper edges clamped to the slowest sample, as
+ * audio_lat's are; merge is addition; an event then a swap gives one sample
+ * of the right size, and only the FIRST event of a frame sets the stamp (the
+ * oldest unpresented input is the one that waited); a SYN alone is not input;
+ * a swap a second late is stale, not binned; input_lat_drop() forgets the
+ * marker; an input stamped in the future (a clock step) is discarded; the
+ * published file is the window merged over what an earlier run left, and a
+ * file that is not a histogram is refused; and fb_swap() itself is the present
+ * — a single-buffered Framebuffer included, a Surface with no panel not.
+ *
+ * NOT part of build-and-deploy.sh: that script cross-compiles for ARM and this
+ * is a host binary.  Run it by hand after touching common/input_lat.c.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include "input_lat.h"
+#include "framebuffer.h"
+
+#define LAT_DIR "/tmp/input_lat_test"
+
+static int fails = 0;
+
+static void expect_true(const char *what, bool cond) {
+    if (!cond) { printf("  FAIL %-60s\n", what); fails++; }
+    else       { printf("  ok   %-60s\n", what); }
+}
+
+static uint64_t wall_us(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint64_t)tv.tv_sec * 1000000ULL + (uint64_t)tv.tv_usec;
+}
+
+/* An event whose kernel timestamp is `ago_us` before now. */
+static void event_ago(int type, int code, int value, int64_t ago_us) {
+    uint64_t at = wall_us() - ago_us;
+    struct input_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.time.tv_sec  = (time_t)(at / 1000000ULL);
+    ev.time.tv_usec = (suseconds_t)(at % 1000000ULL);
+    ev.type = type; ev.code = code; ev.value = value;
+    input_lat_event(&ev);
+}
+
+static void test_hist(void) {
+    printf("histogram, stats and format\n");
+    InputLatHist h;
+    input_lat_hist_reset(&h);
+    InputLatStats st;
+    input_lat_hist_stats(&h, &st);
+    expect_true("empty histogram is all zeros", st.count == 0 && st.p95_us == 0 && st.max_us == 0);
+
+    for (int i = 0; i < 19; i++) input_lat_hist_add(&h, 10400);   /* bin 10 */
+    input_lat_hist_add(&h, 87300);                                /* bin 87 */
+    input_lat_hist_add(&h, 999000);                               /* the last bin */
+    expect_true("bins by the millisecond",
+                h.hist[10] == 19 && h.hist[87] == 1 && h.hist[INPUT_LAT_BINS - 1] == 1);
+    input_lat_hist_stats(&h, &st);
+    expect_true("count, min, max", st.count == 21 && st.min_us == 10400 && st.max_us == 999000);
+    expect_true("p50 is the bin's upper edge", st.p50_us == 11000);
+    expect_true("p95 reaches the slow tail", st.p95_us == 88000);
+    expect_true("avg from the exact sum",
+                st.avg_us == (uint32_t)((19ull * 10400 + 87300 + 999000) / 21));
+
+    InputLatHist one;
+    input_lat_hist_reset(&one);
+    input_lat_hist_add(&one, 5200);
+    input_lat_hist_stats(&one, &st);
+    expect_true("an edge never passes the slowest sample", st.p50_us == 5200 && st.p95_us == 5200);
+
+    InputLatHist m;
+    input_lat_hist_reset(&m);
+    m.stale = 2;
+    input_lat_hist_merge(&m, &h);
+    input_lat_hist_merge(&m, &one);
+    expect_true("merge adds counts, bins and stale",
+                m.count == 22 && m.hist[5] == 1 && m.hist[10] == 19 && m.stale == 2 &&
+                m.min_us == 5200 && m.max_us == 999000 && m.sum_us == h.sum_us + 5200);
+
+    input_lat_hist_stats(&h, &st);
+    char buf[160];
+    input_lat_format(&st, buf, sizeof(buf));
+    expect_true("format reads in ms",
+                strstr(buf, "21 inputs, 0 stale") && strstr(buf, "10.4/") && strstr(buf, "/999.0 ms"));
+}
+
+static void test_tracer(void) {
+    printf("the tracer\n");
+    input_lat_open(NULL, "tracer");
+    InputLatHist w;
+
+    input_lat_present();
+    input_lat_window(&w);
+    expect_true("a swap with no input is not a sample", w.count == 0 && w.stale == 0);
+
+    event_ago(EV_SYN, SYN_REPORT, 0, 30000);
+    input_lat_present();
+    input_lat_window(&w);
+    expect_true("a SYN alone is not input", w.count == 0);
+
+    event_ago(EV_ABS, ABS_X, 100, 40000);
+    event_ago(EV_ABS, ABS_X, 120, 5000);          /* the same frame, fresher */
+    event_ago(EV_SYN, SYN_REPORT, 0, 5000);
+    input_lat_present();
+    input_lat_window(&w);
+    expect_true("event then swap is one sample", w.count == 1);
+    expect_true("measured from the FIRST input of the frame",
+                w.min_us >= 40000 && w.min_us < 60000);
+    input_lat_present();
+    input_lat_window(&w);
+    expect_true("and the marker is cleared by it", w.count == 1);
+
+    event_ago(EV_KEY, BTN_TOUCH, 1, 1500000);
+    input_lat_present();
+    input_lat_window(&w);
+    expect_true("a swap a second late is stale, not binned", w.count == 1 && w.stale == 1);
+
+    event_ago(EV_REL, REL_X, 3, 20000);
+    input_lat_drop();
+    input_lat_present();
+    input_lat_window(&w);
+    expect_true("drop forgets the marker", w.count == 1 && w.stale == 1);
+
+    event_ago(EV_KEY, KEY_A, 1, -5000000);       /* stamped 5 s ahead */
+    input_lat_present();
+    input_lat_window(&w);
+    expect_true("a stamp from the future is discarded", w.count == 1 && w.stale == 1);
+
+    input_lat_open(NULL, "tracer");
+    input_lat_window(&w);
+    expect_true("open starts a fresh window", w.count == 0 && w.stale == 0);
+}
+
+static void test_file(void) {
+    printf("publishing\n");
+    mkdir(LAT_DIR, 0777);
+    unlink(LAT_DIR "/pub");
+
+    InputLatHist earlier;
+    input_lat_hist_reset(&earlier);
+    for (int i = 0; i < 3; i++) input_lat_hist_add(&earlier, 70000);
+    earlier.stale = 4;
+    expect_true("save", input_lat_save(LAT_DIR "/pub", "pub", &earlier) == 0);
+
+    input_lat_open(LAT_DIR, "pub");
+    event_ago(EV_KEY, BTN_TOUCH, 1, 20000);
+    input_lat_present();                          /* the first sample publishes at once */
+
+    char name[INPUT_LAT_NAME_MAX];
+    InputLatHist got;
+    expect_true("load", input_lat_load(LAT_DIR "/pub", name, &got) == 0);
+    expect_true("the file carries the app's name", strcmp(name, "pub") == 0);
+    expect_true("and its window merged over the earlier run",
+                got.count == 4 && got.stale == 4 && got.hist[70] == 3 &&
+                got.min_us >= 20000 && got.max_us == 70000);
+
+    event_ago(EV_KEY, BTN_TOUCH, 0, 30000);
+    input_lat_present();                          /* inside INPUT_LAT_SAVE_MS: held */
+    input_lat_load(LAT_DIR "/pub", name, &got);
+    expect_true("a second sample waits for the save interval", got.count == 4);
+    input_lat_flush();
+    input_lat_load(LAT_DIR "/pub", name, &got);
+    expect_true("flush publishes it, counted once", got.count == 5 && got.hist[70] == 3);
+
+    FILE *f = fopen(LAT_DIR "/bad", "wb");
+    fputs("not a histogram at all, but long enough to be read as a header", f);
+    fclose(f);
+    expect_true("a file that is not a histogram is refused",
+                input_lat_load(LAT_DIR "/bad", name, &got) == -1);
+    expect_true("a missing one too", input_lat_load(LAT_DIR "/none", name, &got) == -1);
+
+    unlink(LAT_DIR "/bad");
+    unlink(LAT_DIR "/pub");
+    rmdir(LAT_DIR);
+}
+
+static void test_fb_swap(void) {
+    printf("fb_swap() is the present\n");
+    input_lat_open(NULL, "swap");
+    uint32_t pixels[16];
+    Framebuffer fb;
+    memset(&fb, 0, sizeof(fb));
+    fb.buffer = pixels;                           /* single-buffered: drew to the panel */
+    fb.width = fb.height = 4;
+
+    InputLatHist w;
+    event_ago(EV_ABS, ABS_Y, 7, 12000);
+    fb_swap(&fb);
+    input_lat_window(&w);
+    expect_true("a single-buffered swap resolves the marker",
+                w.count == 1 && w.min_us >= 12000 && w.min_us < 40000);
+
+    Framebuffer surf;
+    memset(&surf, 0, sizeof(surf));
+    surf.back_buffer = pixels;                    /* a Surface: no panel */
+    surf.double_buffering = true;
+    event_ago(EV_ABS, ABS_Y, 8, 12000);
+    fb_swap(&surf);
+    input_lat_window(&w);
+    expect_true("a Surface's swap does not", w.count == 1);
+    fb_swap(&fb);
+    input_lat_window(&w);
+    expect_true("and the marker waits for the panel", w.count == 2);
+}
+
+int main(void) {
+    test_hist();
+    test_tracer();
+    test_file();
+    test_fb_swap();
+    printf("\n%s (%d failure%s)\n", fails ? "FAILED" : "PASSED",
+           fails, fails == 1 ? "" : "s");
+    return fails ? 1 : 0;
+}
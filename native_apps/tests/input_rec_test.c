@@ -0,0 +1,270 @@
+/* Host-side regression for input record/replay (common/input_rec.h).
+ *
+ * Runs on the DEV MACHINE with native gcc, not on the device.  It sleeps for
+ * real — replay is a forked process writing to pipes on the wall clock, and
+ * the timing is what is under test — so the whole run takes about a second.
+ *
+ *   cd native_apps && gcc -Wall -Wextra -Wno-unused-parameter -I common \
+ *       -o build/input_rec_test tests/input_rec_test.c common/input_rec.c \
+ *       common/touch_input.c common/framebuffer.c common/hardware.c \
+ *       common/config.c -lm && ./build/input_rec_test
+ *
+ * What it asserts, and why: the environment switch starts a recording and is
+ * then gone from the environment (a child must not inherit it); the file is
+ * the 16 + 12n bytes the header promises, with the kernel timestamps turned
+ * into deltas; a replay reaches touch_poll() through touch_init() on a host
+ * with no touch device at all, and the press, drag and release land where and
+ * WHEN they were recorded — at 1x and at 10x; a source the session never used
+ * stays unplugged; the feeder closes every fd the app had open when it forked,
+ * so it cannot keep a device busy after the app exits; the axis ranges a
+ * recording carries are what EVIOCGABS answers under replay; and a file that
+ * is not a recording is refused.
+ *
+ * NOT part of build-and-deploy.sh: that script cross-compiles for ARM and this
+ * is a host binary.  Run it by hand after touching common/input_rec.c.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include "input_rec.h"
+#include "touch_input.h"
+
+#define REC_FIXTURE  "/tmp/ir_test.rwin"
+#define META_FIXTURE "/tmp/ir_meta.rwin"
+
+static int fails = 0;
+
+static void expect_true(const char *what, bool cond) {
+    if (!cond) { printf("  FAIL %-60s\n", what); fails++; }
+    else       { printf("  ok   %-60s\n", what); }
+}
+
+static uint64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static uint64_t wall_us(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint64_t)tv.tv_sec * 1000000ULL + (uint64_t)tv.tv_usec;
+}
+
+static void event(InputRecSource src, uint64_t at_us, int type, int code, int value) {
+    struct input_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.time.tv_sec  = (time_t)(at_us / 1000000ULL);
+    ev.time.tv_usec = (suseconds_t)(at_us % 1000000ULL);
+    ev.type = type; ev.code = code; ev.value = value;
+    input_rec_event(src, &ev);
+}
+
+/* The session every replay below plays: a tap at raw (1000,2000) 10 ms in,
+ * dragged to (3000,2000) at 30 ms, a key at 40 ms, released at 60 ms. */
+static void record_session(uint64_t t0) {
+    event(INPUT_REC_TOUCH, t0 + 10000, EV_ABS, ABS_X, 1000);
+    event(INPUT_REC_TOUCH, t0 + 10000, EV_ABS, ABS_Y, 2000);
+    event(INPUT_REC_TOUCH, t0 + 10000, EV_KEY, BTN_TOUCH, 1);
+    event(INPUT_REC_TOUCH, t0 + 10000, EV_SYN, SYN_REPORT, 0);
+    event(INPUT_REC_TOUCH, t0 + 30000, EV_ABS, ABS_X, 3000);
+    event(INPUT_REC_TOUCH, t0 + 30000, EV_SYN, SYN_REPORT, 0);
+    event(INPUT_REC_KEYBOARD, t0 + 40000, EV_KEY, KEY_A, 1);
+    event(INPUT_REC_KEYBOARD, t0 + 40000, EV_SYN, SYN_REPORT, 0);
+    event(INPUT_REC_TOUCH, t0 + 60000, EV_KEY, BTN_TOUCH, 0);
+    event(INPUT_REC_TOUCH, t0 + 60000, EV_SYN, SYN_REPORT, 0);
+}
+
+static void test_record(void) {
+    printf("record\n");
+    unlink(REC_FIXTURE);
+    setenv(INPUT_REC_ENV_RECORD, REC_FIXTURE, 1);
+    expect_true("a device open with nothing to replay is left alone",
+                input_rec_device(INPUT_REC_TOUCH, -1) == -1);
+    expect_true("the environment switch started a recording",
+                access(REC_FIXTURE, F_OK) == 0);
+    expect_true("and is unset, so a child cannot inherit it",
+                getenv(INPUT_REC_ENV_RECORD) == NULL);
+
+    record_session(wall_us());
+    expect_true("ten events counted", input_rec_count() == 10);
+    input_rec_stop();
+
+    struct stat st;
+    stat(REC_FIXTURE, &st);
+    expect_true("file is a 16-byte header and 12 bytes an event",
+                st.st_size == (off_t)(sizeof(InputRecHeader) + 10 * sizeof(InputRecord)));
+
+    FILE *f = fopen(REC_FIXTURE, "rb");
+    InputRecHeader h;
+    InputRecord r[10];
+    bool read_ok = f && fread(&h, sizeof(h), 1, f) == 1 && fread(r, sizeof(r[0]), 10, f) == 10;
+    if (f) fclose(f);
+    expect_true("header carries the magic and version",
+                read_ok && h.magic == INPUT_REC_MAGIC && h.version == INPUT_REC_VERSION);
+    expect_true("first delta is from the start of the recording",
+                read_ok && r[0].dt_us >= 9000 && r[0].dt_us < 60000);
+    expect_true("events of one report are 0 apart",
+                read_ok && r[1].dt_us == 0 && r[3].dt_us == 0);
+    expect_true("and the next report 20 ms later",
+                read_ok && r[4].dt_us == 20000);
+    expect_true("sources and codes survive",
+                read_ok && r[6].src == INPUT_REC_KEYBOARD && r[6].code == KEY_A &&
+                r[2].src == INPUT_REC_TOUCH && r[2].type == EV_KEY && r[2].value == 1);
+}
+
+/* Poll a replayed touch until the release, noting when each edge arrived. */
+typedef struct { bool pressed, released; int px, py, dx; uint64_t press_us, release_us; } Seen;
+
+static Seen play_touch(TouchInput *t, uint64_t start, uint64_t limit_us) {
+    Seen s;
+    memset(&s, 0, sizeof(s));
+    while (now_us() - start < limit_us && !s.released) {
+        touch_poll(t);
+        if (t->state.pressed) {
+            s.pressed = true; s.press_us = now_us() - start;
+            s.px = t->state.x; s.py = t->state.y;
+        }
+        if (s.pressed && t->state.held) s.dx = t->state.x;
+        if (t->state.released) { s.released = true; s.release_us = now_us() - start; }
+        usleep(500);
+    }
+    return s;
+}
+
+static void test_replay(void) {
+    printf("replay at 1x through touch_init()\n");
+    uint64_t start = now_us(), wall0 = wall_us();
+    expect_true("replay starts", input_rec_replay(REC_FIXTURE, 1.0, false) == 0);
+
+    TouchInput t;
+    memset(&t, 0, sizeof(t));
+    expect_true("touch_init succeeds with no device on this host",
+                touch_init(&t, "/dev/input/ir_test_no_such_node") == 0);
+    touch_set_raw_range(&t, 0, 4095, 0, 4095);
+    expect_true("an unused source stays unplugged",
+                input_rec_device(INPUT_REC_GAMEPAD, -1) == -1);
+    int kbd = input_rec_device(INPUT_REC_KEYBOARD, -1);
+    expect_true("a used one gets a pipe", kbd >= 0);
+
+    Seen s = play_touch(&t, start, 500000);
+    expect_true("the press arrives", s.pressed);
+    expect_true("no sooner than recorded", s.press_us >= 9000);
+    expect_true("at the recorded position",
+                s.px == 1000 * 799 / 4095 && s.py == 2000 * 479 / 4095);
+    expect_true("the drag moves it", s.dx == 3000 * 799 / 4095);
+    expect_true("the release arrives", s.released);
+    expect_true("no sooner than recorded, and not far later",
+                s.release_us >= 58000 && s.release_us < 200000);
+
+    struct input_event ev;
+    uint64_t wall = wall_us();
+    bool got_key = read(kbd, &ev, sizeof(ev)) == (ssize_t)sizeof(ev);
+    uint64_t stamp = (uint64_t)ev.time.tv_sec * 1000000ULL + (uint64_t)ev.time.tv_usec;
+    expect_true("the keyboard pipe carries its own event",
+                got_key && ev.type == EV_KEY && ev.code == KEY_A && ev.value == 1);
+    expect_true("stamped on the replay's clock, not the recording's",
+                got_key && stamp >= wall0 + 39000 && stamp <= wall);
+
+    close(kbd);
+    touch_close(&t);
+    input_rec_stop();
+}
+
+static void test_speed(void) {
+    printf("replay at 10x and full speed\n");
+    TouchInput t;
+    memset(&t, 0, sizeof(t));
+
+    uint64_t start = now_us();
+    input_rec_replay(REC_FIXTURE, 10.0, false);
+    touch_init(&t, "/dev/input/ir_test_no_such_node");
+    touch_set_raw_range(&t, 0, 4095, 0, 4095);
+    Seen s = play_touch(&t, start, 500000);
+    expect_true("10x: the whole tap arrives", s.pressed && s.released);
+    expect_true("10x: in a tenth of the time",
+                s.release_us >= 5000 && s.release_us < 40000);
+    touch_close(&t);
+    input_rec_stop();
+
+    start = now_us();
+    input_rec_replay(REC_FIXTURE, 0, false);
+    touch_init(&t, "/dev/input/ir_test_no_such_node");
+    touch_set_raw_range(&t, 0, 4095, 0, 4095);
+    s = play_touch(&t, start, 500000);
+    expect_true("full speed: the whole tap arrives", s.pressed && s.released);
+    touch_close(&t);
+    input_rec_stop();
+}
+
+static void test_inherited(void) {
+    printf("fds the app had open\n");
+    int p[2];
+    if (pipe(p) != 0) { expect_true("pipe", false); return; }
+
+    /* p[1] stands in for /dev/dsp or a framebuffer the app opened before the
+     * replay: not close-on-exec, and open across the fork.  At 0.01x the
+     * feeder is still sleeping on the tap seconds from now. */
+    expect_true("replay starts", input_rec_replay(REC_FIXTURE, 0.01, false) == 0);
+    close(p[1]);
+
+    struct pollfd pfd = { p[0], POLLIN, 0 };
+    char c;
+    bool eof = poll(&pfd, 1, 1000) == 1 && read(p[0], &c, 1) == 0;
+    expect_true("the feeder does not hold them", eof);
+    input_rec_stop();
+    close(p[0]);
+}
+
+static void test_meta(void) {
+    printf("axis ranges and bad files\n");
+    FILE *f = fopen(META_FIXTURE, "wb");
+    InputRecHeader h = { INPUT_REC_MAGIC, INPUT_REC_VERSION, sizeof(InputRecord), 0 };
+    InputRecord r[3] = {
+        { 0, -32768, ABS_X, INPUT_REC_ABS_MIN, INPUT_REC_GAMEPAD },
+        { 0,  32767, ABS_X, INPUT_REC_ABS_MAX, INPUT_REC_GAMEPAD },
+        { 1000, 500, ABS_X, EV_ABS,            INPUT_REC_GAMEPAD },
+    };
+    fwrite(&h, sizeof(h), 1, f);
+    fwrite(r, sizeof(r[0]), 3, f);
+    fclose(f);
+
+    input_rec_replay(META_FIXTURE, 1.0, false);
+    struct input_absinfo ai;
+    memset(&ai, 0, sizeof(ai));
+    expect_true("a recorded range is what EVIOCGABS answers",
+                input_rec_absinfo(INPUT_REC_GAMEPAD, -1, ABS_X, &ai) == 0 &&
+                ai.minimum == -32768 && ai.maximum == 32767);
+    expect_true("an axis it never saw has none",
+                input_rec_absinfo(INPUT_REC_GAMEPAD, -1, ABS_Y, &ai) == -1);
+    expect_true("the pad it moved gets a pipe",
+                input_rec_device(INPUT_REC_GAMEPAD, -1) >= 0);
+    expect_true("the touch it never used gets none",
+                input_rec_device(INPUT_REC_TOUCH, -1) == -1);
+    input_rec_stop();
+
+    f = fopen(META_FIXTURE, "wb");
+    fputs("x\t1000\ty\t2000\n", f);             /* a touch_raw capture, say */
+    fclose(f);
+    expect_true("a file that is not a recording is refused",
+                input_rec_replay(META_FIXTURE, 1.0, false) == -1);
+    expect_true("and leaves devices alone", input_rec_device(INPUT_REC_TOUCH, 7) == 7);
+    unlink(META_FIXTURE);
+}
+
+int main(void) {
+    test_record();
+    test_replay();
+    test_speed();
+    test_inherited();
+    test_meta();
+    unlink(REC_FIXTURE);
+    printf("\n%s (%d failure%s)\n", fails ? "FAILED" : "PASSED",
+           fails, fails == 1 ? "" : "s");
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,148 @@
+/* Host-side regression for the launcher's partial redraw (draw_launcher()'s
+ * early path: redraw_tile() and redraw_toggle()).
+ *
+ * Runs on the DEV MACHINE with native gcc, not on the device.  The launcher is
+ * compiled in — app_launcher.c #included with its main() renamed — and drawn
+ * into an offscreen Surface the size of the panel, over a made-up app list
+ * (no scan of /opt/games, no icons on disk: every tile is its coloured
+ * letter).  fb_swap() of a Surface is a no-op, so the damage list a frame
+ * recorded is still there to read after draw_launcher() returns.
+ *
+ *   cd native_apps && gcc -Wall -Wextra -Wno-unused-parameter -I common -I . \
+ *       -o build/launcher_redraw_test tests/launcher_redraw_test.c \
+ *       common/common.c common/framebuffer.c common/hardware.c \
+ *       common/config.c common/touch_input.c common/highscore.c \
+ *       common/keyboard.c common/audio.c common/audio_gen.c \
+ *       common/audio_out.c common/audio_wav.c common/frame_sched.c \
+ *       common/gamepad.c common/input_hotplug.c common/input_hub.c \
+ *       common/ppm.c common/logger.c -lm && ./build/launcher_redraw_test
+ *
+ * What it asserts, and why — as tetris_redraw_test.c: each frame is drawn
+ * partial and then forced full (drawn_valid = false), the two must be
+ * pixel-identical, and every pixel the partial frame changed must lie in the
+ * damage list.  The random moves are the launcher's own: the selection moving
+ * (to a tile on this page, one on another page, or none), the page turning,
+ * either audio toggle flipping, and a pad coming and going, which shows or
+ * hides the input hint.  The page turn and the hint are full frames by
+ * design; the others go through redraw_tile() and redraw_toggle(), and a
+ * frame that takes that path must repaint far less than the screen.
+ *
+ * NOT part of build-and-deploy.sh: that script cross-compiles for ARM and this
+ * is a host binary.  Run it by hand after touching the launcher's draw code.
+ */
+#define main launcher_main
+#include "../app_launcher/app_launcher.c"
+#undef main
+
+#define STEPS 2000
+#define APPS  11                    /* more than one page, the last one short */
+
+static int fails = 0;
+
+static void expect_true(const char *what, bool cond) {
+    if (!cond) { printf("  FAIL %-60s\n", what); fails++; }
+    else       { printf("  ok   %-60s\n", what); }
+}
+
+/* Pixels that differ from `before` and lie in no damage rectangle. */
+static long undamaged_changes(const Framebuffer *s, const uint8_t *before) {
+    if (s->damage_full) return 0;
+    const uint32_t *a = (const uint32_t *)before;
+    const uint32_t *b = (const uint32_t *)s->back_buffer;
+    long n = 0;
+    for (int y = 0; y < (int)s->height; y++)
+        for (int x = 0; x < (int)s->width; x++) {
+            size_t i = (size_t)y * s->width + x;
+            if (a[i] == b[i]) continue;
+            bool in = false;
+            for (int d = 0; d < s->damage_count && !in; d++) {
+                const FbRect *r = &s->damage[d];
+                in = x >= r->x && x < r->x + r->w && y >= r->y && y < r->y + r->h;
+            }
+            if (!in) n++;
+        }
+    return n;
+}
+
+static long damage_area(const Framebuffer *s) {
+    if (s->damage_full) return (long)s->width * s->height;
+    long a = 0;
+    for (int d = 0; d < s->damage_count; d++)
+        a += (long)s->damage[d].w * s->damage[d].h;
+    return a;
+}
+
+static void random_move(Launcher *l) {
+    switch (rand() % 10) {
+    case 0: case 1: case 2: case 3: case 4:
+        l->selected_app = rand() % (l->app_count + 1) - 1;
+        break;
+    case 5: l->current_page = rand() % l->total_pages;              break;
+    case 6: l->music_sw.state = !l->music_sw.state;                 break;
+    case 7: l->effects_sw.state = !l->effects_sw.state;             break;
+    case 8: l->input.gamepad_connected = rand() % 2;                break;
+    default:                                                        break;
+    }
+}
+
+int main(void) {
+    static Launcher l;
+    memset(&l, 0, sizeof(l));
+    Framebuffer like;
+    memset(&like, 0, sizeof(like));
+    like.bytes_per_pixel = 4;
+    if (fb_surface_init(&l.fb, &like, 800, 480) != 0) { printf("no surface\n"); return 1; }
+
+    compute_grid_layout(&l.fb);
+    toggles_layout(&l);
+    l.app_count = APPS;
+    for (int i = 0; i < l.app_count; i++) {
+        snprintf(l.apps[i].name, sizeof(l.apps[i].name), "App%c", 'A' + i);
+        l.apps[i].icon_color = name_to_color(l.apps[i].name);
+    }
+    l.total_pages  = (l.app_count + apps_per_page - 1) / apps_per_page;
+    l.selected_app = -1;
+
+    size_t size = l.fb.back_buffer_size;
+    uint8_t *before = malloc(size), *partial = malloc(size);
+    if (!before || !partial) { printf("out of memory\n"); return 1; }
+
+    printf("random moves, %d frames, %d apps on %d pages\n", STEPS, APPS, l.total_pages);
+    srand(3);
+    int frames = 0, wrong = 0, short_damage = 0;
+    long area = 0;
+    for (int step = 0; step < STEPS; step++) {
+        random_move(&l);
+
+        memcpy(before, l.fb.back_buffer, size);
+        bool was_valid = l.drawn_valid;
+        l.fb.damage_tracking = true;
+        l.fb.damage_full = false;
+        l.fb.damage_count = 0;
+        draw_launcher(&l);
+
+        if (was_valid && !l.fb.damage_full) {
+            frames++;
+            area += damage_area(&l.fb);
+            if (undamaged_changes(&l.fb, before)) short_damage++;
+        }
+        memcpy(partial, l.fb.back_buffer, size);
+        l.drawn_valid = false;
+        draw_launcher(&l);
+        if (memcmp(partial, l.fb.back_buffer, size)) wrong++;
+    }
+
+    expect_true("every frame matches a full redraw", wrong == 0);
+    expect_true("every pixel a partial one changed is in the damage list",
+                short_damage == 0);
+    expect_true("the partial path ran", frames > STEPS / 3);
+    long mean = frames ? area / frames : 0;
+    printf("  (%d partial frames, mean damage %ld px of %d)\n", frames, mean, 800 * 480);
+    expect_true("and repainted under a fifth of the screen", mean < 800 * 480 / 5);
+
+    free(before);
+    free(partial);
+    printf("\n%s (%d failure%s)\n", fails ? "FAILED" : "PASSED",
+           fails, fails == 1 ? "" : "s");
+    return fails ? 1 : 0;
+}
@@ -1,5 +1,6 @@
 #!/bin/bash
-# Measure that audio_gen_test's level, limiter and voice-tail groups can FAIL.
+# Measure that audio_gen_test's level, limiter, voice-tail and rate-converter
+# groups can FAIL.
 # Copies only; the tree is untouched.  ⚠️ Cases 2 and 5 rotted once already, when
 # AUDIO_MIX_CEIL became derived and the default limiter became HARD — a stanza
 # that no longer matches prints "NO-OP EDIT" rather than "0 failed", which is the
@@ -32,7 +33,7 @@ run "2 derived ceiling outside int16 (3x the knee)" \
 run "3 no knee at all: y = K + span*u (linear, unbounded)" \
     sed -i 's|span \* (u / (1.0 + u))|span * u|' audio_gen.c
 run "4 counters swapped: the knee counts as a clip" \
-    sed -i 's/if (m->limit == AUDIO_MIX_HARD) m->clipped++;/if (m->limit == AUDIO_MIX_HARD) m->limited++;/' audio_gen.c
+    sed -i 's/if (out != acc\[i\]) m->limited++;/if (out != acc[i]) m->clipped++;/' audio_gen.c
 run "5 default mode is SOFT again, not ScummVM's clamped add" \
     sed -i 's/m->limit = AUDIO_MIX_HARD;     \/\* clampedAdd/m->limit = AUDIO_MIX_SOFT;     \/* clampedAdd/' audio_gen.c
 run "6 truncate instead of round (the lost LSB at the knee)" \
@@ -58,4 +59,16 @@ run "13 the voice tail ignores the generation it was asked about" \
 # "rc=139", which is why it does.
 run "14 THE DEFECT RESTORED: a voice's tail is the whole bus's tail" \
     sed -i 's|return (left > 0) ? left : 0;|return audio_mix_pending(m);|' audio_gen.c
+
+# ── group T, the rate converter ────────────────────────────────────────────
+run "15 the phase restarts on every pull — slicing changes the output" \
+    sed -i '/^long audio_rs_pull/,/^}/ s|    long n = 0;|    long n = 0;\n    rs->acc = 0;|' audio_gen.c
+run "16 the rows are not renormalised — DC ripples at the phase rate" \
+    sed -i 's|rs->coef\[p\]\[big\] = (int16_t)(rs->coef\[p\]\[big\] + (32768 - total));|(void)big;|' audio_gen.c
+run "17 the cutoff ignores a DOWNWARD ratio — what is above Nyquist folds back" \
+    sed -i 's|double fc = 0.85 \* (out_rate < in_rate ? (double)out_rate / in_rate : 1.0);|double fc = 0.85;|' audio_gen.c
+run "18 the length rounds down, so a converted voice loses its last frame" \
+    sed -i 's|return (long)(((long long)in_frames \* out_rate + in_rate - 1) / in_rate);|return (long)(((long long)in_frames * out_rate) / in_rate);|' audio_gen.c
+run "19 no blend between phases — 64 steps of phase error" \
+    sed -i 's|int32_t v = a0 + (int32_t)(((int64_t)(a1 - a0) \* blend) >> RS_BLEND_BITS);|int32_t v = a0; (void)a1; (void)blend;|' audio_gen.c
 rm -rf "$W"
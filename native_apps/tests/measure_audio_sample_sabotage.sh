@@ -48,15 +48,15 @@ run "6 a drained non-looping reader wraps anyway" \
 run "7 the loop counter never increments" \
     sed -i 's|w->loops++;||' audio_wav.c
 run "8 rewind does not reset pos, so a wrap reads past the end" \
-    sed -i 's|if (fseek(w->f, w->data_pos, SEEK_SET) == 0) w->pos = 0;|(void)fseek(w->f, w->data_pos, SEEK_SET);|' audio_wav.c
+    sed -i 's|} else if (fseek(w->f, w->data_pos, SEEK_SET) == 0) {|} else if (fseek(w->f, w->data_pos, SEEK_SET) == 0 \&\& 0) {|' audio_wav.c
 run "9 16-bit is not checked, so an 8-bit file is read as PCM" \
-    sed -i 's|bits != 16|bits < 8|' audio_wav.c
+    sed -i 's|: (channels >= 1 \&\& bits == 16);|: (channels >= 1 \&\& bits >= 8);|' audio_wav.c
 
 # ── the voice on the bus ───────────────────────────────────────────────────
 run "10 the buffer is refilled every frame, losing the unread tail" \
     sed -i 's|if (vo->buf_pos >= vo->buf_len \&\& !vo->drained) {|if (1) {|' audio_gen.c
 run "11 the sample voice never advances pos, so it never ends" \
-    sed -i 's|                if (++vo->pos >= vo->frames) vo->active = false;|                (void)0;|' audio_gen.c
+    sed -i '/^static void mix_sample_run/,/^}/ s|vo->pos += run;|(void)0;|' audio_gen.c
 run "12 a full bus STEALS slot 0 instead of refusing" \
     sed -i 's|if (vo->active) continue;|if (vo->active \&\& i + 1 < AUDIO_MAX_VOICES) continue;|' audio_gen.c
 run "13 the refusal is not counted" \
@@ -66,6 +66,28 @@ run "14 release CUTS the voice instead of arming the envelope" \
 run "15 release ignores the generation, so a stale handle stops a live voice" \
     sed -i 's|if (!vo->active \|\| vo->gen != gen) return false;   /\* freed, or reused \*/|if (!vo->active) return false;|' audio_gen.c
 run "16 the sample voice skips the envelope, so the bed starts with a step" \
-    sed -i 's|acc += (int32_t)((((long)s \* (long)vo->peak) >> 15) \* env);|acc += (int32_t)(((long)s * (long)vo->peak) >> 15);|' audio_gen.c
+    sed -i 's|acc\[k\] += mul_q15(((int32_t)src\[k\] \* vo->peak) >> 15, env);|acc[k] += ((int32_t)src[k] * vo->peak) >> 15;|' audio_gen.c
+
+# ── IMA-ADPCM (group I) ────────────────────────────────────────────────────
+run "17 the decoder takes the HIGH nibble first" \
+    sed -i '0,/blk\[i\] \& 0x0f);/s|blk\[i\] \& 0x0f);|blk[i] >> 4);|' audio_wav.c
+run "18 the fact chunk is ignored, so the spare nibble plays as a frame" \
+    sed -i 's|if (fact > 0 \&\& fact < frames) frames = fact;||' audio_wav.c
+run "19 the encoder starts every block at the carried index" \
+    sed -i 's|    if (frames > 1) {|    if (0) {|' audio_wav.c
+run "20 the stereo downmix takes the left channel" \
+    sed -i 's|dst\[n++\] = (int16_t)((l\[k\] + r\[k\]) >> 1);|dst[n++] = (int16_t)l[k];|' audio_wav.c
+
+# ── the mapped path (group J) ──────────────────────────────────────────────
+run "21 no residency probe: the read touches whatever it needs (the fault)" \
+    sed -i 's|    if (mincore((void \*)start, pages \* (size_t)w->page, vec) != 0) return need;|    return need;|' audio_wav.c
+run "22 a stalled fill returns SHORT, which ends the voice" \
+    sed -i '0,/            done = frames;/s|            done = frames;||' audio_wav.c
+run "23 the wrap is never hinted" \
+    sed -i 's|w->wrap_hinted = true;||' audio_wav.c
+run "24 a mapped rewind does not reset the byte cursor" \
+    sed -i 's|        w->cur    = 0;||' audio_wav.c
+run "25 no read-ahead after the first windows" \
+    sed -i '/^static long read_mapped_pcm/,/^}/ s|    map_hint(w);||' audio_wav.c
 
 rm -rf "$W"
@@ -0,0 +1,180 @@
+/* Host-side regression for samegame's partial redraw (draw_field_changes()).
+ *
+ * Runs on the DEV MACHINE with native gcc, not on the device.  The game itself
+ * is compiled in — samegame.c #included with its main() renamed, and its
+ * get_time_ms() swapped for a clock the test advances, so the highlight pulse
+ * and the flash fade are the same in the two draws of a frame.
+ *
+ *   cd native_apps && gcc -Wall -Wextra -Wno-unused-parameter -I common -I . \
+ *       -o build/samegame_redraw_test tests/samegame_redraw_test.c \
+ *       common/common.c common/framebuffer.c common/hardware.c \
+ *       common/config.c common/touch_input.c common/highscore.c \
+ *       common/keyboard.c common/audio.c common/audio_gen.c \
+ *       common/audio_out.c common/audio_wav.c common/frame_sched.c \
+ *       common/gamepad.c common/input_hotplug.c common/input_hub.c \
+ *       -lm && ./build/samegame_redraw_test
+ *
+ * What it asserts, and why — as tetris_redraw_test.c: every steady frame is
+ * drawn partial and then forced full (field_drawn = false) and the two must be
+ * pixel-identical, and every pixel the partial frame changed must lie in the
+ * damage list fb_swap() will copy.
+ *
+ * The parts of draw_field_changes() most likely to go wrong are the ones this
+ * walks through on purpose:
+ *   - the group-size line.  At 800x480 it is drawn OVER the grid's bottom
+ *     row, so a change to either must redraw the whole band and every cell it
+ *     crosses.  The row-band arithmetic is checked by the first assertion that
+ *     the layout really overlaps — without it the band path would never run.
+ *   - the HUD restore rectangle, which the two buttons' pressed states
+ *     (flipped at random) and the SCORE and BLOCKS lines redraw through.  In
+ *     play those numbers change only with a removal, whose animation makes
+ *     the frame a full one, so the test pokes them on steady frames — the
+ *     score for good, the block count for one frame — or the rectangle would
+ *     only ever be tried with the text it already held.
+ *   - the flash on a lone block, and its fade, over 200 ms of the test clock.
+ * Taps are random cells with a bias to tapping the highlighted group, so
+ * groups are removed and blocks fall; the frames that animate are not steady
+ * and are not compared (a full frame is all they ever get).
+ *
+ * NOT part of build-and-deploy.sh: that script cross-compiles for ARM and this
+ * is a host binary.  Run it by hand after touching samegame's draw code.
+ */
+#include <stdint.h>
+#define get_time_ms test_clock_ms
+#define main samegame_main
+#include "../samegame/samegame.c"
+#undef main
+#undef get_time_ms
+
+#define STEPS 3000
+
+static uint32_t clock_ms = 1000;
+uint32_t test_clock_ms(void) { return clock_ms; }
+
+static int fails = 0;
+
+static void expect_true(const char *what, bool cond) {
+    if (!cond) { printf("  FAIL %-60s\n", what); fails++; }
+    else       { printf("  ok   %-60s\n", what); }
+}
+
+/* Pixels that differ from `before` and lie in no damage rectangle. */
+static long undamaged_changes(const Framebuffer *s, const uint8_t *before) {
+    if (s->damage_full) return 0;
+    const uint32_t *a = (const uint32_t *)before;
+    const uint32_t *b = (const uint32_t *)s->back_buffer;
+    long n = 0;
+    for (int y = 0; y < (int)s->height; y++)
+        for (int x = 0; x < (int)s->width; x++) {
+            size_t i = (size_t)y * s->width + x;
+            if (a[i] == b[i]) continue;
+            bool in = false;
+            for (int d = 0; d < s->damage_count && !in; d++) {
+                const FbRect *r = &s->damage[d];
+                in = x >= r->x && x < r->x + r->w && y >= r->y && y < r->y + r->h;
+            }
+            if (!in) n++;
+        }
+    return n;
+}
+
+static long damage_area(const Framebuffer *s) {
+    if (s->damage_full) return (long)s->width * s->height;
+    long a = 0;
+    for (int d = 0; d < s->damage_count; d++)
+        a += (long)s->damage[d].w * s->damage[d].h;
+    return a;
+}
+
+/* A random cell, or — half the time while a group is lit — the group itself,
+ * which removes it. */
+static void tap(void) {
+    int c = rand() % game.cols, r = rand() % game.rows;
+    if (rand() % 4 == 0) c = -1;                    /* off the grid: clears */
+    if (game.highlight_active && rand() % 2) {
+        for (int cc = 0; cc < game.cols; cc++)
+            for (int rr = 0; rr < game.rows; rr++)
+                if (game.highlight_map[cc][rr]) { c = cc; r = rr; }
+    }
+    handle_grid_click(game.grid_x + c * game.block_size + 2,
+                      game.grid_y + r * game.block_size + 2);
+}
+
+int main(void) {
+    Framebuffer like;
+    memset(&like, 0, sizeof(like));
+    like.bytes_per_pixel = 4;
+    if (fb_surface_init(&fb, &like, 800, 480) != 0) { printf("no surface\n"); return 1; }
+
+    srand(2);
+    init_game();
+    board_bg_ok = fb_layer_init(&board_bg, &fb, (int)fb.width, (int)fb.height,
+                                paint_board, NULL) == 0;
+    current_screen = SCREEN_PLAYING;
+
+    printf("layout, 800x480\n");
+    expect_true("the board layer was allocated", board_bg_ok);
+    expect_true("the group-size line crosses the grid's bottom row",
+                hl_text_y() < game.grid_y + game.rows * game.block_size);
+
+    size_t size = fb.back_buffer_size;
+    uint8_t *before = malloc(size), *partial = malloc(size);
+    if (!before || !partial) { printf("out of memory\n"); return 1; }
+
+    printf("\nrandom play, %d frames\n", STEPS);
+    int frames = 0, wrong = 0, short_damage = 0, scored = 0, poked = 0;
+    long area = 0;
+    for (int step = 0; step < STEPS; step++) {
+        clock_ms += 1 + rand() % 60;
+        if (current_screen != SCREEN_PLAYING || game.perfect_clear) {
+            reset_game();
+            current_screen = SCREEN_PLAYING;
+        }
+        int score = game.score;
+        if (rand() % 3 == 0) tap();
+        if (rand() % 40 == 0) exit_button.visual_state = rand() % 3;
+        if (rand() % 40 == 0) menu_button.visual_state = rand() % 3;
+        update_game();
+        if (game.score != score) scored++;
+
+        bool was_partial = field_drawn && field_is_steady();
+        int remaining = game.blocks_remaining;
+        if (was_partial && rand() % 20 == 0) {
+            game.score += 1 + rand() % 2000;
+            game.blocks_remaining += 1 + rand() % 150;
+            poked++;
+        }
+
+        memcpy(before, fb.back_buffer, size);
+        fb.damage_tracking = true;
+        fb.damage_full = false;
+        fb.damage_count = 0;
+        draw_game();
+
+        if (was_partial) {
+            frames++;
+            area += damage_area(&fb);
+            if (undamaged_changes(&fb, before)) short_damage++;
+        }
+        memcpy(partial, fb.back_buffer, size);
+        field_drawn = false;
+        draw_game();
+        if (was_partial && memcmp(partial, fb.back_buffer, size)) wrong++;
+        game.blocks_remaining = remaining;
+    }
+
+    expect_true("every partial frame matches a full redraw", wrong == 0);
+    expect_true("every pixel it changed is in the damage list", short_damage == 0);
+    expect_true("groups were removed along the way", scored > 20);
+    expect_true("and the HUD's numbers changed on steady frames", poked > 20);
+    expect_true("the partial path ran", frames > STEPS / 4);
+    long mean = frames ? area / frames : 0;
+    printf("  (%d partial frames, mean damage %ld px of %d)\n", frames, mean, 800 * 480);
+    expect_true("and repainted under a fifth of the screen", mean < 800 * 480 / 5);
+
+    free(before);
+    free(partial);
+    printf("\n%s (%d failure%s)\n", fails ? "FAILED" : "PASSED",
+           fails, fails == 1 ? "" : "s");
+    return fails ? 1 : 0;
+}
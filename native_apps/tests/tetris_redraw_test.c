@@ -0,0 +1,168 @@
+/* Host-side regression for tetris' partial redraw (draw_playing_changes()).
+ *
+ * Runs on the DEV MACHINE with native gcc, not on the device.  The game itself
+ * is compiled in — tetris.c #included with its main() renamed — so the test
+ * drives the real static draw functions over an offscreen Surface the size of
+ * the panel, with no /dev/fb0 and no touch device behind it.
+ *
+ *   cd native_apps && gcc -Wall -Wextra -Wno-unused-parameter -I common -I . \
+ *       -o build/tetris_redraw_test tests/tetris_redraw_test.c \
+ *       common/common.c common/framebuffer.c common/hardware.c \
+ *       common/config.c common/touch_input.c common/highscore.c \
+ *       common/keyboard.c common/audio.c common/audio_gen.c \
+ *       common/audio_out.c common/audio_wav.c common/frame_sched.c \
+ *       common/gamepad.c common/input_hotplug.c common/input_hub.c \
+ *       -lm && ./build/tetris_redraw_test
+ *
+ * What it asserts, and why.  A partial frame repaints only the cells whose
+ * colour changed since the last one, plus the HUD and next-piece box when they
+ * did, and trusts the back buffer for everything else.  So it has the two
+ * failure modes fb_damage_test.c names for the swap, one level up:
+ *
+ *   1. the back buffer is wrong — a cell left showing the piece that moved off
+ *      it.  Caught by drawing every frame twice, partial and then forced full
+ *      (field_drawn = false), and comparing the two pixel for pixel.
+ *   2. the back buffer is right and the DAMAGE is short — the panel keeps the
+ *      old pixel, because fb_swap() copies only the damage list.  Caught by
+ *      checking that every pixel the partial frame changed lies inside a
+ *      recorded rectangle.
+ *
+ * The moves are random (a fixed seed): shifts, rotations, soft drops and
+ * locks, so the next piece changes and games end and restart; the menu
+ * button's pressed state flips now and then, because the chrome is redrawn
+ * when it does.  Random moves almost never complete a row, and a cleared row
+ * is what changes the score and level and shifts the whole stack, so now and
+ * then the test fills the bottom row itself and clears it as a lock would.  A last check makes sure the partial
+ * path really ran and really was partial — a draw that always fell back to a
+ * full frame would pass the first two trivially.
+ *
+ * NOT part of build-and-deploy.sh: that script cross-compiles for ARM and this
+ * is a host binary.  Run it by hand after touching tetris' draw code.
+ */
+#define main tetris_main
+#include "../tetris/tetris.c"
+#undef main
+
+#define STEPS 3000
+
+static int fails = 0;
+
+static void expect_true(const char *what, bool cond) {
+    if (!cond) { printf("  FAIL %-60s\n", what); fails++; }
+    else       { printf("  ok   %-60s\n", what); }
+}
+
+/* Pixels that differ from `before` and lie in no damage rectangle. */
+static long undamaged_changes(const Framebuffer *s, const uint8_t *before) {
+    if (s->damage_full) return 0;
+    const uint32_t *a = (const uint32_t *)before;
+    const uint32_t *b = (const uint32_t *)s->back_buffer;
+    long n = 0;
+    for (int y = 0; y < (int)s->height; y++)
+        for (int x = 0; x < (int)s->width; x++) {
+            size_t i = (size_t)y * s->width + x;
+            if (a[i] == b[i]) continue;
+            bool in = false;
+            for (int d = 0; d < s->damage_count && !in; d++) {
+                const FbRect *r = &s->damage[d];
+                in = x >= r->x && x < r->x + r->w && y >= r->y && y < r->y + r->h;
+            }
+            if (!in) n++;
+        }
+    return n;
+}
+
+static long damage_area(const Framebuffer *s) {
+    if (s->damage_full) return (long)s->width * s->height;
+    long a = 0;
+    for (int d = 0; d < s->damage_count; d++)
+        a += (long)s->damage[d].w * s->damage[d].h;
+    return a;
+}
+
+static void step_piece(void) {
+    Piece *p = &game.current;
+    switch (rand() % 6) {
+    case 0: if (!check_collision(p, -1, 0, p->rotation)) p->x--; break;
+    case 1: if (!check_collision(p, 1, 0, p->rotation)) p->x++;  break;
+    case 2:
+        if (!check_collision(p, 0, 0, (p->rotation + 1) % 4))
+            p->rotation = (p->rotation + 1) % 4;
+        break;
+    default:
+        if (!check_collision(p, 0, 1, p->rotation)) p->y++;
+        else lock_piece();
+        break;
+    }
+}
+
+static void complete_bottom_row(void) {
+    for (int x = 0; x < BOARD_WIDTH; x++)
+        if (!game.board[BOARD_HEIGHT - 1][x])
+            game.board[BOARD_HEIGHT - 1][x] = 1 + rand() % 7;
+    clear_lines();
+}
+
+int main(void) {
+    Framebuffer like;
+    memset(&like, 0, sizeof(like));
+    like.bytes_per_pixel = 4;
+    if (fb_surface_init(&fb, &like, 800, 480) != 0) { printf("no surface\n"); return 1; }
+
+    srand(1);
+    init_game();
+    current_screen = SCREEN_PLAYING;
+
+    size_t size = fb.back_buffer_size;
+    uint8_t *before = malloc(size), *partial = malloc(size);
+    if (!before || !partial) { printf("out of memory\n"); return 1; }
+
+    printf("random play, %d frames, 800x480\n", STEPS);
+    int frames = 0, wrong = 0, short_damage = 0, scored = 0;
+    long area = 0;
+    for (int step = 0; step < STEPS; step++) {
+        int score = game.score;
+        step_piece();
+        if (rand() % 25 == 0 && game.current.y < BOARD_HEIGHT - 6)
+            complete_bottom_row();
+        if (game.score != score) scored++;
+        /* Before the draw: the game-over screen's name entry blocks on touch. */
+        if (game.game_over || current_screen != SCREEN_PLAYING) {
+            reset_game();
+            current_screen = SCREEN_PLAYING;
+        }
+        if (rand() % 50 == 0) menu_button.visual_state = rand() % 3;
+
+        /* What the panel shows: the last frame, as fb_swap() left it. */
+        memcpy(before, fb.back_buffer, size);
+        bool was_partial = field_drawn;
+        fb.damage_tracking = true;
+        fb.damage_full = false;
+        fb.damage_count = 0;
+        draw_game();
+
+        if (was_partial) {
+            frames++;
+            area += damage_area(&fb);
+            if (undamaged_changes(&fb, before)) short_damage++;
+        }
+        memcpy(partial, fb.back_buffer, size);
+        field_drawn = false;
+        draw_game();
+        if (was_partial && memcmp(partial, fb.back_buffer, size)) wrong++;
+    }
+
+    expect_true("every partial frame matches a full redraw", wrong == 0);
+    expect_true("every pixel it changed is in the damage list", short_damage == 0);
+    expect_true("lines were cleared along the way", scored > 20);
+    expect_true("the partial path ran", frames > STEPS / 2);
+    long mean = frames ? area / frames : 0;
+    printf("  (%d partial frames, mean damage %ld px of %d)\n", frames, mean, 800 * 480);
+    expect_true("and repainted under a fifth of the screen", mean < 800 * 480 / 5);
+
+    free(before);
+    free(partial);
+    printf("\n%s (%d failure%s)\n", fails ? "FAILED" : "PASSED",
+           fails, fails == 1 ? "" : "s");
+    return fails ? 1 : 0;
+}
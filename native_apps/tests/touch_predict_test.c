@@ -0,0 +1,218 @@
+/* Host-side regression for touch motion prediction (common/touch_input.h,
+ * MOTION PREDICTION).
+ *
+ * Runs on the DEV MACHINE with native gcc, not on the device.  The pure half
+ * is fed synthetic reports; the touch_poll() half reads real input_events from
+ * a pipe standing in for the touch fd, stamped a little in the past so nothing
+ * sleeps.
+ *
+ *   cd native_apps && gcc -Wall -Wextra -Wno-unused-parameter -I common \
+ *       -o build/touch_predict_test tests/touch_predict_test.c \
+ *       common/touch_input.c common/framebuffer.c common/hardware.c \
+ *       common/config.c -lm && ./build/touch_predict_test
+ *
+ * What it asserts, and why: the velocity is a fit over several reports, so two
+ * are not enough and a steady drag reads its true speed; the prediction is the
+ * newest report carried along that velocity to the target, never further than
+ * TOUCH_PRED_MAX_LEAD_US past now and not at all once the reports stop
+ * (a finger held still); smoothing damps jitter and a reversal alike; and
+ * through touch_poll() prediction is off until asked for, follows the lead
+ * while the finger moves, is clamped to the screen, drops back to the measured
+ * position on release, and answers an explicit monotonic target the same way.
+ *
+ * NOT part of build-and-deploy.sh: that script cross-compiles for ARM and this
+ * is a host binary.  Run it by hand after touching the prediction code.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <linux/input.h>
+#include "touch_input.h"
+
+static int fails = 0;
+
+static void expect_true(const char *what, bool cond) {
+    if (!cond) { printf("  FAIL %-60s\n", what); fails++; }
+    else       { printf("  ok   %-60s\n", what); }
+}
+
+static bool near(int got, int want, int tol) {
+    return got >= want - tol && got <= want + tol;
+}
+
+static float absf(float v) { return v < 0 ? -v : v; }
+
+static void test_motion(void) {
+    printf("the fit and the extrapolation\n");
+    TouchMotion m;
+    memset(&m, 0, sizeof(m));
+    int x, y;
+    expect_true("no reports: nothing to predict",
+                !touch_motion_predict(&m, 0, 1000, &x, &y) && x == 0 && y == 0);
+
+    int64_t t0 = 5000000;
+    touch_motion_add(&m, t0, 100, 200);
+    touch_motion_add(&m, t0 + 10000, 105, 200);
+    expect_true("two reports are not a fit",
+                !touch_motion_predict(&m, t0 + 10000, t0 + 30000, &x, &y) && x == 105);
+
+    /* 500 px/s right, 250 px/s up, a report every 10 ms. */
+    touch_motion_reset(&m);
+    for (int i = 0; i < 6; i++) touch_motion_add(&m, t0 + i * 10000, 100 + 5 * i, 200 - 5 * i / 2);
+    expect_true("a steady drag reads its speed",
+                m.have_v && absf(m.vx - 500.0f) < 1.0f && absf(m.vy + 250.0f) < 30.0f);
+    int64_t last = t0 + 50000;
+    expect_true("predicts along it to the target",
+                touch_motion_predict(&m, last, last + 20000, &x, &y) && x == 135 && near(y, 183, 1));
+    expect_true("counting the age of the newest report",
+                touch_motion_predict(&m, last + 10000, last + 20000, &x, &y) && x == 135);
+    touch_motion_predict(&m, last, last + 400000, &x, &y);
+    expect_true("and never past the maximum lead", x == 125 + TOUCH_PRED_MAX_LEAD_US / 2000);
+    expect_true("a finger that stopped reporting is not extrapolated",
+                !touch_motion_predict(&m, last + TOUCH_PRED_STALE_US + 1, last + 60000, &x, &y) &&
+                x == 125);
+
+    /* A finger held still on a noisy digitiser: -2..+2 px of pseudo-random
+     * noise every report.  RMS of the velocity, since one unlucky run of
+     * reports can fool any filter once. */
+    TouchMotion raw, smooth;
+    memset(&raw, 0, sizeof(raw));
+    memset(&smooth, 0, sizeof(smooth));
+    smooth.smoothing = 80;
+    unsigned seed = 12345;
+    float ss_raw = 0, ss_smooth = 0;
+    for (int i = 0; i < 200; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int jx = 300 + (int)((seed >> 16) % 5) - 2;
+        touch_motion_add(&raw, t0 + i * 10000, jx, 100);
+        touch_motion_add(&smooth, t0 + i * 10000, jx, 100);
+        if (i >= 8) {
+            ss_raw    += raw.vx * raw.vx;
+            ss_smooth += smooth.vx * smooth.vx;
+        }
+    }
+    expect_true("smoothing damps jitter on a still finger", ss_smooth < ss_raw / 4);
+
+    /* A reversal: 20 reports right, then left at the same speed. */
+    memset(&raw, 0, sizeof(raw));
+    memset(&smooth, 0, sizeof(smooth));
+    smooth.smoothing = 80;
+    int px = 100;
+    for (int i = 0; i < 20; i++, px += 5) {
+        touch_motion_add(&raw, t0 + i * 10000, px, 0);
+        touch_motion_add(&smooth, t0 + i * 10000, px, 0);
+    }
+    for (int i = 20; i < 28; i++, px -= 5) {
+        touch_motion_add(&raw, t0 + i * 10000, px, 0);
+        touch_motion_add(&smooth, t0 + i * 10000, px, 0);
+    }
+    expect_true("unsmoothed turns with the finger", raw.vx < -400.0f);
+    expect_true("smoothed turns, later", smooth.vx < 0 && smooth.vx > raw.vx);
+    touch_motion_reset(&smooth);
+    expect_true("reset keeps the smoothing setting", smooth.n == 0 && !smooth.have_v &&
+                smooth.smoothing == 80);
+}
+
+/* ── Through touch_poll() ────────────────────────────────────────────────── */
+
+static int wr = -1;
+
+static int64_t wall_us(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+static void put(int64_t at_us, int type, int code, int value) {
+    struct input_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.time.tv_sec  = (time_t)(at_us / 1000000);
+    ev.time.tv_usec = (suseconds_t)(at_us % 1000000);
+    ev.type = type; ev.code = code; ev.value = value;
+    if (write(wr, &ev, sizeof(ev)) != (ssize_t)sizeof(ev)) perror("write");
+}
+
+static void report(int64_t at_us, int x, int y) {
+    put(at_us, EV_ABS, ABS_X, x);
+    put(at_us, EV_ABS, ABS_Y, y);
+    put(at_us, EV_SYN, SYN_REPORT, 0);
+}
+
+/* A press at `x0` moving 5 px per 10 ms report, the last report just now. */
+static void drag(int x0, int reports) {
+    int64_t now = wall_us();
+    int64_t t = now - (int64_t)(reports - 1) * 10000;
+    put(t, EV_ABS, ABS_X, x0);
+    put(t, EV_ABS, ABS_Y, 240);
+    put(t, EV_KEY, BTN_TOUCH, 1);
+    put(t, EV_SYN, SYN_REPORT, 0);
+    for (int i = 1; i < reports; i++) report(t + i * 10000, x0 + 5 * i, 240);
+}
+
+static void test_poll(void) {
+    printf("through touch_poll()\n");
+    TouchInput t;
+    memset(&t, 0, sizeof(t));
+    if (touch_init(&t, "/dev/null") < 0) { expect_true("touch_init", false); return; }
+    int p[2];
+    if (pipe(p) != 0) { expect_true("pipe", false); return; }
+    fcntl(p[0], F_SETFL, O_NONBLOCK);
+    close(t.fd);
+    t.fd = p[0];
+    wr = p[1];
+    touch_set_raw_range(&t, 0, 799, 0, 479);       /* raw == logical pixel */
+
+    drag(100, 6);
+    touch_poll(&t);
+    expect_true("off until asked for: pred is the measured position",
+                t.state.x == 125 && t.state.pred_x == 125 && t.state.pred_y == t.state.y);
+    put(wall_us(), EV_KEY, BTN_TOUCH, 0);
+    put(wall_us(), EV_SYN, SYN_REPORT, 0);
+    touch_poll(&t);
+
+    touch_set_prediction(&t, true, 20000, 0);
+    drag(100, 6);
+    touch_poll(&t);
+    expect_true("on: measured x is untouched", t.state.x == 125 && t.state.held);
+    expect_true("pred leads it by 500 px/s x 20 ms", near(t.state.pred_x, 135, 2));
+    expect_true("and y, which is still, stays put", t.state.pred_y == 240);
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t mono = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    touch_predict_at(&t, mono + 10000000ULL);
+    expect_true("an explicit monotonic target 10 ms on", near(t.state.pred_x, 130, 2));
+
+    put(wall_us(), EV_KEY, BTN_TOUCH, 0);
+    put(wall_us(), EV_SYN, SYN_REPORT, 0);
+    touch_poll(&t);
+    expect_true("released: pred falls back to the measured position",
+                t.state.released && t.state.pred_x == t.state.x);
+
+    drag(770, 6);
+    touch_poll(&t);
+    expect_true("clamped to the screen", t.state.x == 795 && t.state.pred_x == 799);
+    put(wall_us(), EV_KEY, BTN_TOUCH, 0);
+    put(wall_us(), EV_SYN, SYN_REPORT, 0);
+    touch_poll(&t);
+
+    drag(400, 2);
+    touch_poll(&t);
+    expect_true("a new contact does not inherit the last one's motion",
+                t.state.pred_x == t.state.x);
+
+    close(p[1]);
+    touch_close(&t);
+}
+
+int main(void) {
+    test_motion();
+    test_poll();
+    printf("\n%s (%d failure%s)\n", fails ? "FAILED" : "PASSED",
+           fails, fails == 1 ? "" : "s");
+    return fails ? 1 : 0;
+}
@@ -19,7 +19,9 @@
 #include "../common/hardware.h"
 #include "../common/highscore.h"
 #include "../common/audio.h"
+#include "../common/frame_sched.h"
 #include "../common/gamepad.h"
+#include "../common/input_hub.h"
 
 #define BOARD_WIDTH 10
 #define BOARD_HEIGHT 20
@@ -150,6 +152,8 @@ Framebuffer fb;
 TouchInput touch;
 GamepadManager gamepad;
 InputState input;
+static InputHub hub;            /* ends an idle frame's wait on input */
+static uint32_t hub_devices;    /* gamepad.devices_changed the hub was built from */
 GameState game;
 int cell_size;
 int board_offset_x;
@@ -166,8 +170,6 @@ GameScreen current_screen = SCREEN_WELCOME;
 HighScoreTable hs_table;
 static GameOverScreen gos;
 Audio audio;
-static uint32_t last_rescan_ms = 0;
-#define RESCAN_INTERVAL_MS 5000
 static DASState das_left  = {false, 0, 0};
 static DASState das_right = {false, 0, 0};
 static bool soft_drop_active = false;
@@ -176,8 +178,25 @@ static bool soft_drop_active = false;
 static bool drop_clock_stale = true;
 /* LED flourishes (game start, game over), advanced once per frame by the main loop. */
 static LedPulse led_pulse;
+/* Everything on the playing screen that never moves — the black, the well
+ * border, the NEXT label and the control hints — painted once into an
+ * offscreen layer and blitted as the frame's background instead of cleared and
+ * redrawn.  Only the layout decides it, so nothing ever invalidates it.  If
+ * the surface could not be allocated, paint_chrome() draws straight onto fb. */
+static FbLayer chrome;
+static bool chrome_ok = false;
+/* What the last playing frame left on the panel, so the next one redraws only
+ * what differs (draw_playing_changes()).  field_drawn is cleared by any frame
+ * that draws something else — welcome, pause dialog, game-over overlay.
+ * Cells hold 0 for empty or a piece colour index + 1, falling piece included. */
+static bool field_drawn = false;
+static int drawn_cells[BOARD_HEIGHT][BOARD_WIDTH];
+static int drawn_score, drawn_level;
+static PieceType drawn_next;
+static ButtonVisualState drawn_menu_state, drawn_exit_state;
 
 // Function prototypes
+static void paint_chrome(Surface *s, void *user);
 void init_game();
 void reset_game();
 void spawn_piece(Piece *piece);
@@ -247,6 +266,9 @@ void init_game() {
     modal_dialog_init(&pause_dialog, "PAUSED", NULL, 2);
     modal_dialog_set_button(&pause_dialog, 0, "RESUME", BTN_COLOR_PRIMARY, COLOR_WHITE);
     modal_dialog_set_button(&pause_dialog, 1, "EXIT", BTN_COLOR_DANGER, COLOR_WHITE);
+
+    chrome_ok = fb_layer_init(&chrome, &fb, (int)fb.width, (int)fb.height,
+                              paint_chrome, NULL) == 0;
     
     reset_game();
 }
@@ -486,10 +508,10 @@ void handle_input() {
     // Poll gamepad/keyboard/touch through unified API
     gamepad_poll(&gamepad, &input, state.x, state.y, state.pressed);
 
-    // Periodic device rescan for hotplug support
-    if (current_time - last_rescan_ms > RESCAN_INTERVAL_MS) {
-        last_rescan_ms = current_time;
-        gamepad_rescan(&gamepad);
+    // A pad plugged in or pulled out has new fds; the hub's set names the old ones
+    if (gamepad.devices_changed != hub_devices) {
+        input_hub_track(&hub, touch.fd, &gamepad);
+        hub_devices = gamepad.devices_changed;
     }
 
     // BTN_BACK always exits to launcher
@@ -722,130 +744,216 @@ void handle_input() {
     }
 }
 
-// Draw the playing field (board, falling piece, HUD) — used as background
-// for PLAYING, PAUSED, and GAME_OVER screens
-void draw_playing_field() {
-    /* HUD: SCORE and LEVEL on ONE line, in the VISIBLE band above the
-     * SAFE-anchored MENU/EXIT row.  The band is drawable, just not
-     * pressable, and a status row is exactly what it is for; stacking the two
-     * strings below SAFE_TOP put LEVEL underneath the buttons, which are drawn
-     * after it.  Horizontally the line sits in the gap between the two buttons,
-     * so it cannot collide with either — and when the band is shorter than the
-     * text (uncalibrated panel, inset 0) it drops into the row's own vertical
-     * centre, which is empty between the buttons. */
+// The static part of the playing screen, onto s: the chrome layer, or fb
+// itself when there is no layer.  Positions here must match the dynamic
+// drawing in draw_playing_field().
+static void paint_chrome(Surface *s, void *user) {
+    // Board border
+    fb_draw_rect(s, board_offset_x - BOARD_BORDER, board_offset_y - BOARD_BORDER,
+                 BOARD_WIDTH * cell_size + 2 * BOARD_BORDER,
+                 BOARD_HEIGHT * cell_size + 2 * BOARD_BORDER, COLOR_WHITE);
+
+    if (portrait_mode) {
+        // NEXT label to the left of the preview, which sits left of the exit button
+        int preview_size = cell_size / 3;
+        if (preview_size < 6) preview_size = 6;
+        int next_x = exit_button.x - 4 * preview_size - 8;
+        int next_y = exit_button.y + (BTN_EXIT_HEIGHT - 4 * preview_size) / 2;
+        int label_w = text_measure_width("NEXT:", 1);
+        fb_draw_text(s, next_x - label_w - 4, next_y, "NEXT:", COLOR_WHITE, 1);
+
+        // Controls hint below the board (centered on play area)
+        int hint_y = board_offset_y + BOARD_HEIGHT * cell_size + 10;
+        text_draw_centered(s, board_offset_x + (BOARD_WIDTH * cell_size) / 2, hint_y,
+                          "L/R: MOVE  CENTER: ROTATE  BOTTOM: DROP",
+                          RGB(100, 100, 100), 1);
+    } else {
+        int next_x = board_offset_x + BOARD_WIDTH * cell_size + 20;
+        int next_y = board_offset_y + 20;
+        fb_draw_text(s, next_x, next_y - 20, "NEXT:", COLOR_WHITE, 2);
+
+        // Controls hint
+        fb_draw_text(s, 10, s->height - 60, "L/R: MOVE", RGB(100, 100, 100), 1);
+        fb_draw_text(s, 10, s->height - 45, "CENTER: ROTATE", RGB(100, 100, 100), 1);
+        fb_draw_text(s, 10, s->height - 30, "BOTTOM: DROP", RGB(100, 100, 100), 1);
+    }
+}
+
+/* HUD: SCORE and LEVEL on ONE line, in the VISIBLE band above the
+ * SAFE-anchored MENU/EXIT row.  The band is drawable, just not
+ * pressable, and a status row is exactly what it is for; stacking the two
+ * strings below SAFE_TOP put LEVEL underneath the buttons, which are drawn
+ * after it.  Horizontally the line sits in the gap between the two buttons,
+ * so it cannot collide with either — and when the band is shorter than the
+ * text (uncalibrated panel, inset 0) it drops into the row's own vertical
+ * centre, which is empty between the buttons. */
+#define HUD_SCALE 2
+#define HUD_GAP   24
+
+static int hud_y(void) {
+    int hud_h  = text_measure_height(HUD_SCALE);
+    int band_h = LAYOUT_MENU_BTN_Y - SCREEN_VISIBLE_TOP;
+    return (band_h >= hud_h)
+           ? SCREEN_VISIBLE_TOP + (band_h - hud_h) / 2
+           : LAYOUT_MENU_BTN_Y + (BTN_MENU_HEIGHT - hud_h) / 2;
+}
+
+static void draw_hud(void) {
     char score_text[32];
     char level_text[32];
     snprintf(score_text, sizeof(score_text), "SCORE:%d", game.score);
     snprintf(level_text, sizeof(level_text), "LVL:%d", game.level);
 
-    const int hud_scale = 2;
-    const int hud_gap   = 24;
-    int hud_h  = text_measure_height(hud_scale);
-    int band_h = LAYOUT_MENU_BTN_Y - SCREEN_VISIBLE_TOP;
-    int hud_y  = (band_h >= hud_h)
-                 ? SCREEN_VISIBLE_TOP + (band_h - hud_h) / 2
-                 : LAYOUT_MENU_BTN_Y + (BTN_MENU_HEIGHT - hud_h) / 2;
-
-    int score_w = text_measure_width(score_text, hud_scale);
-    int level_w = text_measure_width(level_text, hud_scale);
+    int score_w = text_measure_width(score_text, HUD_SCALE);
+    int level_w = text_measure_width(level_text, HUD_SCALE);
     int hud_cx  = (LAYOUT_MENU_BTN_X + BTN_MENU_WIDTH + LAYOUT_EXIT_BTN_X) / 2;
-    int hud_x   = hud_cx - (score_w + hud_gap + level_w) / 2;
+    int hud_x   = hud_cx - (score_w + HUD_GAP + level_w) / 2;
+
+    fb_draw_text(&fb, hud_x, hud_y(), score_text, COLOR_WHITE, HUD_SCALE);
+    fb_draw_text(&fb, hud_x + score_w + HUD_GAP, hud_y(), level_text, COLOR_CYAN, HUD_SCALE);
+}
+
+// Next piece preview: its top-left corner and the size of one of its cells
+static void next_preview_geometry(int *next_x, int *next_y, int *size) {
+    if (portrait_mode) {
+        // Portrait: to the left of the exit button (avoids overlap)
+        int preview_size = cell_size / 3;
+        if (preview_size < 6) preview_size = 6;
+        *next_x = exit_button.x - 4 * preview_size - 8;
+        *next_y = exit_button.y + (BTN_EXIT_HEIGHT - 4 * preview_size) / 2;
+        *size   = preview_size;
+    } else {
+        // Landscape: side panel to the right of the board
+        *next_x = board_offset_x + BOARD_WIDTH * cell_size + 20;
+        *next_y = board_offset_y + 20;
+        *size   = cell_size / 2;
+    }
+}
+
+static void draw_next_preview(void) {
+    int next_x, next_y, size;
+    next_preview_geometry(&next_x, &next_y, &size);
+    for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 4; x++) {
+            if (tetrominos[game.next.type][0][y][x]) {
+                fb_fill_rect(&fb, next_x + x * size, next_y + y * size,
+                             size - 1, size - 1, piece_colors[game.next.type]);
+            }
+        }
+    }
+}
 
-    fb_draw_text(&fb, hud_x, hud_y, score_text, COLOR_WHITE, hud_scale);
-    fb_draw_text(&fb, hud_x + score_w + hud_gap, hud_y, level_text, COLOR_CYAN, hud_scale);
+// The board as it should look: locked cells with the falling piece on top
+static void compose_cells(int cells[BOARD_HEIGHT][BOARD_WIDTH]) {
+    memcpy(cells, game.board, sizeof(game.board));
+    for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 4; x++) {
+            int bx = game.current.x + x, by = game.current.y + y;
+            if (tetrominos[game.current.type][game.current.rotation][y][x] &&
+                bx >= 0 && bx < BOARD_WIDTH && by >= 0 && by < BOARD_HEIGHT)
+                cells[by][bx] = game.current.type + 1;
+        }
+    }
+}
+
+static void remember_field(const int cells[BOARD_HEIGHT][BOARD_WIDTH]) {
+    memcpy(drawn_cells, cells, sizeof(drawn_cells));
+    drawn_score      = game.score;
+    drawn_level      = game.level;
+    drawn_next       = game.next.type;
+    drawn_menu_state = menu_button.visual_state;
+    drawn_exit_state = exit_button.visual_state;
+    field_drawn      = true;
+}
+
+// Draw the playing field (board, falling piece, HUD) — used as background
+// for PLAYING, PAUSED, and GAME_OVER screens
+void draw_playing_field() {
+    if (chrome_ok) {
+        fb_layer_blit(&fb, &chrome, 0, 0);
+    } else {
+        fb_clear(&fb, COLOR_BLACK);
+        paint_chrome(&fb, NULL);
+    }
+
+    draw_hud();
 
     // Draw menu and exit buttons
     draw_menu_button(&fb, &menu_button);
     draw_exit_button(&fb, &exit_button);
 
-    // Draw board border
-    fb_draw_rect(&fb, board_offset_x - BOARD_BORDER, board_offset_y - BOARD_BORDER,
-                 BOARD_WIDTH * cell_size + 2 * BOARD_BORDER,
-                 BOARD_HEIGHT * cell_size + 2 * BOARD_BORDER, COLOR_WHITE);
-    
-    // Draw locked pieces
+    // Draw locked pieces and the current piece
+    int cells[BOARD_HEIGHT][BOARD_WIDTH];
+    compose_cells(cells);
     for (int y = 0; y < BOARD_HEIGHT; y++) {
         for (int x = 0; x < BOARD_WIDTH; x++) {
-            if (game.board[y][x]) {
+            if (cells[y][x]) {
                 int px = board_offset_x + x * cell_size;
                 int py = board_offset_y + y * cell_size;
-                uint32_t color = piece_colors[game.board[y][x] - 1];
-                fb_fill_rect(&fb, px + 1, py + 1, cell_size - 2, cell_size - 2, color);
+                fb_fill_rect(&fb, px + 1, py + 1, cell_size - 2, cell_size - 2,
+                             piece_colors[cells[y][x] - 1]);
             }
         }
     }
-    
-    // Draw current piece
-    for (int y = 0; y < 4; y++) {
-        for (int x = 0; x < 4; x++) {
-            if (tetrominos[game.current.type][game.current.rotation][y][x]) {
-                int px = board_offset_x + (game.current.x + x) * cell_size;
-                int py = board_offset_y + (game.current.y + y) * cell_size;
-                uint32_t color = piece_colors[game.current.type];
-                fb_fill_rect(&fb, px + 1, py + 1, cell_size - 2, cell_size - 2, color);
-            }
+
+    draw_next_preview();
+    remember_field(cells);
+}
+
+// Put back the chrome under a rectangle, before drawing over it again
+static void restore_chrome(int x, int y, int w, int h) {
+    fb_blit_surface(&fb, fb_layer_surface(&chrome), x, y, x, y, w, h);
+}
+
+/* A playing frame over the previous playing frame.  With damage tracking on
+ * (main()), fb_swap() then copies only what this touched: a piece moving one
+ * column is the eight cells it left and entered, not the 1.5 MB screen that
+ * draw_playing_field() rewrites.  Needs the chrome layer to restore from;
+ * without it every frame is a full one. */
+static void draw_playing_changes(void) {
+    int cells[BOARD_HEIGHT][BOARD_WIDTH];
+    compose_cells(cells);
+    for (int y = 0; y < BOARD_HEIGHT; y++) {
+        for (int x = 0; x < BOARD_WIDTH; x++) {
+            if (cells[y][x] == drawn_cells[y][x]) continue;
+            int px = board_offset_x + x * cell_size;
+            int py = board_offset_y + y * cell_size;
+            fb_fill_rect(&fb, px, py, cell_size, cell_size, COLOR_BLACK);
+            if (cells[y][x])
+                fb_fill_rect(&fb, px + 1, py + 1, cell_size - 2, cell_size - 2,
+                             piece_colors[cells[y][x] - 1]);
         }
     }
-    
-    // Draw next piece preview
-    if (portrait_mode) {
-        // Portrait: draw NEXT preview to the left of the exit button (avoids overlap)
-        int preview_size = cell_size / 3;
-        if (preview_size < 6) preview_size = 6;
-        int preview_block_w = 4 * preview_size;
-        int next_x = exit_button.x - preview_block_w - 8;
-        int next_y = exit_button.y + (BTN_EXIT_HEIGHT - 4 * preview_size) / 2;
-        int label_w = text_measure_width("NEXT:", 1);
-        fb_draw_text(&fb, next_x - label_w - 4, next_y, "NEXT:", COLOR_WHITE, 1);
-        
-        for (int y = 0; y < 4; y++) {
-            for (int x = 0; x < 4; x++) {
-                if (tetrominos[game.next.type][0][y][x]) {
-                    int px = next_x + x * preview_size;
-                    int py = next_y + y * preview_size;
-                    uint32_t color = piece_colors[game.next.type];
-                    fb_fill_rect(&fb, px, py, preview_size - 1, preview_size - 1, color);
-                }
-            }
-        }
-        
-        // Draw controls hint below the board (centered on play area)
-        int hint_y = board_offset_y + BOARD_HEIGHT * cell_size + 10;
-        text_draw_centered(&fb, board_offset_x + (BOARD_WIDTH * cell_size) / 2, hint_y,
-                          "L/R: MOVE  CENTER: ROTATE  BOTTOM: DROP",
-                          RGB(100, 100, 100), 1);
-    } else {
-        // Landscape: side panel to the right of the board
-        int next_x = board_offset_x + BOARD_WIDTH * cell_size + 20;
-        int next_y = board_offset_y + 20;
-        fb_draw_text(&fb, next_x, next_y - 20, "NEXT:", COLOR_WHITE, 2);
-        
-        for (int y = 0; y < 4; y++) {
-            for (int x = 0; x < 4; x++) {
-                if (tetrominos[game.next.type][0][y][x]) {
-                    int px = next_x + x * (cell_size / 2);
-                    int py = next_y + y * (cell_size / 2);
-                    uint32_t color = piece_colors[game.next.type];
-                    fb_fill_rect(&fb, px, py, cell_size / 2 - 1, cell_size / 2 - 1, color);
-                }
-            }
-        }
-        
-        // Draw controls hint
-        fb_draw_text(&fb, 10, fb.height - 60, "L/R: MOVE", RGB(100, 100, 100), 1);
-        fb_draw_text(&fb, 10, fb.height - 45, "CENTER: ROTATE", RGB(100, 100, 100), 1);
-        fb_draw_text(&fb, 10, fb.height - 30, "BOTTOM: DROP", RGB(100, 100, 100), 1);
+
+    /* The HUD line, the buttons and the preview can share the button row (a
+     * portrait panel with no band above it), so any of them changing redraws
+     * all three over restored chrome, in draw_playing_field()'s order. */
+    if (game.score != drawn_score || game.level != drawn_level ||
+        game.next.type != drawn_next ||
+        menu_button.visual_state != drawn_menu_state ||
+        exit_button.visual_state != drawn_exit_state) {
+        int next_x, next_y, size;
+        next_preview_geometry(&next_x, &next_y, &size);
+        int hud_left = LAYOUT_MENU_BTN_X + BTN_MENU_WIDTH;
+        restore_chrome(hud_left, hud_y(), LAYOUT_EXIT_BTN_X - hud_left,
+                       text_measure_height(HUD_SCALE));
+        restore_chrome(next_x, next_y, 4 * size, 4 * size);
+        draw_hud();
+        draw_menu_button(&fb, &menu_button);
+        draw_exit_button(&fb, &exit_button);
+        draw_next_preview();
     }
+    remember_field(cells);
 }
 
 void draw_game() {
-    fb_clear(&fb, COLOR_BLACK);
-    
     // Welcome screen — the shared implementation measures the instruction block
     // and lays TAP TO START out below it.  This used to be four hand-placed
     // text_draw_centered() calls plus a button at a fixed fb.height/2 + 40, and
     // the fourth line landed inside the button.
     if (current_screen == SCREEN_WELCOME) {
+        field_drawn = false;
+        fb_clear(&fb, COLOR_BLACK);
         draw_welcome_screen(&fb, "TETRIS",
             "L/R: MOVE   UP/A: ROTATE\n"
             "DOWN: SOFT DROP   X: HARD DROP\n"
@@ -855,8 +963,16 @@ void draw_game() {
         return;
     }
     
-    // Draw the playing field as background (used by PLAYING, PAUSED, GAME_OVER)
+    if (current_screen == SCREEN_PLAYING && field_drawn && chrome_ok) {
+        draw_playing_changes();
+        return;
+    }
+
+    // Draw the playing field as background (used by PLAYING, PAUSED, GAME_OVER);
+    // it lays down the whole frame, so there is no clear above
     draw_playing_field();
+    if (current_screen != SCREEN_PLAYING)
+        field_drawn = false;            /* an overlay goes on top of it */
     
     // Handle pause screen overlay (Issue #11: semi-transparent overlay)
     if (current_screen == SCREEN_PAUSED) {
@@ -920,6 +1036,7 @@ int main(int argc, char *argv[]) {
         fb_close(&fb);
         return 1;
     }
+    fb_set_damage_tracking(&fb, true);  /* see draw_playing_changes() */
     
     // Initialize hardware control
     hw_init();
@@ -937,9 +1054,30 @@ int main(int argc, char *argv[]) {
      * rather than muting, so there is nothing for a game to do about it, and
      * audio_close() reports which path actually ran. */
     audio_cont_enable(&audio, true);
+    /* Opt-in (`audio_server` in the config): the bus in a forked process of its
+     * own, so the name-entry screen and the touch drains, which do not pump,
+     * stop starving the stream.  Unchecked for the same reason as the line
+     * above — a refusal leaves the in-loop path exactly as it was. */
+    if (audio_server_enabled(&audio)) audio_server_start(&audio);
+
+    FrameSched sched;
+    frame_sched_init(&sched, FRAME_DELAY_ACTIVE_US, FRAME_DELAY_IDLE_US);
+    frame_sched_set_audio(&sched, audio_pump_slot, &audio,
+                          audio_cont_service_interval_us(&audio) / 2);
+    frame_sched_set_report(&sched, 60000, frame_stats_print, "tetris: frames");
 
     // Gamepad init
     gamepad_init(&gamepad);
+
+    /* The welcome, pause and game-over screens are idle frames, and so is every
+     * frame once the audio server owns the stream: up to 100 ms asleep, which a
+     * tap used to wait out.  The hub ends that sleep when touch or a pad has
+     * input (common/input_hub.h); without epoll it is the plain sleep. */
+    if (input_hub_init(&hub) != 0)
+        fprintf(stderr, "tetris: epoll unavailable, idle frames sleep their full period\n");
+    input_hub_track(&hub, touch.fd, &gamepad);
+    hub_devices = gamepad.devices_changed;
+    frame_sched_set_wait(&sched, input_hub_wait, &hub);
     
     srand(time(NULL));
     init_game();
@@ -949,6 +1087,7 @@ int main(int argc, char *argv[]) {
     /* ── main loop ───────────────────────────────────────────────────── */
     bool needs_redraw = true;
     while (running) {
+        frame_sched_begin(&sched);
         GameScreen prev_screen = current_screen;
 
         /* Snapshot game state before processing (for change detection) */
@@ -991,28 +1130,30 @@ int main(int argc, char *argv[]) {
         if (current_screen == SCREEN_GAME_OVER && gameover_needs_redraw(&gos))
             needs_redraw = true;
 
-        if (needs_redraw) {
+        if (needs_redraw && frame_sched_render_due(&sched)) {
             draw_game();
             fb_swap(&fb);
+            needs_redraw = false;
         }
 
-        /* Service the stream on EVERY iteration, drawing or not — it holds one
-         * lead (~139 ms on the OSS shim) and a skipped service is an audible
-         * gap.  ⚠️ audio_pump_active() belongs in the pacing decision: it is
-         * unconditionally true while the continuous stream is live, and
-         * FRAME_DELAY_IDLE_US (100 ms) is well above the ~55 ms service ceiling
-         * the library measures for itself (common/audio_out.h). */
-        audio_pump(&audio);
-        usleep((needs_redraw || audio_pump_active(&audio))
-               ? FRAME_DELAY_ACTIVE_US : FRAME_DELAY_IDLE_US);
-        needs_redraw = false;  /* reset for next frame */
+        /* frame_sched_end() runs the audio slot (audio_pump_slot) on EVERY
+         * iteration, drawing or not, and again in slices through the wait — the
+         * stream holds one lead (~139 ms on the OSS shim) and a skipped service
+         * is an audible gap.  ⚠️ audio_pump_active() is still in the pacing
+         * decision, as the slot's return value: it is unconditionally true
+         * while the continuous stream is live.  The wait is to an absolute
+         * deadline, so this frame's work is inside FRAME_DELAY_ACTIVE_US rather
+         * than added to it (common/frame_sched.h). */
+        frame_sched_end(&sched);
     }
     
+    input_hub_close(&hub);
     gamepad_close(&gamepad);
     touch_close(&touch);
     hw_leds_off();
     hw_set_backlight(100);
     audio_close(&audio);
+    fb_layer_free(&chrome);
     fb_close(&fb);
     
     printf("Tetris ended. Final score: %d\n", game.score);
@@ -75,7 +75,6 @@ RoomWizardEventSource::RoomWizardEventSource()
 	  _keyboardFd(-1),
 	  _mouseFd(-1),
 	  _gamepadFd(-1),
-	  _lastDeviceScan(0),
 	  // Keyboard
 	  _modifierFlags(0),
 	  // Mouse
@@ -107,11 +106,13 @@ RoomWizardEventSource::RoomWizardEventSource()
 	loadInputConfig();
 	initTouch();
 	scanInputDevices();
+	input_hotplug_open(&_hotplug, NULL);
 }
 
 RoomWizardEventSource::~RoomWizardEventSource() {
 	closeTouch();
 	closeInputDevices();
+	input_hotplug_close(&_hotplug);
 }
 
 // =========================================================================
@@ -213,51 +214,56 @@ RoomWizardEventSource::DeviceType RoomWizardEventSource::classifyDevice(int fd)
 	return DEV_UNKNOWN;
 }
 
-void RoomWizardEventSource::scanInputDevices() {
-	char path[64];
+bool RoomWizardEventSource::openInputDevice(const char *path) {
 	char name[128];
 
-	for (int i = 0; i < MAX_EVDEV_DEVICES; i++) {
-		snprintf(path, sizeof(path), "/dev/input/event%d", i);
-
-		int fd = open(path, O_RDONLY | O_NONBLOCK);
-		if (fd < 0) {
-			// BUG-INPUT-004 FIX: Log permission errors so we can diagnose
-			// "no input" issues caused by /dev/input/event* permissions.
-			if (errno == EACCES || errno == EPERM) {
-				warning("RoomWizard: cannot open %s — permission denied (run as root or add to 'input' group)", path);
-			}
-			continue;
+	int fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+	if (fd < 0) {
+		// BUG-INPUT-004 FIX: Log permission errors so we can diagnose
+		// "no input" issues caused by /dev/input/event* permissions.
+		if (errno == EACCES || errno == EPERM) {
+			warning("RoomWizard: cannot open %s — permission denied (run as root or add to 'input' group)", path);
 		}
+		return false;
+	}
 
-		name[0] = '\0';
-		ioctl(fd, EVIOCGNAME(sizeof(name)), name);
+	name[0] = '\0';
+	ioctl(fd, EVIOCGNAME(sizeof(name)), name);
 
-		// Filter out Panjit touchscreen (already handled by touch code)
-		if (strstr(name, "panjit") || strstr(name, "Panjit") || strstr(name, "PANJIT") ||
-		    strstr(name, "TouchScreen") || strstr(name, "touchscreen")) {
-			close(fd);
-			continue;
-		}
+	// Filter out Panjit touchscreen (already handled by touch code)
+	if (strstr(name, "panjit") || strstr(name, "Panjit") || strstr(name, "PANJIT") ||
+	    strstr(name, "TouchScreen") || strstr(name, "touchscreen")) {
+		close(fd);
+		return false;
+	}
 
-		DeviceType type = classifyDevice(fd);
-
-		if (type == DEV_GAMEPAD && _gamepadFd < 0) {
-			_gamepadFd = fd;
-			loadGamepadAxisCalibration();
-			warning("RoomWizard: Detected gamepad '%s' at %s", name, path);
-		} else if (type == DEV_KEYBOARD && _keyboardFd < 0) {
-			_keyboardFd = fd;
-			warning("RoomWizard: Detected keyboard '%s' at %s", name, path);
-		} else if (type == DEV_MOUSE && _mouseFd < 0) {
-			_mouseFd = fd;
-			warning("RoomWizard: Detected mouse '%s' at %s", name, path);
-		} else {
-			close(fd);
-		}
+	DeviceType type = classifyDevice(fd);
+
+	if (type == DEV_GAMEPAD && _gamepadFd < 0) {
+		_gamepadFd = fd;
+		loadGamepadAxisCalibration();
+		warning("RoomWizard: Detected gamepad '%s' at %s", name, path);
+	} else if (type == DEV_KEYBOARD && _keyboardFd < 0) {
+		_keyboardFd = fd;
+		warning("RoomWizard: Detected keyboard '%s' at %s", name, path);
+	} else if (type == DEV_MOUSE && _mouseFd < 0) {
+		_mouseFd = fd;
+		warning("RoomWizard: Detected mouse '%s' at %s", name, path);
+	} else {
+		close(fd);
+		return false;
+	}
+	return true;
+}
 
+void RoomWizardEventSource::scanInputDevices() {
+	char path[64];
+
+	for (int i = 0; i < MAX_EVDEV_DEVICES; i++) {
 		if (_gamepadFd >= 0 && _keyboardFd >= 0 && _mouseFd >= 0)
 			break;
+		snprintf(path, sizeof(path), INPUT_HOTPLUG_DIR "/event%d", i);
+		openInputDevice(path);
 	}
 
 	// BUG-INPUT-004 FIX: Log a summary after scanning so we know what was
@@ -268,6 +274,25 @@ void RoomWizardEventSource::scanInputDevices() {
 	      (_gamepadFd >= 0  ? "YES" : "no"));
 }
 
+// New /dev/input nodes since the last poll.  Only the node that appeared is
+// opened and classified; the full scan is for a lost inotify queue, or every
+// INPUT_HOTPLUG_RESCAN_MS on a kernel without inotify.
+void RoomWizardEventSource::pollHotplug() {
+	char path[96];
+	InputHotplugChange c;
+	while ((c = input_hotplug_next(&_hotplug, path, sizeof(path))) != INPUT_HOTPLUG_NONE) {
+		if (c == INPUT_HOTPLUG_RESCAN) {
+			if (_keyboardFd < 0 || _mouseFd < 0 || _gamepadFd < 0)
+				scanInputDevices();
+		} else if ((_keyboardFd < 0 || _mouseFd < 0 || _gamepadFd < 0) &&
+		           !input_hotplug_same_node(_keyboardFd, path) &&
+		           !input_hotplug_same_node(_mouseFd, path) &&
+		           !input_hotplug_same_node(_gamepadFd, path)) {
+			openInputDevice(path);
+		}
+	}
+}
+
 void RoomWizardEventSource::closeInputDevices() {
 	if (_keyboardFd >= 0) { close(_keyboardFd); _keyboardFd = -1; }
 	if (_mouseFd >= 0)    { close(_mouseFd);    _mouseFd = -1; }
@@ -682,12 +707,13 @@ RoomWizardEventSource::KeyMapping RoomWizardEventSource::mapLinuxKey(int linuxKe
 bool RoomWizardEventSource::pollKeyboard(Common::Event &event) {
 	if (_keyboardFd < 0) return false;
 
-	// BUG-INPUT-004 FIX: Clear errno before the read loop so stale values
-	// (e.g. EAGAIN from a previous poll) don't trigger false disconnect detection.
-	errno = 0;
-
+	// Unplugged is a read that FAILED with ENODEV, so the loop keeps that
+	// read's result: errno alone means nothing when the loop ended on a short
+	// read, and BUG-INPUT-004's errno = 0 only hid values left by earlier
+	// calls.  gamepad.c and vnc_input.c test it the same way.
+	ssize_t n;
 	struct input_event ev;
-	while (read(_keyboardFd, &ev, sizeof(ev)) == (ssize_t)sizeof(ev)) {
+	while ((n = read(_keyboardFd, &ev, sizeof(ev))) == (ssize_t)sizeof(ev)) {
 		if (ev.type != EV_KEY) continue;
 
 		// value: 0=release, 1=press, 2=auto-repeat (ignored — ScummVM repeats internally)
@@ -723,11 +749,14 @@ bool RoomWizardEventSource::pollKeyboard(Common::Event &event) {
 	}
 
 	// Check for disconnect
-	if (errno == ENODEV || errno == EBADF) {
+	if (n < 0 && errno == ENODEV) {
 		debug("RoomWizard: keyboard disconnected");
 		close(_keyboardFd);
 		_keyboardFd = -1;
 		_modifierFlags = 0;
+		// A second keyboard plugged in while this one held the slot was
+		// never reported again — one scan picks it up.
+		scanInputDevices();
 	}
 	return false;
 }
@@ -739,16 +768,13 @@ bool RoomWizardEventSource::pollKeyboard(Common::Event &event) {
 bool RoomWizardEventSource::pollMouse(Common::Event &event) {
 	if (_mouseFd < 0) return false;
 
-	// BUG-INPUT-004 FIX: Clear errno before read loop — stale errno from
-	// prior system calls could cause false disconnect detection below.
-	errno = 0;
-
+	ssize_t n;                  // the last read's result — see pollKeyboard()
 	struct input_event ev;
 	int accumDx = 0, accumDy = 0;
 	int buttonChanges = 0;
 	int buttonState = _prevMouseButtons;
 
-	while (read(_mouseFd, &ev, sizeof(ev)) == (ssize_t)sizeof(ev)) {
+	while ((n = read(_mouseFd, &ev, sizeof(ev))) == (ssize_t)sizeof(ev)) {
 		if (ev.type == EV_REL) {
 			if (ev.code == REL_X) accumDx += ev.value;
 			else if (ev.code == REL_Y) accumDy += ev.value;
@@ -765,10 +791,11 @@ bool RoomWizardEventSource::pollMouse(Common::Event &event) {
 		}
 	}
 
-	if (errno == ENODEV || errno == EBADF) {
+	if (n < 0 && errno == ENODEV) {
 		debug("RoomWizard: mouse disconnected");
 		close(_mouseFd);
 		_mouseFd = -1;
+		scanInputDevices();
 		return false;
 	}
 
@@ -911,17 +938,14 @@ bool RoomWizardEventSource::pollMouse(Common::Event &event) {
 bool RoomWizardEventSource::pollGamepad(Common::Event &event) {
 	if (_gamepadFd < 0) return false;
 
-	// BUG-INPUT-004 FIX: Clear errno before read loop — stale errno from
-	// prior system calls could cause false disconnect detection below.
-	errno = 0;
-
+	ssize_t n;                  // the last read's result — see pollKeyboard()
 	struct input_event ev;
 	int buttonChanges = 0;
 	int buttonState = _prevGamepadButtons;
 	// Bit assignments: 0=South(A), 1=East(B), 2=West(X), 3=North(Y),
 	//                  4=Start, 5=Select, 6=TL, 7=TR
 
-	while (read(_gamepadFd, &ev, sizeof(ev)) == (ssize_t)sizeof(ev)) {
+	while ((n = read(_gamepadFd, &ev, sizeof(ev))) == (ssize_t)sizeof(ev)) {
 		if (ev.type == EV_ABS) {
 			if (ev.code == _gamepadMap.stickXAxis)      _gamepadAxisX = ev.value;
 			else if (ev.code == _gamepadMap.stickYAxis)  _gamepadAxisY = ev.value;
@@ -946,10 +970,11 @@ bool RoomWizardEventSource::pollGamepad(Common::Event &event) {
 		}
 	}
 
-	if (errno == ENODEV || errno == EBADF) {
+	if (n < 0 && errno == ENODEV) {
 		debug("RoomWizard: gamepad disconnected");
 		close(_gamepadFd);
 		_gamepadFd = -1;
+		scanInputDevices();
 		return false;
 	}
 
@@ -1327,16 +1352,8 @@ bool RoomWizardEventSource::pollEvent(Common::Event &event) {
 		return true;
 	}
 
-	// Periodic device rescan (every 5 seconds) to detect hotplug
-	if (g_system) {
-		uint32 now = g_system->getMillis();
-		if (now - _lastDeviceScan > DEVICE_SCAN_INTERVAL) {
-			_lastDeviceScan = now;
-			// Only rescan for devices that aren't currently open
-			if (_keyboardFd < 0 || _mouseFd < 0 || _gamepadFd < 0)
-				scanInputDevices();
-		}
-	}
+	// Devices plugged in since the last poll (inotify, not a rescan timer)
+	pollHotplug();
 
 	// Poll all input sources — return first event found
 	if (pollKeyboard(event)) return true;
@@ -28,6 +28,7 @@
 extern "C" {
 #include "touch_input.h"
 #include "framebuffer.h"   // screen_base_width/height (the visible screen size)
+#include "input_hotplug.h" // inotify on /dev/input instead of a rescan timer
 }
 
 class RoomWizardEventSource : public Common::EventSource {
@@ -142,12 +143,14 @@ private:
 	int _gamepadFd;
 
 	void scanInputDevices();         // Scan /dev/input/event* for USB devices
+	bool openInputDevice(const char *path); // Classify one node, keep it if a slot is free
 	DeviceType classifyDevice(int fd); // Classify as keyboard/mouse/gamepad
 	void closeInputDevices();        // Close all USB device fds
 
-	// Periodic rescan timer
-	uint32 _lastDeviceScan;
-	static const uint32 DEVICE_SCAN_INTERVAL = 5000; // 5 seconds
+	// Hotplug: new nodes are classified as they appear (native_apps/common/
+	// input_hotplug.h); an unplug shows up as ENODEV in the poll functions.
+	InputHotplug _hotplug;
+	void pollHotplug();
 	// BUG-INPUT-004 FIX: Increased from 16 to 32 — USB keyboards/mice are often
 	// assigned event numbers >= 16 when built-in devices occupy the lower slots.
 	static const int MAX_EVDEV_DEVICES = 32;
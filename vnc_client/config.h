@@ -132,8 +132,9 @@ typedef enum {
  * keyboard that enumerated as /dev/input/event17 worked under the native apps
  * and ScummVM but was invisible here.  It bounds the scan loop only and sizes
  * no array, so raising it costs nothing but 16 more failed open() calls per
- * rescan.  The real fix is one shared scanner — ../IMPROVEMENT_PLAN.md C1. */
+ * scan.  Scans are rare now: new devices arrive through the shared hotplug
+ * watcher (common/input_hotplug.h), and a full scan runs only at start-up,
+ * after an unplug, or every INPUT_HOTPLUG_RESCAN_MS without inotify. */
 #define MAX_INPUT_DEVICES       32
-#define DEVICE_SCAN_INTERVAL_MS 5000
 
 #endif // VNC_CONFIG_H
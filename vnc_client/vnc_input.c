@@ -220,57 +220,67 @@ static void load_input_config(VNCInput *input) {
     DEBUG_PRINT("Loaded input config from %s", INPUT_CONFIG_FILE);
 }
 
-/* ── Get current time in milliseconds ───────────────────────────────────── */
-static uint32_t get_ticks_ms(void) {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (uint32_t)(tv.tv_sec * 1000 + tv.tv_usec / 1000);
-}
-
 /* ═══════════════════════════════════════════════════════════════════════════
  * Public API
  * ═══════════════════════════════════════════════════════════════════════════ */
 
-/* ── Scan /dev/input/event* for USB keyboard and mouse ──────────────────── */
-void vnc_input_scan_devices(VNCInput *input) {
-    char path[64];
+/* ── Open one event node; keep it if it fills an empty slot ─────────────── */
+static void open_device(VNCInput *input, const char *path) {
     char name[128];
 
-    for (int i = 0; i < MAX_INPUT_DEVICES; i++) {
-        snprintf(path, sizeof(path), "/dev/input/event%d", i);
+    int fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) return;
 
-        int fd = open(path, O_RDONLY | O_NONBLOCK);
-        if (fd < 0) continue;
+    /* Read device name */
+    name[0] = '\0';
+    ioctl(fd, EVIOCGNAME(sizeof(name)), name);
 
-        /* Read device name */
-        name[0] = '\0';
-        ioctl(fd, EVIOCGNAME(sizeof(name)), name);
+    /* Filter out Panjit touchscreen */
+    if (strstr(name, "panjit") || strstr(name, "Panjit") ||
+        strstr(name, "PANJIT") || strstr(name, "TouchScreen")) {
+        close(fd);
+        return;
+    }
 
-        /* Filter out Panjit touchscreen */
-        if (strstr(name, "panjit") || strstr(name, "Panjit") ||
-            strstr(name, "PANJIT") || strstr(name, "TouchScreen")) {
-            close(fd);
-            continue;
-        }
+    VDevType type = classify_device(fd);
 
-        VDevType type = classify_device(fd);
+    if (type == VDEV_KEYBOARD && input->keyboard_fd < 0) {
+        input->keyboard_fd = fd;
+        DEBUG_PRINT("USB keyboard found: '%s' at %s", name, path);
+    } else if (type == VDEV_MOUSE && input->mouse_fd < 0) {
+        input->mouse_fd = fd;
+        DEBUG_PRINT("USB mouse found: '%s' at %s", name, path);
+    } else {
+        close(fd);
+    }
+}
 
-        if (type == VDEV_KEYBOARD && input->keyboard_fd < 0) {
-            input->keyboard_fd = fd;
-            DEBUG_PRINT("USB keyboard found: '%s' at %s", name, path);
-        } else if (type == VDEV_MOUSE && input->mouse_fd < 0) {
-            input->mouse_fd = fd;
-            DEBUG_PRINT("USB mouse found: '%s' at %s", name, path);
-        } else {
-            close(fd);
-        }
+/* ── Scan /dev/input/event* for USB keyboard and mouse ──────────────────── */
+void vnc_input_scan_devices(VNCInput *input) {
+    char path[64];
 
-        /* Stop early if both found */
-        if (input->keyboard_fd >= 0 && input->mouse_fd >= 0)
-            break;
+    /* Stop early once both are found — before the first open, too. */
+    for (int i = 0; i < MAX_INPUT_DEVICES &&
+                    (input->keyboard_fd < 0 || input->mouse_fd < 0); i++) {
+        snprintf(path, sizeof(path), INPUT_HOTPLUG_DIR "/event%d", i);
+        open_device(input, path);
     }
+}
 
-    input->last_device_scan = get_ticks_ms();
+/* ── Adopt devices plugged in since the last call ───────────────────────── */
+static void poll_hotplug(VNCInput *input) {
+    char path[96];
+    InputHotplugChange c;
+    while ((c = input_hotplug_next(&input->hotplug, path, sizeof(path))) != INPUT_HOTPLUG_NONE) {
+        if (c == INPUT_HOTPLUG_RESCAN) {
+            vnc_input_scan_devices(input);
+        } else if ((input->keyboard_fd < 0 || input->mouse_fd < 0) &&
+                   !input_hotplug_same_node(input->keyboard_fd, path) &&
+                   !input_hotplug_same_node(input->mouse_fd, path)) {
+            /* Only the node that appeared — not every node on the bus. */
+            open_device(input, path);
+        }
+    }
 }
 
 /* ── Close USB devices ──────────────────────────────────────────────────── */
@@ -330,8 +340,9 @@ int vnc_input_init(VNCInput *input, TouchInput *touch, VNCRenderer *renderer, rf
     /* Load mouse config from /etc/input_config.conf */
     load_input_config(input);
 
-    /* Scan for USB keyboard and mouse */
+    /* Scan for USB keyboard and mouse, then watch for more */
     vnc_input_scan_devices(input);
+    input_hotplug_open(&input->hotplug, NULL);
     
     DEBUG_PRINT("Input handler initialized (keyboard=%s, mouse=%s)",
                 input->keyboard_fd >= 0 ? "connected" : "none",
@@ -362,7 +373,8 @@ static void poll_usb_keyboard(VNCInput *input) {
     if (input->keyboard_fd < 0) return;
 
     struct input_event ev;
-    while (read(input->keyboard_fd, &ev, sizeof(ev)) == (ssize_t)sizeof(ev)) {
+    ssize_t n;
+    while ((n = read(input->keyboard_fd, &ev, sizeof(ev))) == (ssize_t)sizeof(ev)) {
         if (ev.type == EV_KEY && ev.code < 256) {
             uint32_t keysym = evdev_to_keysym[ev.code];
             if (keysym != 0) {
@@ -374,11 +386,13 @@ static void poll_usb_keyboard(VNCInput *input) {
         }
     }
 
-    /* Check for device disconnect */
-    if (errno == ENODEV) {
+    /* Check for device disconnect.  A second keyboard that was plugged in
+     * while this one held the slot was never adopted: one scan finds it. */
+    if (n < 0 && errno == ENODEV) {
         DEBUG_PRINT("USB keyboard disconnected");
         close(input->keyboard_fd);
         input->keyboard_fd = -1;
+        vnc_input_scan_devices(input);
     }
 }
 
@@ -390,8 +404,9 @@ static void poll_usb_mouse(VNCInput *input) {
     struct input_event ev;
     int dx = 0, dy = 0;
     int buttons_changed = 0;
+    ssize_t n;
 
-    while (read(input->mouse_fd, &ev, sizeof(ev)) == (ssize_t)sizeof(ev)) {
+    while ((n = read(input->mouse_fd, &ev, sizeof(ev))) == (ssize_t)sizeof(ev)) {
         if (ev.type == EV_REL) {
             if (ev.code == REL_X) {
                 dx += ev.value;
@@ -454,10 +469,11 @@ static void poll_usb_mouse(VNCInput *input) {
     }
 
     /* Check for device disconnect */
-    if (errno == ENODEV) {
+    if (n < 0 && errno == ENODEV) {
         DEBUG_PRINT("USB mouse disconnected");
         close(input->mouse_fd);
         input->mouse_fd = -1;
+        vnc_input_scan_devices(input);
     }
 }
 
@@ -465,13 +481,8 @@ static void poll_usb_mouse(VNCInput *input) {
 void vnc_input_process(VNCInput *input) {
     if (!input || !input->touch || !input->renderer) return;
 
-    /* ── Periodic device rescan (every DEVICE_SCAN_INTERVAL_MS) ──────── */
-    if (input->keyboard_fd < 0 || input->mouse_fd < 0) {
-        uint32_t now_ms = get_ticks_ms();
-        if (now_ms - input->last_device_scan >= DEVICE_SCAN_INTERVAL_MS) {
-            vnc_input_scan_devices(input);
-        }
-    }
+    /* ── Hotplug: classify only nodes that just appeared ──────────────── */
+    poll_hotplug(input);
 
     /* ── Poll USB keyboard ───────────────────────────────────────────── */
     poll_usb_keyboard(input);
@@ -579,5 +590,6 @@ void vnc_input_cleanup(VNCInput *input) {
     if (!input) return;
     
     vnc_input_close_usb_devices(input);
+    input_hotplug_close(&input->hotplug);
     DEBUG_PRINT("Input handler cleanup");
 }
@@ -6,6 +6,7 @@
 #include <sys/time.h>
 #include <rfb/rfbclient.h>
 #include "../native_apps/common/touch_input.h"
+#include "../native_apps/common/input_hotplug.h"
 
 // Forward declaration
 typedef struct VNCRenderer VNCRenderer;
@@ -52,8 +53,8 @@ typedef struct {
     int mouse_low_threshold;    // Default 3
     int mouse_high_threshold;   // Default 15
 
-    // Device rescan timer
-    uint32_t last_device_scan;
+    // Watches /dev/input for keyboards and mice plugged in later
+    InputHotplug hotplug;
 } VNCInput;
 
 // Initialize input handler